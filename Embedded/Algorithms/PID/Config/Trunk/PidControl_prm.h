@@ -38,6 +38,9 @@
 /// define the agument type
 #define PIDCONTROL_ARG_TYPE                 ( PIDCONTROL_ARGTYPE_FLOAT )
 
+/// define the macro to enable the fixed point PID bank
+#define PIDCONTROL_ENABLE_BANK              ( OFF )
+
 /**@} EOF PidControl_prm.h */
 
 #endif  // _PIDCONTROL_PRM_H
\ No newline at end of file
@@ -24,6 +24,7 @@
  *****************************************************************************/
 
 // system includes ------------------------------------------------------------
+#include <string.h>
 
 // local includes -------------------------------------------------------------
 #include "PID/PidControl.h"
@@ -41,6 +42,12 @@
 // local parameter declarations -----------------------------------------------
 
 // local function prototypes --------------------------------------------------
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+static  void  BankExecuteLoop( const PIDBANKDEF* ptDef, PPIDBANKLOOP ptLoop );
+static  void  BankGetGains( const PIDBANKDEF* ptDef, PPIDBANKLOOP ptLoop, PS32 plKp, PS32 plKi, PS32 plKd );
+static  S32   BankMultiply( S32 lA, S32 lB );
+static  S32   BankSaturate( S64 hValue );
+#endif // PIDCONTROL_ENABLE_BANK
 
 // constant parameter initializations -----------------------------------------
 
@@ -71,7 +78,7 @@ void PidControl_Initialize( void )
  * @return      new output value
  *
  *****************************************************************************/
-PIDCONTROLARG PidControl_Process( PPIDCTRL ptPidCtl, PIDCONTROLARG xSetPoint, PIDCONTROLARG xProcVar )
+PIDCONTROLARG PidControl_Process( PPIDCONTROLVAR ptPidCtl, PIDCONTROLARG xSetPoint, PIDCONTROLARG xProcVar )
 {
 	PIDCONTROLARG	xError;
 	PIDCONTROLARG	xOutput;
@@ -82,7 +89,7 @@ PIDCONTROLARG PidControl_Process( PPIDCTRL ptPidCtl, PIDCONTROLARG xSetPoint, PI
 	// compute the integral/check for limits
 	ptPidCtl->xTotalError += xError;
 	ptPidCtl->xTotalError = ( ptPidCtl->xTotalError > ptPidCtl->tDefs.xLd ) ? ptPidCtl->tDefs.xLd : ptPidCtl->xTotalError;
-	ptPidCtl->xTotalError = ( -ptPidCtl->xTotalError < -ptPidCtl->tDefs.xLd ) ? -ptPidCtl->tDefs.xLd : ptPidCtl->xTotalError;
+	ptPidCtl->xTotalError = ( ptPidCtl->xTotalError < -ptPidCtl->tDefs.xLd ) ? -ptPidCtl->tDefs.xLd : ptPidCtl->xTotalError;
 
  // compute derivative
   ptPidCtl->xLastError = ptPidCtl->xCurError;
@@ -101,4 +108,307 @@ PIDCONTROLARG PidControl_Process( PPIDCTRL ptPidCtl, PIDCONTROLARG xSetPoint, PI
 	return( xOutput );
 }
 
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+/******************************************************************************
+ * @function PidControl_BankInitialize
+ *
+ * @brief initialize a bank of fixed point loops
+ *
+ * This function will clear each loop of the bank, place it in automatic and
+ * load its countdown with the phase so the loops sharing a rate can be spread
+ * across the ticks
+ *
+ * @param[in]   ptBank        pointer to the bank
+ *
+ *****************************************************************************/
+void PidControl_BankInitialize( PPIDBANK ptBank )
+{
+  U8            nLoop;
+  PPIDBANKLOOP  ptLoop;
+
+  // for each loop
+  for ( nLoop = 0; nLoop < MIN( ptBank->nNumLoops, PIDCONTROL_BANK_MAX_LOOPS ); nLoop++ )
+  {
+    // clear it and set the phase
+    ptLoop = &ptBank->ptLoops[ nLoop ];
+    memset( ptLoop, 0, PIDBANKLOOP_SIZE );
+    ptLoop->wCountdown = ptBank->ptDefs[ nLoop ].wPhaseTicks;
+  }
+}
+
+/******************************************************************************
+ * @function PidControl_BankProcess
+ *
+ * @brief process one tick of a bank
+ *
+ * This function will count down each loop and execute the loops that are due,
+ * using the set points and process variables the caller has written into the
+ * loops.  It is called from a single task at the base rate of the bank.
+ *
+ * @param[in]   ptBank        pointer to the bank
+ *
+ * @return      mask of the loops executed on this tick
+ *
+ *****************************************************************************/
+U32 PidControl_BankProcess( PPIDBANK ptBank )
+{
+  U8                nLoop;
+  U32               uMask = 0;
+  PPIDBANKLOOP      ptLoop;
+  const PIDBANKDEF* ptDef;
+
+  // for each loop
+  for ( nLoop = 0; nLoop < MIN( ptBank->nNumLoops, PIDCONTROL_BANK_MAX_LOOPS ); nLoop++ )
+  {
+    ptLoop = &ptBank->ptLoops[ nLoop ];
+    ptDef = &ptBank->ptDefs[ nLoop ];
+
+    // check for due
+    if ( ptLoop->wCountdown == 0 )
+    {
+      // execute it and reload the countdown
+      BankExecuteLoop( ptDef, ptLoop );
+      ptLoop->wCountdown = ( ptDef->wRateTicks > 1 ) ? ptDef->wRateTicks - 1 : 0;
+      uMask |= ( 1UL << nLoop );
+    }
+    else
+    {
+      // count it down
+      ptLoop->wCountdown--;
+    }
+  }
+
+  // return the mask
+  return( uMask );
+}
+
+/******************************************************************************
+ * @function PidControl_BankSetManual
+ *
+ * @brief place a loop in manual
+ *
+ * This function will place a loop in manual with the given output.  While in
+ * manual the integral tracks the output so the return to automatic is
+ * bumpless.
+ *
+ * @param[in]   ptBank        pointer to the bank
+ * @param[in]   nLoop         loop index
+ * @param[in]   lOutput       manual output, Q16.16
+ *
+ *****************************************************************************/
+void PidControl_BankSetManual( PPIDBANK ptBank, U8 nLoop, S32 lOutput )
+{
+  PPIDBANKLOOP      ptLoop;
+  const PIDBANKDEF* ptDef;
+
+  // check for a valid loop
+  if ( nLoop < ptBank->nNumLoops )
+  {
+    // clamp the output and set manual
+    ptLoop = &ptBank->ptLoops[ nLoop ];
+    ptDef = &ptBank->ptDefs[ nLoop ];
+    ptLoop->lManualOutput = CONSTRAIN( lOutput, ptDef->lMinOutput, ptDef->lMaxOutput );
+    ptLoop->lOutput = ptLoop->lManualOutput;
+    ptLoop->bManual = TRUE;
+  }
+}
+
+/******************************************************************************
+ * @function PidControl_BankSetAuto
+ *
+ * @brief return a loop to automatic
+ *
+ * This function will return a loop to automatic, it resumes from the
+ * integral that tracked the manual output
+ *
+ * @param[in]   ptBank        pointer to the bank
+ * @param[in]   nLoop         loop index
+ *
+ *****************************************************************************/
+void PidControl_BankSetAuto( PPIDBANK ptBank, U8 nLoop )
+{
+  // check for a valid loop
+  if ( nLoop < ptBank->nNumLoops )
+  {
+    // clear manual
+    ptBank->ptLoops[ nLoop ].bManual = FALSE;
+  }
+}
+
+/******************************************************************************
+ * @function BankExecuteLoop
+ *
+ * @brief execute one loop
+ *
+ * This function will execute one loop.  The derivative is taken on the
+ * measurement through a first order filter so set point steps do not kick
+ * the output.  The integral is held in output units so gain changes are
+ * bumpless, and the difference between the saturated and unsaturated output
+ * is fed back through the back calculation gain to unwind it.
+ *
+ * @param[in]   ptDef         pointer to the loop definition
+ * @param[in]   ptLoop        pointer to the loop
+ *
+ *****************************************************************************/
+static void BankExecuteLoop( const PIDBANKDEF* ptDef, PPIDBANKLOOP ptLoop )
+{
+  S32 lKp, lKi, lKd;
+  S32 lError, lProp, lDeriv, lUnsat, lOutput;
+
+  // get the gains and the error
+  BankGetGains( ptDef, ptLoop, &lKp, &lKi, &lKd );
+  lError = BankSaturate(( S64 )ptLoop->lSetPoint - ptLoop->lProcVar );
+  lProp = BankMultiply( lKp, lError );
+
+  // filtered derivative on the measurement
+  if ( !ptLoop->bPrimed )
+  {
+    ptLoop->lLastProcVar = ptLoop->lProcVar;
+    ptLoop->bPrimed = TRUE;
+  }
+  lDeriv = BankMultiply( lKd, BankSaturate(( S64 )ptLoop->lLastProcVar - ptLoop->lProcVar ));
+  ptLoop->lDerivative = BankSaturate(( S64 )ptLoop->lDerivative + BankMultiply( ptDef->lDerivAlpha, BankSaturate(( S64 )lDeriv - ptLoop->lDerivative )));
+  ptLoop->lLastProcVar = ptLoop->lProcVar;
+
+  // check for manual
+  if ( ptLoop->bManual )
+  {
+    // track the manual output with the integral
+    lOutput = ptLoop->lManualOutput;
+    ptLoop->lIntegral = BankSaturate(( S64 )lOutput - lProp - ptLoop->lDerivative );
+  }
+  else
+  {
+    // integrate, compute and clamp the output
+    ptLoop->lIntegral = BankSaturate(( S64 )ptLoop->lIntegral + BankMultiply( lKi, lError ));
+    lUnsat = BankSaturate(( S64 )lProp + ptLoop->lIntegral + ptLoop->lDerivative );
+    lOutput = CONSTRAIN( lUnsat, ptDef->lMinOutput, ptDef->lMaxOutput );
+
+    // back calculate the integral
+    ptLoop->lIntegral = BankSaturate(( S64 )ptLoop->lIntegral + BankMultiply( ptDef->lKb, BankSaturate(( S64 )lOutput - lUnsat )));
+  }
+
+  // store the output
+  ptLoop->lOutput = lOutput;
+}
+
+/******************************************************************************
+ * @function BankGetGains
+ *
+ * @brief get the gains of a loop
+ *
+ * This function will return the fixed gains or interpolate the gain schedule
+ * on the selected schedule variable, clamping to the end entries
+ *
+ * @param[in]   ptDef         pointer to the loop definition
+ * @param[in]   ptLoop        pointer to the loop
+ * @param[io]   plKp          pointer to the proportional gain
+ * @param[io]   plKi          pointer to the integral gain
+ * @param[io]   plKd          pointer to the derivative gain
+ *
+ *****************************************************************************/
+static void BankGetGains( const PIDBANKDEF* ptDef, PPIDBANKLOOP ptLoop, PS32 plKp, PS32 plKi, PS32 plKd )
+{
+  const PIDSCHEDENTRY*  ptLo;
+  const PIDSCHEDENTRY*  ptHi;
+  S32                   lVar, lFrac;
+  U8                    nIdx;
+
+  // get the schedule variable
+  switch( ptDef->eSchedSource )
+  {
+    case PIDCONTROL_SCHED_SETPOINT :
+      lVar = ptLoop->lSetPoint;
+      break;
+
+    case PIDCONTROL_SCHED_PROCVAR :
+      lVar = ptLoop->lProcVar;
+      break;
+
+    case PIDCONTROL_SCHED_EXTERNAL :
+      lVar = ptLoop->lSchedVar;
+      break;
+
+    default :
+      lVar = 0;
+      break;
+  }
+
+  // check for fixed gains
+  if (( ptDef->ptSchedule == NULL ) || ( ptDef->nNumSchedule == 0 ) || ( ptDef->eSchedSource == PIDCONTROL_SCHED_NONE ))
+  {
+    *plKp = ptDef->lKp;
+    *plKi = ptDef->lKi;
+    *plKd = ptDef->lKd;
+  }
+  else
+  {
+    // find the segment
+    for ( nIdx = 1; ( nIdx < ptDef->nNumSchedule - 1 ) && ( lVar >= ptDef->ptSchedule[ nIdx ].lBreakPoint ); nIdx++ );
+    ptLo = &ptDef->ptSchedule[ nIdx - 1 ];
+    ptHi = &ptDef->ptSchedule[ MIN( nIdx, ptDef->nNumSchedule - 1 )];
+
+    // compute the fraction, clamped to the ends
+    if (( ptHi == ptLo ) || ( lVar <= ptLo->lBreakPoint ))
+    {
+      lFrac = 0;
+    }
+    else if ( lVar >= ptHi->lBreakPoint )
+    {
+      lFrac = PIDCONTROL_Q16_ONE;
+    }
+    else
+    {
+      lFrac = ( S32 )(((( S64 )lVar - ptLo->lBreakPoint ) << 16 ) / (( S64 )ptHi->lBreakPoint - ptLo->lBreakPoint ));
+    }
+
+    // interpolate the gains
+    *plKp = ptLo->lKp + BankMultiply( lFrac, ptHi->lKp - ptLo->lKp );
+    *plKi = ptLo->lKi + BankMultiply( lFrac, ptHi->lKi - ptLo->lKi );
+    *plKd = ptLo->lKd + BankMultiply( lFrac, ptHi->lKd - ptLo->lKd );
+  }
+}
+
+/******************************************************************************
+ * @function BankMultiply
+ *
+ * @brief Q16.16 multiply
+ *
+ * This function will multiply two Q16.16 values, rounding and saturating the
+ * result
+ *
+ * @param[in]   lA            first value
+ * @param[in]   lB            second value
+ *
+ * @return      product
+ *
+ *****************************************************************************/
+static S32 BankMultiply( S32 lA, S32 lB )
+{
+  // multiply, round and saturate
+  return( BankSaturate(((( S64 )lA * lB ) + 0x8000 ) >> 16 ));
+}
+
+/******************************************************************************
+ * @function BankSaturate
+ *
+ * @brief saturate to 32 bits
+ *
+ * This function will saturate a 64 bit value to the 32 bit range
+ *
+ * @param[in]   hValue        value
+ *
+ * @return      saturated value
+ *
+ *****************************************************************************/
+static S32 BankSaturate( S64 hValue )
+{
+  // clamp it
+  hValue = CONSTRAIN( hValue, ( S64 )( -0x7FFFFFFFL - 1 ), ( S64 )0x7FFFFFFFL );
+
+  // return it
+  return(( S32 )hValue );
+}
+#endif // PIDCONTROL_ENABLE_BANK
+
 /**@} EOF PidControl.c */
@@ -53,6 +53,72 @@
   #error Illegal PID arugment type
 #endif // PIDCONTROL_ARG_TYPE
 
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+/// define the Q16.16 one and the conversion macros
+#define PIDCONTROL_Q16_ONE                      ( 65536L )
+#define PIDCONTROL_Q16( f )                     (( S32 )((( f ) * 65536.0 ) + ((( f ) < 0 ) ? -0.5 : 0.5 )))
+#define PIDCONTROL_Q16_TO_FLOAT( q )            (( FLOAT )( q ) / 65536.0f )
+
+/// define the maximum number of loops in a bank, one bit each in the process mask
+#define PIDCONTROL_BANK_MAX_LOOPS               ( 32 )
+
+/// define the helper macro for a fixed gain bank loop
+#define PIDCONTROL_BANKDEF( kp, ki, kd, kb, alpha, min, max, rate, phase ) \
+  { \
+    .lKp          = PIDCONTROL_Q16( kp ), \
+    .lKi          = PIDCONTROL_Q16( ki ), \
+    .lKd          = PIDCONTROL_Q16( kd ), \
+    .lKb          = PIDCONTROL_Q16( kb ), \
+    .lDerivAlpha  = PIDCONTROL_Q16( alpha ), \
+    .lMinOutput   = PIDCONTROL_Q16( min ), \
+    .lMaxOutput   = PIDCONTROL_Q16( max ), \
+    .ptSchedule   = NULL, \
+    .nNumSchedule = 0, \
+    .eSchedSource = PIDCONTROL_SCHED_NONE, \
+    .wRateTicks   = rate, \
+    .wPhaseTicks  = phase, \
+  }
+
+/// define the helper macro for a gain scheduled bank loop
+#define PIDCONTROL_BANKDEFSCHED( sched, source, kb, alpha, min, max, rate, phase ) \
+  { \
+    .lKp          = 0, \
+    .lKi          = 0, \
+    .lKd          = 0, \
+    .lKb          = PIDCONTROL_Q16( kb ), \
+    .lDerivAlpha  = PIDCONTROL_Q16( alpha ), \
+    .lMinOutput   = PIDCONTROL_Q16( min ), \
+    .lMaxOutput   = PIDCONTROL_Q16( max ), \
+    .ptSchedule   = sched, \
+    .nNumSchedule = sizeof( sched ) / sizeof( PIDSCHEDENTRY ), \
+    .eSchedSource = source, \
+    .wRateTicks   = rate, \
+    .wPhaseTicks  = phase, \
+  }
+
+/// define the helper macro for a gain schedule entry
+#define PIDCONTROL_SCHEDENTRY( bp, kp, ki, kd ) \
+  { \
+    .lBreakPoint  = PIDCONTROL_Q16( bp ), \
+    .lKp          = PIDCONTROL_Q16( kp ), \
+    .lKi          = PIDCONTROL_Q16( ki ), \
+    .lKd          = PIDCONTROL_Q16( kd ), \
+  }
+#endif // PIDCONTROL_ENABLE_BANK
+
+// enumerations ---------------------------------------------------------------
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+/// enumerate the gain schedule sources
+typedef enum _PIDSCHEDSRC
+{
+  PIDCONTROL_SCHED_NONE = 0,        ///< fixed gains
+  PIDCONTROL_SCHED_SETPOINT,        ///< scheduled on the set point
+  PIDCONTROL_SCHED_PROCVAR,         ///< scheduled on the process variable
+  PIDCONTROL_SCHED_EXTERNAL,        ///< scheduled on the external variable
+  PIDCONTROL_SCHED_MAX
+} PIDSCHEDSRC;
+#endif // PIDCONTROL_ENABLE_BANK
+
 // structures -----------------------------------------------------------------
 /// define the definition structure
 typedef struct _PIDCONTROLDEF
@@ -77,9 +143,71 @@ typedef struct _PIDCONTROLVAR
 } PIDCONTROLVAR, *PPIDCONTROLVAR;
 #define PIDCONTROLVAR_SIZE                            sizeof( PIDCONTROLVAR )
 
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+/// define the gain schedule entry, gains are interpolated between entries
+typedef struct _PIDSCHEDENTRY
+{
+  S32           lBreakPoint;      ///< schedule variable, Q16.16, ascending
+  S32           lKp;              ///< proportional gain, Q16.16
+  S32           lKi;              ///< integral gain per execution, Q16.16
+  S32           lKd;              ///< derivative gain per execution, Q16.16
+} PIDSCHEDENTRY, *PPIDSCHEDENTRY;
+#define PIDSCHEDENTRY_SIZE                            sizeof( PIDSCHEDENTRY )
+
+/// define the bank loop definition structure
+typedef struct _PIDBANKDEF
+{
+  S32                   lKp;              ///< proportional gain, Q16.16
+  S32                   lKi;              ///< integral gain per execution, Q16.16
+  S32                   lKd;              ///< derivative gain per execution, Q16.16
+  S32                   lKb;              ///< back calculation anti-windup gain, Q16.16
+  S32                   lDerivAlpha;      ///< derivative filter coefficient, Q16.16, one for no filter
+  S32                   lMinOutput;       ///< minimum output level, Q16.16
+  S32                   lMaxOutput;       ///< maximum output level, Q16.16
+  const PIDSCHEDENTRY*  ptSchedule;       ///< gain schedule, NULL for the fixed gains
+  U8                    nNumSchedule;     ///< number of schedule entries
+  PIDSCHEDSRC           eSchedSource;     ///< gain schedule source
+  U16                   wRateTicks;       ///< execute every N bank ticks
+  U16                   wPhaseTicks;      ///< ticks before the first execution
+} PIDBANKDEF, *PPIDBANKDEF;
+#define PIDBANKDEF_SIZE                               sizeof( PIDBANKDEF )
+
+/// define the bank loop structure
+typedef struct _PIDBANKLOOP
+{
+  S32           lSetPoint;        ///< set point, Q16.16, written by the caller
+  S32           lProcVar;         ///< process variable, Q16.16, written by the caller
+  S32           lSchedVar;        ///< external schedule variable, Q16.16, written by the caller
+  S32           lOutput;          ///< output, Q16.16, read by the caller
+  S32           lIntegral;        ///< integral term in output units
+  S32           lDerivative;      ///< filtered derivative term in output units
+  S32           lLastProcVar;     ///< previous process variable
+  S32           lManualOutput;    ///< manual output
+  U16           wCountdown;       ///< ticks to the next execution
+  BOOL          bManual;          ///< manual mode
+  BOOL          bPrimed;          ///< previous process variable is valid
+} PIDBANKLOOP, *PPIDBANKLOOP;
+#define PIDBANKLOOP_SIZE                              sizeof( PIDBANKLOOP )
+
+/// define the bank structure
+typedef struct _PIDBANK
+{
+  const PIDBANKDEF*     ptDefs;           ///< pointer to the loop definitions
+  PPIDBANKLOOP          ptLoops;          ///< pointer to the loops
+  U8                    nNumLoops;        ///< number of loops
+} PIDBANK, *PPIDBANK;
+#define PIDBANK_SIZE                                  sizeof( PIDBANK )
+#endif // PIDCONTROL_ENABLE_BANK
+
 // global function prototypes --------------------------------------------------
 extern  void            PidControl_Initialize( void );
 extern  PIDCONTROLARG   PidControl_Process( PPIDCONTROLVAR ptPidCtl, PIDCONTROLARG xSetPoint, PIDCONTROLARG xProcVar );
+#if ( PIDCONTROL_ENABLE_BANK == ON )
+extern  void            PidControl_BankInitialize( PPIDBANK ptBank );
+extern  U32             PidControl_BankProcess( PPIDBANK ptBank );
+extern  void            PidControl_BankSetManual( PPIDBANK ptBank, U8 nLoop, S32 lOutput );
+extern  void            PidControl_BankSetAuto( PPIDBANK ptBank, U8 nLoop );
+#endif // PIDCONTROL_ENABLE_BANK
 
 /**@} EOF PidControl.h */
 
@@ -0,0 +1,633 @@
+/******************************************************************************
+ * @file PidControlBankTest.c
+ *
+ * @brief PID control bank test
+ *
+ * This file provides a host tool that runs the fixed point PID bank against
+ * the float PID on simulated first order plants.  The match check runs 16
+ * unsaturated loops on both and reports the largest output and process
+ * variable differences, the windup check steps a saturating plant with and
+ * without the anti-windup of each, the bumpless check switches a loop from
+ * manual to automatic, the schedule check verifies the gain interpolation and
+ * the rate check counts the executions of mixed rate loops.  It then times a
+ * bank update and reports the time and the host cycles per loop.  It exits
+ * non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o PidControlBankTest
+ *             PidControlBankTest.c ../../Core/Trunk/PidControl.c
+ * usage:      PidControlBankTest
+ *
+ * @copyright Copyright (c) 2012CyberIntegration
+ * This document contains proprietary data and information ofCyberIntegration
+ * LLC. It is the exclusive property ofCyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ *CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission ofCyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup PidControl
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+// local includes -------------------------------------------------------------
+#include "PID/PidControl.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of loops
+#define NUM_LOOPS                                   ( 16 )
+
+/// define the match run length
+#define MATCH_STEPS                                 ( 2000 )
+
+/// define the windup run length
+#define WINDUP_STEPS                                ( 600 )
+
+/// define the number of timing ticks
+#define TIMING_TICKS                                ( 200000 )
+
+/// define the allowed output difference in the match check
+#define MATCH_LIMIT                                 ( 0.05 )
+
+/// define the windup plant and limits
+#define WINDUP_SETPOINT                             ( 80.0 )
+#define WINDUP_KP                                   ( 2.0 )
+#define WINDUP_KI                                   ( 0.2 )
+#define WINDUP_MAX                                  ( 100.0 )
+
+// structures -----------------------------------------------------------------
+/// define the plant structure, a first order lag
+typedef struct _PLANT
+{
+  double  dGain;            ///< steady state gain
+  double  dAlpha;           ///< step over the time constant
+  double  dOutput;          ///< output
+} PLANT, *PPLANT;
+
+// local parameter declarations -----------------------------------------------
+static  PIDBANKDEF      atDefs[ NUM_LOOPS ];
+static  PIDBANKLOOP     atLoops[ NUM_LOOPS ];
+static  PIDBANK         tBank = { atDefs, atLoops, NUM_LOOPS };
+static  PIDCONTROLVAR   atFloat[ NUM_LOOPS ];
+static  PLANT           atFloatPlants[ NUM_LOOPS ];
+static  PLANT           atBankPlants[ NUM_LOOPS ];
+
+/// define the schedule for the schedule check
+static  const PIDSCHEDENTRY atSchedule[ ] =
+{
+  PIDCONTROL_SCHEDENTRY(   0.0, 1.0, 0.0, 0.0 ),
+  PIDCONTROL_SCHEDENTRY(  50.0, 2.0, 0.0, 0.0 ),
+  PIDCONTROL_SCHEDENTRY( 100.0, 4.0, 0.0, 0.0 ),
+};
+
+// local function prototypes --------------------------------------------------
+static  double  PlantStep( PPLANT ptPlant, double dInput );
+static  int     RunMatch( void );
+static  double  RunWindupFloat( double dLimit );
+static  double  RunWindupBank( double dKb );
+static  int     RunWindup( void );
+static  int     RunBumpless( void );
+static  int     RunSchedule( void );
+static  int     RunRates( void );
+static  void    RunTiming( void );
+static  double  GetTime( void );
+static  unsigned long long  GetCycles( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check and the timing
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+
+  // run the checks
+  iErrors += RunMatch( );
+  iErrors += RunWindup( );
+  iErrors += RunBumpless( );
+  iErrors += RunSchedule( );
+  iErrors += RunRates( );
+  RunTiming( );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function PlantStep
+ *
+ * @brief step a plant
+ *
+ * This function will step a first order plant one sample
+ *
+ * @param[in]   ptPlant     pointer to the plant
+ * @param[in]   dInput      input
+ *
+ * @return      plant output
+ *
+ *****************************************************************************/
+static double PlantStep( PPLANT ptPlant, double dInput )
+{
+  // step it
+  ptPlant->dOutput += ptPlant->dAlpha * (( ptPlant->dGain * dInput ) - ptPlant->dOutput );
+  return( ptPlant->dOutput );
+}
+
+/******************************************************************************
+ * @function RunMatch
+ *
+ * @brief match check
+ *
+ * This function will run 16 unsaturated loops on the float PID and the bank
+ * with the same gains and compare the outputs and process variables
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunMatch( void )
+{
+  int     iLoop, iStep, iErrors = 0;
+  double  dKp, dKi, dKd, dSetPoint, dBankOut;
+  double  adFloatOut[ NUM_LOOPS ];
+  double  dMaxOut = 0, dMaxPv = 0;
+
+  // set up the loops
+  srand( 1 );
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    dKp = 0.5 + ( rand( ) % 100 ) / 100.0;
+    dKi = 0.02 + ( rand( ) % 100 ) / 2000.0;
+    dKd = ( rand( ) % 100 ) / 100.0;
+    atDefs[ iLoop ] = ( PIDBANKDEF )PIDCONTROL_BANKDEF( dKp, dKi, dKd, 0.5, 1.0, -1000.0, 1000.0, 1, 0 );
+    memset( &atFloat[ iLoop ], 0, PIDCONTROLVAR_SIZE );
+    atFloat[ iLoop ].tDefs.xKp = PIDCONTROL_Q16_TO_FLOAT( atDefs[ iLoop ].lKp );
+    atFloat[ iLoop ].tDefs.xKi = PIDCONTROL_Q16_TO_FLOAT( atDefs[ iLoop ].lKi );
+    atFloat[ iLoop ].tDefs.xKd = PIDCONTROL_Q16_TO_FLOAT( atDefs[ iLoop ].lKd );
+    atFloat[ iLoop ].tDefs.xLd = 1.0e9f;
+    atFloat[ iLoop ].tDefs.xMinOutput = -1000.0f;
+    atFloat[ iLoop ].tDefs.xMaxOutput = 1000.0f;
+    atFloatPlants[ iLoop ].dGain = 0.5 + ( rand( ) % 100 ) / 50.0;
+    atFloatPlants[ iLoop ].dAlpha = 0.01 + ( rand( ) % 100 ) / 1000.0;
+    atFloatPlants[ iLoop ].dOutput = 0;
+    atBankPlants[ iLoop ] = atFloatPlants[ iLoop ];
+  }
+  PidControl_BankInitialize( &tBank );
+
+  // run them, the float PID starts with the initial error to match the derivative on measurement
+  for ( iStep = 0; iStep < MATCH_STEPS; iStep++ )
+  {
+    for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      dSetPoint = 10.0 + iLoop * 5.0;
+      if ( iStep == 0 )
+      {
+        atFloat[ iLoop ].xCurError = dSetPoint;
+      }
+      atLoops[ iLoop ].lSetPoint = PIDCONTROL_Q16( dSetPoint );
+      atLoops[ iLoop ].lProcVar = PIDCONTROL_Q16( atBankPlants[ iLoop ].dOutput );
+      adFloatOut[ iLoop ] = PidControl_Process( &atFloat[ iLoop ], dSetPoint, atFloatPlants[ iLoop ].dOutput );
+      PlantStep( &atFloatPlants[ iLoop ], adFloatOut[ iLoop ] );
+    }
+    PidControl_BankProcess( &tBank );
+    for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      dBankOut = PIDCONTROL_Q16_TO_FLOAT( atLoops[ iLoop ].lOutput );
+      PlantStep( &atBankPlants[ iLoop ], dBankOut );
+      dMaxPv = fmax( dMaxPv, fabs( atBankPlants[ iLoop ].dOutput - atFloatPlants[ iLoop ].dOutput ));
+      dMaxOut = fmax( dMaxOut, fabs( dBankOut - adFloatOut[ iLoop ] ));
+    }
+  }
+
+  // report
+  printf( "match: %d loops %d steps, max output difference %.4f, max process variable difference %.4f\n", NUM_LOOPS, MATCH_STEPS, dMaxOut, dMaxPv );
+  if (( dMaxOut > MATCH_LIMIT ) || ( dMaxPv > MATCH_LIMIT ))
+  {
+    printf( "  error: difference exceeds %.2f\n", MATCH_LIMIT );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunWindupFloat
+ *
+ * @brief windup run on the float PID
+ *
+ * This function will step the windup plant with the float PID
+ *
+ * @param[in]   dLimit      integral limit
+ *
+ * @return      overshoot
+ *
+ *****************************************************************************/
+static double RunWindupFloat( double dLimit )
+{
+  PIDCONTROLVAR tPid;
+  PLANT         tPlant = { 1.0, 0.05, 0.0 };
+  double        dPeak = 0;
+  int           iStep;
+
+  // set up the PID
+  memset( &tPid, 0, PIDCONTROLVAR_SIZE );
+  tPid.tDefs.xKp = WINDUP_KP;
+  tPid.tDefs.xKi = WINDUP_KI;
+  tPid.tDefs.xLd = dLimit;
+  tPid.tDefs.xMinOutput = 0.0f;
+  tPid.tDefs.xMaxOutput = WINDUP_MAX;
+  tPid.xCurError = WINDUP_SETPOINT;
+
+  // run it
+  for ( iStep = 0; iStep < WINDUP_STEPS; iStep++ )
+  {
+    PlantStep( &tPlant, PidControl_Process( &tPid, WINDUP_SETPOINT, tPlant.dOutput ));
+    dPeak = fmax( dPeak, tPlant.dOutput );
+  }
+
+  // return the overshoot
+  return( dPeak - WINDUP_SETPOINT );
+}
+
+/******************************************************************************
+ * @function RunWindupBank
+ *
+ * @brief windup run on the bank
+ *
+ * This function will step the windup plant with a single loop bank
+ *
+ * @param[in]   dKb         back calculation gain
+ *
+ * @return      overshoot
+ *
+ *****************************************************************************/
+static double RunWindupBank( double dKb )
+{
+  PIDBANKDEF    tDef = PIDCONTROL_BANKDEF( WINDUP_KP, WINDUP_KI, 0.0, dKb, 1.0, 0.0, WINDUP_MAX, 1, 0 );
+  PIDBANKLOOP   tLoop;
+  PIDBANK       tWind = { &tDef, &tLoop, 1 };
+  PLANT         tPlant = { 1.0, 0.05, 0.0 };
+  double        dPeak = 0;
+  int           iStep;
+
+  // run it
+  PidControl_BankInitialize( &tWind );
+  tLoop.lSetPoint = PIDCONTROL_Q16( WINDUP_SETPOINT );
+  for ( iStep = 0; iStep < WINDUP_STEPS; iStep++ )
+  {
+    tLoop.lProcVar = PIDCONTROL_Q16( tPlant.dOutput );
+    PidControl_BankProcess( &tWind );
+    PlantStep( &tPlant, PIDCONTROL_Q16_TO_FLOAT( tLoop.lOutput ));
+    dPeak = fmax( dPeak, tPlant.dOutput );
+  }
+
+  // return the overshoot
+  return( dPeak - WINDUP_SETPOINT );
+}
+
+/******************************************************************************
+ * @function RunWindup
+ *
+ * @brief windup check
+ *
+ * This function will step a saturating plant with the float PID with and
+ * without its integral limit and with the bank with and without back
+ * calculation, the back calculation must cut the overshoot
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunWindup( void )
+{
+  double  dFloatNone, dFloatLimit, dBankNone, dBankBack;
+  int     iErrors = 0;
+
+  // run each
+  dFloatNone = RunWindupFloat( 1.0e9 );
+  dFloatLimit = RunWindupFloat( WINDUP_MAX / WINDUP_KI );
+  dBankNone = RunWindupBank( 0.0 );
+  dBankBack = RunWindupBank( 0.5 );
+
+  // report
+  printf( "windup: overshoot float %.2f, float integral limit %.2f, bank %.2f, bank back calculation %.2f\n",
+          dFloatNone, dFloatLimit, dBankNone, dBankBack );
+  if ( fabs( dFloatNone - dBankNone ) > MATCH_LIMIT )
+  {
+    printf( "  error: bank without back calculation does not match the float PID\n" );
+    iErrors++;
+  }
+  if ( dBankBack >= dBankNone )
+  {
+    printf( "  error: back calculation did not reduce the overshoot\n" );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunBumpless
+ *
+ * @brief bumpless check
+ *
+ * This function will settle a plant in manual, then return it to automatic
+ * with a new set point and check the output continues from the manual output
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunBumpless( void )
+{
+  PIDBANKDEF    tDef = PIDCONTROL_BANKDEF( 2.0, 0.1, 1.0, 0.5, 0.25, 0.0, 100.0, 1, 0 );
+  PIDBANKLOOP   tLoop;
+  PIDBANK       tBump = { &tDef, &tLoop, 1 };
+  PLANT         tPlant = { 1.0, 0.05, 0.0 };
+  double        dManual = 30.0, dBefore, dAfter, dStep, dLimit;
+  int           iStep, iErrors = 0;
+
+  // settle in manual
+  PidControl_BankInitialize( &tBump );
+  PidControl_BankSetManual( &tBump, 0, PIDCONTROL_Q16( dManual ));
+  tLoop.lSetPoint = PIDCONTROL_Q16( 50.0 );
+  for ( iStep = 0; iStep < 200; iStep++ )
+  {
+    tLoop.lProcVar = PIDCONTROL_Q16( tPlant.dOutput );
+    PidControl_BankProcess( &tBump );
+    if ( tLoop.lOutput != PIDCONTROL_Q16( dManual ))
+    {
+      printf( "  error: manual output not held at step %d\n", iStep );
+      iErrors++;
+      break;
+    }
+    PlantStep( &tPlant, PIDCONTROL_Q16_TO_FLOAT( tLoop.lOutput ));
+  }
+  dBefore = PIDCONTROL_Q16_TO_FLOAT( tLoop.lOutput );
+
+  // return to automatic, the only change allowed is one integral step
+  PidControl_BankSetAuto( &tBump, 0 );
+  tLoop.lProcVar = PIDCONTROL_Q16( tPlant.dOutput );
+  PidControl_BankProcess( &tBump );
+  dAfter = PIDCONTROL_Q16_TO_FLOAT( tLoop.lOutput );
+  dStep = dAfter - dBefore;
+  dLimit = ( 0.1 * fabs( 50.0 - tPlant.dOutput )) + 0.01;
+  printf( "bumpless: manual %.2f, first automatic %.2f, step %.3f, limit %.3f\n", dBefore, dAfter, dStep, dLimit );
+  if ( fabs( dStep ) > dLimit )
+  {
+    printf( "  error: transfer bumped the output\n" );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunSchedule
+ *
+ * @brief schedule check
+ *
+ * This function will check the interpolated proportional gain across and
+ * beyond the schedule
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunSchedule( void )
+{
+  PIDBANKDEF    tDef = PIDCONTROL_BANKDEFSCHED( atSchedule, PIDCONTROL_SCHED_PROCVAR, 0.0, 1.0, -1000.0, 1000.0, 1, 0 );
+  PIDBANKLOOP   tLoop;
+  PIDBANK       tSched = { &tDef, &tLoop, 1 };
+  static const double adProcVars[ ] = { -10.0, 0.0, 25.0, 50.0, 75.0, 100.0, 200.0 };
+  static const double adGains[ ] = { 1.0, 1.0, 1.5, 2.0, 3.0, 4.0, 4.0 };
+  double        dGain;
+  int           iIdx, iErrors = 0;
+
+  // for each point
+  printf( "schedule:" );
+  for ( iIdx = 0; iIdx < ( int )( sizeof( adProcVars ) / sizeof( double )); iIdx++ )
+  {
+    // unit error gives the gain
+    PidControl_BankInitialize( &tSched );
+    tLoop.lProcVar = PIDCONTROL_Q16( adProcVars[ iIdx ] );
+    tLoop.lSetPoint = PIDCONTROL_Q16( adProcVars[ iIdx ] + 1.0 );
+    PidControl_BankProcess( &tSched );
+    dGain = PIDCONTROL_Q16_TO_FLOAT( tLoop.lOutput );
+    printf( " %.0f:%.3f", adProcVars[ iIdx ], dGain );
+    if ( fabs( dGain - adGains[ iIdx ] ) > 0.001 )
+    {
+      printf( "\n  error: gain at %.0f is %.4f expected %.4f", adProcVars[ iIdx ], dGain, adGains[ iIdx ] );
+      iErrors++;
+    }
+  }
+  printf( "\n" );
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunRates
+ *
+ * @brief rate check
+ *
+ * This function will run loops at one, two, four and eight ticks with phases
+ * spreading each rate and check the execution counts and the peak loops per
+ * tick
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunRates( void )
+{
+  int   iLoop, iTick, iCount, iPeak = 0, iErrors = 0;
+  int   aiCounts[ NUM_LOOPS ] = { 0 };
+  U32   uMask;
+  U16   wRate;
+
+  // set up the loops
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    wRate = 1 << ( iLoop % 4 );
+    atDefs[ iLoop ] = ( PIDBANKDEF )PIDCONTROL_BANKDEF( 1.0, 0.0, 0.0, 0.0, 1.0, -1000.0, 1000.0, wRate, ( iLoop / 4 ) % wRate );
+  }
+  PidControl_BankInitialize( &tBank );
+
+  // run them
+  for ( iTick = 0; iTick < 800; iTick++ )
+  {
+    uMask = PidControl_BankProcess( &tBank );
+    for ( iLoop = 0, iCount = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      if ( uMask & ( 1UL << iLoop ))
+      {
+        aiCounts[ iLoop ]++;
+        iCount++;
+      }
+    }
+    iPeak = ( iCount > iPeak ) ? iCount : iPeak;
+  }
+
+  // check the counts
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    if ( aiCounts[ iLoop ] != ( 800 >> ( iLoop % 4 )))
+    {
+      printf( "  error: loop %d executed %d expected %d\n", iLoop, aiCounts[ iLoop ], 800 >> ( iLoop % 4 ));
+      iErrors++;
+    }
+  }
+  printf( "rates: 1/2/4/8 ticks, peak %d loops per tick, %.2f average\n", iPeak, ( 800 + 400 + 200 + 100 ) * 4 / 800.0 );
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief timing
+ *
+ * This function will time the float PID, the fixed gain bank and the
+ * scheduled bank and report the time and the host cycles per loop
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  int                 iLoop, iTick;
+  double              dStart, dFloat, dFixed, dSched;
+  unsigned long long  ullStart, ullFloat, ullFixed, ullSched;
+  volatile FLOAT      fSink = 0;
+  double              dLoops = ( double )TIMING_TICKS * NUM_LOOPS;
+
+  // float PID
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    memset( &atFloat[ iLoop ], 0, PIDCONTROLVAR_SIZE );
+    atFloat[ iLoop ].tDefs.xKp = 1.0f;
+    atFloat[ iLoop ].tDefs.xKi = 0.01f;
+    atFloat[ iLoop ].tDefs.xKd = 0.5f;
+    atFloat[ iLoop ].tDefs.xLd = 1000.0f;
+    atFloat[ iLoop ].tDefs.xMinOutput = -100.0f;
+    atFloat[ iLoop ].tDefs.xMaxOutput = 100.0f;
+  }
+  dStart = GetTime( );
+  ullStart = GetCycles( );
+  for ( iTick = 0; iTick < TIMING_TICKS; iTick++ )
+  {
+    for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      fSink = PidControl_Process( &atFloat[ iLoop ], 50.0f, ( FLOAT )(( iTick + iLoop ) & 0x3F ));
+    }
+  }
+  ullFloat = GetCycles( ) - ullStart;
+  dFloat = GetTime( ) - dStart;
+
+  // fixed gain bank
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    atDefs[ iLoop ] = ( PIDBANKDEF )PIDCONTROL_BANKDEF( 1.0, 0.01, 0.5, 0.5, 0.25, -100.0, 100.0, 1, 0 );
+  }
+  PidControl_BankInitialize( &tBank );
+  dStart = GetTime( );
+  ullStart = GetCycles( );
+  for ( iTick = 0; iTick < TIMING_TICKS; iTick++ )
+  {
+    for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      atLoops[ iLoop ].lSetPoint = PIDCONTROL_Q16_ONE * 50;
+      atLoops[ iLoop ].lProcVar = PIDCONTROL_Q16_ONE * (( iTick + iLoop ) & 0x3F );
+    }
+    PidControl_BankProcess( &tBank );
+  }
+  ullFixed = GetCycles( ) - ullStart;
+  dFixed = GetTime( ) - dStart;
+
+  // scheduled bank
+  for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+  {
+    atDefs[ iLoop ] = ( PIDBANKDEF )PIDCONTROL_BANKDEFSCHED( atSchedule, PIDCONTROL_SCHED_PROCVAR, 0.5, 0.25, -100.0, 100.0, 1, 0 );
+  }
+  PidControl_BankInitialize( &tBank );
+  dStart = GetTime( );
+  ullStart = GetCycles( );
+  for ( iTick = 0; iTick < TIMING_TICKS; iTick++ )
+  {
+    for ( iLoop = 0; iLoop < NUM_LOOPS; iLoop++ )
+    {
+      atLoops[ iLoop ].lSetPoint = PIDCONTROL_Q16_ONE * 50;
+      atLoops[ iLoop ].lProcVar = PIDCONTROL_Q16_ONE * (( iTick + iLoop ) & 0x3F );
+    }
+    PidControl_BankProcess( &tBank );
+  }
+  ullSched = GetCycles( ) - ullStart;
+  dSched = GetTime( ) - dStart;
+
+  // report
+  ( void )fSink;
+  printf( "timing: %d loops x %d ticks\n", NUM_LOOPS, TIMING_TICKS );
+  printf( "  float PID        %6.1f ns %6.1f cycles per loop\n", dFloat * 1e9 / dLoops, ullFloat / dLoops );
+  printf( "  bank fixed gain  %6.1f ns %6.1f cycles per loop\n", dFixed * 1e9 / dLoops, ullFixed / dLoops );
+  printf( "  bank scheduled   %6.1f ns %6.1f cycles per loop\n", dSched * 1e9 / dLoops, ullSched / dLoops );
+}
+
+/******************************************************************************
+ * @function GetTime
+ *
+ * @brief get the time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time
+ *
+ *****************************************************************************/
+static double GetTime( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/******************************************************************************
+ * @function GetCycles
+ *
+ * @brief get the cycle count
+ *
+ * This function will return the time stamp counter on x86 hosts, zero on
+ * the others
+ *
+ * @return      cycles
+ *
+ *****************************************************************************/
+static unsigned long long GetCycles( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+  return( __rdtsc( ));
+#else
+  return( 0 );
+#endif
+}
+
+/**@} EOF PidControlBankTest.c */
@@ -33,6 +33,12 @@
 /// define the kelvin base
 #define KELVIN_BASE_TEMP                        ( 273.15 )
 
+/// define the temperature limits of the lookup table
+#define LUT_TEMP_LIMIT                          ( 327.0 )
+
+/// define the number of error test points per segment
+#define LUT_ERROR_POINTS                        ( 8 )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
@@ -42,6 +48,9 @@
 // local parameter declarations -----------------------------------------------
 
 // local function prototypes --------------------------------------------------
+static  FLOAT ComputeTemp( FLOAT fCounts, PSTEINHARTDEF ptDef );
+static  U16   FindCounts( FLOAT fTemp, PSTEINHARTDEF ptDef );
+static  S32   InterpolateTable( PSTEINHARTLUT ptLut, U16 wOffset );
 
 // constant parameter initializations -----------------------------------------
 
@@ -59,16 +68,197 @@
  *
  *****************************************************************************/
 FLOAT SteinhartHart_CalculateTemp( U16 wMeasuredCounts, PSTEINHARTDEF ptDef )
+{
+  // return the temp
+  return( ComputeTemp(( FLOAT )wMeasuredCounts, ptDef ));
+}
+
+/******************************************************************************
+ * @function SteinhartHart_GenerateTable
+ *
+ * @brief generate a lookup table
+ *
+ * This function will fill a lookup table from the coefficients.  The table
+ * covers the counts of the temperature range with equally spaced breakpoints,
+ * the spacing being the smallest power of two that fits the table.  The error
+ * of the interpolation is measured between the breakpoints and stored as the
+ * error bound of the table.
+ *
+ * @param[in]   ptDef           pointer to the definition
+ * @param[io]   ptLut           pointer to the lookup table
+ * @param[in]   fMinTemp        minimum temperature in C
+ * @param[in]   fMaxTemp        maximum temperature in C
+ *
+ * @return      TRUE if errors, FALSE if not
+ *
+ *****************************************************************************/
+BOOL SteinhartHart_GenerateTable( PSTEINHARTDEF ptDef, PSTEINHARTLUT ptLut, FLOAT fMinTemp, FLOAT fMaxTemp )
+{
+  BOOL  bStatus = TRUE;
+  U16   wIdx, wRange, wNumUsed, wStep, wPoint;
+  U32   uCounts;
+  FLOAT fCounts, fLength, fTemp, fError, fMaxError = 0;
+
+  // check for valid limits
+  if (( ptLut->psTable != NULL ) && ( ptLut->wNumEntries >= 2 ) && ( fMinTemp >= -LUT_TEMP_LIMIT ) && ( fMaxTemp <= LUT_TEMP_LIMIT ) && ( fMinTemp < fMaxTemp ))
+  {
+    // find the counts of the range
+    ptLut->wMinCounts = FindCounts( fMinTemp, ptDef );
+    ptLut->wMaxCounts = FindCounts( fMaxTemp, ptDef );
+    wRange = ptLut->wMaxCounts - ptLut->wMinCounts;
+
+    // check for a valid range
+    if ( ptLut->wMaxCounts > ptLut->wMinCounts )
+    {
+      // find the smallest spacing that fits
+      for ( ptLut->nShift = 0; (( wRange >> ptLut->nShift ) + 2 ) > ptLut->wNumEntries; ptLut->nShift++ );
+      wNumUsed = ( wRange >> ptLut->nShift ) + 2;
+      wStep = 1 << ptLut->nShift;
+
+      // fill the breakpoints, clamping the counts to the converter range
+      for ( wIdx = 0; wIdx < wNumUsed; wIdx++ )
+      {
+        uCounts = MIN(( U32 )ptLut->wMinCounts + (( U32 )wIdx << ptLut->nShift ), ( U32 )ptDef->wMaxCounts - 1 );
+        fTemp = ComputeTemp(( FLOAT )uCounts, ptDef ) * STEINHARTHART_LUT_SCALE;
+        fTemp = CONSTRAIN( fTemp, -32767.0f, 32767.0f );
+        ptLut->psTable[ wIdx ] = ( S16 )(( fTemp < 0 ) ? ( fTemp - 0.5f ) : ( fTemp + 0.5f ));
+      }
+
+      // measure the error across the used part of each segment
+      for ( wIdx = 0; wIdx < wNumUsed - 1; wIdx++ )
+      {
+        fLength = MIN(( FLOAT )wStep, ( FLOAT )wRange - (( FLOAT )wIdx * wStep ));
+        for ( wPoint = 1; wPoint <= LUT_ERROR_POINTS; wPoint++ )
+        {
+          // compare against the unrounded interpolation
+          fCounts = fLength * wPoint / LUT_ERROR_POINTS;
+          fTemp = ComputeTemp( ptLut->wMinCounts + (( FLOAT )wIdx * wStep ) + fCounts, ptDef ) * STEINHARTHART_LUT_SCALE;
+          fError = ptLut->psTable[ wIdx ] + (( ptLut->psTable[ wIdx + 1 ] - ptLut->psTable[ wIdx ] ) * fCounts / wStep );
+          fMaxError = MAX( fMaxError, fabs( fTemp - fError ));
+        }
+      }
+
+      // store the bound, allowing for the error peak between the test points and the rounding
+      ptLut->wErrorBound = ( U16 )MIN(( fMaxError * 1.25f ) + 1.5f, 65535.0f );
+      bStatus = FALSE;
+    }
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function SteinhartHart_LookupTemp
+ *
+ * @brief look up the temperature of a thermistor
+ *
+ * This function will interpolate the temperature from a lookup table, counts
+ * outside the table are clamped to its ends
+ *
+ * @param[in]   wMeasuredCounts AtoD value in counts
+ * @param[in]   ptLut           pointer to the lookup table
+ *
+ * @return      temperature in hundredths of a degree C
+ *
+ *****************************************************************************/
+S16 SteinhartHart_LookupTemp( U16 wMeasuredCounts, PSTEINHARTLUT ptLut )
+{
+  // clamp and interpolate
+  wMeasuredCounts = CONSTRAIN( wMeasuredCounts, ptLut->wMinCounts, ptLut->wMaxCounts );
+  return(( S16 )InterpolateTable( ptLut, wMeasuredCounts - ptLut->wMinCounts ));
+}
+
+/******************************************************************************
+ * @function ComputeTemp
+ *
+ * @brief compute the temperature
+ *
+ * This function will compute the temperature from the Steinhart-Hart
+ * equation for fractional counts
+ *
+ * @param[in]   fCounts         AtoD value in counts
+ * @param[in]   ptDef           pointer to the definition
+ *
+ * @return      temperature in C
+ *
+ *****************************************************************************/
+static FLOAT ComputeTemp( FLOAT fCounts, PSTEINHARTDEF ptDef )
 {
   FLOAT fTemp, fThermRes;
   
   // calculate the resistance of the thermistor
-  fThermRes= log( ptDef->fR1Res * (( FLOAT )ptDef->wMaxCounts / ( FLOAT )wMeasuredCounts - 1.0 ));
+  fThermRes= log( ptDef->fR1Res * (( FLOAT )ptDef->wMaxCounts / fCounts - 1.0 ));
   fTemp = ( 1.0 / ( ptDef->fACoeef + ( ptDef->fBCoeef * fThermRes ) + ( ptDef->fCCoeef * fThermRes * fThermRes * fThermRes )));
   fTemp -= KELVIN_BASE_TEMP;
   
   // return the temp
   return( fTemp );
 }
+
+/******************************************************************************
+ * @function FindCounts
+ *
+ * @brief find the counts of a temperature
+ *
+ * This function will binary search the converter range for the lowest counts
+ * at or above a temperature, the temperature rising with the counts
+ *
+ * @param[in]   fTemp           temperature in C
+ * @param[in]   ptDef           pointer to the definition
+ *
+ * @return      counts
+ *
+ *****************************************************************************/
+static U16 FindCounts( FLOAT fTemp, PSTEINHARTDEF ptDef )
+{
+  U16 wLo = 1, wHi = ptDef->wMaxCounts - 1, wMid;
+
+  // search
+  while ( wLo < wHi )
+  {
+    wMid = wLo + (( wHi - wLo ) / 2 );
+    if ( ComputeTemp(( FLOAT )wMid, ptDef ) < fTemp )
+    {
+      wLo = wMid + 1;
+    }
+    else
+    {
+      wHi = wMid;
+    }
+  }
+
+  // return the counts
+  return( wLo );
+}
+
+/******************************************************************************
+ * @function InterpolateTable
+ *
+ * @brief interpolate the table
+ *
+ * This function will interpolate between the breakpoints either side of an
+ * offset from the start of the table, rounding to nearest
+ *
+ * @param[in]   ptLut           pointer to the lookup table
+ * @param[in]   wOffset         counts from the first breakpoint
+ *
+ * @return      temperature in hundredths of a degree C
+ *
+ *****************************************************************************/
+static S32 InterpolateTable( PSTEINHARTLUT ptLut, U16 wOffset )
+{
+  U16 wIdx, wFrac;
+  S32 lBase, lDelta;
+
+  // get the breakpoint and the fraction
+  wIdx = wOffset >> ptLut->nShift;
+  wFrac = wOffset & (( 1 << ptLut->nShift ) - 1 );
+  lBase = ptLut->psTable[ wIdx ];
+  lDelta = ( S32 )ptLut->psTable[ wIdx + 1 ] - lBase;
+
+  // return the interpolated value
+  return( lBase + ((( lDelta * wFrac ) + (( 1 << ptLut->nShift ) >> 1 )) >> ptLut->nShift ));
+}
  
 /**@} EOF SteinhartHart.c */
@@ -33,6 +33,17 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the lookup table scale, temperatures are in hundredths of a degree
+#define STEINHARTHART_LUT_SCALE                 ( 100 )
+
+/// define the helper macro to define a lookup table with its storage
+#define STEINHARTHART_LUT_DEFINE( name, entries ) \
+  static S16 as ## name ## Table[ entries ]; \
+  static STEINHARTLUT name = \
+  { \
+    .psTable      = as ## name ## Table, \
+    .wNumEntries  = entries, \
+  }
 
 // enumerations ---------------------------------------------------------------
 
@@ -48,10 +59,24 @@ typedef struct _STEINHARTDEF
 } STEINHARTDEF, *PSTEINHARTDEF;
 #define STEINHARTDEF_SIZE                       sizeof( STEINHARTDEF )
 
+/// define the lookup table structure
+typedef struct _STEINHARTLUT
+{
+  PS16  psTable;          ///< temperatures at each breakpoint, hundredths of a degree
+  U16   wNumEntries;      ///< number of entries in the table
+  U16   wMinCounts;       ///< counts at the first breakpoint, lower counts clamp
+  U16   wMaxCounts;       ///< highest counts in the table, higher counts clamp
+  U8    nShift;           ///< log2 of the counts between breakpoints
+  U16   wErrorBound;      ///< maximum error, hundredths of a degree
+} STEINHARTLUT, *PSTEINHARTLUT;
+#define STEINHARTLUT_SIZE                       sizeof( STEINHARTLUT )
+
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
 extern  FLOAT  SteinhartHart_CalculateTemp( U16 wMeasuredCounts, PSTEINHARTDEF ptDef );
+extern  BOOL   SteinhartHart_GenerateTable( PSTEINHARTDEF ptDef, PSTEINHARTLUT ptLut, FLOAT fMinTemp, FLOAT fMaxTemp );
+extern  S16    SteinhartHart_LookupTemp( U16 wMeasuredCounts, PSTEINHARTLUT ptLut );
 
 /**@} EOF SteinhartHart.h */
 
@@ -0,0 +1,326 @@
+/******************************************************************************
+ * @file SteinhartHartTest.c
+ *
+ * @brief Steinhart-Hart lookup table test
+ *
+ * This file provides a host tool that generates lookup tables of several
+ * sizes for a 10K NTC thermistor on a 12 bit converter over -40 to 125 C.  It
+ * sweeps every converter code, compares the table against a double precision
+ * Steinhart-Hart reference and checks the error stays within the bound the
+ * generator reported, and that the codes outside the range clamp to its ends.
+ * It then times the equation and the table and reports the speedup.  It exits
+ * non zero on any failure.  With -g it prints a table for the given number of
+ * entries as C source so it can be built in instead of generated at init.
+ *
+ * build with: cc -O2 -I. -I<include root> -o SteinhartHartTest
+ *             SteinhartHartTest.c ../../Core/Trunk/SteinhartHart.c -lm
+ * usage:      SteinhartHartTest [-g entries]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup SteinhartHart
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "SteinhartHart/SteinhartHart.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the converter size
+#define MAX_COUNTS                                  ( 4096 )
+
+/// define the temperature range
+#define MIN_TEMP                                    ( -40.0f )
+#define MAX_TEMP                                    ( 125.0f )
+
+/// define the largest table
+#define MAX_ENTRIES                                 ( 1024 )
+
+/// define the number of timing passes over every code
+#define TIMING_PASSES                               ( 200 )
+
+// local parameter declarations -----------------------------------------------
+/// define the thermistor, 10K NTC with a 10K divider resistor
+static  STEINHARTDEF  tDef =
+{
+  .wMaxCounts = MAX_COUNTS,
+  .fR1Res     = 10000.0f,
+  .fACoeef    = 1.009249522e-3f,
+  .fBCoeef    = 2.378405444e-4f,
+  .fCCoeef    = 2.019202697e-7f,
+};
+
+/// define the table sizes to test
+static  const U16 awSizes[ ] = { 17, 33, 65, 129, 257 };
+
+static  S16           asTable[ MAX_ENTRIES ];
+
+// local function prototypes --------------------------------------------------
+static  double  Reference( U16 wCounts );
+static  int     RunSweep( U16 wEntries );
+static  void    RunTiming( U16 wEntries );
+static  int     PrintTable( U16 wEntries );
+static  double  GetTime( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run the sweeps and the timing or print a table
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int iErrors = 0, iIdx;
+
+  // check for print
+  if (( iArgc > 2 ) && ( strcmp( ppszArgv[ 1 ], "-g" ) == 0 ))
+  {
+    return( PrintTable(( U16 )atoi( ppszArgv[ 2 ] )));
+  }
+
+  // sweep each size
+  printf( "%8s %6s %8s %8s %10s %10s\n", "entries", "shift", "min", "max", "bound C", "error C" );
+  for ( iIdx = 0; iIdx < ( int )( sizeof( awSizes ) / sizeof( U16 )); iIdx++ )
+  {
+    iErrors += RunSweep( awSizes[ iIdx ] );
+  }
+
+  // time it
+  RunTiming( 65 );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function Reference
+ *
+ * @brief reference temperature
+ *
+ * This function will compute the temperature in double precision
+ *
+ * @param[in]   wCounts     converter counts
+ *
+ * @return      temperature in C
+ *
+ *****************************************************************************/
+static double Reference( U16 wCounts )
+{
+  double  dLogRes;
+
+  // compute it
+  dLogRes = log(( double )tDef.fR1Res * (( double )tDef.wMaxCounts / wCounts - 1.0 ));
+  return(( 1.0 / ( tDef.fACoeef + ( tDef.fBCoeef * dLogRes ) + ( tDef.fCCoeef * dLogRes * dLogRes * dLogRes ))) - 273.15 );
+}
+
+/******************************************************************************
+ * @function RunSweep
+ *
+ * @brief sweep every code
+ *
+ * This function will generate a table and sweep every converter code
+ *
+ * @param[in]   wEntries    number of table entries
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunSweep( U16 wEntries )
+{
+  STEINHARTLUT  tLut = { asTable, wEntries, 0, 0, 0, 0 };
+  U32           uCounts;
+  S16           sTemp;
+  double        dError, dMaxError = 0, dBound;
+  int           iErrors = 0;
+
+  // generate it
+  if ( SteinhartHart_GenerateTable( &tDef, &tLut, MIN_TEMP, MAX_TEMP ))
+  {
+    printf( "  error: generate failed for %u entries\n", wEntries );
+    return( 1 );
+  }
+  dBound = ( double )tLut.wErrorBound / STEINHARTHART_LUT_SCALE;
+
+  // sweep every code
+  for ( uCounts = 1; uCounts < MAX_COUNTS; uCounts++ )
+  {
+    sTemp = SteinhartHart_LookupTemp(( U16 )uCounts, &tLut );
+    if ( uCounts < tLut.wMinCounts )
+    {
+      // must clamp to the first breakpoint
+      if ( sTemp != tLut.psTable[ 0 ] )
+      {
+        printf( "  error: code %u below range not clamped\n", uCounts );
+        iErrors++;
+      }
+    }
+    else if ( uCounts > tLut.wMaxCounts )
+    {
+      // must clamp to the last code
+      if ( sTemp != SteinhartHart_LookupTemp( tLut.wMaxCounts, &tLut ))
+      {
+        printf( "  error: code %u above range not clamped\n", uCounts );
+        iErrors++;
+      }
+    }
+    else
+    {
+      // must be within the bound
+      dError = fabs(( double )sTemp / STEINHARTHART_LUT_SCALE - Reference(( U16 )uCounts ));
+      dMaxError = fmax( dMaxError, dError );
+      if (( dError > dBound ) && ( iErrors++ < 5 ))
+      {
+        printf( "  error: code %u error %.3f exceeds bound %.3f\n", uCounts, dError, dBound );
+      }
+    }
+  }
+
+  // report
+  printf( "%8u %6u %8u %8u %10.3f %10.3f\n", wEntries, tLut.nShift, tLut.wMinCounts, tLut.wMaxCounts, dBound, dMaxError );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief timing
+ *
+ * This function will time the equation and the table over every code in the
+ * range
+ *
+ * @param[in]   wEntries    number of table entries
+ *
+ *****************************************************************************/
+static void RunTiming( U16 wEntries )
+{
+  STEINHARTLUT    tLut = { asTable, wEntries, 0, 0, 0, 0 };
+  volatile FLOAT  fSink;
+  volatile S16    sSink;
+  U32             uCounts, uConversions = 0;
+  int             iPass;
+  double          dStart, dEquation, dTable;
+
+  // generate it
+  SteinhartHart_GenerateTable( &tDef, &tLut, MIN_TEMP, MAX_TEMP );
+
+  // time the equation
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    for ( uCounts = tLut.wMinCounts; uCounts <= tLut.wMaxCounts; uCounts++ )
+    {
+      fSink = SteinhartHart_CalculateTemp(( U16 )uCounts, &tDef );
+      uConversions++;
+    }
+  }
+  dEquation = GetTime( ) - dStart;
+
+  // time the table
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    for ( uCounts = tLut.wMinCounts; uCounts <= tLut.wMaxCounts; uCounts++ )
+    {
+      sSink = SteinhartHart_LookupTemp(( U16 )uCounts, &tLut );
+    }
+  }
+  dTable = GetTime( ) - dStart;
+
+  // report
+  ( void )fSink;
+  ( void )sSink;
+  printf( "timing: %u entries, equation %.1f ns, table %.1f ns per conversion, speedup %.1fx\n", wEntries,
+          dEquation * 1e9 / uConversions, dTable * 1e9 / uConversions, dEquation / dTable );
+}
+
+/******************************************************************************
+ * @function PrintTable
+ *
+ * @brief print a table
+ *
+ * This function will generate a table and print it as C source
+ *
+ * @param[in]   wEntries    number of table entries
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+static int PrintTable( U16 wEntries )
+{
+  STEINHARTLUT  tLut = { asTable, MIN( wEntries, MAX_ENTRIES ), 0, 0, 0, 0 };
+  U16           wIdx, wNumUsed;
+
+  // generate it
+  if ( SteinhartHart_GenerateTable( &tDef, &tLut, MIN_TEMP, MAX_TEMP ))
+  {
+    fprintf( stderr, "generate failed for %u entries\n", wEntries );
+    return( 1 );
+  }
+  wNumUsed = (( tLut.wMaxCounts - tLut.wMinCounts ) >> tLut.nShift ) + 2;
+
+  // print it
+  printf( "/// thermistor table, %.0f to %.0f C, error bound %u hundredths of a degree\n", MIN_TEMP, MAX_TEMP, tLut.wErrorBound );
+  printf( "static S16 asThermTable[ %u ] =\n{", wNumUsed );
+  for ( wIdx = 0; wIdx < wNumUsed; wIdx++ )
+  {
+    printf( "%s%6d,", (( wIdx % 8 ) == 0 ) ? "\n  " : " ", tLut.psTable[ wIdx ] );
+  }
+  printf( "\n};\n\n" );
+  printf( "static STEINHARTLUT tThermLut =\n{\n" );
+  printf( "  .psTable      = asThermTable,\n" );
+  printf( "  .wNumEntries  = %u,\n", wNumUsed );
+  printf( "  .wMinCounts   = %u,\n", tLut.wMinCounts );
+  printf( "  .wMaxCounts   = %u,\n", tLut.wMaxCounts );
+  printf( "  .nShift       = %u,\n", tLut.nShift );
+  printf( "  .wErrorBound  = %u,\n", tLut.wErrorBound );
+  printf( "};\n" );
+
+  // return ok
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function GetTime
+ *
+ * @brief get the time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time
+ *
+ *****************************************************************************/
+static double GetTime( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/**@} EOF SteinhartHartTest.c */
@@ -21,6 +21,9 @@
  * Created in $/SfwLibraries/C++
  * INITIAL CHECKIN
  * 
+ * Parsing, generation and the CRCs are done by the portable CHexImage engine,
+ * this class keeps the dense array interface for the existing applications.
+ * 
  ******************************************************************************/
 
 
@@ -63,12 +66,7 @@ public:
 	} tDblWord;
 
 protected:
-	CString	m_strLocal;
-	bool	    m_fBigEndian;	
-  int     m_iPage;
-
-	// declare the constants
-	static const BYTE	m_OutputByteCount	= 16;
+	bool	    m_fBigEndian;
 
 // implementation
 public:
@@ -81,21 +79,6 @@ public:
 	void	ComputeCrc16( DWORD wStartAddress, DWORD wEndAddress, DWORD wOffset );
 	void	ComputeCrc32( DWORD wStartAddress, DWORD wEndAddress, DWORD wOffset );
 
-protected:
-	bool	ParseLine( CString strLine, DWORD dwOffset );
-	bool	ParseHex( DWORD dwOffset );
-	bool	ParseS19( DWORD dwOffset );
-	WORD	GetLineWord( short iOffset );
-	BYTE	AscHex( short iOffset );
-	BYTE	GetLineByte( short iOffset );
-	DWORD	GetLineAddress( short iOffset, short iLength );
-	void	GenHex( CStdioFile* pfilData, DWORD dwStartingAddress );
-	void	GenS19( CStdioFile* pfilData, DWORD dwStartingAddress );
-  void	GenBin( CFile* pfilData, DWORD dwStartingAddress);
-  CString MakeLineAddress( DWORD dwValue, int iAddrLength );
-	CString	MakeLineWord( WORD wValue );
-	CString	MakeLineByte( BYTE nValue );
-	CString	HexAsc( BYTE nValue );
 };
 
 #endif // !defined(AFX_HEXFILES_H__ED8C818F_D785_439B_B300_159BCB07C4DA__INCLUDED_)
@@ -0,0 +1,936 @@
+/*****************************************************************************
+//   $Workfile: HexImage.cpp $
+//    Function: Hex Image Class Implementation
+//   $JustDate: $
+//   $Revision: 1.0 $
+//
+//	  This document contains proprietary data and information of Cyber Integration
+//  LLC.  It is the exclusive property of Cyber Integration, LLC and
+//  will not be disclosed in any form to any party without prior written
+//  permission of Cyber Integration, LLC.	This document may not be reproduced
+//  or further used without the prior written permission of Cyber Integration
+//  LLC.
+//
+//  Copyright (C) 2004 Cyber Integration, LLC. All Rights Reserved
+//
+//  $History: $
+ *
+ ******************************************************************************/
+
+#include "HexImage.h"
+#include <string.h>
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+//////////////////////////////////////////////////////////////////////
+// local defines
+//////////////////////////////////////////////////////////////////////
+#define	MAX_RECORD_BYTES	  ( 260 )
+#define	MAX_LINE_LENGTH		  ( 2 * MAX_RECORD_BYTES + 4 )
+#define	OUTPUT_BUFFER_SIZE	( 65536 )
+#define	CRC_CHUNK_SIZE		  ( 4096 )
+
+//////////////////////////////////////////////////////////////////////
+// local tables
+//////////////////////////////////////////////////////////////////////
+// ASCII to nibble, 0xFF for non hex characters
+static const uint8_t anHexTable[ 256 ] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+// nibble to ASCII
+static const char acHexDigits[ ] = "0123456789ABCDEF";
+
+// CRC-16 CCITT, polynomial 0x1021, MSB first
+static const uint16_t awCrc16Table[ 256 ] =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+	0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+	0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+	0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+	0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+	0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+	0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+	0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+	0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+	0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+	0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+	0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+	0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+	0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+	0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+	0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+	0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+	0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+	0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+	0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+	0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+	0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+	0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+	0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+	0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+	0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+	0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+	0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+	0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+	0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+	0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+// CRC-32, polynomial 0xEDB88320, LSB first
+static const uint32_t adwCrc32Table[ 256 ] =
+{
+	0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
+	0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
+	0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+	0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
+	0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
+	0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+	0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423, 0xCFBA9599, 0xB8BDA50F,
+	0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D,
+	0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+	0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01,
+	0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457,
+	0x65B0D9C6, 0x12B7E950, 0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+	0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB,
+	0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0, 0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9,
+	0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+	0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81, 0xB7BD5C3B, 0xC0BA6CAD,
+	0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683,
+	0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+	0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7,
+	0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5,
+	0xD6D6A3E8, 0xA1D1937E, 0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+	0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79,
+	0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236, 0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F,
+	0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+	0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F, 0x72076785, 0x05005713,
+	0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21,
+	0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+	0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45,
+	0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB,
+	0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+	0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
+	0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D,
+};
+
+//////////////////////////////////////////////////////////////////////
+// local classes
+//////////////////////////////////////////////////////////////////////
+// read only memory mapping of a file
+class CMappedFile
+{
+public:
+	CMappedFile( const char* pszFileName );
+	~CMappedFile();
+
+	bool		    IsOpen( void ) const { return( m_fOpen ); }
+	const char*	GetData( void ) const { return( m_pcData ); }
+	size_t		  GetLength( void ) const { return( m_tLength ); }
+
+protected:
+	const char*	m_pcData;
+	size_t		  m_tLength;
+	bool		    m_fOpen;
+#if defined( _WIN32 )
+	HANDLE		  m_hFile;
+	HANDLE		  m_hMapping;
+#else
+	int			    m_iFile;
+#endif // _WIN32
+};
+
+CMappedFile::CMappedFile( const char* pszFileName )
+{
+	// clear the mapping
+	m_pcData = NULL;
+	m_tLength = 0;
+	m_fOpen = false;
+
+#if defined( _WIN32 )
+	LARGE_INTEGER	tSize;
+
+	// open the file/map it, an empty file has no mapping
+	m_hMapping = NULL;
+	if (( m_hFile = CreateFileA( pszFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL )) != INVALID_HANDLE_VALUE )
+	{
+		if ( GetFileSizeEx( m_hFile, &tSize ) && ( tSize.QuadPart == 0 ))
+		{
+			m_fOpen = true;
+		}
+		else if (( m_hMapping = CreateFileMappingA( m_hFile, NULL, PAGE_READONLY, 0, 0, NULL )) != NULL )
+		{
+			if (( m_pcData = ( const char* )MapViewOfFile( m_hMapping, FILE_MAP_READ, 0, 0, 0 )) != NULL )
+			{
+				m_tLength = ( size_t )tSize.QuadPart;
+				m_fOpen = true;
+			}
+		}
+	}
+#else
+	struct stat	tStat;
+	void*		    pvData;
+
+	// open the file/map it, an empty file has no mapping
+	if (( m_iFile = open( pszFileName, O_RDONLY )) >= 0 )
+	{
+		if ( fstat( m_iFile, &tStat ) == 0 )
+		{
+			if ( tStat.st_size == 0 )
+			{
+				m_fOpen = true;
+			}
+			else if (( pvData = mmap( NULL, ( size_t )tStat.st_size, PROT_READ, MAP_PRIVATE, m_iFile, 0 )) != MAP_FAILED )
+			{
+				// the file is read once front to back
+				madvise( pvData, ( size_t )tStat.st_size, MADV_SEQUENTIAL );
+				m_pcData = ( const char* )pvData;
+				m_tLength = ( size_t )tStat.st_size;
+				m_fOpen = true;
+			}
+		}
+	}
+#endif // _WIN32
+}
+
+CMappedFile::~CMappedFile()
+{
+#if defined( _WIN32 )
+	// unmap/close
+	if ( m_pcData != NULL )
+		UnmapViewOfFile( m_pcData );
+	if ( m_hMapping != NULL )
+		CloseHandle( m_hMapping );
+	if ( m_hFile != INVALID_HANDLE_VALUE )
+		CloseHandle( m_hFile );
+#else
+	// unmap/close
+	if ( m_pcData != NULL )
+		munmap(( void* )m_pcData, m_tLength );
+	if ( m_iFile >= 0 )
+		close( m_iFile );
+#endif // _WIN32
+}
+
+// buffered record writer, bytes are written as hex and summed for the
+// record checksum
+class CRecordWriter
+{
+public:
+	CRecordWriter( FILE* pfilData ) : m_pfilData( pfilData ), m_tIndex( 0 ), m_nSum( 0 ), m_fError( false ) { }
+
+	void	  Start( char cStart, char cType );
+	void	  PutByte( uint8_t nValue );
+	void	  PutBytes( const uint8_t* pnData, size_t tLength );
+	void	  End( void ) { m_acBuffer[ m_tIndex++ ] = '\n'; }
+	uint8_t	GetSum( void ) const { return( m_nSum ); }
+	bool	  Flush( void );
+
+protected:
+	FILE*	  m_pfilData;
+	char	  m_acBuffer[ OUTPUT_BUFFER_SIZE ];
+	size_t	m_tIndex;
+	uint8_t	m_nSum;
+	bool	  m_fError;
+};
+
+void CRecordWriter::Start( char cStart, char cType )
+{
+	// make room for a full line
+	if (( m_tIndex + MAX_LINE_LENGTH ) > OUTPUT_BUFFER_SIZE )
+		Flush( );
+
+	// output the start/type, clear the sum
+	m_acBuffer[ m_tIndex++ ] = cStart;
+	if ( cType != '\0' )
+		m_acBuffer[ m_tIndex++ ] = cType;
+	m_nSum = 0;
+}
+
+void CRecordWriter::PutByte( uint8_t nValue )
+{
+	// output the digits/add to the sum
+	m_acBuffer[ m_tIndex++ ] = acHexDigits[ nValue >> 4 ];
+	m_acBuffer[ m_tIndex++ ] = acHexDigits[ nValue & 0x0F ];
+	m_nSum += nValue;
+}
+
+void CRecordWriter::PutBytes( const uint8_t* pnData, size_t tLength )
+{
+	// output each byte
+	while ( tLength-- != 0 )
+		PutByte( *( pnData++ ));
+}
+
+bool CRecordWriter::Flush( void )
+{
+	// write the buffer
+	if (( m_tIndex != 0 ) && ( fwrite( m_acBuffer, 1, m_tIndex, m_pfilData ) != m_tIndex ))
+		m_fError = true;
+	m_tIndex = 0;
+
+	// return the status
+	return( !m_fError );
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CHexImage::CHexImage( uint8_t nFill )
+{
+	// set the fill/clear the image
+	m_nFill = nFill;
+	Clear( );
+}
+
+CHexImage::~CHexImage()
+{
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// implementation
+//////////////////////////////////////////////////////////////////////
+CHexImage::STATUS CHexImage::ParseFile( const char* pszFileName, uint32_t dwOffset )
+{
+	STATUS	eStatus = STATUS_OPENERROR;
+
+	// map the file/parse it
+	CMappedFile	tFile( pszFileName );
+	if ( tFile.IsOpen( ))
+		eStatus = ParseBuffer( tFile.GetData( ), tFile.GetLength( ), dwOffset );
+
+	// return the status
+	return( eStatus );
+}
+
+CHexImage::STATUS CHexImage::ParseBuffer( const char* pcData, size_t tLength, uint32_t dwOffset )
+{
+	STATUS			    eStatus = STATUS_OK;
+	const uint8_t*	pnPos = ( const uint8_t* )pcData;
+	const uint8_t*	pnEnd = pnPos + tLength;
+	const uint8_t*	pnLineEnd;
+	const uint8_t*	pnDigits;
+	const uint8_t*	pnNext;
+	uint8_t			    anRecord[ MAX_RECORD_BYTES ];
+	uint8_t			    nHigh, nLow;
+	uint32_t		    dwBase = 0;
+	size_t			    tLine = 0, tBytes, tIndex;
+	bool			      fDone = false;
+
+	// for each line
+	m_tErrorLine = 0;
+	while (( eStatus == STATUS_OK ) && ( !fDone ) && ( pnPos < pnEnd ))
+	{
+		// find the end of the line/trim it
+		tLine++;
+		if (( pnLineEnd = ( const uint8_t* )memchr( pnPos, '\n', pnEnd - pnPos )) == NULL )
+			pnLineEnd = pnEnd;
+		pnNext = ( pnLineEnd < pnEnd ) ? pnLineEnd + 1 : pnEnd;
+		while (( pnLineEnd > pnPos ) && (( pnLineEnd[ -1 ] == '\r' ) || ( pnLineEnd[ -1 ] == ' ' ) || ( pnLineEnd[ -1 ] == '\t' )))
+			pnLineEnd--;
+
+		// only record lines are parsed, anything else is skipped
+		if (( pnLineEnd > pnPos ) && (( *pnPos == ':' ) || ( *pnPos == 'S' )))
+		{
+			// decode the hex digits
+			pnDigits = pnPos + (( *pnPos == ':' ) ? 1 : 2 );
+			tBytes = ( pnLineEnd > pnDigits ) ? ( size_t )( pnLineEnd - pnDigits ) / 2 : 0;
+			if (( tBytes == 0 ) || ( tBytes > MAX_RECORD_BYTES ) || ((( pnLineEnd - pnDigits ) & 1 ) != 0 ))
+			{
+				eStatus = STATUS_SYNTAXERROR;
+			}
+			else
+			{
+				for ( tIndex = 0; tIndex < tBytes; tIndex++, pnDigits += 2 )
+				{
+					nHigh = anHexTable[ pnDigits[ 0 ]];
+					nLow = anHexTable[ pnDigits[ 1 ]];
+					if (( nHigh | nLow ) & 0xF0 )
+					{
+						eStatus = STATUS_SYNTAXERROR;
+						break;
+					}
+					anRecord[ tIndex ] = ( uint8_t )(( nHigh << 4 ) | nLow );
+				}
+			}
+
+			// parse the record
+			if ( eStatus == STATUS_OK )
+			{
+				if ( *pnPos == ':' )
+					eStatus = ParseHex( anRecord, tBytes, dwOffset, dwBase, fDone );
+				else
+					eStatus = ParseS19(( char )pnPos[ 1 ], anRecord, tBytes, dwOffset, fDone );
+			}
+		}
+
+		// next line
+		pnPos = pnNext;
+	}
+
+	// save the error line
+	if ( eStatus != STATUS_OK )
+		m_tErrorLine = tLine;
+
+	// return the status
+	return( eStatus );
+}
+
+CHexImage::STATUS CHexImage::LoadBinary( const char* pszFileName, uint32_t dwAddress )
+{
+	STATUS	eStatus = STATUS_OPENERROR;
+
+	// map the file/add it
+	CMappedFile	tFile( pszFileName );
+	if ( tFile.IsOpen( ))
+	{
+		if (( uint64_t )dwAddress + tFile.GetLength( ) > 0x100000000ULL )
+		{
+			eStatus = STATUS_ADDRESSERROR;
+		}
+		else
+		{
+			Write( dwAddress, ( const uint8_t* )tFile.GetData( ), tFile.GetLength( ));
+			eStatus = STATUS_OK;
+		}
+	}
+
+	// return the status
+	return( eStatus );
+}
+
+CHexImage::STATUS CHexImage::GenerateFile( const char* pszFileName, FORMAT eFormat ) const
+{
+	STATUS	eStatus = STATUS_OK;
+	FILE*	  pfilData;
+	bool	  fWritten = false;
+
+	// open the file, the text formats get native line endings
+	if (( pfilData = fopen( pszFileName, ( eFormat == FORMAT_BIN ) ? "wb" : "w" )) == NULL )
+	{
+		eStatus = STATUS_OPENERROR;
+	}
+	else
+	{
+		// generate it
+		switch ( eFormat )
+		{
+		case FORMAT_S19 :
+			fWritten = GenS19( pfilData );
+			break;
+
+		case FORMAT_HEX :
+			fWritten = GenHex( pfilData );
+			break;
+
+		case FORMAT_BIN :
+			fWritten = GenBin( pfilData );
+			break;
+
+		default :
+			break;
+		}
+
+		// close it/check for errors
+		if (( fclose( pfilData ) != 0 ) || ( !fWritten ))
+			eStatus = STATUS_WRITEERROR;
+	}
+
+	// return the status
+	return( eStatus );
+}
+
+void CHexImage::Clear( void )
+{
+	// clear the segments
+	m_mapSegments.clear( );
+	m_itLast = m_mapSegments.end( );
+	m_tErrorLine = 0;
+}
+
+void CHexImage::Write( uint32_t dwAddress, const uint8_t* pnData, size_t tLength )
+{
+	SEGMENTMAP::iterator	itFirst, itLast, itNext;
+	uint64_t				      hEnd = ( uint64_t )dwAddress + tLength;
+	uint64_t				      hStop = hEnd;
+	uint32_t				      dwStart = dwAddress;
+	bool					        fDone = ( tLength == 0 );
+
+	// records are normally in order, so try appending to the last segment
+	if (( !fDone ) && ( m_itLast != m_mapSegments.end( )) && (( m_itLast->first + ( uint64_t )m_itLast->second.size( )) == dwAddress ))
+	{
+		itNext = m_itLast;
+		++itNext;
+		if (( itNext == m_mapSegments.end( )) || ( itNext->first > hEnd ))
+		{
+			m_itLast->second.insert( m_itLast->second.end( ), pnData, pnData + tLength );
+			fDone = true;
+		}
+	}
+
+	if ( !fDone )
+	{
+		// find the first segment that touches the data
+		itFirst = m_mapSegments.upper_bound( dwAddress );
+		if ( itFirst != m_mapSegments.begin( ))
+		{
+			itNext = itFirst;
+			--itNext;
+			if (( itNext->first + ( uint64_t )itNext->second.size( )) >= dwAddress )
+				itFirst = itNext;
+		}
+
+		// find the extent of the touching segments
+		for ( itLast = itFirst; ( itLast != m_mapSegments.end( )) && ( itLast->first <= hEnd ); ++itLast )
+		{
+			if ( itLast->first < dwStart )
+				dwStart = itLast->first;
+			if (( itLast->first + ( uint64_t )itLast->second.size( )) > hStop )
+				hStop = itLast->first + ( uint64_t )itLast->second.size( );
+		}
+
+		// check for an overwrite inside one segment
+		itNext = itFirst;
+		if (( itFirst != itLast ) && ( ++itNext == itLast ) && ( dwStart == itFirst->first ) && ( hStop == itFirst->first + ( uint64_t )itFirst->second.size( )))
+		{
+			memcpy( &itFirst->second[ dwAddress - dwStart ], pnData, tLength );
+			m_itLast = itFirst;
+		}
+		else
+		{
+			// merge the touching segments and the data into one
+			std::vector< uint8_t > anMerged(( size_t )( hStop - dwStart ), m_nFill );
+			for ( itNext = itFirst; itNext != itLast; ++itNext )
+				memcpy( &anMerged[ itNext->first - dwStart ], &itNext->second[ 0 ], itNext->second.size( ));
+			memcpy( &anMerged[ dwAddress - dwStart ], pnData, tLength );
+
+			// replace them
+			m_mapSegments.erase( itFirst, itLast );
+			m_itLast = m_mapSegments.insert( std::make_pair( dwStart, std::vector< uint8_t >( ))).first;
+			m_itLast->second.swap( anMerged );
+		}
+	}
+}
+
+size_t CHexImage::Read( uint32_t dwAddress, uint8_t* pnData, size_t tLength ) const
+{
+	SEGMENTMAP::const_iterator	itSeg;
+	uint64_t					          hEnd = ( uint64_t )dwAddress + tLength;
+	uint64_t					          hSegEnd, hCopyStart, hCopyEnd;
+	size_t						          tMapped = 0;
+
+	// fill it
+	memset( pnData, m_nFill, tLength );
+
+	// start with the segment at or before the address
+	itSeg = m_mapSegments.upper_bound( dwAddress );
+	if ( itSeg != m_mapSegments.begin( ))
+		--itSeg;
+
+	// copy each overlapping segment
+	for ( ; ( itSeg != m_mapSegments.end( )) && ( itSeg->first < hEnd ); ++itSeg )
+	{
+		hSegEnd = itSeg->first + ( uint64_t )itSeg->second.size( );
+		hCopyStart = ( itSeg->first > dwAddress ) ? itSeg->first : dwAddress;
+		hCopyEnd = ( hSegEnd < hEnd ) ? hSegEnd : hEnd;
+		if ( hCopyEnd > hCopyStart )
+		{
+			memcpy( pnData + ( hCopyStart - dwAddress ), &itSeg->second[ ( size_t )( hCopyStart - itSeg->first ) ], ( size_t )( hCopyEnd - hCopyStart ));
+			tMapped += ( size_t )( hCopyEnd - hCopyStart );
+		}
+	}
+
+	// return the number of mapped bytes
+	return( tMapped );
+}
+
+uint8_t CHexImage::GetByte( uint32_t dwAddress ) const
+{
+	uint8_t	nValue;
+
+	// get the value
+	Read( dwAddress, &nValue, 1 );
+	return( nValue );
+}
+
+bool CHexImage::IsEmpty( void ) const
+{
+	// return the state
+	return( m_mapSegments.empty( ));
+}
+
+uint32_t CHexImage::GetLowAddress( void ) const
+{
+	// return the first address
+	return(( m_mapSegments.empty( )) ? 0 : m_mapSegments.begin( )->first );
+}
+
+uint64_t CHexImage::GetHighAddress( void ) const
+{
+	// return the address after the last byte
+	return(( m_mapSegments.empty( )) ? 0 : m_mapSegments.rbegin( )->first + ( uint64_t )m_mapSegments.rbegin( )->second.size( ));
+}
+
+uint16_t CHexImage::ComputeCrc16( uint32_t dwStartAddress, uint32_t dwEndAddress ) const
+{
+	uint8_t		anChunk[ CRC_CHUNK_SIZE ];
+	uint16_t	wCrc = 0xFFFF;
+	size_t		tLength;
+
+	// for each chunk, gaps are the fill value
+	while ( dwStartAddress < dwEndAddress )
+	{
+		tLength = (( dwEndAddress - dwStartAddress ) < CRC_CHUNK_SIZE ) ? ( dwEndAddress - dwStartAddress ) : CRC_CHUNK_SIZE;
+		Read( dwStartAddress, anChunk, tLength );
+		wCrc = Crc16Block( wCrc, anChunk, tLength );
+		dwStartAddress += ( uint32_t )tLength;
+	}
+
+	// return the CRC
+	return( wCrc );
+}
+
+uint32_t CHexImage::ComputeCrc32( uint32_t dwStartAddress, uint32_t dwEndAddress ) const
+{
+	uint8_t		anChunk[ CRC_CHUNK_SIZE ];
+	uint32_t	dwCrc = 0xFFFFFFFF;
+	size_t		tLength;
+
+	// for each chunk, gaps are the fill value
+	while ( dwStartAddress < dwEndAddress )
+	{
+		tLength = (( dwEndAddress - dwStartAddress ) < CRC_CHUNK_SIZE ) ? ( dwEndAddress - dwStartAddress ) : CRC_CHUNK_SIZE;
+		Read( dwStartAddress, anChunk, tLength );
+		dwCrc = Crc32Block( dwCrc, anChunk, tLength );
+		dwStartAddress += ( uint32_t )tLength;
+	}
+
+	// return the complemented CRC
+	return( ~dwCrc );
+}
+
+uint16_t CHexImage::Crc16Block( uint16_t wCrc, const uint8_t* pnData, size_t tLength )
+{
+	// for each byte
+	while ( tLength-- != 0 )
+		wCrc = ( uint16_t )(( wCrc << 8 ) ^ awCrc16Table[ (( wCrc >> 8 ) ^ *( pnData++ )) & 0xFF ]);
+
+	// return the CRC
+	return( wCrc );
+}
+
+uint32_t CHexImage::Crc32Block( uint32_t dwCrc, const uint8_t* pnData, size_t tLength )
+{
+	// for each byte
+	while ( tLength-- != 0 )
+		dwCrc = adwCrc32Table[ ( dwCrc ^ *( pnData++ )) & 0xFF ] ^ ( dwCrc >> 8 );
+
+	// return the CRC
+	return( dwCrc );
+}
+
+//////////////////////////////////////////////////////////////////////
+// local parsers
+//////////////////////////////////////////////////////////////////////
+CHexImage::STATUS CHexImage::ParseHex( const uint8_t* pnRecord, size_t tLength, uint32_t dwOffset, uint32_t& dwBase, bool& fDone )
+{
+	STATUS		eStatus = STATUS_OK;
+	uint64_t	hAddress;
+	uint8_t		nSum = 0;
+	size_t		tIndex;
+
+	// add up the record, it must sum to zero
+	for ( tIndex = 0; tIndex < tLength; tIndex++ )
+		nSum += pnRecord[ tIndex ];
+
+	// check the length/checksum
+	if (( tLength < 5 ) || (( size_t )pnRecord[ 0 ] + 5 != tLength ))
+	{
+		eStatus = STATUS_SYNTAXERROR;
+	}
+	else if ( nSum != 0 )
+	{
+		eStatus = STATUS_CHECKSUMERROR;
+	}
+	else
+	{
+		// process the appropriate types
+		switch ( pnRecord[ 3 ] )
+		{
+		case 0x00 :
+			// compute/check the address
+			hAddress = ( uint64_t )dwBase + (( pnRecord[ 1 ] << 8 ) | pnRecord[ 2 ] );
+			if (( hAddress < dwOffset ) || (( hAddress + pnRecord[ 0 ] ) > 0x100000000ULL ))
+				eStatus = STATUS_ADDRESSERROR;
+			else
+				Write(( uint32_t )( hAddress - dwOffset ), &pnRecord[ 4 ], pnRecord[ 0 ] );
+			break;
+
+		case 0x01 :
+			// end of file
+			fDone = true;
+			break;
+
+		case 0x02 :
+		case 0x04 :
+			// extended segment/linear address
+			if ( pnRecord[ 0 ] != 2 )
+				eStatus = STATUS_SYNTAXERROR;
+			else
+				dwBase = (( uint32_t )(( pnRecord[ 4 ] << 8 ) | pnRecord[ 5 ] )) << (( pnRecord[ 3 ] == 0x02 ) ? 4 : 16 );
+			break;
+
+		case 0x03 :
+		case 0x05 :
+			// start address
+			break;
+
+		default :
+			eStatus = STATUS_SYNTAXERROR;
+			break;
+		}
+	}
+
+	// return the status
+	return( eStatus );
+}
+
+CHexImage::STATUS CHexImage::ParseS19( char cType, const uint8_t* pnRecord, size_t tLength, uint32_t dwOffset, bool& fDone )
+{
+	STATUS		eStatus = STATUS_OK;
+	uint64_t	hAddress = 0;
+	uint8_t		nSum = 0;
+	size_t		tIndex, tAddrLength;
+
+	// add up the record, with the checksum it must sum to 0xFF
+	for ( tIndex = 0; tIndex < tLength; tIndex++ )
+		nSum += pnRecord[ tIndex ];
+
+	// check the length/checksum
+	if (( tLength < 2 ) || (( size_t )pnRecord[ 0 ] + 1 != tLength ))
+	{
+		eStatus = STATUS_SYNTAXERROR;
+	}
+	else if ( nSum != 0xFF )
+	{
+		eStatus = STATUS_CHECKSUMERROR;
+	}
+	else
+	{
+		// process the appropriate types
+		switch ( cType )
+		{
+		case '1' :
+		case '2' :
+		case '3' :
+			// get the address
+			tAddrLength = ( size_t )( cType - '0' ) + 1;
+			if ( pnRecord[ 0 ] < tAddrLength + 1 )
+			{
+				eStatus = STATUS_SYNTAXERROR;
+				break;
+			}
+			for ( tIndex = 0; tIndex < tAddrLength; tIndex++ )
+				hAddress = ( hAddress << 8 ) | pnRecord[ 1 + tIndex ];
+
+			// check it/store the data
+			tLength = pnRecord[ 0 ] - tAddrLength - 1;
+			if (( hAddress < dwOffset ) || (( hAddress + tLength ) > 0x100000000ULL ))
+				eStatus = STATUS_ADDRESSERROR;
+			else
+				Write(( uint32_t )( hAddress - dwOffset ), &pnRecord[ 1 + tAddrLength ], tLength );
+			break;
+
+		case '7' :
+		case '8' :
+		case '9' :
+			// end of file
+			fDone = true;
+			break;
+
+		default :
+			// header/count/reserved
+			break;
+		}
+	}
+
+	// return the status
+	return( eStatus );
+}
+
+//////////////////////////////////////////////////////////////////////
+// local generators
+//////////////////////////////////////////////////////////////////////
+bool CHexImage::GenHex( FILE* pfilData ) const
+{
+	CRecordWriter*				      ptWriter = new CRecordWriter( pfilData );
+	SEGMENTMAP::const_iterator	itSeg;
+	uint32_t					          dwAddress, dwUpper = 0;
+	size_t						          tIndex, tCount;
+	bool						            fStatus;
+
+	// for each segment
+	for ( itSeg = m_mapSegments.begin( ); itSeg != m_mapSegments.end( ); ++itSeg )
+	{
+		// for each record, records never cross a 64K page
+		dwAddress = itSeg->first;
+		for ( tIndex = 0; tIndex < itSeg->second.size( ); tIndex += tCount, dwAddress += ( uint32_t )tCount )
+		{
+			// check for a page record
+			if (( dwAddress >> 16 ) != dwUpper )
+			{
+				dwUpper = dwAddress >> 16;
+				ptWriter->Start( ':', '\0' );
+				ptWriter->PutByte( 2 );
+				ptWriter->PutByte( 0 );
+				ptWriter->PutByte( 0 );
+				ptWriter->PutByte( 0x04 );
+				ptWriter->PutByte(( uint8_t )( dwUpper >> 8 ));
+				ptWriter->PutByte(( uint8_t )dwUpper );
+				ptWriter->PutByte(( uint8_t )-ptWriter->GetSum( ));
+				ptWriter->End( );
+			}
+
+			// compute the number of output bytes
+			tCount = itSeg->second.size( ) - tIndex;
+			if ( tCount > m_OutputByteCount )
+				tCount = m_OutputByteCount;
+			if ( tCount > ( 0x10000 - ( dwAddress & 0xFFFF )))
+				tCount = 0x10000 - ( dwAddress & 0xFFFF );
+
+			// output the count/address/type/data/checksum
+			ptWriter->Start( ':', '\0' );
+			ptWriter->PutByte(( uint8_t )tCount );
+			ptWriter->PutByte(( uint8_t )( dwAddress >> 8 ));
+			ptWriter->PutByte(( uint8_t )dwAddress );
+			ptWriter->PutByte( 0x00 );
+			ptWriter->PutBytes( &itSeg->second[ tIndex ], tCount );
+			ptWriter->PutByte(( uint8_t )-ptWriter->GetSum( ));
+			ptWriter->End( );
+		}
+	}
+
+	// output the end of file
+	ptWriter->Start( ':', '\0' );
+	ptWriter->PutByte( 0 );
+	ptWriter->PutByte( 0 );
+	ptWriter->PutByte( 0 );
+	ptWriter->PutByte( 0x01 );
+	ptWriter->PutByte( 0xFF );
+	ptWriter->End( );
+
+	// flush it
+	fStatus = ptWriter->Flush( );
+	delete ptWriter;
+	return( fStatus );
+}
+
+bool CHexImage::GenS19( FILE* pfilData ) const
+{
+	CRecordWriter*				      ptWriter = new CRecordWriter( pfilData );
+	SEGMENTMAP::const_iterator	itSeg;
+	uint64_t					          hHigh = GetHighAddress( );
+	uint32_t					          dwAddress;
+	size_t						          tIndex, tCount;
+	int							            iAddrLength, iByte;
+	bool						            fStatus;
+
+	// determine address length from the highest address
+	if ( hHigh <= 0x10000 )
+		iAddrLength = 2;
+	else if ( hHigh <= 0x1000000 )
+		iAddrLength = 3;
+	else
+		iAddrLength = 4;
+
+	// for each segment
+	for ( itSeg = m_mapSegments.begin( ); itSeg != m_mapSegments.end( ); ++itSeg )
+	{
+		// for each record
+		dwAddress = itSeg->first;
+		for ( tIndex = 0; tIndex < itSeg->second.size( ); tIndex += tCount, dwAddress += ( uint32_t )tCount )
+		{
+			// compute the number of output bytes
+			tCount = itSeg->second.size( ) - tIndex;
+			if ( tCount > m_OutputByteCount )
+				tCount = m_OutputByteCount;
+
+			// output the type/count/address/data/checksum
+			ptWriter->Start( 'S', ( char )( '0' + iAddrLength - 1 ));
+			ptWriter->PutByte(( uint8_t )( tCount + iAddrLength + 1 ));
+			for ( iByte = iAddrLength - 1; iByte >= 0; iByte-- )
+				ptWriter->PutByte(( uint8_t )( dwAddress >> ( iByte * 8 )));
+			ptWriter->PutBytes( &itSeg->second[ tIndex ], tCount );
+			ptWriter->PutByte(( uint8_t )~ptWriter->GetSum( ));
+			ptWriter->End( );
+		}
+	}
+
+	// output the end record
+	ptWriter->Start( 'S', ( char )( '9' - ( iAddrLength - 2 )));
+	ptWriter->PutByte(( uint8_t )( iAddrLength + 1 ));
+	for ( iByte = 0; iByte < iAddrLength; iByte++ )
+		ptWriter->PutByte( 0 );
+	ptWriter->PutByte(( uint8_t )~ptWriter->GetSum( ));
+	ptWriter->End( );
+
+	// flush it
+	fStatus = ptWriter->Flush( );
+	delete ptWriter;
+	return( fStatus );
+}
+
+bool CHexImage::GenBin( FILE* pfilData ) const
+{
+	SEGMENTMAP::const_iterator	itSeg;
+	uint8_t						          anFill[ CRC_CHUNK_SIZE ];
+	uint64_t					          hAddress = GetLowAddress( );
+	size_t						          tLength;
+	bool						            fStatus = true;
+
+	// for each segment, gaps are written as the fill value
+	memset( anFill, m_nFill, sizeof( anFill ));
+	for ( itSeg = m_mapSegments.begin( ); ( fStatus ) && ( itSeg != m_mapSegments.end( )); ++itSeg )
+	{
+		// fill up to the segment
+		while (( fStatus ) && ( hAddress < itSeg->first ))
+		{
+			tLength = (( itSeg->first - hAddress ) < sizeof( anFill )) ? ( size_t )( itSeg->first - hAddress ) : sizeof( anFill );
+			fStatus = ( fwrite( anFill, 1, tLength, pfilData ) == tLength );
+			hAddress += tLength;
+		}
+
+		// write the segment
+		if ( fStatus )
+			fStatus = ( fwrite( &itSeg->second[ 0 ], 1, itSeg->second.size( ), pfilData ) == itSeg->second.size( ));
+		hAddress += itSeg->second.size( );
+	}
+
+	// return the status
+	return( fStatus );
+}
@@ -0,0 +1,110 @@
+/*****************************************************************************
+//   $Workfile: HexImage.h $
+//    Function: Hex Image Class Declarations
+//   $JustDate: $
+//   $Revision: 1.0 $
+//
+//	This document contains proprietary data and information of Cyber Integration
+//  LLC.  It is the exclusive property of Cyber Integration, LLC and
+//  will not be disclosed in any form to any party without prior written
+//  permission of Cyber Integration, LLC.	This document may not be reproduced
+//  or further used without the prior written permission of Cyber Integration
+//  LLC.
+//
+//  Copyright (C) 2004 Cyber Integration, LLC. All Rights Reserved
+//
+//   $History: HexImage.h $
+ *
+ * Portable image engine behind CHexFiles.  It has no MFC dependencies, the
+ * input file is memory mapped and parsed in place into a sparse map of
+ * contiguous segments keyed by start address, so multi-megabyte images with
+ * gaps load without growing a dense array.
+ *
+ ******************************************************************************/
+
+#if !defined(HEXIMAGE_H_INCLUDED)
+#define HEXIMAGE_H_INCLUDED
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <vector>
+
+class CHexImage
+{
+public:
+	CHexImage( uint8_t nFill = 0xFF );
+	virtual ~CHexImage();
+
+// attributes
+public:
+	// the formats, these match CHexFiles::OUTMODE
+	typedef enum _FORMAT
+	{
+		FORMAT_S19 = 0,
+		FORMAT_HEX,
+		FORMAT_BIN,
+	} FORMAT;
+
+	// the status
+	typedef enum _STATUS
+	{
+		STATUS_OK = 0,
+		STATUS_OPENERROR,
+		STATUS_SYNTAXERROR,
+		STATUS_CHECKSUMERROR,
+		STATUS_ADDRESSERROR,
+		STATUS_WRITEERROR,
+	} STATUS;
+
+	// the segment map, contiguous data keyed by start address, segments never
+	// touch or overlap
+	typedef std::map< uint32_t, std::vector< uint8_t > > SEGMENTMAP;
+
+protected:
+	SEGMENTMAP            m_mapSegments;
+	SEGMENTMAP::iterator  m_itLast;
+	uint8_t               m_nFill;
+	size_t                m_tErrorLine;
+
+	// declare the constants
+	static const uint8_t	m_OutputByteCount	= 16;
+
+// implementation
+public:
+	STATUS	ParseFile( const char* pszFileName, uint32_t dwOffset = 0 );
+	STATUS	ParseBuffer( const char* pcData, size_t tLength, uint32_t dwOffset = 0 );
+	STATUS	LoadBinary( const char* pszFileName, uint32_t dwAddress );
+	STATUS	GenerateFile( const char* pszFileName, FORMAT eFormat ) const;
+	void	  Clear( void );
+	void	  Write( uint32_t dwAddress, const uint8_t* pnData, size_t tLength );
+	size_t	Read( uint32_t dwAddress, uint8_t* pnData, size_t tLength ) const;
+	uint8_t	GetByte( uint32_t dwAddress ) const;
+	bool	  IsEmpty( void ) const;
+	uint32_t	GetLowAddress( void ) const;
+	uint64_t	GetHighAddress( void ) const;
+	uint16_t	ComputeCrc16( uint32_t dwStartAddress, uint32_t dwEndAddress ) const;
+	uint32_t	ComputeCrc32( uint32_t dwStartAddress, uint32_t dwEndAddress ) const;
+	size_t	GetErrorLine( void ) const { return( m_tErrorLine ); }
+	uint8_t	GetFill( void ) const { return( m_nFill ); }
+	const SEGMENTMAP&	GetSegments( void ) const { return( m_mapSegments ); }
+
+	// block CRCs, CRC-16 CCITT and CRC-32 matching CCrc16Tabl/CCrc32Tabl, the
+	// CRC-32 value is running and must be complemented when done
+	static uint16_t	Crc16Block( uint16_t wCrc, const uint8_t* pnData, size_t tLength );
+	static uint32_t	Crc32Block( uint32_t dwCrc, const uint8_t* pnData, size_t tLength );
+
+protected:
+	STATUS	ParseHex( const uint8_t* pnRecord, size_t tLength, uint32_t dwOffset, uint32_t& dwBase, bool& fDone );
+	STATUS	ParseS19( char cType, const uint8_t* pnRecord, size_t tLength, uint32_t dwOffset, bool& fDone );
+	bool	  GenHex( FILE* pfilData ) const;
+	bool	  GenS19( FILE* pfilData ) const;
+	bool	  GenBin( FILE* pfilData ) const;
+};
+
+#endif // !defined(HEXIMAGE_H_INCLUDED)
@@ -0,0 +1,258 @@
+/*****************************************************************************
+//   $Workfile: HexImageTool.cpp $
+//    Function: Hex Image Command Line Tool
+//   $JustDate: $
+//   $Revision: 1.0 $
+//
+//	  This document contains proprietary data and information of Cyber Integration
+//  LLC.  It is the exclusive property of Cyber Integration, LLC and
+//  will not be disclosed in any form to any party without prior written
+//  permission of Cyber Integration, LLC.	This document may not be reproduced
+//  or further used without the prior written permission of Cyber Integration
+//  LLC.
+//
+//  Copyright (C) 2004 Cyber Integration, LLC. All Rights Reserved
+//
+//  $History: $
+ *
+ * Command line front end for CHexImage.  Input files ending in .bin are
+ * loaded raw at the base address, anything else is parsed as Intel HEX or
+ * S19.  The output format follows the output extension.
+ *
+ * build with: c++ -O2 -o HexImageTool HexImageTool.cpp HexImage.cpp
+ * usage:      HexImageTool info <input> [-o offset] [-b base]
+ *             HexImageTool convert <input> <output> [-o offset] [-b base]
+ *             HexImageTool crc <input> <start> <end> [-o offset] [-b base]
+ *             HexImageTool bench [megabytes]
+ *
+ ******************************************************************************/
+
+#include "HexImage.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//////////////////////////////////////////////////////////////////////
+// local defines
+//////////////////////////////////////////////////////////////////////
+#define	BENCH_DEFAULT_SIZE	( 16 )
+#define	BENCH_BASE_ADDRESS	( 0x08000000 )
+#define	BENCH_HEX_FILE		  "heximage_bench.hex"
+#define	BENCH_S19_FILE		  "heximage_bench.s19"
+#define	BENCH_BIN_FILE		  "heximage_bench.bin"
+
+//////////////////////////////////////////////////////////////////////
+// local functions
+//////////////////////////////////////////////////////////////////////
+static bool		HasExtension( const char* pszFileName, const char* pszExtension )
+{
+	size_t	tName = strlen( pszFileName );
+	size_t	tExt = strlen( pszExtension );
+
+	// compare the tail
+	return(( tName >= tExt ) && ( strcmp( pszFileName + tName - tExt, pszExtension ) == 0 ));
+}
+
+static const char*	GetStatusText( CHexImage::STATUS eStatus )
+{
+	// return the text
+	switch ( eStatus )
+	{
+	case CHexImage::STATUS_OK :			        return( "ok" );
+	case CHexImage::STATUS_OPENERROR :	    return( "unable to open file" );
+	case CHexImage::STATUS_SYNTAXERROR :	  return( "syntax error" );
+	case CHexImage::STATUS_CHECKSUMERROR :	return( "checksum error" );
+	case CHexImage::STATUS_ADDRESSERROR :	  return( "illegal address" );
+	case CHexImage::STATUS_WRITEERROR :	    return( "write error" );
+	default :							                  return( "unknown error" );
+	}
+}
+
+static bool		LoadImage( CHexImage& tImage, const char* pszFileName, uint32_t dwOffset, uint32_t dwBase )
+{
+	CHexImage::STATUS	eStatus;
+
+	// load it
+	if ( HasExtension( pszFileName, ".bin" ))
+		eStatus = tImage.LoadBinary( pszFileName, dwBase );
+	else
+		eStatus = tImage.ParseFile( pszFileName, dwOffset );
+
+	// report errors
+	if ( eStatus != CHexImage::STATUS_OK )
+	{
+		if ( tImage.GetErrorLine( ) != 0 )
+			fprintf( stderr, "%s(%u): %s\n", pszFileName, ( unsigned )tImage.GetErrorLine( ), GetStatusText( eStatus ));
+		else
+			fprintf( stderr, "%s: %s\n", pszFileName, GetStatusText( eStatus ));
+	}
+
+	// return the status
+	return( eStatus == CHexImage::STATUS_OK );
+}
+
+static CHexImage::FORMAT	GetFormat( const char* pszFileName )
+{
+	// determine the format from the extension
+	if ( HasExtension( pszFileName, ".bin" ))
+		return( CHexImage::FORMAT_BIN );
+	else if ( HasExtension( pszFileName, ".s19" ) || HasExtension( pszFileName, ".srec" ) || HasExtension( pszFileName, ".mot" ))
+		return( CHexImage::FORMAT_S19 );
+	else
+		return( CHexImage::FORMAT_HEX );
+}
+
+static double	GetSeconds( void )
+{
+	struct timespec	tTime;
+
+	// get the monotonic time
+	clock_gettime( CLOCK_MONOTONIC, &tTime );
+	return( tTime.tv_sec + ( tTime.tv_nsec / 1e9 ));
+}
+
+static void		ReportBench( const char* pszName, double dStart, size_t tBytes )
+{
+	double	dElapsed = GetSeconds( ) - dStart;
+
+	// report the time/rate
+	printf( "  %-24s %8.3f s %8.1f MB/s\n", pszName, dElapsed, ( tBytes / 1048576.0 ) / dElapsed );
+}
+
+static int		RunBench( size_t tMegabytes )
+{
+	CHexImage		    tSource, tImage;
+	std::vector< uint8_t >	anData( tMegabytes * 1048576 );
+	uint32_t		    dwState = 0x12345678, dwCrc = 0;
+	double			    dStart;
+	size_t			    tIndex;
+	int				      iStatus = 0;
+
+	// build a pseudo random image with a few gaps, like a linked firmware image
+	for ( tIndex = 0; tIndex < anData.size( ); tIndex++ )
+	{
+		dwState = dwState * 1664525 + 1013904223;
+		anData[ tIndex ] = ( uint8_t )( dwState >> 24 );
+	}
+	for ( tIndex = 0; tIndex < anData.size( ); tIndex += 1048576 )
+		tSource.Write( BENCH_BASE_ADDRESS + ( uint32_t )tIndex, &anData[ tIndex ], ( anData.size( ) - tIndex ) < 1048576 - 4096 ? anData.size( ) - tIndex : 1048576 - 4096 );
+	printf( "%u MB image at %08X\n", ( unsigned )tMegabytes, BENCH_BASE_ADDRESS );
+
+	// generate
+	dStart = GetSeconds( );
+	tSource.GenerateFile( BENCH_HEX_FILE, CHexImage::FORMAT_HEX );
+	ReportBench( "generate hex", dStart, anData.size( ));
+	dStart = GetSeconds( );
+	tSource.GenerateFile( BENCH_S19_FILE, CHexImage::FORMAT_S19 );
+	ReportBench( "generate s19", dStart, anData.size( ));
+	dStart = GetSeconds( );
+	tSource.GenerateFile( BENCH_BIN_FILE, CHexImage::FORMAT_BIN );
+	ReportBench( "generate bin", dStart, anData.size( ));
+
+	// parse them back
+	dStart = GetSeconds( );
+	if ( tImage.ParseFile( BENCH_HEX_FILE ) != CHexImage::STATUS_OK )
+		iStatus = 1;
+	ReportBench( "parse hex", dStart, anData.size( ));
+	tImage.Clear( );
+	dStart = GetSeconds( );
+	if ( tImage.ParseFile( BENCH_S19_FILE ) != CHexImage::STATUS_OK )
+		iStatus = 1;
+	ReportBench( "parse s19", dStart, anData.size( ));
+
+	// compute the CRCs
+	dStart = GetSeconds( );
+	dwCrc = tImage.ComputeCrc32( tImage.GetLowAddress( ), ( uint32_t )tImage.GetHighAddress( ));
+	ReportBench( "crc32", dStart, anData.size( ));
+	dStart = GetSeconds( );
+	tImage.ComputeCrc16( tImage.GetLowAddress( ), ( uint32_t )tImage.GetHighAddress( ));
+	ReportBench( "crc16", dStart, anData.size( ));
+
+	// check the round trip
+	if (( iStatus != 0 ) || ( dwCrc != tSource.ComputeCrc32( tSource.GetLowAddress( ), ( uint32_t )tSource.GetHighAddress( ))) || ( tImage.GetSegments( ) != tSource.GetSegments( )))
+	{
+		fprintf( stderr, "round trip mismatch\n" );
+		iStatus = 1;
+	}
+
+	// clean up
+	remove( BENCH_HEX_FILE );
+	remove( BENCH_S19_FILE );
+	remove( BENCH_BIN_FILE );
+	return( iStatus );
+}
+
+static void		Usage( const char* pszName )
+{
+	// display the usage
+	fprintf( stderr, "usage: %s info <input> [-o offset] [-b base]\n", pszName );
+	fprintf( stderr, "       %s convert <input> <output> [-o offset] [-b base]\n", pszName );
+	fprintf( stderr, "       %s crc <input> <start> <end> [-o offset] [-b base]\n", pszName );
+	fprintf( stderr, "       %s bench [megabytes]\n", pszName );
+}
+
+//////////////////////////////////////////////////////////////////////
+// main entry
+//////////////////////////////////////////////////////////////////////
+int main( int argc, char* argv[ ] )
+{
+	CHexImage	  tImage;
+	CHexImage::SEGMENTMAP::const_iterator	itSeg;
+	uint32_t	  dwOffset = 0, dwBase = 0, dwStart, dwEnd;
+	int			    iArgs, iStatus = 0;
+	CHexImage::STATUS	eStatus;
+
+	// check for the bench
+	if (( argc >= 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ))
+		return( RunBench(( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : BENCH_DEFAULT_SIZE ));
+
+	// strip the options
+	for ( iArgs = argc; ( iArgs >= 2 ) && ( argv[ iArgs - 2 ][ 0 ] == '-' ); iArgs -= 2 )
+	{
+		if ( strcmp( argv[ iArgs - 2 ], "-o" ) == 0 )
+			dwOffset = strtoul( argv[ iArgs - 1 ], NULL, 0 );
+		else if ( strcmp( argv[ iArgs - 2 ], "-b" ) == 0 )
+			dwBase = strtoul( argv[ iArgs - 1 ], NULL, 0 );
+		else
+			break;
+	}
+
+	// check the command
+	if (( iArgs == 3 ) && ( strcmp( argv[ 1 ], "info" ) == 0 ))
+	{
+		// load it/display the segments
+		if ( !LoadImage( tImage, argv[ 2 ], dwOffset, dwBase ))
+			return( 1 );
+		for ( itSeg = tImage.GetSegments( ).begin( ); itSeg != tImage.GetSegments( ).end( ); ++itSeg )
+			printf( "%08X-%08X %10u bytes\n", itSeg->first, ( unsigned )( itSeg->first + itSeg->second.size( ) - 1 ), ( unsigned )itSeg->second.size( ));
+		printf( "%u segments, CRC32 %08X\n", ( unsigned )tImage.GetSegments( ).size( ), tImage.ComputeCrc32( tImage.GetLowAddress( ), ( uint32_t )tImage.GetHighAddress( )));
+	}
+	else if (( iArgs == 4 ) && ( strcmp( argv[ 1 ], "convert" ) == 0 ))
+	{
+		// load it/generate the output
+		if ( !LoadImage( tImage, argv[ 2 ], dwOffset, dwBase ))
+			return( 1 );
+		if (( eStatus = tImage.GenerateFile( argv[ 3 ], GetFormat( argv[ 3 ] ))) != CHexImage::STATUS_OK )
+		{
+			fprintf( stderr, "%s: %s\n", argv[ 3 ], GetStatusText( eStatus ));
+			iStatus = 1;
+		}
+	}
+	else if (( iArgs == 5 ) && ( strcmp( argv[ 1 ], "crc" ) == 0 ))
+	{
+		// load it/compute the CRCs over start to end exclusive
+		if ( !LoadImage( tImage, argv[ 2 ], dwOffset, dwBase ))
+			return( 1 );
+		dwStart = strtoul( argv[ 3 ], NULL, 0 );
+		dwEnd = strtoul( argv[ 4 ], NULL, 0 );
+		printf( "CRC16 %04X CRC32 %08X\n", tImage.ComputeCrc16( dwStart, dwEnd ), tImage.ComputeCrc32( dwStart, dwEnd ));
+	}
+	else
+	{
+		Usage( argv[ 0 ] );
+		iStatus = 1;
+	}
+
+	// return the status
+	return( iStatus );
+}
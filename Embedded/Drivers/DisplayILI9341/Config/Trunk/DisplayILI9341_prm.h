@@ -32,7 +32,7 @@
 
 // library includes -----------------------------------------------------------
 #include "GPIO/Gpio.h"
-#include "I2C/I2c.h"
+#include "SPI/Spi.h"
 
 // Macros and Defines ---------------------------------------------------------
 /// define the GPIO pins for the command data select and the chip enable
@@ -40,7 +40,7 @@
 #define DISPLAYILI9341_CENB_ENUM        ( GPIO_PIN_ENUM_ILLEGAL )
 
 /// define the SPI enumeration
-#define DISPLAYIL9341_SPI_ENUM          ( SPI_ENUM_ILLEGAL )
+#define DISPLAYIL9341_SPI_ENUM          ( SPI_DEV_ENUM_ILLEGAL )
 
 /**@} EOF DisplayILI9341_prm.h */
 
@@ -22,12 +22,14 @@
  *****************************************************************************/
 
 // system includes ------------------------------------------------------------
+#include <stdlib.h>
 
 // local includes -------------------------------------------------------------
 #include  "DisplayILI9341/DisplayILI9341.h"
 #include  "DisplayILI9341/DisplayILI9341_prv.h"
 
 // library includes -----------------------------------------------------------
+#include  "SystemTick/SystemTick.h"
 
 // Macros and Defines ---------------------------------------------------------
 /// define the helper macros for initializing the initialization table
@@ -74,14 +76,16 @@ typedef struct _INITDATA
 // local parameter declarations -----------------------------------------------
 
 // local function prototypes --------------------------------------------------
-static  void  WriteDataBlock( PU8 pnData, U16 wLegnth );
+static  void  WriteDataBlock( PU16 pwData, U16 wLength );
+static  void  WriteColorRun( U16 wColor, U32 uCount );
 static  void  WriteDataWord( U16 wValue );
 static  void  WriteDataByte( U8 nValue );
 static  void  WriteCommand( U8 nValue );
 static  void  Write( U8 nValue );
+static  U8    ReadDataByte( U8 nAddr, U8 nParam );
 
 // constant parameter initializations -----------------------------------------
-static  const CODE atInitData[ ] =
+static  const CODE INITDATA atInitData[ ] =
 {
   CMDDEF( 0x01 ),
   DLYDEF( 200  ),
@@ -188,7 +192,7 @@ static  const CODE atInitData[ ] =
   
   CMDDEF( 0x29 ),   // display on
   
-  ENDDEF
+  ENDDEF( )
 };
 
 /******************************************************************************
@@ -222,7 +226,7 @@ void DisplayILI9314_Initialize( void )
         
       case CMDDATA_TYPE_DAT :
         // write a data byte
-        WriteData( ptInitEntry->nValue );
+        WriteDataByte( ptInitEntry->nValue );
         break;
         
       case CMDDATA_TYPE_DLY :
@@ -291,7 +295,7 @@ void DisplayILI9314_SetPage( U16 wStartPage, U16 wEndPage )
 void DisplayILI9314_SetXY( U16 wXPoint, U16 wYPoint )
 {
   // set the column with xPoint, page with yPoint
-  DisplayILI9314_SetColumn( wxPoint, wxPoint );
+  DisplayILI9314_SetColumn( wXPoint, wXPoint );
   DisplayILI9314_SetPage( wYPoint, wYPoint );
   
   // send the command
@@ -335,9 +339,6 @@ void DisplayILI9314_SetPixel( U16 wXPoint, U16 wYPoint, U16 wColor )
  *****************************************************************************/
 void DisplayILI9314_FillScreen( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U16 wColor )
 {
-  U32 uCount, uIndex;
-  U8  nColorMsb, nColorLsb;
-
   // adjust for start lower than end
   if ( wXLeft > wXRight )
   {
@@ -351,46 +352,180 @@ void DisplayILI9314_FillScreen( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U
   if ( wYUp > wYDown )
   {
     wYUp ^= wYDown;
-    wYDown ^= wYup;
+    wYDown ^= wYUp;
     wYUp ^= wYDown;
   }
   
   // constrain to display size
   wXLeft = CONSTRAIN( wXLeft, DISPLAY_ILI9314_MIN_X, DISPLAY_ILI9314_MAX_X );
   wXRight = CONSTRAIN( wXRight, DISPLAY_ILI9314_MIN_X, DISPLAY_ILI9314_MAX_X );
-  wXUp = CONSTRAIN( wXUp, DISPLAY_ILI9314_MIN_Y, DISPLAY_ILI9314_MAX_Y );
-  wXDown = CONSTRAIN( wXDown, DISPLAY_ILI9314_MIN_Y, DISPLAY_ILI9314_MAX_Y );
+  wYUp = CONSTRAIN( wYUp, DISPLAY_ILI9314_MIN_Y, DISPLAY_ILI9314_MAX_Y );
+  wYDown = CONSTRAIN( wYDown, DISPLAY_ILI9314_MIN_Y, DISPLAY_ILI9314_MAX_Y );
 
-  // compute the total count
-  uCount = ( wXRight - wXLeft + 1 ) * ( wYDown - wYUP + 1 );
+  // fill it
+  DisplayILI9314_FillSpan( wXLeft, wXRight, wYUp, wYDown, wColor );
+}
 
-  // set the column with xPoint, page with yPoint
+/******************************************************************************
+ * @function DisplayILI9314_OpenWindow
+ *
+ * @brief open a write window
+ *
+ * This function will set the column/page window and start a memory write,
+ * pixels written with DisplayILI9314_WritePixels fill the window left to 
+ * right, top to bottom
+ *
+ * @param[in]   wXLeft    x left coordinate
+ * @param[in]   wXRight   x right coordinate
+ * @param[in]   wYUp      y up coordiante
+ * @param[in]   wYDown    y down coordiante
+ *
+ *****************************************************************************/
+void DisplayILI9314_OpenWindow( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown )
+{
+  // set the column/page window
   DisplayILI9314_SetColumn( wXLeft, wXRight );
   DisplayILI9314_SetPage( wYUp, wYDown );
   
-  // send a command
+  // send the memory write command
   WriteCommand( 0x2C );
+}
+
+/******************************************************************************
+ * @function DisplayILI9314_WritePixels
+ *
+ * @brief write pixels into the open window
+ *
+ * This function will stream a block of pixels into the current window with
+ * a single chip select
+ *
+ * @param[in]   pwPixels  pointer to the pixel colors
+ * @param[in]   wCount    number of pixels
+ *
+ *****************************************************************************/
+void DisplayILI9314_WritePixels( PU16 pwPixels, U16 wCount )
+{
+  // write the block
+  WriteDataBlock( pwPixels, wCount );
+}
+
+/******************************************************************************
+ * @function DisplayILI9314_FillSpan
+ *
+ * @brief fill a span with a color
+ *
+ * This function will open a single window and stream the color into it, a 
+ * horizontal or vertical line is a window one pixel high or wide
+ *
+ * @param[in]   wXLeft    x left coordinate
+ * @param[in]   wXRight   x right coordinate, inclusive
+ * @param[in]   wYUp      y up coordiante
+ * @param[in]   wYDown    y down coordiante, inclusive
+ * @param[in]   wColor    desired color
+ *
+ *****************************************************************************/
+void DisplayILI9314_FillSpan( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U16 wColor )
+{
+  // check for a valid span
+  if (( wXLeft <= wXRight ) && ( wYUp <= wYDown ))
+  {
+    // open the window/stream the color
+    DisplayILI9314_OpenWindow( wXLeft, wXRight, wYUp, wYDown );
+    WriteColorRun( wColor, ( U32 )( wXRight - wXLeft + 1 ) * ( U32 )( wYDown - wYUp + 1 ));
+  }
+}
+
+/******************************************************************************
+ * @function DisplayILI9314_BlitRect
+ *
+ * @brief copy a block of pixels to the display
+ *
+ * This function will open a single window and stream the pixels into it, 
+ * the pixels are stored row by row
+ *
+ * @param[in]   wXLeft    x left coordinate
+ * @param[in]   wYUp      y up coordiante
+ * @param[in]   wWidth    width of the block
+ * @param[in]   wHeight   height of the block
+ * @param[in]   pwPixels  pointer to the pixel colors
+ *
+ *****************************************************************************/
+void DisplayILI9314_BlitRect( U16 wXLeft, U16 wYUp, U16 wWidth, U16 wHeight, PU16 pwPixels )
+{
+  U16 wRow;
   
-  // set the command low
-  Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
-  
-  // chip enable it
-  Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
-  
-  // get the color value
-  nColorMsb = HI16( wColor );
-  nColocLsb = LO16( wColor );
-  
-  // for the total count
-  for ( uIndex = 0; uIndex < uCount; uIndex++ )
+  // check for a valid block
+  if (( wWidth != 0 ) && ( wHeight != 0 ))
   {
-    // write the color
-    Spi_Write( DISPLAYIL9341_SPI_ENUM, nColorMsb );
-    Spi_Write( DISPLAYIL9341_SPI_ENUM, nColorLsb );
+    // open the window
+    DisplayILI9314_OpenWindow( wXLeft, wXLeft + wWidth - 1, wYUp, wYUp + wHeight - 1 );
+    
+    // for each row
+    for ( wRow = 0; wRow < wHeight; wRow++ )
+    {
+      // write the row
+      DisplayILI9314_WritePixels( pwPixels + (( U32 )wRow * wWidth ), wWidth );
+    }
   }
+}
+
+/******************************************************************************
+ * @function DisplayILI9314_BlitGlyph1bpp
+ *
+ * @brief draw a one bit per pixel glyph
+ *
+ * This function will open a single window for the scaled glyph and stream
+ * the foreground/background colors into it with a single chip select.  The
+ * glyph is stored a column per byte, least significant bit at the top, as
+ * in the font tables
+ *
+ * @param[in]   wXLeft    x left coordinate
+ * @param[in]   wYUp      y up coordiante
+ * @param[in]   pnColumns pointer to the glyph columns
+ * @param[in]   nWidth    number of columns
+ * @param[in]   nHeight   number of rows, 8 maximum
+ * @param[in]   nScale    scale factor
+ * @param[in]   wFgColor  foreground color
+ * @param[in]   wBgColor  background color
+ *
+ *****************************************************************************/
+void DisplayILI9314_BlitGlyph1bpp( U16 wXLeft, U16 wYUp, const CODE U8* pnColumns, U8 nWidth, U8 nHeight, U8 nScale, U16 wFgColor, U16 wBgColor )
+{
+  U16UN tValue;
+  U16   wX, wY, wWidth, wHeight;
+  U8    nMask;
   
-  // disable it
-  Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
+  // check for a valid glyph
+  if (( nWidth != 0 ) && ( nHeight != 0 ) && ( nScale != 0 ))
+  {
+    // compute the scaled size/open the window
+    wWidth = nWidth * nScale;
+    wHeight = nHeight * nScale;
+    DisplayILI9314_OpenWindow( wXLeft, wXLeft + wWidth - 1, wYUp, wYUp + wHeight - 1 );
+    
+    // set the data select/chip enable
+    Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
+    Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
+    
+    // for each row
+    for ( wY = 0; wY < wHeight; wY++ )
+    {
+      // compute the row mask
+      nMask = BIT(( wY / nScale ));
+      
+      // for each column
+      for ( wX = 0; wX < wWidth; wX++ )
+      {
+        // select the color/write it
+        tValue.wValue = (( PGM_RDBYTE( pnColumns[ wX / nScale ] ) & nMask ) != 0 ) ? wFgColor : wBgColor;
+        Spi_Write( DISPLAYIL9341_SPI_ENUM, tValue.anValue[ LE_U16_MSB_IDX ] );
+        Spi_Write( DISPLAYIL9341_SPI_ENUM, tValue.anValue[ LE_U16_LSB_IDX ] );
+      }
+    }
+    
+    // disable it
+    Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
+  }
 }
 
 /******************************************************************************
@@ -407,28 +542,8 @@ void DisplayILI9314_FillScreen( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U
  *****************************************************************************/
 void DisplayILI9314_ClearScreen( void )
 {
-  // set the column with xPoint, page with yPoint
-  DisplayILI9314_SetColumn( 0, DISPLAYILI9314_MAX_COL );
-  DisplayILI9314_SetPage( 0, DISPLAYILI9314_MAX_ROW );
-  
-  // send the command
-  WriteCommand( 0x2C );
-
-  // set the command low
-  Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
-  
-  // chip enable it
-  Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
-  
-  // for each pixel
-  for ( wIndex = 0; wIndex < DISPLAYILI9314_MAX_PIXELS; wIndex++ )
-  {
-    // write 4 bytes
-    Spi_Write( DISPLAYIL9341_SPI_ENUM, 0 );
-  }
-  
-  // chip disable
-  Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
+  // fill the whole display with black
+  DisplayILI9314_FillSpan( DISPLAY_ILI9314_MIN_X, DISPLAY_ILI9314_MAX_X, DISPLAY_ILI9314_MIN_Y, DISPLAY_ILI9314_MAX_Y, DISPLAY_ILI9314_COLOR_BLK );
 }
 
 /******************************************************************************
@@ -460,7 +575,7 @@ void DisplayILI9314_DrawString( PC8 pcString, U8 nCharSize, U16 wXPoint, U16 wYP
     if ( wXPoint < DISPLAY_ILI9314_MAX_X )
     {
       // increment the cursor location
-      wXPoint += ( FONT_SPACE * nCharSize );
+      wXPoint += ( FONT_SPACE_SIZE * nCharSize );
     }
   }
 }
@@ -481,13 +596,11 @@ void DisplayILI9314_DrawString( PC8 pcString, U8 nCharSize, U16 wXPoint, U16 wYP
  *****************************************************************************/
 void DisplayILI9314_DrawChar( C8 cChar, U8 nCharSize, U16 wXPoint, U16 wYPoint, U16 wColor )
 {
-  U8  nCharRow, nRowIdx, nBitIdx;
-  
   // validate character
   if (( cChar < ' ' ) || ( cChar > '~' ))
   {
     // set it to space
-    cChar = ' ';
+    cChar = 0;
   }
   else
   {
@@ -495,27 +608,8 @@ void DisplayILI9314_DrawChar( C8 cChar, U8 nCharSize, U16 wXPoint, U16 wYPoint,
     cChar -= ' ';
   }
   
-  // for each row
-  for( nRowIdx = 0; nRowIdx < FONT_X_SIZE; nRowIdx++ )
-  {
-    // get the row value
-    nCharRow = PGM_RDBYTE( anFonts[ cChar ][ nRowIdx ] );
-    
-    // for each entry in the table
-    for ( nBitIdx = 0; nBitIdx < FONT_X_SIZE; nBitIdx++ )
-    {
-      // if bit is set
-      if (( nCharRow & BIT( nBitIdx )) != 0 )
-      {
-        // draw it
-        DisplayILI9314_FillScreen(( wXPoint + ( nRowIdx * nCharSize )), 
-                                  (( wYPoint + ( nBitIdx * nCharSize )) + nCharSize ), 
-                                  ( wYPoint + ( nBitIdx * nCharSize )), 
-                                  (( wYPoint + ( nBitIdx * nCharSize )) + nCharSize, 
-                                  wColor );
-      }
-    }
-  }
+  // draw the glyph in a single window
+  DisplayILI9314_BlitGlyph1bpp( wXPoint, wYPoint, anFonts[ ( U8 )cChar ], FONT_X_SIZE, FONT_Y_SIZE, nCharSize, wColor, DISPLAY_ILI9314_COLOR_BLK );
 }
 
 /******************************************************************************
@@ -545,7 +639,7 @@ void DisplayILI9314_DrawRectangle( BOOL bFill, U16 wXLeft, U16 wXRight, U16 wLen
   if ( bFill )
   {
     // fill it
-    DisplayILI9314_FillScreen( wXLeft + 1, wXRight - 1, wYUp + 1, wYDown - 1, wColor );
+    DisplayILI9314_FillSpan( wXLeft + 1, wXLeft + wLength - 1, wXRight + 1, wXRight + wWidth - 1, wColor );
   }
 }
 
@@ -596,16 +690,21 @@ void DisplayILI9314_DrawCircle( BOOL bFill, U16 wXPoint, U16 wYPoint, U16 wRadiu
     sErr2 = sErr;
     if ( sErr2 <= sY )
     {
-      // recompute
-      sErr += (( sY + 1 ) * 2 ) + 1;
-      if (( -sX == sY ) && ( sErr2 <= sX )
+      // step y/recompute
+      sY++;
+      sErr += ( sY * 2 ) + 1;
+      if (( -sX == sY ) && ( sErr2 <= sX ))
       {
         sErr2 = 0;
       }
-      if ( sErr2 > sX )
-      {
-        sErr += (( sX + 1 ) * 2 ) + 1;
-      }
+    }
+    
+    // check for a step in x
+    if ( sErr2 > sX )
+    {
+      // step x/recompute
+      sX++;
+      sErr += ( sX * 2 ) + 1;
     }
   } while( sX <= 0 );
 }
@@ -617,6 +716,7 @@ void DisplayILI9314_DrawCircle( BOOL bFill, U16 wXPoint, U16 wYPoint, U16 wRadiu
  *
  * This function will draw a triangle
  *
+ * @param[in]   bFill     fill triangle, not supported
  * @param[in]   wXPoint1  x left coordinate
  * @param[in]   wYPoint1  y right coordinate
  * @param[in]   wXPoint2  x left coordinate
@@ -628,10 +728,13 @@ void DisplayILI9314_DrawCircle( BOOL bFill, U16 wXPoint, U16 wYPoint, U16 wRadiu
  *****************************************************************************/
 void DisplayILI9314_DrawTriangle( BOOL bFill, U16 wXPoint1, U16 wYPoint1, U16 wXPoint2, U16 wYPoint2, U16 wXPoint3, U16 wYPoint3, U16 wColor )
 {
+  // fill is not supported
+  ( void )bFill;
+  
   // draw the three sides
-  DisplayILI9314_DrawLine( wXPoint1, wYPoint1, wXPoint2, wYPoint2 );
-  DisplayILI9314_DrawLine( wXPoint1, wYPoint1, wXPoint3, wYPoint3 );
-  DisplayILI9314_DrawLine( wXPoint2, wYPoint2, wXPoint3, wYPoint3 );
+  DisplayILI9314_DrawLine( wXPoint1, wYPoint1, wXPoint2, wYPoint2, wColor );
+  DisplayILI9314_DrawLine( wXPoint1, wYPoint1, wXPoint3, wYPoint3, wColor );
+  DisplayILI9314_DrawLine( wXPoint2, wYPoint2, wXPoint3, wYPoint3, wColor );
 }
 
 /******************************************************************************
@@ -649,20 +752,11 @@ void DisplayILI9314_DrawTriangle( BOOL bFill, U16 wXPoint1, U16 wYPoint1, U16 wX
  *****************************************************************************/
 void DisplayILI9314_DrawVerticalLine( U16 wXStart, U16 wYStart, U16 wLength, U16 wColor )
 {
-  U16 wIndex;
-  
-  // set the column with xPoint, page with yPoint
-  DisplayILI9314_SetColumn( wxStart, wxStart );
-  DisplayILI9314_SetPage( wYStart, wYStart + wLength );
-  
-  // send the command
-  WriteCommand( 0x2C );
-  
-  // now write the color
-  for ( wIndex = 0; wIndex < wLength; wIndex++ )
+  // check for a valid length
+  if ( wLength != 0 )
   {
-    // write the color
-    WriteDataWord( wColor );
+    // fill the span
+    DisplayILI9314_FillSpan( wXStart, wXStart, wYStart, wYStart + wLength - 1, wColor );
   }
 }
 
@@ -681,20 +775,11 @@ void DisplayILI9314_DrawVerticalLine( U16 wXStart, U16 wYStart, U16 wLength, U16
  *****************************************************************************/
 void DisplayILI9314_DrawHorizontalLine( U16 wXStart, U16 wYstart, U16 wWidth, U16 wColor )
 {
-  U16 wIndex;
-  
-  // set the column with xPoint, page with yPoint
-  DisplayILI9314_SetColumn( wxStart, wxStart + wWidth );
-  DisplayILI9314_SetPage( wYStart, wYStart );
-  
-  // send the command
-  WriteCommand( 0x2C );
-  
-  // now write the color
-  for ( wIndex = 0; wIndex < wWidth; wIndex++ )
+  // check for a valid width
+  if ( wWidth != 0 )
   {
-    // write the color
-    WriteDataWord( wColor );
+    // fill the span
+    DisplayILI9314_FillSpan( wXStart, wXStart + wWidth - 1, wYstart, wYstart, wColor );
   }
 }
 
@@ -742,14 +827,14 @@ void DisplayILI9314_DrawLine( U16 wXStart, U16 wYStart, U16 wXEnd, U16 wYEnd, U1
       }
       
       // adjust 
-      sErr += sDY;
+      sErr += sDy;
       wXStart += sSx;
     }
     
     if ( sErr2 <= sDx )
     {
       // check for done
-      if ( wStartY == wYEnd )
+      if ( wYStart == wYEnd )
       {
         // break out of loop
         break;
@@ -763,7 +848,7 @@ void DisplayILI9314_DrawLine( U16 wXStart, U16 wYStart, U16 wXEnd, U16 wYEnd, U1
 }
 
 /******************************************************************************
- * @function ReadData
+ * @function ReadDataByte
  *
  * @brief read a data byte
  *
@@ -783,7 +868,7 @@ static U8 ReadDataByte( U8 nAddr, U8 nParam )
   WriteCommand( 0xD9 );
   
   // write the data
-  WriteData( 0x10 + nParam );
+  WriteDataByte( 0x10 + nParam );
   
   // set the command low
   Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, OFF );
@@ -816,16 +901,13 @@ static U8 ReadDataByte( U8 nAddr, U8 nParam )
  * the write function
  *
  * @param[in] pwData        block to be written  
- * @param[in] wLength       numbef of wordw to be written
+ * @param[in] wLength       number of words to be written
  *
  *****************************************************************************/
-static void WriteDataBlock( PW8 pwData, U16 wLength )
+static void WriteDataBlock( PU16 pwData, U16 wLength )
 {
   U16UN tValue;
-  U8    nIndex;
-  
-  // wtore it
-  tValue.wValue = wValue;
+  U16   wIndex;
   
   // set the command low
   Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
@@ -834,10 +916,10 @@ static void WriteDataBlock( PW8 pwData, U16 wLength )
   Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
   
   // for each entry
-  for( nIndex = 0; nIndex < wLength; nIndex++ )
+  for( wIndex = 0; wIndex < wLength; wIndex++ )
   {
     // store it
-    tValue.wValue = *( pwValue + nIndex );
+    tValue.wValue = *( pwData + wIndex );
     
     // now write the block
     Spi_Write( DISPLAYIL9341_SPI_ENUM, tValue.anValue[ LE_U16_MSB_IDX ] );
@@ -848,6 +930,41 @@ static void WriteDataBlock( PW8 pwData, U16 wLength )
   Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
 }
 
+/******************************************************************************
+ * @function WriteColorRun
+ *
+ * @brief write a run of a single color
+ *
+ * This function will set the data/command select line to data and write
+ * the color the requested number of times with a single chip select
+ *
+ * @param[in] wColor      color to be written  
+ * @param[in] uCount      number of pixels
+ *
+ *****************************************************************************/
+static void WriteColorRun( U16 wColor, U32 uCount )
+{
+  U16UN tValue;
+  
+  // store it
+  tValue.wValue = wColor;
+  
+  // set the data select/chip enable
+  Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
+  Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
+  
+  // for each pixel
+  while ( uCount-- != 0 )
+  {
+    // write the color
+    Spi_Write( DISPLAYIL9341_SPI_ENUM, tValue.anValue[ LE_U16_MSB_IDX ] );
+    Spi_Write( DISPLAYIL9341_SPI_ENUM, tValue.anValue[ LE_U16_LSB_IDX ] );
+  }
+  
+  // disable it
+  Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
+}
+
 /******************************************************************************
  * @function WriteDataWord
  *
@@ -881,7 +998,7 @@ static void WriteDataWord( U16 wValue )
 }
 
 /******************************************************************************
- * @function WriteData
+ * @function WriteDataByte
  *
  * @brief write a data byte
  *
@@ -891,7 +1008,7 @@ static void WriteDataWord( U16 wValue )
  * @param[in] nValue      value to be written  
  *
  *****************************************************************************/
-static void WriteData( U8 nValue )
+static void WriteDataByte( U8 nValue )
 {
   // set the command low
   Gpio_Set( DISPLAYILI9341_DCSEL_ENUM, ON );
@@ -934,13 +1051,13 @@ static void WriteCommand( U8 nValue )
 static void Write( U8 nValue )
 {
   // enable the chip select
-  Gpio_Set( DISPLAYIL9341_CENB_ENUM, ON );
+  Gpio_Set( DISPLAYILI9341_CENB_ENUM, ON );
   
   // write it
   Spi_Write( DISPLAYIL9341_SPI_ENUM, nValue );
   
   // disable the chip select
-  Gpio_Set( DISPLAYIL9341_CENB_ENUM, OFF );
+  Gpio_Set( DISPLAYILI9341_CENB_ENUM, OFF );
 }
  
 /**@} EOF DisplayILI9341.c */
@@ -35,7 +35,7 @@
 
 // Macros and Defines ---------------------------------------------------------
 /// define the RGB macro
-#define RGB( red, green, blue )       ((( red & 0x1F ) << 12 ) | (( grn & 0x3F ) << 6 ) | ( blu & 0x1F ))
+#define RGB( red, green, blue )       (((( red ) & 0x1F ) << 11 ) | ((( green ) & 0x3F ) << 5 ) | (( blue ) & 0x1F ))
 
 /// define the basic colors
 #define DISPLAY_ILI9314_COLOR_RED     RGB( 0x1F, 0x00, 0x00 )
@@ -67,6 +67,11 @@ extern  void  DisplayILI9314_SetPage( U16 wStartPage, U16 wEndPage );
 extern  void  DisplayILI9314_SetXY( U16 wXPoint, U16 wYPoint );
 extern  void  DisplayILI9314_SetPixel( U16 wXPoint, U16 wYPoint, U16 wColor );
 extern  void  DisplayILI9314_FillScreen( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U16 wColor );
+extern  void  DisplayILI9314_OpenWindow( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown );
+extern  void  DisplayILI9314_WritePixels( PU16 pwPixels, U16 wCount );
+extern  void  DisplayILI9314_FillSpan( U16 wXLeft, U16 wXRight, U16 wYUp, U16 wYDown, U16 wColor );
+extern  void  DisplayILI9314_BlitRect( U16 wXLeft, U16 wYUp, U16 wWidth, U16 wHeight, PU16 pwPixels );
+extern  void  DisplayILI9314_BlitGlyph1bpp( U16 wXLeft, U16 wYUp, const CODE U8* pnColumns, U8 nWidth, U8 nHeight, U8 nScale, U16 wFgColor, U16 wBgColor );
 extern  void  DisplayILI9314_ClearScreen( void );
 extern  void  DisplayILI9314_DrawString( PC8 pcString, U8 nCharSize, U16 wXPoint, U16 wYPoint, U16 wColor );
 extern  void  DisplayILI9314_DrawChar( C8 cChar, U8 nCharSize, U16 wXPoint, U16 wYPoint, U16 wColor );
@@ -42,7 +42,7 @@
 
 // constant parameter initializations -----------------------------------------
 /// instatiate the font file
-extern  const CODE U8  anFonts[ FONT_MAX_SIZE ][ FONT_X_SIZE ] =
+const CODE U8  anFonts[ FONT_MAX_SIZE ][ FONT_X_SIZE ] =
 { 
   { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 
   { 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, 0x00, 0x00 }, 
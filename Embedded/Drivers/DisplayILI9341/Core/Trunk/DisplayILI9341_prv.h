@@ -36,7 +36,7 @@
 /// define the number of characters
 #define FONT_MIN_VAL                ( 0x20 )
 #define FONT_MAX_VAL                ( 0x7F )
-#define FONT_MAX_SIZE               ( FONT_MAX_VAL - FONT_MIN_VAL )
+#define FONT_MAX_SIZE               ( FONT_MAX_VAL - FONT_MIN_VAL + 1 )
 
 /// define the X/y size
 #define FONT_X_SIZE                 ( 8 )
@@ -48,7 +48,7 @@
 // structures -----------------------------------------------------------------
 
 // global parameter declarations -----------------------------------------------
-extern  const CODE U8  anFonts[ ][ ];
+extern  const CODE U8  anFonts[ ][ FONT_X_SIZE ];
 
 // global function prototypes --------------------------------------------------
 
@@ -341,6 +341,61 @@ void DisplayST7565R_WriteBuffer( void )
 }
 
 
+/******************************************************************************
+ * @function DisplayST7565R_WriteBufferRegion
+ *
+ * @brief outputs a region of the buffer to the display
+ *
+ * This function will update the display with the columns of each page within
+ * the requested region, regardless of the modified extents
+ *
+ * @param[in]   nColStart   starting column
+ * @param[in]   nColEnd     ending column, inclusive
+ * @param[in]   nPageStart  starting page
+ * @param[in]   nPageEnd    ending page, inclusive
+ *
+ *****************************************************************************/
+void DisplayST7565R_WriteBufferRegion( U8 nColStart, U8 nColEnd, U8 nPageStart, U8 nPageEnd )
+{
+  U8  nIndex, nPage, nColumn;
+  
+  // constrain to the display
+  nColEnd = MIN( nColEnd, DISPLAY_MAX_X - 1 );
+  nPageEnd = MIN( nPageEnd, DISPLAY_NUM_PAGES - 1 );
+  
+  // check for a valid region
+  if (( nColStart <= nColEnd ) && ( nPageStart <= nPageEnd ))
+  {
+    // enable the chip
+    Gpio_Set( DISPLAYST7565R_CEN_GPIO_ENUM, ON );
+    
+    // compute the display column
+    nColumn = nColStart + DISPLAY_X_OFFSET;
+    
+    // for each page in the region
+    for ( nPage = nPageStart; nPage <= nPageEnd; nPage++ )
+    {
+      // set command mode/set the page address/beginning column address
+      Gpio_Set( DISPLAYST7565R_CDS_GPIO_ENUM, OFF );
+      Spi_Write( DISPLAYST7565R_SPI_ENUM, CMD_SET_PAGE | nPage );
+      Spi_Write( DISPLAYST7565R_SPI_ENUM, CMD_SET_COLUMN_UPPER | ( nColumn >> 4 ));
+      Spi_Write( DISPLAYST7565R_SPI_ENUM, CMD_SET_COLUMN_LOWER | ( nColumn & 0x0F ));
+      Gpio_Set( DISPLAYST7565R_CDS_GPIO_ENUM, ON );
+      
+      // now for each x
+      for ( nIndex = nColStart; nIndex <= nColEnd; nIndex++ )
+      {
+        // now write the data
+        Spi_Write( DISPLAYST7565R_SPI_ENUM, anDisplayBuffer[ nPage ][ nIndex ] );
+      }
+    }
+    
+    // disable the chip
+    Gpio_Set( DISPLAYST7565R_CEN_GPIO_ENUM, OFF );
+  }
+}
+
+
 /******************************************************************************
  * @function WriteCommand
  *
@@ -53,6 +53,7 @@ extern  void  DisplayST7565R_SetBrightness( U8 nBrightness );
 extern  void  DisplayST7565R_ClearScreen( void );
 extern  void  DisplayST7565R_SetPixel( U8 nX, U8 nY, DISPLAYPIXACT eAction );
 extern  void  DisplayST7565R_WriteBuffer( void );
+extern  void  DisplayST7565R_WriteBufferRegion( U8 nColStart, U8 nColEnd, U8 nPageStart, U8 nPageEnd );
 
 /**@} EOF DisplayST7565R.h */
 
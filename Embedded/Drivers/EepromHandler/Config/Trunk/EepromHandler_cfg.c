@@ -28,6 +28,9 @@
 
 // library includes -----------------------------------------------------------
 #include "SystemTick/SystemTick.h"
+#if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  #include <stdio.h>
+#endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_FREERTOS )
   // OS includes
   #include <FreeRtos.h>
@@ -60,6 +63,10 @@
     static k_tid_t tBkgrndWriteThreadId;
   #endif // SYSTEMDEFINE_OS_SELECTION
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
+#if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  static  FILE*   ptImage;
+  static  U32     uBusyTime;
+#endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
 
 // local function prototypes --------------------------------------------------
 #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
@@ -84,6 +91,31 @@
 *****************************************************************************/
 BOOL EepromHandler_LclInitialize( void )
 {
+  BOOL  bStatus = FALSE;
+  #if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  U16   wIndex;
+  #endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
+
+  #if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+    // open the image, create an erased one if not present
+    if (( ptImage = fopen( EEPROMHANDLER_FILE_IMAGE_NAME, "r+b" )) == NULL )
+    {
+      if (( ptImage = fopen( EEPROMHANDLER_FILE_IMAGE_NAME, "w+b" )) != NULL )
+      {
+        // fill it
+        for ( wIndex = 0; wIndex < EEPROMHANDLER_DEV_SIZE; wIndex++ )
+        {
+          fputc( 0xFF, ptImage );
+        }
+        fflush( ptImage );
+      }
+    }
+
+    // set the status/clear the busy time
+    bStatus = ( ptImage == NULL ) ? TRUE : FALSE;
+    uBusyTime = 0;
+  #endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
+
 #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
     #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_FREERTOS )
       // create the background write task
@@ -100,7 +132,7 @@ BOOL EepromHandler_LclInitialize( void )
     #endif // SYSTEMDEFINE_OS_SELECTION
   #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
   // return status
-  return( FALSE );
+  return( bStatus );
 }
 
 #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
@@ -191,6 +223,53 @@ BOOL EepromHandler_LclInitialize( void )
   }
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
 
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+    /******************************************************************************
+    * @function EepromHandler_ProcessWriteCacheTask
+    *
+    * @brief process the write cache task
+    *
+    * This function will call the write cache background flush
+    *
+    * @param[in]   xArg          task argument
+    *
+    * @return      TRUE to flush event
+    *
+    *****************************************************************************/
+    BOOL EepromHandler_ProcessWriteCacheTask( TASKARG xArg )
+    {
+      // call the function
+      EepromHandler_ProcessWriteCache( );
+
+      // return true
+      return( TRUE );
+    }
+  #endif // SYSTEMDEFINE_OS_SELECTION
+
+  /******************************************************************************
+  * @function EepromHandler_WriteCacheControl
+  *
+  * @brief control the write cache task
+  *
+  * This function will enable the task when there are dirty pages and
+  * disable it when the cache is clean
+  *
+  * @param[in]   bState     state of the task
+  *
+  *****************************************************************************/
+  void EepromHandler_WriteCacheControl( BOOL bState )
+  {
+    #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+      // enable/disable the task
+      TaskManager_EnableDisable( EEPROMHANDLER_WRITECACHE_TASK_ENUM, bState );
+    #else
+      // no operating system, the main loop calls EepromHandler_ProcessWriteCache
+      ( void )bState;
+    #endif // SYSTEMDEFINE_OS_SELECTION
+  }
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
 /******************************************************************************
  * @function EepromHandler_GetSystemTime
  *
@@ -228,6 +307,11 @@ U32 EepromHandler_GetSystemTime( void )
 BOOL EepromHandler_LclRdBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnData )
 {
   BOOL      bStatus;
+  #if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  // read from the image
+  ( void )nDevAddr;
+  bStatus = (( fseek( ptImage, wAddress, SEEK_SET ) == 0 ) && ( fread( pnData, 1, wLength, ptImage ) == wLength )) ? FALSE : TRUE;
+  #else
   I2CXFRCTL tXfrCtl;
 
   // set the address
@@ -246,22 +330,24 @@ BOOL EepromHandler_LclRdBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnDat
 
   // perform read/write
   bStatus = ( I2c_Read( EEPROMHANDLER_I2C_ENUM, &tXfrCtl ) == I2C_ERROR_NONE ) ? FALSE : TRUE;
+  #endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
 
   // return the status
   return( bStatus );
 }
 
 /******************************************************************************
- * @function EepromHandler_LclRdBlock
+ * @function EepromHandler_LclWrBlock
  *
- * @brief read a block of data from the eeprom
+ * @brief write a block of data to the eeprom
  *
- * This function will read a block of data from the eeprom
+ * This function will write a block of data to the eeprom, the file
+ * emulation wraps within the page and goes busy like the device
  *
  * @param[in]   nDevAddr    device address
- * @param[in]   wAddress    address to read from
- * @param[in]   wLength     length to read
- * @param[i0]   pnData      pointer to the data storage
+ * @param[in]   wAddress    address to write to
+ * @param[in]   wLength     length to write
+ * @param[in]   pnData      pointer to the data
  *
  * @return      TRUE if errors, FALSE if OK
  *
@@ -269,6 +355,26 @@ BOOL EepromHandler_LclRdBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnDat
 BOOL EepromHandler_LclWrBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnData )
 {
   BOOL      bStatus;
+  #if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  U16       wFirst, wRemain;
+
+  // compute the length up to the end of the page/the remainder that wraps
+  ( void )nDevAddr;
+  wFirst = MIN( wLength, EEPROMHANDLER_BLK_SIZE - ( wAddress & ( EEPROMHANDLER_BLK_SIZE - 1 )));
+  wRemain = wLength - wFirst;
+
+  // write up to the end of the page, the remainder wraps to the start of the page
+  bStatus = (( fseek( ptImage, wAddress, SEEK_SET ) == 0 ) && ( fwrite( pnData, 1, wFirst, ptImage ) == wFirst )) ? FALSE : TRUE;
+  if (( bStatus == FALSE ) && ( wRemain != 0 ))
+  {
+    wAddress &= ~( EEPROMHANDLER_BLK_SIZE - 1 );
+    bStatus = (( fseek( ptImage, wAddress, SEEK_SET ) == 0 ) && ( fwrite( pnData + wFirst, 1, wRemain, ptImage ) == wRemain )) ? FALSE : TRUE;
+  }
+  fflush( ptImage );
+
+  // set the busy time
+  uBusyTime = EepromHandler_GetSystemTime( ) + EEPROMHANDLER_PAGE_WRITE_MSECS;
+  #else
   I2CXFRCTL tXfrCtl;
 
   // set the address
@@ -287,6 +393,7 @@ BOOL EepromHandler_LclWrBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnDat
 
   // perform write
   bStatus = ( I2c_Write( EEPROMHANDLER_I2C_ENUM, &tXfrCtl ) == I2C_ERROR_NONE ) ? FALSE : TRUE;
+  #endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
 
   // return the status
   return( bStatus );
@@ -305,6 +412,10 @@ BOOL EepromHandler_LclWrBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnDat
 BOOL EepromHandler_LclCheckBusy( void )
 {
   BOOL bBusy;
+  #if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  // busy until the page write time has elapsed, signed so the tick can wrap
+  bBusy = (( S32 )( EepromHandler_GetSystemTime( ) - uBusyTime ) < 0 ) ? TRUE : FALSE;
+  #else
   I2CCHKBSY tChkBusy;
 
   // check for device presence
@@ -320,6 +431,7 @@ BOOL EepromHandler_LclCheckBusy( void )
     // set busy
     bBusy = TRUE;
   }
+  #endif // EEPROMHANDLER_ENABLE_FILE_EMULATION
 
   // return the busy status
   return( bBusy );
@@ -31,7 +31,7 @@
 #include "EepromHandler/EepromHandler_prm.h"
 
 // library includes -----------------------------------------------------------
-#if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
+#if (( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON ) || ( EEPROMHANDLER_ENABLE_WRITECACHE == ON ))
   #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
     #include "TaskManager/TaskManager.h"
   #endif // ( SYSTEMDEFINE_OS_SELECTION
@@ -68,6 +68,12 @@ extern  BOOL  EepromHandler_LclInitialize( void );
 #if (( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 1 ))
   extern  BOOL  EepromHandler_ProcessBackgroundWrite( TASKARG xArg );
 #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+    extern  BOOL  EepromHandler_ProcessWriteCacheTask( TASKARG xArg );
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  extern  void  EepromHandler_WriteCacheControl( BOOL bState );
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
 extern  U32   EepromHandler_GetSystemTime( void );
 extern  BOOL  EepromHandler_LclRdBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnData );
 extern  BOOL  EepromHandler_LclWrBlock( U8 nDevAddr, U16 wAddress, U16 wLength, PU8 pnData );
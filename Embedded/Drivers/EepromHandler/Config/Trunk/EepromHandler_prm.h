@@ -94,6 +94,32 @@
 /// define the page write time
 #define EEPROMHANDLER_PAGE_WRITE_MSECS              ( 10 )
 
+/// define the macro to enable the page write-combining cache, the cache is not
+/// locked so it requires the task manager, which runs the flush task, or no
+/// operating system, where the main loop must call EepromHandler_ProcessWriteCache
+#define EEPROMHANDLER_ENABLE_WRITECACHE             ( OFF )
+
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  /// define the number of cached pages
+  #define EEPROMHANDLER_WRITECACHE_NUM_PAGES        ( 4 )
+
+  /// define the time a dirty page is held for further writes before a background flush
+  #define EEPROMHANDLER_WRITECACHE_HOLD_MSECS       ( 50 )
+
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+    /// define the write cache task enum
+    #define EEPROMHANDLER_WRITECACHE_TASK_ENUM      ( TASK_SCHD_ILLEGAL )
+  #endif
+#endif
+
+/// define the macro to enable the file backed emulation for host testing
+#define EEPROMHANDLER_ENABLE_FILE_EMULATION         ( OFF )
+
+#if ( EEPROMHANDLER_ENABLE_FILE_EMULATION == ON )
+  /// define the image file name
+  #define EEPROMHANDLER_FILE_IMAGE_NAME             ( "eeprom.img" )
+#endif
+
 
 
 #endif  // _EEPROMHANDLER_PRM_H
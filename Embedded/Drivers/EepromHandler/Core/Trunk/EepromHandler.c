@@ -25,7 +25,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
-#include "EepromHandler/Eepromhandler.h"
+#include "EepromHandler/EepromHandler.h"
 
 // library includes -----------------------------------------------------------
 
@@ -37,9 +37,38 @@
   #define BLOCK_WRITEMOD_BIT_MASK( addr )     ( addr % ( EEPROMHANDLER_BLK_SIZE * 8 ))
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
 
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  #if (( EEPROMHANDLER_ENABLE_EMULATION == ON ) || ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON ))
+    #error "EEPROM write cache requires emulation and background writes to be disabled"
+  #endif
+  #if (( SYSTEMDEFINE_OS_SELECTION != SYSTEMDEFINE_OS_TASKMANAGER ) && ( SYSTEMDEFINE_OS_SELECTION != SYSTEMDEFINE_OS_NONE ))
+    #error "EEPROM write cache is not locked, it requires the task manager or no operating system"
+  #endif
+
+  /// define the macro to get the page base address
+  #define PAGE_BASE_ADDR( addr )              (( addr ) & ~( EEPROMHANDLER_BLK_SIZE - 1 ))
+
+  /// define the no slot value
+  #define CACHE_SLOT_NONE                     ( 0xFF )
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  /// define the cached page structure
+  typedef struct _CACHEPAGE
+  {
+    U16   wBaseAddr;              ///< page base address
+    U16   wDirtyLo;               ///< offset of the first dirty byte
+    U16   wDirtyHi;               ///< offset past the last dirty byte
+    U32   uTime;                  ///< time of the last access
+    BOOL  bValid;                 ///< page holds valid data
+    BOOL  bDirty;                 ///< page must be written
+    U8    anData[ EEPROMHANDLER_BLK_SIZE ]; ///< page data
+  } CACHEPAGE, *PCACHEPAGE;
+  #define CACHEPAGE_SIZE                      sizeof( CACHEPAGE )
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
 
 // global parameter declarations ----------------------------------------------
 
@@ -51,6 +80,9 @@ static  BOOL      bCheckForBusyRequired;
 #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
   static  U8        anBlockModifiedStatus[ BLOCK_WRITEMOD_SIZE ];
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  static  CACHEPAGE atCachePages[ EEPROMHANDLER_WRITECACHE_NUM_PAGES ];
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
 
 // command handlers
 #if ( EEPROMHANDLER_ENABLE_DEBUGCOMMANDS == ON )
@@ -70,6 +102,14 @@ static  BOOL      bCheckForBusyRequired;
   static  BOOL       CheckForBusy( void );
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
 
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  static  U8         CacheFind( U16 wBaseAddr );
+  static  U8         CacheFindDirty( BOOL bHoldExpired );
+  static  EEPROMERR  CacheAcquire( U16 wBaseAddr, BOOL bLoad, PU8 pnSlot );
+  static  EEPROMERR  CacheWritePage( U8 nSlot );
+  static  void       CacheOverlay( U16 wAddress, U16 wLength, PU8 pnData );
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
 // constant parameter initializations -----------------------------------------
 /// define the command strings
 #if ( EEPROMHANDLER_ENABLE_DEBUGCOMMANDS == ON )
@@ -119,6 +159,11 @@ BOOL EepromHandler_Initialize( void )
   #if (( EEPROMHANDLER_ENABLE_EMULATION == ON ) || ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON ))
     memset( anEeprom, 0xFF, EEPROMHANDLER_DEV_SIZE );
   #endif // EEPROMHANDLER_ENABLE_EMULATION
+
+  #if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+    // clear the cache
+    memset( atCachePages, 0, sizeof( atCachePages ));
+  #endif // EEPROMHANDLER_ENABLE_WRITECACHE
   
   // call the local initialization
   bStatus = EepromHandler_LclInitialize( );
@@ -321,7 +366,7 @@ EEPROMERR EepromHandler_RdBlock( U16 wAddress, U16 wLength, PU8 pnData )
   #endif // EEPROMHANDLER_ENABLE_EMULATION
 
   // check to see if valid address
-  if(( wAddress + wLength ) < EEPROMHANDLER_DEV_SIZE )
+  if(( wAddress + wLength ) <= EEPROMHANDLER_DEV_SIZE )
   {
     #if (( EEPROMHANDLER_ENABLE_EMULATION == OFF ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == OFF ))
       // get the current time
@@ -331,7 +376,7 @@ EEPROMERR EepromHandler_RdBlock( U16 wAddress, U16 wLength, PU8 pnData )
       while(( bCheckForBusyRequired = CheckForBusy( )) == TRUE )
       {
         // check for timeout
-        if ( EepromHandler_GetSystemTime( ) >= uTime )
+        if (( S32 )( EepromHandler_GetSystemTime( ) - uTime ) >= 0 )
         {
           // timeout occured - flag error
           eError = EEPROM_ERR_DEVBUSY;
@@ -345,6 +390,14 @@ EEPROMERR EepromHandler_RdBlock( U16 wAddress, U16 wLength, PU8 pnData )
     {
       #if (( EEPROMHANDLER_ENABLE_EMULATION == OFF ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == OFF ))
         eError = ( EepromHandler_LclRdBlock( EEPROMHANDLER_DEV_ADDR, wAddress, wLength, pnData )) ? EEPROM_ERR_I2CERR : EEPROM_ERR_NONE;
+
+        #if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+          // apply any cached pages that have not been written
+          if ( eError == EEPROM_ERR_NONE )
+          {
+            CacheOverlay( wAddress, wLength, pnData );
+          }
+        #endif // EEPROMHANDLER_ENABLE_WRITECACHE
       #else
         // copy from the local area
         memcpy( pnData, &anEeprom[ wAddress ], wLength ); 
@@ -453,9 +506,14 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   #if (( EEPROMHANDLER_ENABLE_EMULATION == OFF ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == OFF ))
     U8        nBlkLength;
   #endif // EEPROMHANDLER_ENABLE_EMULATION
+  #if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+    U8          nSlot;
+    U8          nOffset;
+    PCACHEPAGE  ptPage;
+  #endif // EEPROMHANDLER_ENABLE_WRITECACHE
   
   // check to see if valid address
-  if(( wAddress + wLength ) < EEPROMHANDLER_DEV_SIZE )
+  if(( wAddress + wLength ) <= EEPROMHANDLER_DEV_SIZE )
   {
     #if (( EEPROMHANDLER_ENABLE_EMULATION == OFF ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == OFF ))
       // while we still have bytes to write
@@ -467,8 +525,26 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
         // set the block length
         nBlkLength = MIN( nBlkLength, wLength );
 
-        // write this block
-        if (( eError = WriteBlock( EEPROMHANDLER_DEV_ADDR, wAddress, nBlkLength, pnData )) == EEPROM_ERR_NONE )
+        #if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+          // get the page, loading it unless it is completely overwritten
+          if (( eError = CacheAcquire( PAGE_BASE_ADDR( wAddress ), ( nBlkLength != EEPROMHANDLER_BLK_SIZE ), &nSlot )) == EEPROM_ERR_NONE )
+          {
+            // merge the data/extend the dirty span
+            ptPage = &atCachePages[ nSlot ];
+            nOffset = wAddress - ptPage->wBaseAddr;
+            memcpy( &ptPage->anData[ nOffset ], pnData, nBlkLength );
+            ptPage->wDirtyLo = ( ptPage->bDirty ) ? MIN( ptPage->wDirtyLo, nOffset ) : nOffset;
+            ptPage->wDirtyHi = ( ptPage->bDirty ) ? MAX( ptPage->wDirtyHi, nOffset + nBlkLength ) : nOffset + nBlkLength;
+            ptPage->bDirty = TRUE;
+            ptPage->uTime = EepromHandler_GetSystemTime( );
+          }
+        #else
+          // write this block
+          eError = WriteBlock( wAddress, nBlkLength, pnData );
+        #endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
+        // check for error
+        if ( eError == EEPROM_ERR_NONE )
         {
           // adjust the address/adjust the length
           wLength -= nBlkLength;
@@ -487,6 +563,11 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
       // copy to local
       memcpy( &anEeprom[ wAddress ], pnData, wLength );
     #endif // EEPROMHANDLER_ENABLE_EMULATION
+
+    #if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+      // enable the background flush
+      EepromHandler_WriteCacheControl( ON );
+    #endif // EEPROMHANDLER_ENABLE_WRITECACHE
     
     #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == ON )
       // mark block as modified
@@ -506,6 +587,90 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   return( eError );
 }
 
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  /******************************************************************************
+   * @function EepromHandler_Flush
+   *
+   * @brief flush the write cache
+   *
+   * This function will write all dirty pages in address order and wait for
+   * the last page write to complete, use it as a barrier before any data
+   * that must survive a reset
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  EEPROMERR EepromHandler_Flush( void )
+  {
+    EEPROMERR eError = EEPROM_ERR_NONE;
+    U8        nSlot;
+    U32       uTime;
+
+    // write each dirty page
+    while (( eError == EEPROM_ERR_NONE ) && (( nSlot = CacheFindDirty( FALSE )) != CACHE_SLOT_NONE ))
+    {
+      eError = CacheWritePage( nSlot );
+    }
+
+    // if no error, wait for the last write to complete
+    if ( eError == EEPROM_ERR_NONE )
+    {
+      // get the current time
+      uTime = EepromHandler_GetSystemTime( ) + WAIT_FOR_BUSY_DONE_TIME;
+
+      // wait till done
+      while(( bCheckForBusyRequired = CheckForBusy( )) == TRUE )
+      {
+        // check for timeout
+        if (( S32 )( EepromHandler_GetSystemTime( ) - uTime ) >= 0 )
+        {
+          // timeout occured - flag error
+          eError = EEPROM_ERR_DEVBUSY;
+          break;
+        }
+      }
+
+      // disable the background flush
+      EepromHandler_WriteCacheControl( OFF );
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function EepromHandler_ProcessWriteCache
+   *
+   * @brief background write cache flush
+   *
+   * This function will write the lowest addressed dirty page that has not
+   * been written for the hold time, if the device is not busy.  It must be
+   * called at the page write rate, the task manager task does this and with
+   * no operating system the application calls it from its main loop
+   *
+   *****************************************************************************/
+  void EepromHandler_ProcessWriteCache( void )
+  {
+    U8  nSlot;
+
+    // only when the last write has completed
+    if (( bCheckForBusyRequired = CheckForBusy( )) == FALSE )
+    {
+      // find a page to write
+      if (( nSlot = CacheFindDirty( TRUE )) != CACHE_SLOT_NONE )
+      {
+        // write it
+        CacheWritePage( nSlot );
+      }
+      else if ( CacheFindDirty( FALSE ) == CACHE_SLOT_NONE )
+      {
+        // cache is clean, disable the background flush
+        EepromHandler_WriteCacheControl( OFF );
+      }
+    }
+  }
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
 #if ( EEPROMHANDLER_ENABLE_EUICAP == ON )
   /******************************************************************************
    * @function EepromHandler_ReadEUI
@@ -559,7 +724,7 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
     while(( bCheckForBusyRequired = CheckForBusy( )) == TRUE )
     {
       // check for timeout
-      if ( EepromHandler_GetSystemTime( ) >= uTime )
+      if (( S32 )( EepromHandler_GetSystemTime( ) - uTime ) >= 0 )
       {
         // timeout occured - flag error
         eError = EEPROM_ERR_DEVBUSY;
@@ -614,6 +779,224 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   }
 #endif // EEPROMHANDLER_ENABLE_EMULATION
 
+#if ( EEPROMHANDLER_ENABLE_WRITECACHE == ON )
+  /******************************************************************************
+   * @function CacheFind
+   *
+   * @brief find a page in the cache
+   *
+   * This function will return the slot holding a page
+   *
+   * @param[in]   wBaseAddr   page base address
+   *
+   * @return      slot or CACHE_SLOT_NONE
+   *
+   *****************************************************************************/
+  static U8 CacheFind( U16 wBaseAddr )
+  {
+    U8  nSlot;
+
+    // for each slot
+    for ( nSlot = 0; nSlot < EEPROMHANDLER_WRITECACHE_NUM_PAGES; nSlot++ )
+    {
+      // check for a match
+      if (( atCachePages[ nSlot ].bValid ) && ( atCachePages[ nSlot ].wBaseAddr == wBaseAddr ))
+      {
+        // return the slot
+        return( nSlot );
+      }
+    }
+
+    // return not found
+    return( CACHE_SLOT_NONE );
+  }
+
+  /******************************************************************************
+   * @function CacheFindDirty
+   *
+   * @brief find the next page to write
+   *
+   * This function will return the dirty page with the lowest address
+   *
+   * @param[in]   bHoldExpired  TRUE to only consider pages past the hold time
+   *
+   * @return      slot or CACHE_SLOT_NONE
+   *
+   *****************************************************************************/
+  static U8 CacheFindDirty( BOOL bHoldExpired )
+  {
+    U8          nSlot, nBest = CACHE_SLOT_NONE;
+    U32         uTime;
+    PCACHEPAGE  ptPage;
+
+    // get the time
+    uTime = EepromHandler_GetSystemTime( );
+
+    // for each slot
+    for ( nSlot = 0; nSlot < EEPROMHANDLER_WRITECACHE_NUM_PAGES; nSlot++ )
+    {
+      // check for a dirty page that is eligible
+      ptPage = &atCachePages[ nSlot ];
+      if (( ptPage->bValid ) && ( ptPage->bDirty ) && 
+          (( !bHoldExpired ) || (( uTime - ptPage->uTime ) >= EEPROMHANDLER_WRITECACHE_HOLD_MSECS )))
+      {
+        // check for lower address
+        if (( nBest == CACHE_SLOT_NONE ) || ( ptPage->wBaseAddr < atCachePages[ nBest ].wBaseAddr ))
+        {
+          nBest = nSlot;
+        }
+      }
+    }
+
+    // return the slot
+    return( nBest );
+  }
+
+  /******************************************************************************
+   * @function CacheAcquire
+   *
+   * @brief get a page into the cache
+   *
+   * This function will return the slot for a page, replacing a free, then
+   * the oldest clean, then the oldest dirty page if it is not cached
+   *
+   * @param[in]   wBaseAddr   page base address
+   * @param[in]   bLoad       TRUE to read the page from the device
+   * @param[io]   pnSlot      pointer to store the slot
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR CacheAcquire( U16 wBaseAddr, BOOL bLoad, PU8 pnSlot )
+  {
+    EEPROMERR   eError = EEPROM_ERR_NONE;
+    U8          nSlot, nBest;
+    U32         uTime;
+    PCACHEPAGE  ptPage, ptBest;
+
+    // check for a hit
+    if (( nBest = CacheFind( wBaseAddr )) == CACHE_SLOT_NONE )
+    {
+      // get the time
+      uTime = EepromHandler_GetSystemTime( );
+
+      // select the replacement
+      nBest = 0;
+      for ( nSlot = 1; nSlot < EEPROMHANDLER_WRITECACHE_NUM_PAGES; nSlot++ )
+      {
+        ptPage = &atCachePages[ nSlot ];
+        ptBest = &atCachePages[ nBest ];
+        if (( ptBest->bValid ) &&
+            (( !ptPage->bValid ) ||
+             (( ptBest->bDirty ) && ( !ptPage->bDirty )) ||
+             (( ptBest->bDirty == ptPage->bDirty ) && (( uTime - ptPage->uTime ) > ( uTime - ptBest->uTime )))))
+        {
+          nBest = nSlot;
+        }
+      }
+
+      // write it if dirty
+      ptPage = &atCachePages[ nBest ];
+      if (( ptPage->bValid ) && ( ptPage->bDirty ))
+      {
+        eError = CacheWritePage( nBest );
+      }
+
+      // now load it
+      if ( eError == EEPROM_ERR_NONE )
+      {
+        // invalidate it/read it if required
+        ptPage->bValid = FALSE;
+        if ( bLoad )
+        {
+          eError = EepromHandler_RdBlock( wBaseAddr, EEPROMHANDLER_BLK_SIZE, ptPage->anData );
+        }
+
+        // if good, set it up
+        if ( eError == EEPROM_ERR_NONE )
+        {
+          ptPage->wBaseAddr = wBaseAddr;
+          ptPage->bValid = TRUE;
+          ptPage->bDirty = FALSE;
+          ptPage->uTime = uTime;
+        }
+      }
+    }
+
+    // return the slot
+    *( pnSlot ) = nBest;
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function CacheWritePage
+   *
+   * @brief write a cached page
+   *
+   * This function will write the dirty span of a page in a single page write
+   *
+   * @param[in]   nSlot       slot
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR CacheWritePage( U8 nSlot )
+  {
+    EEPROMERR   eError;
+    PCACHEPAGE  ptPage;
+
+    // write the dirty span
+    ptPage = &atCachePages[ nSlot ];
+    if (( eError = WriteBlock( ptPage->wBaseAddr + ptPage->wDirtyLo, ptPage->wDirtyHi - ptPage->wDirtyLo, &ptPage->anData[ ptPage->wDirtyLo ] )) == EEPROM_ERR_NONE )
+    {
+      // page is now clean
+      ptPage->bDirty = FALSE;
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function CacheOverlay
+   *
+   * @brief apply the cached data to a read
+   *
+   * This function will copy the dirty spans of the cached pages over the
+   * data read from the device
+   *
+   * @param[in]   wAddress    address read from
+   * @param[in]   wLength     length read
+   * @param[io]   pnData      pointer to the data read
+   *
+   *****************************************************************************/
+  static void CacheOverlay( U16 wAddress, U16 wLength, PU8 pnData )
+  {
+    U8          nSlot;
+    U16         wStart, wEnd;
+    PCACHEPAGE  ptPage;
+
+    // for each slot
+    for ( nSlot = 0; nSlot < EEPROMHANDLER_WRITECACHE_NUM_PAGES; nSlot++ )
+    {
+      ptPage = &atCachePages[ nSlot ];
+      if (( ptPage->bValid ) && ( ptPage->bDirty ))
+      {
+        // compute the overlap
+        wStart = MAX( wAddress, ptPage->wBaseAddr + ptPage->wDirtyLo );
+        wEnd = MIN( wAddress + wLength, ptPage->wBaseAddr + ptPage->wDirtyHi );
+        if ( wStart < wEnd )
+        {
+          // copy it
+          memcpy( pnData + ( wStart - wAddress ), &ptPage->anData[ wStart - ptPage->wBaseAddr ], wEnd - wStart );
+        }
+      }
+    }
+  }
+#endif // EEPROMHANDLER_ENABLE_WRITECACHE
+
 #if ( EEPROMHANDLER_ENABLE_DEBUGCOMMANDS == ON )
   /******************************************************************************
    * @function CmdWrtEep
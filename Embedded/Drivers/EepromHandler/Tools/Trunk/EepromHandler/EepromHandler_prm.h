@@ -0,0 +1,91 @@
+/******************************************************************************
+ * @file EepromHandler_prm.h
+ *
+ * @brief EEPROM handler test parameter declarations
+ *
+ * This file configures the handler for the host write cache test, the write
+ * cache runs over the file backed emulation of a 512 byte, 16 byte page part
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup EepromHandler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _EEPROMHANDLER_PRM_H
+#define _EEPROMHANDLER_PRM_H
+
+// local includes -------------------------------------------------------------
+
+// libary includes -------------------------------------------------------------
+#include "I2C/I2c.h"
+#include "SystemTick/SystemTick.h"
+
+// define ---------------------------------------------------------------------
+/// define the macro to enable EUI capability
+#define EEPROMHANDLER_ENABLE_EUICAP                 ( OFF )
+
+/// define the slave address
+#define	EEPROMHANDLER_DEV_ADDR                      ( 0x50 )
+
+/// define the size of the device
+#define	EEPROMHANDLER_DEV_SIZE                      ( 512 )
+
+/// define the size of the block in page write
+#define EEPROMHANDLER_BLK_SIZE                      ( 16 )
+
+/// define the size of the address
+#define EEPROMHANDLER_ADR_SIZE                      ( 2 )
+
+/// define the device enum
+#define EEPROMHANDLER_DEVICE                        ( 0 )
+
+/// define the enumeration for the I2C, not used by the file emulation
+#define EEPROMHANDLER_I2C_ENUM                      ( I2C_DEV_ENUM_ILLEGAL )
+
+/// define the operation for busy polling( 0 - write, 1 - read )
+#define EEPROMHANDLER_I2C_POLL_MODE                 ( 0 )
+
+/// define the macro to enable debug commands
+#define EEPROMHANDLER_ENABLE_DEBUGCOMMANDS          ( OFF )
+
+/// define the macro to enable EEPROM emulation
+#define EEPROMHANDLER_ENABLE_EMULATION              ( OFF )
+
+/// define the macro to enable background writes
+#define EEPROMHANDLER_ENABLE_BACKGROUND_WRITES      ( OFF )
+
+/// define the page write time
+#define EEPROMHANDLER_PAGE_WRITE_MSECS              ( 10 )
+
+/// define the macro to enable the page write-combining cache
+#define EEPROMHANDLER_ENABLE_WRITECACHE             ( ON )
+
+/// define the number of cached pages
+#define EEPROMHANDLER_WRITECACHE_NUM_PAGES          ( 4 )
+
+/// define the time a dirty page is held for further writes before a background flush
+#define EEPROMHANDLER_WRITECACHE_HOLD_MSECS         ( 50 )
+
+/// define the macro to enable the file backed emulation for host testing
+#define EEPROMHANDLER_ENABLE_FILE_EMULATION         ( ON )
+
+/// define the image file name
+#define EEPROMHANDLER_FILE_IMAGE_NAME               ( "EepromHandlerCacheTest.img" )
+
+#endif  // _EEPROMHANDLER_PRM_H
+
+/**@} EOF EepromHandler_prm.h */
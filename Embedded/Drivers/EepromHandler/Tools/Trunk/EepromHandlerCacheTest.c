@@ -0,0 +1,318 @@
+/******************************************************************************
+ * @file EepromHandlerCacheTest.c
+ *
+ * @brief EEPROM handler write cache test
+ *
+ * This file provides a host tool that runs the page write-combining cache
+ * over the file backed emulation.  The system tick is simulated, it starts
+ * just short of the 32 bit wrap and advances a millisecond on every read so
+ * the busy polls make progress.  It checks that the emulation holds the
+ * device busy for the page write time across the wrap, that a dirty page is
+ * held in the cache for the hold time and then flushed by the background
+ * process, and then runs a random mix of writes, reads and background
+ * flushes against a reference image, checking every read and, after the
+ * final flush, the image file byte for byte.  It exits non zero on any
+ * failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o EepromHandlerCacheTest
+ *             EepromHandlerCacheTest.c ../../Core/Trunk/EepromHandler.c
+ *             ../../Config/Trunk/EepromHandler_cfg.c
+ * usage:      EepromHandlerCacheTest [operations] [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup EepromHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "EepromHandler/EepromHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of operations/seed
+#define DEFAULT_OPERATIONS                          ( 50000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the starting tick, just short of the wrap
+#define START_TIME                                  ( 0xFFFFFF00ul )
+
+/// define the longest random write
+#define MAX_WRITE_LEN                               ( 40 )
+
+/// define the longest random time step
+#define MAX_TIME_STEP                               ( 20 )
+
+// local parameter declarations -----------------------------------------------
+static  U32   uSimTime;
+static  U32   uRandom;
+static  U8    anReference[ EEPROMHANDLER_DEV_SIZE ];
+static  U32   uErrors;
+
+// local function prototypes --------------------------------------------------
+static  U32   Random( U32 uRange );
+static  void  Check( BOOL bCondition, PC8 pszWhat );
+static  BOOL  ReadImage( U16 wAddress, U16 wLength, PU8 pnData );
+static  void  CheckBusyWrap( void );
+static  void  CheckHold( void );
+static  void  RunRandom( U32 uOperations );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  U32 uOperations = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : DEFAULT_OPERATIONS;
+
+  // start erased, just short of the wrap
+  uRandom = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+  uSimTime = START_TIME;
+  remove( EEPROMHANDLER_FILE_IMAGE_NAME );
+  memset( anReference, 0xFF, sizeof( anReference ));
+  if ( EepromHandler_Initialize( ))
+  {
+    fprintf( stderr, "unable to create %s\n", EEPROMHANDLER_FILE_IMAGE_NAME );
+    return( 1 );
+  }
+
+  // run the checks
+  CheckBusyWrap( );
+  CheckHold( );
+  RunRandom( uOperations );
+
+  // report
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", ( unsigned )uErrors );
+  remove( EEPROMHANDLER_FILE_IMAGE_NAME );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function SystemTick_GetTimeMsec
+ *
+ * @brief simulated system tick
+ *
+ * This function returns the simulated time, advancing it a millisecond
+ *
+ * @return      time in milliseconds
+ *
+ *****************************************************************************/
+U32 SystemTick_GetTimeMsec( void )
+{
+  // return it, then advance
+  return( uSimTime++ );
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief random number
+ *
+ * @param[in]   uRange    range
+ *
+ * @return      random number below the range
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // xorshift
+  uRandom ^= uRandom << 13;
+  uRandom ^= uRandom >> 17;
+  uRandom ^= uRandom << 5;
+  return( uRandom % uRange );
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * @param[in]   bCondition  condition that must be true
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, PC8 pszWhat )
+{
+  // report the first few failures
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      fprintf( stderr, "fail at %08X: %s\n", ( unsigned )uSimTime, pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function ReadImage
+ *
+ * @brief read the image file directly
+ *
+ * @param[in]   wAddress    address
+ * @param[in]   wLength     length
+ * @param[io]   pnData      pointer to store the data
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL ReadImage( U16 wAddress, U16 wLength, PU8 pnData )
+{
+  FILE* pfImage;
+  BOOL  bStatus = TRUE;
+
+  // open it/read it
+  if (( pfImage = fopen( EEPROMHANDLER_FILE_IMAGE_NAME, "rb" )) != NULL )
+  {
+    bStatus = (( fseek( pfImage, wAddress, SEEK_SET ) == 0 ) && ( fread( pnData, 1, wLength, pfImage ) == wLength )) ? FALSE : TRUE;
+    fclose( pfImage );
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CheckBusyWrap
+ *
+ * @brief check the emulated busy time across the tick wrap
+ *
+ * This function writes the last page directly so the busy time ends after
+ * the wrap and checks the device is busy until then
+ *
+ *****************************************************************************/
+static void CheckBusyWrap( void )
+{
+  U8  anPage[ EEPROMHANDLER_BLK_SIZE ];
+
+  // write the last page of erased data, ending past the wrap
+  memset( anPage, 0xFF, sizeof( anPage ));
+  uSimTime = 0xFFFFFFFF - ( EEPROMHANDLER_PAGE_WRITE_MSECS / 2 );
+  Check( EepromHandler_LclWrBlock( EEPROMHANDLER_DEV_ADDR, EEPROMHANDLER_DEV_SIZE - EEPROMHANDLER_BLK_SIZE, EEPROMHANDLER_BLK_SIZE, anPage ) == FALSE, "direct page write" );
+
+  // busy now, across the wrap
+  Check( EepromHandler_LclCheckBusy( ) == TRUE, "busy before the wrap" );
+  uSimTime = 0;
+  Check( EepromHandler_LclCheckBusy( ) == TRUE, "busy after the wrap" );
+
+  // done after the page write time
+  uSimTime = EEPROMHANDLER_PAGE_WRITE_MSECS;
+  Check( EepromHandler_LclCheckBusy( ) == FALSE, "not busy after the page write" );
+
+  // restart short of the wrap for the rest
+  uSimTime = START_TIME;
+}
+
+/******************************************************************************
+ * @function CheckHold
+ *
+ * @brief check the hold time
+ *
+ * This function writes a few bytes and checks they stay in the cache, visible
+ * to reads, until the hold time has passed and the background flush runs
+ *
+ *****************************************************************************/
+static void CheckHold( void )
+{
+  static  U8  anData[ ] = { 0x12, 0x34, 0x56, 0x78 };
+  U8          anRead[ sizeof( anData ) ];
+  U16         wAddress = 0x23;
+
+  // write it
+  Check( EepromHandler_WrBlock( wAddress, sizeof( anData ), anData ) == EEPROM_ERR_NONE, "hold write" );
+  memcpy( &anReference[ wAddress ], anData, sizeof( anData ));
+
+  // read back through the handler, from the cache
+  Check(( EepromHandler_RdBlock( wAddress, sizeof( anRead ), anRead ) == EEPROM_ERR_NONE ) && ( memcmp( anRead, anData, sizeof( anData )) == 0 ), "hold read back" );
+
+  // not written before the hold time
+  EepromHandler_ProcessWriteCache( );
+  Check(( ReadImage( wAddress, sizeof( anRead ), anRead ) == FALSE ) && ( anRead[ 0 ] == 0xFF ), "held in the cache" );
+
+  // written after the hold time
+  uSimTime += EEPROMHANDLER_WRITECACHE_HOLD_MSECS;
+  EepromHandler_ProcessWriteCache( );
+  Check(( ReadImage( wAddress, sizeof( anRead ), anRead ) == FALSE ) && ( memcmp( anRead, anData, sizeof( anData )) == 0 ), "flushed after the hold" );
+}
+
+/******************************************************************************
+ * @function RunRandom
+ *
+ * @brief random operations
+ *
+ * This function runs random writes, reads and background flushes, checking
+ * every read against the reference, then flushes and checks the image
+ *
+ * @param[in]   uOperations number of operations
+ *
+ *****************************************************************************/
+static void RunRandom( U32 uOperations )
+{
+  static  U8  anImage[ EEPROMHANDLER_DEV_SIZE ];
+  U8          anData[ MAX_WRITE_LEN ];
+  U32         uOp, uWrites = 0, uReads = 0, uFlushes = 0, uStart = uSimTime;
+  U16         wAddress, wLength, wIdx;
+
+  // for each operation
+  for ( uOp = 0; uOp < uOperations; uOp++ )
+  {
+    // pick an address/length
+    wLength = 1 + Random( MAX_WRITE_LEN );
+    wAddress = Random( EEPROMHANDLER_DEV_SIZE - wLength + 1 );
+    switch( Random( 3 ))
+    {
+      case 0 :
+        // write
+        for ( wIdx = 0; wIdx < wLength; wIdx++ )
+        {
+          anData[ wIdx ] = Random( 256 );
+        }
+        Check( EepromHandler_WrBlock( wAddress, wLength, anData ) == EEPROM_ERR_NONE, "write" );
+        memcpy( &anReference[ wAddress ], anData, wLength );
+        uWrites++;
+        break;
+
+      case 1 :
+        // read
+        Check(( EepromHandler_RdBlock( wAddress, wLength, anData ) == EEPROM_ERR_NONE ) && ( memcmp( anData, &anReference[ wAddress ], wLength ) == 0 ), "read" );
+        uReads++;
+        break;
+
+      default :
+        // let time pass/run the background flush
+        uSimTime += Random( MAX_TIME_STEP );
+        EepromHandler_ProcessWriteCache( );
+        uFlushes++;
+        break;
+    }
+  }
+
+  // flush it/check the image
+  Check( EepromHandler_Flush( ) == EEPROM_ERR_NONE, "flush" );
+  Check(( ReadImage( 0, EEPROMHANDLER_DEV_SIZE, anImage ) == FALSE ) && ( memcmp( anImage, anReference, EEPROMHANDLER_DEV_SIZE ) == 0 ), "image after flush" );
+  printf( "random: %u writes, %u reads, %u background flushes over %u ms\n", ( unsigned )uWrites, ( unsigned )uReads, ( unsigned )uFlushes, ( unsigned )( uSimTime - uStart ));
+}
+
+/**@} EOF EepromHandlerCacheTest.c */
@@ -82,6 +82,9 @@ BOOL ImuICM20948_PollEvent( TASKARG xArg )
       // set data ready
       bDataReady = TRUE;
     }
+  #elif ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+    // the driver checks the FIFO count against the watermark
+    bDataReady = TRUE;
   #else
     // read the int status1 register
     U8 nData;
@@ -103,6 +103,30 @@
 /// define the IRQ operational mode enable
 #define IMUICM20948_IRQ_OPMODE_ENABLE                   ( 0 )
 
+/// define the FIFO burst mode enable
+#define IMUICM20948_FIFO_MODE_ENABLE                    ( 0 )
+
+/// define the FIFO watermark in frames, the FIFO is drained when it holds this many
+#define IMUICM20948_FIFO_WATERMARK_FRAMES               ( 8 )
+
+/// define the number of frames read in one bus transaction
+#define IMUICM20948_FIFO_BURST_FRAMES                   ( 16 )
+
+/// define the number of samples in the sample ring, must be a power of 2
+#define IMUICM20948_FIFO_RING_SIZE                      ( 64 )
+
+/// define the temperature in FIFO frames enable
+#define IMUICM20948_FIFO_TEMP_ENABLE                    ( 1 )
+
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+  #if ( IMUICM20948_ACCEL_SAMPLE_RATE_HZ != IMUICM20948_GYRO_SAMPLE_RATE_HZ )
+    #error "FIFO mode requires equal accel and gyro sample rates!"
+  #endif
+  #if (( IMUICM20948_FIFO_RING_SIZE & ( IMUICM20948_FIFO_RING_SIZE - 1 )) != 0 )
+    #error "FIFO ring size must be a power of 2!"
+  #endif
+#endif
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
@@ -30,6 +30,31 @@
 #include "SystemTick/SystemTick.h"
 
 // Macros and Defines ---------------------------------------------------------
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+/// define the FIFO frame size, acceleration and gyro with optional temperature
+#if ( IMUICM20948_FIFO_TEMP_ENABLE == 1 )
+  #define FIFO_FRAME_SIZE                           ( 14 )
+#else
+  #define FIFO_FRAME_SIZE                           ( 12 )
+#endif
+
+/// define the offsets in the frame
+#define FIFO_FRAME_ACCEL_OFS                        ( 0 )
+#define FIFO_FRAME_GYRO_OFS                         ( 6 )
+#define FIFO_FRAME_TEMP_OFS                         ( 12 )
+
+/// define the burst size in bytes
+#define FIFO_BURST_SIZE                             ( IMUICM20948_FIFO_BURST_FRAMES * FIFO_FRAME_SIZE )
+#if ( FIFO_BURST_SIZE > 255 )
+  #error "FIFO burst exceeds a single transfer!"
+#endif
+#if (( IMUICM20948_FIFO_WATERMARK_FRAMES * FIFO_FRAME_SIZE ) >= FIFO_SIZE_BYTES )
+  #error "FIFO watermark exceeds the FIFO!"
+#endif
+
+/// define the sample ring mask
+#define FIFO_RING_MASK                              ( IMUICM20948_FIFO_RING_SIZE - 1 )
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
 
 // enumerations ---------------------------------------------------------------
 
@@ -41,10 +66,29 @@
 static  IMUICM20948DATA     tRawData;
 static  IMUICM20948ALL      tCurData;
 static  BOOL                bValidData;
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+static  IMUICM20948SAMPLE     atSampleRing[ IMUICM20948_FIFO_RING_SIZE ];
+static  U16                   wRingWrIdx;
+static  U16                   wRingRdIdx;
+static  U16                   wRingCount;
+static  IMUICM20948FIFOSTATS  tFifoStats;
+static  U64                   hAnchorUsec;
+static  U32                   uAnchorIndex;
+static  BOOL                  bAnchored;
+static  U16                   wSampleDivider;
+static  U8                    anBurst[ FIFO_BURST_SIZE ];
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
 
 // local function prototypes --------------------------------------------------
 static  BOOL  WriteMagRegisters( MAGNREGS eMagReg, U8 nData );
 static  BOOL  ReadMagRegisters( MAGNREGS eMagReg, PU8 pnData, U8 nLength );
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+static  void  ConfigureFifo( U16 wDivider );
+static  void  ResetFifo( void );
+static  void  DrainFifo( void );
+static  void  ParseFrames( PU8 pnData, U16 wNumFrames );
+static  U64   SampleOffsetUsec( U32 uIndex );
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
 
 // constant parameter initializations -----------------------------------------
 
@@ -111,7 +155,7 @@ void ImuICM20948_Initialize( void )
       ImuICM20948_WriteRegisters( BANK2_REGS_ACCELCONFIG2, &tRegs.nByte, 1 );
 
       // set up the sample rate
-      wSampleRate = 1125 / IMUICM20948_ACCEL_SAMPLE_RATE_HZ;
+      wSampleRate = SAMPLE_RATE_BASE_HZ / IMUICM20948_ACCEL_SAMPLE_RATE_HZ;
       tRegs.nByte = HI16 (wSampleRate );
       ImuICM20948_WriteRegisters( BANK2_REGS_ACCELSMPLRTDIV1, &tRegs.nByte, 1 );
       tRegs.nByte = LO16( wSampleRate );
@@ -141,7 +185,7 @@ void ImuICM20948_Initialize( void )
       tRegs.tBank2GyroCfg1.nGyroDlpfCfg = IMUICM20948_GYRO_LOWPASS_SELECT;
       tRegs.tBank2GyroCfg1.nGyroFsSelec = IMUICM20948_GYRO_FS_SELECT;
       ImuICM20948_WriteRegisters( BANK2_REGS_GYROCONFIG1, &tRegs.nByte, 1 );
-      wSampleRate = 1125 / IMUICM20948_GYRO_SAMPLE_RATE_HZ;
+      wSampleRate = SAMPLE_RATE_BASE_HZ / IMUICM20948_GYRO_SAMPLE_RATE_HZ;
       tRegs.nByte = LO16( wSampleRate );
       ImuICM20948_WriteRegisters( BANK2_REGS_GYROSMPLRT, &tRegs.nByte, 1 );
 //
@@ -169,6 +213,11 @@ void ImuICM20948_Initialize( void )
       ImuICM20948_WriteRegisters( BANK3_REGS_IC2MSTCTRL, &tRegs.nByte, 1 );
       nData = MAGN_SAMPLERATE_20HZ;
       WriteMagRegisters( MAGN_REGS_CNTL2, MAGN_SAMPLERATE_20HZ );
+
+      #if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+        // set up the FIFO
+        ConfigureFifo( wSampleRate );
+      #endif
     }
   }
 }
@@ -300,6 +349,10 @@ IMUICM20948ERR ImuICM20948_GetAllData( PIMUICM20948ALL ptData )
  *****************************************************************************/
 void ImuICM20948_ProcessDataReady( void )
 {
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+  // drain the FIFO
+  DrainFifo( );
+#else
   // temporary data registers
   U8  anTempData[( BANK0_REGS_EXTSLVSENSD05 - BANK0_REGS_ACCELXOUTH ) + 1 ];
 
@@ -348,6 +401,7 @@ void ImuICM20948_ProcessDataReady( void )
     // call the indirection on good data
     ImuICM20948_PostDataEvent( );
   }
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
 }
 
 /******************************************************************************
@@ -432,6 +486,73 @@ void ImuICM20948_GetRawData( PIMUICM20948DATA ptRawData )
   memcpy( ptRawData, &tRawData, IMUICM20948DATA_SIZE );
 }
 
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+/******************************************************************************
+ *
+ * @function ImuICM20948_GetSample
+ *
+ * @brief  get a sample
+ *
+ * This function will remove the oldest sample from the sample ring
+ * 
+ * @param[io]   ptSample    pointer to store the sample
+ *
+ * @return      approriate error
+ *
+ *****************************************************************************/
+IMUICM20948ERR ImuICM20948_GetSample( PIMUICM20948SAMPLE ptSample )
+{
+  IMUICM20948ERR  eError = IMUICM20948_ERR_NODATA;
+
+  // check for a sample
+  if ( wRingCount != 0 )
+  {
+    // copy it and remove it
+    memcpy( ptSample, &atSampleRing[ wRingRdIdx ], IMUICM20948SAMPLE_SIZE );
+    wRingRdIdx = ( wRingRdIdx + 1 ) & FIFO_RING_MASK;
+    wRingCount--;
+    eError = IMUICM20948_ERR_NONE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ *
+ * @function ImuICM20948_GetSampleCount
+ *
+ * @brief  get the sample count
+ *
+ * This function will return the number of samples in the sample ring
+ * 
+ * @return      number of samples
+ *
+ *****************************************************************************/
+U16 ImuICM20948_GetSampleCount( void )
+{
+  // return the count
+  return( wRingCount );
+}
+
+/******************************************************************************
+ *
+ * @function ImuICM20948_GetFifoStats
+ *
+ * @brief  get the FIFO statistics
+ *
+ * This function will return the FIFO statistics
+ * 
+ * @param[io]   ptStats     pointer to store the statistics
+ *
+ *****************************************************************************/
+void ImuICM20948_GetFifoStats( PIMUICM20948FIFOSTATS ptStats )
+{
+  // copy them
+  memcpy( ptStats, &tFifoStats, IMUICM20948FIFOSTATS_SIZE );
+}
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+
 /******************************************************************************
  *
  * @function WriteMagRegisters
@@ -508,4 +629,248 @@ static BOOL ReadMagRegisters( MAGNREGS eMagReg, PU8 pnData, U8 nLength )
   return ( TRUE );
 }
 
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+/******************************************************************************
+ *
+ * @function ConfigureFifo
+ *
+ * @brief  configure the FIFO
+ *
+ * This function will select the sensors written to the FIFO, enable the
+ * overflow and watermark interrupts and start the FIFO
+ * 
+ * @param[in]   wDivider    sample rate divider
+ *
+ *****************************************************************************/
+static void ConfigureFifo( U16 wDivider )
+{
+  BANKXREGS   tRegs;
+
+  // clear the ring and the statistics, the time is anchored on the first drain
+  wRingWrIdx = 0;
+  wRingRdIdx = 0;
+  wRingCount = 0;
+  memset( &tFifoStats, 0, IMUICM20948FIFOSTATS_SIZE );
+  bAnchored = FALSE;
+  wSampleDivider = wDivider + 1;
+
+  // select the sensors
+  tRegs.nByte = 0;
+  tRegs.tBank0FifoEn2.bAccelFifoEn = ON;
+  tRegs.tBank0FifoEn2.bGyroXFifoEn = ON;
+  tRegs.tBank0FifoEn2.bGyroYFifoEn = ON;
+  tRegs.tBank0FifoEn2.bGyroZFifoEn = ON;
+  #if ( IMUICM20948_FIFO_TEMP_ENABLE == 1 )
+    tRegs.tBank0FifoEn2.bTempFifoEn = ON;
+  #endif
+  ImuICM20948_WriteRegisters( BANK0_REGS_FIFOEN2, &tRegs.nByte, 1 );
+
+  // snapshot mode, a full FIFO stops instead of overwriting part of a frame
+  tRegs.nByte = 0;
+  tRegs.tBank0FifoMode.nFifoMode = FIFO_ALL_FIFOS;
+  ImuICM20948_WriteRegisters( BANK0_REGS_FIFOMODE, &tRegs.nByte, 1 );
+
+  // enable the overflow and watermark interrupts
+  tRegs.nByte = 0;
+  tRegs.tBank0IntEnable2.nFifoOverFlowEn = FIFO_ALL_FIFOS;
+  ImuICM20948_WriteRegisters( BANK0_REGS_INTENABLE2, &tRegs.nByte, 1 );
+  tRegs.nByte = 0;
+  tRegs.tBank0IntEnable3.nFifoWmEn = FIFO_ALL_FIFOS;
+  ImuICM20948_WriteRegisters( BANK0_REGS_INTENABLE3, &tRegs.nByte, 1 );
+
+  // reset it
+  ResetFifo( );
+
+  // enable it, leaving the I2C master on for the magnetometer
+  tRegs.nByte = 0;
+  tRegs.tBank0UserCtrl.bI2cMstEn = ON;
+  tRegs.tBank0UserCtrl.bFifoEn = ON;
+  ImuICM20948_WriteRegisters( BANK0_REGS_USERCTRL, &tRegs.nByte, 1 );
+}
+
+/******************************************************************************
+ *
+ * @function ResetFifo
+ *
+ * @brief  reset the FIFO
+ *
+ * This function will assert and release the FIFO reset, discarding its
+ * contents
+ * 
+ *****************************************************************************/
+static void ResetFifo( void )
+{
+  BANKXREGS   tRegs;
+
+  // assert it/release it
+  tRegs.nByte = 0;
+  tRegs.tBank0FifoRst.nFifoReset = FIFO_ALL_FIFOS;
+  ImuICM20948_WriteRegisters( BANK0_REGS_FIFORST, &tRegs.nByte, 1 );
+  tRegs.nByte = 0;
+  ImuICM20948_WriteRegisters( BANK0_REGS_FIFORST, &tRegs.nByte, 1 );
+}
+
+/******************************************************************************
+ *
+ * @function DrainFifo
+ *
+ * @brief  drain the FIFO
+ *
+ * This function will read the FIFO count and, at the watermark, read the
+ * whole frames in bursts into the sample ring.  The device has no user
+ * watermark level so the watermark is applied to the count here.  On an
+ * overflow or a failed read the whole frames already read are kept, the
+ * FIFO is reset to drop the partial frame and the time is anchored again on
+ * the next drain
+ * 
+ *****************************************************************************/
+static void DrainFifo( void )
+{
+  U8    anCount[ 2 ];
+  U8    nOverflow;
+  U16   wCount, wNumFrames, wBurstFrames;
+  BOOL  bOverflow;
+  PIMUICM20948SAMPLE  ptSample;
+
+  // read the overflow status, cleared on read, and the count
+  if ( ImuICM20948_ReadRegisters( BANK0_REGS_INTSTATUS2, &nOverflow, 1 ) &&
+       ImuICM20948_ReadRegisters( BANK0_REGS_FIFOCOUNTH, anCount, 2 ))
+  {
+    // get the whole frames, a full FIFO is an overflow even if the status was missed
+    wCount = (( anCount[ 0 ] & FIFO_COUNTH_MASK ) << 8 ) | anCount[ 1 ];
+    wNumFrames = wCount / FIFO_FRAME_SIZE;
+    bOverflow = ((( nOverflow & FIFO_ALL_FIFOS ) != 0 ) || ( wCount > ( FIFO_SIZE_BYTES - FIFO_FRAME_SIZE ))) ? TRUE : FALSE;
+
+    // process at the watermark or on an overflow
+    if (( wNumFrames >= IMUICM20948_FIFO_WATERMARK_FRAMES ) || ( bOverflow ))
+    {
+      // anchor the time on the first drain after a reset, the newest frame is now
+      if (( !bAnchored ) && ( wNumFrames != 0 ))
+      {
+        hAnchorUsec = SystemTick_GetTimeUsec( ) - SampleOffsetUsec( wNumFrames - 1 );
+        uAnchorIndex = 0;
+        bAnchored = TRUE;
+      }
+
+      // read the whole frames in bursts
+      while ( wNumFrames != 0 )
+      {
+        wBurstFrames = MIN( wNumFrames, IMUICM20948_FIFO_BURST_FRAMES );
+        if ( ImuICM20948_ReadRegisters( BANK0_REGS_FIFORW, anBurst, ( U8 )( wBurstFrames * FIFO_FRAME_SIZE )))
+        {
+          // parse them
+          ParseFrames( anBurst, wBurstFrames );
+          tFifoStats.uBursts++;
+          wNumFrames -= wBurstFrames;
+        }
+        else
+        {
+          // the alignment is lost, reset it
+          bOverflow = TRUE;
+          wNumFrames = 0;
+        }
+      }
+
+      // recover from an overflow
+      if ( bOverflow )
+      {
+        ResetFifo( );
+        bAnchored = FALSE;
+        tFifoStats.uOverflows++;
+      }
+
+      // update the current data from the newest sample
+      if ( wRingCount != 0 )
+      {
+        ptSample = &atSampleRing[( wRingWrIdx - 1 ) & FIFO_RING_MASK ];
+        tCurData.tAccel.fAxisX = ( FLOAT )ptSample->asAccel[ 0 ] * IMUICM20948_ACCEL_CONV_K;
+        tCurData.tAccel.fAxisY = ( FLOAT )ptSample->asAccel[ 1 ] * IMUICM20948_ACCEL_CONV_K;
+        tCurData.tAccel.fAxisZ = ( FLOAT )ptSample->asAccel[ 2 ] * IMUICM20948_ACCEL_CONV_K;
+        tCurData.tGyro.fAxisX = ( FLOAT )ptSample->asGyro[ 0 ] * IMUICM20948_GYRO_CONV_K;
+        tCurData.tGyro.fAxisY = ( FLOAT )ptSample->asGyro[ 1 ] * IMUICM20948_GYRO_CONV_K;
+        tCurData.tGyro.fAxisZ = ( FLOAT )ptSample->asGyro[ 2 ] * IMUICM20948_GYRO_CONV_K;
+        bValidData = TRUE;
+
+        // call the indirection on good data
+        ImuICM20948_PostDataEvent( );
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ *
+ * @function ParseFrames
+ *
+ * @brief  parse frames
+ *
+ * This function will parse the packed big endian frames into the sample
+ * ring, dropping the oldest sample when it is full, and stamp each with its
+ * time from the anchor
+ * 
+ * @param[in]   pnData      pointer to the frames
+ * @param[in]   wNumFrames  number of frames
+ *
+ *****************************************************************************/
+static void ParseFrames( PU8 pnData, U16 wNumFrames )
+{
+  PIMUICM20948SAMPLE  ptSample;
+  U8                  nAxis;
+
+  // for each frame
+  while ( wNumFrames-- != 0 )
+  {
+    // drop the oldest if full
+    if ( wRingCount == IMUICM20948_FIFO_RING_SIZE )
+    {
+      wRingRdIdx = ( wRingRdIdx + 1 ) & FIFO_RING_MASK;
+      tFifoStats.uRingDrops++;
+    }
+    else
+    {
+      wRingCount++;
+    }
+
+    // fill it
+    ptSample = &atSampleRing[ wRingWrIdx ];
+    for ( nAxis = 0; nAxis < 3; nAxis++ )
+    {
+      ptSample->asAccel[ nAxis ] = ( S16 )(( pnData[ FIFO_FRAME_ACCEL_OFS + ( nAxis * 2 ) ] << 8 ) | pnData[ FIFO_FRAME_ACCEL_OFS + ( nAxis * 2 ) + 1 ] );
+      ptSample->asGyro[ nAxis ] = ( S16 )(( pnData[ FIFO_FRAME_GYRO_OFS + ( nAxis * 2 ) ] << 8 ) | pnData[ FIFO_FRAME_GYRO_OFS + ( nAxis * 2 ) + 1 ] );
+    }
+    #if ( IMUICM20948_FIFO_TEMP_ENABLE == 1 )
+      ptSample->sTemp = ( S16 )(( pnData[ FIFO_FRAME_TEMP_OFS ] << 8 ) | pnData[ FIFO_FRAME_TEMP_OFS + 1 ] );
+    #else
+      ptSample->sTemp = 0;
+    #endif
+    ptSample->hTimeUsec = hAnchorUsec + SampleOffsetUsec( uAnchorIndex++ );
+
+    // next
+    wRingWrIdx = ( wRingWrIdx + 1 ) & FIFO_RING_MASK;
+    pnData += FIFO_FRAME_SIZE;
+    tFifoStats.uFrames++;
+  }
+}
+
+/******************************************************************************
+ *
+ * @function SampleOffsetUsec
+ *
+ * @brief  sample offset
+ *
+ * This function will return the time of a sample from the anchor, computed
+ * from the index so the ODR period does not accumulate rounding
+ * 
+ * @param[in]   uIndex      sample index
+ *
+ * @return      offset in microseconds
+ *
+ *****************************************************************************/
+static U64 SampleOffsetUsec( U32 uIndex )
+{
+  // compute it
+  return((( U64 )uIndex * wSampleDivider * 1000000 ) / SAMPLE_RATE_BASE_HZ );
+}
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+
 /**@} EOF ImuICM20948.c */
@@ -76,6 +76,26 @@ typedef struct _IMUICM20948ALL
 } IMUICM20948ALL, *PIMUICM20948ALL;
 #define IMUICM20948ALL_SIZE                     sizeof( IMUICM20948ALL )
 
+/// define the FIFO sample structure
+typedef struct _IMUICM20948SAMPLE
+{
+  U64     hTimeUsec;          ///< sample time in microseconds, reconstructed from the ODR
+  S16     asAccel[ 3 ];       ///< raw acceleration X/Y/Z
+  S16     asGyro[ 3 ];        ///< raw gyro X/Y/Z
+  S16     sTemp;              ///< raw temperature
+} IMUICM20948SAMPLE, *PIMUICM20948SAMPLE;
+#define IMUICM20948SAMPLE_SIZE                  sizeof( IMUICM20948SAMPLE )
+
+/// define the FIFO statistics structure
+typedef struct _IMUICM20948FIFOSTATS
+{
+  U32     uFrames;            ///< frames parsed
+  U32     uBursts;            ///< burst reads
+  U32     uOverflows;         ///< device FIFO overflows recovered
+  U32     uRingDrops;         ///< samples dropped from a full sample ring
+} IMUICM20948FIFOSTATS, *PIMUICM20948FIFOSTATS;
+#define IMUICM20948FIFOSTATS_SIZE               sizeof( IMUICM20948FIFOSTATS )
+
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
@@ -87,6 +107,11 @@ extern  IMUICM20948ERR  ImuICM20948_GetAllData( PIMUICM20948ALL ptData );
 extern  FLOAT           ImuICM20948_GetImuFieldValue( IMUICM20948DATAFLDS eField );
 extern  void            ImuICM20948_ProcessDataReady( void );
 extern  void            ImuICM20948_GetRawData( PIMUICM20948DATA ptRawData );
+#if ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
+extern  IMUICM20948ERR  ImuICM20948_GetSample( PIMUICM20948SAMPLE ptSample );
+extern  U16             ImuICM20948_GetSampleCount( void );
+extern  void            ImuICM20948_GetFifoStats( PIMUICM20948FIFOSTATS ptStats );
+#endif // ( IMUICM20948_FIFO_MODE_ENABLE == 1 )
 
 /**@} EOF ImuICM20948.h */
 
@@ -73,6 +73,18 @@
 /// define the magnetometer address (AK09916)
 #define MAGN_AK09916_I2C_ADDR                       ( 0x0C )
 
+/// define the FIFO size in bytes
+#define FIFO_SIZE_BYTES                             ( 512 )
+
+/// define the FIFO count mask, high byte
+#define FIFO_COUNTH_MASK                            ( 0x1F )
+
+/// define the FIFO reset/mode/interrupt value, applied to FIFO 0 through 4
+#define FIFO_ALL_FIFOS                              ( 0x1F )
+
+/// define the internal sample rate for the sample rate dividers
+#define SAMPLE_RATE_BASE_HZ                         ( 1125 )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the Bank0 Registers
 typedef enum _BANK0REGS
@@ -453,6 +465,20 @@ typedef struct _BANK0FIFOEN2
 } BANK0FIFOEN2, *PBANK0FIFOEN2;
 #define BANK0FIFOEN2_SIZE                      sizeof( BANK0FIFOEN2 )
 
+/// define the BANK0 FIFO reset
+typedef struct _BANK0FIFORST
+{
+  U8  nFifoReset      : 5;
+} BANK0FIFORST, *PBANK0FIFORST;
+#define BANK0FIFORST_SIZE                      sizeof( BANK0FIFORST )
+
+/// define the BANK0 FIFO mode, set for snapshot, clear for stream
+typedef struct _BANK0FIFOMODE
+{
+  U8  nFifoMode       : 5;
+} BANK0FIFOMODE, *PBANK0FIFOMODE;
+#define BANK0FIFOMODE_SIZE                     sizeof( BANK0FIFOMODE )
+
 /// define the BANK0 Data Ready Status
 typedef struct _BANK0DATARDYSTATUS
 {
@@ -556,10 +582,14 @@ typedef union _BANKXREGS
   BANK0INTSTATUS1       tBank0IntStatus1;
   BANK0INTSTATUS2       tBank0IntStatus2;
   BANK0INTENABLE        tBank0IntEnable;
+  BANK0INTENABLE2       tBank0IntEnable2;
   BANK0INTENABLE3       tBank0IntEnable3;
+  BANK0INTSTATUS3       tBank0IntStatus3;
   BANK0I2CMSTSTATUS     tBank0I2cMstStatus;
   BANK0FIFOEN1          tBank0FifoEn1;
   BANK0FIFOEN2          tBank0FifoEn2;
+  BANK0FIFORST          tBank0FifoRst;
+  BANK0FIFOMODE         tBank0FifoMode;
   BANK0DATARDYSTATUS    tBank0DataRdyStatus;
   BANK2GYROCFG1         tBank2GyroCfg1;
   BANK2GYROCFG2         tBank2GyroCfg2;
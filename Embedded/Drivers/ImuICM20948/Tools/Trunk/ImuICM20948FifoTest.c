@@ -0,0 +1,587 @@
+/******************************************************************************
+ * @file ImuICM20948FifoTest.c
+ *
+ * @brief IMU ICM20948 FIFO burst test
+ *
+ * This file provides a host tool that runs the ICM20948 driver in FIFO burst
+ * mode against a register level simulated device.  The device writes packed
+ * frames into a 512 byte snapshot FIFO at the configured ODR, each frame
+ * carrying a pattern derived from its sample index.  The tool polls the
+ * driver and drains the sample ring, checking every sample decodes to a
+ * consistent pattern, arrives in order and carries a timestamp within one
+ * ODR period of its true time.  It then stalls the poll to overflow the
+ * FIFO and checks the recovery realigns the frames and the time, and stalls
+ * the consumer to check the ring drops the oldest samples.  It reports the
+ * bus transactions per sample.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o ImuICM20948FifoTest
+ *             ImuICM20948FifoTest.c ../../Core/Trunk/ImuICM20948.c
+ * usage:      ImuICM20948FifoTest
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup ImuICM20948
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "ImuICM20948/ImuICM20948.h"
+
+// library includes -----------------------------------------------------------
+#include "SystemTick/SystemTick.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the frame size, acceleration, gyro and temperature
+#define SIM_FRAME_SIZE                              ( 14 )
+
+/// define the ODR divider as the driver programs it
+#define SIM_DIVIDER                                 (( SAMPLE_RATE_BASE_HZ / IMUICM20948_ACCEL_SAMPLE_RATE_HZ ) + 1 )
+
+/// define the poll period
+#define POLL_USECS                                  ( 10000 )
+
+/// define the phase lengths in polls
+#define STEADY_POLLS                                ( 6000 )
+#define STALL_POLLS                                 ( 30 )
+#define RECOVER_POLLS                               ( 500 )
+#define SLOW_POLLS                                  ( 100 )
+
+/// define the user control FIFO enable
+#define USERCTRL_FIFO_EN                            ( 0x40 )
+
+// structures -----------------------------------------------------------------
+/// define the checker state
+typedef struct _CHECKER
+{
+  U32   uExpect;            ///< next expected sample index
+  U32   uSamples;           ///< samples checked
+  U32   uLost;              ///< samples skipped where allowed
+  U32   uErrors;            ///< errors
+  U64   hMaxTimeErr;        ///< largest timestamp error
+  BOOL  bAllowGap;          ///< allow one gap in the sequence
+} CHECKER, *PCHECKER;
+
+// local parameter declarations -----------------------------------------------
+static  U8      anRegs[ 4 ][ 128 ];
+static  U8      anFifo[ FIFO_SIZE_BYTES ];
+static  U16     wFifoHead;
+static  U16     wFifoCount;
+static  U64     hSimTimeUsec;
+static  U32     uSimIndex;
+static  U32     uTransactions;
+static  CHECKER tCheck;
+
+// local function prototypes --------------------------------------------------
+static  U64     TrueTimeUsec( U32 uIndex );
+static  void    BuildFrame( U32 uIndex, PU8 pnFrame );
+static  void    SimAdvance( U64 hUsecs );
+static  void    Poll( U32 uNumPolls, BOOL bConsume );
+static  void    Consume( void );
+static  int     RunSteady( void );
+static  int     RunStall( void );
+static  int     RunSlowConsumer( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will initialize the driver and run the checks
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+
+  // initialize
+  anRegs[ 0 ][ BANK0_REGS_WHOAMI ] = CHIP_ID_VALUE;
+  hSimTimeUsec = 1000000;
+  ImuICM20948_Initialize( );
+  if (( anRegs[ 0 ][ BANK0_REGS_USERCTRL ] & USERCTRL_FIFO_EN ) == 0 )
+  {
+    printf( "initialize did not enable the FIFO\n" );
+    return( 1 );
+  }
+
+  // the device starts sampling now
+  uSimIndex = 0;
+  tCheck.uExpect = 0;
+  hSimTimeUsec = 0;
+
+  // run the checks
+  iErrors += RunSteady( );
+  iErrors += RunStall( );
+  iErrors += RunSlowConsumer( );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function ImuICM20948_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function does nothing for the simulation
+ *
+ *****************************************************************************/
+void ImuICM20948_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function ImuICM20948_ReadRegisters
+ *
+ * @brief read registers
+ *
+ * This function will read the simulated device, popping the FIFO data
+ * register, returning the FIFO count and clearing the overflow status on
+ * read
+ *
+ * @param[in]   wBaseReg    bank and register
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   nLength     number of bytes
+ *
+ * @return      TRUE
+ *
+ *****************************************************************************/
+BOOL ImuICM20948_ReadRegisters( U16 wBaseReg, PU8 pnData, U8 nLength )
+{
+  U8  nBank = HI16( wBaseReg ), nReg = LO16( wBaseReg ), nIdx;
+
+  // count it
+  uTransactions++;
+
+  // determine the register
+  if (( nBank == 0 ) && ( nReg == BANK0_REGS_FIFORW ))
+  {
+    // pop the FIFO
+    for ( nIdx = 0; nIdx < nLength; nIdx++ )
+    {
+      if ( wFifoCount != 0 )
+      {
+        pnData[ nIdx ] = anFifo[ wFifoHead ];
+        wFifoHead = ( wFifoHead + 1 ) % FIFO_SIZE_BYTES;
+        wFifoCount--;
+      }
+      else
+      {
+        pnData[ nIdx ] = 0xFF;
+      }
+    }
+  }
+  else if (( nBank == 0 ) && ( nReg == BANK0_REGS_FIFOCOUNTH ))
+  {
+    // return the count
+    pnData[ 0 ] = ( U8 )( wFifoCount >> 8 );
+    pnData[ 1 ] = ( U8 )wFifoCount;
+  }
+  else
+  {
+    // copy the registers, clear the overflow status on read
+    memcpy( pnData, &anRegs[ nBank ][ nReg ], nLength );
+    if (( nBank == 0 ) && ( nReg == BANK0_REGS_INTSTATUS2 ))
+    {
+      anRegs[ 0 ][ BANK0_REGS_INTSTATUS2 ] = 0;
+    }
+  }
+
+  // return ok
+  return( TRUE );
+}
+
+/******************************************************************************
+ * @function ImuICM20948_WriteRegisters
+ *
+ * @brief write registers
+ *
+ * This function will write the simulated device, clearing the FIFO on a
+ * FIFO reset
+ *
+ * @param[in]   wBaseReg    bank and register
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   nLength     number of bytes
+ *
+ * @return      TRUE
+ *
+ *****************************************************************************/
+BOOL ImuICM20948_WriteRegisters( U16 wBaseReg, PU8 pnData, U8 nLength )
+{
+  U8  nBank = HI16( wBaseReg ), nReg = LO16( wBaseReg );
+
+  // count it/store it
+  uTransactions++;
+  memcpy( &anRegs[ nBank ][ nReg ], pnData, nLength );
+
+  // check for reset
+  if (( nBank == 0 ) && ( nReg == BANK0_REGS_FIFORST ) && ( pnData[ 0 ] != 0 ))
+  {
+    wFifoHead = 0;
+    wFifoCount = 0;
+  }
+
+  // return ok
+  return( TRUE );
+}
+
+/******************************************************************************
+ * @function ImuICM20948_PostDataEvent
+ *
+ * @brief post data event
+ *
+ * This function does nothing for the simulation
+ *
+ *****************************************************************************/
+void ImuICM20948_PostDataEvent( void )
+{
+}
+
+/******************************************************************************
+ * @function SystemTick_GetTimeUsec
+ *
+ * @brief get the time
+ *
+ * This function will return the simulated time
+ *
+ * @return      time in microseconds
+ *
+ *****************************************************************************/
+U64 SystemTick_GetTimeUsec( void )
+{
+  return( hSimTimeUsec );
+}
+
+/******************************************************************************
+ * @function SystemTick_DelayMsec
+ *
+ * @brief delay
+ *
+ * This function will ignore the delay
+ *
+ * @param[in]   wMilliSeconds   delay in milliseconds
+ *
+ *****************************************************************************/
+void SystemTick_DelayMsec( U16 wMilliSeconds )
+{
+  ( void )wMilliSeconds;
+}
+
+/******************************************************************************
+ * @function TrueTimeUsec
+ *
+ * @brief true sample time
+ *
+ * This function will return the time the device took a sample
+ *
+ * @param[in]   uIndex      sample index
+ *
+ * @return      time in microseconds
+ *
+ *****************************************************************************/
+static U64 TrueTimeUsec( U32 uIndex )
+{
+  // compute it
+  return((( U64 )uIndex * SIM_DIVIDER * 1000000 ) / SAMPLE_RATE_BASE_HZ );
+}
+
+/******************************************************************************
+ * @function BuildFrame
+ *
+ * @brief build a frame
+ *
+ * This function will build the big endian frame for a sample index
+ *
+ * @param[in]   uIndex      sample index
+ * @param[io]   pnFrame     pointer to the frame
+ *
+ *****************************************************************************/
+static void BuildFrame( U32 uIndex, PU8 pnFrame )
+{
+  U16 awValues[ SIM_FRAME_SIZE / 2 ];
+  int iIdx;
+
+  // build the pattern
+  awValues[ 0 ] = ( U16 )uIndex;
+  awValues[ 1 ] = ( U16 )~uIndex;
+  awValues[ 2 ] = ( U16 )( uIndex * 7 );
+  awValues[ 3 ] = ( U16 )( uIndex * 3 );
+  awValues[ 4 ] = ( U16 )( 0 - uIndex );
+  awValues[ 5 ] = ( U16 )( uIndex ^ 0x5A5A );
+  awValues[ 6 ] = ( U16 )( uIndex * 11 );
+
+  // pack it
+  for ( iIdx = 0; iIdx < SIM_FRAME_SIZE / 2; iIdx++ )
+  {
+    pnFrame[ iIdx * 2 ] = HI16( awValues[ iIdx ] );
+    pnFrame[ ( iIdx * 2 ) + 1 ] = LO16( awValues[ iIdx ] );
+  }
+}
+
+/******************************************************************************
+ * @function SimAdvance
+ *
+ * @brief advance the simulation
+ *
+ * This function will advance the time, writing each sample due into the
+ * FIFO, stopping at full with the overflow status set
+ *
+ * @param[in]   hUsecs      time to advance
+ *
+ *****************************************************************************/
+static void SimAdvance( U64 hUsecs )
+{
+  U8  anFrame[ SIM_FRAME_SIZE ];
+  int iIdx;
+
+  // advance
+  hSimTimeUsec += hUsecs;
+  while ( TrueTimeUsec( uSimIndex ) <= hSimTimeUsec )
+  {
+    // write it if enabled
+    if ( anRegs[ 0 ][ BANK0_REGS_USERCTRL ] & USERCTRL_FIFO_EN )
+    {
+      BuildFrame( uSimIndex, anFrame );
+      for ( iIdx = 0; iIdx < SIM_FRAME_SIZE; iIdx++ )
+      {
+        if ( wFifoCount < FIFO_SIZE_BYTES )
+        {
+          anFifo[( wFifoHead + wFifoCount ) % FIFO_SIZE_BYTES ] = anFrame[ iIdx ];
+          wFifoCount++;
+        }
+        else
+        {
+          anRegs[ 0 ][ BANK0_REGS_INTSTATUS2 ] = 0x01;
+        }
+      }
+    }
+    uSimIndex++;
+  }
+}
+
+/******************************************************************************
+ * @function Consume
+ *
+ * @brief consume the samples
+ *
+ * This function will drain the sample ring and check each sample
+ *
+ *****************************************************************************/
+static void Consume( void )
+{
+  IMUICM20948SAMPLE tSample;
+  U32               uIndex;
+  U64               hError;
+
+  // for each sample
+  while ( ImuICM20948_GetSample( &tSample ) == IMUICM20948_ERR_NONE )
+  {
+    // recover the index, the low 16 bits from accel X, the rest from the expected index
+    uIndex = ( tCheck.uExpect & 0xFFFF0000 ) | ( U16 )tSample.asAccel[ 0 ];
+    if ( uIndex < tCheck.uExpect )
+    {
+      uIndex += 0x10000;
+    }
+    tCheck.uSamples++;
+
+    // check the pattern
+    if (( tSample.asAccel[ 1 ] != ( S16 )~uIndex ) || ( tSample.asAccel[ 2 ] != ( S16 )( uIndex * 7 )) ||
+        ( tSample.asGyro[ 0 ] != ( S16 )( uIndex * 3 )) || ( tSample.asGyro[ 1 ] != ( S16 )( 0 - uIndex )) ||
+        ( tSample.asGyro[ 2 ] != ( S16 )( uIndex ^ 0x5A5A )) || ( tSample.sTemp != ( S16 )( uIndex * 11 )))
+    {
+      if ( tCheck.uErrors++ < 5 )
+      {
+        printf( "  error: sample %u misaligned\n", uIndex );
+      }
+      continue;
+    }
+
+    // check the sequence
+    if ( uIndex != tCheck.uExpect )
+    {
+      if (( tCheck.bAllowGap ) && ( uIndex > tCheck.uExpect ))
+      {
+        tCheck.uLost += uIndex - tCheck.uExpect;
+        tCheck.bAllowGap = FALSE;
+      }
+      else if ( tCheck.uErrors++ < 5 )
+      {
+        printf( "  error: sample %u expected %u\n", uIndex, tCheck.uExpect );
+      }
+    }
+    tCheck.uExpect = uIndex + 1;
+
+    // check the time
+    hError = ( tSample.hTimeUsec > TrueTimeUsec( uIndex )) ? tSample.hTimeUsec - TrueTimeUsec( uIndex ) : TrueTimeUsec( uIndex ) - tSample.hTimeUsec;
+    tCheck.hMaxTimeErr = MAX( tCheck.hMaxTimeErr, hError );
+    if (( hError > TrueTimeUsec( 1 )) && ( tCheck.uErrors++ < 5 ))
+    {
+      printf( "  error: sample %u time off by %llu usec\n", uIndex, ( unsigned long long )hError );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function Poll
+ *
+ * @brief poll the driver
+ *
+ * This function will advance the simulation a poll period at a time and
+ * process the driver, optionally consuming the samples
+ *
+ * @param[in]   uNumPolls   number of polls
+ * @param[in]   bConsume    TRUE to consume the samples
+ *
+ *****************************************************************************/
+static void Poll( U32 uNumPolls, BOOL bConsume )
+{
+  // for each poll
+  while ( uNumPolls-- != 0 )
+  {
+    SimAdvance( POLL_USECS );
+    ImuICM20948_ProcessDataReady( );
+    if ( bConsume )
+    {
+      Consume( );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function RunSteady
+ *
+ * @brief steady state check
+ *
+ * This function will poll for a minute, checking every sample arrives in
+ * order with its time, and report the bus transactions per sample
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunSteady( void )
+{
+  IMUICM20948FIFOSTATS  tStats;
+  U32                   uStartTransactions = uTransactions;
+  int                   iErrors;
+
+  // run it
+  Poll( STEADY_POLLS, TRUE );
+  ImuICM20948_GetFifoStats( &tStats );
+
+  // report
+  printf( "steady: %u samples at %.2f Hz, %u bursts, %.3f bus transactions per sample, max time error %llu usec\n",
+          tCheck.uSamples, ( SAMPLE_RATE_BASE_HZ * 1.0 ) / SIM_DIVIDER, tStats.uBursts,
+          ( double )( uTransactions - uStartTransactions ) / tCheck.uSamples, ( unsigned long long )tCheck.hMaxTimeErr );
+  iErrors = tCheck.uErrors;
+  if (( tCheck.uSamples + IMUICM20948_FIFO_WATERMARK_FRAMES < uSimIndex ) || ( tStats.uOverflows != 0 ) || ( tStats.uRingDrops != 0 ))
+  {
+    printf( "  error: %u of %u samples, %u overflows, %u drops\n", tCheck.uSamples, uSimIndex, tStats.uOverflows, tStats.uRingDrops );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunStall
+ *
+ * @brief overflow check
+ *
+ * This function will stop polling long enough to overflow the FIFO, then
+ * check the frames read before the overflow, the single gap and the realigned
+ * frames and time after it
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunStall( void )
+{
+  IMUICM20948FIFOSTATS  tStats;
+  U32                   uStartErrors = tCheck.uErrors, uStartSamples = tCheck.uSamples;
+  int                   iErrors;
+
+  // stall, the partial frame written at full is left in the FIFO
+  SimAdvance( STALL_POLLS * POLL_USECS );
+  tCheck.bAllowGap = TRUE;
+  tCheck.hMaxTimeErr = 0;
+  Poll( RECOVER_POLLS, TRUE );
+  ImuICM20948_GetFifoStats( &tStats );
+
+  // report
+  printf( "stall: %u overflows, %u samples lost, %u samples after, max time error %llu usec\n", tStats.uOverflows, tCheck.uLost,
+          tCheck.uSamples - uStartSamples, ( unsigned long long )tCheck.hMaxTimeErr );
+  iErrors = tCheck.uErrors - uStartErrors;
+  if (( tStats.uOverflows != 1 ) || ( tCheck.uLost == 0 ) || ( tCheck.bAllowGap ))
+  {
+    printf( "  error: overflow not recovered\n" );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunSlowConsumer
+ *
+ * @brief ring overflow check
+ *
+ * This function will keep polling without consuming, then check the ring
+ * holds the newest samples in order
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunSlowConsumer( void )
+{
+  IMUICM20948FIFOSTATS  tStats;
+  IMUICM20948SAMPLE     tSample;
+  U32                   uStartErrors = tCheck.uErrors, uStartDrops, uHeld;
+  int                   iErrors;
+
+  // poll without consuming
+  ImuICM20948_GetFifoStats( &tStats );
+  uStartDrops = tStats.uRingDrops;
+  Poll( SLOW_POLLS, FALSE );
+  ImuICM20948_GetFifoStats( &tStats );
+  uHeld = ImuICM20948_GetSampleCount( );
+
+  // the oldest held must follow the dropped ones
+  tCheck.bAllowGap = TRUE;
+  Consume( );
+
+  // the newest must follow without a gap
+  Poll( RECOVER_POLLS, TRUE );
+
+  // report
+  printf( "slow consumer: %u held, %u dropped\n", uHeld, tStats.uRingDrops - uStartDrops );
+  iErrors = tCheck.uErrors - uStartErrors;
+  if (( uHeld != IMUICM20948_FIFO_RING_SIZE ) || ( tStats.uRingDrops == uStartDrops ) || ( ImuICM20948_GetSample( &tSample ) == IMUICM20948_ERR_NONE ))
+  {
+    printf( "  error: ring did not drop the oldest\n" );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/**@} EOF ImuICM20948FifoTest.c */
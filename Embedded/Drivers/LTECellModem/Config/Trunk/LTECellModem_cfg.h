@@ -46,6 +46,16 @@
 #define LTECELLMODEM_RCVBUF_SIZE                    ( 0 )
 #define LTECELLMODEM_XMTBUF_SIZE                    ( 80 )
 
+/// define the number of entries in the command queue
+#define LTECELLMODEM_CMDQUEUE_SIZE                  ( 16 )
+
+/// define the maximum number of queued commands concatenated on one line, 1 disables
+#define LTECELLMODEM_BATCH_MAX                      ( 4 )
+
+/// define the default command timeout and the number of retries on a timeout
+#define LTECELLMODEM_CMD_TIMEOUT_MSECS              ( 500 )
+#define LTECELLMODEM_CMD_RETRIES                    ( 2 )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the local events
 typedef enum _LTELCLEVENT
@@ -3,19 +3,24 @@
  *
  * @brief LTE Cellular modem implementation
  *
- * This file provides the implementation for the LTE cellular modem
+ * This file provides the implementation for the LTE cellular modem.  Commands
+ * are placed in a queue and sent as soon as the previous final result code
+ * arrives, consecutive idempotent commands are concatenated onto a single
+ * command line.  Received characters are assembled into lines which are
+ * routed to the commands in flight or, through a hashed prefix table, to the
+ * unsolicited result code handler
  *
  * @copyright Copyright (c) 2012 Cyber Intergration
- * This document contains proprietary data and information of Cyber Integration 
- * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
- * disclosed in any form to any party without prior written permission of 
- * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
  * without the prior written permission of Cyber Integration, LLC.
  *
  * Version History
  * ======
  * $Rev: $
- * 
+ *
  *
  * \addtogroup LTECellModem
  * @{
@@ -33,44 +38,113 @@
 #define XMIT_BUF_SIZE                       ( 512 )
 #define RECV_BUF_SIZE                       ( 512 )
 
-/// define the message timeout
-#define XMIT_MSG_TIME_MSECS                 ( 500 )
+/// define the size of the queued command arguments
+#define CMD_ARGS_SIZE                       ( 64 )
+
+/// define the maximum length of a string argument
+#define MAX_STRARG_LEN                      ( 40 )
+
+/// define the maximum socket transfer, hex encoded in the line buffers
+#define MAX_SOCK_XFER                       (( RECV_BUF_SIZE - 32 ) / 2 )
+
+/// define the long command timeouts
+#define CFUN_TIME_MSECS                     ( 15000 )
+#define UMNOPROF_TIME_MSECS                 ( 5000 )
+#define USOCO_TIME_MSECS                    ( 30000 )
 
 /// define the power up delay time
 #define PWRUP_DELAY_TIME_MSECS              ( 3000 )
 
+/// define the synchronization probe time
+#define SYNC_PROBE_TIME_MSECS               ( 250 )
+
 /// define the carriage return/linefeed charasters
 #define CH_CR                               ( 0x0D )
 #define CH_LF                               ( 0x0A )
 
+/// define the field delimiters
+#define CH_QUOTE                            ( '"' )
+#define CH_COMMA                            ( ',' )
+#define CH_COLON                            ( ':' )
+#define CH_SEMI                             ( ';' )
+#define CH_SPACE                            ( ' ' )
+
+/// define the URC hash table size, must be a power of two
+#define URC_HASH_SIZE                       ( 16 )
+#define URC_HASH_MASK                       ( URC_HASH_SIZE - 1 )
+
+/// define the maximum number of response fields
+#define MAX_RSP_FIELDS                      ( 6 )
+
+/// define the highest valid RSSI index
+#define MAX_RSSI_INDEX                      ( 31 )
+
+/// define the access technology not reported value
+#define ACT_NOT_REPORTED                    ( 0xFF )
+
+// check the configuration
+#if ( LTECELLMODEM_BATCH_MAX < 1 )
+  #error "LTECELLMODEM_BATCH_MAX must be at least 1"
+#endif
+#if ( LTECELLMODEM_CMDQUEUE_SIZE > 255 )
+  #error "LTECELLMODEM_CMDQUEUE_SIZE must be less than 256"
+#endif
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the states
 typedef enum _CTLSTATE
 {
   CTL_STATE_PWRUP = 0,
   CTL_STATE_PWRDLY,
+  CTL_STATE_SYNC,
   CTL_STATE_IDLE,
   CTL_STATE_WAIT,
   CTL_STATE_MAX
 } CTLSTATE;
 
-/// enumerate the decode states
-typedef enum _DECSTATE
-{
-  DEC_STATE_CR1 = 0,
-  DEC_STATE_LF1,
-  DEC_STATE_RSP,
-  DEC_STATE_ERR,
-  DEC_STATE_CR2,
-  DEC_STATE_LF2,
-  DEC_STATE_OK1,
-  DEC_STATE_OK2,
-  DEC_STATE_CR3,
-  DEC_STATE_LF3,
-  DEC_STATE_CR4,
-  DEC_STATE_LF4,
-  DEC_STATE_FLS,
-} DECSTATE;
+/// enumerate the response types
+typedef enum _RSPTYPE
+{
+  RSP_TYPE_NONE = 0,        ///< final result code only
+  RSP_TYPE_BARE,            ///< unprefixed identity line
+  RSP_TYPE_IDENT,           ///< prefixed identity
+  RSP_TYPE_VALUE,           ///< single integer
+  RSP_TYPE_CSQ,             ///< signal quality
+  RSP_TYPE_REG,             ///< registration status
+  RSP_TYPE_OPER,            ///< operator selection
+  RSP_TYPE_SOCKET,          ///< socket number/length
+  RSP_TYPE_SOCKDATA,        ///< socket data available
+  RSP_TYPE_SOCKREAD,        ///< socket data read
+  RSP_TYPE_MAX
+} RSPTYPE;
+
+/// enumerate the queued commands
+typedef enum _CMDENUM
+{
+  CMD_ENUM_ECHO = 0,
+  CMD_ENUM_CGSN,
+  CMD_ENUM_CIMI,
+  CMD_ENUM_CCID,
+  CMD_ENUM_CSQ,
+  CMD_ENUM_CREG,
+  CMD_ENUM_CEREG,
+  CMD_ENUM_CEREGSET,
+  CMD_ENUM_UMNOPROF,
+  CMD_ENUM_UMNOPROFSET,
+  CMD_ENUM_COPS,
+  CMD_ENUM_CGDCONT,
+  CMD_ENUM_CTZU,
+  CMD_ENUM_UGPIOC,
+  CMD_ENUM_CFUN,
+  CMD_ENUM_UDCONF,
+  CMD_ENUM_USOCR,
+  CMD_ENUM_USOCL,
+  CMD_ENUM_USOCO,
+  CMD_ENUM_USOLI,
+  CMD_ENUM_USOWR,
+  CMD_ENUM_USORD,
+  CMD_ENUM_MAX
+} CMDENUM;
 
 /// enumerate the MQTT op codes
 typedef enum _LTEMQTTOPCODE
@@ -85,7 +159,7 @@ typedef enum _LTEMQTTOPCODE
   LTE_MQTTOPCODE_WILLTOPIC,
   LTE_MQTTOPCODE_WILLMESSAGE,
   LTE_MQTTOPCODE_INACTIVEPER,
-  LTE_MQTTOPCODE_SSECURE
+  LTE_MQTTOPCODE_SSECURE,
   LTE_MQTTOPCODE_CLEANSESSION,
   LTE_MQTTOPCODE_UNUSED,
   LTE_MQTTOPCODE_TERSEVERB,
@@ -93,54 +167,115 @@ typedef enum _LTEMQTTOPCODE
 } LTEMQTTOPCODE;
 
 // structures -----------------------------------------------------------------
+/// define the parsed response value
+typedef union _RSPVALUE
+{
+  LTECSQ        tCsq;
+  LTEREG        tReg;
+  LTEIDENT      tIdent;
+  LTEOPER       tOper;
+  LTESOCKET     tSocket;
+  LTESOCKDATA   tData;
+  S32           lValue;
+  U16           wCmeError;
+} RSPVALUE, *PRSPVALUE;
+#define RSPVALUE_SIZE                       sizeof( RSPVALUE )
+
+/// define the command definition
+typedef struct _CMDDEF
+{
+  PCC8          pszCommand;       ///< command, also the response prefix
+  RSPTYPE       eRspType;         ///< response type
+  U16           wTimeoutMsecs;    ///< final result code timeout
+  BOOL          bBatchable;       ///< can be concatenated with other commands
+  BOOL          bRetry;           ///< can be resent on a timeout
+} CMDDEF, *PCMDDEF;
+#define CMDDEF_SIZE                         sizeof( CMDDEF )
+
+/// define the queued command
+typedef struct _CMDENTRY
+{
+  CMDENUM       eCmd;             ///< command
+  C8            acArgs[ CMD_ARGS_SIZE ];  ///< formatted arguments
+  PU8           pnData;           ///< socket data buffer
+  U16           wDataLength;      ///< socket data length
+  PVLTECALLBACK pvCallback;       ///< completion callback
+  U8            nRetries;         ///< retries remaining
+  BOOL          bSingle;          ///< send on its own line
+  BOOL          bInfo;            ///< information response received
+  RSPVALUE      tValue;           ///< parsed response
+} CMDENTRY, *PCMDENTRY;
+#define CMDENTRY_SIZE                       sizeof( CMDENTRY )
+
+/// define the unsolicited result code definition
+typedef struct _URCDEF
+{
+  PCC8          pszPrefix;        ///< prefix
+  RSPTYPE       eRspType;         ///< response type
+  LTEURC        eUrc;             ///< URC reported
+} URCDEF, *PURCDEF;
+#define URCDEF_SIZE                         sizeof( URCDEF )
 
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
-static  CTLSTATE      eCtlState;
-static  DECSTATE      eDecState;
-static  U8            anXmitBuffer[ XMIT_BUF_SIZE ];
-static  U8            anRecvBuffer[ RECV_BUF_SIZE ];
-static  U16           wXmitBufIdx;
-static  U16           wRecvBufIdx;
-static  U16           wRespBufIdx;
-static  PVLTECALLBACK pvCurCallback;
-static  PCC8          pszExpectedResult;
+static  CTLSTATE          eCtlState;
+static  C8                acXmitBuffer[ XMIT_BUF_SIZE ];
+static  C8                acRecvBuffer[ RECV_BUF_SIZE ];
+static  U16               wXmitBufIdx;
+static  U16               wRecvBufIdx;
+static  BOOL              bRecvOverflow;
+static  CMDENTRY          atCmdQueue[ LTECELLMODEM_CMDQUEUE_SIZE ];
+static  U8                nQueueHead;
+static  U8                nQueueCount;
+static  U8                nInFlight;
+static  PVLTEURCCALLBACK  pvUrcCallback;
+static  U8                anUrcHash[ URC_HASH_SIZE ];
 
 // local function prototypes --------------------------------------------------
-static  void  SendCommand( PCC8 pszCommand, PC8 pszOption, PCC8 pszExpectedResult, BOOL bSendAT, PVLTECALLBACK pvCallback );
-static  void  ParseResponse( void );
-static  PVOID ParseResponseValue( void );
+static  LTEERR  EnqueueCommand( CMDENUM eCmd, PC8 pcArgs, PU8 pnData, U16 wDataLength, PVLTECALLBACK pvCallback );
+static  void    DispatchCommands( void );
+static  BOOL    CanBatch( void );
+static  void    RequeueCommands( void );
+static  void    CompleteCommands( LTEERR eError, U16 wCmeError );
+static  void    ProcessLine( void );
+static  BOOL    RouteResponse( PC8 pcLine );
+static  void    DispatchUrc( PC8 pcLine );
+static  U8      ComputeHash( PCC8 pszPrefix, PU8 pnLength );
+static  void    BuildUrcTable( void );
+static  BOOL    ParseResponseValue( PC8 pcArgs, RSPTYPE eRspType, BOOL bUrc, PRSPVALUE ptValue, PU8 pnData, U16 wDataLength );
+static  U8      SplitFields( PC8 pcArgs, PC8* ppcFields );
+static  void    CopyString( PC8 pcDst, PCC8 pszSrc, U16 wSize );
+static  U16     DecodeHex( PCC8 pszHex, PU8 pnData, U16 wMaxLength );
+static  S8      HexNibble( C8 cChar );
 
 // constant parameter initializations -----------------------------------------
 /// define the commands
 /// general
 static  const CODE C8   szCmdAT[ ]          = { "AT" };
-static  const CODE C8   szCmdECHO[ ]        = { "E%d" };
+static  const CODE C8   szCmdSync[ ]        = { "AT\r" };
+static  const CODE C8   szCmdECHO[ ]        = { "E" };
 static  const CODE C8   szCmdCGSN[ ]        = { "+CGSN" };
 static  const CODE C8   szCmdCIMI[ ]        = { "+CIMI" };
 static  const CODE C8   szCmdCCID[]         = { "+CCID" };
 
 /// control and status
 static  const CODE C8   szCmdCFUN[ ]        = { "+CFUN" };
-static  const CODE C8   szCmdCCLK[ ]        = { "+CCLK" };
 static  const CODE C8   szCmdCTZU[ ]        = { "+CTZU" };
 
 /// Network service
-static  const CODE C8   szCmdUMNOPROF[ ]    = { "+UMNOPROF" }; 
+static  const CODE C8   szCmdUMNOPROF[ ]    = { "+UMNOPROF" };
 static  const CODE C8   szCmdCSQ[ ]         = { "+CSQ" };
 static  const CODE C8   szCmdCREG[ ]        = { "+CREG" };
+static  const CODE C8   szCmdCEREG[ ]       = { "+CEREG" };
 static  const CODE C8   szCmdCGDCONT[ ]     = { "+CGDCONT" };
-static  const CODE C8   szCmdPPP[ ]         = { "D" };
 static  const CODE C8   szCmdCOPS[ ]        = { "+COPS" };
 
-/// baud rate
-static  const CODE C8   szCmdIPR[ ]         = { "+IPR" };
-
 /// GPIO
 static  const CODE C8   szCmdUGPIOC[ ]      = { "+UGPIOC" };
 
 /// IP
+static  const CODE C8   szCmdUDCONF[ ]      = { "+UDCONF" };
 static  const CODE C8   szCmdUSOCR[ ]       = { "+USOCR" };
 static  const CODE C8   szCmdUSCOL[ ]       = { "+USOCL" };
 static  const CODE C8   szCmdUSOCO[ ]       = { "+USOCO" };
@@ -148,17 +283,13 @@ static  const CODE C8   szCmdUSOWR[ ]       = { "+USOWR" };
 static  const CODE C8   szCmdUSORD[ ]       = { "+USORD" };
 static  const CODE C8   szCmdUSOLI[ ]       = { "+USOLI" };
 
-/// SMS
-static  const CODE C8   szCmdCMGF[ ]        = { "+CMGF" };
-static  const CODE C8   szCmdCMGS[ ]        = { "+CMGS" };
-
-/// location
-static  const CODE C8   szCmdUPGS[ ]        = { "+UGPS" };
-static  const CODE C8   szCmdULOC[ ]        = { "+ULOC" };
-static  const CODE C8   szCmdUGPRMC[ ]      = { "+UGRMC" };
-
 /// MQQT
 
+/// unsolicited result codes
+static  const CODE C8   szUrcUUSORD[ ]      = { "+UUSORD" };
+static  const CODE C8   szUrcUUSORF[ ]      = { "+UUSORF" };
+static  const CODE C8   szUrcUUSOCL[ ]      = { "+UUSOCL" };
+
 /// on/off codes
 static  const CODE C8   szOptOff[ ]         = { "0" };
 static  const CODE C8   szOptOn[ ]          = { "1" };
@@ -169,15 +300,22 @@ static  const CODE C8   szQuery[ ]          = { "?" };
 /// response codes
 static  const CODE C8   szRspOK[ ]          = { "OK" };
 static  const CODE C8   szRspError[ ]       = { "ERROR" };
+static  const CODE C8   szRspCmeError[ ]    = { "+CME ERROR:" };
+static  const CODE C8   szRspCmsError[ ]    = { "+CMS ERROR:" };
 
 /// general format strings
 static  const CODE C8   szFmtStr[ ]         = { "%s" };
-static  const CODE C8   szFmtVal[ ]         = { "%d" };
+static  const CODE C8   szFmtCmd[ ]         = { "%s%s" };
 
 /// argument format strings
 static  const CODE C8   szFmtSngArg[ ]      = { "=%d" };
 static  const CODE C8   szFmtDblArg[ ]      = { "=%d,%d" };
-static  const CODE C8   szFmtCopsArg[ ]     = { "=%d,\"%s\",\"%S\"" };
+static  const CODE C8   szFmtApnArg[ ]      = { "=1,\"%s\",\"%s\"" };
+static  const CODE C8   szFmtConnArg[ ]     = { "=%d,\"%s\",%d" };
+static  const CODE C8   szFmtHexMode[ ]     = { "=1,1" };
+
+/// hex digits
+static  const CODE C8   szHexDigits[ ]      = { "0123456789ABCDEF" };
 
 /// GPIO mapping
 static  const CODE U8   anGpioMode[ LTE_GPIO_MAX ] =
@@ -194,7 +332,46 @@ static  const CODE PC8 apszPdpType[ ]  =
   "IPV6"
 };
 
+/// command definitions
+static  const CODE CMDDEF atCmdDefs[ CMD_ENUM_MAX ] =
+{
+  // basic commands can not be concatenated with a semicolon
+  { szCmdECHO,      RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, TRUE  },
+  // unprefixed responses can only be matched on their own
+  { szCmdCGSN,      RSP_TYPE_BARE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, TRUE  },
+  { szCmdCIMI,      RSP_TYPE_BARE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, TRUE  },
+  { szCmdCCID,      RSP_TYPE_IDENT,     LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCSQ,       RSP_TYPE_CSQ,       LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCREG,      RSP_TYPE_REG,       LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCEREG,     RSP_TYPE_REG,       LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCEREG,     RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdUMNOPROF,  RSP_TYPE_VALUE,     LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdUMNOPROF,  RSP_TYPE_NONE,      UMNOPROF_TIME_MSECS,            FALSE, TRUE  },
+  { szCmdCOPS,      RSP_TYPE_OPER,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCGDCONT,   RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCTZU,      RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdUGPIOC,    RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  { szCmdCFUN,      RSP_TYPE_NONE,      CFUN_TIME_MSECS,                FALSE, TRUE  },
+  { szCmdUDCONF,    RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, TRUE,  TRUE  },
+  // socket commands are not idempotent, never concatenate or resend them
+  { szCmdUSOCR,     RSP_TYPE_SOCKET,    LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, FALSE },
+  { szCmdUSCOL,     RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, FALSE },
+  { szCmdUSOCO,     RSP_TYPE_NONE,      USOCO_TIME_MSECS,               FALSE, FALSE },
+  { szCmdUSOLI,     RSP_TYPE_NONE,      LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, FALSE },
+  { szCmdUSOWR,     RSP_TYPE_SOCKET,    LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, FALSE },
+  { szCmdUSORD,     RSP_TYPE_SOCKREAD,  LTECELLMODEM_CMD_TIMEOUT_MSECS, FALSE, FALSE },
+};
 
+/// unsolicited result code definitions
+static  const CODE URCDEF atUrcDefs[ ] =
+{
+  { szCmdCREG,    RSP_TYPE_REG,       LTE_URC_CREG        },
+  { szCmdCEREG,   RSP_TYPE_REG,       LTE_URC_CEREG       },
+  { szCmdCSQ,     RSP_TYPE_CSQ,       LTE_URC_CSQ         },
+  { szUrcUUSORD,  RSP_TYPE_SOCKDATA,  LTE_URC_SOCKDATA    },
+  { szUrcUUSORF,  RSP_TYPE_SOCKDATA,  LTE_URC_SOCKDATA    },
+  { szUrcUUSOCL,  RSP_TYPE_SOCKET,    LTE_URC_SOCKCLOSED  },
+};
 
 /******************************************************************************
  * @function LTECellModem_Intialize
@@ -208,12 +385,23 @@ void LTECellModem_Intialize( void )
 {
   // call the local initialization
   LTECellModem_LocalInitialize( );
-  
+
   // set the state
   eCtlState = CTL_STATE_PWRUP;
 
   // clear the buffer indices
   wXmitBufIdx = wRecvBufIdx = 0;
+  bRecvOverflow = FALSE;
+
+  // clear the queue/callback
+  nQueueHead = nQueueCount = nInFlight = 0;
+  pvUrcCallback = NULL;
+
+  // build the URC table
+  BuildUrcTable( );
+
+  // socket data is exchanged in hex, queue the mode select, this also starts the power up
+  EnqueueCommand( CMD_ENUM_UDCONF, ( PC8 )szFmtHexMode, NULL, 0, NULL );
 }
 
 /******************************************************************************
@@ -221,196 +409,41 @@ void LTECellModem_Intialize( void )
  *
  * @brief process character task
  *
- * This function will process the incoming character
+ * This function will process the incoming character, assembling lines and
+ * processing each complete line
  *
  * @param[in]   nChar   character to process
  *
  *****************************************************************************/
 void LTECellModem_CharProcess( U8 nChar )
 {
-  // process the state
-  switch( eDecState )
+  // check for a line terminator
+  if (( CH_CR == nChar ) || ( CH_LF == nChar ))
   {
-    case DEC_STATE_CR1 :
-      if ( CH_CR == nChar )
-      {
-        // go to LF1
-        eDecState = DEC_STATE_LF1;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_LF1 :
-      if ( CH_LF == nChar )
-      {
-        // go to RSP
-        eDecState = DEC_STATE_RSP;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_RSP :
-      // check for the terminating carriage return
-      if ( CH_CR == nChar )
-      {
-        // terminate the receive buffer
-        anRecvBuffer[ wRecvBufIdx - 1 ] = '\0';
-
-        // goto LF2
-        eDecState = DEC_STATE_LF2;
-      }
-      else if ( *( pszExpectedResult + wRespBufIdx ) == nChar )
-      {
-        // add to receive buffer
-        anRecvBuffer[ wRecvBufIdx++ ] = nChar;
-
-        // increment the response index
-        wRespBufIdx++;
-      }
-      else if ( szRspError[ wRespBufIdx ] == nChar )
-      {
-        // add to receive buffer
-        anRecvBuffer[ wRecvBufIdx++ ] = nChar;
-
-        // increment the response index
-        wRespBufIdx++;
-
-        // go to error
-        eDecState = DEC_STATE_ERR;
-      }
-      break;
-
-    case DEC_STATE_ERR :
-      // check for the terminating carriage return
-      if ( CH_CR == nChar )
-      {
-        // goto LF4
-        eDecState = DEC_STATE_LF4;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_OK1 :
-      if ( szRspOK[ 0 ] == nChar )
-      {
-        // go to OK2
-        eDecState = DEC_STATE_OK2;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_OK2 :
-      if ( szRspOK[ 1 ] == nChar )
-      {
-        // go to CR4
-        eDecState = DEC_STATE_CR4;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_CR2 :
-      if ( CH_CR == nChar )
-      {
-        // go to LF1
-        eDecState = DEC_STATE_LF2;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_LF2 :
-      if ( CH_LF == nChar )
-      {
-        // go to RSP
-        eDecState = DEC_STATE_CR3;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_CR3 :
-      if ( CH_CR == nChar )
-      {
-        // go to LF1
-        eDecState = DEC_STATE_LF3;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_LF3 :
-      if ( CH_LF == nChar )
-      {
-        // go to OK1
-        eDecState = DEC_STATE_OK1;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_CR4 :
-      if ( CH_CR == nChar )
-      {
-        // go to LF1
-        eDecState = DEC_STATE_LF4;
-      }
-      else
-      {
-        // go to error
-        eDecState = DEC_STATE_FLS;
-      }
-      break;
-
-    case DEC_STATE_LF4 :
-      if ( CH_LF == nChar )
-      {
-        // in all cases - post a message received event
-        LTECellModem_PostCtrlEvent( LTE_LCLEVENT_RCVMSG );
-      }
-      else
+    // ignore empty lines
+    if ( wRecvBufIdx != 0 )
+    {
+      // terminate the line/process it unless it overflowed
+      acRecvBuffer[ wRecvBufIdx ] = '\0';
+      if ( !bRecvOverflow )
       {
-        // go to error
-        eDecState = DEC_STATE_FLS;
+        ProcessLine( );
       }
-      break;
-
-    case DEC_STATE_FLS :
-      break;
 
-    default :
-      break;
+      // reset the line
+      wRecvBufIdx = 0;
+      bRecvOverflow = FALSE;
+    }
+  }
+  else if ( wRecvBufIdx < ( RECV_BUF_SIZE - 1 ))
+  {
+    // add to receive buffer
+    acRecvBuffer[ wRecvBufIdx++ ] = ( C8 )nChar;
+  }
+  else
+  {
+    // flag the overflow
+    bRecvOverflow = TRUE;
   }
 }
 
@@ -421,7 +454,7 @@ void LTECellModem_CharProcess( U8 nChar )
  *
  * This function will process the control event
  *
- * @param[in]   eEvent  event 
+ * @param[in]   eEvent  event
  *
  *****************************************************************************/
 void LTECellModem_CtrlProcess( LTELCLEVENT eEvent )
@@ -437,11 +470,22 @@ void LTECellModem_CtrlProcess( LTELCLEVENT eEvent )
       break;
 
     case CTL_STATE_PWRDLY :
-      // if this is a timeout - reset the 
+      // if this is a timeout - release the power control and probe the modem
       if ( LTE_LCLEVENT_TIMEOUT == eEvent )
       {
         LTECellModem_PowerControl( OFF );
-        eCtlState = CTL_STATE_IDLE;
+        eCtlState = CTL_STATE_SYNC;
+        LTECellModem_Write(( PC8 )szCmdSync, STRLEN_P( szCmdSync ));
+        LTECellModem_StartStopTime( SYNC_PROBE_TIME_MSECS );
+      }
+      break;
+
+    case CTL_STATE_SYNC :
+      // probe again until the modem answers
+      if ( LTE_LCLEVENT_TIMEOUT == eEvent )
+      {
+        LTECellModem_Write(( PC8 )szCmdSync, STRLEN_P( szCmdSync ));
+        LTECellModem_StartStopTime( SYNC_PROBE_TIME_MSECS );
       }
       break;
 
@@ -449,36 +493,32 @@ void LTECellModem_CtrlProcess( LTELCLEVENT eEvent )
       // check for a message request
       if ( LTE_LCLEVENT_XMTMSG == eEvent )
       {
-        // send it/start timer/goto wait state
-        LTECellModem_Write( anXmitBuffer, wXmitBufIdx );
-        LTECellModem_StartStopTime( XMIT_MSG_TIME_MSECS );
-        eCtlState = CTL_STATE_WAIT;
+        // send the next line
+        DispatchCommands( );
       }
       break;
 
     case CTL_STATE_WAIT :
-      // determine the event
-      switch( eEvent )
+      // check for a timeout
+      if ( LTE_LCLEVENT_TIMEOUT == eEvent )
       {
-        case LTE_LCLEVENT_RCVMSG :
-          // stop the timer
-          LTECellModem_StartStopTime( 0 );
-
-          // parse the buffer
-          ParseResponse( );
-          break;
-
-        case TASK_TIMEOUT_EVENT :
-          // message timeout
-          if ( pvCurCallback != NULL )
+        // complete a single command out of retries, otherwise resend
+        if (( nInFlight == 1 ) && ( atCmdQueue[ nQueueHead ].nRetries == 0 ))
+        {
+          CompleteCommands( LTE_ERR_TIMEOUT, 0 );
+        }
+        else
+        {
+          // use a retry on a single command
+          if ( nInFlight == 1 )
           {
-            // call the callback
-            pvCurCallback( LTE_ERR_TIMEOUT, NULL );
+            atCmdQueue[ nQueueHead ].nRetries--;
           }
-          break;
 
-        default :
-          break;
+          // requeue/resend
+          RequeueCommands( );
+          DispatchCommands( );
+        }
       }
       break;
 
@@ -489,101 +529,94 @@ void LTECellModem_CtrlProcess( LTELCLEVENT eEvent )
 }
 
 /******************************************************************************
- * @function LteCellModem_EchoControl
+ * @function LTECellModem_EchoControl
  *
  * @brief turn on/off the echo on the modem
  *
- * This function will ping and determine if the modem is there
+ * This function will queue the echo control command
  *
  * @param[in]   bState        state of the echo
  * @param[in]   pvCallback    pointer to the callback function
  *
+ * @return      apropriate error
+ *
  *****************************************************************************/
-void LteCellModem_EchoControlOff( BOOL bState, PVLTECALLBACK pvCallback )
+LTEERR LTECellModem_EchoControl( BOOL bState, PVLTECALLBACK pvCallback )
 {
-  C8    acLclBuffer[ 2 ];
-
-  // create the option
-  SPRINTF_P( acLclBuffer, ( PCC8 )szFmtVal, bState );
-  
-  // send the command
-  SendCommand( szCmdECHO, acLclBuffer, szRspOK, TRUE, pvCallback );
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_ECHO, ( PC8 )(( bState ) ? szOptOn : szOptOff ), NULL, 0, pvCallback ));
 }
 
-
 /******************************************************************************
  * @function LTECellModem_SendRequest
  *
  * @brief send a request for data
  *
- * This function will send a request for data, register the callback
+ * This function will queue a request for data, the callback is passed the
+ * parsed response
  *
  * @param[in]   eRequest    request enumeration
  * @param[in]   pvCallback  pointer to the callback
  *
- * @return      apropriate error 
+ * @return      apropriate error
  *
  *****************************************************************************/
 LTEERR LTECellModem_SendRequest( LTEREQUEST eRequest, PVLTECALLBACK pvCallback )
 {
   LTEERR  eError = LTE_ERR_NONE;
-  PCC8    pszCommand;
+  CMDENUM eCmd = CMD_ENUM_MAX;
   PCC8    pszOption = NULL;
 
-  // check for a command in progress
-  if ( CTL_STATE_IDLE != eCtlState )
+  // now get the command
+  switch( eRequest )
   {
-    // set the error
-    eError = LTE_ERR_BUSY;
+    case LTE_REQUEST_CREG :
+      eCmd = CMD_ENUM_CREG;
+      pszOption = szQuery;
+      break;
+
+    case LTE_REQUEST_CGSN :
+      eCmd = CMD_ENUM_CGSN;
+      break;
+
+    case LTE_REQUEST_CIMI :
+      eCmd = CMD_ENUM_CIMI;
+      break;
+
+    case LTE_REQUEST_CCID :
+      eCmd = CMD_ENUM_CCID;
+      break;
+
+    case LTE_REQUEST_CSQ :
+      eCmd = CMD_ENUM_CSQ;
+      break;
+
+    case LTE_REQUEST_MNO :
+      eCmd = CMD_ENUM_UMNOPROF;
+      pszOption = szQuery;
+      break;
+
+    case LTE_REQUEST_APN :
+      eCmd = CMD_ENUM_COPS;
+      pszOption = szQuery;
+      break;
+
+    case LTE_REQUEST_CEREG :
+      eCmd = CMD_ENUM_CEREG;
+      pszOption = szQuery;
+      break;
+
+    default :
+      // error
+      eError = LTE_ERR_ILLREQUEST;
+      break;
   }
-  else
-  {
-    // now get the command
-    switch( eRequest )
-    {
-      case LTE_REQUEST_CREG :
-        pszCommand = szCmdCREG;
-        break;
-
-      case LTE_REQUEST_CGSN :
-        pszCommand = szCmdCGSN;
-        break;
-
-      case LTE_REQUEST_CIMI :
-        pszCommand = szCmdCIMI;
-        break;
-
-      case LTE_REQUEST_CCID :
-        pszCommand = szCmdCCID;
-        break;
-
-      case LTE_REQUEST_CSQ :
-        pszCommand = szCmdCSQ;
-        break;
-
-      case LTE_REQUEST_MNO :
-        pszCommand = szCmdUMNOPROF;
-        pszOption = szQuery;
-        break;
-
-      case LTE_REQUEST_APN :
-        pszCommand = szCmdCOPS;
-        pszOption = szQuery;
-        break;
-
-      default :
-        // error
-        eError = LTE_ERR_ILLREQUEST;
-        pszCommand = NULL;
-        break;
-    }
 
-    // now check for valid command
-    if ( NULL != pszCommand )
-    {
-      // send the command
-      SendCommand( pszCommand, ( PC8 )pszOption, szRspOK, TRUE, pvCallback );
-    }
+  // now check for valid command
+  if ( CMD_ENUM_MAX != eCmd )
+  {
+    // queue the command
+    eError = EnqueueCommand( eCmd, ( PC8 )pszOption, NULL, 0, pvCallback );
   }
 
   // return the error
@@ -600,22 +633,18 @@ LTEERR LTECellModem_SendRequest( LTEREQUEST eRequest, PVLTECALLBACK pvCallback )
  * @param[in]   eMno      MNO selection
  * @param[in]   pvCallback  pointer to the callback
  *
- * @return      apropriate error 
+ * @return      apropriate error
  *
  *****************************************************************************/
 LTEERR LTECellModem_SetOperator( LTEMNO eMno, PVLTECALLBACK pvCallback )
 {
-  LTEERR  eError = LTE_ERR_NONE;
-  C8      acArgument[ 8 ];
+  C8      acArgument[ CMD_ARGS_SIZE ];
 
   // format the option
   SPRINTF_P( acArgument, ( PCC8 )szFmtSngArg, eMno );
 
-  // send the command
-  SendCommand( szCmdUMNOPROF, acArgument, szRspOK, TRUE, pvCallback );
-
-  // return the error
-  return( eError );
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_UMNOPROFSET, acArgument, NULL, 0, pvCallback ));
 }
 
 /******************************************************************************
@@ -623,24 +652,29 @@ LTEERR LTECellModem_SetOperator( LTEMNO eMno, PVLTECALLBACK pvCallback )
  *
  * @brief set the APN
  *
- * This function will set the APN
+ * This function will set the APN of the first PDP context
  *
- * @param[in]   pszOperator pointer to the operator
+ * @param[in]   pszOperator pointer to the APN
+ * @param[in]   ePdp        PDP type
  * @param[in]   pvCallback  pointer to the callback
  *
- * @return      apropriate error 
+ * @return      apropriate error
  *
  *****************************************************************************/
 LTEERR LTECellModem_SetAPN( PC8 pszOperator, LTEPDP ePdp, PVLTECALLBACK pvCallback )
 {
-  LTEERR  eError = LTE_ERR_NONE;
-  C8      acArgument[ 24 ];
+  LTEERR  eError = LTE_ERR_ILLREQUEST;
+  C8      acArgument[ CMD_ARGS_SIZE ];
 
-  // format the option
-  SPRINTF_P( acArgument, szFmtCopsArg, 1, ( PC8 )apszPdpType[ ePdp ], pszOperator );
+  // validate the arguments
+  if (( ePdp < LTE_PDP_MAX ) && ( STRLEN_P( pszOperator ) <= MAX_STRARG_LEN ))
+  {
+    // format the option
+    SPRINTF_P( acArgument, ( PCC8 )szFmtApnArg, ( PC8 )apszPdpType[ ePdp ], pszOperator );
 
-  // send the command
-  SendCommand( szCmdCOPS, acArgument, szRspOK, TRUE, pvCallback );
+    // queue the command
+    eError = EnqueueCommand( CMD_ENUM_CGDCONT, acArgument, NULL, 0, pvCallback );
+  }
 
   // return the error
   return( eError );
@@ -662,22 +696,17 @@ LTEERR LTECellModem_SetAPN( PC8 pszOperator, LTEPDP ePdp, PVLTECALLBACK pvCallba
  *****************************************************************************/
 LTEERR LTECellModem_SetGpio( LTEGPIO eGpioEnum, LTEGPIOMODE eGpioMode, PVLTECALLBACK pvCallback )
 {
-  LTEERR  eError = LTE_ERR_NONE;
-  C8      acArguments[ 8 ];
-  
+  LTEERR  eError = LTE_ERR_ILLGPIOENUM;
+  C8      acArguments[ CMD_ARGS_SIZE ];
+
   // test for valid enum
   if ( eGpioEnum < LTE_GPIO_MAX )
   {
     // create the option
-    SPRINTF_P( acArguments, szFmtDblArg, eGpioEnum, eGpioMode );
-    
-    // send the command
-    SendCommand( szCmdUGPIOC, acArguments, szRspOK, TRUE, pvCallback );
-  }
-  else
-  {
-    // set the error
-    eError = LTE_ERR_ILLGPIOENUM;
+    SPRINTF_P( acArguments, ( PCC8 )szFmtDblArg, anGpioMode[ eGpioEnum ], eGpioMode );
+
+    // queue the command
+    eError = EnqueueCommand( CMD_ENUM_UGPIOC, acArguments, NULL, 0, pvCallback );
   }
 
   // return the error
@@ -685,7 +714,7 @@ LTEERR LTECellModem_SetGpio( LTEGPIO eGpioEnum, LTEGPIOMODE eGpioMode, PVLTECALL
 }
 
 /******************************************************************************
- * @function LteCellModem_SetAutoTimeZone
+ * @function LTECellModem_SetAutoTimeZone
  *
  * @brief enable/disable the auto time zone
  *
@@ -694,237 +723,1076 @@ LTEERR LTECellModem_SetGpio( LTEGPIO eGpioEnum, LTEGPIOMODE eGpioMode, PVLTECALL
  * @param[in]   bState        auto time zone state
  * @param[in]   pvCallback    pointer to the callback function
  *
+ * @return      appropriate error
+ *
  *****************************************************************************/
-LTEERR LteCellModem_SetAutoTimeZone( BOOL bState, PVLTECALLBACK pvCallback )
+LTEERR LTECellModem_SetAutoTimeZone( BOOL bState, PVLTECALLBACK pvCallback )
 {
-  LTEERR  eError = LTE_ERR_NONE;
-  C8      acArguments[ 8 ];
+  C8      acArguments[ CMD_ARGS_SIZE ];
 
   // create the option
   SPRINTF_P( acArguments, ( PCC8 )szFmtSngArg, bState );
-  
-  // send the command
-  SendCommand( szCmdCTZU, acArguments, szRspOK, TRUE, pvCallback );
 
-  // return the error
-  return( eError );
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_CTZU, acArguments, NULL, 0, pvCallback ));
 }
 
 /******************************************************************************
- * @function SendCommand
+ * @function LTECellModem_SetRegistrationUrc
  *
- * @brief send a command
+ * @brief set the EPS registration URC mode
  *
- * This function will stuff the transmit buffer and send the command
+ * This function will select the +CEREG unsolicited result code mode, 1
+ * reports the state, 2 adds the location
  *
- * @param[in]   pszCommand    pointer to the command
- * @param[in]   pszOption     pointer to the option
- * @param[in]   pszExpected   pointer to the expected result
- * @param[in]   bSendAT       send an AT also
+ * @param[in]   nMode         URC mode
  * @param[in]   pvCallback    pointer to the callback function
  *
+ * @return      appropriate error
+ *
  *****************************************************************************/
-static void SendCommand( PCC8 pszCommand, PC8 pszOption, PCC8 pszExpected, BOOL bSendAT, PVLTECALLBACK pvCallback )
+LTEERR LTECellModem_SetRegistrationUrc( U8 nMode, PVLTECALLBACK pvCallback )
 {
-  // store the callback/result
-  pvCurCallback = pvCallback;
-  pszExpectedResult = pszExpected;
+  C8      acArguments[ CMD_ARGS_SIZE ];
 
-  // clear the index
-  wXmitBufIdx = 0;
-  wRecvBufIdx = 0;
-  wRespBufIdx = 0;
+  // create the option
+  SPRINTF_P( acArguments, ( PCC8 )szFmtSngArg, nMode );
 
-  // set the decode state
-  eDecState = DEC_STATE_CR1;
-  
-  // check for send AT
-  if ( bSendAT )
-  {
-    // stuff in buffer
-    wXmitBufIdx = SPRINTF_P( anXmitBuffer, ( PCC8 )szFmtStr, ( PCC8 )szCmdAT );
-  }
-  
-  // now stuff command
-  wXmitBufIdx += SPRINTF_P( &anXmitBuffer[ wXmitBufIdx ], ( PCC8 )szFmtStr, pszCommand );
-  
-  // check for option
-  if ( NULL != pszOption )
-  {
-    // now stuff option
-    wXmitBufIdx += SPRINTF_P( &anXmitBuffer[ wXmitBufIdx ], ( PCC8 )szFmtStr, pszOption );
-  }
-  
-  // terminate it
-  anXmitBuffer[ wXmitBufIdx++ ] = '\r';
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_CEREGSET, acArguments, NULL, 0, pvCallback ));
+}
+
+/******************************************************************************
+ * @function LTECellModem_SetFunction
+ *
+ * @brief set the modem functionality
+ *
+ * This function will set the modem functionality, 1 enables the radio
+ *
+ * @param[in]   nFunction     functionality level
+ * @param[in]   pvCallback    pointer to the callback function
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+LTEERR LTECellModem_SetFunction( U8 nFunction, PVLTECALLBACK pvCallback )
+{
+  C8      acArguments[ CMD_ARGS_SIZE ];
+
+  // create the option
+  SPRINTF_P( acArguments, ( PCC8 )szFmtSngArg, nFunction );
 
-  // post the message
-  LTECellModem_PostCtrlEvent( LTE_LCLEVENT_XMTMSG );
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_CFUN, acArguments, NULL, 0, pvCallback ));
 }
 
 /******************************************************************************
- * @function ParseResponse
+ * @function LTECellModem_SocketOpen
+ *
+ * @brief open a socket
  *
- * @brief parse the response
+ * This function will create a socket, the callback is passed an LTESOCKET
+ * with the socket number
+ *
+ * @param[in]   eProtocol     protocol
+ * @param[in]   wLocalPort    local port, 0 for any
+ * @param[in]   pvCallback    pointer to the callback function
  *
- * This function will parse the response
+ * @return      appropriate error
  *
  *****************************************************************************/
-static void ParseResponse( void )
+LTEERR LTECellModem_SocketOpen( LTESKTPROT eProtocol, U16 wLocalPort, PVLTECALLBACK pvCallback )
 {
-  LTEERR  eError = LTE_ERR_NONE;
-  PVOID   pvRetValue = NULL;
+  C8      acArguments[ CMD_ARGS_SIZE ];
 
-  // determine the response
-  if ( STRNCMP_P( szRspOK, anRecvBuffer, STRLEN_P( szRspOK )) == 0 )
-  {
-    // set the error
-    eError = LTE_ERR_NONE;
-  }
-  else if ( STRNCMP_P( szRspError, anRecvBuffer, STRLEN_P( szRspError )) == 0 )
+  // create the option
+  if ( wLocalPort == 0 )
   {
-    // set the error
-    eError = LTE_ERR_ERROR;
+    SPRINTF_P( acArguments, ( PCC8 )szFmtSngArg, eProtocol );
   }
   else
   {
-    // special processing
-    pvRetValue = ParseResponseValue( );
+    SPRINTF_P( acArguments, ( PCC8 )szFmtDblArg, eProtocol, wLocalPort );
   }
 
-  // process the callback if not null
-  if ( pvCurCallback != NULL )
-  {
-    pvCurCallback( eError, pvRetValue );
-  }
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_USOCR, acArguments, NULL, 0, pvCallback ));
 }
- 
+
 /******************************************************************************
- * @function ParseResponseValue
+ * @function LTECellModem_SocketClose
  *
- * @brief prase the returned message for content
+ * @brief close a socket
+ *
+ * This function will close a socket
  *
- * This function will parse the content of the returned message
+ * @param[in]   cSocket       socket number
+ * @param[in]   pvCallback    pointer to the callback function
  *
- * @return      pointer to the parsed content
+ * @return      appropriate error
  *
  *****************************************************************************/
-static PVOID ParseResponseValue( void )
+LTEERR LTECellModem_SocketClose( S8 cSocket, PVLTECALLBACK pvCallback )
 {
-  PVOID pvRetValue = NULL;
+  C8      acArguments[ CMD_ARGS_SIZE ];
+
+  // create the option
+  SPRINTF_P( acArguments, ( PCC8 )szFmtSngArg, cSocket );
 
-  return( pvRetValue );
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_USOCL, acArguments, NULL, 0, pvCallback ));
 }
 
 /******************************************************************************
- * @function 
+ * @function LTECellModem_SocketConnect
  *
- * @brief 
+ * @brief connect a socket
  *
- * This function 
+ * This function will connect a socket to a remote address
  *
- * @param[in]   
+ * @param[in]   cSocket       socket number
+ * @param[in]   pszAddress    pointer to the remote address
+ * @param[in]   wPort         remote port
+ * @param[in]   pvCallback    pointer to the callback function
  *
- * @return      
+ * @return      appropriate error
  *
  *****************************************************************************/
+LTEERR LTECellModem_SocketConnect( S8 cSocket, PCC8 pszAddress, U16 wPort, PVLTECALLBACK pvCallback )
+{
+  LTEERR  eError = LTE_ERR_ILLREQUEST;
+  C8      acArguments[ CMD_ARGS_SIZE ];
+
+  // validate the address
+  if ( STRLEN_P( pszAddress ) <= MAX_STRARG_LEN )
+  {
+    // create the option
+    SPRINTF_P( acArguments, ( PCC8 )szFmtConnArg, cSocket, pszAddress, wPort );
+
+    // queue the command
+    eError = EnqueueCommand( CMD_ENUM_USOCO, acArguments, NULL, 0, pvCallback );
+  }
+
+  // return the error
+  return( eError );
+}
+
 /******************************************************************************
- * @function 
+ * @function LTECellModem_SocketListen
  *
- * @brief 
+ * @brief listen on a socket
  *
- * This function 
+ * This function will set a socket listening on a port
  *
- * @param[in]   
+ * @param[in]   cSocket       socket number
+ * @param[in]   wPort         port
+ * @param[in]   pvCallback    pointer to the callback function
  *
- * @return      
+ * @return      appropriate error
  *
  *****************************************************************************/
+LTEERR LTECellModem_SocketListen( S8 cSocket, U16 wPort, PVLTECALLBACK pvCallback )
+{
+  C8      acArguments[ CMD_ARGS_SIZE ];
 
-///******************************************************************************
-// * @function LTECellModem_GetGpio
-// *
-// * @brief wet the gpio
-// *
-// * This function will get the GPIO to a givenfunction
-// *
-// * @param[in]   eGpioEnum     desried GPIO enumeration
-// * @param[in]   eGpioMode     desired GPIO mode
-// * @param[in]   pvCallback    pointer to the callback function
-// *
-// * @return      appropriate error
-// *
-// *****************************************************************************/
-//LTEERR LTECellModem_GetGpio( LTEGPIO eGpioEnum, PLTEGPIOMODE peGpioMode, PVLTECALLBACK pvCallback )
-//{
-//  LTEERR eError = LTE_ERR_NONE;
+  // create the option
+  SPRINTF_P( acArguments, ( PCC8 )szFmtDblArg, cSocket, wPort );
 
-//  // save the callback
-//  pvCurCallback = pvCallback;
+  // queue the command
+  return( EnqueueCommand( CMD_ENUM_USOLI, acArguments, NULL, 0, pvCallback ));
+}
 
-//  // test for valid enum
-//  if ( eGpioEnum < LTE_GPIO_MAX )
-//  {
-//  }
-//  else
-//  {
-//    // set the error
-//    eError = LTE_ERR_ILLGPIOENUM;
-//  }
+/******************************************************************************
+ * @function LTECellModem_SocketRead
+ *
+ * @brief read from a socket
+ *
+ * This function will queue a socket read, the callback is passed an
+ * LTESOCKDATA pointing to the buffer, which must remain valid until then
+ *
+ * @param[in]   cSocket       socket number
+ * @param[in]   pnBuffer      pointer to the buffer
+ * @param[in]   wLength       length to read
+ * @param[in]   pvCallback    pointer to the callback function
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+LTEERR LTECellModem_SocketRead( S8 cSocket, PU8 pnBuffer, U16 wLength, PVLTECALLBACK pvCallback )
+{
+  LTEERR  eError = LTE_ERR_ILLREQUEST;
+  C8      acArguments[ CMD_ARGS_SIZE ];
 
-//  // return the error
-//  return( eError );
-//}
+  // validate the length
+  if (( wLength != 0 ) && ( wLength <= MAX_SOCK_XFER ))
+  {
+    // create the option
+    SPRINTF_P( acArguments, ( PCC8 )szFmtDblArg, cSocket, wLength );
+
+    // queue the command
+    eError = EnqueueCommand( CMD_ENUM_USORD, acArguments, pnBuffer, wLength, pvCallback );
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function LTECellModem_SocketWrite
+ *
+ * @brief write to a socket
+ *
+ * This function will queue a socket write, the buffer must remain valid
+ * until the callback
+ *
+ * @param[in]   cSocket       socket number
+ * @param[in]   pnBuffer      pointer to the buffer
+ * @param[in]   wLength       length to write
+ * @param[in]   pvCallback    pointer to the callback function
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+LTEERR LTECellModem_SocketWrite( S8 cSocket, PU8 pnBuffer, U16 wLength, PVLTECALLBACK pvCallback )
+{
+  LTEERR  eError = LTE_ERR_ILLREQUEST;
+  C8      acArguments[ CMD_ARGS_SIZE ];
+
+  // validate the length
+  if (( wLength != 0 ) && ( wLength <= MAX_SOCK_XFER ))
+  {
+    // create the option
+    SPRINTF_P( acArguments, ( PCC8 )szFmtDblArg, cSocket, wLength );
+
+    // queue the command
+    eError = EnqueueCommand( CMD_ENUM_USOWR, acArguments, pnBuffer, wLength, pvCallback );
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function LTECellModem_SetUrcCallback
+ *
+ * @brief set the URC callback
+ *
+ * This function will set the callback for the unsolicited result codes
+ *
+ * @param[in]   pvCallback    pointer to the callback function
+ *
+ *****************************************************************************/
+void LTECellModem_SetUrcCallback( PVLTEURCCALLBACK pvCallback )
+{
+  // store it
+  pvUrcCallback = pvCallback;
+}
+
+/******************************************************************************
+ * @function LTECellModem_GetQueueCount
+ *
+ * @brief get the queue count
+ *
+ * This function will return the number of commands queued or in flight
+ *
+ * @return      number of commands
+ *
+ *****************************************************************************/
+U8 LTECellModem_GetQueueCount( void )
+{
+  // return the count
+  return( nQueueCount );
+}
+
+/******************************************************************************
+ * @function EnqueueCommand
+ *
+ * @brief queue a command
+ *
+ * This function will add a command to the end of the queue and kick the
+ * control task if the queue was empty
+ *
+ * @param[in]   eCmd          command
+ * @param[in]   pcArgs        pointer to the arguments, NULL for none
+ * @param[in]   pnData        pointer to the socket data
+ * @param[in]   wDataLength   socket data length
+ * @param[in]   pvCallback    pointer to the callback function
+ *
+ * @return      LTE_ERR_BUSY if the queue is full
+ *
+ *****************************************************************************/
+static LTEERR EnqueueCommand( CMDENUM eCmd, PC8 pcArgs, PU8 pnData, U16 wDataLength, PVLTECALLBACK pvCallback )
+{
+  LTEERR    eError = LTE_ERR_BUSY;
+  PCMDENTRY ptEntry;
+
+  // check for room
+  if ( nQueueCount < LTECELLMODEM_CMDQUEUE_SIZE )
+  {
+    // fill the tail entry
+    ptEntry = &atCmdQueue[ ( nQueueHead + nQueueCount ) % LTECELLMODEM_CMDQUEUE_SIZE ];
+    ptEntry->eCmd = eCmd;
+    CopyString( ptEntry->acArgs, ( pcArgs != NULL ) ? pcArgs : "", CMD_ARGS_SIZE );
+    ptEntry->pnData = pnData;
+    ptEntry->wDataLength = wDataLength;
+    ptEntry->pvCallback = pvCallback;
+    ptEntry->nRetries = ( atCmdDefs[ eCmd ].bRetry ) ? LTECELLMODEM_CMD_RETRIES : 0;
+    ptEntry->bSingle = FALSE;
+    ptEntry->bInfo = FALSE;
+
+    // kick the control task if this is the only entry
+    if ( ++nQueueCount == 1 )
+    {
+      LTECellModem_PostCtrlEvent( LTE_LCLEVENT_XMTMSG );
+    }
+
+    // clear the error
+    eError = LTE_ERR_NONE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function DispatchCommands
+ *
+ * @brief send the next command line
+ *
+ * This function will build a command line from the head of the queue,
+ * concatenating batchable commands, send it and start the timer
+ *
+ *****************************************************************************/
+static void DispatchCommands( void )
+{
+  PCMDENTRY ptEntry;
+  PCMDDEF   ptDef;
+  U16       wTimeoutMsecs = 0;
+  U16       wIdx;
+
+  // only when idle with commands waiting
+  if (( CTL_STATE_IDLE == eCtlState ) && ( nQueueCount != 0 ))
+  {
+    // start the line
+    wXmitBufIdx = SPRINTF_P( acXmitBuffer, ( PCC8 )szFmtStr, ( PCC8 )szCmdAT );
+    nInFlight = 0;
+
+    do
+    {
+      // get the entry/definition
+      ptEntry = &atCmdQueue[ ( nQueueHead + nInFlight ) % LTECELLMODEM_CMDQUEUE_SIZE ];
+      ptDef = ( PCMDDEF )&atCmdDefs[ ptEntry->eCmd ];
+
+      // separate concatenated commands
+      if ( nInFlight != 0 )
+      {
+        acXmitBuffer[ wXmitBufIdx++ ] = CH_SEMI;
+      }
+
+      // stuff the command/arguments
+      wXmitBufIdx += SPRINTF_P( &acXmitBuffer[ wXmitBufIdx ], ( PCC8 )szFmtCmd, ptDef->pszCommand, ptEntry->acArgs );
+
+      // append the hex encoded write data
+      if ( CMD_ENUM_USOWR == ptEntry->eCmd )
+      {
+        acXmitBuffer[ wXmitBufIdx++ ] = CH_COMMA;
+        acXmitBuffer[ wXmitBufIdx++ ] = CH_QUOTE;
+        for ( wIdx = 0; wIdx < ptEntry->wDataLength; wIdx++ )
+        {
+          acXmitBuffer[ wXmitBufIdx++ ] = szHexDigits[ *( ptEntry->pnData + wIdx ) >> 4 ];
+          acXmitBuffer[ wXmitBufIdx++ ] = szHexDigits[ *( ptEntry->pnData + wIdx ) & 0x0F ];
+        }
+        acXmitBuffer[ wXmitBufIdx++ ] = CH_QUOTE;
+      }
+
+      // clear the info flag/accumulate the timeout
+      ptEntry->bInfo = FALSE;
+      wTimeoutMsecs += ptDef->wTimeoutMsecs;
+      nInFlight++;
+    } while ( CanBatch( ));
+
+    // terminate it/send it/start the timer
+    acXmitBuffer[ wXmitBufIdx++ ] = CH_CR;
+    eCtlState = CTL_STATE_WAIT;
+    LTECellModem_Write( acXmitBuffer, wXmitBufIdx );
+    LTECellModem_StartStopTime( wTimeoutMsecs );
+  }
+}
+
+/******************************************************************************
+ * @function CanBatch
+ *
+ * @brief test if the next queued command can join the line
+ *
+ * This function will determine if the next queued command can be
+ * concatenated on the current command line
+ *
+ * @return      TRUE if it can
+ *
+ *****************************************************************************/
+static BOOL CanBatch( void )
+{
+  BOOL      bResult = FALSE;
+  PCMDENTRY ptFirst;
+  PCMDENTRY ptNext;
+  U16       wLength;
+  U8        nIdx;
+
+  // check for room in the batch
+  if (( nInFlight < LTECELLMODEM_BATCH_MAX ) && ( nInFlight < nQueueCount ))
+  {
+    // get the first and next entries
+    ptFirst = &atCmdQueue[ nQueueHead ];
+    ptNext = &atCmdQueue[ ( nQueueHead + nInFlight ) % LTECELLMODEM_CMDQUEUE_SIZE ];
+
+    // both must be batchable and the line must fit, separator and terminator
+    wLength = STRLEN_P( atCmdDefs[ ptNext->eCmd ].pszCommand ) + STRLEN_P( ptNext->acArgs ) + 2;
+    bResult = ( atCmdDefs[ ptFirst->eCmd ].bBatchable && !ptFirst->bSingle &&
+                atCmdDefs[ ptNext->eCmd ].bBatchable && !ptNext->bSingle &&
+                (( wXmitBufIdx + wLength ) < XMIT_BUF_SIZE ));
+
+    // a repeated command would make its response ambiguous
+    for ( nIdx = 0; ( bResult ) && ( nIdx < nInFlight ); nIdx++ )
+    {
+      if ( atCmdQueue[ ( nQueueHead + nIdx ) % LTECELLMODEM_CMDQUEUE_SIZE ].eCmd == ptNext->eCmd )
+      {
+        bResult = FALSE;
+      }
+    }
+  }
+
+  // return the result
+  return( bResult );
+}
+
+/******************************************************************************
+ * @function RequeueCommands
+ *
+ * @brief return the commands in flight to the queue
+ *
+ * This function will return the commands in flight to the head of the queue
+ * for resending, a concatenated line stops at the failing command so its
+ * members are resent on their own lines
+ *
+ *****************************************************************************/
+static void RequeueCommands( void )
+{
+  U8  nIdx;
+
+  // split a batch
+  if ( nInFlight > 1 )
+  {
+    for ( nIdx = 0; nIdx < nInFlight; nIdx++ )
+    {
+      atCmdQueue[ ( nQueueHead + nIdx ) % LTECELLMODEM_CMDQUEUE_SIZE ].bSingle = TRUE;
+    }
+  }
+
+  // back to idle
+  nInFlight = 0;
+  eCtlState = CTL_STATE_IDLE;
+}
+
+/******************************************************************************
+ * @function CompleteCommands
+ *
+ * @brief complete the commands in flight
+ *
+ * This function will complete the commands in flight on a final result code
+ * or timeout, calling the callbacks, and send the next line
+ *
+ * @param[in]   eError        error
+ * @param[in]   wCmeError     extended error code
+ *
+ *****************************************************************************/
+static void CompleteCommands( LTEERR eError, U16 wCmeError )
+{
+  CMDENTRY  tDone;
+  PU8       pnValue;
+
+  // ignore stray result codes
+  if (( CTL_STATE_WAIT == eCtlState ) && ( nInFlight != 0 ))
+  {
+    // stop the timer
+    LTECellModem_StartStopTime( 0 );
+
+    // check for a failed batch
+    if (( LTE_ERR_NONE != eError ) && ( nInFlight > 1 ))
+    {
+      // resend each on its own
+      RequeueCommands( );
+    }
+    else
+    {
+      // back to idle
+      eCtlState = CTL_STATE_IDLE;
+
+      while ( nInFlight != 0 )
+      {
+        // copy out the entry and free it, the callback may queue further commands
+        tDone = atCmdQueue[ nQueueHead ];
+        nQueueHead = ( nQueueHead + 1 ) % LTECELLMODEM_CMDQUEUE_SIZE;
+        nQueueCount--;
+        nInFlight--;
+
+        // process the callback if not null
+        if ( tDone.pvCallback != NULL )
+        {
+          // determine the value
+          switch( eError )
+          {
+            case LTE_ERR_NONE :
+              pnValue = ( tDone.bInfo ) ? ( PU8 )&tDone.tValue : NULL;
+              break;
+
+            case LTE_ERR_ERROR :
+              tDone.tValue.wCmeError = wCmeError;
+              pnValue = ( PU8 )&tDone.tValue.wCmeError;
+              break;
+
+            default :
+              pnValue = NULL;
+              break;
+          }
+
+          // call it
+          tDone.pvCallback( eError, pnValue );
+        }
+      }
+    }
+
+    // send the next line
+    DispatchCommands( );
+  }
+}
+
+/******************************************************************************
+ * @function ProcessLine
+ *
+ * @brief process a received line
+ *
+ * This function will classify a received line as an echo, a final result
+ * code, an information response or an unsolicited result code
+ *
+ *****************************************************************************/
+static void ProcessLine( void )
+{
+  PC8   pcLine = acRecvBuffer;
+  U16   wCmeLen;
+
+  // get the error prefix length
+  wCmeLen = STRLEN_P( szRspCmeError );
+
+  // ignore echoed commands
+  if ( STRNCMP_P( pcLine, szCmdAT, 2 ) == 0 )
+  {
+  }
+  else if ( STRCMP_P( pcLine, szRspOK ) == 0 )
+  {
+    // check for synchronization
+    if ( CTL_STATE_SYNC == eCtlState )
+    {
+      // stop the probe/send the first line
+      LTECellModem_StartStopTime( 0 );
+      eCtlState = CTL_STATE_IDLE;
+      DispatchCommands( );
+    }
+    else
+    {
+      // complete it
+      CompleteCommands( LTE_ERR_NONE, 0 );
+    }
+  }
+  else if ( STRCMP_P( pcLine, szRspError ) == 0 )
+  {
+    // complete it with an error
+    CompleteCommands( LTE_ERR_ERROR, 0 );
+  }
+  else if (( STRNCMP_P( pcLine, szRspCmeError, wCmeLen ) == 0 ) || ( STRNCMP_P( pcLine, szRspCmsError, wCmeLen ) == 0 ))
+  {
+    // complete it with the extended error
+    CompleteCommands( LTE_ERR_ERROR, ( U16 )strtoul( pcLine + wCmeLen, NULL, 10 ));
+  }
+  else if ( !RouteResponse( pcLine ))
+  {
+    // must be unsolicited
+    DispatchUrc( pcLine );
+  }
+}
+
+/******************************************************************************
+ * @function RouteResponse
+ *
+ * @brief route an information response
+ *
+ * This function will route an information response to the command in flight
+ * expecting it
+ *
+ * @param[in]   pcLine      pointer to the line
+ *
+ * @return      TRUE if it was consumed
+ *
+ *****************************************************************************/
+static BOOL RouteResponse( PC8 pcLine )
+{
+  BOOL      bRouted = FALSE;
+  PCMDENTRY ptEntry;
+  PCMDDEF   ptDef;
+  U16       wLength;
+  U8        nIdx;
+
+  // only while waiting
+  if ( CTL_STATE_WAIT == eCtlState )
+  {
+    for ( nIdx = 0; ( !bRouted ) && ( nIdx < nInFlight ); nIdx++ )
+    {
+      // get the entry/definition
+      ptEntry = &atCmdQueue[ ( nQueueHead + nIdx ) % LTECELLMODEM_CMDQUEUE_SIZE ];
+      ptDef = ( PCMDDEF )&atCmdDefs[ ptEntry->eCmd ];
+      wLength = STRLEN_P( ptDef->pszCommand );
 
+      // determine the response type
+      switch( ptDef->eRspType )
+      {
+        case RSP_TYPE_NONE :
+          break;
 
+        case RSP_TYPE_BARE :
+          // take the first unprefixed line
+          if (( !ptEntry->bInfo ) && ( *pcLine != '+' ))
+          {
+            CopyString( ptEntry->tValue.tIdent.acValue, pcLine, sizeof( ptEntry->tValue.tIdent.acValue ));
+            ptEntry->bInfo = bRouted = TRUE;
+          }
+          break;
+
+        default :
+          // match the prefix
+          if (( STRNCMP_P( pcLine, ptDef->pszCommand, wLength ) == 0 ) && ( CH_COLON == *( pcLine + wLength )))
+          {
+            ptEntry->bInfo = ParseResponseValue( pcLine + wLength + 1, ptDef->eRspType, FALSE, &ptEntry->tValue, ptEntry->pnData, ptEntry->wDataLength );
+            bRouted = TRUE;
+          }
+          break;
+      }
+    }
+  }
+
+  // return the routed state
+  return( bRouted );
+}
 
 /******************************************************************************
- * @function 
+ * @function DispatchUrc
  *
- * @brief 
+ * @brief dispatch an unsolicited result code
  *
- * This function 
+ * This function will look up the line prefix in the URC hash table, parse
+ * the arguments and call the URC callback
  *
- * @param[in]   
+ * @param[in]   pcLine      pointer to the line
  *
- * @return      
+ *****************************************************************************/
+static void DispatchUrc( PC8 pcLine )
+{
+  PURCDEF   ptDef;
+  RSPVALUE  tValue;
+  BOOL      bFound = FALSE;
+  U8        nLength;
+  U8        nIdx;
+
+  // hash the prefix
+  nIdx = ComputeHash( pcLine, &nLength ) & URC_HASH_MASK;
+
+  // only prefixed lines
+  if ( CH_COLON == *( pcLine + nLength ))
+  {
+    // probe the table
+    while (( !bFound ) && ( anUrcHash[ nIdx ] != 0 ))
+    {
+      // compare the prefix
+      ptDef = ( PURCDEF )&atUrcDefs[ anUrcHash[ nIdx ] - 1 ];
+      if (( STRLEN_P( ptDef->pszPrefix ) == nLength ) && ( STRNCMP_P( pcLine, ptDef->pszPrefix, nLength ) == 0 ))
+      {
+        // parse it/report it
+        if (( ParseResponseValue( pcLine + nLength + 1, ptDef->eRspType, TRUE, &tValue, NULL, 0 )) && ( pvUrcCallback != NULL ))
+        {
+          pvUrcCallback( ptDef->eUrc, ( PU8 )&tValue );
+        }
+
+        // set the found flag
+        bFound = TRUE;
+      }
+
+      // next slot
+      nIdx = ( nIdx + 1 ) & URC_HASH_MASK;
+    }
+  }
+}
+
+/******************************************************************************
+ * @function ComputeHash
+ *
+ * @brief compute a prefix hash
+ *
+ * This function will hash the prefix up to the colon or end of string
+ *
+ * @param[in]   pszPrefix   pointer to the prefix
+ * @param[io]   pnLength    pointer to store the prefix length
+ *
+ * @return      hash
  *
  *****************************************************************************/
+static U8 ComputeHash( PCC8 pszPrefix, PU8 pnLength )
+{
+  U8  nHash = 0;
+  U8  nLength = 0;
+
+  // hash to the colon
+  while (( *( pszPrefix + nLength ) != '\0' ) && ( *( pszPrefix + nLength ) != CH_COLON ) && ( nLength < 0xFF ))
+  {
+    nHash = ( U8 )(( nHash * 31 ) + *( pszPrefix + nLength ));
+    nLength++;
+  }
+
+  // return the length/hash
+  *pnLength = nLength;
+  return( nHash );
+}
+
+/******************************************************************************
+ * @function BuildUrcTable
+ *
+ * @brief build the URC hash table
+ *
+ * This function will place each URC definition in the open addressed hash
+ * table
+ *
+ *****************************************************************************/
+static void BuildUrcTable( void )
+{
+  U8  nDef;
+  U8  nIdx;
+  U8  nLength;
+
+  // clear the table
+  memset( anUrcHash, 0, URC_HASH_SIZE );
+
+  // insert each definition
+  for ( nDef = 0; nDef < NUMELEMENTS( atUrcDefs ); nDef++ )
+  {
+    // find a free slot
+    nIdx = ComputeHash( atUrcDefs[ nDef ].pszPrefix, &nLength ) & URC_HASH_MASK;
+    while ( anUrcHash[ nIdx ] != 0 )
+    {
+      nIdx = ( nIdx + 1 ) & URC_HASH_MASK;
+    }
+
+    // store the index plus one, zero is empty
+    anUrcHash[ nIdx ] = nDef + 1;
+  }
+}
+
+/******************************************************************************
+ * @function ParseResponseValue
+ *
+ * @brief prase the returned message for content
+ *
+ * This function will parse the arguments of a response into its value
+ *
+ * @param[in]   pcArgs        pointer to the arguments following the colon
+ * @param[in]   eRspType      response type
+ * @param[in]   bUrc          TRUE if unsolicited
+ * @param[io]   ptValue       pointer to the value
+ * @param[in]   pnData        pointer to the socket read buffer
+ * @param[in]   wDataLength   socket read buffer length
+ *
+ * @return      TRUE if valid
+ *
+ *****************************************************************************/
+static BOOL ParseResponseValue( PC8 pcArgs, RSPTYPE eRspType, BOOL bUrc, PRSPVALUE ptValue, PU8 pnData, U16 wDataLength )
+{
+  PC8   apcFields[ MAX_RSP_FIELDS ];
+  U8    nFields;
+  U8    nBase;
+  BOOL  bValid = FALSE;
+
+  // split the fields
+  nFields = SplitFields( pcArgs, apcFields );
+
+  // determine the type
+  switch( eRspType )
+  {
+    case RSP_TYPE_IDENT :
+      if ( nFields >= 1 )
+      {
+        CopyString( ptValue->tIdent.acValue, apcFields[ 0 ], sizeof( ptValue->tIdent.acValue ));
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_VALUE :
+      if ( nFields >= 1 )
+      {
+        ptValue->lValue = strtol( apcFields[ 0 ], NULL, 10 );
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_CSQ :
+      if ( nFields >= 2 )
+      {
+        ptValue->tCsq.nRssi = ( U8 )strtoul( apcFields[ 0 ], NULL, 10 );
+        ptValue->tCsq.nBer = ( U8 )strtoul( apcFields[ 1 ], NULL, 10 );
+        ptValue->tCsq.sDbm = ( ptValue->tCsq.nRssi <= MAX_RSSI_INDEX ) ? ( -113 + ( 2 * ptValue->tCsq.nRssi )) : 0;
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_REG :
+      // a query response leads with the URC mode
+      nBase = ( bUrc ) ? 0 : 1;
+      if ( nFields > nBase )
+      {
+        ptValue->tReg.nStat = ( U8 )strtoul( apcFields[ nBase ], NULL, 10 );
+        ptValue->tReg.wTac = ( nFields > ( nBase + 1 )) ? ( U16 )strtoul( apcFields[ nBase + 1 ], NULL, 16 ) : 0;
+        ptValue->tReg.uCellId = ( nFields > ( nBase + 2 )) ? ( U32 )strtoul( apcFields[ nBase + 2 ], NULL, 16 ) : 0;
+        ptValue->tReg.nAct = ( nFields > ( nBase + 3 )) ? ( U8 )strtoul( apcFields[ nBase + 3 ], NULL, 10 ) : ACT_NOT_REPORTED;
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_OPER :
+      if ( nFields >= 1 )
+      {
+        ptValue->tOper.nMode = ( U8 )strtoul( apcFields[ 0 ], NULL, 10 );
+        CopyString( ptValue->tOper.acName, ( nFields > 2 ) ? apcFields[ 2 ] : "", sizeof( ptValue->tOper.acName ));
+        ptValue->tOper.nAct = ( nFields > 3 ) ? ( U8 )strtoul( apcFields[ 3 ], NULL, 10 ) : ACT_NOT_REPORTED;
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_SOCKET :
+      if ( nFields >= 1 )
+      {
+        ptValue->tSocket.cSocket = ( S8 )strtol( apcFields[ 0 ], NULL, 10 );
+        ptValue->tSocket.wLength = ( nFields > 1 ) ? ( U16 )strtoul( apcFields[ 1 ], NULL, 10 ) : 0;
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_SOCKDATA :
+      if ( nFields >= 2 )
+      {
+        ptValue->tData.cSocket = ( S8 )strtol( apcFields[ 0 ], NULL, 10 );
+        ptValue->tData.wLength = ( U16 )strtoul( apcFields[ 1 ], NULL, 10 );
+        ptValue->tData.pnData = NULL;
+        bValid = TRUE;
+      }
+      break;
+
+    case RSP_TYPE_SOCKREAD :
+      if (( nFields >= 3 ) && ( pnData != NULL ))
+      {
+        ptValue->tData.cSocket = ( S8 )strtol( apcFields[ 0 ], NULL, 10 );
+        ptValue->tData.wLength = DecodeHex( apcFields[ 2 ], pnData, wDataLength );
+        ptValue->tData.pnData = pnData;
+        bValid = TRUE;
+      }
+      break;
+
+    default :
+      break;
+  }
+
+  // return the valid state
+  return( bValid );
+}
+
 /******************************************************************************
- * @function 
+ * @function SplitFields
  *
- * @brief 
+ * @brief split the response fields
  *
- * This function 
+ * This function will split the response arguments in place at the commas
+ * outside of quotes, removing the quotes
  *
- * @param[in]   
+ * @param[in]   pcArgs      pointer to the arguments
+ * @param[io]   ppcFields   pointer to the field pointers
  *
- * @return      
+ * @return      number of fields
  *
  *****************************************************************************/
+static U8 SplitFields( PC8 pcArgs, PC8* ppcFields )
+{
+  U8    nCount = 0;
+  BOOL  bQuoted = FALSE;
+  BOOL  bStart = TRUE;
+
+  // skip the leading spaces
+  while ( CH_SPACE == *pcArgs )
+  {
+    pcArgs++;
+  }
+
+  // process each character
+  while (( *pcArgs != '\0' ) && !(( bStart ) && ( nCount == MAX_RSP_FIELDS )))
+  {
+    if ( bStart )
+    {
+      // skip an opening quote/store the field
+      if ( CH_QUOTE == *pcArgs )
+      {
+        bQuoted = TRUE;
+        pcArgs++;
+      }
+      *( ppcFields + nCount++ ) = pcArgs;
+      bStart = FALSE;
+    }
+    else if ( bQuoted )
+    {
+      // check for the closing quote
+      if ( CH_QUOTE == *pcArgs )
+      {
+        *pcArgs = '\0';
+        bQuoted = FALSE;
+      }
+      pcArgs++;
+    }
+    else
+    {
+      // check for the delimiter
+      if ( CH_COMMA == *pcArgs )
+      {
+        *pcArgs = '\0';
+        bStart = TRUE;
+      }
+      pcArgs++;
+    }
+  }
+
+  // return the count
+  return( nCount );
+}
+
+/******************************************************************************
+ * @function CopyString
+ *
+ * @brief copy a bounded string
+ *
+ * This function will copy a string, truncating and terminating it
+ *
+ * @param[io]   pcDst       pointer to the destination
+ * @param[in]   pszSrc      pointer to the source
+ * @param[in]   wSize       size of the destination
+ *
+ *****************************************************************************/
+static void CopyString( PC8 pcDst, PCC8 pszSrc, U16 wSize )
+{
+  // copy/terminate it
+  STRNCPY_P( pcDst, pszSrc, wSize - 1 );
+  *( pcDst + wSize - 1 ) = '\0';
+}
+
 /******************************************************************************
- * @function 
+ * @function DecodeHex
  *
- * @brief 
+ * @brief decode a hex string
  *
- * This function 
+ * This function will decode a hex string into a buffer
  *
- * @param[in]   
+ * @param[in]   pszHex      pointer to the hex string
+ * @param[io]   pnData      pointer to the buffer
+ * @param[in]   wMaxLength  size of the buffer
  *
- * @return      
+ * @return      number of bytes decoded
  *
  *****************************************************************************/
+static U16 DecodeHex( PCC8 pszHex, PU8 pnData, U16 wMaxLength )
+{
+  U16   wLength = 0;
+  S8    cHigh = 0;
+  S8    cLow = 0;
+
+  // decode each pair, stop on an invalid nibble
+  while (( wLength < wMaxLength ) && (( cHigh = HexNibble( *( pszHex ))) >= 0 ) && (( cLow = HexNibble( *( pszHex + 1 ))) >= 0 ))
+  {
+    // store it
+    *( pnData + wLength++ ) = ( U8 )(( cHigh << 4 ) | cLow );
+    pszHex += 2;
+  }
+
+  // return the length
+  return( wLength );
+}
+
 /******************************************************************************
- * @function 
+ * @function HexNibble
  *
- * @brief 
+ * @brief convert a hex character
  *
- * This function 
+ * This function will convert a hex character to its value
  *
- * @param[in]   
+ * @param[in]   cChar       character
  *
- * @return      
+ * @return      value or -1 if invalid
  *
  *****************************************************************************/
+static S8 HexNibble( C8 cChar )
+{
+  S8  cValue = -1;
+
+  // convert it
+  if (( cChar >= '0' ) && ( cChar <= '9' ))
+  {
+    cValue = cChar - '0';
+  }
+  else if (( cChar >= 'A' ) && ( cChar <= 'F' ))
+  {
+    cValue = cChar - 'A' + 10;
+  }
+  else if (( cChar >= 'a' ) && ( cChar <= 'f' ))
+  {
+    cValue = cChar - 'a' + 10;
+  }
+
+  // return the value
+  return( cValue );
+}
+
+///******************************************************************************
+// * @function LTECellModem_GetGpio
+// *
+// * @brief wet the gpio
+// *
+// * This function will get the GPIO to a givenfunction
+// *
+// * @param[in]   eGpioEnum     desried GPIO enumeration
+// * @param[in]   eGpioMode     desired GPIO mode
+// * @param[in]   pvCallback    pointer to the callback function
+// *
+// * @return      appropriate error
+// *
+// *****************************************************************************/
+//LTEERR LTECellModem_GetGpio( LTEGPIO eGpioEnum, PLTEGPIOMODE peGpioMode, PVLTECALLBACK pvCallback )
+//{
+//  LTEERR eError = LTE_ERR_NONE;
+
+//  // save the callback
+//  pvCurCallback = pvCallback;
+
+//  // test for valid enum
+//  if ( eGpioEnum < LTE_GPIO_MAX )
+//  {
+//  }
+//  else
+//  {
+//    // set the error
+//    eError = LTE_ERR_ILLGPIOENUM;
+//  }
+
+//  // return the error
+//  return( eError );
+//}
 
 /**@} EOF LTECellModem.c */
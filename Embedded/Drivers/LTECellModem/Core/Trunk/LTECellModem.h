@@ -94,13 +94,14 @@ typedef enum _LTEGPIOMODE
 /// enumerate the request
 typedef enum _LTEREQUEST
 {
-  LTE_REQUEST_CREG = 0,
-  LTE_REQUEST_CGSN,
-  LTE_REQUEST_CIMI,
-  LTE_REQUEST_CCID,
-  LTE_REQUEST_CSQ,
-  LTE_REQUEST_MNO,
-  LTE_REQUEST_APN,
+  LTE_REQUEST_CREG = 0,      ///< LTEREG
+  LTE_REQUEST_CGSN,           ///< LTEIDENT
+  LTE_REQUEST_CIMI,           ///< LTEIDENT
+  LTE_REQUEST_CCID,           ///< LTEIDENT
+  LTE_REQUEST_CSQ,            ///< LTECSQ
+  LTE_REQUEST_MNO,            ///< S32 profile
+  LTE_REQUEST_APN,            ///< LTEOPER
+  LTE_REQUEST_CEREG,          ///< LTEREG
   LTE_REQUEST_MAX
 } LTEREQUEST;
 
@@ -144,10 +145,76 @@ typedef enum _LTEMQTTCLEAN
   LTE_MQTTCLEAN_MAX
 } LTEMQTTCLEAN;
 
+/// enumerate the unsolicited result codes
+typedef enum _LTEURC
+{
+  LTE_URC_CREG = 0,           ///< circuit registration, LTEREG
+  LTE_URC_CEREG,              ///< EPS registration, LTEREG
+  LTE_URC_CSQ,                ///< signal quality, LTECSQ
+  LTE_URC_SOCKDATA,           ///< socket data available, LTESOCKDATA
+  LTE_URC_SOCKCLOSED,         ///< socket closed by the peer, LTESOCKET
+  LTE_URC_MAX
+} LTEURC;
+
 // structures -----------------------------------------------------------------
 /// define the callback
 typedef void  ( *PVLTECALLBACK )( LTEERR, PU8 );
 
+/// define the unsolicited result code callback
+typedef void  ( *PVLTEURCCALLBACK )( LTEURC, PU8 );
+
+/// define the signal quality, +CSQ
+typedef struct _LTECSQ
+{
+  U8    nRssi;              ///< RSSI index, 99 unknown
+  U8    nBer;               ///< bit error rate index, 99 unknown
+  S16   sDbm;               ///< RSSI in dBm, 0 unknown
+} LTECSQ, *PLTECSQ;
+#define LTECSQ_SIZE                                 sizeof( LTECSQ )
+
+/// define the registration status, +CREG/+CEREG
+typedef struct _LTEREG
+{
+  U8    nStat;              ///< registration state, 1 home, 5 roaming
+  U8    nAct;               ///< access technology, 0xFF not reported
+  U16   wTac;               ///< tracking area code
+  U32   uCellId;            ///< cell identity
+} LTEREG, *PLTEREG;
+#define LTEREG_SIZE                                 sizeof( LTEREG )
+
+/// define the identity string, +CGSN/+CIMI/+CCID
+typedef struct _LTEIDENT
+{
+  C8    acValue[ 24 ];      ///< null terminated identity
+} LTEIDENT, *PLTEIDENT;
+#define LTEIDENT_SIZE                               sizeof( LTEIDENT )
+
+/// define the operator selection, +COPS
+typedef struct _LTEOPER
+{
+  U8    nMode;              ///< selection mode
+  U8    nAct;               ///< access technology, 0xFF not reported
+  C8    acName[ 24 ];       ///< null terminated operator name
+} LTEOPER, *PLTEOPER;
+#define LTEOPER_SIZE                                sizeof( LTEOPER )
+
+/// define the socket result, +USOCR/+USOWR/+UUSOCL
+typedef struct _LTESOCKET
+{
+  S8    cSocket;            ///< socket number
+  U16   wLength;            ///< length written
+} LTESOCKET, *PLTESOCKET;
+#define LTESOCKET_SIZE                              sizeof( LTESOCKET )
+
+/// define the socket data, +USORD/+UUSORD
+typedef struct _LTESOCKDATA
+{
+  S8    cSocket;            ///< socket number
+  U16   wLength;            ///< length read or available
+  PU8   pnData;             ///< pointer to the read data, NULL on available
+} LTESOCKDATA, *PLTESOCKDATA;
+#define LTESOCKDATA_SIZE                            sizeof( LTESOCKDATA )
+
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
@@ -175,7 +242,11 @@ extern  LTEERR  LTECellModem_MqttConfigureUserCred( PC8 pszName, PC8 pszPassword
 extern  LTEERR  LTECellModem_MqttConfigureTimeout( U32 uTimeout, PVLTECALLBACK pvCallback );
 extern  LTEERR  LTECellModem_MqttConfigureSecure( BOOL bState, PVLTECALLBACK pvCallback );
 extern  LTEERR  LTECellModem_MqttConfigureClean( LTEMQTTCLEAN eLteClean, PVLTECALLBACK pvCallback );
-extern  LTEERR  LTECellModem_Mqtt
+extern  void    LTECellModem_SetUrcCallback( PVLTEURCCALLBACK pvCallback );
+extern  LTEERR  LTECellModem_SetRegistrationUrc( U8 nMode, PVLTECALLBACK pvCallback );
+extern  LTEERR  LTECellModem_SetFunction( U8 nFunction, PVLTECALLBACK pvCallback );
+extern  U8      LTECellModem_GetQueueCount( void );
+
 /**@} EOF LTECellModem.h */
 
 #endif  // _LTECELLMODEM_H
\ No newline at end of file
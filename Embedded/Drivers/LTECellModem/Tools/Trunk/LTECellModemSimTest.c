@@ -0,0 +1,1390 @@
+/******************************************************************************
+ * @file LTECellModemSimTest.c
+ *
+ * @brief LTE cellular modem scripted simulator test
+ *
+ * This file provides a host tool that runs the LTE cellular modem driver
+ * against a scripted modem on a simulated millisecond clock.  The modem
+ * models the power key, boot time, command echo, per line and per command
+ * latency, network attach and an echoing TCP peer.  The tool runs a network
+ * registration and a socket data session twice, once through the queued
+ * engine with registration URCs and once in lockstep, one command per final
+ * result code with registration polled, and reports the times.  It then
+ * checks the timeout retries, the split of a failed concatenated line, a URC
+ * arriving inside a response and the queue full error.  It exits non zero on
+ * any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o LTECellModemSimTest
+ *             LTECellModemSimTest.c ../../Core/Trunk/LTECellModem.c
+ * usage:      LTECellModemSimTest
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup LTECellModem
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+// local includes -------------------------------------------------------------
+#include "LTECellModem/LTECellModem.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the modem timing
+#define SIM_BOOT_MSECS                              ( 1500 )
+#define SIM_LINE_MSECS                              ( 20 )
+#define SIM_CMD_MSECS                               ( 15 )
+#define SIM_CFUN_MSECS                              ( 200 )
+#define SIM_MNOPROF_MSECS                           ( 1000 )
+#define SIM_SEARCH_MSECS                            ( 300 )
+#define SIM_ATTACH_MSECS                            ( 2000 )
+#define SIM_CONNECT_MSECS                           ( 150 )
+#define SIM_PEER_RTT_MSECS                          ( 120 )
+
+/// define the registration poll period in lockstep
+#define POLL_MSECS                                  ( 1000 )
+
+/// define the run limit
+#define RUN_LIMIT_MSECS                             ( 60000 )
+
+/// define the sizes
+#define SIM_OUT_SIZE                                ( 32 )
+#define SIM_TEXT_SIZE                               ( 600 )
+#define SIM_LINE_SIZE                               ( 600 )
+#define EVENT_FIFO_SIZE                             ( 32 )
+
+/// define the expected values
+#define EXP_IMEI                                    ( "356726100000000" )
+#define EXP_IMSI                                    ( "310410123456789" )
+#define EXP_ICCID                                   ( "89011703278100000000" )
+#define EXP_OPER                                    ( "AT&T" )
+#define EXP_TAC                                     ( 0x1A2B )
+#define EXP_CELLID                                  ( 0x01A2B3C4 )
+#define EXP_PAYLOAD                                 ( "hello" )
+
+// structures -----------------------------------------------------------------
+/// define a timed modem output
+typedef struct _SIMOUT
+{
+  U32   uTime;                      ///< time to deliver
+  C8    acText[ SIM_TEXT_SIZE ];    ///< text
+} SIMOUT, *PSIMOUT;
+
+/// define the modem state
+typedef struct _SIMMODEM
+{
+  BOOL  bPowerKey;                  ///< power key pressed
+  BOOL  bPowered;                   ///< power key pulse seen
+  U32   uBootTime;                  ///< time the modem answers
+  BOOL  bEcho;                      ///< echo enabled
+  U8    nCfun;                      ///< functionality
+  U8    nCeregMode;                 ///< registration URC mode
+  U32   uRegTime;                   ///< registration time, 0 not attaching
+  BOOL  bConnected;                 ///< socket connected
+  U8    anSockData[ 256 ];          ///< peer echo data
+  U16   wSockData;                  ///< peer echo length
+  int   iDropCsq;                   ///< number of +CSQ lines to drop
+  BOOL  bInjectUrc;                 ///< inject a URC inside the +CSQ response
+  C8    acLine[ SIM_LINE_SIZE ];    ///< received line
+  U16   wLineIdx;                   ///< received line index
+  U32   uLines;                     ///< command lines received
+  U32   uCommands;                  ///< commands executed
+} SIMMODEM, *PSIMMODEM;
+
+/// define the session state
+typedef struct _SESSION
+{
+  BOOL  bLockstep;                  ///< one command per final result code
+  U8    nStep;                      ///< lockstep bring-up step
+  BOOL  bRegistered;                ///< registered
+  BOOL  bDone;                      ///< session closed
+  U32   uRegMsec;                   ///< registration time
+  U32   uDoneMsec;                  ///< session done time
+  S8    cSocket;                    ///< socket
+  U8    anRead[ 16 ];               ///< read buffer
+  int   iErrors;                    ///< errors
+} SESSION, *PSESSION;
+
+// local parameter declarations -----------------------------------------------
+static  U32         uNow;
+static  BOOL        bTimerRun;
+static  U32         uTimerDeadline;
+static  BOOL        bAppTimerRun;
+static  U32         uAppDeadline;
+static  void        ( *pvAppTimer )( void );
+static  LTELCLEVENT aeEvents[ EVENT_FIFO_SIZE ];
+static  U8          nEventHead;
+static  U8          nEventCount;
+static  SIMOUT      atSimOut[ SIM_OUT_SIZE ];
+static  U8          nSimOutCount;
+static  SIMMODEM    tSim;
+static  SESSION     tSession;
+static  LTEERR      aeResults[ 4 ];
+static  U16         awCmeErrors[ 4 ];
+static  U8          nResults;
+static  LTECSQ      tLastCsq;
+static  LTESOCKET   tLastClosed;
+static  U8          nUrcClosed;
+
+// local function prototypes --------------------------------------------------
+static  void    SimReset( void );
+static  void    SimEmit( U32 uTime, BOOL bRaw, PCC8 pszFormat, ... );
+static  void    SimLine( PC8 pcLine );
+static  int     SimExecute( PC8 pcCmd, U32* puTime );
+static  void    Run( BOOL ( *pbDone )( void ), U32 uLimit );
+static  BOOL    IsQueueEmpty( void );
+static  BOOL    IsSessionDone( void );
+static  void    StartDriver( void );
+static  void    StepNext( void );
+static  void    OnOk( LTEERR eError, PU8 pnValue );
+static  void    OnIdent( LTEERR eError, PU8 pnValue );
+static  void    OnMno( LTEERR eError, PU8 pnValue );
+static  void    OnCfun( LTEERR eError, PU8 pnValue );
+static  void    OnPollReg( LTEERR eError, PU8 pnValue );
+static  void    OnCsq( LTEERR eError, PU8 pnValue );
+static  void    OnOper( LTEERR eError, PU8 pnValue );
+static  void    OnOpen( LTEERR eError, PU8 pnValue );
+static  void    OnConnect( LTEERR eError, PU8 pnValue );
+static  void    OnWrite( LTEERR eError, PU8 pnValue );
+static  void    OnRead( LTEERR eError, PU8 pnValue );
+static  void    OnClose( LTEERR eError, PU8 pnValue );
+static  void    OnUrc( LTEURC eUrc, PU8 pnValue );
+static  void    OnResult( LTEERR eError, PU8 pnValue );
+static  void    PollRegistration( void );
+static  void    StartSession( void );
+static  int     RunSession( BOOL bLockstep, PU32 puRegMsec, PU32 puDoneMsec, PU32 puLines, PU32 puCommands );
+static  int     RunRetry( void );
+static  int     RunBatchError( void );
+static  int     RunUrcInside( void );
+static  int     RunQueueFull( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function runs each test phase and reports the result
+ *
+ * @return      0 on pass, 1 on failure
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+  U32 uPipeReg, uPipeDone, uPipeLines, uPipeCmds;
+  U32 uStepReg, uStepDone, uStepLines, uStepCmds;
+
+  // run the session both ways
+  iErrors += RunSession( FALSE, &uPipeReg, &uPipeDone, &uPipeLines, &uPipeCmds );
+  iErrors += RunSession( TRUE, &uStepReg, &uStepDone, &uStepLines, &uStepCmds );
+  printf( "queued:   registered at %5u msec, session closed at %5u msec, %2u lines, %2u commands\n", uPipeReg, uPipeDone, uPipeLines, uPipeCmds );
+  printf( "lockstep: registered at %5u msec, session closed at %5u msec, %2u lines, %2u commands\n", uStepReg, uStepDone, uStepLines, uStepCmds );
+  printf( "bring-up %d msec faster, session %d msec faster\n", ( int )( uStepReg - uPipeReg ), ( int )(( uStepDone - uStepReg ) - ( uPipeDone - uPipeReg )));
+  if (( uPipeReg >= uStepReg ) || ( uPipeDone >= uStepDone ))
+  {
+    printf( "queued engine is not faster\n" );
+    iErrors++;
+  }
+
+  // run the error paths
+  iErrors += RunRetry( );
+  iErrors += RunBatchError( );
+  iErrors += RunUrcInside( );
+  iErrors += RunQueueFull( );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function LTECellModem_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function provides the configuration hook, nothing to do
+ *
+ *****************************************************************************/
+void LTECellModem_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function LTECellModem_Write
+ *
+ * @brief output a block of characters
+ *
+ * This function will feed the characters to the simulated modem
+ *
+ * @param[in]   pcData      pointer to the data to send
+ * @param[in]   wLength     length of the data
+ *
+ *****************************************************************************/
+void LTECellModem_Write( PC8 pcData, U16 wLength )
+{
+  // assemble the lines
+  while ( wLength-- != 0 )
+  {
+    if ( *pcData == '\r' )
+    {
+      tSim.acLine[ tSim.wLineIdx ] = '\0';
+      SimLine( tSim.acLine );
+      tSim.wLineIdx = 0;
+    }
+    else if ( tSim.wLineIdx < ( SIM_LINE_SIZE - 1 ))
+    {
+      tSim.acLine[ tSim.wLineIdx++ ] = *pcData;
+    }
+    pcData++;
+  }
+}
+
+/******************************************************************************
+ * @function LTECellModem_StartStopTime
+ *
+ * @brief start/stop a timer
+ *
+ * This function will start/stop the simulated control timer
+ *
+ * @param[in]   wTimeMsecs      timer in milliseconds
+ *
+ *****************************************************************************/
+void LTECellModem_StartStopTime( U16 wTimeMsecs )
+{
+  bTimerRun = ( wTimeMsecs != 0 );
+  uTimerDeadline = uNow + wTimeMsecs;
+}
+
+/******************************************************************************
+ * @function LTECellModem_PowerControl
+ *
+ * @brief turn off/on the power control
+ *
+ * This function will drive the simulated power key, the modem boots after
+ * the key is released
+ *
+ * @param[in]   bState      power key state
+ *
+ *****************************************************************************/
+void LTECellModem_PowerControl( BOOL bState )
+{
+  // check for the release of a pressed key
+  if (( tSim.bPowerKey ) && ( !bState ))
+  {
+    tSim.bPowered = TRUE;
+    tSim.uBootTime = uNow + SIM_BOOT_MSECS;
+    SimEmit( tSim.uBootTime, FALSE, "+CPIN: READY" );
+  }
+  tSim.bPowerKey = bState;
+}
+
+/******************************************************************************
+ * @function LTECellModem_PostCtrlEvent
+ *
+ * @brief post an event to the control
+ *
+ * This function will queue an event for the control process
+ *
+ * @param[in]   eEvent    event to post
+ *
+ *****************************************************************************/
+void LTECellModem_PostCtrlEvent( LTELCLEVENT eEvent )
+{
+  if ( nEventCount < EVENT_FIFO_SIZE )
+  {
+    aeEvents[ ( nEventHead + nEventCount++ ) % EVENT_FIFO_SIZE ] = eEvent;
+  }
+}
+
+/******************************************************************************
+ * @function SimReset
+ *
+ * @brief reset the simulation
+ *
+ * This function will reset the clock, the modem and the event queues
+ *
+ *****************************************************************************/
+static void SimReset( void )
+{
+  uNow = 0;
+  bTimerRun = bAppTimerRun = FALSE;
+  nEventHead = nEventCount = 0;
+  nSimOutCount = 0;
+  memset( &tSim, 0, sizeof( tSim ));
+  tSim.bEcho = TRUE;
+  memset( &tSession, 0, sizeof( tSession ));
+  tSession.cSocket = -1;
+}
+
+/******************************************************************************
+ * @function SimEmit
+ *
+ * @brief emit modem output
+ *
+ * This function will queue modem output for delivery at a time, response
+ * lines are framed with CR/LF, raw output is not
+ *
+ * @param[in]   uTime       delivery time
+ * @param[in]   bRaw        TRUE for unframed output
+ * @param[in]   pszFormat   pointer to the format
+ *
+ *****************************************************************************/
+static void SimEmit( U32 uTime, BOOL bRaw, PCC8 pszFormat, ... )
+{
+  va_list tArgs;
+  C8      acText[ SIM_TEXT_SIZE - 8 ];
+  U8      nIdx;
+
+  // format it
+  va_start( tArgs, pszFormat );
+  vsnprintf( acText, sizeof( acText ), pszFormat, tArgs );
+  va_end( tArgs );
+
+  if ( nSimOutCount < SIM_OUT_SIZE )
+  {
+    // insert after every entry due at or before this time
+    for ( nIdx = nSimOutCount; ( nIdx != 0 ) && ( atSimOut[ nIdx - 1 ].uTime > uTime ); nIdx-- )
+    {
+      atSimOut[ nIdx ] = atSimOut[ nIdx - 1 ];
+    }
+    atSimOut[ nIdx ].uTime = uTime;
+    snprintf( atSimOut[ nIdx ].acText, SIM_TEXT_SIZE, ( bRaw ) ? "%s" : "\r\n%s\r\n", acText );
+    nSimOutCount++;
+  }
+}
+
+/******************************************************************************
+ * @function SimLine
+ *
+ * @brief process a command line
+ *
+ * This function will echo and execute a command line, splitting the
+ * concatenated commands and stopping at the first error
+ *
+ * @param[in]   pcLine      pointer to the line
+ *
+ *****************************************************************************/
+static void SimLine( PC8 pcLine )
+{
+  U32   uTime = uNow + SIM_LINE_MSECS;
+  PC8   pcCmd;
+  PC8   pcNext;
+  BOOL  bQuoted;
+  int   iResult = 0;
+
+  // ignore input until booted
+  if (( tSim.bPowered ) && ( uNow >= tSim.uBootTime ))
+  {
+    // echo it
+    tSim.uLines++;
+    if ( tSim.bEcho )
+    {
+      SimEmit( uNow, TRUE, "%s\r", pcLine );
+    }
+
+    // check for the attention
+    if ( strncmp( pcLine, "AT", 2 ) == 0 )
+    {
+      // split on the semicolons outside quotes
+      pcCmd = pcLine + 2;
+      while (( *pcCmd != '\0' ) && ( iResult == 0 ))
+      {
+        for ( pcNext = pcCmd, bQuoted = FALSE; ( *pcNext != '\0' ) && (( *pcNext != ';' ) || ( bQuoted )); pcNext++ )
+        {
+          bQuoted ^= ( *pcNext == '"' );
+        }
+        if ( *pcNext == ';' )
+        {
+          *pcNext++ = '\0';
+        }
+        iResult = SimExecute( pcCmd, &uTime );
+        pcCmd = pcNext;
+      }
+
+      // final result code, nothing on a dropped line
+      if ( iResult == 0 )
+      {
+        SimEmit( uTime, FALSE, "OK" );
+      }
+      else if ( iResult > 0 )
+      {
+        SimEmit( uTime, FALSE, "+CME ERROR: %d", iResult );
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function SimExecute
+ *
+ * @brief execute a command
+ *
+ * This function will execute one command, emitting its information response
+ *
+ * @param[in]   pcCmd       pointer to the command
+ * @param[io]   puTime      pointer to the response time
+ *
+ * @return      0 for OK, CME error code, -1 to drop the line
+ *
+ *****************************************************************************/
+static int SimExecute( PC8 pcCmd, U32* puTime )
+{
+  int   iResult = 0;
+  int   iArg1, iArg2, iLength;
+  C8    acHex[ 520 ];
+  U16   wIdx;
+
+  // count it
+  tSim.uCommands++;
+  *puTime += SIM_CMD_MSECS;
+
+  if (( strcmp( pcCmd, "E0" ) == 0 ) || ( strcmp( pcCmd, "E1" ) == 0 ))
+  {
+    tSim.bEcho = ( pcCmd[ 1 ] == '1' );
+  }
+  else if ( strcmp( pcCmd, "" ) == 0 )
+  {
+  }
+  else if ( strcmp( pcCmd, "+CGSN" ) == 0 )
+  {
+    SimEmit( *puTime, FALSE, EXP_IMEI );
+  }
+  else if ( strcmp( pcCmd, "+CIMI" ) == 0 )
+  {
+    SimEmit( *puTime, FALSE, EXP_IMSI );
+  }
+  else if ( strcmp( pcCmd, "+CCID" ) == 0 )
+  {
+    SimEmit( *puTime, FALSE, "+CCID: %s", EXP_ICCID );
+  }
+  else if ( strcmp( pcCmd, "+CSQ" ) == 0 )
+  {
+    if ( tSim.iDropCsq > 0 )
+    {
+      tSim.iDropCsq--;
+      iResult = -1;
+    }
+    else
+    {
+      SimEmit( *puTime, FALSE, "+CSQ: 18,99" );
+      if ( tSim.bInjectUrc )
+      {
+        SimEmit( *puTime, FALSE, "+UUSOCL: 3" );
+      }
+    }
+  }
+  else if ( strcmp( pcCmd, "+UMNOPROF?" ) == 0 )
+  {
+    SimEmit( *puTime, FALSE, "+UMNOPROF: 2" );
+  }
+  else if ( sscanf( pcCmd, "+UMNOPROF=%d", &iArg1 ) == 1 )
+  {
+    *puTime += SIM_MNOPROF_MSECS;
+  }
+  else if ( strcmp( pcCmd, "+COPS?" ) == 0 )
+  {
+    SimEmit( *puTime, FALSE, "+COPS: 0,0,\"%s\",7", EXP_OPER );
+  }
+  else if (( strncmp( pcCmd, "+CGDCONT=1,", 11 ) == 0 ) || ( strncmp( pcCmd, "+CTZU=", 6 ) == 0 ) || ( strcmp( pcCmd, "+UDCONF=1,1" ) == 0 ))
+  {
+  }
+  else if ( sscanf( pcCmd, "+UGPIOC=%d,%d", &iArg1, &iArg2 ) == 2 )
+  {
+    iResult = (( iArg2 > 17 ) && ( iArg2 != 255 )) ? 4 : 0;
+  }
+  else if ( sscanf( pcCmd, "+CEREG=%d", &iArg1 ) == 1 )
+  {
+    tSim.nCeregMode = ( U8 )iArg1;
+  }
+  else if ( strcmp( pcCmd, "+CEREG?" ) == 0 )
+  {
+    if (( tSim.uRegTime != 0 ) && ( *puTime >= tSim.uRegTime ))
+    {
+      SimEmit( *puTime, FALSE, "+CEREG: %d,1,\"%04X\",\"%08X\",7", tSim.nCeregMode, EXP_TAC, EXP_CELLID );
+    }
+    else
+    {
+      SimEmit( *puTime, FALSE, "+CEREG: %d,%d", tSim.nCeregMode, ( tSim.nCfun != 0 ) ? 2 : 0 );
+    }
+  }
+  else if ( sscanf( pcCmd, "+CFUN=%d", &iArg1 ) == 1 )
+  {
+    *puTime += SIM_CFUN_MSECS;
+    tSim.nCfun = ( U8 )iArg1;
+    if ( tSim.nCfun == 1 )
+    {
+      // attach, reporting the search and the registration
+      tSim.uRegTime = *puTime + SIM_ATTACH_MSECS;
+      if ( tSim.nCeregMode != 0 )
+      {
+        SimEmit( *puTime + SIM_SEARCH_MSECS, FALSE, "+CEREG: 2" );
+        if ( tSim.nCeregMode == 2 )
+        {
+          SimEmit( tSim.uRegTime, FALSE, "+CEREG: 1,\"%04X\",\"%08X\",7", EXP_TAC, EXP_CELLID );
+        }
+        else
+        {
+          SimEmit( tSim.uRegTime, FALSE, "+CEREG: 1" );
+        }
+      }
+    }
+  }
+  else if ( sscanf( pcCmd, "+USOCR=%d", &iArg1 ) == 1 )
+  {
+    SimEmit( *puTime, FALSE, "+USOCR: 0" );
+  }
+  else if ( strncmp( pcCmd, "+USOCO=0,", 9 ) == 0 )
+  {
+    if (( tSim.uRegTime != 0 ) && ( *puTime >= tSim.uRegTime ))
+    {
+      *puTime += SIM_CONNECT_MSECS;
+      tSim.bConnected = TRUE;
+    }
+    else
+    {
+      iResult = 3;
+    }
+  }
+  else if ( sscanf( pcCmd, "+USOWR=0,%d,\"%518[0-9A-F]\"", &iLength, acHex ) == 2 )
+  {
+    if (( tSim.bConnected ) && (( int )strlen( acHex ) == ( iLength * 2 )) && ( iLength <= ( int )sizeof( tSim.anSockData )))
+    {
+      // the peer echoes the data back
+      for ( wIdx = 0; wIdx < iLength; wIdx++ )
+      {
+        sscanf( &acHex[ wIdx * 2 ], "%2hhx", &tSim.anSockData[ wIdx ] );
+      }
+      tSim.wSockData = ( U16 )iLength;
+      SimEmit( *puTime, FALSE, "+USOWR: 0,%d", iLength );
+      SimEmit( *puTime + SIM_PEER_RTT_MSECS, FALSE, "+UUSORD: 0,%d", iLength );
+    }
+    else
+    {
+      iResult = 4;
+    }
+  }
+  else if ( sscanf( pcCmd, "+USORD=0,%d", &iLength ) == 1 )
+  {
+    // return the pending data
+    iLength = ( iLength < tSim.wSockData ) ? iLength : tSim.wSockData;
+    for ( wIdx = 0; wIdx < iLength; wIdx++ )
+    {
+      sprintf( &acHex[ wIdx * 2 ], "%02X", tSim.anSockData[ wIdx ] );
+    }
+    acHex[ iLength * 2 ] = '\0';
+    tSim.wSockData -= iLength;
+    SimEmit( *puTime, FALSE, "+USORD: 0,%d,\"%s\"", iLength, acHex );
+  }
+  else if ( strcmp( pcCmd, "+USOCL=0" ) == 0 )
+  {
+    tSim.bConnected = FALSE;
+  }
+  else
+  {
+    iResult = 4;
+  }
+
+  // return the result
+  return( iResult );
+}
+
+/******************************************************************************
+ * @function Run
+ *
+ * @brief run the simulation
+ *
+ * This function will process events, modem output and timers in time order
+ * until the condition is met or the limit is reached
+ *
+ * @param[in]   pbDone      pointer to the completion test
+ * @param[in]   uLimit      time limit
+ *
+ *****************************************************************************/
+static void Run( BOOL ( *pbDone )( void ), U32 uLimit )
+{
+  LTELCLEVENT eEvent;
+  SIMOUT      tOut;
+  PC8         pcChar;
+  U32         uNext;
+  U8          nIdx;
+
+  while (( !pbDone( )) && ( uNow < uLimit ))
+  {
+    if ( nEventCount != 0 )
+    {
+      // process the control event
+      eEvent = aeEvents[ nEventHead ];
+      nEventHead = ( nEventHead + 1 ) % EVENT_FIFO_SIZE;
+      nEventCount--;
+      LTECellModem_CtrlProcess( eEvent );
+    }
+    else if (( nSimOutCount != 0 ) && ( atSimOut[ 0 ].uTime <= uNow ))
+    {
+      // deliver the modem output
+      tOut = atSimOut[ 0 ];
+      for ( nIdx = 1; nIdx < nSimOutCount; nIdx++ )
+      {
+        atSimOut[ nIdx - 1 ] = atSimOut[ nIdx ];
+      }
+      nSimOutCount--;
+      for ( pcChar = tOut.acText; *pcChar != '\0'; pcChar++ )
+      {
+        LTECellModem_CharProcess(( U8 )*pcChar );
+      }
+    }
+    else if (( bTimerRun ) && ( uTimerDeadline <= uNow ))
+    {
+      // control timeout
+      bTimerRun = FALSE;
+      LTECellModem_CtrlProcess( LTE_LCLEVENT_TIMEOUT );
+    }
+    else if (( bAppTimerRun ) && ( uAppDeadline <= uNow ))
+    {
+      // application timer
+      bAppTimerRun = FALSE;
+      pvAppTimer( );
+    }
+    else
+    {
+      // advance to the next
+      uNext = uLimit;
+      if (( nSimOutCount != 0 ) && ( atSimOut[ 0 ].uTime < uNext ))
+      {
+        uNext = atSimOut[ 0 ].uTime;
+      }
+      if (( bTimerRun ) && ( uTimerDeadline < uNext ))
+      {
+        uNext = uTimerDeadline;
+      }
+      if (( bAppTimerRun ) && ( uAppDeadline < uNext ))
+      {
+        uNext = uAppDeadline;
+      }
+      uNow = uNext;
+    }
+  }
+}
+
+/******************************************************************************
+ * @function IsQueueEmpty
+ *
+ * @brief test for an empty queue
+ *
+ * This function will test for no commands queued or in flight
+ *
+ * @return      TRUE if empty
+ *
+ *****************************************************************************/
+static BOOL IsQueueEmpty( void )
+{
+  return( LTECellModem_GetQueueCount( ) == 0 );
+}
+
+/******************************************************************************
+ * @function IsSessionDone
+ *
+ * @brief test for the end of the session
+ *
+ * This function will test for the session closed
+ *
+ * @return      TRUE if done
+ *
+ *****************************************************************************/
+static BOOL IsSessionDone( void )
+{
+  return( tSession.bDone );
+}
+
+/******************************************************************************
+ * @function StartDriver
+ *
+ * @brief start the driver
+ *
+ * This function will reset the simulation, initialize the driver and run
+ * through the power up until the queue is empty
+ *
+ *****************************************************************************/
+static void StartDriver( void )
+{
+  SimReset( );
+  LTECellModem_Intialize( );
+  LTECellModem_SetUrcCallback( OnUrc );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+  LTECellModem_EchoControl( FALSE, NULL );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+}
+
+/******************************************************************************
+ * @function StepNext
+ *
+ * @brief issue the next bring-up step
+ *
+ * This function will issue the next bring-up command, in lockstep one at a
+ * time from the previous callback, otherwise all of them at once
+ *
+ *****************************************************************************/
+static void StepNext( void )
+{
+  BOOL  bMore = TRUE;
+
+  while ( bMore )
+  {
+    switch( tSession.nStep++ )
+    {
+      case 0 :  LTECellModem_EchoControl( FALSE, OnOk );                                  break;
+      case 1 :  LTECellModem_SendRequest( LTE_REQUEST_CGSN, OnIdent );                    break;
+      case 2 :  LTECellModem_SendRequest( LTE_REQUEST_CIMI, OnIdent );                    break;
+      case 3 :  LTECellModem_SendRequest( LTE_REQUEST_CCID, OnIdent );                    break;
+      case 4 :  LTECellModem_SendRequest( LTE_REQUEST_MNO, OnMno );                       break;
+      case 5 :  LTECellModem_SetAPN( "hologram", LTE_PDP_IP, OnOk );                      break;
+      case 6 :  LTECellModem_SetAutoTimeZone( TRUE, OnOk );                               break;
+      case 7 :  LTECellModem_SetGpio( LTE_GPIO_1, LTE_GPIO_MODE_NETWORK_STS, OnOk );      break;
+      case 8 :
+        // only the queued engine relies on the registration URCs
+        if ( !tSession.bLockstep )
+        {
+          LTECellModem_SetRegistrationUrc( 2, OnOk );
+        }
+        else
+        {
+          LTECellModem_SetFunction( 1, OnCfun );
+          tSession.nStep++;
+        }
+        break;
+
+      case 9 :  LTECellModem_SetFunction( 1, OnCfun );                                    break;
+      default : bMore = FALSE;                                                            break;
+    }
+
+    // lockstep issues one
+    bMore &= !tSession.bLockstep;
+  }
+}
+
+/******************************************************************************
+ * @function OnOk
+ *
+ * @brief completion callback
+ *
+ * This function will check for success and continue a lockstep bring-up
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnOk( LTEERR eError, PU8 pnValue )
+{
+  // the value is not used
+  ( void )pnValue;
+
+  if ( eError != LTE_ERR_NONE )
+  {
+    printf( "command failed at step %u, error %d\n", tSession.nStep, eError );
+    tSession.iErrors++;
+  }
+  if ( tSession.bLockstep )
+  {
+    StepNext( );
+  }
+}
+
+/******************************************************************************
+ * @function OnIdent
+ *
+ * @brief identity callback
+ *
+ * This function will check the identity against the scripted values
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnIdent( LTEERR eError, PU8 pnValue )
+{
+  PLTEIDENT ptIdent = ( PLTEIDENT )pnValue;
+
+  if (( eError != LTE_ERR_NONE ) || ( ptIdent == NULL ) ||
+      (( strcmp( ptIdent->acValue, EXP_IMEI ) != 0 ) && ( strcmp( ptIdent->acValue, EXP_IMSI ) != 0 ) && ( strcmp( ptIdent->acValue, EXP_ICCID ) != 0 )))
+  {
+    printf( "identity mismatch, error %d, %s\n", eError, ( ptIdent != NULL ) ? ptIdent->acValue : "none" );
+    tSession.iErrors++;
+  }
+  OnOk( LTE_ERR_NONE, NULL );
+}
+
+/******************************************************************************
+ * @function OnMno
+ *
+ * @brief MNO profile callback
+ *
+ * This function will check the profile value
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnMno( LTEERR eError, PU8 pnValue )
+{
+  if (( eError != LTE_ERR_NONE ) || ( pnValue == NULL ) || ( *( S32* )pnValue != 2 ))
+  {
+    printf( "MNO profile mismatch, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  OnOk( LTE_ERR_NONE, NULL );
+}
+
+/******************************************************************************
+ * @function OnCfun
+ *
+ * @brief radio on callback
+ *
+ * This function will start the registration poll in lockstep
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnCfun( LTEERR eError, PU8 pnValue )
+{
+  OnOk( eError, pnValue );
+  if ( tSession.bLockstep )
+  {
+    PollRegistration( );
+  }
+}
+
+/******************************************************************************
+ * @function PollRegistration
+ *
+ * @brief poll the registration
+ *
+ * This function will query the registration state
+ *
+ *****************************************************************************/
+static void PollRegistration( void )
+{
+  LTECellModem_SendRequest( LTE_REQUEST_CEREG, OnPollReg );
+}
+
+/******************************************************************************
+ * @function OnPollReg
+ *
+ * @brief registration poll callback
+ *
+ * This function will start the session when registered, otherwise poll again
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnPollReg( LTEERR eError, PU8 pnValue )
+{
+  PLTEREG ptReg = ( PLTEREG )pnValue;
+
+  if (( eError == LTE_ERR_NONE ) && ( ptReg != NULL ) && (( ptReg->nStat == 1 ) || ( ptReg->nStat == 5 )))
+  {
+    if (( ptReg->wTac != EXP_TAC ) || ( ptReg->uCellId != EXP_CELLID ) || ( ptReg->nAct != 7 ))
+    {
+      printf( "registration location mismatch\n" );
+      tSession.iErrors++;
+    }
+    tSession.bRegistered = TRUE;
+    tSession.uRegMsec = uNow;
+    StartSession( );
+  }
+  else
+  {
+    // poll again
+    pvAppTimer = PollRegistration;
+    uAppDeadline = uNow + POLL_MSECS;
+    bAppTimerRun = TRUE;
+  }
+}
+
+/******************************************************************************
+ * @function StartSession
+ *
+ * @brief start the data session
+ *
+ * This function will query the signal and operator and open the socket
+ *
+ *****************************************************************************/
+static void StartSession( void )
+{
+  LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnCsq );
+  if ( !tSession.bLockstep )
+  {
+    LTECellModem_SendRequest( LTE_REQUEST_APN, OnOper );
+    LTECellModem_SocketOpen( LTE_SKTPROT_TCP, 0, OnOpen );
+  }
+}
+
+/******************************************************************************
+ * @function OnCsq
+ *
+ * @brief signal quality callback
+ *
+ * This function will check the signal quality
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnCsq( LTEERR eError, PU8 pnValue )
+{
+  PLTECSQ ptCsq = ( PLTECSQ )pnValue;
+
+  if (( eError != LTE_ERR_NONE ) || ( ptCsq == NULL ) || ( ptCsq->nRssi != 18 ) || ( ptCsq->nBer != 99 ) || ( ptCsq->sDbm != -77 ))
+  {
+    printf( "signal quality mismatch, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  if ( tSession.bLockstep )
+  {
+    LTECellModem_SendRequest( LTE_REQUEST_APN, OnOper );
+  }
+}
+
+/******************************************************************************
+ * @function OnOper
+ *
+ * @brief operator callback
+ *
+ * This function will check the operator
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnOper( LTEERR eError, PU8 pnValue )
+{
+  PLTEOPER ptOper = ( PLTEOPER )pnValue;
+
+  if (( eError != LTE_ERR_NONE ) || ( ptOper == NULL ) || ( strcmp( ptOper->acName, EXP_OPER ) != 0 ) || ( ptOper->nAct != 7 ))
+  {
+    printf( "operator mismatch, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  if ( tSession.bLockstep )
+  {
+    LTECellModem_SocketOpen( LTE_SKTPROT_TCP, 0, OnOpen );
+  }
+}
+
+/******************************************************************************
+ * @function OnOpen
+ *
+ * @brief socket open callback
+ *
+ * This function will connect the socket and, when queued, the write
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnOpen( LTEERR eError, PU8 pnValue )
+{
+  if (( eError != LTE_ERR_NONE ) || ( pnValue == NULL ))
+  {
+    printf( "socket open failed, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  else
+  {
+    tSession.cSocket = (( PLTESOCKET )pnValue )->cSocket;
+    LTECellModem_SocketConnect( tSession.cSocket, "10.1.2.3", 7, OnConnect );
+    if ( !tSession.bLockstep )
+    {
+      LTECellModem_SocketWrite( tSession.cSocket, ( PU8 )EXP_PAYLOAD, strlen( EXP_PAYLOAD ), OnWrite );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function OnConnect
+ *
+ * @brief socket connect callback
+ *
+ * This function will write the payload in lockstep
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnConnect( LTEERR eError, PU8 pnValue )
+{
+  // the value is not used
+  ( void )pnValue;
+
+  if ( eError != LTE_ERR_NONE )
+  {
+    printf( "socket connect failed, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  if ( tSession.bLockstep )
+  {
+    LTECellModem_SocketWrite( tSession.cSocket, ( PU8 )EXP_PAYLOAD, strlen( EXP_PAYLOAD ), OnWrite );
+  }
+}
+
+/******************************************************************************
+ * @function OnWrite
+ *
+ * @brief socket write callback
+ *
+ * This function will check the length written
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnWrite( LTEERR eError, PU8 pnValue )
+{
+  if (( eError != LTE_ERR_NONE ) || ( pnValue == NULL ) || ((( PLTESOCKET )pnValue )->wLength != strlen( EXP_PAYLOAD )))
+  {
+    printf( "socket write failed, error %d\n", eError );
+    tSession.iErrors++;
+  }
+}
+
+/******************************************************************************
+ * @function OnRead
+ *
+ * @brief socket read callback
+ *
+ * This function will check the echoed data and close the socket
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnRead( LTEERR eError, PU8 pnValue )
+{
+  PLTESOCKDATA ptData = ( PLTESOCKDATA )pnValue;
+
+  if (( eError != LTE_ERR_NONE ) || ( ptData == NULL ) || ( ptData->wLength != strlen( EXP_PAYLOAD )) ||
+      ( memcmp( ptData->pnData, EXP_PAYLOAD, ptData->wLength ) != 0 ))
+  {
+    printf( "socket read mismatch, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  LTECellModem_SocketClose( tSession.cSocket, OnClose );
+}
+
+/******************************************************************************
+ * @function OnClose
+ *
+ * @brief socket close callback
+ *
+ * This function will mark the session done
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnClose( LTEERR eError, PU8 pnValue )
+{
+  // the value is not used
+  ( void )pnValue;
+
+  if ( eError != LTE_ERR_NONE )
+  {
+    printf( "socket close failed, error %d\n", eError );
+    tSession.iErrors++;
+  }
+  tSession.bDone = TRUE;
+  tSession.uDoneMsec = uNow;
+}
+
+/******************************************************************************
+ * @function OnUrc
+ *
+ * @brief URC callback
+ *
+ * This function will start the session on registration and read the socket
+ * when data arrives
+ *
+ * @param[in]   eUrc        URC
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnUrc( LTEURC eUrc, PU8 pnValue )
+{
+  PLTEREG       ptReg = ( PLTEREG )pnValue;
+  PLTESOCKDATA  ptData = ( PLTESOCKDATA )pnValue;
+
+  switch( eUrc )
+  {
+    case LTE_URC_CEREG :
+      if (( !tSession.bRegistered ) && (( ptReg->nStat == 1 ) || ( ptReg->nStat == 5 )))
+      {
+        if (( ptReg->wTac != EXP_TAC ) || ( ptReg->uCellId != EXP_CELLID ) || ( ptReg->nAct != 7 ))
+        {
+          printf( "registration URC location mismatch\n" );
+          tSession.iErrors++;
+        }
+        tSession.bRegistered = TRUE;
+        tSession.uRegMsec = uNow;
+        StartSession( );
+      }
+      break;
+
+    case LTE_URC_SOCKDATA :
+      if (( ptData->cSocket == tSession.cSocket ) && ( ptData->wLength != 0 ))
+      {
+        LTECellModem_SocketRead( ptData->cSocket, tSession.anRead, ptData->wLength, OnRead );
+      }
+      break;
+
+    case LTE_URC_SOCKCLOSED :
+      tLastClosed = *( PLTESOCKET )pnValue;
+      nUrcClosed++;
+      break;
+
+    default :
+      break;
+  }
+}
+
+/******************************************************************************
+ * @function OnResult
+ *
+ * @brief recording callback
+ *
+ * This function will record the result of a command
+ *
+ * @param[in]   eError      error
+ * @param[in]   pnValue     pointer to the value
+ *
+ *****************************************************************************/
+static void OnResult( LTEERR eError, PU8 pnValue )
+{
+  if ( nResults < 4 )
+  {
+    aeResults[ nResults ] = eError;
+    awCmeErrors[ nResults ] = (( eError == LTE_ERR_ERROR ) && ( pnValue != NULL )) ? *( PU16 )pnValue : 0;
+    if (( eError == LTE_ERR_NONE ) && ( pnValue != NULL ))
+    {
+      tLastCsq = *( PLTECSQ )pnValue;
+    }
+  }
+  nResults++;
+}
+
+/******************************************************************************
+ * @function RunSession
+ *
+ * @brief run a registration and data session
+ *
+ * This function will power up the modem and run the bring-up and the data
+ * session
+ *
+ * @param[in]   bLockstep     TRUE for one command per final result code
+ * @param[io]   puRegMsec     pointer to store the registration time
+ * @param[io]   puDoneMsec    pointer to store the session done time
+ * @param[io]   puLines       pointer to store the command lines
+ * @param[io]   puCommands    pointer to store the commands
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunSession( BOOL bLockstep, PU32 puRegMsec, PU32 puDoneMsec, PU32 puLines, PU32 puCommands )
+{
+  // start the modem and the bring-up together
+  SimReset( );
+  tSession.bLockstep = bLockstep;
+  LTECellModem_Intialize( );
+  LTECellModem_SetUrcCallback( OnUrc );
+  StepNext( );
+  Run( IsSessionDone, RUN_LIMIT_MSECS );
+  if ( !tSession.bDone )
+  {
+    printf( "%s session did not complete\n", ( bLockstep ) ? "lockstep" : "queued" );
+    tSession.iErrors++;
+  }
+
+  // report
+  *puRegMsec = tSession.uRegMsec;
+  *puDoneMsec = tSession.uDoneMsec;
+  *puLines = tSim.uLines;
+  *puCommands = tSim.uCommands;
+  return( tSession.iErrors );
+}
+
+/******************************************************************************
+ * @function RunRetry
+ *
+ * @brief run the timeout retries
+ *
+ * This function will drop responses, checking a command is resent and that
+ * it times out once the retries are used
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunRetry( void )
+{
+  int iErrors = 0;
+  U32 uLines;
+  U32 uStart;
+
+  // one dropped response is retried
+  StartDriver( );
+  nResults = 0;
+  tSim.iDropCsq = 1;
+  uLines = tSim.uLines;
+  uStart = uNow;
+  LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnResult );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+  if (( nResults != 1 ) || ( aeResults[ 0 ] != LTE_ERR_NONE ) || ( tLastCsq.nRssi != 18 ) || (( tSim.uLines - uLines ) != 2 ))
+  {
+    printf( "retry: %u results, error %d, %u lines\n", nResults, aeResults[ 0 ], tSim.uLines - uLines );
+    iErrors++;
+  }
+  printf( "retry: recovered after %u msec\n", uNow - uStart );
+
+  // every response dropped times out after the retries
+  nResults = 0;
+  tSim.iDropCsq = LTECELLMODEM_CMD_RETRIES + 1;
+  uLines = tSim.uLines;
+  uStart = uNow;
+  LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnResult );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+  if (( nResults != 1 ) || ( aeResults[ 0 ] != LTE_ERR_TIMEOUT ) || (( tSim.uLines - uLines ) != ( LTECELLMODEM_CMD_RETRIES + 1 )))
+  {
+    printf( "retry: %u results, error %d, %u lines on timeout\n", nResults, aeResults[ 0 ], tSim.uLines - uLines );
+    iErrors++;
+  }
+  printf( "retry: timed out after %u msec, %u attempts\n", uNow - uStart, tSim.uLines - uLines );
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunBatchError
+ *
+ * @brief run a failed concatenated line
+ *
+ * This function will queue three batchable commands, the middle one failing,
+ * and check each completes with its own result
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunBatchError( void )
+{
+  int iErrors = 0;
+  U32 uLines;
+
+  // queue them together
+  StartDriver( );
+  nResults = 0;
+  uLines = tSim.uLines;
+  LTECellModem_SetAutoTimeZone( TRUE, OnResult );
+  LTECellModem_SetGpio( LTE_GPIO_2, ( LTEGPIOMODE )99, OnResult );
+  LTECellModem_SetAPN( "hologram", LTE_PDP_IP, OnResult );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+
+  // one concatenated line rejected, then each on its own line
+  if (( nResults != 3 ) || (( tSim.uLines - uLines ) != 4 ) || ( aeResults[ 0 ] != LTE_ERR_NONE ) || ( aeResults[ 1 ] != LTE_ERR_ERROR ) || ( awCmeErrors[ 1 ] != 4 ) ||
+      ( aeResults[ 2 ] != LTE_ERR_NONE ))
+  {
+    printf( "batch: %u results, errors %d %d(%u) %d\n", nResults, aeResults[ 0 ], aeResults[ 1 ], awCmeErrors[ 1 ], aeResults[ 2 ] );
+    iErrors++;
+  }
+  printf( "batch: failed line split, %u lines\n", tSim.uLines - uLines );
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunUrcInside
+ *
+ * @brief run a URC inside a response
+ *
+ * This function will inject a socket closed URC between a response and its
+ * final result code and check both are delivered
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunUrcInside( void )
+{
+  int iErrors = 0;
+
+  // inject it
+  StartDriver( );
+  nResults = 0;
+  nUrcClosed = 0;
+  tSim.bInjectUrc = TRUE;
+  LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnResult );
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+  if (( nResults != 1 ) || ( aeResults[ 0 ] != LTE_ERR_NONE ) || ( tLastCsq.sDbm != -77 ) || ( nUrcClosed != 1 ) || ( tLastClosed.cSocket != 3 ))
+  {
+    printf( "urc: %u results, %u closed URCs, socket %d\n", nResults, nUrcClosed, tLastClosed.cSocket );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunQueueFull
+ *
+ * @brief run the queue full
+ *
+ * This function will fill the queue and check the next command is refused
+ * and the queued ones all complete
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunQueueFull( void )
+{
+  int     iErrors = 0;
+  U8      nIdx;
+  LTEERR  eError = LTE_ERR_NONE;
+
+  // fill it
+  StartDriver( );
+  nResults = 0;
+  for ( nIdx = 0; ( nIdx < LTECELLMODEM_CMDQUEUE_SIZE ) && ( eError == LTE_ERR_NONE ); nIdx++ )
+  {
+    eError = LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnResult );
+  }
+  if (( eError != LTE_ERR_NONE ) || ( LTECellModem_SendRequest( LTE_REQUEST_CSQ, OnResult ) != LTE_ERR_BUSY ))
+  {
+    printf( "queue: not refused when full\n" );
+    iErrors++;
+  }
+  Run( IsQueueEmpty, RUN_LIMIT_MSECS );
+  if ( nResults != LTECELLMODEM_CMDQUEUE_SIZE )
+  {
+    printf( "queue: %u of %u completed\n", nResults, LTECELLMODEM_CMDQUEUE_SIZE );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/**@} EOF LTECellModemSimTest.c */
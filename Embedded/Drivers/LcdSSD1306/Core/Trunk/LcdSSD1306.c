@@ -292,7 +292,7 @@ void LcdSSD1306_SetColData( U8 nPage, U8 nCol, U8 nData, LCDSSD1306DISPLAYPIXACT
   U16 wOffset;
 
   // test for valid page/column
-  if (( nPage < DISPLAY_END_PAGE ) && ( nCol < LCDSSD1306_DISPLAY_WIDTH )) 
+  if (( nPage <= DISPLAY_END_PAGE ) && ( nCol < LCDSSD1306_DISPLAY_WIDTH )) 
   {
     // compute buffer index
     wOffset = ( nPage * LCDSSD1306_DISPLAY_WIDTH ) + nCol;
@@ -340,6 +340,47 @@ void LcdSSD1306_WriteBuffer( void )
   LcdSSD1306_LocalWriteBuffer( anBuffer, BUFFER_SIZE );
 }
 
+/******************************************************************************
+ * @function LcdSSD1306_WriteBufferRegion
+ *
+ * @brief outputs a region of the buffer to the display
+ *
+ * This function will set the column/page window to the requested region and
+ * output only the columns of each page that fall within it
+ *
+ * @param[in]   nColStart   starting column
+ * @param[in]   nColEnd     ending column, inclusive
+ * @param[in]   nPageStart  starting page
+ * @param[in]   nPageEnd    ending page, inclusive
+ *
+ *****************************************************************************/
+void LcdSSD1306_WriteBufferRegion( U8 nColStart, U8 nColEnd, U8 nPageStart, U8 nPageEnd )
+{
+  U8  nPage;
+  
+  // constrain to the display
+  nColEnd = MIN( nColEnd, LCDSSD1306_DISPLAY_WIDTH - 1 );
+  nPageEnd = MIN( nPageEnd, DISPLAY_END_PAGE );
+  
+  // check for a valid region
+  if (( nColStart <= nColEnd ) && ( nPageStart <= nPageEnd ))
+  {
+    // set the column start address/end addresses/page start/end addresses
+    LcdSSD1306_LocalWriteCommand( SSD1306_COLUMNADDR );
+    LcdSSD1306_LocalWriteCommand( nColStart );
+    LcdSSD1306_LocalWriteCommand( nColEnd );
+    LcdSSD1306_LocalWriteCommand( SSD1306_PAGEADDR );
+    LcdSSD1306_LocalWriteCommand( nPageStart );
+    LcdSSD1306_LocalWriteCommand( nPageEnd );
+    
+    // for each page, output the columns, the window wraps to the next page
+    for ( nPage = nPageStart; nPage <= nPageEnd; nPage++ )
+    {
+      LcdSSD1306_LocalWriteBuffer( &anBuffer[ ( nPage * LCDSSD1306_DISPLAY_WIDTH ) + nColStart ], ( nColEnd - nColStart ) + 1 );
+    }
+  }
+}
+
 /******************************************************************************
  * @function LcdSSD1306_SetScroll
  *
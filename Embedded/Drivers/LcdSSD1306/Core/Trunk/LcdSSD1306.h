@@ -65,7 +65,9 @@ extern  BOOL  LcdSSD1306_Initialize( void );
 extern  void  LcdSSD1306_SetDim( BOOL bState );
 extern  void  LcdSSD1306_ClearScreen( void );
 extern  void  LcdSSD1306_SetPixel( U8 nX, U8 nY, LCDSSD1306DISPLAYPIXACT eAction );
+extern  void  LcdSSD1306_SetColData( U8 nPage, U8 nCol, U8 nData, LCDSSD1306DISPLAYPIXACT eAction );
 extern  void  LcdSSD1306_WriteBuffer( void );
+extern  void  LcdSSD1306_WriteBufferRegion( U8 nColStart, U8 nColEnd, U8 nPageStart, U8 nPageEnd );
 extern  void  LcdSSD1306_SetScroll( LCDSSD1306DISPLAYSCROLL eScrollType, U8 nStart, U8 nStop );
 
 /**@} EOF LcdSSD1306.h */
@@ -30,6 +30,29 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the backend selections
+#define MMCSDHANDLER_BACKEND_SPI                ( 0 )
+#define MMCSDHANDLER_BACKEND_FILE               ( 1 )
+
+/// set the macro below to one of the above backends, the file backend
+/// emulates a card with an image file for host benchmarking
+#define MMCSDHANDLER_BACKEND                    ( MMCSDHANDLER_BACKEND_SPI )
+
+/// define the SPI device enumeration
+#define MMCSDHANDLER_SPI_DEV_ENUM               ( SPI_DEV_ENUM_ILLEGAL )
+
+/// define the image file name for the file backend
+#define MMCSDHANDLER_FILE_IMAGE_NAME            ( "sdcard.img" )
+
+/// define the number of cached sectors, 0 disables the cache
+#define MMCSDHANDLER_CACHE_NUM_SECTORS          ( 8 )
+
+/// define the number of sectors read on a sequential cache miss
+#define MMCSDHANDLER_CACHE_READAHEAD            ( 4 )
+
+/// define the transfer count at which reads/writes bypass the cache
+#define MMCSDHANDLER_CACHE_BYPASS_COUNT         ( 4 )
+
 /// define the card detect enumeration
 #define MMCSDHANDLER_CARD_DETECT_ENUM           ( GPIO_PIN_ENUM_ILLEGAL )
 
@@ -24,12 +24,18 @@
  *****************************************************************************/
 
 // system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
 
 // local includes -------------------------------------------------------------
 #include "MmcSdHandler/MmcSdHandler.h"
 #include "MmcSdHandler/MmcSdHandler_prm.h"
 
 // library includes -----------------------------------------------------------
+#if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+  #include "SPI/Spi.h"
+  #include "GPIO/Gpio.h"
+#endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 
 // Macros and Defines ---------------------------------------------------------
 // define the response length
@@ -73,22 +79,70 @@
 /// define the number of dummy bytes for int
 #define NUM_DUMMY_BYTES       ( 10 )            ///< 80 bits
 
+/// define the data tokens
+#define TOKEN_SINGLE_BLOCK    ( 0xFE )          // single block write/read data
+#define TOKEN_MULTI_BLOCK     ( 0xFC )          // multiple block write data
+#define TOKEN_STOP_TRAN       ( 0xFD )          // multiple block write stop
+
+/// define the illegal sector
+#define ILLEGAL_SECTOR        ( 0xFFFFFFFF )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+#if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+/// define the cache entry structure
+typedef struct _CACHEENT
+{
+  U32   uSector;                  ///< cached sector
+  U32   uStamp;                   ///< last access stamp
+  BOOL  bValid;                   ///< entry valid
+  BOOL  bDirty;                   ///< entry must be written back
+} CACHEENT, *PCACHEENT;
+#define CACHEENT_SIZE         sizeof( CACHEENT )
+#endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
-static  VU8     nLclStatus;
-static  VBOOL   bPowerFlag;
-static  VU16    wTimer1;
-static  VU16    wTimer2;
-static  U8      nCardType;
-static  U8      anResponse[ RESP_MSG_LEN ];
-static  U8      anCmdBuffer[ CMD_BUF_LEN ];
+static  VU8               nLclStatus;
+static  VBOOL             bPowerFlag;
+static  VU16              wTimer1;
+static  VU16              wTimer2;
+static  U8                nCardType;
+#if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+static  U8                anResponse[ RESP_MSG_LEN ];
+static  U8                anCmdBuffer[ CMD_BUF_LEN ];
+#endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+static  MMCSDHANDLERSTATS tStats;
+#if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+static  FILE*             ptImage;
+#endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+#if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+static  CACHEENT          atCacheEnts[ MMCSDHANDLER_CACHE_NUM_SECTORS ];
+static  U8                anCacheData[ MMCSDHANDLER_CACHE_NUM_SECTORS ][ MMCSDHANDLER_BLK_SIZE ];
+static  U32               uCacheStamp;
+static  U32               uLastReadSector;
+#endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
 // local function prototypes --------------------------------------------------
+static  BOOL    CardReadStart( U32 uSector, U8 nCount );
+static  BOOL    CardReadBlock( PU8 pnBuffer );
+static  void    CardReadStop( U8 nCount );
+static  BOOL    CardWriteStart( U32 uSector, U8 nCount );
+static  BOOL    CardWriteBlock( const U8* pnBuffer, U8 nCount );
+static  BOOL    CardWriteStop( U8 nCount );
+static  BOOL    CardRead( PU8 pnBuffer, U32 uSector, U8 nCount );
+static  BOOL    CardWrite( const U8* pnBuffer, U32 uSector, U8 nCount );
+#if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+static  void      CacheInvalidate( void );
+static  PCACHEENT CacheLookup( U32 uSector );
+static  U8        CacheAllocate( U8 nCount, PU8 pnSlots );
+static  BOOL      CacheRead( PU8 pnBuffer, U32 uSector );
+static  BOOL      CacheWrite( const U8* pnBuffer, U32 uSector );
+static  BOOL      CacheFlush( void );
+#endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+#if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 static  BOOL    RcvDataBlock( PU8 pnBUffer, U16 wCount );
 static  BOOL    XmtDataBlock( PU8 pnBUffer, U8 nCmd );
 static  U8      SendCmd( U8 nCmd, U32 uArg );
@@ -96,6 +150,7 @@ static  BOOL    PowerControl( BOOL bState );
 static  U8      WaitReady( U16 wMilliseconds );
 static  BOOL    Select( void );
 static  void    Deselect( void );
+#endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 
 // constant parameter initializations -----------------------------------------
 /// define the error strings
@@ -155,8 +210,14 @@ static  const CODE PC8 aszErrors[ NUM_ERROR_STRINGS ] =
  *****************************************************************************/
 BOOL MmcSdHandler_Initialize( void )
 {
-  // clear the power flag
+  // clear the power flag/statistics
   bPowerFlag = OFF;
+  memset( &tStats, 0, MMCSDHANDLERSTATS_SIZE );
+
+  #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+  // clear the cache
+  CacheInvalidate( );
+  #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
   // set the status equal to no card inserted
   nLclStatus |= MMCSDHANDLER_STS_NODISK;
@@ -200,6 +261,9 @@ BOOL MmcSdHandler_Initialize( void )
  *****************************************************************************/
 BOOL MmcSdHandler_ProcessTimer( TASKARG xArg )
 {
+  // unused argument
+  ( void )xArg;
+
   // decrment timer 1 if time remaining
   if ( wTimer1 != 0 )
     wTimer1--;
@@ -251,14 +315,35 @@ BOOL MmcSdHandler_ProcessTimer( TASKARG xArg )
 U8 MmcSdHandler_InitializeDrive( U8 nDrive )
 {
   U8    nStatus = MMCSDHANDLER_STS_NOINIT;
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
   U8    nType = 0;
   U8    nCmd;
   U16   wSpeed;
   U8    anBuffer[ NUM_DUMMY_BYTES ];
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
   
   // only supports drive 0
   if ( nDrive == 0 )
   {
+    #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+    // discard the cache, the card may have been changed
+    CacheInvalidate( );
+    #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+
+    #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+    // open the image
+    if ( ptImage == NULL )
+    {
+      ptImage = fopen( MMCSDHANDLER_FILE_IMAGE_NAME, "r+b" );
+    }
+
+    // if opened, emulate a block addressed SD card
+    if ( ptImage != NULL )
+    {
+      nCardType = CARD_TYPE_SDC;
+      nLclStatus &= ~MMCSDHANDLER_STS_NOINIT;
+    }
+    #else
     // power off
     PowerControl( OFF );
     
@@ -324,7 +409,7 @@ U8 MmcSdHandler_InitializeDrive( U8 nDrive )
           while(( wTimer1 != 0 ) && ( SendCmd( nCmd, 0 )));
           
           // check for timeout
-          if (( wTimer1 != 0 ) || ( SendCmd( CMD16, 512 ) != 0 ))
+          if (( wTimer1 == 0 ) || ( SendCmd( CMD16, 512 ) != 0 ))
           {
             nType = 0;
           }
@@ -351,6 +436,7 @@ U8 MmcSdHandler_InitializeDrive( U8 nDrive )
         }
       }
     }
+    #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
 
     // copy the status to local status
     nStatus = nLclStatus;
@@ -392,7 +478,9 @@ U8 MmcSdHandler_Status( U8 nDrive )
  *
  * @brief read a sector
  *
- * This function will read a sector from the MMC/SD card
+ * This function will read sectors from the MMC/SD card.  Short reads go
+ * through the sector cache, long reads are streamed with a single CMD18
+ * and then patched with any newer data still waiting in the cache
  *
  * @param[in]   nDrive      drive number
  * @param[in]   pnBuffer    pointer to the data buffer
@@ -405,6 +493,11 @@ U8 MmcSdHandler_Status( U8 nDrive )
 MMCSDHANDLERRESULT MmcSdHandler_Read( U8 nDrive, PU8 pnBuffer, U32 uSector, U8 nCount )
 {
   MMCSDHANDLERRESULT eResult;
+  BOOL               bStatus = TRUE;
+  #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+  PCACHEENT          ptEnt;
+  U8                 nIndex;
+  #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
   // check for valid parameters
   if (( nDrive == 0 ) && ( nCount != 0 ))
@@ -412,55 +505,33 @@ MMCSDHANDLERRESULT MmcSdHandler_Read( U8 nDrive, PU8 pnBuffer, U32 uSector, U8 n
     // check for disk initialized
     if (( nLclStatus & MMCSDHANDLER_STS_NOINIT ) == 0 )
     {
-      // convert to byte address if needed
-      if ( !( nCardType & CARD_TYPE_BLK ))
-      {
-        // convert to sector address
-        uSector *= MMCSDHANDLER_BLK_SIZE;
-      }
-
-      // check for single block
-      if ( nCount == 1 )
+      #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+      if ( nCount < MMCSDHANDLER_CACHE_BYPASS_COUNT )
       {
-        // single block read
-        if (( SendCmd( CMD17, uSector ) == 0 ) && ( RcvDataBlock( pnBuffer, MMCSDHANDLER_BLK_SIZE )))
+        // read each sector through the cache
+        for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
         {
-          // clear the count
-          nCount = 0;
+          bStatus = CacheRead( pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ), uSector + nIndex );
         }
       }
-      else
+      else if (( bStatus = CardRead( pnBuffer, uSector, nCount )) == TRUE )
       {
-        // multiple block read
-        if ( SendCmd( CMD18, uSector ) == 0 )
+        // overlay any dirty cached sectors
+        for ( nIndex = 0; nIndex < nCount; nIndex++ )
         {
-          // loop
-          do 
-          { 
-            // if error - break
-            if ( !RcvDataBlock( pnBuffer, MMCSDHANDLER_BLK_SIZE ))
-            {
-              // exit
-              break;
-            }
-            else
-            {
-              // adjust buffer pointer
-              pnBuffer += MMCSDHANDLER_BLK_SIZE;
-            }
+          if ((( ptEnt = CacheLookup( uSector + nIndex )) != NULL ) && ( ptEnt->bDirty ))
+          {
+            memcpy( pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ), anCacheData[ ptEnt - atCacheEnts ], MMCSDHANDLER_BLK_SIZE );
           }
-          while ( --nCount );
-
-          // terminate read
-          SendCmd( CMD12, 0 );
         }
       }
+      #else
+      // read from the card
+      bStatus = CardRead( pnBuffer, uSector, nCount );
+      #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
-      // deselect/idle
-      Deselect( );
-
-      // set the result based on count
-      eResult = ( nCount != 0 ) ? MMCSDHANDLER_RES_ERROR : MMCSDHANDLER_RES_OK;
+      // set the result
+      eResult = ( bStatus ) ? MMCSDHANDLER_RES_OK : MMCSDHANDLER_RES_ERROR;
     }
     else
     {
@@ -483,7 +554,10 @@ MMCSDHANDLERRESULT MmcSdHandler_Read( U8 nDrive, PU8 pnBuffer, U32 uSector, U8 n
  *
  * @brief write a sector
  *
- * This function will write a sector to the MMC/SD card
+ * This function will write sectors to the MMC/SD card.  Short writes,
+ * which are typically FAT and directory updates, are held in the cache
+ * until evicted or synced.  Long writes are streamed with ACMD23/CMD25
+ * and refresh any cached copies
  *
  * @param[in]   nDrive      drive number
  * @param[in]   pnBuffer    pointer to the data buffer
@@ -496,6 +570,11 @@ MMCSDHANDLERRESULT MmcSdHandler_Read( U8 nDrive, PU8 pnBuffer, U32 uSector, U8 n
 MMCSDHANDLERRESULT MmcSdHandler_Write( U8 nDrive, const U8 *pnBuffer, U32 uSector, U8 nCount )
 {
   MMCSDHANDLERRESULT eResult;
+  BOOL               bStatus = TRUE;
+  #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+  PCACHEENT          ptEnt;
+  U8                 nIndex;
+  #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
   // check for valid parameters
   if (( nDrive == 0 ) && ( nCount != 0 ))
@@ -504,64 +583,36 @@ MMCSDHANDLERRESULT MmcSdHandler_Write( U8 nDrive, const U8 *pnBuffer, U32 uSecto
     if ( !( nLclStatus & MMCSDHANDLER_STS_NOINIT ))
     {
       // check for protected
-      if ( nLclStatus & MMCSDHANDLER_STS_PROTECT )
+      if (( nLclStatus & MMCSDHANDLER_STS_PROTECT ) == 0 )
       {
-        // convert to byte address if needed
-        if ( !( nCardType & CARD_TYPE_BLK ))
-        {
-                // convert to sector address
-                uSector *= MMCSDHANDLER_BLK_SIZE;
-        }
-
-        // check for single block
-        if ( nCount == 1 )
+        #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+        if ( nCount < MMCSDHANDLER_CACHE_BYPASS_COUNT )
         {
-          // single block write
-          if (( SendCmd( CMD24, uSector ) == 0 ) && ( XmtDataBlock(( PU8 )pnBuffer, 0xFE )))
+          // write each sector into the cache
+          for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
           {
-            // clear the count
-            nCount = 0;
+            bStatus = CacheWrite( pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ), uSector + nIndex );
           }
         }
-        else
+        else if (( bStatus = CardWrite( pnBuffer, uSector, nCount )) == TRUE )
         {
-          // multiple block write
-          if ( nCardType & CARD_TYPE_SDC )
-          {
-            // send the commands for multiple blocks
-            SendCmd( ACMD23, nCount );
-          }
-
-          // start write
-          if ( SendCmd( CMD25, uSector ) == 0 )
+          // refresh any cached copies, they are now clean
+          for ( nIndex = 0; nIndex < nCount; nIndex++ )
           {
-            // loop
-            do 
-            {
-              // if error - break
-              if ( !XmtDataBlock(( PU8 )pnBuffer, 0xFC ))
-                      break;
-
-              // adjust buffer
-              pnBuffer += MMCSDHANDLER_BLK_SIZE;
-
-            }
-            while ( --nCount );
-
-            // send stop token
-            if ( !( XmtDataBlock( NULL, 0xFD ))) 
+            if (( ptEnt = CacheLookup( uSector + nIndex )) != NULL )
             {
-              // set count to 1 to indicate error
-              nCount = 1;
+              memcpy( anCacheData[ ptEnt - atCacheEnts ], pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ), MMCSDHANDLER_BLK_SIZE );
+              ptEnt->bDirty = FALSE;
             }
           }
         }
+        #else
+        // write to the card
+        bStatus = CardWrite( pnBuffer, uSector, nCount );
+        #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
 
-        // deselect/ idle 
-        Deselect( );
-
-        // set the result based on count
-        eResult = ( nCount != 0 ) ? MMCSDHANDLER_RES_ERROR : MMCSDHANDLER_RES_OK;
+        // set the result
+        eResult = ( bStatus ) ? MMCSDHANDLER_RES_OK : MMCSDHANDLER_RES_ERROR;
       }
       else
       {
@@ -602,11 +653,13 @@ MMCSDHANDLERRESULT MmcSdHandler_Write( U8 nDrive, const U8 *pnBuffer, U32 uSecto
 MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
 {
   MMCSDHANDLERRESULT  eResult = MMCSDHANDLER_RES_ERROR;
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
   U8                  nShift, anCsd[ 16 ];
   U16                 wSize;
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 
   // check for valid drive
-  if ( nDrive != 0 )
+  if ( nDrive == 0 )
   {
     // check for a power command
     if ( nCmd == MMCSDHANDLER_CTRL_POWER )
@@ -614,6 +667,7 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
       // check for what we need to do
       switch( *(( PU8 )pvBuffer ))
       {
+        #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
         case 0 :        // power off
           // if power on
           if ( bPowerFlag )
@@ -629,6 +683,7 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
           PowerControl( ON );
           eResult = MMCSDHANDLER_RES_OK;
           break;
+        #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 
         case 2 :        // power get
           *(( PU8  )pvBuffer + 1 ) = bPowerFlag;
@@ -640,6 +695,18 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
           break;
       }
     }
+    else if ( nCmd == MMCSDHANDLER_GET_STATS )
+    {
+      // copy the statistics
+      memcpy( pvBuffer, &tStats, MMCSDHANDLERSTATS_SIZE );
+      eResult = MMCSDHANDLER_RES_OK;
+    }
+    else if ( nCmd == MMCSDHANDLER_CLR_STATS )
+    {
+      // clear the statistics
+      memset( &tStats, 0, MMCSDHANDLERSTATS_SIZE );
+      eResult = MMCSDHANDLER_RES_OK;
+    }
     else
     {
       // check for not initialized
@@ -650,13 +717,23 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
       }
       else
       {
+        #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
         // select the device
         Select( );
+        #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 
         // process the sub command
         switch( nCmd )
         {
           case MMCSDHANDLER_GET_SECTOR_COUNT :
+            #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+            // get the image size
+            if ( fseek( ptImage, 0, SEEK_END ) == 0 )
+            {
+              *( PU32 )pvBuffer = ( U32 )( ftell( ptImage ) / MMCSDHANDLER_BLK_SIZE );
+              eResult = MMCSDHANDLER_RES_OK;
+            }
+            #else
             // get the sector count
             if (( SendCmd( CMD9, 0 ) == 0 ) && ( RcvDataBlock( &anCsd[ 0 ], 16 )))
             {
@@ -678,6 +755,7 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
                     // set ok result
                     eResult = MMCSDHANDLER_RES_OK;
             }
+            #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
             break;
 
           case MMCSDHANDLER_GET_SECTOR_SIZE :
@@ -687,14 +765,29 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
             break;
 
           case MMCSDHANDLER_CTRL_SYNC :
+            #if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+            // write back the cache
+            if ( !CacheFlush( ))
+            {
+              break;
+            }
+            #endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+
+            #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+            // flush the image
+            fflush( ptImage );
+            eResult = MMCSDHANDLER_RES_OK;
+            #else
             // check for ready
             if ( Select( ))
             {
               // set good response
               eResult = MMCSDHANDLER_RES_OK;
             }
+            #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
             break;
 
+          #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
           case MMCSDHANDLER_GET_CSD :
             // get the current CSD
             if (( SendCmd( CMD9, 0 ) == 0 ) && ( RcvDataBlock( pvBuffer, 16 )))
@@ -723,10 +816,12 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
               eResult = MMCSDHANDLER_RES_OK;
             }
             break;
+          #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
                   
           case MMCSDHANDLER_GET_TYPE :
             // return the type
             *( PU8 )pvBuffer = nCardType;
+            eResult = MMCSDHANDLER_RES_OK;
             break;
                   
           default :
@@ -734,8 +829,10 @@ MMCSDHANDLERRESULT MmcSdHandler_Ioctl( U8 nDrive, U8 nCmd, PVOID pvBuffer )
             break;
         }
 
+        #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
         // deselect/idle
         Deselect( );
+        #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
       }
     }
   }
@@ -776,6 +873,660 @@ PC8 MmcSdHandler_GetErrorString( U8 nError )
   return( pvString );  
 }
 
+/******************************************************************************
+ * @function CardReadStart
+ *
+ * @brief start a read stream
+ *
+ * This function will start a single/multiple block read
+ *
+ * @param[in]   uSector     starting sector
+ * @param[in]   nCount      number of sectors
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardReadStart( U32 uSector, U8 nCount )
+{
+  BOOL  bStatus;
+
+  // increment the command count
+  tStats.uReadCmds++;
+
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+  // position the image
+  ( void )nCount;
+  bStatus = ( fseek( ptImage, ( long )uSector * MMCSDHANDLER_BLK_SIZE, SEEK_SET ) == 0 ) ? TRUE : FALSE;
+  #else
+  // convert to byte address if needed
+  if ( !( nCardType & CARD_TYPE_BLK ))
+  {
+    // convert to sector address
+    uSector *= MMCSDHANDLER_BLK_SIZE;
+  }
+
+  // single or multiple block read
+  bStatus = ( SendCmd(( nCount == 1 ) ? CMD17 : CMD18, uSector ) == 0 ) ? TRUE : FALSE;
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardReadBlock
+ *
+ * @brief read the next block of a stream
+ *
+ * This function will read the next block of a read stream
+ *
+ * @param[io]   pnBuffer    pointer to the block
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardReadBlock( PU8 pnBuffer )
+{
+  BOOL  bStatus;
+
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+  // read the block
+  bStatus = ( fread( pnBuffer, MMCSDHANDLER_BLK_SIZE, 1, ptImage ) == 1 ) ? TRUE : FALSE;
+  #else
+  // read the block
+  bStatus = RcvDataBlock( pnBuffer, MMCSDHANDLER_BLK_SIZE );
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+
+  // if good, count it
+  if ( bStatus )
+  {
+    tStats.uSectorsRead++;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardReadStop
+ *
+ * @brief stop a read stream
+ *
+ * This function will terminate a multiple block read and release the card
+ *
+ * @param[in]   nCount      number of sectors in the stream
+ *
+ *****************************************************************************/
+static void CardReadStop( U8 nCount )
+{
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+  // terminate a multiple block read
+  if ( nCount > 1 )
+  {
+    SendCmd( CMD12, 0 );
+  }
+
+  // deselect/idle
+  Deselect( );
+  #else
+  // nothing to do
+  ( void )nCount;
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+}
+
+/******************************************************************************
+ * @function CardWriteStart
+ *
+ * @brief start a write stream
+ *
+ * This function will start a single/multiple block write, pre-erasing
+ * the blocks on SD cards
+ *
+ * @param[in]   uSector     starting sector
+ * @param[in]   nCount      number of sectors
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardWriteStart( U32 uSector, U8 nCount )
+{
+  BOOL  bStatus;
+
+  // increment the command count
+  tStats.uWriteCmds++;
+
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+  // position the image
+  ( void )nCount;
+  bStatus = ( fseek( ptImage, ( long )uSector * MMCSDHANDLER_BLK_SIZE, SEEK_SET ) == 0 ) ? TRUE : FALSE;
+  #else
+  // convert to byte address if needed
+  if ( !( nCardType & CARD_TYPE_BLK ))
+  {
+    // convert to sector address
+    uSector *= MMCSDHANDLER_BLK_SIZE;
+  }
+
+  // check for single block
+  if ( nCount == 1 )
+  {
+    // single block write
+    bStatus = ( SendCmd( CMD24, uSector ) == 0 ) ? TRUE : FALSE;
+  }
+  else
+  {
+    // pre-erase the blocks
+    if ( nCardType & CARD_TYPE_SDC )
+    {
+      SendCmd( ACMD23, nCount );
+    }
+
+    // multiple block write
+    bStatus = ( SendCmd( CMD25, uSector ) == 0 ) ? TRUE : FALSE;
+  }
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardWriteBlock
+ *
+ * @brief write the next block of a stream
+ *
+ * This function will write the next block of a write stream
+ *
+ * @param[in]   pnBuffer    pointer to the block
+ * @param[in]   nCount      number of sectors in the stream
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardWriteBlock( const U8* pnBuffer, U8 nCount )
+{
+  BOOL  bStatus;
+
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+  // write the block
+  ( void )nCount;
+  bStatus = ( fwrite( pnBuffer, MMCSDHANDLER_BLK_SIZE, 1, ptImage ) == 1 ) ? TRUE : FALSE;
+  #else
+  // write the block with the appropriate token
+  bStatus = XmtDataBlock(( PU8 )pnBuffer, ( nCount == 1 ) ? TOKEN_SINGLE_BLOCK : TOKEN_MULTI_BLOCK );
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_FILE )
+
+  // if good, count it
+  if ( bStatus )
+  {
+    tStats.uSectorsWritten++;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardWriteStop
+ *
+ * @brief stop a write stream
+ *
+ * This function will terminate a multiple block write and release the card
+ *
+ * @param[in]   nCount      number of sectors in the stream
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardWriteStop( U8 nCount )
+{
+  BOOL  bStatus = TRUE;
+
+  #if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+  // send the stop token for a multiple block write
+  if ( nCount > 1 )
+  {
+    bStatus = XmtDataBlock( NULL, TOKEN_STOP_TRAN );
+  }
+
+  // deselect/idle
+  Deselect( );
+  #else
+  // nothing to do
+  ( void )nCount;
+  #endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardRead
+ *
+ * @brief read sectors from the card
+ *
+ * This function will read a run of sectors in a single stream
+ *
+ * @param[io]   pnBuffer    pointer to the data buffer
+ * @param[in]   uSector     starting sector
+ * @param[in]   nCount      number of sectors
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardRead( PU8 pnBuffer, U32 uSector, U8 nCount )
+{
+  BOOL  bStatus;
+  U8    nIndex;
+
+  // start the stream
+  if (( bStatus = CardReadStart( uSector, nCount )) == TRUE )
+  {
+    // read each block
+    for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
+    {
+      bStatus = CardReadBlock( pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ));
+    }
+
+    // stop the stream
+    CardReadStop( nCount );
+  }
+  else
+  {
+    // just release the card
+    CardReadStop( 1 );
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CardWrite
+ *
+ * @brief write sectors to the card
+ *
+ * This function will write a run of sectors in a single stream
+ *
+ * @param[in]   pnBuffer    pointer to the data buffer
+ * @param[in]   uSector     starting sector
+ * @param[in]   nCount      number of sectors
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CardWrite( const U8* pnBuffer, U32 uSector, U8 nCount )
+{
+  BOOL  bStatus;
+  U8    nIndex;
+
+  // start the stream
+  if (( bStatus = CardWriteStart( uSector, nCount )) == TRUE )
+  {
+    // write each block
+    for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
+    {
+      bStatus = CardWriteBlock( pnBuffer + ( nIndex * MMCSDHANDLER_BLK_SIZE ), nCount );
+    }
+
+    // stop the stream
+    bStatus &= CardWriteStop( nCount );
+  }
+  else
+  {
+    // just release the card
+    CardWriteStop( 1 );
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+#if ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+/******************************************************************************
+ * @function CacheInvalidate
+ *
+ * @brief invalidate the cache
+ *
+ * This function will discard all cached sectors
+ *
+ *****************************************************************************/
+static void CacheInvalidate( void )
+{
+  U8  nIndex;
+
+  // for each entry
+  for ( nIndex = 0; nIndex < MMCSDHANDLER_CACHE_NUM_SECTORS; nIndex++ )
+  {
+    // clear it
+    atCacheEnts[ nIndex ].uSector = ILLEGAL_SECTOR;
+    atCacheEnts[ nIndex ].uStamp = 0;
+    atCacheEnts[ nIndex ].bValid = FALSE;
+    atCacheEnts[ nIndex ].bDirty = FALSE;
+  }
+
+  // reset the stamp/sequential detect
+  uCacheStamp = 0;
+  uLastReadSector = ILLEGAL_SECTOR;
+}
+
+/******************************************************************************
+ * @function CacheLookup
+ *
+ * @brief find a sector in the cache
+ *
+ * This function will return the entry that holds the sector
+ *
+ * @param[in]   uSector     sector
+ *
+ * @return      pointer to the entry or NULL if not cached
+ *
+ *****************************************************************************/
+static PCACHEENT CacheLookup( U32 uSector )
+{
+  PCACHEENT ptEnt = NULL;
+  U8        nIndex;
+
+  // for each entry
+  for ( nIndex = 0; ( nIndex < MMCSDHANDLER_CACHE_NUM_SECTORS ) && ( ptEnt == NULL ); nIndex++ )
+  {
+    // check for a match
+    if (( atCacheEnts[ nIndex ].bValid ) && ( atCacheEnts[ nIndex ].uSector == uSector ))
+    {
+      ptEnt = &atCacheEnts[ nIndex ];
+    }
+  }
+
+  // return the entry
+  return( ptEnt );
+}
+
+/******************************************************************************
+ * @function CacheAllocate
+ *
+ * @brief allocate cache entries
+ *
+ * This function will select the least recently used entries, writing back
+ * the cache first if any of them are dirty.  The selected entries are
+ * returned invalidated
+ *
+ * @param[in]   nCount      number of entries requested
+ * @param[io]   pnSlots     pointer to the storage for the slot indices
+ *
+ * @return      the number of entries allocated, 0 on a write back error
+ *
+ *****************************************************************************/
+static U8 CacheAllocate( U8 nCount, PU8 pnSlots )
+{
+  BOOL  bDirty = FALSE;
+  U8    nSlot, nIndex, nBest, nChosen;
+
+  // clamp the count
+  nCount = MIN( nCount, MMCSDHANDLER_CACHE_NUM_SECTORS );
+
+  // select each slot
+  for ( nSlot = 0; nSlot < nCount; nSlot++ )
+  {
+    // find the oldest entry not yet chosen, free entries first
+    nBest = MMCSDHANDLER_CACHE_NUM_SECTORS;
+    for ( nIndex = 0; nIndex < MMCSDHANDLER_CACHE_NUM_SECTORS; nIndex++ )
+    {
+      // skip entries already chosen
+      for ( nChosen = 0; ( nChosen < nSlot ) && ( pnSlots[ nChosen ] != nIndex ); nChosen++ );
+      if ( nChosen == nSlot )
+      {
+        // check for better
+        if (( nBest == MMCSDHANDLER_CACHE_NUM_SECTORS ) ||
+            ( !atCacheEnts[ nIndex ].bValid && atCacheEnts[ nBest ].bValid ) ||
+            (( atCacheEnts[ nIndex ].bValid == atCacheEnts[ nBest ].bValid ) && ( atCacheEnts[ nIndex ].uStamp < atCacheEnts[ nBest ].uStamp )))
+        {
+          nBest = nIndex;
+        }
+      }
+    }
+
+    // store it/flag dirty victims
+    pnSlots[ nSlot ] = nBest;
+    bDirty |= ( atCacheEnts[ nBest ].bValid && atCacheEnts[ nBest ].bDirty );
+  }
+
+  // write back the cache if a victim is dirty
+  if (( bDirty ) && ( !CacheFlush( )))
+  {
+    // nothing allocated
+    nCount = 0;
+  }
+
+  // invalidate the chosen entries
+  for ( nSlot = 0; nSlot < nCount; nSlot++ )
+  {
+    atCacheEnts[ pnSlots[ nSlot ]].bValid = FALSE;
+    atCacheEnts[ pnSlots[ nSlot ]].bDirty = FALSE;
+  }
+
+  // return the count
+  return( nCount );
+}
+
+/******************************************************************************
+ * @function CacheRead
+ *
+ * @brief read a sector through the cache
+ *
+ * This function will return a sector from the cache, loading it on a miss.
+ * A miss on the sector following the previous read is treated as a
+ * sequential read and the following uncached sectors are loaded in the
+ * same stream
+ *
+ * @param[io]   pnBuffer    pointer to the data buffer
+ * @param[in]   uSector     sector
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CacheRead( PU8 pnBuffer, U32 uSector )
+{
+  BOOL      bStatus = TRUE;
+  PCACHEENT ptEnt;
+  U8        nCount, nIndex;
+  U8        anSlots[ MMCSDHANDLER_CACHE_NUM_SECTORS ];
+
+  // check for a hit
+  if (( ptEnt = CacheLookup( uSector )) != NULL )
+  {
+    // count it/update the stamp
+    tStats.uCacheHits++;
+    ptEnt->uStamp = ++uCacheStamp;
+  }
+  else
+  {
+    // count it
+    tStats.uCacheMisses++;
+
+    // on a sequential miss, read ahead over the following uncached sectors
+    nCount = 1;
+    if ( uSector == ( uLastReadSector + 1 ))
+    {
+      while (( nCount < MIN( MMCSDHANDLER_CACHE_READAHEAD, MMCSDHANDLER_CACHE_NUM_SECTORS )) && ( CacheLookup( uSector + nCount ) == NULL ))
+      {
+        nCount++;
+      }
+    }
+
+    // allocate the entries/start the stream
+    if ((( nCount = CacheAllocate( nCount, anSlots )) != 0 ) && ( CardReadStart( uSector, nCount )))
+    {
+      // read each block
+      for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
+      {
+        // read it into the entry
+        if (( bStatus = CardReadBlock( anCacheData[ anSlots[ nIndex ]] )) == TRUE )
+        {
+          // validate the entry
+          ptEnt = &atCacheEnts[ anSlots[ nIndex ]];
+          ptEnt->uSector = uSector + nIndex;
+          ptEnt->uStamp = ++uCacheStamp;
+          ptEnt->bValid = TRUE;
+        }
+      }
+
+      // stop the stream
+      CardReadStop( nCount );
+
+      // requested sector is the first entry
+      ptEnt = &atCacheEnts[ anSlots[ 0 ]];
+      bStatus = ptEnt->bValid;
+    }
+    else
+    {
+      // release the card/set the error
+      CardReadStop( 1 );
+      bStatus = FALSE;
+    }
+  }
+
+  // copy the data
+  if ( bStatus )
+  {
+    memcpy( pnBuffer, anCacheData[ ptEnt - atCacheEnts ], MMCSDHANDLER_BLK_SIZE );
+  }
+
+  // remember the sector for sequential detection
+  uLastReadSector = uSector;
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CacheWrite
+ *
+ * @brief write a sector into the cache
+ *
+ * This function will store a sector in the cache and mark it dirty, it is
+ * written to the card when evicted or on a sync
+ *
+ * @param[in]   pnBuffer    pointer to the data buffer
+ * @param[in]   uSector     sector
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CacheWrite( const U8* pnBuffer, U32 uSector )
+{
+  BOOL      bStatus = TRUE;
+  PCACHEENT ptEnt;
+  U8        nSlot;
+
+  // check for a miss
+  if (( ptEnt = CacheLookup( uSector )) == NULL )
+  {
+    // allocate an entry
+    if ( CacheAllocate( 1, &nSlot ) != 0 )
+    {
+      // set the sector
+      ptEnt = &atCacheEnts[ nSlot ];
+      ptEnt->uSector = uSector;
+      ptEnt->bValid = TRUE;
+    }
+    else
+    {
+      // set the error
+      bStatus = FALSE;
+    }
+  }
+
+  // check for an entry
+  if ( bStatus )
+  {
+    // copy the data/mark it dirty
+    memcpy( anCacheData[ ptEnt - atCacheEnts ], pnBuffer, MMCSDHANDLER_BLK_SIZE );
+    ptEnt->uStamp = ++uCacheStamp;
+    ptEnt->bDirty = TRUE;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CacheFlush
+ *
+ * @brief write back the cache
+ *
+ * This function will write all dirty entries to the card, coalescing runs
+ * of consecutive sectors into a single stream
+ *
+ * @return      TRUE if no errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CacheFlush( void )
+{
+  BOOL      bStatus = TRUE;
+  PCACHEENT ptEnt;
+  U8        nIndex, nFirst, nCount;
+  U8        anSlots[ MMCSDHANDLER_CACHE_NUM_SECTORS ];
+
+  // while dirty entries remain
+  while ( bStatus )
+  {
+    // find the lowest dirty sector
+    nFirst = MMCSDHANDLER_CACHE_NUM_SECTORS;
+    for ( nIndex = 0; nIndex < MMCSDHANDLER_CACHE_NUM_SECTORS; nIndex++ )
+    {
+      if (( atCacheEnts[ nIndex ].bValid ) && ( atCacheEnts[ nIndex ].bDirty ) &&
+          (( nFirst == MMCSDHANDLER_CACHE_NUM_SECTORS ) || ( atCacheEnts[ nIndex ].uSector < atCacheEnts[ nFirst ].uSector )))
+      {
+        nFirst = nIndex;
+      }
+    }
+
+    // exit if none
+    if ( nFirst == MMCSDHANDLER_CACHE_NUM_SECTORS )
+    {
+      break;
+    }
+
+    // gather the run of consecutive dirty sectors
+    anSlots[ 0 ] = nFirst;
+    nCount = 1;
+    while (( nCount < MMCSDHANDLER_CACHE_NUM_SECTORS ) &&
+           (( ptEnt = CacheLookup( atCacheEnts[ nFirst ].uSector + nCount )) != NULL ) && ( ptEnt->bDirty ))
+    {
+      anSlots[ nCount++ ] = ( U8 )( ptEnt - atCacheEnts );
+    }
+
+    // write the run
+    if (( bStatus = CardWriteStart( atCacheEnts[ nFirst ].uSector, nCount )) == TRUE )
+    {
+      // write each block
+      for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
+      {
+        bStatus = CardWriteBlock( anCacheData[ anSlots[ nIndex ]], nCount );
+      }
+
+      // stop the stream
+      bStatus &= CardWriteStop( nCount );
+    }
+    else
+    {
+      // just release the card
+      CardWriteStop( 1 );
+    }
+
+    // if good, the entries are now clean
+    for ( nIndex = 0; ( nIndex < nCount ) && bStatus; nIndex++ )
+    {
+      atCacheEnts[ anSlots[ nIndex ]].bDirty = FALSE;
+    }
+  }
+
+  // return the status
+  return( bStatus );
+}
+#endif // ( MMCSDHANDLER_CACHE_NUM_SECTORS != 0 )
+
+#if ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
 /******************************************************************************
  * @function RcvDataBlock
  *
@@ -846,7 +1597,7 @@ static BOOL XmtDataBlock( PU8 pnBuffer, U8 nCmd )
     Spi_Write( MMCSDHANDLER_SPI_DEV_ENUM, nCmd );
 
     // is this a data toekn
-    if ( nCmd != 0xFD )
+    if ( nCmd != TOKEN_STOP_TRAN )
     {
       // write the buffer
       Spi_WriteBlock( MMCSDHANDLER_SPI_DEV_ENUM, pnBuffer, MMCSDHANDLER_BLK_SIZE, FALSE );
@@ -863,6 +1614,11 @@ static BOOL XmtDataBlock( PU8 pnBuffer, U8 nCmd )
         bStatus = TRUE;
       }
     }
+    else
+    {
+      // stop token has no response
+      bStatus = TRUE;
+    }
   }
 
   // return the status
@@ -1076,4 +1832,6 @@ static BOOL WaitReady( U16 wMilliseconds )
   return(( nTemp == 0xFF ) ? TRUE : FALSE );
 }
 
+#endif // ( MMCSDHANDLER_BACKEND == MMCSDHANDLER_BACKEND_SPI )
+
 /**@} EOF MmcSdHandler.c */
@@ -30,7 +30,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
-#include "MMcSdHandler/MmcSdHandler_prm.h"
+#include "MmcSdHandler/MmcSdHandler_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "TaskManager/TaskManager.h"
@@ -66,6 +66,10 @@
 #define MMCSDHANDLER_GET_OCR                    ( 13 )
 #define MMCSDHANDLER_GET_SDSTAT                 ( 14 )
 
+/// handler statistics
+#define MMCSDHANDLER_GET_STATS                  ( 20 )
+#define MMCSDHANDLER_CLR_STATS                  ( 21 )
+
 // enumerations ---------------------------------------------------------------
 // enumerate the result
 typedef enum 	_MMCSDHANDLERRESULT
@@ -78,6 +82,17 @@ typedef enum 	_MMCSDHANDLERRESULT
 } MMCSDHANDLERRESULT;
 
 // structures -----------------------------------------------------------------
+/// define the statistics structure
+typedef struct _MMCSDHANDLERSTATS
+{
+  U32   uReadCmds;                ///< single/multiple block read commands
+  U32   uWriteCmds;               ///< single/multiple block write commands
+  U32   uSectorsRead;             ///< sectors read from the card
+  U32   uSectorsWritten;          ///< sectors written to the card
+  U32   uCacheHits;               ///< sector reads satisfied by the cache
+  U32   uCacheMisses;             ///< sector reads that went to the card
+} MMCSDHANDLERSTATS, *PMMCSDHANDLERSTATS;
+#define MMCSDHANDLERSTATS_SIZE                  sizeof( MMCSDHANDLERSTATS )
 
 // global parameter declarations -----------------------------------------------
 
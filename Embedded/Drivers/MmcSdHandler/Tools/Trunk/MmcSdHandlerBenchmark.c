@@ -0,0 +1,701 @@
+/******************************************************************************
+ * @file MmcSdHandlerBenchmark.c
+ *
+ * @brief MMC/SD card handler benchmark
+ *
+ * This file provides a host tool that runs the card handler over the file
+ * backed card emulation.  The raw checks fill the start of the card with a
+ * known pattern and check that single sector sequential reads are loaded by
+ * the read ahead, that a run of cached writes in any order is written back as
+ * a single stream on a sync, and then run a random mix of short cached and
+ * long bypassing reads/writes and syncs against a reference, checking every
+ * read and, after the final sync, the image file byte for byte.  The file
+ * system part formats the card with FATFS, writes a large file and a set of
+ * small files in odd sized chunks, reinitializes the drive to discard the
+ * cache and reads them all back, checking each byte and reporting the
+ * throughput and the handler statistics for each pass.  It exits non zero on
+ * any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -I<fatfs>/Core/Main/Trunk
+ *             -I<fatfs>/Config/Trunk -o MmcSdHandlerBenchmark
+ *             MmcSdHandlerBenchmark.c ../../Core/Trunk/MmcSdHandler.c
+ *             <fatfs>/Core/Main/Trunk/ff.c <fatfs>/Config/Trunk/diskio.c
+ * usage:      MmcSdHandlerBenchmark [operations] [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup MmcSdHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "MmcSdHandler/MmcSdHandler.h"
+
+// library includes -----------------------------------------------------------
+#include "ff.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of operations/seed
+#define DEFAULT_OPERATIONS                          ( 20000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the size of the emulated card in sectors, 32MB
+#define CARD_SECTORS                                ( 65536 )
+
+/// define the number of sectors covered by the raw checks
+#define RAW_SECTORS                                 ( 4096 )
+
+/// define the longest random transfer
+#define MAX_XFER_SECTORS                            ( 16 )
+
+/// define the allocation unit for the format
+#define FORMAT_AU_BYTES                             ( 4096 )
+
+/// define the large file size/write and read chunks
+#define LARGE_FILE_SIZE                             ( 8ul * 1024 * 1024 )
+#define LARGE_WRITE_CHUNK                           ( 700 )
+#define LARGE_READ_CHUNK                            ( 1000 )
+
+/// define the number of small files/longest small file
+#define NUM_SMALL_FILES                             ( 200 )
+#define MAX_SMALL_FILE_SIZE                         ( 3000 )
+
+/// define the pattern seeds
+#define LARGE_FILE_SEED                             ( 0x1234567 )
+#define SMALL_FILE_SEED                             ( 0x7654321 )
+
+// local parameter declarations -----------------------------------------------
+static  U32     uRandom;
+static  U32     uErrors;
+static  PU8     pnReference;
+static  FATFS   tFatFs;
+
+// local function prototypes --------------------------------------------------
+static  U32     Random( U32 uRange );
+static  U8      Pattern( PU32 puState );
+static  void    Check( BOOL bCondition, PC8 pszWhat );
+static  double  GetSeconds( void );
+static  void    GetStats( PMMCSDHANDLERSTATS ptStats );
+static  void    ClearStats( void );
+static  void    ReportStats( PC8 pszWhat, U32 uBytes, double dSeconds );
+static  BOOL    CreateImage( void );
+static  BOOL    CompareImage( U32 uSector, U32 uCount );
+static  void    CheckReadAhead( void );
+static  void    CheckCoalesce( void );
+static  void    RunRandom( U32 uOperations );
+static  void    RunFileSystem( void );
+static  void    WriteLargeFile( void );
+static  void    ReadLargeFile( PC8 pszWhat );
+static  void    WriteSmallFiles( void );
+static  void    ReadSmallFiles( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  U32 uOperations = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : DEFAULT_OPERATIONS;
+
+  // create the card/initialize the handler
+  uRandom = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+  if (( pnReference = malloc( RAW_SECTORS * MMCSDHANDLER_BLK_SIZE )) == NULL )
+  {
+    fprintf( stderr, "unable to allocate the reference\n" );
+    return( 1 );
+  }
+  MmcSdHandler_Initialize( );
+  if (( CreateImage( )) || ( MmcSdHandler_InitializeDrive( 0 ) & MMCSDHANDLER_STS_NOINIT ))
+  {
+    fprintf( stderr, "unable to create %s\n", MMCSDHANDLER_FILE_IMAGE_NAME );
+    return( 1 );
+  }
+
+  // run the raw checks
+  CheckReadAhead( );
+  CheckCoalesce( );
+  RunRandom( uOperations );
+
+  // run the file system
+  RunFileSystem( );
+
+  // report
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", ( unsigned )uErrors );
+  free( pnReference );
+  remove( MMCSDHANDLER_FILE_IMAGE_NAME );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function get_fattime
+ *
+ * @brief FATFS time stamp
+ *
+ * This function returns a fixed time stamp, 2015-01-01 00:00:00
+ *
+ * @return      packed time
+ *
+ *****************************************************************************/
+DWORD get_fattime( void )
+{
+  return((( DWORD )( 2015 - 1980 ) << 25 ) | (( DWORD )1 << 21 ) | (( DWORD )1 << 16 ));
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief random number
+ *
+ * @param[in]   uRange    range
+ *
+ * @return      random number below the range
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // xorshift
+  uRandom ^= uRandom << 13;
+  uRandom ^= uRandom >> 17;
+  uRandom ^= uRandom << 5;
+  return( uRandom % uRange );
+}
+
+/******************************************************************************
+ * @function Pattern
+ *
+ * @brief next pattern byte
+ *
+ * This function returns the next byte of a repeatable pattern so the file
+ * contents can be regenerated for the read back
+ *
+ * @param[io]   puState   pointer to the pattern state
+ *
+ * @return      pattern byte
+ *
+ *****************************************************************************/
+static U8 Pattern( PU32 puState )
+{
+  // linear congruential
+  *puState = ( *puState * 1103515245ul ) + 12345;
+  return(( U8 )( *puState >> 16 ));
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * @param[in]   bCondition  condition that must be true
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, PC8 pszWhat )
+{
+  // report the first few failures
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      fprintf( stderr, "fail: %s\n", pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function GetSeconds
+ *
+ * @brief get the monotonic time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time in seconds
+ *
+ *****************************************************************************/
+static double GetSeconds( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/******************************************************************************
+ * @function GetStats
+ *
+ * @brief get the handler statistics
+ *
+ * @param[io]   ptStats     pointer to store the statistics
+ *
+ *****************************************************************************/
+static void GetStats( PMMCSDHANDLERSTATS ptStats )
+{
+  // get them
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_GET_STATS, ptStats ) == MMCSDHANDLER_RES_OK, "get statistics" );
+}
+
+/******************************************************************************
+ * @function ClearStats
+ *
+ * @brief clear the handler statistics
+ *
+ *****************************************************************************/
+static void ClearStats( void )
+{
+  // clear them
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CLR_STATS, NULL ) == MMCSDHANDLER_RES_OK, "clear statistics" );
+}
+
+/******************************************************************************
+ * @function ReportStats
+ *
+ * @brief report the throughput and statistics of a pass
+ *
+ * @param[in]   pszWhat     description
+ * @param[in]   uBytes      bytes transferred by the pass
+ * @param[in]   dSeconds    time taken
+ *
+ *****************************************************************************/
+static void ReportStats( PC8 pszWhat, U32 uBytes, double dSeconds )
+{
+  MMCSDHANDLERSTATS tStats;
+
+  // get them/report
+  GetStats( &tStats );
+  printf( "%-22s %7.1f MB/s, %6u rd cmds %7u sectors, %6u wr cmds %7u sectors, %7u hits %6u misses\n",
+          pszWhat, ( uBytes / ( 1024.0 * 1024.0 )) / dSeconds,
+          ( unsigned )tStats.uReadCmds, ( unsigned )tStats.uSectorsRead,
+          ( unsigned )tStats.uWriteCmds, ( unsigned )tStats.uSectorsWritten,
+          ( unsigned )tStats.uCacheHits, ( unsigned )tStats.uCacheMisses );
+}
+
+/******************************************************************************
+ * @function CreateImage
+ *
+ * @brief create the card image
+ *
+ * This function creates the image, the raw check area is filled with random
+ * data and mirrored in the reference, the rest is zero
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL CreateImage( void )
+{
+  FILE* pfImage;
+  BOOL  bStatus = TRUE;
+  U32   uIdx;
+
+  // fill the reference
+  for ( uIdx = 0; uIdx < RAW_SECTORS * MMCSDHANDLER_BLK_SIZE; uIdx++ )
+  {
+    pnReference[ uIdx ] = ( U8 )Random( 256 );
+  }
+
+  // write the raw area, then extend to the card size
+  if (( pfImage = fopen( MMCSDHANDLER_FILE_IMAGE_NAME, "wb" )) != NULL )
+  {
+    bStatus = (( fwrite( pnReference, MMCSDHANDLER_BLK_SIZE, RAW_SECTORS, pfImage ) == RAW_SECTORS ) &&
+               ( fseek( pfImage, (( long )CARD_SECTORS * MMCSDHANDLER_BLK_SIZE ) - 1, SEEK_SET ) == 0 ) &&
+               ( fputc( 0, pfImage ) == 0 )) ? FALSE : TRUE;
+    fclose( pfImage );
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CompareImage
+ *
+ * @brief compare the image file with the reference
+ *
+ * @param[in]   uSector     first sector
+ * @param[in]   uCount      number of sectors
+ *
+ * @return      TRUE if the image matches
+ *
+ *****************************************************************************/
+static BOOL CompareImage( U32 uSector, U32 uCount )
+{
+  FILE* pfImage;
+  PU8   pnImage;
+  BOOL  bMatch = FALSE;
+
+  // open it/read it/compare it
+  if (( pnImage = malloc( uCount * MMCSDHANDLER_BLK_SIZE )) != NULL )
+  {
+    if (( pfImage = fopen( MMCSDHANDLER_FILE_IMAGE_NAME, "rb" )) != NULL )
+    {
+      bMatch = (( fseek( pfImage, ( long )uSector * MMCSDHANDLER_BLK_SIZE, SEEK_SET ) == 0 ) &&
+                ( fread( pnImage, MMCSDHANDLER_BLK_SIZE, uCount, pfImage ) == uCount ) &&
+                ( memcmp( pnImage, &pnReference[ uSector * MMCSDHANDLER_BLK_SIZE ], uCount * MMCSDHANDLER_BLK_SIZE ) == 0 )) ? TRUE : FALSE;
+      fclose( pfImage );
+    }
+    free( pnImage );
+  }
+
+  // return the result
+  return( bMatch );
+}
+
+/******************************************************************************
+ * @function CheckReadAhead
+ *
+ * @brief check the read ahead
+ *
+ * This function reads the raw area one sector at a time in order, after the
+ * first miss each miss should load the read ahead count in one stream
+ *
+ *****************************************************************************/
+static void CheckReadAhead( void )
+{
+  MMCSDHANDLERSTATS tStats;
+  U8                anData[ MMCSDHANDLER_BLK_SIZE ];
+  U32               uSector, uMaxMisses;
+  BOOL              bMatch = TRUE;
+  double            dStart;
+
+  // read it all, a sector at a time, starting past sector 0 so the first
+  // read is not taken as sequential
+  ClearStats( );
+  dStart = GetSeconds( );
+  for ( uSector = 1; uSector < RAW_SECTORS; uSector++ )
+  {
+    bMatch &= (( MmcSdHandler_Read( 0, anData, uSector, 1 ) == MMCSDHANDLER_RES_OK ) &&
+               ( memcmp( anData, &pnReference[ uSector * MMCSDHANDLER_BLK_SIZE ], MMCSDHANDLER_BLK_SIZE ) == 0 )) ? TRUE : FALSE;
+  }
+  ReportStats( "sequential sectors", ( RAW_SECTORS - 1 ) * MMCSDHANDLER_BLK_SIZE, GetSeconds( ) - dStart );
+  Check( bMatch, "sequential read data" );
+
+  // one miss, then one miss per read ahead run, the last run may read past the end
+  GetStats( &tStats );
+  uMaxMisses = 1 + ((( RAW_SECTORS - 2 ) + MMCSDHANDLER_CACHE_READAHEAD - 1 ) / MMCSDHANDLER_CACHE_READAHEAD );
+  Check( tStats.uCacheMisses <= uMaxMisses, "read ahead misses" );
+  Check( tStats.uReadCmds == tStats.uCacheMisses, "one command per miss" );
+  Check(( tStats.uSectorsRead >= ( RAW_SECTORS - 1 )) && ( tStats.uSectorsRead < ( RAW_SECTORS - 1 + MMCSDHANDLER_CACHE_READAHEAD )), "each sector read once" );
+  Check(( tStats.uCacheHits + tStats.uCacheMisses ) == ( RAW_SECTORS - 1 ), "hits and misses" );
+}
+
+/******************************************************************************
+ * @function CheckCoalesce
+ *
+ * @brief check the write back coalescing
+ *
+ * This function writes a run of sectors, one at a time in a scrambled order,
+ * checks nothing reaches the card before the sync and that the sync writes
+ * the run in a single stream
+ *
+ *****************************************************************************/
+static void CheckCoalesce( void )
+{
+  static  const U8  anOrder[ ] = { 5, 2, 7, 0, 3, 6, 1, 4 };
+  MMCSDHANDLERSTATS tStats;
+  U32               uBase = RAW_SECTORS / 2, uSector;
+  U16               wIdx;
+  U8                nIdx;
+
+  // start clean
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CTRL_SYNC, NULL ) == MMCSDHANDLER_RES_OK, "initial sync" );
+  ClearStats( );
+
+  // write the run through the cache
+  for ( nIdx = 0; nIdx < MIN( sizeof( anOrder ), MMCSDHANDLER_CACHE_NUM_SECTORS ); nIdx++ )
+  {
+    uSector = uBase + anOrder[ nIdx ];
+    for ( wIdx = 0; wIdx < MMCSDHANDLER_BLK_SIZE; wIdx++ )
+    {
+      pnReference[ ( uSector * MMCSDHANDLER_BLK_SIZE ) + wIdx ] = ( U8 )Random( 256 );
+    }
+    Check( MmcSdHandler_Write( 0, &pnReference[ uSector * MMCSDHANDLER_BLK_SIZE ], uSector, 1 ) == MMCSDHANDLER_RES_OK, "cached write" );
+  }
+  GetStats( &tStats );
+  Check( tStats.uWriteCmds == 0, "writes held in the cache" );
+
+  // sync it, one stream
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CTRL_SYNC, NULL ) == MMCSDHANDLER_RES_OK, "coalesce sync" );
+  GetStats( &tStats );
+  Check( tStats.uWriteCmds == 1, "run written in one stream" );
+  Check( tStats.uSectorsWritten == nIdx, "each sector written once" );
+  Check( CompareImage( uBase, nIdx ), "image after coalesce" );
+  printf( "coalesce: %u sectors written in %u stream\n", ( unsigned )tStats.uSectorsWritten, ( unsigned )tStats.uWriteCmds );
+}
+
+/******************************************************************************
+ * @function RunRandom
+ *
+ * @brief random operations
+ *
+ * This function runs random reads, writes and syncs over the raw area,
+ * checking every read against the reference, then syncs and checks the image
+ *
+ * @param[in]   uOperations number of operations
+ *
+ *****************************************************************************/
+static void RunRandom( U32 uOperations )
+{
+  static  U8  anData[ MAX_XFER_SECTORS * MMCSDHANDLER_BLK_SIZE ];
+  U32         uOp, uSector, uIdx, uReads = 0, uWrites = 0, uSyncs = 0;
+  U8          nCount;
+
+  // for each operation
+  for ( uOp = 0; uOp < uOperations; uOp++ )
+  {
+    // pick a run, mostly short ones that go through the cache
+    nCount = ( Random( 4 ) == 0 ) ? 1 + Random( MAX_XFER_SECTORS ) : 1 + Random( MMCSDHANDLER_CACHE_BYPASS_COUNT );
+    uSector = Random( RAW_SECTORS - nCount + 1 );
+    switch( Random( 5 ))
+    {
+      case 0 :
+      case 1 :
+        // write
+        for ( uIdx = 0; uIdx < ( U32 )nCount * MMCSDHANDLER_BLK_SIZE; uIdx++ )
+        {
+          anData[ uIdx ] = ( U8 )Random( 256 );
+        }
+        Check( MmcSdHandler_Write( 0, anData, uSector, nCount ) == MMCSDHANDLER_RES_OK, "write" );
+        memcpy( &pnReference[ uSector * MMCSDHANDLER_BLK_SIZE ], anData, nCount * MMCSDHANDLER_BLK_SIZE );
+        uWrites++;
+        break;
+
+      case 4 :
+        // occasionally sync
+        if ( Random( 8 ) == 0 )
+        {
+          Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CTRL_SYNC, NULL ) == MMCSDHANDLER_RES_OK, "sync" );
+          uSyncs++;
+          break;
+        }
+        // fall through
+
+      default :
+        // read
+        Check(( MmcSdHandler_Read( 0, anData, uSector, nCount ) == MMCSDHANDLER_RES_OK ) &&
+              ( memcmp( anData, &pnReference[ uSector * MMCSDHANDLER_BLK_SIZE ], nCount * MMCSDHANDLER_BLK_SIZE ) == 0 ), "read" );
+        uReads++;
+        break;
+    }
+  }
+
+  // sync it/check the image
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CTRL_SYNC, NULL ) == MMCSDHANDLER_RES_OK, "final sync" );
+  Check( CompareImage( 0, RAW_SECTORS ), "image after sync" );
+  printf( "random: %u writes, %u reads, %u syncs\n", ( unsigned )uWrites, ( unsigned )uReads, ( unsigned )uSyncs );
+}
+
+/******************************************************************************
+ * @function RunFileSystem
+ *
+ * @brief file system benchmark
+ *
+ * This function formats the card, writes the files, then reinitializes the
+ * drive so the read back comes from the image rather than the cache
+ *
+ *****************************************************************************/
+static void RunFileSystem( void )
+{
+  // format/mount it
+  Check( f_mount( &tFatFs, "", 0 ) == FR_OK, "register" );
+  Check( f_mkfs( "", 1, FORMAT_AU_BYTES ) == FR_OK, "format" );
+  Check( f_mount( &tFatFs, "", 1 ) == FR_OK, "mount" );
+
+  // write the files, read the large one back through the cache
+  WriteLargeFile( );
+  ReadLargeFile( "large read, warm" );
+  WriteSmallFiles( );
+
+  // drop the volume, discard the cache and remount
+  Check( f_mount( NULL, "", 0 ) == FR_OK, "unmount" );
+  Check( MmcSdHandler_Ioctl( 0, MMCSDHANDLER_CTRL_SYNC, NULL ) == MMCSDHANDLER_RES_OK, "volume sync" );
+  Check(( MmcSdHandler_InitializeDrive( 0 ) & MMCSDHANDLER_STS_NOINIT ) == 0, "reinitialize" );
+  Check( f_mount( &tFatFs, "", 1 ) == FR_OK, "remount" );
+
+  // read them back from the image
+  ReadLargeFile( "large read, cold" );
+  ReadSmallFiles( );
+  Check( f_mount( NULL, "", 0 ) == FR_OK, "final unmount" );
+}
+
+/******************************************************************************
+ * @function WriteLargeFile
+ *
+ * @brief write the large file
+ *
+ *****************************************************************************/
+static void WriteLargeFile( void )
+{
+  static  U8  anChunk[ LARGE_WRITE_CHUNK ];
+  FIL         tFile;
+  UINT        uWritten;
+  U32         uState = LARGE_FILE_SEED, uOffset, uLength, uIdx;
+  BOOL        bGood;
+  double      dStart;
+
+  // create it
+  ClearStats( );
+  dStart = GetSeconds( );
+  if (( bGood = ( f_open( &tFile, "LARGE.BIN", FA_CREATE_ALWAYS | FA_WRITE ) == FR_OK ) ? TRUE : FALSE ) == TRUE )
+  {
+    // write it in odd sized chunks
+    for ( uOffset = 0; ( uOffset < LARGE_FILE_SIZE ) && bGood; uOffset += uLength )
+    {
+      uLength = MIN( LARGE_WRITE_CHUNK, LARGE_FILE_SIZE - uOffset );
+      for ( uIdx = 0; uIdx < uLength; uIdx++ )
+      {
+        anChunk[ uIdx ] = Pattern( &uState );
+      }
+      bGood = (( f_write( &tFile, anChunk, uLength, &uWritten ) == FR_OK ) && ( uWritten == uLength )) ? TRUE : FALSE;
+    }
+
+    // close it
+    bGood &= ( f_close( &tFile ) == FR_OK ) ? TRUE : FALSE;
+  }
+  ReportStats( "large write", LARGE_FILE_SIZE, GetSeconds( ) - dStart );
+  Check( bGood, "large write" );
+}
+
+/******************************************************************************
+ * @function ReadLargeFile
+ *
+ * @brief read back the large file
+ *
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void ReadLargeFile( PC8 pszWhat )
+{
+  static  U8  anChunk[ LARGE_READ_CHUNK ];
+  FIL         tFile;
+  UINT        uRead;
+  U32         uState = LARGE_FILE_SEED, uOffset = 0, uIdx;
+  BOOL        bGood, bMatch = TRUE;
+  double      dStart;
+
+  // open it
+  ClearStats( );
+  dStart = GetSeconds( );
+  if (( bGood = ( f_open( &tFile, "LARGE.BIN", FA_READ ) == FR_OK ) ? TRUE : FALSE ) == TRUE )
+  {
+    // read it in odd sized chunks, checking each byte
+    while (( bGood = ( f_read( &tFile, anChunk, LARGE_READ_CHUNK, &uRead ) == FR_OK ) ? TRUE : FALSE ) && ( uRead != 0 ))
+    {
+      for ( uIdx = 0; uIdx < uRead; uIdx++ )
+      {
+        bMatch &= ( anChunk[ uIdx ] == Pattern( &uState )) ? TRUE : FALSE;
+      }
+      uOffset += uRead;
+    }
+
+    // close it
+    f_close( &tFile );
+  }
+  ReportStats( pszWhat, LARGE_FILE_SIZE, GetSeconds( ) - dStart );
+  Check( bGood && ( uOffset == LARGE_FILE_SIZE ), "large read" );
+  Check( bMatch, "large read data" );
+}
+
+/******************************************************************************
+ * @function WriteSmallFiles
+ *
+ * @brief write the small files
+ *
+ *****************************************************************************/
+static void WriteSmallFiles( void )
+{
+  static  U8  anData[ MAX_SMALL_FILE_SIZE ];
+  FIL         tFile;
+  UINT        uWritten;
+  C8          szName[ 16 ];
+  U32         uState = SMALL_FILE_SEED, uBytes = 0, uFile, uLength, uIdx;
+  BOOL        bGood = TRUE;
+  double      dStart;
+
+  // for each file
+  ClearStats( );
+  dStart = GetSeconds( );
+  for ( uFile = 0; ( uFile < NUM_SMALL_FILES ) && bGood; uFile++ )
+  {
+    // build it
+    uLength = 1 + ( Pattern( &uState ) * MAX_SMALL_FILE_SIZE / 256 );
+    for ( uIdx = 0; uIdx < uLength; uIdx++ )
+    {
+      anData[ uIdx ] = Pattern( &uState );
+    }
+
+    // write it
+    snprintf( szName, sizeof( szName ), "S%05u.BIN", ( unsigned )uFile );
+    bGood = (( f_open( &tFile, szName, FA_CREATE_ALWAYS | FA_WRITE ) == FR_OK ) &&
+             ( f_write( &tFile, anData, uLength, &uWritten ) == FR_OK ) && ( uWritten == uLength ) &&
+             ( f_close( &tFile ) == FR_OK )) ? TRUE : FALSE;
+    uBytes += uLength;
+  }
+  ReportStats( "small writes", uBytes, GetSeconds( ) - dStart );
+  Check( bGood, "small writes" );
+}
+
+/******************************************************************************
+ * @function ReadSmallFiles
+ *
+ * @brief read back the small files
+ *
+ *****************************************************************************/
+static void ReadSmallFiles( void )
+{
+  static  U8  anData[ MAX_SMALL_FILE_SIZE + 1 ];
+  FIL         tFile;
+  UINT        uRead;
+  C8          szName[ 16 ];
+  U32         uState = SMALL_FILE_SEED, uBytes = 0, uFile, uLength, uIdx;
+  BOOL        bGood = TRUE, bMatch = TRUE;
+  double      dStart;
+
+  // for each file
+  ClearStats( );
+  dStart = GetSeconds( );
+  for ( uFile = 0; ( uFile < NUM_SMALL_FILES ) && bGood; uFile++ )
+  {
+    // read it, asking for one byte more than was written
+    uLength = 1 + ( Pattern( &uState ) * MAX_SMALL_FILE_SIZE / 256 );
+    snprintf( szName, sizeof( szName ), "S%05u.BIN", ( unsigned )uFile );
+    bGood = (( f_open( &tFile, szName, FA_READ ) == FR_OK ) &&
+             ( f_read( &tFile, anData, sizeof( anData ), &uRead ) == FR_OK ) && ( uRead == uLength ) &&
+             ( f_close( &tFile ) == FR_OK )) ? TRUE : FALSE;
+
+    // check it
+    for ( uIdx = 0; uIdx < uLength; uIdx++ )
+    {
+      bMatch &= ( anData[ uIdx ] == Pattern( &uState )) ? TRUE : FALSE;
+    }
+    uBytes += uLength;
+  }
+  ReportStats( "small reads, cold", uBytes, GetSeconds( ) - dStart );
+  Check( bGood, "small reads" );
+  Check( bMatch, "small read data" );
+}
+
+/**@} EOF MmcSdHandlerBenchmark.c */
@@ -37,6 +37,18 @@
 /// define the NEO pixel handler pin
 #define NEOPIXELHANDLER_OUTPUT_PIN            ( PINB4 )
 
+/// enable the bit-banged refresh output
+#define NEOPIXELHANDLER_ENABLE_BITBANG        ( ON )
+
+/// enable the SPI wire-format frame buffers/animation renderer
+#define NEOPIXELHANDLER_ENABLE_SPIFRAME       ( OFF )
+
+/// define the number of SPI bits per pixel data bit ( 3 = 2.4MHz, 4 = 3.2MHz )
+#define NEOPIXELHANDLER_SPI_BITS_PER_BIT      ( 3 )
+
+/// define the reset/latch time appended to each frame in microseconds
+#define NEOPIXELHANDLER_SPI_RESET_USEC        ( 300 )
+
 /**@} EOF NeoPixelHandler_prm.h */
 
 #endif  // _NEOPIXELHANDLER_PRM_H
\ No newline at end of file
@@ -30,7 +30,9 @@
 #include "NeoPixelHandler/NeoPixelHandler_prm.h"
 
 // library includes -----------------------------------------------------------
+#if ( NEOPIXELHANDLER_ENABLE_BITBANG == ON )
 #include "Interrupt/Interrupt.h"
+#endif // NEOPIXELHANDLER_ENABLE_BITBANG
 
 // Macros and Defines ---------------------------------------------------------
 /// define the sizes for an RGB/RGBW devices
@@ -43,6 +45,12 @@
 /// define the pin
 #define NEO_PIXEL_PIN       ( 1 )
 
+/// define the unused offset
+#define OFFSET_UNUSED       ( 0xFF )
+
+/// define the Q16 unity value
+#define Q16_ONE             ( 0x10000UL )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
@@ -50,6 +58,7 @@
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+#if ( NEOPIXELHANDLER_ENABLE_BITBANG == ON )
 static  U8            nRedOffset;
 static  U8            nGrnOffset;
 static  U8            nBluOffset;
@@ -64,12 +73,96 @@ static  NEOPIXELSPEED eLclSpeed;
 static  EEPROM  NEOPIXELSPEED eEepSpeed;
 static  EEPROM  U8            nEepNumDevs;
 static  EEPROM  NEOPIXELTYPE  eEepType;
+#endif // NEOPIXELHANDLER_ENABLE_BITBANG
 
 // local function prototypes --------------------------------------------------
+#if ( NEOPIXELHANDLER_ENABLE_BITBANG == ON )
 static  void  SetOffsets( void );
+#endif // NEOPIXELHANDLER_ENABLE_BITBANG
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+static  void  EncodePixel( PU8 pnPixel, PU8 pnWire, U8 nBytesPerPixel );
+static  void  BlendColors( PNEOPIXELANIM ptAnim, U32 uLevel, PU8 pnColor );
+static  void  FillRange( PNEOPIXELFRAME ptFrame, PNEOPIXELANIM ptAnim, U16 wStart, U16 wCount, PU8 pnColor );
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
 
 // constant parameter initializations -----------------------------------------
-
+/// define the color offsets for each type, red/green/blue/white
+static  const CODE U8 anOffsetTable[ NEOPIXEL_TYPE_MAX ][ NEOPIXEL_COLOR_MAX ] =
+{
+  { 0, 1, 2, OFFSET_UNUSED },   // RGB
+  { 0, 2, 1, OFFSET_UNUSED },   // RBG
+  { 1, 2, 0, OFFSET_UNUSED },   // BRG
+  { 2, 1, 0, OFFSET_UNUSED },   // BGR
+  { 2, 0, 1, OFFSET_UNUSED },   // GBR
+  { 1, 0, 2, OFFSET_UNUSED },   // GRB
+  { 0, 1, 2, 3 },               // RGBW
+  { 0, 2, 1, 3 },               // RBGW
+  { 1, 2, 0, 3 },               // BRGW
+  { 2, 1, 0, 3 },               // BGRW
+  { 2, 0, 1, 3 },               // GBRW
+  { 1, 0, 2, 3 },               // GRBW
+  { 0, 1, 3, 2 },               // RGWB
+  { 0, 3, 1, 2 },               // RBWG
+  { 1, 3, 0, 2 },               // BRWG
+  { 3, 1, 0, 2 },               // BGWR
+  { 3, 0, 1, 2 },               // GBWR
+  { 1, 0, 3, 2 },               // GRWB
+  { 0, 2, 3, 1 },               // RWGB
+  { 0, 3, 2, 1 },               // RWBG
+  { 2, 3, 0, 1 },               // BWRG
+  { 3, 2, 0, 1 },               // BWGR
+  { 3, 0, 2, 1 },               // GWBR
+  { 2, 0, 3, 1 },               // GWRB
+  { 1, 2, 3, 0 },               // WRGB
+  { 1, 3, 2, 0 },               // WRBG
+  { 2, 3, 1, 0 },               // WBRG
+  { 3, 2, 1, 0 },               // WBGR
+  { 3, 1, 2, 0 },               // WGBR
+  { 2, 1, 3, 0 },               // WGRB
+};
+
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+#if ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 3 )
+/// define the symbols for a nibble, 0 = 100, 1 = 110, 12 bits
+static  const CODE U16  awSymbols[ 16 ] =
+{
+  0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+  0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6,
+};
+#elif ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 4 )
+/// define the symbols for a nibble, 0 = 1000, 1 = 1110, 16 bits
+static  const CODE U16  awSymbols[ 16 ] =
+{
+  0x8888, 0x888E, 0x88E8, 0x88EE, 0x8E88, 0x8E8E, 0x8EE8, 0x8EEE,
+  0xE888, 0xE88E, 0xE8E8, 0xE8EE, 0xEE88, 0xEE8E, 0xEEE8, 0xEEEE,
+};
+#else
+#error "NEOPIXELHANDLER_SPI_BITS_PER_BIT must be 3 or 4"
+#endif // NEOPIXELHANDLER_SPI_BITS_PER_BIT
+
+/// define the gamma table, gamma = 2.6
+static  const CODE U8   anGamma[ 256 ] =
+{
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03,
+  0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x06, 0x06, 0x06, 0x06, 0x07,
+  0x07, 0x07, 0x08, 0x08, 0x08, 0x09, 0x09, 0x09, 0x0A, 0x0A, 0x0A, 0x0B, 0x0B, 0x0B, 0x0C, 0x0C,
+  0x0D, 0x0D, 0x0D, 0x0E, 0x0E, 0x0F, 0x0F, 0x10, 0x10, 0x11, 0x11, 0x12, 0x12, 0x13, 0x13, 0x14,
+  0x14, 0x15, 0x15, 0x16, 0x16, 0x17, 0x18, 0x18, 0x19, 0x19, 0x1A, 0x1B, 0x1B, 0x1C, 0x1D, 0x1D,
+  0x1E, 0x1F, 0x1F, 0x20, 0x21, 0x22, 0x22, 0x23, 0x24, 0x25, 0x26, 0x26, 0x27, 0x28, 0x29, 0x2A,
+  0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+  0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x41, 0x42, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4B,
+  0x4C, 0x4D, 0x4E, 0x50, 0x51, 0x52, 0x54, 0x55, 0x56, 0x58, 0x59, 0x5A, 0x5C, 0x5D, 0x5E, 0x60,
+  0x61, 0x63, 0x64, 0x66, 0x67, 0x69, 0x6A, 0x6C, 0x6D, 0x6F, 0x70, 0x72, 0x73, 0x75, 0x77, 0x78,
+  0x7A, 0x7C, 0x7D, 0x7F, 0x81, 0x82, 0x84, 0x86, 0x88, 0x89, 0x8B, 0x8D, 0x8F, 0x91, 0x92, 0x94,
+  0x96, 0x98, 0x9A, 0x9C, 0x9E, 0xA0, 0xA2, 0xA4, 0xA6, 0xA8, 0xAA, 0xAC, 0xAE, 0xB0, 0xB2, 0xB4,
+  0xB6, 0xB8, 0xBA, 0xBC, 0xBF, 0xC1, 0xC3, 0xC5, 0xC7, 0xCA, 0xCC, 0xCE, 0xD1, 0xD3, 0xD5, 0xD7,
+  0xDA, 0xDC, 0xDF, 0xE1, 0xE3, 0xE6, 0xE8, 0xEB, 0xED, 0xF0, 0xF2, 0xF5, 0xF7, 0xFA, 0xFC, 0xFF,
+};
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
+
+#if ( NEOPIXELHANDLER_ENABLE_BITBANG == ON )
 /******************************************************************************
  * @function NeoPixelHandler_Initialize
  *
@@ -115,7 +208,7 @@ void NeoPixelHandler_Initialize( void )
   }
 
   // allocate memory for the single device
-  wByteCount = nLclNumDevs * ( nWhtOffset == 0xFF ) ? RGB_SIZE : RGBW_SIZE;
+  wByteCount = nLclNumDevs * (( nWhtOffset == OFFSET_UNUSED ) ? RGB_SIZE : RGBW_SIZE );
   pnPixelData = malloc( wByteCount );
 }
 
@@ -176,7 +269,7 @@ void NeoPixelHandler_SetConfiguration( NEOPIXELSPEED eSpeed, NEOPIXELTYPE eReqTy
   free( pnPixelData );
 
   // now - rellaocate memory
-  wByteCount = nLclNumDevs * ( nWhtOffset == 0xFF ) ? RGB_SIZE : RGBW_SIZE;
+  wByteCount = nLclNumDevs * (( nWhtOffset == OFFSET_UNUSED ) ? RGB_SIZE : RGBW_SIZE );
   pnPixelData = malloc( wByteCount );
 }
 
@@ -226,7 +319,7 @@ void NeoPixelHandler_SetPixelColor( U8 nDeviceIndex, U8 nRed, U8 nGrn, U8 nBlu,
     for ( nDevIdx = 0; nDevIdx < nLclNumDevs; nDevIdx++ )
     {
       // compute the device offset
-      wOffset = ( nDevIdx * ( nWhtOffset == 0xFF ) ? RGB_SIZE : RGBW_SIZE );
+      wOffset = nDevIdx * (( nWhtOffset == OFFSET_UNUSED ) ? RGB_SIZE : RGBW_SIZE );
 
       // now set the RGB data
       *( pnPixelData +  wOffset + nRedOffset ) = nRed;
@@ -234,20 +327,20 @@ void NeoPixelHandler_SetPixelColor( U8 nDeviceIndex, U8 nRed, U8 nGrn, U8 nBlu,
       *( pnPixelData +  wOffset + nBluOffset ) = nBlu;
 
       // optional white
-      if ( nWhtOffset != 0xFF )
+      if ( nWhtOffset != OFFSET_UNUSED )
       {
         // set the white data
-        *( pnPixelData +  wOffset + nBluOffset ) = nWht;
+        *( pnPixelData +  wOffset + nWhtOffset ) = nWht;
       }
     }
   }
   else
   {
     // check for a valid device
-    if ( nDeviceIndex < MAX_NUM_DEVICES )
+    if ( nDeviceIndex < nLclNumDevs )
     {
       // compute the device offset
-      wOffset = ( nDeviceIndex * ( nWhtOffset == 0xFF ) ? RGB_SIZE : RGBW_SIZE );
+      wOffset = nDeviceIndex * (( nWhtOffset == OFFSET_UNUSED ) ? RGB_SIZE : RGBW_SIZE );
 
       // now set the RGB data
       *( pnPixelData +  wOffset + nRedOffset ) = nRed;
@@ -255,10 +348,10 @@ void NeoPixelHandler_SetPixelColor( U8 nDeviceIndex, U8 nRed, U8 nGrn, U8 nBlu,
       *( pnPixelData +  wOffset + nBluOffset ) = nBlu;
 
       // optional white
-      if ( nWhtOffset != 0xFF )
+      if ( nWhtOffset != OFFSET_UNUSED )
       {
         // set the white data
-        *( pnPixelData +  wOffset + nBluOffset ) = nWht;
+        *( pnPixelData +  wOffset + nWhtOffset ) = nWht;
       }
     }
   }
@@ -441,226 +534,459 @@ void NeoPixelHandler_Refresh( void )
  *****************************************************************************/
 static void SetOffsets( void )
 {
-  // determine the device
-  switch( eLclType )
+  NEOPIXELTYPE  eType;
+
+  // validate the type
+  eType = ( eLclType < NEOPIXEL_TYPE_MAX ) ? eLclType : NEOPIXEL_TYPE_RGB;
+
+  // get the offsets from the table
+  nRedOffset = PGM_RDBYTE( anOffsetTable[ eType ][ NEOPIXEL_COLOR_RED ] );
+  nGrnOffset = PGM_RDBYTE( anOffsetTable[ eType ][ NEOPIXEL_COLOR_GRN ] );
+  nBluOffset = PGM_RDBYTE( anOffsetTable[ eType ][ NEOPIXEL_COLOR_BLU ] );
+  nWhtOffset = PGM_RDBYTE( anOffsetTable[ eType ][ NEOPIXEL_COLOR_WHT ] );
+}
+#endif // NEOPIXELHANDLER_ENABLE_BITBANG
+
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+/******************************************************************************
+ * @function NeoPixelHandler_FrameInitialize
+ *
+ * @brief initialize a wire-format frame
+ *
+ * This function will set the offsets for the type, clear all pixels and
+ * encode both wire buffers including the reset tail
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   eType       type of device
+ *
+ * @return      TRUE if the type does not match the frame, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL NeoPixelHandler_FrameInitialize( PNEOPIXELFRAME ptFrame, NEOPIXELTYPE eType )
+{
+  BOOL  bStatus = TRUE;
+  U8    nColor, nBufIdx;
+  U16   wPixel;
+  PU8   pnWire;
+
+  // validate the type against the bytes per pixel
+  if (( eType < NEOPIXEL_TYPE_MAX ) &&
+      ((( PGM_RDBYTE( anOffsetTable[ eType ][ NEOPIXEL_COLOR_WHT ] ) == OFFSET_UNUSED ) ? RGB_SIZE : RGBW_SIZE ) == ptFrame->nBytesPerPixel ))
   {
-    case NEOPIXEL_TYPE_RGB :
-    nRedOffset = 0;
-    nGrnOffset = 0;
-    nBluOffset = 0;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_RBG :
-    nRedOffset = 0;
-    nGrnOffset = 2;
-    nBluOffset = 1;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_BRG :
-    nRedOffset = 1;
-    nGrnOffset = 2;
-    nBluOffset = 0;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_BGR :
-    nRedOffset = 2;
-    nGrnOffset = 1;
-    nBluOffset = 0;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_GBR :
-    nRedOffset = 2;
-    nGrnOffset = 0;
-    nBluOffset = 1;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_GRB :
-    nRedOffset = 1;
-    nGrnOffset = 0;
-    nBluOffset = 2;
-    nWhtOffset = 0xFF;
-    break;
-
-    case NEOPIXEL_TYPE_RGBW :
-    nRedOffset = 0;
-    nGrnOffset = 1;
-    nBluOffset = 2;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_RBGW :
-    nRedOffset = 0;
-    nGrnOffset = 2;
-    nBluOffset = 1;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_BRGW :
-    nRedOffset = 1;
-    nGrnOffset = 2;
-    nBluOffset = 0;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_BGRW :
-    nRedOffset = 2;
-    nGrnOffset = 1;
-    nBluOffset = 0;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_GBRW :
-    nRedOffset = 2;
-    nGrnOffset = 0;
-    nBluOffset = 1;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_GRBW :
-    nRedOffset = 1;
-    nGrnOffset = 0;
-    nBluOffset = 2;
-    nWhtOffset = 3;
-    break;
-
-    case NEOPIXEL_TYPE_RGWB :
-    nRedOffset = 0;
-    nGrnOffset = 0;
-    nBluOffset = 3;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_RBWG :
-    nRedOffset = 0;
-    nGrnOffset = 3;
-    nBluOffset = 1;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_BRWG :
-    nRedOffset = 1;
-    nGrnOffset = 3;
-    nBluOffset = 0;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_BGWR :
-    nRedOffset = 3;
-    nGrnOffset = 1;
-    nBluOffset = 0;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_GBWR :
-    nRedOffset = 3;
-    nGrnOffset = 0;
-    nBluOffset = 1;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_GRWB :
-    nRedOffset = 1;
-    nGrnOffset = 0;
-    nBluOffset = 3;
-    nWhtOffset = 2;
-    break;
-
-    case NEOPIXEL_TYPE_RWGB :
-    nRedOffset = 0;
-    nGrnOffset = 2;
-    nBluOffset = 3;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_RWBG :
-    nRedOffset = 0;
-    nGrnOffset = 3;
-    nBluOffset = 2;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_BWRG :
-    nRedOffset = 2;
-    nGrnOffset = 3;
-    nBluOffset = 0;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_BWGR :
-    nRedOffset = 3;
-    nGrnOffset = 2;
-    nBluOffset = 0;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_GWBR :
-    nRedOffset = 3;
-    nGrnOffset = 0;
-    nBluOffset = 2;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_GWRB :
-    nRedOffset = 2;
-    nGrnOffset = 0;
-    nBluOffset = 3;
-    nWhtOffset = 1;
-    break;
-
-    case NEOPIXEL_TYPE_WRGB :
-    nRedOffset = 1;
-    nGrnOffset = 2;
-    nBluOffset = 3;
-    nWhtOffset = 0;
-    break;
-
-    case NEOPIXEL_TYPE_WRBG :
-    nRedOffset = 1;
-    nGrnOffset = 3;
-    nBluOffset = 2;
-    nWhtOffset = 0;
-    break;
-
-    case NEOPIXEL_TYPE_WBRG :
-    nRedOffset = 2;
-    nGrnOffset = 3;
-    nBluOffset = 1;
-    nWhtOffset = 0;
-    break;
-
-    case NEOPIXEL_TYPE_WBGR :
-    nRedOffset = 3;
-    nGrnOffset = 2;
-    nBluOffset = 1;
-    nWhtOffset = 0;
-    break;
-
-    case NEOPIXEL_TYPE_WGBR :
-    nRedOffset = 3;
-    nGrnOffset = 1;
-    nBluOffset = 2;
-    nWhtOffset = 0;
-    break;
-
-    case NEOPIXEL_TYPE_WGRB :
-    nRedOffset = 2;
-    nGrnOffset = 1;
-    nBluOffset = 3;
-    nWhtOffset = 0;
-    break;
+    // copy the offsets
+    for ( nColor = 0; nColor < NEOPIXEL_COLOR_MAX; nColor++ )
+    {
+      ptFrame->anOffsets[ nColor ] = PGM_RDBYTE( anOffsetTable[ eType ][ nColor ] );
+    }
+
+    // clear the pixels
+    memset( ptFrame->pnPixels, 0, NEOPIXEL_FRAME_PIXEL_SIZE( ptFrame->wNumPixels, ptFrame->nBytesPerPixel ));
+
+    // encode each wire buffer
+    for ( nBufIdx = 0; nBufIdx < 2; nBufIdx++ )
+    {
+      // encode every pixel
+      pnWire = ptFrame->apnWire[ nBufIdx ];
+      for ( wPixel = 0; wPixel < ptFrame->wNumPixels; wPixel++ )
+      {
+        EncodePixel( ptFrame->pnPixels, pnWire, ptFrame->nBytesPerPixel );
+        pnWire += ptFrame->nBytesPerPixel * NEOPIXEL_FRAME_SYMBOL_BYTES;
+      }
+
+      // clear the reset tail and the dirty mask
+      memset( pnWire, 0, NEOPIXEL_FRAME_RESET_BYTES );
+      memset( ptFrame->apuDirty[ nBufIdx ], 0, NEOPIXEL_FRAME_DIRTY_WORDS( ptFrame->wNumPixels ) * sizeof( U32 ));
+    }
+
+    // start rendering into the first buffer
+    ptFrame->nBackIdx = 0;
+    bStatus = FALSE;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_FrameSetPixel
+ *
+ * @brief set a pixel in the frame
+ *
+ * This function will set a single pixel and mark it for encoding if it
+ * changed
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   wIndex      index of the pixel
+ * @param[in]   nRed        red color
+ * @param[in]   nGrn        green color
+ * @param[in]   nBlu        blue color
+ * @param[in]   nWht        white color
+ *
+ *****************************************************************************/
+void NeoPixelHandler_FrameSetPixel( PNEOPIXELFRAME ptFrame, U16 wIndex, U8 nRed, U8 nGrn, U8 nBlu, U8 nWht )
+{
+  // fill a single pixel
+  NeoPixelHandler_FrameFillPixels( ptFrame, wIndex, 1, nRed, nGrn, nBlu, nWht );
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_FrameFillPixels
+ *
+ * @brief fill a block of pixels in the frame
+ *
+ * This function will set a block of pixels to a color, only pixels whose
+ * value changed are marked for encoding in both wire buffers
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   wFirst      index of the first pixel
+ * @param[in]   wCount      number of pixels
+ * @param[in]   nRed        red color
+ * @param[in]   nGrn        green color
+ * @param[in]   nBlu        blue color
+ * @param[in]   nWht        white color
+ *
+ *****************************************************************************/
+void NeoPixelHandler_FrameFillPixels( PNEOPIXELFRAME ptFrame, U16 wFirst, U16 wCount, U8 nRed, U8 nGrn, U8 nBlu, U8 nWht )
+{
+  U8    anPixel[ RGBW_SIZE ];
+  U8    nBpp, nIdx;
+  U16   wIndex, wLast;
+  PU8   pnPixel;
+  U32   uBit;
+  BOOL  bChanged;
+
+  // clamp the block to the frame
+  wLast = ( wFirst < ptFrame->wNumPixels ) ? wFirst + MIN( wCount, ptFrame->wNumPixels - wFirst ) : wFirst;
+
+  // build the pixel in wire order
+  nBpp = ptFrame->nBytesPerPixel;
+  anPixel[ ptFrame->anOffsets[ NEOPIXEL_COLOR_RED ]] = nRed;
+  anPixel[ ptFrame->anOffsets[ NEOPIXEL_COLOR_GRN ]] = nGrn;
+  anPixel[ ptFrame->anOffsets[ NEOPIXEL_COLOR_BLU ]] = nBlu;
+  if ( nBpp == RGBW_SIZE )
+  {
+    anPixel[ ptFrame->anOffsets[ NEOPIXEL_COLOR_WHT ]] = nWht;
+  }
+
+  // for each pixel in the block
+  pnPixel = ptFrame->pnPixels + (( U32 )wFirst * nBpp );
+  for ( wIndex = wFirst; wIndex < wLast; wIndex++ )
+  {
+    // compare/copy the pixel
+    bChanged = FALSE;
+    for ( nIdx = 0; nIdx < nBpp; nIdx++ )
+    {
+      if ( pnPixel[ nIdx ] != anPixel[ nIdx ] )
+      {
+        pnPixel[ nIdx ] = anPixel[ nIdx ];
+        bChanged = TRUE;
+      }
+    }
+
+    // mark it in both wire buffers if changed
+    if ( bChanged )
+    {
+      uBit = ( U32 )1 << ( wIndex & 0x1F );
+      ptFrame->apuDirty[ 0 ][ wIndex >> 5 ] |= uBit;
+      ptFrame->apuDirty[ 1 ][ wIndex >> 5 ] |= uBit;
+    }
+
+    // next pixel
+    pnPixel += nBpp;
+  }
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_FrameCommit
+ *
+ * @brief commit the frame
+ *
+ * This function will encode the pixels that changed since the back buffer was
+ * last committed and make it the front buffer. It must not be called while
+ * the current front buffer is still being transmitted.
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ *
+ *****************************************************************************/
+void NeoPixelHandler_FrameCommit( PNEOPIXELFRAME ptFrame )
+{
+  PU32  puDirty;
+  PU8   pnWire;
+  U32   uMask;
+  U16   wWord, wNumWords, wIndex;
+  U8    nBpp, nWireBpp;
+
+  // get the back buffer
+  puDirty = ptFrame->apuDirty[ ptFrame->nBackIdx ];
+  pnWire = ptFrame->apnWire[ ptFrame->nBackIdx ];
+  nBpp = ptFrame->nBytesPerPixel;
+  nWireBpp = nBpp * NEOPIXEL_FRAME_SYMBOL_BYTES;
+  wNumWords = NEOPIXEL_FRAME_DIRTY_WORDS( ptFrame->wNumPixels );
+
+  // for each dirty word
+  for ( wWord = 0; wWord < wNumWords; wWord++ )
+  {
+    // skip the clean words
+    if (( uMask = puDirty[ wWord ] ) != 0 )
+    {
+      // clear it and encode each dirty pixel
+      puDirty[ wWord ] = 0;
+      wIndex = wWord << 5;
+      while ( uMask != 0 )
+      {
+        if ( uMask & 1 )
+        {
+          EncodePixel( ptFrame->pnPixels + (( U32 )wIndex * nBpp ), pnWire + (( U32 )wIndex * nWireBpp ), nBpp );
+        }
+
+        // next pixel
+        uMask >>= 1;
+        wIndex++;
+      }
+    }
+  }
+
+  // swap the buffers
+  ptFrame->nBackIdx ^= 1;
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_FrameGetWireData
+ *
+ * @brief get the front wire buffer
+ *
+ * This function will return the front wire buffer and its length, including
+ * the reset tail, to be handed to the SPI/DMA
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[io]   puLength    pointer to store the length
+ *
+ * @return      pointer to the wire data
+ *
+ *****************************************************************************/
+PU8 NeoPixelHandler_FrameGetWireData( PNEOPIXELFRAME ptFrame, PU32 puLength )
+{
+  // return the length/front buffer
+  *( puLength ) = NEOPIXEL_FRAME_WIRE_SIZE( ptFrame->wNumPixels, ptFrame->nBytesPerPixel );
+  return( ptFrame->apnWire[ ptFrame->nBackIdx ^ 1 ] );
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_AnimStart
+ *
+ * @brief start an animation
+ *
+ * This function will validate the animation and compute its fixed point
+ * rates
+ *
+ * @param[in]   ptAnim      pointer to the animation
+ *
+ *****************************************************************************/
+void NeoPixelHandler_AnimStart( PNEOPIXELANIM ptAnim )
+{
+  // ensure at least one step/pixel
+  ptAnim->wNumSteps = MAX( ptAnim->wNumSteps, 1 );
+  ptAnim->wCount = MAX( ptAnim->wCount, 1 );
+
+  // clamp the tail to the block
+  ptAnim->nTailLength = ( U8 )MIN( MAX( ptAnim->nTailLength, 1 ), ptAnim->wCount );
+
+  // compute the chase rate and tail scale
+  ptAnim->uRate = (( U32 )ptAnim->wCount << 16 ) / ptAnim->wNumSteps;
+  ptAnim->uTailScale = Q16_ONE / ptAnim->nTailLength;
+
+  // reset the position
+  ptAnim->wStep = 0;
+  ptAnim->uPhase = 0;
+}
+
+/******************************************************************************
+ * @function NeoPixelHandler_AnimRender
+ *
+ * @brief render an animation step
+ *
+ * This function will render one step of the animation into the frame. A
+ * fade computes one color and fills the block. A chase fills everything but
+ * the lit tail with the background and blends only the tail pixels.
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   ptAnim      pointer to the animation
+ *
+ * @return      TRUE if the fade has completed or the chase completed a pass
+ *
+ *****************************************************************************/
+BOOL NeoPixelHandler_AnimRender( PNEOPIXELFRAME ptFrame, PNEOPIXELANIM ptAnim )
+{
+  BOOL  bDone = FALSE;
+  U8    anColor[ NEOPIXEL_COLOR_MAX ];
+  U32   uDist, uLimit;
+  U16   wHead, wLit, wPixel;
+
+  // determine the type
+  switch( ptAnim->eType )
+  {
+    case NEOPIXEL_ANIM_FADE :
+      // compute the color for this step and fill the block
+      BlendColors( ptAnim, (( U32 )ptAnim->wStep << 16 ) / ptAnim->wNumSteps, anColor );
+      FillRange( ptFrame, ptAnim, 0, ptAnim->wCount, anColor );
+
+      // check for done
+      if ( ptAnim->wStep >= ptAnim->wNumSteps )
+      {
+        bDone = TRUE;
+      }
+      else
+      {
+        ptAnim->wStep++;
+      }
+      break;
+
+    case NEOPIXEL_ANIM_CHASE :
+      // draw the tail back from the head
+      wHead = ( U16 )( ptAnim->uPhase >> 16 );
+      uDist = ptAnim->uPhase & 0xFFFF;
+      uLimit = ( U32 )ptAnim->nTailLength << 16;
+      wPixel = wHead;
+      for ( wLit = 0; uDist < uLimit; wLit++ )
+      {
+        // blend and set the pixel
+        BlendColors( ptAnim, Q16_ONE - ((( uDist >> 8 ) * ptAnim->uTailScale ) >> 8 ), anColor );
+        FillRange( ptFrame, ptAnim, wPixel, 1, anColor );
+
+        // move back one pixel
+        wPixel = ( wPixel == 0 ) ? ptAnim->wCount - 1 : wPixel - 1;
+        uDist += Q16_ONE;
+      }
+
+      // fill the rest with the background
+      BlendColors( ptAnim, 0, anColor );
+      FillRange( ptFrame, ptAnim, ( wHead + 1 ) % ptAnim->wCount, ptAnim->wCount - MIN( wLit, ptAnim->wCount ), anColor );
+
+      // advance the head
+      ptAnim->uPhase += ptAnim->uRate;
+      if ( ptAnim->uPhase >= (( U32 )ptAnim->wCount << 16 ))
+      {
+        ptAnim->uPhase -= (( U32 )ptAnim->wCount << 16 );
+      }
+
+      // check for end of pass
+      if ( ++ptAnim->wStep >= ptAnim->wNumSteps )
+      {
+        ptAnim->wStep = 0;
+        ptAnim->uPhase = 0;
+        bDone = TRUE;
+      }
+      break;
 
     default :
-    nRedOffset = 0;
-    nGrnOffset = 1;
-    nBluOffset = 2;
-    nWhtOffset = 0xFF;
-    break;
+      bDone = TRUE;
+      break;
   }
+
+  // return the status
+  return( bDone );
 }
 
+/******************************************************************************
+ * @function EncodePixel
+ *
+ * @brief encode a pixel
+ *
+ * This function will encode the pixel bytes into SPI symbols, MSB first
+ *
+ * @param[in]   pnPixel         pointer to the pixel
+ * @param[in]   pnWire          pointer to the wire data
+ * @param[in]   nBytesPerPixel  number of bytes per pixel
+ *
+ *****************************************************************************/
+static void EncodePixel( PU8 pnPixel, PU8 pnWire, U8 nBytesPerPixel )
+{
+  U8  nByte;
+  #if ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 3 )
+  U32 uSymbols;
+  #else
+  U16 wSymbols;
+  #endif
+
+  // for each byte
+  while ( nBytesPerPixel-- != 0 )
+  {
+    nByte = *( pnPixel++ );
+    #if ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 3 )
+    // combine the two nibbles into 24 bits
+    uSymbols = (( U32 )PGM_RDWORD( awSymbols[ nByte >> 4 ] ) << 12 ) | PGM_RDWORD( awSymbols[ nByte & 0x0F ] );
+    *( pnWire++ ) = ( U8 )( uSymbols >> 16 );
+    *( pnWire++ ) = ( U8 )( uSymbols >> 8 );
+    *( pnWire++ ) = ( U8 )( uSymbols );
+    #else
+    // output each nibble as 16 bits
+    wSymbols = PGM_RDWORD( awSymbols[ nByte >> 4 ] );
+    *( pnWire++ ) = HI16( wSymbols );
+    *( pnWire++ ) = LO16( wSymbols );
+    wSymbols = PGM_RDWORD( awSymbols[ nByte & 0x0F ] );
+    *( pnWire++ ) = HI16( wSymbols );
+    *( pnWire++ ) = LO16( wSymbols );
+    #endif
+  }
+}
+
+/******************************************************************************
+ * @function BlendColors
+ *
+ * @brief blend the animation colors
+ *
+ * This function will interpolate between color A and color B and optionally
+ * apply the gamma table
+ *
+ * @param[in]   ptAnim      pointer to the animation
+ * @param[in]   uLevel      level of color B, Q16, 0 to 1.0
+ * @param[io]   pnColor     pointer to store the color
+ *
+ *****************************************************************************/
+static void BlendColors( PNEOPIXELANIM ptAnim, U32 uLevel, PU8 pnColor )
+{
+  U8  nColor, nValue;
+  S32 lDelta;
+
+  // for each color
+  for ( nColor = 0; nColor < NEOPIXEL_COLOR_MAX; nColor++ )
+  {
+    // interpolate
+    lDelta = ( S32 )ptAnim->anColorB[ nColor ] - ptAnim->anColorA[ nColor ];
+    nValue = ( U8 )( ptAnim->anColorA[ nColor ] + (( lDelta * ( S32 )uLevel ) >> 16 ));
+
+    // apply the gamma if requested
+    pnColor[ nColor ] = ( ptAnim->bGamma ) ? PGM_RDBYTE( anGamma[ nValue ] ) : nValue;
+  }
+}
+
+/******************************************************************************
+ * @function FillRange
+ *
+ * @brief fill a range of the animation block
+ *
+ * This function will fill a range of the block, wrapping at its end
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   ptAnim      pointer to the animation
+ * @param[in]   wStart      start index within the block
+ * @param[in]   wCount      number of pixels
+ * @param[in]   pnColor     pointer to the color
+ *
+ *****************************************************************************/
+static void FillRange( PNEOPIXELFRAME ptFrame, PNEOPIXELANIM ptAnim, U16 wStart, U16 wCount, PU8 pnColor )
+{
+  U16 wFirst;
+
+  // fill up to the end of the block
+  wFirst = MIN( wCount, ptAnim->wCount - wStart );
+  NeoPixelHandler_FrameFillPixels( ptFrame, ptAnim->wFirst + wStart, wFirst, pnColor[ NEOPIXEL_COLOR_RED ], pnColor[ NEOPIXEL_COLOR_GRN ], pnColor[ NEOPIXEL_COLOR_BLU ], pnColor[ NEOPIXEL_COLOR_WHT ] );
+
+  // fill the wrapped portion
+  if ( wCount > wFirst )
+  {
+    NeoPixelHandler_FrameFillPixels( ptFrame, ptAnim->wFirst, wCount - wFirst, pnColor[ NEOPIXEL_COLOR_RED ], pnColor[ NEOPIXEL_COLOR_GRN ], pnColor[ NEOPIXEL_COLOR_BLU ], pnColor[ NEOPIXEL_COLOR_WHT ] );
+  }
+}
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
 /**@} EOF NeoPixelHandler.c */
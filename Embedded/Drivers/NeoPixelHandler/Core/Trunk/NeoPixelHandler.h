@@ -31,6 +31,7 @@
 #include "Types/Types.h"
 
 // local includes -------------------------------------------------------------
+#include "NeoPixelHandler/NeoPixelHandler_prm.h"
 
 // library includes -----------------------------------------------------------
 
@@ -38,6 +39,33 @@
 /// define the global inclusive device index
 #define NEOPIXEL_ALL_DEVICES          ( 0xFF )
 
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+/// define the number of SPI bytes per pixel data byte
+#define NEOPIXEL_FRAME_SYMBOL_BYTES   ( NEOPIXELHANDLER_SPI_BITS_PER_BIT )
+
+/// define the number of zero bytes appended to a frame for the reset/latch
+#define NEOPIXEL_FRAME_RESET_BYTES    (( NEOPIXELHANDLER_SPI_RESET_USEC * NEOPIXELHANDLER_SPI_BITS_PER_BIT ) / 10 )
+
+/// define the macros for sizing the frame buffers
+#define NEOPIXEL_FRAME_PIXEL_SIZE( pixels, bpp )  (( pixels ) * ( bpp ))
+#define NEOPIXEL_FRAME_WIRE_SIZE( pixels, bpp )   ((( U32 )( pixels ) * ( bpp ) * NEOPIXEL_FRAME_SYMBOL_BYTES ) + NEOPIXEL_FRAME_RESET_BYTES )
+#define NEOPIXEL_FRAME_DIRTY_WORDS( pixels )      ((( pixels ) + 31 ) / 32 )
+
+/// define the helper macro for declaring a frame and its buffers
+#define NEOPIXEL_FRAME_DEFINE( name, pixels, bpp ) \
+  static U8   an ## name ## Pixels[ NEOPIXEL_FRAME_PIXEL_SIZE( pixels, bpp ) ]; \
+  static U8   an ## name ## Wire[ 2 ][ NEOPIXEL_FRAME_WIRE_SIZE( pixels, bpp ) ]; \
+  static U32  au ## name ## Dirty[ 2 ][ NEOPIXEL_FRAME_DIRTY_WORDS( pixels ) ]; \
+  static NEOPIXELFRAME name = \
+  { \
+    .pnPixels       = an ## name ## Pixels, \
+    .apnWire        = { an ## name ## Wire[ 0 ], an ## name ## Wire[ 1 ] }, \
+    .apuDirty       = { au ## name ## Dirty[ 0 ], au ## name ## Dirty[ 1 ] }, \
+    .wNumPixels     = pixels, \
+    .nBytesPerPixel = bpp, \
+  }
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the Neo Pixel types
 typedef enum _NEOPIXELTYPE
@@ -83,16 +111,77 @@ typedef enum _NEOPIXELSPEED
   NEOPIXEL_SPEED_MAX
 } NEOPIXELSPEED, *PNEOPIXELSPEED;
 
+/// enumerate the color indices
+typedef enum _NEOPIXELCOLOR
+{
+  NEOPIXEL_COLOR_RED = 0,       ///< red
+  NEOPIXEL_COLOR_GRN,           ///< green
+  NEOPIXEL_COLOR_BLU,           ///< blue
+  NEOPIXEL_COLOR_WHT,           ///< white
+  NEOPIXEL_COLOR_MAX
+} NEOPIXELCOLOR;
+
+/// enumerate the animation types
+typedef enum _NEOPIXELANIMTYPE
+{
+  NEOPIXEL_ANIM_FADE = 0,       ///< fade the block from color A to color B
+  NEOPIXEL_ANIM_CHASE,          ///< run a head of color B with a fading tail over color A
+  NEOPIXEL_ANIM_MAX
+} NEOPIXELANIMTYPE;
+
 // structures -----------------------------------------------------------------
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+/// define the wire-format frame structure
+typedef struct _NEOPIXELFRAME
+{
+  PU8   pnPixels;                           ///< pixel values in wire order
+  PU8   apnWire[ 2 ];                       ///< encoded front/back wire buffers
+  PU32  apuDirty[ 2 ];                      ///< pixels to re-encode per wire buffer
+  U16   wNumPixels;                         ///< number of pixels
+  U8    nBytesPerPixel;                     ///< bytes per pixel ( 3 or 4 )
+  U8    nBackIdx;                           ///< index of the back wire buffer
+  U8    anOffsets[ NEOPIXEL_COLOR_MAX ];    ///< color offsets within a pixel
+} NEOPIXELFRAME, *PNEOPIXELFRAME;
+#define NEOPIXELFRAME_SIZE                  sizeof( NEOPIXELFRAME )
+
+/// define the animation structure
+typedef struct _NEOPIXELANIM
+{
+  NEOPIXELANIMTYPE  eType;                          ///< animation type
+  U16               wFirst;                         ///< first pixel of the block
+  U16               wCount;                         ///< number of pixels in the block
+  U16               wNumSteps;                      ///< fade steps/chase steps per pass
+  U8                nTailLength;                    ///< chase tail length in pixels
+  BOOL              bGamma;                         ///< apply the gamma table
+  U8                anColorA[ NEOPIXEL_COLOR_MAX ]; ///< fade start/chase background
+  U8                anColorB[ NEOPIXEL_COLOR_MAX ]; ///< fade end/chase head
+  U16               wStep;                          ///< current step
+  U32               uPhase;                         ///< chase head position, Q16.16
+  U32               uRate;                          ///< chase pixels per step, Q16.16
+  U32               uTailScale;                     ///< chase tail level scale
+} NEOPIXELANIM, *PNEOPIXELANIM;
+#define NEOPIXELANIM_SIZE                   sizeof( NEOPIXELANIM )
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
 
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
+#if ( NEOPIXELHANDLER_ENABLE_BITBANG == ON )
 extern  void  NeoPixelHandler_Initialize( void );
 extern  void  NeoPixelHandler_SetConfiguration( NEOPIXELSPEED eSpeed, NEOPIXELTYPE eType, U8 nNumDevices );
 extern  void  NeoPixelHandler_GetConfiguration( PNEOPIXELSPEED peSpeed, PNEOPIXELTYPE peType, PU8 pnNumDevices );
 extern  void  NeoPixelHandler_SetPixelColor( U8 nDeviceIndex, U8 nRed, U8 nGrn, U8 nBlu, U8 nWht );
 extern  void  NeoPixelHandler_Refresh( void );
+#endif // NEOPIXELHANDLER_ENABLE_BITBANG
+#if ( NEOPIXELHANDLER_ENABLE_SPIFRAME == ON )
+extern  BOOL  NeoPixelHandler_FrameInitialize( PNEOPIXELFRAME ptFrame, NEOPIXELTYPE eType );
+extern  void  NeoPixelHandler_FrameSetPixel( PNEOPIXELFRAME ptFrame, U16 wIndex, U8 nRed, U8 nGrn, U8 nBlu, U8 nWht );
+extern  void  NeoPixelHandler_FrameFillPixels( PNEOPIXELFRAME ptFrame, U16 wFirst, U16 wCount, U8 nRed, U8 nGrn, U8 nBlu, U8 nWht );
+extern  void  NeoPixelHandler_FrameCommit( PNEOPIXELFRAME ptFrame );
+extern  PU8   NeoPixelHandler_FrameGetWireData( PNEOPIXELFRAME ptFrame, PU32 puLength );
+extern  void  NeoPixelHandler_AnimStart( PNEOPIXELANIM ptAnim );
+extern  BOOL  NeoPixelHandler_AnimRender( PNEOPIXELFRAME ptFrame, PNEOPIXELANIM ptAnim );
+#endif // NEOPIXELHANDLER_ENABLE_SPIFRAME
 
 /**@} EOF NeoPixelHandler.h */
 
@@ -0,0 +1,549 @@
+/******************************************************************************
+ * @file NeoPixelFrameTest.c
+ *
+ * @brief Neo Pixel Handler frame test
+ *
+ * This file provides a host tool that decodes the SPI wire-format frames
+ * generated by the Neo Pixel Handler back into pixels.  Each symbol must be a
+ * valid zero or one pattern and the reset tail must be all zeros.  The random
+ * check applies random pixel and block writes to a 1000 pixel GRB strip and a
+ * GRBW strip and compares every committed front buffer against a reference
+ * image, the fade check runs a gamma fade to completion and the chase check
+ * counts the lit tail on each step.  It then times a full strip update, a
+ * sparse update, a fade and a chase.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o NeoPixelFrameTest
+ *             NeoPixelFrameTest.c ../../Core/Trunk/NeoPixelHandler.c
+ *             ( add -DNEOPIXELHANDLER_SPI_BITS_PER_BIT=4 for 4 bit symbols )
+ * usage:      NeoPixelFrameTest [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup NeoPixelHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "NeoPixelHandler/NeoPixelHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the strip sizes
+#define NUM_PIXELS                                  ( 1000 )
+#define NUM_RGBW_PIXELS                             ( 300 )
+
+/// define the random run length
+#define RANDOM_FRAMES                               ( 2000 )
+
+/// define the number of timing passes
+#define TIMING_FRAMES                               ( 2000 )
+
+/// define the number of pixels changed in the sparse timing
+#define SPARSE_PIXELS                               ( 10 )
+
+/// define the SPI bit rate
+#define SPI_BIT_RATE                                ( 800000UL * NEOPIXELHANDLER_SPI_BITS_PER_BIT )
+
+// structures -----------------------------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+NEOPIXEL_FRAME_DEFINE( tStrip, NUM_PIXELS, 3 );
+NEOPIXEL_FRAME_DEFINE( tRgbwStrip, NUM_RGBW_PIXELS, 4 );
+static  U8    anRefImage[ NUM_PIXELS ][ NEOPIXEL_COLOR_MAX ];
+static  U8    anDecoded[ NUM_PIXELS * 4 ];
+
+/// define the wire order of the test types, red/green/blue/white
+static  const U8  anGrbOrder[ NEOPIXEL_COLOR_MAX ] = { 1, 0, 2, 0xFF };
+static  const U8  anGrbwOrder[ NEOPIXEL_COLOR_MAX ] = { 1, 0, 2, 3 };
+
+// local function prototypes --------------------------------------------------
+static  BOOL    Decode( PNEOPIXELFRAME ptFrame );
+static  int     Verify( PNEOPIXELFRAME ptFrame, const U8* pnOrder, PC8 pszName, int iFrame );
+static  int     RunRandom( PNEOPIXELFRAME ptFrame, NEOPIXELTYPE eType, const U8* pnOrder, PC8 pszName );
+static  int     RunFade( void );
+static  int     RunChase( void );
+static  void    RunTiming( void );
+static  double  ElapsedNsecs( struct timespec* ptStart );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int iErrors;
+  U32 uLength;
+
+  // seed the random writes
+  srand(( iArgc > 1 ) ? atoi( ppszArgv[ 1 ] ) : 1 );
+
+  // report the frame
+  NeoPixelHandler_FrameInitialize( &tStrip, NEOPIXEL_TYPE_GRB );
+  NeoPixelHandler_FrameGetWireData( &tStrip, &uLength );
+  printf( "pixels %d, %d bit symbols, wire %u bytes ( %u reset ), %.2f msecs at %lu Hz\n", NUM_PIXELS, NEOPIXELHANDLER_SPI_BITS_PER_BIT,
+          uLength, NEOPIXEL_FRAME_RESET_BYTES, ( uLength * 8.0 * 1000.0 ) / SPI_BIT_RATE, SPI_BIT_RATE );
+
+  // check a mismatched type is rejected
+  iErrors = ( NeoPixelHandler_FrameInitialize( &tStrip, NEOPIXEL_TYPE_GRBW ) == TRUE ) ? 0 : 1;
+  if ( iErrors != 0 )
+  {
+    printf( "  RGBW type accepted on an RGB frame\n" );
+  }
+
+  // run the checks
+  iErrors += RunRandom( &tStrip, NEOPIXEL_TYPE_GRB, anGrbOrder, "GRB" );
+  iErrors += RunRandom( &tRgbwStrip, NEOPIXEL_TYPE_GRBW, anGrbwOrder, "GRBW" );
+  iErrors += RunFade( );
+  iErrors += RunChase( );
+  RunTiming( );
+
+  // report
+  printf( "%s\n", ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function Decode
+ *
+ * @brief decode the front buffer
+ *
+ * This function will decode the symbols of the front wire buffer back into
+ * pixel bytes
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ *
+ * @return      TRUE if an invalid symbol or reset byte was found
+ *
+ *****************************************************************************/
+static BOOL Decode( PNEOPIXELFRAME ptFrame )
+{
+  BOOL  bError = FALSE;
+  PU8   pnWire;
+  U32   uLength, uBit, uNumBits, uIdx;
+  U8    nSymbol, nSymIdx, nZero, nOne;
+
+  // get the front buffer
+  pnWire = NeoPixelHandler_FrameGetWireData( ptFrame, &uLength );
+  uNumBits = ( U32 )ptFrame->wNumPixels * ptFrame->nBytesPerPixel * 8;
+  nZero = ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 3 ) ? 0x4 : 0x8;
+  nOne = ( NEOPIXELHANDLER_SPI_BITS_PER_BIT == 3 ) ? 0x6 : 0xE;
+  memset( anDecoded, 0, sizeof( anDecoded ));
+
+  // for each data bit
+  for ( uBit = 0; uBit < uNumBits; uBit++ )
+  {
+    // gather the symbol, MSB first
+    nSymbol = 0;
+    for ( nSymIdx = 0; nSymIdx < NEOPIXELHANDLER_SPI_BITS_PER_BIT; nSymIdx++ )
+    {
+      uIdx = ( uBit * NEOPIXELHANDLER_SPI_BITS_PER_BIT ) + nSymIdx;
+      nSymbol = ( nSymbol << 1 ) | (( pnWire[ uIdx >> 3 ] >> ( 7 - ( uIdx & 7 ))) & 1 );
+    }
+
+    // decode it
+    if ( nSymbol == nOne )
+    {
+      anDecoded[ uBit >> 3 ] |= 0x80 >> ( uBit & 7 );
+    }
+    else if ( nSymbol != nZero )
+    {
+      bError = TRUE;
+    }
+  }
+
+  // check the reset tail
+  for ( uIdx = uLength - NEOPIXEL_FRAME_RESET_BYTES; uIdx < uLength; uIdx++ )
+  {
+    bError |= ( pnWire[ uIdx ] != 0 );
+  }
+
+  // return the status
+  return( bError );
+}
+
+/******************************************************************************
+ * @function Verify
+ *
+ * @brief verify the front buffer
+ *
+ * This function will decode the front buffer and compare it to the
+ * reference image
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   pnOrder     wire order of the colors
+ * @param[in]   pszName     name of the check
+ * @param[in]   iFrame      frame number
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int Verify( PNEOPIXELFRAME ptFrame, const U8* pnOrder, PC8 pszName, int iFrame )
+{
+  int iErrors = 0;
+  int iPixel, iColor;
+  U8  nBpp;
+
+  // decode
+  nBpp = ptFrame->nBytesPerPixel;
+  if ( Decode( ptFrame ))
+  {
+    printf( "  %s frame %d: invalid symbol or reset\n", pszName, iFrame );
+    iErrors++;
+  }
+
+  // compare each pixel
+  for ( iPixel = 0; ( iPixel < ptFrame->wNumPixels ) && ( iErrors == 0 ); iPixel++ )
+  {
+    for ( iColor = 0; iColor < nBpp; iColor++ )
+    {
+      if ( anDecoded[ ( iPixel * nBpp ) + pnOrder[ iColor ]] != anRefImage[ iPixel ][ iColor ] )
+      {
+        printf( "  %s frame %d: pixel %d color %d %02X != %02X\n", pszName, iFrame, iPixel, iColor,
+                anDecoded[ ( iPixel * nBpp ) + pnOrder[ iColor ]], anRefImage[ iPixel ][ iColor ] );
+        iErrors++;
+      }
+    }
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunRandom
+ *
+ * @brief run the random check
+ *
+ * This function will apply random pixel and block writes, commit, and verify
+ * every front buffer against the reference image
+ *
+ * @param[in]   ptFrame     pointer to the frame
+ * @param[in]   eType       type of device
+ * @param[in]   pnOrder     wire order of the colors
+ * @param[in]   pszName     name of the check
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunRandom( PNEOPIXELFRAME ptFrame, NEOPIXELTYPE eType, const U8* pnOrder, PC8 pszName )
+{
+  int iErrors = 0;
+  int iFrame, iWrite, iNumWrites, iPixel, iCount;
+  U8  anColor[ NEOPIXEL_COLOR_MAX ];
+
+  // initialize
+  if ( NeoPixelHandler_FrameInitialize( ptFrame, eType ))
+  {
+    printf( "  %s initialize failed\n", pszName );
+    return( 1 );
+  }
+  memset( anRefImage, 0, sizeof( anRefImage ));
+  iErrors += Verify( ptFrame, pnOrder, pszName, -1 );
+
+  // for each frame
+  for ( iFrame = 0; ( iFrame < RANDOM_FRAMES ) && ( iErrors == 0 ); iFrame++ )
+  {
+    // apply a random number of writes, sometimes none
+    iNumWrites = rand( ) % 8;
+    for ( iWrite = 0; iWrite < iNumWrites; iWrite++ )
+    {
+      // pick a color, white is ignored for RGB
+      anColor[ 0 ] = rand( );
+      anColor[ 1 ] = rand( );
+      anColor[ 2 ] = rand( );
+      anColor[ 3 ] = ( ptFrame->nBytesPerPixel == 4 ) ? rand( ) : 0;
+
+      // single pixel or block, including ones past the end
+      iPixel = rand( ) % ( ptFrame->wNumPixels + 4 );
+      iCount = (( rand( ) & 3 ) == 0 ) ? rand( ) % 200 : 1;
+      NeoPixelHandler_FrameFillPixels( ptFrame, iPixel, iCount, anColor[ 0 ], anColor[ 1 ], anColor[ 2 ], anColor[ 3 ] );
+      for ( ; ( iCount > 0 ) && ( iPixel < ptFrame->wNumPixels ); iCount--, iPixel++ )
+      {
+        memcpy( anRefImage[ iPixel ], anColor, NEOPIXEL_COLOR_MAX );
+      }
+    }
+
+    // commit/verify
+    NeoPixelHandler_FrameCommit( ptFrame );
+    iErrors += Verify( ptFrame, pnOrder, pszName, iFrame );
+  }
+
+  // report
+  printf( "random %s: %d frames, %d errors\n", pszName, iFrame, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunFade
+ *
+ * @brief run the fade check
+ *
+ * This function will fade a block from dark to a color with gamma and checks
+ * each step is non decreasing and the last step lands on the gamma corrected
+ * color
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunFade( void )
+{
+  int           iErrors = 0;
+  int           iSteps = 0;
+  int           iPixel, iColor;
+  U8            anLast[ NEOPIXEL_COLOR_MAX ] = { 0 };
+  BOOL          bDone;
+  NEOPIXELANIM  tAnim =
+  {
+    .eType      = NEOPIXEL_ANIM_FADE,
+    .wFirst     = 100,
+    .wCount     = 500,
+    .wNumSteps  = 40,
+    .bGamma     = TRUE,
+    .anColorA   = { 0, 0, 0, 0 },
+    .anColorB   = { 255, 128, 64, 0 },
+  };
+
+  // initialize
+  NeoPixelHandler_FrameInitialize( &tStrip, NEOPIXEL_TYPE_GRB );
+  memset( anRefImage, 0, sizeof( anRefImage ));
+  NeoPixelHandler_AnimStart( &tAnim );
+
+  // run until done
+  do
+  {
+    // render/commit/decode
+    bDone = NeoPixelHandler_AnimRender( &tStrip, &tAnim );
+    NeoPixelHandler_FrameCommit( &tStrip );
+    iErrors += ( Decode( &tStrip ) == TRUE );
+    iSteps++;
+
+    // check the block is uniform, non decreasing and outside is dark
+    for ( iPixel = 0; iPixel < NUM_PIXELS; iPixel++ )
+    {
+      for ( iColor = 0; iColor < 3; iColor++ )
+      {
+        U8 nValue = anDecoded[ ( iPixel * 3 ) + anGrbOrder[ iColor ]];
+        if (( iPixel >= 100 ) && ( iPixel < 600 ))
+        {
+          if (( iPixel == 100 ) && ( nValue < anLast[ iColor ] ))
+          {
+            iErrors++;
+          }
+          iErrors += ( nValue != anDecoded[ ( 100 * 3 ) + anGrbOrder[ iColor ]] );
+        }
+        else
+        {
+          iErrors += ( nValue != 0 );
+        }
+      }
+    }
+    for ( iColor = 0; iColor < 3; iColor++ )
+    {
+      anLast[ iColor ] = anDecoded[ ( 100 * 3 ) + anGrbOrder[ iColor ]];
+    }
+  }
+  while (( bDone == FALSE ) && ( iSteps < 1000 ));
+
+  // check the final color is the gamma corrected end color
+  if (( anLast[ 0 ] != 0xFF ) || ( anLast[ 1 ] != 0x2A ) || ( anLast[ 2 ] != 0x07 ))
+  {
+    printf( "  fade ended at %02X %02X %02X\n", anLast[ 0 ], anLast[ 1 ], anLast[ 2 ] );
+    iErrors++;
+  }
+
+  // report
+  printf( "fade: %d steps, %d errors\n", iSteps, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunChase
+ *
+ * @brief run the chase check
+ *
+ * This function will run two passes of a chase over the whole strip and check
+ * the lit pixel count and head position on each step
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunChase( void )
+{
+  int           iErrors = 0;
+  int           iStep, iPixel, iLit, iPasses = 0;
+  U32           uHead;
+  NEOPIXELANIM  tAnim =
+  {
+    .eType        = NEOPIXEL_ANIM_CHASE,
+    .wFirst       = 0,
+    .wCount       = NUM_PIXELS,
+    .wNumSteps    = 700,
+    .nTailLength  = 8,
+    .bGamma       = FALSE,
+    .anColorA     = { 0, 0, 4, 0 },
+    .anColorB     = { 255, 255, 255, 0 },
+  };
+
+  // initialize
+  NeoPixelHandler_FrameInitialize( &tStrip, NEOPIXEL_TYPE_GRB );
+  NeoPixelHandler_AnimStart( &tAnim );
+
+  // run two passes
+  for ( iStep = 0; iStep < 1400; iStep++ )
+  {
+    // get the head before rendering
+    uHead = tAnim.uPhase >> 16;
+
+    // render/commit/decode
+    iPasses += NeoPixelHandler_AnimRender( &tStrip, &tAnim );
+    NeoPixelHandler_FrameCommit( &tStrip );
+    iErrors += ( Decode( &tStrip ) == TRUE );
+
+    // count the lit pixels, the red channel is zero in the background
+    for ( iPixel = 0, iLit = 0; iPixel < NUM_PIXELS; iPixel++ )
+    {
+      iLit += ( anDecoded[ ( iPixel * 3 ) + anGrbOrder[ 0 ]] != 0 );
+    }
+
+    // the head is always lit, the tail is at most eight pixels
+    if (( anDecoded[ ( uHead * 3 ) + anGrbOrder[ 0 ]] == 0 ) || ( iLit > 8 ) || ( iLit < 7 ))
+    {
+      if ( iErrors++ < 5 )
+      {
+        printf( "  chase step %d: head %u, lit %d\n", iStep, uHead, iLit );
+      }
+    }
+  }
+
+  // check the passes
+  iErrors += ( iPasses != 2 );
+
+  // report
+  printf( "chase: %d steps, %d passes, %d errors\n", iStep, iPasses, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief run the timing
+ *
+ * This function will time a full strip update, a sparse update, a fade and a
+ * chase, each rendered and committed per frame
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  struct timespec tStart;
+  int             iFrame, iPixel;
+  double          dFull, dSparse, dFade, dChase;
+  NEOPIXELANIM    tFade =
+  {
+    .eType = NEOPIXEL_ANIM_FADE, .wFirst = 0, .wCount = NUM_PIXELS, .wNumSteps = TIMING_FRAMES,
+    .bGamma = TRUE, .anColorA = { 0, 0, 0, 0 }, .anColorB = { 255, 200, 100, 0 },
+  };
+  NEOPIXELANIM    tChase =
+  {
+    .eType = NEOPIXEL_ANIM_CHASE, .wFirst = 0, .wCount = NUM_PIXELS, .wNumSteps = 500, .nTailLength = 16,
+    .bGamma = TRUE, .anColorA = { 0, 0, 8, 0 }, .anColorB = { 255, 255, 255, 0 },
+  };
+
+  // full update, every pixel changes every frame
+  NeoPixelHandler_FrameInitialize( &tStrip, NEOPIXEL_TYPE_GRB );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( iFrame = 0; iFrame < TIMING_FRAMES; iFrame++ )
+  {
+    for ( iPixel = 0; iPixel < NUM_PIXELS; iPixel++ )
+    {
+      NeoPixelHandler_FrameSetPixel( &tStrip, iPixel, iFrame + iPixel, iFrame, iPixel, 0 );
+    }
+    NeoPixelHandler_FrameCommit( &tStrip );
+  }
+  dFull = ElapsedNsecs( &tStart ) / TIMING_FRAMES;
+
+  // sparse update
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( iFrame = 0; iFrame < TIMING_FRAMES; iFrame++ )
+  {
+    for ( iPixel = 0; iPixel < SPARSE_PIXELS; iPixel++ )
+    {
+      NeoPixelHandler_FrameSetPixel( &tStrip, ( iFrame * 37 + iPixel * 101 ) % NUM_PIXELS, iFrame, iPixel, 0, 0 );
+    }
+    NeoPixelHandler_FrameCommit( &tStrip );
+  }
+  dSparse = ElapsedNsecs( &tStart ) / TIMING_FRAMES;
+
+  // fade
+  NeoPixelHandler_AnimStart( &tFade );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( iFrame = 0; iFrame < TIMING_FRAMES; iFrame++ )
+  {
+    NeoPixelHandler_AnimRender( &tStrip, &tFade );
+    NeoPixelHandler_FrameCommit( &tStrip );
+  }
+  dFade = ElapsedNsecs( &tStart ) / TIMING_FRAMES;
+
+  // chase
+  NeoPixelHandler_AnimStart( &tChase );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( iFrame = 0; iFrame < TIMING_FRAMES; iFrame++ )
+  {
+    NeoPixelHandler_AnimRender( &tStrip, &tChase );
+    NeoPixelHandler_FrameCommit( &tStrip );
+  }
+  dChase = ElapsedNsecs( &tStart ) / TIMING_FRAMES;
+
+  // report
+  printf( "timing per frame, %d pixels:\n", NUM_PIXELS );
+  printf( "  full update     %8.1f usecs\n", dFull / 1000.0 );
+  printf( "  %2d pixel update %8.1f usecs\n", SPARSE_PIXELS, dSparse / 1000.0 );
+  printf( "  fade            %8.1f usecs\n", dFade / 1000.0 );
+  printf( "  chase           %8.1f usecs\n", dChase / 1000.0 );
+}
+
+/******************************************************************************
+ * @function ElapsedNsecs
+ *
+ * @brief get the elapsed time
+ *
+ * This function will return the nanoseconds since the start time
+ *
+ * @param[in]   ptStart     pointer to the start time
+ *
+ * @return      elapsed nanoseconds
+ *
+ *****************************************************************************/
+static double ElapsedNsecs( struct timespec* ptStart )
+{
+  struct timespec tStop;
+
+  // get the stop time
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+  return((( tStop.tv_sec - ptStart->tv_sec ) * 1e9 ) + ( tStop.tv_nsec - ptStart->tv_nsec ));
+}
+
+/**@} EOF NeoPixelFrameTest.c */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * @file NeoPixelHandler_prm.h
+ *
+ * @brief Neo Pixel Handler frame test parameter declarations
+ *
+ * This file provides the parameter declarations for the frame test, it builds
+ * the SPI frame buffers without the bit-banged output.  The symbol size can
+ * be overridden on the command line.
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup NeoPixelHandler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _NEOPIXELHANDLER_PRM_H
+#define _NEOPIXELHANDLER_PRM_H
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// disable the bit-banged refresh output
+#define NEOPIXELHANDLER_ENABLE_BITBANG        ( OFF )
+
+/// enable the SPI wire-format frame buffers/animation renderer
+#define NEOPIXELHANDLER_ENABLE_SPIFRAME       ( ON )
+
+/// define the number of SPI bits per pixel data bit ( 3 = 2.4MHz, 4 = 3.2MHz )
+#ifndef NEOPIXELHANDLER_SPI_BITS_PER_BIT
+#define NEOPIXELHANDLER_SPI_BITS_PER_BIT      ( 3 )
+#endif
+
+/// define the reset/latch time appended to each frame in microseconds
+#define NEOPIXELHANDLER_SPI_RESET_USEC        ( 300 )
+
+/**@} EOF NeoPixelHandler_prm.h */
+
+#endif  // _NEOPIXELHANDLER_PRM_H
@@ -32,6 +32,7 @@
 #include "SenBME280/SenBME280.h"
 
 // library includes -----------------------------------------------------------
+#include "Types/Types.h"
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
   #include "TaskManager/TaskManager.h"
 #endif // SYSTEMDEFINE_OS_SELECTION
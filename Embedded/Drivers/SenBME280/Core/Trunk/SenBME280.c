@@ -54,7 +54,7 @@
 #define PRESS_MAX_VALUE               ( 110000 )
 
 /// define the humidity max values
-#define HUMID_MAX_VALUE               ( 100000 )
+#define HUMID_MAX_VALUE               ( 102400 )
 
 /// define the soft reset command
 #define SFW_RESET_COMMAND             ( 0xB6 )
@@ -104,46 +104,6 @@ typedef enum _CTLCONFIGSTBY
 } CTLCONFIGSTBY;
 
 // structures -----------------------------------------------------------------
-/// define the temperature/pressure calibration structure
-typedef struct _TEMPPRESCALIB
-{
-  U16   wT1;                    ///< T1 calibration 
-  S16   wT2;                    ///< T2 calibration
-  S16   wT3;                    ///< T3 calibration
-  U16   wP1;                    ///< P1 calibration
-  S16   wP2;                    ///< P2 calibration
-  S16   wP3;                    ///< P3 calibration
-  S16   wP4;                    ///< P4 calibration
-  S16   wP5;                    ///< P5 calibration
-  S16   wP6;                    ///< P6 calibration
-  S16   wP7;                    ///< P7 calibration
-  S16   wP8;                    ///< P8 calibration
-  S16   wP9;                    ///< P9 calibration
-  U8    nReserved;              ///< reserved
-  U8    nH1;                    ///< H1 calibration
-} TEMPPRESCALIB, *PTEMPPRESCALIB;
-#define TEMPPRESCALIB_SIZE          sizeof( TEMPPRESCALIB )
-
-/// define the humidity calibration structure
-typedef struct _HUMIDCALIB
-{
-  S16   wH2;                    ///< H2 calibration
-  U8    nH3;                    ///< H3 calibration
-  S16   wH4;                    ///< H4 calibration
-  S16   wH5;                    ///< H5 calibration
-  S8    nH6;                    ///< H6 calibration
-} HUMIDCALIB, *PHUMIDCALIB;
-#define HUMIDCALIB_SIZE            sizeof( HUMIDCALIB )
-
-/// define the combined calibration structure
-typedef struct _CALIBRATION
-{
-  TEMPPRESCALIB   tTempPres;    ///< temperature pressure calibration
-  HUMIDCALIB      tHumidity;    ///< humidity calibration
-  S32             uCalcFine;    ///< temperature fine
-} CALIBRATION, *PCALIBRATION;
-#define CALIBRATION_SIZE          sizeof( CALIBRATION )
-
 /// define the data structure
 typedef struct _MEASUREMENTS
 {
@@ -197,7 +157,8 @@ typedef struct _REGISTERS
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
-static  CALIBRATION tCalibrationData;
+static  SENBME280COMP tComp;
+static  S32         lTempFine;
 static  FLOAT       afActualValues[ SENBME280_MEASTYPE_MAX ];
 static  S32         alRawValues[ SENBME280_MEASTYPE_MAX ];
 static  BOOL        bSensorOk;
@@ -207,7 +168,10 @@ static  void    GetMeasurements( void );
 static  FLOAT   CompensateTemperature( S32 lRawTemp );
 static  FLOAT   CompensatePressure( S32 uRawPress );
 static  FLOAT   CompensateHumidity( S32 uRawHumid );
-static  void    ParseHumidityCalibration( U8 *tHumidCalib );
+static  void    ParseFrame( PU8 pnFrame, PS32 plTemp, PS32 plPress, PS32 plHumid );
+static  S32     ComputeTemperature( PSENBME280COMP ptComp, S32 lRawTemp, PS32 plFine );
+static  U32     ComputePressure( PSENBME280COMP ptComp, S32 lRawPress, S32 lFine );
+static  U32     ComputeHumidity( PSENBME280COMP ptComp, S32 lRawHumid, S32 lFine );
 static  BOOL    ReadCalibrationData( void );
 static  BOOL    SetSensorControl( CTLMEASMODE eMode );
 
@@ -499,32 +463,17 @@ FLOAT SenBME280_GetPressure( void )
 static void GetMeasurements( void )
 {
     MEASUREMENTS  tMeasurements;
-    S32           lMeasValue;
   
     // set up for the read
     if( !SenBME280_ReadRegisters( REG_MEAS_BASE, ( PU8 )&tMeasurements, MEASUREMENTS_SIZE ))
     {
-      // perform compensation
-      lMeasValue = ( ((U32) tMeasurements.nTempMsb) << 12 );
-      lMeasValue |= ( ((U32) tMeasurements.nTempLsb) << 4 );
-      lMeasValue |= ( ((U32) tMeasurements.nTempXlsb) >> 4 );
-      alRawValues[ SENBME280_MEASTYPE_TEMP ] = lMeasValue;
+      // parse the frame
+      ParseFrame(( PU8 )&tMeasurements, &alRawValues[ SENBME280_MEASTYPE_TEMP ], &alRawValues[ SENBME280_MEASTYPE_PRES ], &alRawValues[ SENBME280_MEASTYPE_HUMD ] );
+
+      // perform compensation, temperature first for the fine temperature
       #if ( SENBME280_COMPENSATE_AT_MEASURE == TRUE )
         afActualValues[ SENBME280_MEASTYPE_TEMP ] = CompensateTemperature( alRawValues[ SENBME280_MEASTYPE_TEMP ] );
-      #endif // SENBME280_COMPENSATE_AT_MEASURE
-      
-      lMeasValue = ( ((U32) tMeasurements.nPressMsb) << 12 );
-      lMeasValue |= ( ((U32) tMeasurements.nPressLsb) << 4 );
-      lMeasValue |= ( ((U32) tMeasurements.nPressXlsb) >> 4 );
-      alRawValues[ SENBME280_MEASTYPE_PRES ] = lMeasValue;
-      #if ( SENBME280_COMPENSATE_AT_MEASURE == TRUE )
         afActualValues[ SENBME280_MEASTYPE_PRES ] = CompensatePressure( alRawValues[ SENBME280_MEASTYPE_PRES ] );
-      #endif // SENBME280_COMPENSATE_AT_MEASURE
-      
-      lMeasValue = ( ((U32) tMeasurements.nHumidMsb) << 8 );
-      lMeasValue |= ( tMeasurements.nHumidLsb );
-      alRawValues[ SENBME280_MEASTYPE_HUMD ] = lMeasValue;
-      #if ( SENBME280_COMPENSATE_AT_MEASURE == TRUE )
         afActualValues[ SENBME280_MEASTYPE_HUMD ] = CompensateHumidity( alRawValues[ SENBME280_MEASTYPE_HUMD ] );
       #endif // SENBME280_COMPENSATE_AT_MEASURE
     }
@@ -539,6 +488,118 @@ static void GetMeasurements( void )
     }
 }
 
+/******************************************************************************
+ * @function SenBME280_PrepareCompensation
+ *
+ * @brief prepare the compensation
+ *
+ * This function will unpack the calibration registers and pre-scale the
+ * coefficients into the compensation structure
+ *
+ * @param[in]   pnTempPresCalib   temperature/pressure calibration registers
+ * @param[in]   pnHumidCalib      humidity calibration registers
+ * @param[io]   ptComp            pointer to the compensation structure
+ *
+ *****************************************************************************/
+void SenBME280_PrepareCompensation( PU8 pnTempPresCalib, PU8 pnHumidCalib, PSENBME280COMP ptComp )
+{
+  // temperature, little endian
+  ptComp->lT1 = ( U16 )( pnTempPresCalib[ 0 ] | ( pnTempPresCalib[ 1 ] << 8 ));
+  ptComp->lT1x2 = ptComp->lT1 << 1;
+  ptComp->lT2 = ( S16 )( pnTempPresCalib[ 2 ] | ( pnTempPresCalib[ 3 ] << 8 ));
+  ptComp->lT3 = ( S16 )( pnTempPresCalib[ 4 ] | ( pnTempPresCalib[ 5 ] << 8 ));
+
+  // pressure
+  ptComp->lP1 = ( U16 )( pnTempPresCalib[ 6 ] | ( pnTempPresCalib[ 7 ] << 8 ));
+  ptComp->lP2 = ( S16 )( pnTempPresCalib[ 8 ] | ( pnTempPresCalib[ 9 ] << 8 ));
+  ptComp->lP3 = ( S16 )( pnTempPresCalib[ 10 ] | ( pnTempPresCalib[ 11 ] << 8 ));
+  ptComp->hP4 = ( S64 )(( S16 )( pnTempPresCalib[ 12 ] | ( pnTempPresCalib[ 13 ] << 8 ))) << 35;
+  ptComp->lP5 = ( S16 )( pnTempPresCalib[ 14 ] | ( pnTempPresCalib[ 15 ] << 8 ));
+  ptComp->lP6 = ( S16 )( pnTempPresCalib[ 16 ] | ( pnTempPresCalib[ 17 ] << 8 ));
+  ptComp->lP7 = ( S32 )(( S16 )( pnTempPresCalib[ 18 ] | ( pnTempPresCalib[ 19 ] << 8 ))) * 16;
+  ptComp->lP8 = ( S16 )( pnTempPresCalib[ 20 ] | ( pnTempPresCalib[ 21 ] << 8 ));
+  ptComp->lP9 = ( S16 )( pnTempPresCalib[ 22 ] | ( pnTempPresCalib[ 23 ] << 8 ));
+
+  // humidity, H4 and H5 share the nibbles of the middle byte
+  ptComp->lH1 = pnTempPresCalib[ 25 ];
+  ptComp->lH2 = ( S16 )( pnHumidCalib[ 0 ] | ( pnHumidCalib[ 1 ] << 8 ));
+  ptComp->lH3 = pnHumidCalib[ 2 ];
+  ptComp->lH4 = ( S32 )(( S16 )((( S8 )pnHumidCalib[ 3 ] * 16 ) | ( pnHumidCalib[ 4 ] & 0x0F ))) * 1048576;
+  ptComp->lH5 = ( S16 )((( S8 )pnHumidCalib[ 5 ] * 16 ) | ( pnHumidCalib[ 4 ] >> 4 ));
+  ptComp->lH6 = ( S8 )pnHumidCalib[ 6 ];
+}
+
+/******************************************************************************
+ * @function SenBME280_GetCompensation
+ *
+ * @brief get the compensation
+ *
+ * This function will return the compensation prepared from the sensor at
+ * initialization
+ *
+ * @return      pointer to the compensation structure
+ *
+ *****************************************************************************/
+PSENBME280COMP SenBME280_GetCompensation( void )
+{
+  // return the pointer
+  return( &tComp );
+}
+
+/******************************************************************************
+ * @function SenBME280_CompensateBurst
+ *
+ * @brief compensate a burst of frames
+ *
+ * This function will compensate a burst of raw measurement frames in integer
+ * arithmetic
+ *
+ * @param[in]   ptComp        pointer to the compensation structure
+ * @param[in]   pnFrames      pointer to the frames
+ * @param[in]   wNumFrames    number of frames
+ * @param[io]   ptValues      pointer to the values
+ *
+ *****************************************************************************/
+void SenBME280_CompensateBurst( PSENBME280COMP ptComp, PU8 pnFrames, U16 wNumFrames, PSENBME280VALUE ptValues )
+{
+  S32 lRawTemp, lRawPress, lRawHumid, lFine;
+
+  // for each frame
+  while ( wNumFrames-- != 0 )
+  {
+    // parse and compensate, temperature first for the fine temperature
+    ParseFrame( pnFrames, &lRawTemp, &lRawPress, &lRawHumid );
+    ptValues->lTemperature = ComputeTemperature( ptComp, lRawTemp, &lFine );
+    ptValues->uPressure = ComputePressure( ptComp, lRawPress, lFine );
+    ptValues->uHumidity = ComputeHumidity( ptComp, lRawHumid, lFine );
+
+    // next frame
+    pnFrames += SENBME280_FRAME_SIZE;
+    ptValues++;
+  }
+}
+
+/******************************************************************************
+ * @function ParseFrame
+ *
+ * @brief parse a measurement frame
+ *
+ * This function will assemble the raw values from a measurement frame
+ *
+ * @param[in]   pnFrame     pointer to the frame
+ * @param[io]   plTemp      pointer to the raw temperature
+ * @param[io]   plPress     pointer to the raw pressure
+ * @param[io]   plHumid     pointer to the raw humidity
+ *
+ *****************************************************************************/
+static void ParseFrame( PU8 pnFrame, PS32 plTemp, PS32 plPress, PS32 plHumid )
+{
+  // assemble the values
+  *( plPress ) = (( U32 )pnFrame[ 0 ] << 12 ) | (( U32 )pnFrame[ 1 ] << 4 ) | ( pnFrame[ 2 ] >> 4 );
+  *( plTemp ) = (( U32 )pnFrame[ 3 ] << 12 ) | (( U32 )pnFrame[ 4 ] << 4 ) | ( pnFrame[ 5 ] >> 4 );
+  *( plHumid ) = (( U32 )pnFrame[ 6 ] << 8 ) | pnFrame[ 7 ];
+}
+
 /******************************************************************************
  * @function CompensateTemperature
  *
@@ -553,32 +614,14 @@ static void GetMeasurements( void )
  *****************************************************************************/
 static FLOAT CompensateTemperature( S32 lRawTemp )
 {
-  FLOAT fValue = 0.0;
-  S32   lTemp1, lTemp2, lTemperature;
-  
-  // perform the compensation
-  lTemp1 = ( lRawTemp / 8 ) - ( (( S32 ) tCalibrationData.tTempPres.wT1 ) * 2 );
-  lTemp1 = ( lTemp1 * tCalibrationData.tTempPres.wT2 ) / 2048;
-  lTemp2 = ( lRawTemp / 16 ) - (( S32 ) tCalibrationData.tTempPres.wT1 );
-  lTemp2 = ((( lTemp2 * lTemp2 ) / 4096 ) * (( S32 ) tCalibrationData.tTempPres.wT3 )) / 16384;
-  tCalibrationData.uCalcFine = lTemp1 + lTemp2;
-  lTemperature = (tCalibrationData.uCalcFine * 5 + 128) / 256;
-  
-  // ensure within min/max
-  if ( lTemperature < TEMP_MIN_VALUE )
-  {
-    lTemperature = TEMP_MIN_VALUE;
-  }
-  else if ( lTemperature > TEMP_MAX_VALUE )
-  {
-    lTemperature = TEMP_MAX_VALUE;
-  }
+  S32   lTemperature;
   
-  // make it a flot
-  fValue = ( FLOAT )lTemperature / ( FLOAT )100.0;
+  // perform the compensation, ensure within min/max
+  lTemperature = ComputeTemperature( &tComp, lRawTemp, &lTempFine );
+  lTemperature = CONSTRAIN( lTemperature, TEMP_MIN_VALUE, TEMP_MAX_VALUE );
   
   // return the value
-  return( fValue );
+  return(( FLOAT )lTemperature / 100.0f );
 }
 
 /******************************************************************************
@@ -596,60 +639,14 @@ static FLOAT CompensateTemperature( S32 lRawTemp )
  *****************************************************************************/
 static FLOAT CompensatePressure( S32 uRawPress )
 {
-  FLOAT fValue = 0.0;
-  S32   lTemp1, lTemp2, lTemp3, lTemp4;
-  U32   uTemp5, uPressure;
+  U32   uPressure;
   
-  // perform the compensation
-  lTemp1 = ((( S32 )tCalibrationData.uCalcFine ) / 2 ) - ( S32 )64000;
-  lTemp2 = ((( lTemp1 / 4 ) * ( lTemp1 / 4 )) / 2048 ) * (( S32 )tCalibrationData.tTempPres.wP6 );
-  lTemp2 = lTemp2 + (( lTemp1 * (( S32 )tCalibrationData.tTempPres.wP5 )) * 2 );
-  lTemp2 = ( lTemp2 / 4 ) + ((( S32 )tCalibrationData.tTempPres.wP4 ) * 65536);
-  lTemp3 = ( tCalibrationData.tTempPres.wP3 * ((( lTemp1 / 4 ) * ( lTemp1 / 4 )) / 8192 )) / 8;
-  lTemp4 = ((( S32 )tCalibrationData.tTempPres.wP2 ) * lTemp1 ) / 2;
-  lTemp1 = ( lTemp3 + lTemp4 ) / 262144;
-  lTemp1 = ((( 32768 + lTemp1 )) * (( S32 )tCalibrationData.tTempPres.wP1 )) / 32768;
-
-  //// check for division by zero
-  if ( lTemp1 != 0 )
-  {
-    uTemp5 = ( U32 )(( U32 )1048576 ) - uRawPress;
-    uPressure = (( U32 )( uTemp5 - ( U32 )( lTemp2 / 4096 ))) * 3125;
-
-    if ( uPressure < 0x80000000 )
-    {
-      uPressure = ( uPressure << 1 ) / (( U32 )lTemp1 );
-    }
-    else
-    {
-      uPressure = ( uPressure / ( U32 )lTemp1 ) * 2;
-    }
-
-    //// apply the rest of the compensation
-    lTemp1 = ((( S32 )tCalibrationData.tTempPres.wP9 ) * (( S32 )((( uPressure / 8 ) * ( uPressure / 8 )) / 8192 ))) / 4096;
-    lTemp2 = ((( S32 )( uPressure / 4 )) * (( S32 )tCalibrationData.tTempPres.wP8 )) / 8192;
-    uPressure = ( U32 )(( S32 )uPressure + (( lTemp1 + lTemp2 + tCalibrationData.tTempPres.wP7 ) / 16 ));
-
-    // check for range
-    if ( uPressure < PRESS_MIN_VALUE )
-    {
-      uPressure = PRESS_MIN_VALUE;
-    }
-    else if ( uPressure > PRESS_MAX_VALUE )
-    {
-      uPressure = PRESS_MAX_VALUE;
-    }
-  }
-  else
-  {
-    uPressure = PRESS_MIN_VALUE;
-  }
+  // perform the compensation, check for range
+  uPressure = ComputePressure( &tComp, uRawPress, lTempFine );
+  uPressure = CONSTRAIN( uPressure, ( U32 )PRESS_MIN_VALUE << 8, ( U32 )PRESS_MAX_VALUE << 8 );
     
-  // make it a float
-  fValue = ( FLOAT )uPressure / 100.0;
-
-  // return the value
-  return( fValue );
+  // return the value in hPa
+  return(( FLOAT )uPressure / 25600.0f );
 }
 
 /******************************************************************************
@@ -666,67 +663,112 @@ static FLOAT CompensatePressure( S32 uRawPress )
  *****************************************************************************/
 static FLOAT CompensateHumidity( S32 uRawHumid )
 {
-  FLOAT fValue = 0.0;
-  S32   lVar1, lVar2, lVar3, lVar4, lVar5;
-  U32   uHumidity = 0;
-
-  lVar1 = tCalibrationData.uCalcFine - (( S32 )76800);
-  lVar2 = ( S32 )( uRawHumid * 16384 );
-  lVar3 = ( S32 )((( S32 )tCalibrationData.tHumidity.wH4 ) * 1048576 );
-  lVar4 = (( S32 )tCalibrationData.tHumidity.wH5 ) * lVar1;
-  lVar5 = ((( lVar2 - lVar3 ) - lVar4 ) + ( S32 )16384) / 32768;
-  lVar2 = ( lVar1 * ( S32 )tCalibrationData.tHumidity.nH6 ) / 1024;
-  lVar3 = ( lVar1 * ( S32 )tCalibrationData.tHumidity.nH3 ) / 2048;
-  lVar4 = (( lVar2 * ( lVar3 + ( S32 )32768 )) / 1024 ) + ( S32 )2097152;
-  lVar2 = (( lVar4 * ( S32 )tCalibrationData.tHumidity.wH2 + 8192 )) / 16384;
-  lVar3 = lVar5 * lVar2;
-  lVar4 = (( lVar3 / 32768 ) * ( lVar3 / 32768 )) /128;
-  lVar5 = lVar3 - (( lVar4 * ( S32 )tCalibrationData.tTempPres.nH1 ) / 16 );
-  lVar5 = ( lVar5 < 0 ) ? 0 : lVar5;
-  lVar5 = ( lVar5 > 419430400 ) ? 41930400 : lVar5;
-  uHumidity = ( U32 )( lVar5 / 4096 );
-
-  // check for overflow
-  if ( uHumidity > HUMID_MAX_VALUE )
-  {
-    uHumidity = HUMID_MAX_VALUE;
-  }
-  
-  // convert to a float
-  fValue = ( FLOAT )uHumidity / 1000.0;
+  U32   uHumidity;
 
+  // perform the compensation, check for overflow
+  uHumidity = ComputeHumidity( &tComp, uRawHumid, lTempFine );
+  uHumidity = MIN( uHumidity, HUMID_MAX_VALUE );
+  
   // return the value
-  return( fValue );
+  return(( FLOAT )uHumidity / 1024.0f );
 }
 
 /******************************************************************************
- * @function ParseHumidityCalibration
+ * @function ComputeTemperature
  *
- * @brief parse the raw humidity calibration data
+ * @brief compute the temperature
  *
- * This function will parese the raw humidity calibration data received from
- * the device
+ * This function will compute the temperature with the 32 bit integer
+ * formula and return the fine temperature for the others
  *
- * @param[in] *tHumidCalib   Pointer to raw humidity calibration as read from
- *                           the device
+ * @param[in]   ptComp      pointer to the compensation structure
+ * @param[in]   lRawTemp    raw temperature
+ * @param[io]   plFine      pointer to the fine temperature
+ *
+ * @return      temperature in hundredths of a degree C
  *
- * @return    void
  *****************************************************************************/
-static void ParseHumidityCalibration( U8 *tHumidCalib )
+static S32 ComputeTemperature( PSENBME280COMP ptComp, S32 lRawTemp, PS32 plFine )
 {
-  S16 wH4msb, wH4lsb, wH5msb, wH5lsb;
+  S32 lVar1, lVar2;
 
-  wH4msb = ((S16) tHumidCalib[3]) * 16;
-  wH4lsb = (S16) (tHumidCalib[4] & 0x0F);
+  // perform the compensation
+  lVar1 = ((( lRawTemp >> 3 ) - ptComp->lT1x2 ) * ptComp->lT2 ) >> 11;
+  lVar2 = ( lRawTemp >> 4 ) - ptComp->lT1;
+  lVar2 = ((( lVar2 * lVar2 ) >> 12 ) * ptComp->lT3 ) >> 14;
+  *( plFine ) = lVar1 + lVar2;
 
-  wH5msb = ((S16) tHumidCalib[5]) * 16;
-  wH5lsb = (S16) (tHumidCalib[4] >> 4) & 0x0F;
+  // return the temperature
+  return((( *( plFine ) * 5 ) + 128 ) >> 8 );
+}
+
+/******************************************************************************
+ * @function ComputePressure
+ *
+ * @brief compute the pressure
+ *
+ * This function will compute the pressure with the 64 bit integer formula
+ *
+ * @param[in]   ptComp      pointer to the compensation structure
+ * @param[in]   lRawPress   raw pressure
+ * @param[in]   lFine       fine temperature
+ *
+ * @return      pressure in Pa, Q24.8
+ *
+ *****************************************************************************/
+static U32 ComputePressure( PSENBME280COMP ptComp, S32 lRawPress, S32 lFine )
+{
+  S64 hVar1, hVar2, hPress;
+  U32 uPressure = 0;
+
+  // compute the offset and the sensitivity
+  hVar1 = ( S64 )lFine - 128000;
+  hVar2 = ( hVar1 * hVar1 * ptComp->lP6 ) + (( hVar1 * ptComp->lP5 ) << 17 ) + ptComp->hP4;
+  hVar1 = ((( hVar1 * hVar1 * ptComp->lP3 ) >> 8 ) + (( hVar1 * ptComp->lP2 ) << 12 ));
+  hVar1 = ((( S64 )1 << 47 ) + hVar1 ) * ptComp->lP1 >> 33;
+
+  // check for division by zero
+  if ( hVar1 != 0 )
+  {
+    // apply the rest of the compensation
+    hPress = 1048576 - lRawPress;
+    hPress = ((( hPress << 31 ) - hVar2 ) * 3125 ) / hVar1;
+    hVar1 = ( ptComp->lP9 * ( hPress >> 13 ) * ( hPress >> 13 )) >> 25;
+    hVar2 = ( ptComp->lP8 * hPress ) >> 19;
+    uPressure = ( U32 )((( hPress + hVar1 + hVar2 ) >> 8 ) + ptComp->lP7 );
+  }
 
-  tCalibrationData.tHumidity.wH2 = (((U16) tHumidCalib[1]) << 8) | tHumidCalib[0];
-  tCalibrationData.tHumidity.nH3 = tHumidCalib[2];
-  tCalibrationData.tHumidity.wH4 = wH4msb | wH4lsb;
-  tCalibrationData.tHumidity.wH5 = wH5msb | wH5lsb;
-  tCalibrationData.tHumidity.nH6 = tHumidCalib[6];
+  // return the pressure
+  return( uPressure );
+}
+
+/******************************************************************************
+ * @function ComputeHumidity
+ *
+ * @brief compute the humidity
+ *
+ * This function will compute the humidity with the 32 bit integer formula
+ *
+ * @param[in]   ptComp      pointer to the compensation structure
+ * @param[in]   lRawHumid   raw humidity
+ * @param[in]   lFine       fine temperature
+ *
+ * @return      humidity in %RH, Q22.10
+ *
+ *****************************************************************************/
+static U32 ComputeHumidity( PSENBME280COMP ptComp, S32 lRawHumid, S32 lFine )
+{
+  S32 lVar;
+
+  // perform the compensation
+  lVar = lFine - 76800;
+  lVar = (((( lRawHumid << 14 ) - ptComp->lH4 - ( ptComp->lH5 * lVar )) + 16384 ) >> 15 ) *
+         (((((((( lVar * ptComp->lH6 ) >> 10 ) * ((( lVar * ptComp->lH3 ) >> 11 ) + 32768 )) >> 10 ) + 2097152 ) * ptComp->lH2 ) + 8192 ) >> 14 );
+  lVar = lVar - ((((( lVar >> 15 ) * ( lVar >> 15 )) >> 7 ) * ptComp->lH1 ) >> 4 );
+  lVar = CONSTRAIN( lVar, 0, 419430400 );
+
+  // return the humidity
+  return(( U32 )lVar >> 12 );
 }
 
 /******************************************************************************
@@ -742,16 +784,17 @@ static void ParseHumidityCalibration( U8 *tHumidCalib )
 static BOOL ReadCalibrationData( void )
 {
   BOOL      bResult = TRUE;
-  U8        tTempHumidCalib[7] = {0};
+  U8        anTempPresCalib[ SENBME280_TEMPPRES_CALIB_SIZE ];
+  U8        anHumidCalib[ SENBME280_HUMID_CALIB_SIZE ];
   
   // setup temperature calibration data read
-  if ( !SenBME280_ReadRegisters( REG_TEMPPRES_CALIB, ( PU8 )&tCalibrationData.tTempPres, TEMPPRESCALIB_SIZE ))
+  if ( !SenBME280_ReadRegisters( REG_TEMPPRES_CALIB, anTempPresCalib, SENBME280_TEMPPRES_CALIB_SIZE ))
   {
     // setup humidity calibration data read
-    if ( !SenBME280_ReadRegisters( REG_TEMPHUMID_CALIB, tTempHumidCalib, 7))
+    if ( !SenBME280_ReadRegisters( REG_TEMPHUMID_CALIB, anHumidCalib, SENBME280_HUMID_CALIB_SIZE ))
     {
-      // parse humidity calibration
-      ParseHumidityCalibration(tTempHumidCalib);
+      // prepare the compensation
+      SenBME280_PrepareCompensation( anTempPresCalib, anHumidCalib, &tComp );
        
       // set the good result flag
       bResult = FALSE;
@@ -35,6 +35,12 @@
 #include "TaskManager/TaskManager.h"
 
 // Macros and Defines ---------------------------------------------------------
+/// define the calibration register block sizes
+#define SENBME280_TEMPPRES_CALIB_SIZE           ( 26 )
+#define SENBME280_HUMID_CALIB_SIZE              ( 7 )
+
+/// define the size of a measurement frame, the registers from pressure MSB to humidity LSB
+#define SENBME280_FRAME_SIZE                    ( 8 )
 
 // enumerations ---------------------------------------------------------------
 /// enumerate the measure type
@@ -47,6 +53,39 @@ typedef enum _SENBME280MEASTYPE
 } SENBME280MEASTYPE;
 
 // structures -----------------------------------------------------------------
+/// define the compensation structure, the coefficients pre-scaled once at init
+typedef struct _SENBME280COMP
+{
+  S64   hP4;                    ///< P4 shifted left 35
+  S32   lT1;                    ///< T1
+  S32   lT1x2;                  ///< T1 shifted left 1
+  S32   lT2;                    ///< T2
+  S32   lT3;                    ///< T3
+  S32   lP1;                    ///< P1
+  S32   lP2;                    ///< P2
+  S32   lP3;                    ///< P3
+  S32   lP5;                    ///< P5
+  S32   lP6;                    ///< P6
+  S32   lP7;                    ///< P7 shifted left 4
+  S32   lP8;                    ///< P8
+  S32   lP9;                    ///< P9
+  S32   lH1;                    ///< H1
+  S32   lH2;                    ///< H2
+  S32   lH3;                    ///< H3
+  S32   lH4;                    ///< H4 shifted left 20
+  S32   lH5;                    ///< H5
+  S32   lH6;                    ///< H6
+} SENBME280COMP, *PSENBME280COMP;
+#define SENBME280COMP_SIZE                      sizeof( SENBME280COMP )
+
+/// define the compensated value structure
+typedef struct _SENBME280VALUE
+{
+  S32   lTemperature;           ///< temperature in hundredths of a degree C
+  U32   uPressure;              ///< pressure in Pa, Q24.8
+  U32   uHumidity;              ///< humidity in %RH, Q22.10
+} SENBME280VALUE, *PSENBME280VALUE;
+#define SENBME280VALUE_SIZE                     sizeof( SENBME280VALUE )
 
 // global parameter declarations -----------------------------------------------
 
@@ -59,6 +98,9 @@ extern  BOOL    SenBME280_GetMeasurement( SENBME280MEASTYPE eMeasType, PFLOAT pf
 extern  FLOAT   SenBME280_GetTemperature( void );
 extern  FLOAT   SenBME280_GetHumidity( void );
 extern  FLOAT   SenBME280_GetPressure( void );
+extern  void    SenBME280_PrepareCompensation( PU8 pnTempPresCalib, PU8 pnHumidCalib, PSENBME280COMP ptComp );
+extern  PSENBME280COMP SenBME280_GetCompensation( void );
+extern  void    SenBME280_CompensateBurst( PSENBME280COMP ptComp, PU8 pnFrames, U16 wNumFrames, PSENBME280VALUE ptValues );
 
 
 /**@} EOF SenBME280.h */
@@ -0,0 +1,489 @@
+/******************************************************************************
+ * @file SenBME280CompTest.c
+ *
+ * @brief Bosch Sensortec BME280 compensation test
+ *
+ * This file provides a host tool that runs the BME280 driver against a
+ * simulated register map loaded with a calibration register dump, the
+ * datasheet example temperature and pressure coefficients with typical
+ * humidity coefficients.  It checks the datasheet example reading, reads
+ * samples through the driver, and compensates a sweep of raw measurement
+ * frames with the integer burst compensation, comparing every sample against
+ * the datasheet double precision formulas.  It then times both paths per
+ * sample.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o SenBME280CompTest
+ *             SenBME280CompTest.c ../../Core/Trunk/SenBME280.c -lm
+ * usage:      SenBME280CompTest
+ *
+ * @copyright Copyright (c) 2017 Guardhat
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup SenBME280
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "SenBME280/SenBME280.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the register addresses
+#define REG_TEMPPRES_CALIB                          ( 0x88 )
+#define REG_CHIPID                                  ( 0xD0 )
+#define REG_TEMPHUMID_CALIB                         ( 0xE1 )
+#define REG_MEAS_BASE                               ( 0xF7 )
+
+/// define the sweep size per axis
+#define SWEEP_STEPS                                 ( 24 )
+#define NUM_FRAMES                                  ( SWEEP_STEPS * SWEEP_STEPS * SWEEP_STEPS )
+
+/// define the number of timing passes
+#define TIMING_PASSES                               ( 50 )
+
+/// define the agreement limits
+#define LIMIT_TEMP                                  ( 0.01 )
+#define LIMIT_PRESS                                 ( 1.0 )
+#define LIMIT_HUMID                                 ( 0.05 )
+
+// structures -----------------------------------------------------------------
+/// define the reference structure
+typedef struct _REFVALUE
+{
+  double  dTemperature;     ///< temperature in C
+  double  dPressure;        ///< pressure in Pa
+  double  dHumidity;        ///< humidity in %RH
+} REFVALUE, *PREFVALUE;
+
+// local parameter declarations -----------------------------------------------
+/// define the calibration dump, 0x88 through 0xA1
+static  const U8  anTempPresDump[ SENBME280_TEMPPRES_CALIB_SIZE ] =
+{
+  0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC, 0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B, 0x27, 0x0B, 0x8C, 0x00,
+  0xF9, 0xFF, 0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17, 0x00, 0x4B
+};
+
+/// define the humidity calibration dump, 0xE1 through 0xE7
+static  const U8  anHumidDump[ SENBME280_HUMID_CALIB_SIZE ] =
+{
+  0x72, 0x01, 0x00, 0x13, 0x29, 0x03, 0x1E
+};
+
+static  U8              anRegisters[ 256 ];
+static  U8              anFrames[ NUM_FRAMES * SENBME280_FRAME_SIZE ];
+static  SENBME280VALUE  atValues[ NUM_FRAMES ];
+static  REFVALUE        atRefs[ NUM_FRAMES ];
+
+// local function prototypes --------------------------------------------------
+static  void    Reference( S32 lRawTemp, S32 lRawPress, S32 lRawHumid, PREFVALUE ptRef );
+static  void    BuildFrame( PU8 pnFrame, S32 lRawTemp, S32 lRawPress, S32 lRawHumid );
+static  void    ParseFrame( PU8 pnFrame, PS32 plTemp, PS32 plPress, PS32 plHumid );
+static  int     RunExample( void );
+static  int     RunDriver( void );
+static  int     RunBurst( void );
+static  void    RunTiming( void );
+static  double  GetTime( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will initialize the driver and run the checks
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+
+  // load the register map and initialize
+  anRegisters[ REG_CHIPID ] = 0x60;
+  memcpy( &anRegisters[ REG_TEMPPRES_CALIB ], anTempPresDump, SENBME280_TEMPPRES_CALIB_SIZE );
+  memcpy( &anRegisters[ REG_TEMPHUMID_CALIB ], anHumidDump, SENBME280_HUMID_CALIB_SIZE );
+  if ( SenBME280_Initialize( ))
+  {
+    printf( "initialize failed\n" );
+    return( 1 );
+  }
+
+  // run the checks
+  iErrors += RunExample( );
+  iErrors += RunDriver( );
+  iErrors += RunBurst( );
+  RunTiming( );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function SenBME280_ReadRegisters
+ *
+ * @brief read registers
+ *
+ * This function will read the simulated register map
+ *
+ * @param[in]   nRegister   first register
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   nLength     number of registers
+ *
+ * @return      FALSE
+ *
+ *****************************************************************************/
+BOOL SenBME280_ReadRegisters( U8 nRegister, PU8 pnData, U8 nLength )
+{
+  // copy them
+  memcpy( pnData, &anRegisters[ nRegister ], nLength );
+  return( FALSE );
+}
+
+/******************************************************************************
+ * @function SenBME280_WriteRegister
+ *
+ * @brief write a register
+ *
+ * This function will write the simulated register map
+ *
+ * @param[in]   nRegister   register
+ * @param[in]   nData       data
+ *
+ * @return      FALSE
+ *
+ *****************************************************************************/
+BOOL SenBME280_WriteRegister( U8 nRegister, U8 nData )
+{
+  // store it
+  anRegisters[ nRegister ] = nData;
+  return( FALSE );
+}
+
+/******************************************************************************
+ * @function SystemTick_DelayMsec
+ *
+ * @brief delay
+ *
+ * This function will ignore the delay
+ *
+ * @param[in]   wMsecs      delay in milliseconds
+ *
+ *****************************************************************************/
+void SystemTick_DelayMsec( U16 wMsecs )
+{
+  ( void )wMsecs;
+}
+
+/******************************************************************************
+ * @function Reference
+ *
+ * @brief reference compensation
+ *
+ * This function will compensate with the datasheet double precision formulas
+ * from the calibration dump
+ *
+ * @param[in]   lRawTemp    raw temperature
+ * @param[in]   lRawPress   raw pressure
+ * @param[in]   lRawHumid   raw humidity
+ * @param[io]   ptRef       pointer to the reference values
+ *
+ *****************************************************************************/
+static void Reference( S32 lRawTemp, S32 lRawPress, S32 lRawHumid, PREFVALUE ptRef )
+{
+  const U8* pnC = anTempPresDump;
+  const U8* pnH = anHumidDump;
+  double    dT1 = ( U16 )( pnC[ 0 ] | ( pnC[ 1 ] << 8 )), dT2 = ( S16 )( pnC[ 2 ] | ( pnC[ 3 ] << 8 )), dT3 = ( S16 )( pnC[ 4 ] | ( pnC[ 5 ] << 8 ));
+  double    dP1 = ( U16 )( pnC[ 6 ] | ( pnC[ 7 ] << 8 )), dP2 = ( S16 )( pnC[ 8 ] | ( pnC[ 9 ] << 8 )), dP3 = ( S16 )( pnC[ 10 ] | ( pnC[ 11 ] << 8 ));
+  double    dP4 = ( S16 )( pnC[ 12 ] | ( pnC[ 13 ] << 8 )), dP5 = ( S16 )( pnC[ 14 ] | ( pnC[ 15 ] << 8 )), dP6 = ( S16 )( pnC[ 16 ] | ( pnC[ 17 ] << 8 ));
+  double    dP7 = ( S16 )( pnC[ 18 ] | ( pnC[ 19 ] << 8 )), dP8 = ( S16 )( pnC[ 20 ] | ( pnC[ 21 ] << 8 )), dP9 = ( S16 )( pnC[ 22 ] | ( pnC[ 23 ] << 8 ));
+  double    dH1 = pnC[ 25 ], dH2 = ( S16 )( pnH[ 0 ] | ( pnH[ 1 ] << 8 )), dH3 = pnH[ 2 ];
+  double    dH4 = ( S16 )((( S8 )pnH[ 3 ] * 16 ) | ( pnH[ 4 ] & 0x0F )), dH5 = ( S16 )((( S8 )pnH[ 5 ] * 16 ) | ( pnH[ 4 ] >> 4 )), dH6 = ( S8 )pnH[ 6 ];
+  double    dVar1, dVar2, dFine, dPress, dHumid;
+
+  // temperature
+  dVar1 = (( lRawTemp / 16384.0 ) - ( dT1 / 1024.0 )) * dT2;
+  dVar2 = (( lRawTemp / 131072.0 ) - ( dT1 / 8192.0 )) * (( lRawTemp / 131072.0 ) - ( dT1 / 8192.0 )) * dT3;
+  dFine = ( S32 )( dVar1 + dVar2 );
+  ptRef->dTemperature = ( dVar1 + dVar2 ) / 5120.0;
+
+  // pressure
+  dVar1 = ( dFine / 2.0 ) - 64000.0;
+  dVar2 = dVar1 * dVar1 * dP6 / 32768.0;
+  dVar2 = dVar2 + ( dVar1 * dP5 * 2.0 );
+  dVar2 = ( dVar2 / 4.0 ) + ( dP4 * 65536.0 );
+  dVar1 = (( dP3 * dVar1 * dVar1 / 524288.0 ) + ( dP2 * dVar1 )) / 524288.0;
+  dVar1 = ( 1.0 + ( dVar1 / 32768.0 )) * dP1;
+  dPress = 1048576.0 - lRawPress;
+  dPress = ( dPress - ( dVar2 / 4096.0 )) * 6250.0 / dVar1;
+  dVar1 = dP9 * dPress * dPress / 2147483648.0;
+  dVar2 = dPress * dP8 / 32768.0;
+  ptRef->dPressure = dPress + (( dVar1 + dVar2 + dP7 ) / 16.0 );
+
+  // humidity
+  dHumid = dFine - 76800.0;
+  dHumid = ( lRawHumid - (( dH4 * 64.0 ) + ( dH5 / 16384.0 * dHumid ))) *
+           ( dH2 / 65536.0 * ( 1.0 + ( dH6 / 67108864.0 * dHumid * ( 1.0 + ( dH3 / 67108864.0 * dHumid )))));
+  dHumid = dHumid * ( 1.0 - ( dH1 * dHumid / 524288.0 ));
+  ptRef->dHumidity = fmin( fmax( dHumid, 0.0 ), 100.0 );
+}
+
+/******************************************************************************
+ * @function BuildFrame
+ *
+ * @brief build a frame
+ *
+ * This function will build a measurement frame from the raw values
+ *
+ * @param[in]   pnFrame     pointer to the frame
+ * @param[in]   lRawTemp    raw temperature
+ * @param[in]   lRawPress   raw pressure
+ * @param[in]   lRawHumid   raw humidity
+ *
+ *****************************************************************************/
+static void BuildFrame( PU8 pnFrame, S32 lRawTemp, S32 lRawPress, S32 lRawHumid )
+{
+  // pack it
+  pnFrame[ 0 ] = ( U8 )( lRawPress >> 12 );
+  pnFrame[ 1 ] = ( U8 )( lRawPress >> 4 );
+  pnFrame[ 2 ] = ( U8 )( lRawPress << 4 );
+  pnFrame[ 3 ] = ( U8 )( lRawTemp >> 12 );
+  pnFrame[ 4 ] = ( U8 )( lRawTemp >> 4 );
+  pnFrame[ 5 ] = ( U8 )( lRawTemp << 4 );
+  pnFrame[ 6 ] = ( U8 )( lRawHumid >> 8 );
+  pnFrame[ 7 ] = ( U8 )lRawHumid;
+}
+
+/******************************************************************************
+ * @function ParseFrame
+ *
+ * @brief parse a frame
+ *
+ * This function will recover the raw values from a measurement frame
+ *
+ * @param[in]   pnFrame     pointer to the frame
+ * @param[io]   plTemp      pointer to the raw temperature
+ * @param[io]   plPress     pointer to the raw pressure
+ * @param[io]   plHumid     pointer to the raw humidity
+ *
+ *****************************************************************************/
+static void ParseFrame( PU8 pnFrame, PS32 plTemp, PS32 plPress, PS32 plHumid )
+{
+  // unpack it
+  *( plPress ) = ( pnFrame[ 0 ] << 12 ) | ( pnFrame[ 1 ] << 4 ) | ( pnFrame[ 2 ] >> 4 );
+  *( plTemp ) = ( pnFrame[ 3 ] << 12 ) | ( pnFrame[ 4 ] << 4 ) | ( pnFrame[ 5 ] >> 4 );
+  *( plHumid ) = ( pnFrame[ 6 ] << 8 ) | pnFrame[ 7 ];
+}
+
+/******************************************************************************
+ * @function RunExample
+ *
+ * @brief datasheet example
+ *
+ * This function will check the datasheet example, 25.08 C and 100653.27 Pa
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunExample( void )
+{
+  U8              anFrame[ SENBME280_FRAME_SIZE ];
+  SENBME280VALUE  tValue;
+  int             iErrors = 0;
+
+  // compensate it
+  BuildFrame( anFrame, 519888, 415148, 0 );
+  SenBME280_CompensateBurst( SenBME280_GetCompensation( ), anFrame, 1, &tValue );
+  printf( "example: %.2f C, %.2f Pa\n", tValue.lTemperature / 100.0, tValue.uPressure / 256.0 );
+  if (( tValue.lTemperature != 2508 ) || ( fabs(( tValue.uPressure / 256.0 ) - 100653.27 ) > LIMIT_PRESS ))
+  {
+    printf( "  error: example does not match the datasheet\n" );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunDriver
+ *
+ * @brief driver check
+ *
+ * This function will place frames in the register map and read them through
+ * the driver measurement functions
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunDriver( void )
+{
+  static const S32  alRaw[ ][ 3 ] =
+  {
+    { 519888, 415148, 30000 },
+    { 450000, 350000, 20000 },
+    { 580000, 500000, 38000 },
+  };
+  REFVALUE  tRef;
+  FLOAT     fTemp, fHumid, fPress;
+  int       iIdx, iErrors = 0;
+
+  // for each sample
+  for ( iIdx = 0; iIdx < ( int )( sizeof( alRaw ) / sizeof( alRaw[ 0 ] )); iIdx++ )
+  {
+    // place it and read it
+    BuildFrame( &anRegisters[ REG_MEAS_BASE ], alRaw[ iIdx ][ 0 ], alRaw[ iIdx ][ 1 ], alRaw[ iIdx ][ 2 ] );
+    SenBME280_GetMeasurement( SENBME280_MEASTYPE_TEMP, &fTemp );
+    SenBME280_GetMeasurement( SENBME280_MEASTYPE_HUMD, &fHumid );
+    SenBME280_GetMeasurement( SENBME280_MEASTYPE_PRES, &fPress );
+    Reference( alRaw[ iIdx ][ 0 ], alRaw[ iIdx ][ 1 ], alRaw[ iIdx ][ 2 ], &tRef );
+    printf( "driver: %7.2f C %9.3f hPa %6.2f %%RH, reference %7.2f C %9.3f hPa %6.2f %%RH\n",
+            fTemp, fPress, fHumid, tRef.dTemperature, tRef.dPressure / 100.0, tRef.dHumidity );
+    if (( fabs( fTemp - tRef.dTemperature ) > LIMIT_TEMP ) || ( fabs(( fPress * 100.0 ) - tRef.dPressure ) > LIMIT_PRESS ) ||
+        ( fabs( fHumid - tRef.dHumidity ) > LIMIT_HUMID ))
+    {
+      printf( "  error: driver does not match the reference\n" );
+      iErrors++;
+    }
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunBurst
+ *
+ * @brief burst check
+ *
+ * This function will compensate a sweep of frames in one burst and compare
+ * every sample in the sensor range against the reference
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunBurst( void )
+{
+  int     iTemp, iPress, iHumid, iFrame = 0, iUsed = 0, iErrors = 0;
+  S32     lRawTemp, lRawPress, lRawHumid;
+  double  dMaxTemp = 0, dMaxPress = 0, dMaxHumid = 0;
+
+  // build the sweep
+  for ( iTemp = 0; iTemp < SWEEP_STEPS; iTemp++ )
+  {
+    for ( iPress = 0; iPress < SWEEP_STEPS; iPress++ )
+    {
+      for ( iHumid = 0; iHumid < SWEEP_STEPS; iHumid++ )
+      {
+        BuildFrame( &anFrames[ iFrame * SENBME280_FRAME_SIZE ], 380000 + ( iTemp * 10000 ) + iPress, 250000 + ( iPress * 15000 ) + iHumid,
+                    15000 + ( iHumid * 1200 ) + iTemp );
+        iFrame++;
+      }
+    }
+  }
+
+  // compensate it in one call
+  SenBME280_CompensateBurst( SenBME280_GetCompensation( ), anFrames, NUM_FRAMES, atValues );
+
+  // compare each sample in the sensor range
+  for ( iFrame = 0; iFrame < NUM_FRAMES; iFrame++ )
+  {
+    ParseFrame( &anFrames[ iFrame * SENBME280_FRAME_SIZE ], &lRawTemp, &lRawPress, &lRawHumid );
+    Reference( lRawTemp, lRawPress, lRawHumid, &atRefs[ iFrame ] );
+    if (( atRefs[ iFrame ].dTemperature >= -40.0 ) && ( atRefs[ iFrame ].dTemperature <= 85.0 ) &&
+        ( atRefs[ iFrame ].dPressure >= 30000.0 ) && ( atRefs[ iFrame ].dPressure <= 110000.0 ))
+    {
+      iUsed++;
+      dMaxTemp = fmax( dMaxTemp, fabs(( atValues[ iFrame ].lTemperature / 100.0 ) - atRefs[ iFrame ].dTemperature ));
+      dMaxPress = fmax( dMaxPress, fabs(( atValues[ iFrame ].uPressure / 256.0 ) - atRefs[ iFrame ].dPressure ));
+      dMaxHumid = fmax( dMaxHumid, fabs(( atValues[ iFrame ].uHumidity / 1024.0 ) - atRefs[ iFrame ].dHumidity ));
+    }
+  }
+
+  // report
+  printf( "burst: %d frames, %d in range, max error %.4f C %.3f Pa %.4f %%RH\n", NUM_FRAMES, iUsed, dMaxTemp, dMaxPress, dMaxHumid );
+  if (( dMaxTemp > LIMIT_TEMP ) || ( dMaxPress > LIMIT_PRESS ) || ( dMaxHumid > LIMIT_HUMID ))
+  {
+    printf( "  error: exceeds %.2f C %.2f Pa %.2f %%RH\n", LIMIT_TEMP, LIMIT_PRESS, LIMIT_HUMID );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief timing
+ *
+ * This function will time the burst compensation and the reference per
+ * sample
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  int     iPass, iFrame;
+  S32     lRawTemp, lRawPress, lRawHumid;
+  double  dStart, dBurst, dRef;
+
+  // time the burst
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    SenBME280_CompensateBurst( SenBME280_GetCompensation( ), anFrames, NUM_FRAMES, atValues );
+  }
+  dBurst = GetTime( ) - dStart;
+
+  // time the reference
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    for ( iFrame = 0; iFrame < NUM_FRAMES; iFrame++ )
+    {
+      ParseFrame( &anFrames[ iFrame * SENBME280_FRAME_SIZE ], &lRawTemp, &lRawPress, &lRawHumid );
+      Reference( lRawTemp, lRawPress, lRawHumid, &atRefs[ iFrame ] );
+    }
+  }
+  dRef = GetTime( ) - dStart;
+
+  // report
+  printf( "timing: integer burst %.1f ns, double %.1f ns per sample\n", dBurst * 1e9 / ( TIMING_PASSES * NUM_FRAMES ),
+          dRef * 1e9 / ( TIMING_PASSES * NUM_FRAMES ));
+}
+
+/******************************************************************************
+ * @function GetTime
+ *
+ * @brief get the time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time
+ *
+ *****************************************************************************/
+static double GetTime( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/**@} EOF SenBME280CompTest.c */
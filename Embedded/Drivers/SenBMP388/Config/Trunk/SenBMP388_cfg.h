@@ -43,6 +43,9 @@
 #define SENBMP388_DATAREADY_EVENT                     ( 0xDEED )
 #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
 
+/// define the macro to enable the integer compensation
+#define SENBMP388_ENABLE_INTEGER_COMP                 ( ON )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
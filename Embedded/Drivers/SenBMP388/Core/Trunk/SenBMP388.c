@@ -24,6 +24,7 @@
 
 // system includes ------------------------------------------------------------
 #include <math.h>
+#include <string.h>
 
 // local includes -------------------------------------------------------------
 #include "SenBMP388/SenBMP388.h"
@@ -280,15 +281,24 @@ static  BOOL            bValidData;
 static  FLOAT           fCurPressure;
 static  FLOAT           fCurTemperature;
 static  FLOAT           fCurAltitude;
-static  TRIMCOEEFFLOAT  tTrimCoeef;
 static  SENBMP388ERR    eLclError;
+static  SENBMP388COMP   tComp;
+#if ( SENBMP388_ENABLE_INTEGER_COMP == ON )
+static  SENBMP388VALUE  tCurValue;
+#else
+static  TRIMCOEEFFLOAT  tTrimCoeef;
+#endif // SENBMP388_ENABLE_INTEGER_COMP
 
 // local function prototypes --------------------------------------------------
 static  BOOL  WriteCommandRegister( U8 nCommand, U8 nDelayMsecs );
 static  BOOL  CheckCommandReady( void );
 static  BOOL  ReadComputeCoeeficients( void );
+#if ( SENBMP388_ENABLE_INTEGER_COMP == OFF )
 static  FLOAT CompensateTemperature( U32 uTempRaw );
 static  FLOAT CompensatePressure( U32 uPressRaw );
+#endif // SENBMP388_ENABLE_INTEGER_COMP
+static  S32   ComputeTemperature( PSENBMP388COMP ptComp, U32 uRawTemp, PS64 phLin );
+static  U32   ComputePressure( PSENBMP388COMP ptComp, U32 uRawPress, S64 hLin );
 static  BOOL  ReadRegisters( REGADR eRegAddr, PU8 pnData, U8 nNumRegs );
 static  BOOL  WriteRegister( REGADR eRegAddr, U8 nData );
 
@@ -428,7 +438,9 @@ void SenBMP388_Initialize( void )
 void SenBMP388_ProcessDataReady( void )
 {
   RAWDATA   tRawData;
+  #if ( SENBMP388_ENABLE_INTEGER_COMP == OFF )
   U32UN     tTemp;
+  #endif // SENBMP388_ENABLE_INTEGER_COMP
   REGSALL   tRegs;
   FLOAT     fK1, fK2, fK3;
   
@@ -441,7 +453,14 @@ void SenBMP388_ProcessDataReady( void )
       // read the data
       if ( ReadRegisters( REGADR_DATA0_PRS0007, ( PU8 )&tRawData, RAWDATA_SIZE ) == TRUE )
       {
+      #if ( SENBMP388_ENABLE_INTEGER_COMP == ON )
+        // compensate in integer, keep the float copies for the getters
+        SenBMP388_CompensateBurst( &tComp, ( PU8 )&tRawData, 1, &tCurValue );
+        fCurTemperature = ( FLOAT )tCurValue.lTemperature / 100.0f;
+        fCurPressure = ( FLOAT )tCurValue.uPressure / 100.0f;
+      #else
         // compensate temperature
+        tTemp.uValue = 0;
         tTemp.anValue[ LE_U32_LSB_IDX ] = tRawData.nTemperature0007;
         tTemp.anValue[ LE_U32_MS1_IDX ] = tRawData.nTemperature0815;
         tTemp.anValue[ LE_U32_MS2_IDX ] = tRawData.nTemperature1623;
@@ -452,6 +471,7 @@ void SenBMP388_ProcessDataReady( void )
         tTemp.anValue[ LE_U32_MS1_IDX ] = tRawData.nPressure0815;
         tTemp.anValue[ LE_U32_MS2_IDX ] = tRawData.nPressure1623;
         fCurPressure = CompensatePressure( tTemp.uValue );
+      #endif // SENBMP388_ENABLE_INTEGER_COMP
     
         // calculate the altitude
         fK1 = PRESTOALT_K1;
@@ -610,6 +630,131 @@ FLOAT SenBMP388_GetFieldValue( SENBMP388FIELD eField )
   return( fValue );
 }
 
+/******************************************************************************
+ * @function SenBMP388_GetValue
+ *
+ * @brief get the current integer values
+ *
+ * This function will return the current temperature and pressure as
+ * integers, without the float conversions
+ *
+ * @param[io]   ptValue   pointer to store the values
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+SENBMP388ERR SenBMP388_GetValue( PSENBMP388VALUE ptValue )
+{
+  SENBMP388ERR eError = eLclError;
+
+  // check for local error
+  if ( eLclError == SENBMP388_ERR_NONE )
+  {
+    #if ( SENBMP388_ENABLE_INTEGER_COMP == ON )
+    // return the last values
+    *( ptValue ) = tCurValue;
+    #else
+    // convert the last values
+    ptValue->lTemperature = ( S32 )( fCurTemperature * 100.0f );
+    ptValue->uPressure = ( U32 )( fCurPressure * 100.0f );
+    #endif // SENBMP388_ENABLE_INTEGER_COMP
+  }
+  else
+  {
+    // set the default
+    memset( ptValue, 0, SENBMP388VALUE_SIZE );
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function SenBMP388_PrepareCompensation
+ *
+ * @brief prepare the compensation
+ *
+ * This function will unpack the trimming coefficient registers and pre-scale
+ * them into the compensation structure
+ *
+ * @param[in]   pnNvmRegs     trimming coefficient registers
+ * @param[io]   ptComp        pointer to the compensation structure
+ *
+ *****************************************************************************/
+void SenBMP388_PrepareCompensation( PU8 pnNvmRegs, PSENBMP388COMP ptComp )
+{
+  // temperature, little endian
+  ptComp->lT1 = ( S32 )( pnNvmRegs[ 0 ] | ( pnNvmRegs[ 1 ] << 8 )) << 8;
+  ptComp->hT2 = ( S64 )( pnNvmRegs[ 2 ] | ( pnNvmRegs[ 3 ] << 8 )) << 18;
+  ptComp->lT3 = ( S8 )pnNvmRegs[ 4 ];
+
+  // pressure
+  ptComp->hP1 = ( S64 )(( S16 )( pnNvmRegs[ 5 ] | ( pnNvmRegs[ 6 ] << 8 )) - 16384 ) * 70368744177664LL;
+  ptComp->lP2 = ( S16 )( pnNvmRegs[ 7 ] | ( pnNvmRegs[ 8 ] << 8 )) - 16384;
+  ptComp->lP3 = ( S8 )pnNvmRegs[ 9 ];
+  ptComp->lP4 = ( S8 )pnNvmRegs[ 10 ];
+  ptComp->hP5 = ( S64 )( pnNvmRegs[ 11 ] | ( pnNvmRegs[ 12 ] << 8 )) << 47;
+  ptComp->lP6 = ( U16 )( pnNvmRegs[ 13 ] | ( pnNvmRegs[ 14 ] << 8 ));
+  ptComp->lP7 = ( S8 )pnNvmRegs[ 15 ];
+  ptComp->lP8 = ( S8 )pnNvmRegs[ 16 ];
+  ptComp->lP9 = ( S32 )(( S16 )( pnNvmRegs[ 17 ] | ( pnNvmRegs[ 18 ] << 8 ))) * 65536;
+  ptComp->lP10 = ( S8 )pnNvmRegs[ 19 ];
+  ptComp->lP11 = ( S8 )pnNvmRegs[ 20 ];
+}
+
+/******************************************************************************
+ * @function SenBMP388_GetCompensation
+ *
+ * @brief get the compensation
+ *
+ * This function will return the compensation prepared from the sensor at
+ * initialization
+ *
+ * @return      pointer to the compensation structure
+ *
+ *****************************************************************************/
+PSENBMP388COMP SenBMP388_GetCompensation( void )
+{
+  // return the pointer
+  return( &tComp );
+}
+
+/******************************************************************************
+ * @function SenBMP388_CompensateBurst
+ *
+ * @brief compensate a burst of frames
+ *
+ * This function will compensate a burst of raw measurement frames in integer
+ * arithmetic
+ *
+ * @param[in]   ptComp        pointer to the compensation structure
+ * @param[in]   pnFrames      pointer to the frames
+ * @param[in]   wNumFrames    number of frames
+ * @param[io]   ptValues      pointer to the values
+ *
+ *****************************************************************************/
+void SenBMP388_CompensateBurst( PSENBMP388COMP ptComp, PU8 pnFrames, U16 wNumFrames, PSENBMP388VALUE ptValues )
+{
+  U32 uRawPress, uRawTemp;
+  S64 hLin;
+
+  // for each frame
+  while ( wNumFrames-- != 0 )
+  {
+    // assemble the raw values
+    uRawPress = pnFrames[ 0 ] | (( U32 )pnFrames[ 1 ] << 8 ) | (( U32 )pnFrames[ 2 ] << 16 );
+    uRawTemp = pnFrames[ 3 ] | (( U32 )pnFrames[ 4 ] << 8 ) | (( U32 )pnFrames[ 5 ] << 16 );
+
+    // compensate, temperature first for the linearized temperature
+    ptValues->lTemperature = ComputeTemperature( ptComp, uRawTemp, &hLin );
+    ptValues->uPressure = ComputePressure( ptComp, uRawPress, hLin );
+
+    // next frame
+    pnFrames += SENBMP388_FRAME_SIZE;
+    ptValues++;
+  }
+}
+
 /******************************************************************************
  * @function WriteCommandRegister
  *
@@ -696,11 +841,17 @@ static BOOL ReadComputeCoeeficients( void )
 {
   TRIMCOEEFRAW  tCoeefRaw;
   BOOL          bStatus;
+  #if ( SENBMP388_ENABLE_INTEGER_COMP == OFF )
   DOUBLE        dblTemp;
+  #endif // SENBMP388_ENABLE_INTEGER_COMP
   
   // read the coeeficients
   if (( bStatus = ReadRegisters( REGADR_NVMPAR_T10007, ( PU8)&tCoeefRaw, TRIMCOEEFRAW_SIZE )) == TRUE )
   {
+    // prepare the integer compensation
+    SenBMP388_PrepareCompensation(( PU8 )&tCoeefRaw, &tComp );
+
+    #if ( SENBMP388_ENABLE_INTEGER_COMP == OFF )
     // now adjust the values
     dblTemp = TRIM_COEEF_T1_K;
     tTrimCoeef.dParT1 = (( DOUBLE )tCoeefRaw.wNvmParT1 / dblTemp );
@@ -730,12 +881,14 @@ static BOOL ReadComputeCoeeficients( void )
     tTrimCoeef.dParP10 = (( DOUBLE )tCoeefRaw.cNvmParP10 / dblTemp );
     dblTemp = TRIM_COEEF_P11_K;
     tTrimCoeef.dParP11 = (( DOUBLE )tCoeefRaw.cNvmParP11 / dblTemp );
+    #endif // SENBMP388_ENABLE_INTEGER_COMP
   }
 
   // return status
   return( bStatus );
 }
 
+#if ( SENBMP388_ENABLE_INTEGER_COMP == OFF )
 /******************************************************************************
  * @function CompensateTemperature
  *
@@ -798,12 +951,78 @@ static FLOAT CompensatePressure( U32 uPressRaw )
   dData6 = uPressRaw * ( tTrimCoeef.dParP1 + dData1 + dData2 + dData3 );
   dData2 = tTrimCoeef.dParP9 + tTrimCoeef.dParP10 * ( DOUBLE )fCurTemperature;
   dData3 = dPressSquared * dData2;
-  dData4 = ( dData3 + dPressCubed ) * tTrimCoeef.dParP11;
+  dData4 = dData3 + ( dPressCubed * tTrimCoeef.dParP11 );
   dCompPress = dData5 + dData6 + dData4;
   
   // return the compensated pressure
   return(( FLOAT )dCompPress );
 }
+#endif // SENBMP388_ENABLE_INTEGER_COMP
+
+/******************************************************************************
+ * @function ComputeTemperature
+ *
+ * @brief compute the temperature
+ *
+ * This function will compute the temperature in 64 bit integer arithmetic
+ * and return the linearized temperature, Q16 degrees C, for the pressure
+ *
+ * @param[in]   ptComp      pointer to the compensation structure
+ * @param[in]   uRawTemp    raw temperature
+ * @param[io]   phLin       pointer to the linearized temperature
+ *
+ * @return      temperature in hundredths of a degree C
+ *
+ *****************************************************************************/
+static S32 ComputeTemperature( PSENBMP388COMP ptComp, U32 uRawTemp, PS64 phLin )
+{
+  S64 hData1;
+
+  // apply the compensation
+  hData1 = ( S64 )uRawTemp - ptComp->lT1;
+  *( phLin ) = (( hData1 * ptComp->hT2 ) + ( hData1 * hData1 * ptComp->lT3 )) >> 32;
+
+  // return the temperature, rounded
+  return(( S32 )((( *( phLin ) * 25 ) + 8192 ) >> 14 ));
+}
+
+/******************************************************************************
+ * @function ComputePressure
+ *
+ * @brief compute the pressure
+ *
+ * This function will compute the pressure in 64 bit integer arithmetic, the
+ * power of two divisions done as shifts
+ *
+ * @param[in]   ptComp      pointer to the compensation structure
+ * @param[in]   uRawPress   raw pressure
+ * @param[in]   hLin        linearized temperature
+ *
+ * @return      pressure in hundredths of a Pa
+ *
+ *****************************************************************************/
+static U32 ComputePressure( PSENBMP388COMP ptComp, U32 uRawPress, S64 hLin )
+{
+  S64 hData1, hData2, hData3, hData4, hOffset, hSensitivity;
+  S64 hRaw = uRawPress;
+
+  // compute the offset and the sensitivity from the temperature
+  hData1 = hLin * hLin;
+  hData3 = (( hData1 >> 6 ) * hLin ) >> 8;
+  hOffset = ptComp->hP5 + (( ptComp->lP8 * hData3 ) >> 5 ) + (( ptComp->lP7 * hData1 ) << 4 ) + (( ptComp->lP6 * hLin ) << 22 );
+  hSensitivity = ptComp->hP1 + (( ptComp->lP4 * hData3 ) >> 5 ) + (( ptComp->lP3 * hData1 ) << 2 ) + (( ptComp->lP2 * hLin ) << 21 );
+
+  // apply them and the second and third order terms
+  hData1 = ( hSensitivity >> 24 ) * hRaw;
+  hData2 = ((( ptComp->lP10 * hLin ) + ptComp->lP9 ) * hRaw ) >> 13;
+  hData2 = ( hRaw * ( hData2 >> 3 )) >> 6;
+  hData3 = ((( ptComp->lP11 * ( hRaw * hRaw )) >> 16 ) * hRaw ) >> 7;
+  hData4 = ( hOffset >> 2 ) + hData1 + hData2 + hData3;
+  hData4 = MAX( hData4, 0 );
+
+  // return the pressure
+  return(( U32 )((( U64 )hData4 * 25 ) >> 40 ));
+}
 
 
 /******************************************************************************
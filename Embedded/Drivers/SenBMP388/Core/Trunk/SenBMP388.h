@@ -33,6 +33,11 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the size of the trimming coefficient registers
+#define SENBMP388_NVM_SIZE                      ( 21 )
+
+/// define the size of a measurement frame, the data registers from pressure to temperature
+#define SENBMP388_FRAME_SIZE                    ( 6 )
 
 // enumerations ---------------------------------------------------------------
 /// enumerate the errors
@@ -54,6 +59,33 @@ typedef enum _SENBMP388FIELD
 } SENBMP388FIELD;
 
 // structures -----------------------------------------------------------------
+/// define the compensation structure, the coefficients pre-scaled once at init
+typedef struct _SENBMP388COMP
+{
+  S64   hT2;                    ///< T2 shifted left 18
+  S64   hP1;                    ///< P1 less 16384 shifted left 46
+  S64   hP5;                    ///< P5 shifted left 47
+  S32   lT1;                    ///< T1 shifted left 8
+  S32   lT3;                    ///< T3
+  S32   lP2;                    ///< P2 less 16384
+  S32   lP3;                    ///< P3
+  S32   lP4;                    ///< P4
+  S32   lP6;                    ///< P6
+  S32   lP7;                    ///< P7
+  S32   lP8;                    ///< P8
+  S32   lP9;                    ///< P9 shifted left 16
+  S32   lP10;                   ///< P10
+  S32   lP11;                   ///< P11
+} SENBMP388COMP, *PSENBMP388COMP;
+#define SENBMP388COMP_SIZE                      sizeof( SENBMP388COMP )
+
+/// define the compensated value structure
+typedef struct _SENBMP388VALUE
+{
+  S32   lTemperature;           ///< temperature in hundredths of a degree C
+  U32   uPressure;              ///< pressure in hundredths of a Pa
+} SENBMP388VALUE, *PSENBMP388VALUE;
+#define SENBMP388VALUE_SIZE                     sizeof( SENBMP388VALUE )
 
 // global parameter declarations -----------------------------------------------
 
@@ -64,6 +96,10 @@ extern  SENBMP388ERR  SenBMP388_GetPressure( PFLOAT pfValue );
 extern  SENBMP388ERR  SenBMP388_GetAltitude( PFLOAT pfValue );
 extern  SENBMP388ERR  SenBMP388_GetTemperature( PFLOAT pfValue );
 extern  FLOAT         SenBMP388_GetFieldValue( SENBMP388FIELD eField );
+extern  SENBMP388ERR  SenBMP388_GetValue( PSENBMP388VALUE ptValue );
+extern  void          SenBMP388_PrepareCompensation( PU8 pnNvmRegs, PSENBMP388COMP ptComp );
+extern  PSENBMP388COMP SenBMP388_GetCompensation( void );
+extern  void          SenBMP388_CompensateBurst( PSENBMP388COMP ptComp, PU8 pnFrames, U16 wNumFrames, PSENBMP388VALUE ptValues );
 
 /**@} EOF SenBMP388.h */
 
@@ -0,0 +1,461 @@
+/******************************************************************************
+ * @file SenBMP388CompTest.c
+ *
+ * @brief Bosch Sensortec BMP388 compensation test
+ *
+ * This file provides a host tool that runs the BMP388 driver, built with the
+ * float compensation, against a simulated register map loaded with a
+ * trimming coefficient register dump.  It reads samples through the driver
+ * float path and compensates a sweep of raw measurement frames with the
+ * integer burst compensation, comparing both against the datasheet double
+ * precision formulas.  It then times the burst and the double formulas per
+ * sample.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o SenBMP388CompTest
+ *             SenBMP388CompTest.c ../../Core/Trunk/SenBMP388.c -lm
+ * usage:      SenBMP388CompTest
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup SenBMP388
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "SenBMP388/SenBMP388.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the register addresses
+#define REG_CHIPID                                  ( 0x00 )
+#define REG_STATUS                                  ( 0x03 )
+#define REG_DATA                                    ( 0x04 )
+#define REG_INT_STATUS                              ( 0x11 )
+#define REG_NVM                                     ( 0x31 )
+
+/// define the status values, command ready and data ready
+#define STATUS_CMDRDY                               ( 0x10 )
+#define INT_STATUS_DRDY                             ( 0x08 )
+
+/// define the sweep size per axis
+#define SWEEP_STEPS                                 ( 96 )
+#define NUM_FRAMES                                  ( SWEEP_STEPS * SWEEP_STEPS )
+
+/// define the number of timing passes
+#define TIMING_PASSES                               ( 50 )
+
+/// define the agreement limits
+#define LIMIT_TEMP                                  ( 0.01 )
+#define LIMIT_PRESS                                 ( 1.0 )
+
+// structures -----------------------------------------------------------------
+/// define the reference structure
+typedef struct _REFVALUE
+{
+  double  dTemperature;     ///< temperature in C
+  double  dPressure;        ///< pressure in Pa
+} REFVALUE, *PREFVALUE;
+
+// global parameter declarations ----------------------------------------------
+const CODE SENBMP388CONFIG  g_tSenBMP388Config =
+{
+  SENBMP388CONFIGM( SENBMP388_MODE_NONBLKNORMAL, SENBMP388_OVER_SAMPRATE_32, SENBMP388_OVER_SAMPRATE_32, SENBMP388_OUTPUT_DATRATE_40MSEC, SENBMP388_FILTCOEEF_127, SENBMP388_IRQDEF_ODLO )
+};
+
+// local parameter declarations -----------------------------------------------
+/// define the trimming coefficient dump, 0x31 through 0x45
+static  const U8  anNvmDump[ SENBMP388_NVM_SIZE ] =
+{
+  0x5C, 0x6C,               // T1   27740
+  0x75, 0x4B,               // T2   19317
+  0xF9,                     // T3   -7
+  0x48, 0xF4,               // P1   -3000
+  0x30, 0xF8,               // P2   -2000
+  0x24,                     // P3   36
+  0x00,                     // P4   0
+  0xA8, 0x61,               // P5   25000
+  0x30, 0x75,               // P6   30000
+  0x03,                     // P7   3
+  0xFB,                     // P8   -5
+  0x80, 0x3E,               // P9   16000
+  0x0A,                     // P10  10
+  0xC4,                     // P11  -60
+};
+
+static  U8              anRegisters[ 256 ];
+static  U8              anFrames[ NUM_FRAMES * SENBMP388_FRAME_SIZE ];
+static  SENBMP388VALUE  atValues[ NUM_FRAMES ];
+static  REFVALUE        atRefs[ NUM_FRAMES ];
+
+// local function prototypes --------------------------------------------------
+static  void    Reference( U32 uRawTemp, U32 uRawPress, PREFVALUE ptRef );
+static  void    BuildFrame( PU8 pnFrame, U32 uRawTemp, U32 uRawPress );
+static  void    ParseFrame( PU8 pnFrame, PU32 puTemp, PU32 puPress );
+static  int     RunDriver( void );
+static  int     RunBurst( void );
+static  void    RunTiming( void );
+static  double  GetTime( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will initialize the driver and run the checks
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+  FLOAT fValue;
+
+  // load the register map and initialize
+  anRegisters[ REG_CHIPID ] = 0x50;
+  anRegisters[ REG_STATUS ] = STATUS_CMDRDY;
+  anRegisters[ REG_INT_STATUS ] = INT_STATUS_DRDY;
+  memcpy( &anRegisters[ REG_NVM ], anNvmDump, SENBMP388_NVM_SIZE );
+  SenBMP388_Initialize( );
+  if ( SenBMP388_GetTemperature( &fValue ) != SENBMP388_ERR_NONE )
+  {
+    printf( "initialize failed\n" );
+    return( 1 );
+  }
+
+  // run the checks
+  iErrors += RunDriver( );
+  iErrors += RunBurst( );
+  RunTiming( );
+
+  // report
+  printf( "%s, %d errors\n", ( iErrors == 0 ) ? "PASS" : "FAIL", iErrors );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function SenBMP388_Read
+ *
+ * @brief read registers
+ *
+ * This function will read the simulated register map
+ *
+ * @param[in]   nBaseReg    first register
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   nLength     number of registers
+ *
+ * @return      TRUE
+ *
+ *****************************************************************************/
+BOOL SenBMP388_Read( U8 nBaseReg, PU8 pnData, U8 nLength )
+{
+  // copy them
+  memcpy( pnData, &anRegisters[ nBaseReg ], nLength );
+  return( TRUE );
+}
+
+/******************************************************************************
+ * @function SenBMP388_Write
+ *
+ * @brief write a register
+ *
+ * This function will write the simulated register map, leaving the status
+ * registers alone
+ *
+ * @param[in]   nBaseReg    register
+ * @param[in]   pnData      pointer to the data
+ *
+ * @return      TRUE
+ *
+ *****************************************************************************/
+BOOL SenBMP388_Write( U8 nBaseReg, PU8 pnData )
+{
+  // store it
+  if (( nBaseReg != REG_STATUS ) && ( nBaseReg != REG_INT_STATUS ))
+  {
+    anRegisters[ nBaseReg ] = *( pnData );
+  }
+  return( TRUE );
+}
+
+/******************************************************************************
+ * @function SenBMP388_DelayMsec
+ *
+ * @brief delay
+ *
+ * This function will ignore the delay
+ *
+ * @param[in]   wDelay      delay in milliseconds
+ *
+ *****************************************************************************/
+void SenBMP388_DelayMsec( U16 wDelay )
+{
+  ( void )wDelay;
+}
+
+/******************************************************************************
+ * @function Reference
+ *
+ * @brief reference compensation
+ *
+ * This function will compensate with the datasheet double precision formulas
+ * from the trimming coefficient dump
+ *
+ * @param[in]   uRawTemp    raw temperature
+ * @param[in]   uRawPress   raw pressure
+ * @param[io]   ptRef       pointer to the reference values
+ *
+ *****************************************************************************/
+static void Reference( U32 uRawTemp, U32 uRawPress, PREFVALUE ptRef )
+{
+  const U8* pnN = anNvmDump;
+  double    dT1 = ( U16 )( pnN[ 0 ] | ( pnN[ 1 ] << 8 )) / 0.00390625;
+  double    dT2 = ( U16 )( pnN[ 2 ] | ( pnN[ 3 ] << 8 )) / 1073741824.0;
+  double    dT3 = ( S8 )pnN[ 4 ] / 281474976710656.0;
+  double    dP1 = (( S16 )( pnN[ 5 ] | ( pnN[ 6 ] << 8 )) - 16384 ) / 1048576.0;
+  double    dP2 = (( S16 )( pnN[ 7 ] | ( pnN[ 8 ] << 8 )) - 16384 ) / 536870912.0;
+  double    dP3 = ( S8 )pnN[ 9 ] / 4294967296.0;
+  double    dP4 = ( S8 )pnN[ 10 ] / 137438953472.0;
+  double    dP5 = ( U16 )( pnN[ 11 ] | ( pnN[ 12 ] << 8 )) / 0.125;
+  double    dP6 = ( U16 )( pnN[ 13 ] | ( pnN[ 14 ] << 8 )) / 64.0;
+  double    dP7 = ( S8 )pnN[ 15 ] / 256.0;
+  double    dP8 = ( S8 )pnN[ 16 ] / 32768.0;
+  double    dP9 = ( S16 )( pnN[ 17 ] | ( pnN[ 18 ] << 8 )) / 281474976710656.0;
+  double    dP10 = ( S8 )pnN[ 19 ] / 281474976710656.0;
+  double    dP11 = ( S8 )pnN[ 20 ] / 36893488147419103232.0;
+  double    dTemp, dData1, dPress = uRawPress;
+
+  // temperature
+  dData1 = uRawTemp - dT1;
+  dTemp = ( dData1 * dT2 ) + ( dData1 * dData1 * dT3 );
+  ptRef->dTemperature = dTemp;
+
+  // pressure
+  ptRef->dPressure = ( dP5 + ( dP6 * dTemp ) + ( dP7 * dTemp * dTemp ) + ( dP8 * dTemp * dTemp * dTemp )) +
+                     ( dPress * ( dP1 + ( dP2 * dTemp ) + ( dP3 * dTemp * dTemp ) + ( dP4 * dTemp * dTemp * dTemp ))) +
+                     ( dPress * dPress * ( dP9 + ( dP10 * dTemp ))) + ( dPress * dPress * dPress * dP11 );
+}
+
+/******************************************************************************
+ * @function BuildFrame
+ *
+ * @brief build a frame
+ *
+ * This function will build a measurement frame from the raw values
+ *
+ * @param[in]   pnFrame     pointer to the frame
+ * @param[in]   uRawTemp    raw temperature
+ * @param[in]   uRawPress   raw pressure
+ *
+ *****************************************************************************/
+static void BuildFrame( PU8 pnFrame, U32 uRawTemp, U32 uRawPress )
+{
+  // pack it, least significant first
+  pnFrame[ 0 ] = ( U8 )uRawPress;
+  pnFrame[ 1 ] = ( U8 )( uRawPress >> 8 );
+  pnFrame[ 2 ] = ( U8 )( uRawPress >> 16 );
+  pnFrame[ 3 ] = ( U8 )uRawTemp;
+  pnFrame[ 4 ] = ( U8 )( uRawTemp >> 8 );
+  pnFrame[ 5 ] = ( U8 )( uRawTemp >> 16 );
+}
+
+/******************************************************************************
+ * @function ParseFrame
+ *
+ * @brief parse a frame
+ *
+ * This function will recover the raw values from a measurement frame
+ *
+ * @param[in]   pnFrame     pointer to the frame
+ * @param[io]   puTemp      pointer to the raw temperature
+ * @param[io]   puPress     pointer to the raw pressure
+ *
+ *****************************************************************************/
+static void ParseFrame( PU8 pnFrame, PU32 puTemp, PU32 puPress )
+{
+  // unpack it
+  *( puPress ) = pnFrame[ 0 ] | ( pnFrame[ 1 ] << 8 ) | ( pnFrame[ 2 ] << 16 );
+  *( puTemp ) = pnFrame[ 3 ] | ( pnFrame[ 4 ] << 8 ) | ( pnFrame[ 5 ] << 16 );
+}
+
+/******************************************************************************
+ * @function RunDriver
+ *
+ * @brief driver check
+ *
+ * This function will place frames in the register map, process the data
+ * ready through the driver float path and compare it to the reference and
+ * the integer burst
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunDriver( void )
+{
+  static const U32  auRaw[ ][ 2 ] =
+  {
+    { 8400000, 6500000 },
+    { 5500000, 4000000 },
+    { 11000000, 8500000 },
+  };
+  REFVALUE        tRef;
+  SENBMP388VALUE  tValue;
+  FLOAT           fTemp, fPress;
+  int             iIdx, iErrors = 0;
+
+  // for each sample
+  for ( iIdx = 0; iIdx < ( int )( sizeof( auRaw ) / sizeof( auRaw[ 0 ] )); iIdx++ )
+  {
+    // place it and process it
+    BuildFrame( &anRegisters[ REG_DATA ], auRaw[ iIdx ][ 0 ], auRaw[ iIdx ][ 1 ] );
+    SenBMP388_ProcessDataReady( );
+    SenBMP388_GetTemperature( &fTemp );
+    SenBMP388_GetPressure( &fPress );
+    SenBMP388_CompensateBurst( SenBMP388_GetCompensation( ), &anRegisters[ REG_DATA ], 1, &tValue );
+    Reference( auRaw[ iIdx ][ 0 ], auRaw[ iIdx ][ 1 ], &tRef );
+    printf( "driver: float %7.2f C %10.2f Pa, integer %7.2f C %10.2f Pa, reference %7.2f C %10.2f Pa\n",
+            fTemp, fPress, tValue.lTemperature / 100.0, tValue.uPressure / 100.0, tRef.dTemperature, tRef.dPressure );
+    if (( fabs( fTemp - tRef.dTemperature ) > LIMIT_TEMP ) || ( fabs( fPress - tRef.dPressure ) > LIMIT_PRESS ) ||
+        ( fabs(( tValue.lTemperature / 100.0 ) - fTemp ) > LIMIT_TEMP ) || ( fabs(( tValue.uPressure / 100.0 ) - fPress ) > LIMIT_PRESS ))
+    {
+      printf( "  error: driver paths do not match\n" );
+      iErrors++;
+    }
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunBurst
+ *
+ * @brief burst check
+ *
+ * This function will compensate a sweep of frames in one burst and compare
+ * every sample in the sensor range against the reference
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunBurst( void )
+{
+  int     iTemp, iPress, iFrame = 0, iUsed = 0, iErrors = 0;
+  U32     uRawTemp, uRawPress;
+  double  dMaxTemp = 0, dMaxPress = 0;
+
+  // build the sweep
+  for ( iTemp = 0; iTemp < SWEEP_STEPS; iTemp++ )
+  {
+    for ( iPress = 0; iPress < SWEEP_STEPS; iPress++ )
+    {
+      BuildFrame( &anFrames[ iFrame * SENBMP388_FRAME_SIZE ], 5000000 + ( iTemp * 70000 ) + iPress, 3000000 + ( iPress * 63000 ) + iTemp );
+      iFrame++;
+    }
+  }
+
+  // compensate it in one call
+  SenBMP388_CompensateBurst( SenBMP388_GetCompensation( ), anFrames, NUM_FRAMES, atValues );
+
+  // compare each sample in the sensor range
+  for ( iFrame = 0; iFrame < NUM_FRAMES; iFrame++ )
+  {
+    ParseFrame( &anFrames[ iFrame * SENBMP388_FRAME_SIZE ], &uRawTemp, &uRawPress );
+    Reference( uRawTemp, uRawPress, &atRefs[ iFrame ] );
+    if (( atRefs[ iFrame ].dTemperature >= -40.0 ) && ( atRefs[ iFrame ].dTemperature <= 85.0 ) &&
+        ( atRefs[ iFrame ].dPressure >= 30000.0 ) && ( atRefs[ iFrame ].dPressure <= 125000.0 ))
+    {
+      iUsed++;
+      dMaxTemp = fmax( dMaxTemp, fabs(( atValues[ iFrame ].lTemperature / 100.0 ) - atRefs[ iFrame ].dTemperature ));
+      dMaxPress = fmax( dMaxPress, fabs(( atValues[ iFrame ].uPressure / 100.0 ) - atRefs[ iFrame ].dPressure ));
+    }
+  }
+
+  // report
+  printf( "burst: %d frames, %d in range, max error %.4f C %.3f Pa\n", NUM_FRAMES, iUsed, dMaxTemp, dMaxPress );
+  if (( dMaxTemp > LIMIT_TEMP ) || ( dMaxPress > LIMIT_PRESS ))
+  {
+    printf( "  error: exceeds %.2f C %.2f Pa\n", LIMIT_TEMP, LIMIT_PRESS );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief timing
+ *
+ * This function will time the burst compensation and the reference per
+ * sample
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  int     iPass, iFrame;
+  U32     uRawTemp, uRawPress;
+  double  dStart, dBurst, dRef;
+
+  // time the burst
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    SenBMP388_CompensateBurst( SenBMP388_GetCompensation( ), anFrames, NUM_FRAMES, atValues );
+  }
+  dBurst = GetTime( ) - dStart;
+
+  // time the reference
+  dStart = GetTime( );
+  for ( iPass = 0; iPass < TIMING_PASSES; iPass++ )
+  {
+    for ( iFrame = 0; iFrame < NUM_FRAMES; iFrame++ )
+    {
+      ParseFrame( &anFrames[ iFrame * SENBMP388_FRAME_SIZE ], &uRawTemp, &uRawPress );
+      Reference( uRawTemp, uRawPress, &atRefs[ iFrame ] );
+    }
+  }
+  dRef = GetTime( ) - dStart;
+
+  // report
+  printf( "timing: integer burst %.1f ns, double %.1f ns per sample\n", dBurst * 1e9 / ( TIMING_PASSES * NUM_FRAMES ),
+          dRef * 1e9 / ( TIMING_PASSES * NUM_FRAMES ));
+}
+
+/******************************************************************************
+ * @function GetTime
+ *
+ * @brief get the time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time
+ *
+ *****************************************************************************/
+static double GetTime( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/**@} EOF SenBMP388CompTest.c */
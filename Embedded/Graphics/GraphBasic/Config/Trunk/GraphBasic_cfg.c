@@ -28,9 +28,50 @@
 
 // library includes -----------------------------------------------------------
 #include "GraphFont5x7/GraphFont5x7.h"
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
 #include "LcdSSD1306/LcdSSD1306.h"
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+#include "DisplayST7565R/DisplayST7565R.h"
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+#include "DisplayILI9341/DisplayILI9341.h"
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 // Macros and Defines ---------------------------------------------------------
+/// determine the display width/height
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
+  #define DISPLAY_WIDTH                         ( LCDSSD1306_DISPLAY_WIDTH )
+  #define DISPLAY_HEIGHT                        ( LCDSSD1306_DISPLAY_HEIGHT )
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+  #if ( DISPLAYST7565R_TYPE_SELECT == DISPLAYST7565R_TYPE_132M )
+    #define DISPLAY_WIDTH                       ( 132 )
+    #define DISPLAY_HEIGHT                      ( 32 )
+  #else
+    #define DISPLAY_WIDTH                       ( 128 )
+    #define DISPLAY_HEIGHT                      ( 64 )
+  #endif // DISPLAYST7565R_TYPE_SELECT
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  #define DISPLAY_WIDTH                         ( DISPLAY_ILI9314_MAX_X + 1 )
+  #define DISPLAY_HEIGHT                        ( DISPLAY_ILI9314_MAX_Y + 1 )
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+  #define DISPLAY_WIDTH                         ( GRAPHBASIC_MEMORY_WIDTH )
+  #define DISPLAY_HEIGHT                        ( GRAPHBASIC_MEMORY_HEIGHT )
+#else
+  #error "GRAPHBASIC_DISPLAY_SELECT incorrectly set"
+#endif // GRAPHBASIC_DISPLAY_SELECT
+
+/// define the number of rows in a page for the page organized displays
+#define PAGE_HEIGHT                             ( 8 )
+
+/// define the size of the in memory buffers
+#define MEMORY_BUFFER_SIZE                      (( DISPLAY_WIDTH * DISPLAY_HEIGHT ) / PAGE_HEIGHT )
+
+/// define the size of the color shadow, two pixels per byte, the panel can
+/// not be read back so the shadow holds the frame for the XOR action and for
+/// the dirty regions pushed at the end of a frame
+#define SHADOW_BUFFER_SIZE                      (( DISPLAY_WIDTH * DISPLAY_HEIGHT ) / 2 )
+
+/// define the shadow nibble mask
+#define SHADOW_NIBBLE_MASK                      ( 0x0F )
 
 // enumerations ---------------------------------------------------------------
 
@@ -39,16 +80,51 @@
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+static  U8                  anShadow[ SHADOW_BUFFER_SIZE ];
+static  U16                 awLine[ DISPLAY_WIDTH ];
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+static  U8                  anWorkBuffer[ MEMORY_BUFFER_SIZE ];
+static  U8                  anPanelBuffer[ MEMORY_BUFFER_SIZE ];
+static  GRAPHBASICMEMSTATS  tMemStats;
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 // local function prototypes --------------------------------------------------
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+static  void  SetShadow( U32 uOffset, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor );
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+static  void  SetColData( U16 wOffset, U8 nMask, GRAPHBASICPIXACT eAction );
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 // constant parameter initializations -----------------------------------------
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
 static  const LCDSSD1306DISPLAYPIXACT aeActions[ GRAPHBASIC_PIXACT_MAX ] =
 {
   LCDSSD1306_DISPLAY_PIXACT_CLR,
   LCDSSD1306_DISPLAY_PIXACT_SET,
   LCDSSD1306_DISPLAY_PIXACT_TGL
 };
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+static  const DISPLAYPIXACT aeActions[ GRAPHBASIC_PIXACT_MAX ] =
+{
+  DISPLAY_PIXACT_CLR,
+  DISPLAY_PIXACT_SET,
+  DISPLAY_PIXACT_TGL
+};
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+/// RGB565 palette for the colors
+static  const CODE U16  awPalette[ GRAPHBASIC_CLR_MAX ] =
+{
+  0x0000,     // black
+  0xF800,     // red
+  0x07E0,     // green
+  0x001F,     // blue
+  0xFFE0,     // yellow
+  0x07FF,     // cyan
+  0xF81F,     // purple
+  0xFFFF      // white
+};
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 /******************************************************************************
  * @function GraphBasic_LocalInitialize
@@ -63,10 +139,21 @@ static  const LCDSSD1306DISPLAYPIXACT aeActions[ GRAPHBASIC_PIXACT_MAX ] =
  *****************************************************************************/
 BOOL GraphBasic_LocalInitialize( void )
 {
-  BOOL bStatus;
+  BOOL bStatus = FALSE;
 
   // initialize the display
+  #if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
   bStatus = LcdSSD1306_Initialize( );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+  DisplayST7565R_Initialize( );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  DisplayILI9314_Initialize( );
+  memset( anShadow, 0, SHADOW_BUFFER_SIZE );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+  memset( anWorkBuffer, 0, MEMORY_BUFFER_SIZE );
+  memset( anPanelBuffer, 0, MEMORY_BUFFER_SIZE );
+  memset( &tMemStats, 0, GRAPHBASICMEMSTATS_SIZE );
+  #endif // GRAPHBASIC_DISPLAY_SELECT
 
   return( bStatus );
 }
@@ -82,7 +169,80 @@ BOOL GraphBasic_LocalInitialize( void )
 void GraphBasic_RefreshScreen( void )
 {
   // refresh the screen
-  LcdSSD1306_WriteBuffer( );
+  GraphBasic_RefreshRegion( 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1 );
+}
+
+/******************************************************************************
+ * @function GraphBasic_RefreshRegion
+ *
+ * @brief refresh a region of the screen
+ *
+ * This function will push a region of the screen to the display, the page
+ * organized displays are pushed in whole pages
+ *
+ * @param[in]   wXMin     left coordinate
+ * @param[in]   wYMin     top coordinate
+ * @param[in]   wXMax     right coordinate, inclusive
+ * @param[in]   wYMax     bottom coordinate, inclusive
+ *
+ *****************************************************************************/
+void GraphBasic_RefreshRegion( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax )
+{
+  #if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  U16 wX, wY, wIndex;
+  U32 uOffset;
+  U8  nColor;
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+  U16 wPage, wOffset, wLength;
+  #endif // GRAPHBASIC_DISPLAY_SELECT
+
+  // constrain to the display
+  wXMax = MIN( wXMax, DISPLAY_WIDTH - 1 );
+  wYMax = MIN( wYMax, DISPLAY_HEIGHT - 1 );
+  if (( wXMin > wXMax ) || ( wYMin > wYMax ))
+  {
+    // nothing to do
+    return;
+  }
+
+  #if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
+  // write the pages that contain the region
+  LcdSSD1306_WriteBufferRegion(( U8 )wXMin, ( U8 )wXMax, ( U8 )( wYMin / PAGE_HEIGHT ), ( U8 )( wYMax / PAGE_HEIGHT ));
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+  // write the pages that contain the region
+  DisplayST7565R_WriteBufferRegion(( U8 )wXMin, ( U8 )wXMax, ( U8 )( wYMin / PAGE_HEIGHT ), ( U8 )( wYMax / PAGE_HEIGHT ));
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  // open the window
+  DisplayILI9314_OpenWindow( wXMin, wXMax, wYMin, wYMax );
+
+  // for each row
+  for ( wY = wYMin; wY <= wYMax; wY++ )
+  {
+    // expand the row into the line buffer
+    for ( wX = wXMin, wIndex = 0; wX <= wXMax; wX++, wIndex++ )
+    {
+      uOffset = (( U32 )wY * DISPLAY_WIDTH ) + wX;
+      nColor = ( anShadow[ uOffset / 2 ] >> (( uOffset & 1 ) * 4 )) & SHADOW_NIBBLE_MASK;
+      awLine[ wIndex ] = PGM_RDWORD( awPalette[ nColor ] );
+    }
+
+    // write the row
+    DisplayILI9314_WritePixels( awLine, wIndex );
+  }
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+  // for each page that contains the region
+  wLength = ( wXMax - wXMin ) + 1;
+  for ( wPage = wYMin / PAGE_HEIGHT; wPage <= wYMax / PAGE_HEIGHT; wPage++ )
+  {
+    // copy the columns to the panel
+    wOffset = ( wPage * DISPLAY_WIDTH ) + wXMin;
+    memcpy( &anPanelBuffer[ wOffset ], &anWorkBuffer[ wOffset ], wLength );
+    tMemStats.uBytes += wLength;
+  }
+
+  // increment the regions
+  tMemStats.uRegions++;
+  #endif // GRAPHBASIC_DISPLAY_SELECT
 }
 
 /******************************************************************************
@@ -98,7 +258,7 @@ void GraphBasic_RefreshScreen( void )
 U16 GraphBasic_GetMaxX( void )
 {
   // return the width
-  return( LCDSSD1306_DISPLAY_WIDTH );
+  return( DISPLAY_WIDTH );
 }
 
 /******************************************************************************
@@ -114,7 +274,7 @@ U16 GraphBasic_GetMaxX( void )
 U16 GraphBasic_GetMaxY( void )
 {
   // return the height
-  return( LCDSSD1306_DISPLAY_HEIGHT );
+  return( DISPLAY_HEIGHT );
 }
 
 /******************************************************************************
@@ -149,9 +309,227 @@ U16 GraphBasic_GetFontX( void )
  *****************************************************************************/
 void GraphBasic_PixelDraw( U16 wX, U16 wY, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor )
 {
+  #if ( GRAPHBASIC_DISPLAY_SELECT != GRAPHBASIC_DISPLAY_ILI9341 )
+  // monochrome, the action sets the pixels
+  ( void )eColor;
+  #endif // GRAPHBASIC_DISPLAY_SELECT
+
+  #if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
   // call the pixel draw for the display
   LcdSSD1306_SetPixel(( U8 )wX, ( U8 )wY, aeActions[ eAction ] );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+  // call the pixel draw for the display
+  DisplayST7565R_SetPixel(( U8 )wX, ( U8 )wY, aeActions[ eAction ] );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  // set the shadow
+  SetShadow((( U32 )wY * DISPLAY_WIDTH ) + wX, eAction, eColor );
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+  // set the column data
+  SetColData( wX + (( wY / PAGE_HEIGHT ) * DISPLAY_WIDTH ), BIT(( wY & 0x07 )), eAction );
+  #endif // GRAPHBASIC_DISPLAY_SELECT
+}
+
+/******************************************************************************
+ * @function GraphBasic_RectDraw
+ *
+ * @brief draw a filled rectangle
+ *
+ * This function will fill a rectangle, the page organized displays are 
+ * filled a column byte at a time
+ *
+ * @param[in]   wXMin     left coordinate
+ * @param[in]   wYMin     top coordinate
+ * @param[in]   wXMax     right coordinate, inclusive
+ * @param[in]   wYMax     bottom coordinate, inclusive
+ * @param[in]   eAction   pixel action
+ * @Param[in]   eColor    pixel color
+ *
+ *****************************************************************************/
+void GraphBasic_RectDraw( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor )
+{
+  #if (( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 ) || ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY ))
+  U16 wPage, wPageEnd, wX;
+  U8  nMask;
+
+  // monochrome, the action sets the pixels
+  ( void )eColor;
+
+  // for each page
+  wPageEnd = wYMax / PAGE_HEIGHT;
+  for ( wPage = wYMin / PAGE_HEIGHT; wPage <= wPageEnd; wPage++ )
+  {
+    // compute the mask of the rows within this page
+    nMask = 0xFF;
+    if ( wPage == ( wYMin / PAGE_HEIGHT ))
+    {
+      nMask &= ( U8 )( 0xFF << ( wYMin & 0x07 ));
+    }
+    if ( wPage == wPageEnd )
+    {
+      nMask &= ( U8 )( 0xFF >> ( 7 - ( wYMax & 0x07 )));
+    }
+
+    // for each column
+    for ( wX = wXMin; wX <= wXMax; wX++ )
+    {
+      #if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_SSD1306 )
+      LcdSSD1306_SetColData(( U8 )wPage, ( U8 )wX, nMask, aeActions[ eAction ] );
+      #else
+      SetColData(( wPage * DISPLAY_WIDTH ) + wX, nMask, eAction );
+      #endif // GRAPHBASIC_DISPLAY_SELECT
+    }
+  }
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ST7565R )
+  U16 wX, wY;
+
+  // monochrome, the action sets the pixels
+  ( void )eColor;
+
+  // for each pixel
+  for ( wY = wYMin; wY <= wYMax; wY++ )
+  {
+    for ( wX = wXMin; wX <= wXMax; wX++ )
+    {
+      DisplayST7565R_SetPixel(( U8 )wX, ( U8 )wY, aeActions[ eAction ] );
+    }
+  }
+  #elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+  U16 wX, wY;
+  U32 uOffset;
+
+  // for each row
+  for ( wY = wYMin; wY <= wYMax; wY++ )
+  {
+    // for each pixel in the row
+    uOffset = (( U32 )wY * DISPLAY_WIDTH ) + wXMin;
+    for ( wX = wXMin; wX <= wXMax; wX++ )
+    {
+      SetShadow( uOffset++, eAction, eColor );
+    }
+  }
+  #endif // GRAPHBASIC_DISPLAY_SELECT
+}
+
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+/******************************************************************************
+ * @function GraphBasic_MemoryGetPanel
+ *
+ * @brief get the in memory panel
+ *
+ * This function will return a pointer to the in memory panel, which holds
+ * only what has been pushed by a refresh, in page organized format
+ *
+ * @return      pointer to the panel buffer
+ *
+ *****************************************************************************/
+PU8 GraphBasic_MemoryGetPanel( void )
+{
+  // return the panel
+  return( anPanelBuffer );
+}
+
+/******************************************************************************
+ * @function GraphBasic_MemoryGetStats
+ *
+ * @brief get the in memory display statistics
+ *
+ * This function will copy the statistics and optionally reset them
+ *
+ * @param[io]   ptStats   pointer to the storage for the statistics
+ * @param[in]   bReset    TRUE to reset the statistics
+ *
+ *****************************************************************************/
+void GraphBasic_MemoryGetStats( PGRAPHBASICMEMSTATS ptStats, BOOL bReset )
+{
+  // copy the stats
+  memcpy( ptStats, &tMemStats, GRAPHBASICMEMSTATS_SIZE );
+
+  // reset if requested
+  if ( bReset )
+  {
+    memset( &tMemStats, 0, GRAPHBASICMEMSTATS_SIZE );
+  }
+}
+#endif // GRAPHBASIC_DISPLAY_SELECT
+
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_ILI9341 )
+/******************************************************************************
+ * @function SetShadow
+ *
+ * @brief set a pixel in the color shadow
+ *
+ * This function will apply the action to a pixel in the color shadow
+ *
+ * @param[in]   uOffset   pixel offset
+ * @param[in]   eAction   pixel action
+ * @Param[in]   eColor    pixel color
+ *
+ *****************************************************************************/
+static void SetShadow( U32 uOffset, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor )
+{
+  U8  nShift, nColor;
+
+  // calculate the shift/get the current color
+  nShift = ( uOffset & 1 ) * 4;
+  nColor = ( anShadow[ uOffset / 2 ] >> nShift ) & SHADOW_NIBBLE_MASK;
+
+  // determine the action
+  switch( eAction )
+  {
+    case GRAPHBASIC_PIXACT_CLR :
+      nColor = GRAPHBASIC_CLR_ENUM_BLK;
+      break;
+
+    case GRAPHBASIC_PIXACT_SET :
+      nColor = eColor;
+      break;
+
+    case GRAPHBASIC_PIXACT_XOR :
+      nColor ^= eColor;
+      break;
+
+    default :
+      break;
+  }
+
+  // store it
+  anShadow[ uOffset / 2 ] &= ~( SHADOW_NIBBLE_MASK << nShift );
+  anShadow[ uOffset / 2 ] |= ( nColor & SHADOW_NIBBLE_MASK ) << nShift;
 }
+#elif ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+/******************************************************************************
+ * @function SetColData
+ *
+ * @brief set column data in the work buffer
+ *
+ * This function will apply the action to the masked bits of a column byte
+ *
+ * @param[in]   wOffset   byte offset
+ * @param[in]   nMask     bit mask
+ * @param[in]   eAction   pixel action
+ *
+ *****************************************************************************/
+static void SetColData( U16 wOffset, U8 nMask, GRAPHBASICPIXACT eAction )
+{
+  // determine the action
+  switch( eAction )
+  {
+    case GRAPHBASIC_PIXACT_CLR :
+      anWorkBuffer[ wOffset ] &= ~( nMask );
+      break;
+
+    case GRAPHBASIC_PIXACT_SET :
+      anWorkBuffer[ wOffset ] |= nMask;
+      break;
 
+    case GRAPHBASIC_PIXACT_XOR :
+      anWorkBuffer[ wOffset ] ^= nMask;
+      break;
+
+    default :
+      break;
+  }
+}
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 /**@} EOF GraphBasic_cfg.c */
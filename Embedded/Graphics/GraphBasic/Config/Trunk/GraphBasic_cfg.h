@@ -37,16 +37,31 @@
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+/// define the in memory display statistics
+typedef struct _GRAPHBASICMEMSTATS
+{
+  U32   uRegions;       ///< number of regions pushed to the panel
+  U32   uBytes;         ///< number of bytes pushed to the panel
+} GRAPHBASICMEMSTATS, *PGRAPHBASICMEMSTATS;
+#define GRAPHBASICMEMSTATS_SIZE                 sizeof( GRAPHBASICMEMSTATS )
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
 extern	BOOL  GraphBasic_LocalInitialize( void );
 extern  void  GraphBasic_RefreshScreen( void );
+extern  void  GraphBasic_RefreshRegion( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax );
 extern  U16   GraphBasic_GetMaxX( void );
 extern  U16   GraphBasic_GetMaxY( void );
 extern  U16   GraphBasic_GetFontX( void );
 extern  void  GraphBasic_PixelDraw( U16 wX, U16 wY, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor );
+extern  void  GraphBasic_RectDraw( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor );
+#if ( GRAPHBASIC_DISPLAY_SELECT == GRAPHBASIC_DISPLAY_MEMORY )
+extern  PU8   GraphBasic_MemoryGetPanel( void );
+extern  void  GraphBasic_MemoryGetStats( PGRAPHBASICMEMSTATS ptStats, BOOL bReset );
+#endif // GRAPHBASIC_DISPLAY_SELECT
 
 /**@} EOF GraphBasic_cfg.h */
 
@@ -27,8 +27,12 @@
 #include "GraphBasic/GraphBasic.h"
 
 // library includes -----------------------------------------------------------
+#include "GraphFont5x7/GraphFont5x7.h"
 
 // Macros and Defines ---------------------------------------------------------
+/// define the empty rectangle values
+#define RECT_EMPTY_MIN                          ( 0xFFFF )
+#define RECT_EMPTY_MAX                          ( 0 )
 
 // enumerations ---------------------------------------------------------------
 
@@ -37,8 +41,20 @@
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+static  GRAPHBASICRECT  atDirtyRects[ GRAPHBASIC_DIRTYRECT_NUM ];
+static  U8              nNumDirtyRects;
+static  GRAPHBASICRECT  tPendingRect;
+static  U8              nFrameDepth;
 
 // local function prototypes --------------------------------------------------
+static  void  CommitPending( void );
+static  void  FillClipped( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax, GRAPHBASICCLR eColor );
+static  void  AddDirtyRect( PGRAPHBASICRECT ptRect );
+static  void  FlushDirtyRects( void );
+static  void  ResetRect( PGRAPHBASICRECT ptRect );
+static  BOOL  RectsTouch( PGRAPHBASICRECT ptRect1, PGRAPHBASICRECT ptRect2 );
+static  void  UnionRect( PGRAPHBASICRECT ptDst, PGRAPHBASICRECT ptSrc );
+static  U32   ComputeArea( PGRAPHBASICRECT ptRect );
 
 // constant parameter initializations -----------------------------------------
 
@@ -59,24 +75,252 @@ BOOL GraphBasic_Initialize( void )
   // call the local initialization to initialize the actual display
   bStatus = GraphBasic_LocalInitialize( );
 
+  // clear the dirty rectangles/frame depth
+  ResetRect( &tPendingRect );
+  nNumDirtyRects = 0;
+  nFrameDepth = 0;
+
   // return status
   return( bStatus );
 }
 
 /******************************************************************************
- * @function 
+ * @function GraphBasic_BeginFrame
  *
- * @brief 
+ * @brief begin a frame
  *
- * This function 
+ * This function will begin a frame, the screen is not refreshed by any of the
+ * draw functions until the matching end frame, frames may be nested
+ *
+ *****************************************************************************/
+void GraphBasic_BeginFrame( void )
+{
+  // increment the frame depth
+  nFrameDepth++;
+}
+
+/******************************************************************************
+ * @function GraphBasic_EndFrame
  *
- * @param[in]   
+ * @brief end a frame
  *
- * @return      
+ * This function will end a frame, when the outermost frame ends the dirty
+ * rectangles are pushed to the display
+ *
+ *****************************************************************************/
+void GraphBasic_EndFrame( void )
+{
+  // check for in a frame
+  if ( nFrameDepth != 0 )
+  {
+    // decrement the depth, flush if outermost
+    if ( --nFrameDepth == 0 )
+    {
+      // add any pending changes and push them
+      CommitPending( );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function GraphBasic_DrawPixel
+ *
+ * @brief draw a pixel
+ *
+ * This function will draw a pixel and add it to the pending dirty rectangle,
+ * pixels outside of the display are ignored
+ *
+ * @param[in]   wX        X location
+ * @param[in]   wY        Y location
+ * @param[in]   eAction   pixel action
+ * @param[in]   eColor    pixel color
  *
  *****************************************************************************/
 void GraphBasic_DrawPixel( U16 wX, U16 wY, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor )
 {
+  // check for valid x/y locations
+  if (( wX < GraphBasic_GetMaxX( )) && ( wY < GraphBasic_GetMaxY( )))
+  {
+    // draw it
+    GraphBasic_PixelDraw( wX, wY, eAction, eColor );
+
+    // adjust the pending rectangle
+    tPendingRect.wXMin = MIN( tPendingRect.wXMin, wX );
+    tPendingRect.wYMin = MIN( tPendingRect.wYMin, wY );
+    tPendingRect.wXMax = MAX( tPendingRect.wXMax, wX );
+    tPendingRect.wYMax = MAX( tPendingRect.wYMax, wY );
+  }
+}
+
+/******************************************************************************
+ * @function GraphBasic_FillSpan
+ *
+ * @brief fill a horizontal span
+ *
+ * This function will fill a horizontal run of pixels
+ *
+ * @param[in]   wXStart   start X coordinate
+ * @param[in]   wY        Y coordinate
+ * @param[in]   wWidth    width
+ * @param[in]   eColor    desired color
+ *
+ *****************************************************************************/
+void GraphBasic_FillSpan( U16 wXStart, U16 wY, U16 wWidth, GRAPHBASICCLR eColor )
+{
+  // check for a valid width
+  if ( wWidth != 0 )
+  {
+    // fill it
+    FillClipped( wXStart, wY, wXStart + wWidth - 1, wY, eColor );
+  }
+
+  // commit the changes
+  CommitPending( );
+}
+
+/******************************************************************************
+ * @function GraphBasic_FillRect
+ *
+ * @brief fill a rectangle
+ *
+ * This function will fill a rectangle
+ *
+ * @param[in]   wXLeft    left coordinate
+ * @param[in]   wYTop     top coordinate
+ * @param[in]   wWidth    width
+ * @param[in]   wHeight   height
+ * @param[in]   eColor    desired color
+ *
+ *****************************************************************************/
+void GraphBasic_FillRect( U16 wXLeft, U16 wYTop, U16 wWidth, U16 wHeight, GRAPHBASICCLR eColor )
+{
+  // check for a valid size
+  if (( wWidth != 0 ) && ( wHeight != 0 ))
+  {
+    // fill it
+    FillClipped( wXLeft, wYTop, wXLeft + wWidth - 1, wYTop + wHeight - 1, eColor );
+  }
+
+  // commit the changes
+  CommitPending( );
+}
+
+/******************************************************************************
+ * @function GraphBasic_FillCircle
+ *
+ * @brief fill a circle
+ *
+ * This function will fill a circle with a horizontal span per row
+ *
+ * @param[in]   wXPoint   center x coordinate
+ * @param[in]   wYPoint   center y coordinate
+ * @param[in]   wRadius   radius
+ * @param[in]   eColor    desired color
+ *
+ *****************************************************************************/
+void GraphBasic_FillCircle( U16 wXPoint, U16 wYPoint, U16 wRadius, GRAPHBASICCLR eColor )
+{
+  S16 sX, sY, sErr, sErr2;
+  U16 wXMin;
+  
+  // set the intitial values
+  sX = ( S16 )-wRadius;
+  sY = 0;
+  sErr = 2 - ( 2* wRadius );
+  
+  // loop
+  do
+  {
+    // compute the left edge, the right edge is wXPoint - sX
+    wXMin = ( wXPoint >= ( U16 )-sX ) ? wXPoint + sX : 0;
+
+    // fill the spans above and below the center
+    FillClipped( wXMin, wYPoint + sY, wXPoint - sX, wYPoint + sY, eColor );
+    if ( wYPoint >= ( U16 )sY )
+    {
+      FillClipped( wXMin, wYPoint - sY, wXPoint - sX, wYPoint - sY, eColor );
+    }
+    
+    // adjust the error
+    sErr2 = sErr;
+    if ( sErr2 <= sY )
+    {
+      // step y
+      sErr += ( ++sY * 2 ) + 1;
+    }
+    if (( sErr2 > sX ) || ( sErr > sY ))
+    {
+      // step x
+      sErr += ( ++sX * 2 ) + 1;
+    }
+  } while( sX < 0 );
+  
+  // commit the changes
+  CommitPending( );
+}
+
+/******************************************************************************
+ * @function GraphBasic_BlitGlyph1bpp
+ *
+ * @brief draw a one bit per pixel glyph
+ *
+ * This function will draw a glyph stored a column per byte, least 
+ * significant bit at the top, as in the font tables.  Clear bits are drawn
+ * in the background color, the glyph is clipped to the display
+ *
+ * @param[in]   wXLeft    left coordinate
+ * @param[in]   wYTop     top coordinate
+ * @param[in]   pnColumns pointer to the glyph columns
+ * @param[in]   nWidth    number of columns
+ * @param[in]   nHeight   number of rows, 8 maximum
+ * @param[in]   eFgColor  foreground color
+ * @param[in]   eBgColor  background color
+ *
+ *****************************************************************************/
+void GraphBasic_BlitGlyph1bpp( U16 wXLeft, U16 wYTop, const CODE U8* pnColumns, U8 nWidth, U8 nHeight, GRAPHBASICCLR eFgColor, GRAPHBASICCLR eBgColor )
+{
+  GRAPHBASICPIXACT  eBgAction;
+  U16               wXMax, wYMax, wX, wY;
+  U8                nBits;
+
+  // clip to the display
+  wXMax = MIN( wXLeft + nWidth, GraphBasic_GetMaxX( ));
+  wYMax = MIN( wYTop + nHeight, GraphBasic_GetMaxY( ));
+  if (( wXLeft < wXMax ) && ( wYTop < wYMax ))
+  {
+    // black backgrounds clear
+    eBgAction = ( eBgColor == GRAPHBASIC_CLR_ENUM_BLK ) ? GRAPHBASIC_PIXACT_CLR : GRAPHBASIC_PIXACT_SET;
+
+    // for each column
+    for ( wX = wXLeft; wX < wXMax; wX++ )
+    {
+      // get the column
+      nBits = PGM_RDBYTE( *( pnColumns + ( wX - wXLeft )));
+
+      // for each row
+      for ( wY = wYTop; wY < wYMax; wY++, nBits >>= 1 )
+      {
+        // draw it
+        if ( nBits & 0x01 )
+        {
+          GraphBasic_PixelDraw( wX, wY, GRAPHBASIC_PIXACT_SET, eFgColor );
+        }
+        else
+        {
+          GraphBasic_PixelDraw( wX, wY, eBgAction, eBgColor );
+        }
+      }
+    }
+
+    // adjust the pending rectangle
+    tPendingRect.wXMin = MIN( tPendingRect.wXMin, wXLeft );
+    tPendingRect.wYMin = MIN( tPendingRect.wYMin, wYTop );
+    tPendingRect.wXMax = MAX( tPendingRect.wXMax, wXMax - 1 );
+    tPendingRect.wYMax = MAX( tPendingRect.wYMax, wYMax - 1 );
+  }
+
+  // commit the changes
+  CommitPending( );
 }
 
 /******************************************************************************
@@ -142,8 +386,8 @@ void GraphBasic_DrawLine( U16 wStartX, U16 wStartY, U16 wEndX, U16 wEndY, GRAPHB
     }
   }
   
-  // refresh the screen
-  GraphBasic_RefreshScreen( );
+  // commit the changes
+  CommitPending( );
 }
 
 
@@ -163,14 +407,13 @@ void GraphBasic_DrawLine( U16 wStartX, U16 wStartY, U16 wEndX, U16 wEndY, GRAPHB
  *****************************************************************************/
 void GraphBasic_DrawRectangle( U16 wTopLeft, U16 wTopRight, U16 wLength, U16 wWidth, GRAPHBASICCLR eColor )
 {
-  // draw the rectangle
+  // draw the rectangle as a single frame
+  GraphBasic_BeginFrame( );
   GraphBasic_DrawHorizontalLine( wTopLeft, wTopRight, wLength, eColor );
   GraphBasic_DrawHorizontalLine( wTopLeft, wTopRight + wWidth, wLength, eColor );
   GraphBasic_DrawVerticalLine( wTopLeft, wTopRight, wWidth, eColor );
   GraphBasic_DrawVerticalLine( wTopLeft + wLength, wTopRight, wWidth, eColor );
-  
-  // refresh the screen
-  GraphBasic_RefreshScreen( );
+  GraphBasic_EndFrame( );
 }
 
 /******************************************************************************
@@ -198,31 +441,28 @@ void GraphBasic_DrawCircle( U16 wXPoint, U16 wYPoint, U16 wRadius, GRAPHBASICCLR
   // loop
   do
   {
-    // just draw pixel
+    // draw a pixel in each quadrant, swapping x/y so each quadrant reaches its apex
     GraphBasic_DrawPixel( wXPoint - sX, wYPoint + sY, GRAPHBASIC_PIXACT_SET, eColor );
-    GraphBasic_DrawPixel( wXPoint + sX, wYPoint + sY, GRAPHBASIC_PIXACT_SET, eColor );
+    GraphBasic_DrawPixel( wXPoint - sY, wYPoint - sX, GRAPHBASIC_PIXACT_SET, eColor );
     GraphBasic_DrawPixel( wXPoint + sX, wYPoint - sY, GRAPHBASIC_PIXACT_SET, eColor );
-    GraphBasic_DrawPixel( wXPoint - sX, wYPoint - sY, GRAPHBASIC_PIXACT_SET, eColor );
+    GraphBasic_DrawPixel( wXPoint + sY, wYPoint + sX, GRAPHBASIC_PIXACT_SET, eColor );
     
     // adjust the error
     sErr2 = sErr;
     if ( sErr2 <= sY )
     {
-      // recompute
-      sErr += (( sY + 1 ) * 2 ) + 1;
-      if (( -sX == sY ) && ( sErr2 <= sX ))
-      {
-        sErr2 = 0;
-      }
-      if ( sErr2 > sX )
-      {
-        sErr += (( sX + 1 ) * 2 ) + 1;
-      }
+      // step y
+      sErr += ( ++sY * 2 ) + 1;
     }
-  } while( sX <= 0 );
+    if (( sErr2 > sX ) || ( sErr > sY ))
+    {
+      // step x
+      sErr += ( ++sX * 2 ) + 1;
+    }
+  } while( sX < 0 );
   
-  // refresh the screen
-  GraphBasic_RefreshScreen( );
+  // commit the changes
+  CommitPending( );
 }
 
 
@@ -244,13 +484,12 @@ void GraphBasic_DrawCircle( U16 wXPoint, U16 wYPoint, U16 wRadius, GRAPHBASICCLR
  *****************************************************************************/
 void GraphBasic_DrawTriangle( U16 wXPoint1, U16 wYPoint1, U16 wXPoint2, U16 wYPoint2, U16 wXPoint3, U16 wYPoint3, GRAPHBASICCLR eColor )
 {
-  // draw the three sides
+  // draw the three sides as a single frame
+  GraphBasic_BeginFrame( );
   GraphBasic_DrawLine( wXPoint1, wYPoint1, wXPoint2, wYPoint2, eColor );
   GraphBasic_DrawLine( wXPoint1, wYPoint1, wXPoint3, wYPoint3, eColor );
   GraphBasic_DrawLine( wXPoint2, wYPoint2, wXPoint3, wYPoint3, eColor );
-  
-  // refresh the screen
-  GraphBasic_RefreshScreen( );
+  GraphBasic_EndFrame( );
 }
 
 /******************************************************************************
@@ -271,6 +510,9 @@ void GraphBasic_DrawString( U16 wStartX, U16 wStartY, PC8 pszString, GRAPHBASICC
 {
   C8  cChar;
   
+  // draw the string as a single frame
+  GraphBasic_BeginFrame( );
+
   // for each character
   while(( cChar = *( pszString++ )) != 0 )
   {
@@ -285,8 +527,8 @@ void GraphBasic_DrawString( U16 wStartX, U16 wStartY, PC8 pszString, GRAPHBASICC
     }
   }
   
-  // refresh the screen
-  GraphBasic_RefreshScreen( );
+  // end the frame
+  GraphBasic_EndFrame( );
 }
 
 /******************************************************************************
@@ -304,6 +546,15 @@ void GraphBasic_DrawString( U16 wStartX, U16 wStartY, PC8 pszString, GRAPHBASICC
  *****************************************************************************/
 void GraphBasic_DrawChar( U16 wStartX, U16 wStartY, C8 cChar, GRAPHBASICCLR eColor )
 {
+  // validate character, unsigned so characters above 0x7F are caught
+  if ((( U8 )cChar < GRAPHICFONT_MIN_VAL ) || (( U8 )cChar > GRAPHICFONT_MAX_VAL ))
+  {
+    // set it to space
+    cChar = ' ';
+  }
+  
+  // draw the glyph
+  GraphBasic_BlitGlyph1bpp( wStartX, wStartY, g_anGraphicFont5x7[ cChar - GRAPHICFONT_MIN_VAL ], GRAPHICFONT_X_SIZE, GRAPHICFONT_Y_SIZE, eColor, GRAPHBASIC_CLR_ENUM_BLK );
 }
 
 /******************************************************************************
@@ -321,6 +572,15 @@ void GraphBasic_DrawChar( U16 wStartX, U16 wStartY, C8 cChar, GRAPHBASICCLR eCol
  *****************************************************************************/
 void GraphBasic_DrawVerticalLine( U16 wXStart, U16 wYStart, U16 wLength, GRAPHBASICCLR eColor )
 {
+  // check for a valid length
+  if ( wLength != 0 )
+  {
+    // fill it
+    FillClipped( wXStart, wYStart, wXStart, wYStart + wLength - 1, eColor );
+  }
+  
+  // commit the changes
+  CommitPending( );
 }
 
 /******************************************************************************
@@ -338,6 +598,254 @@ void GraphBasic_DrawVerticalLine( U16 wXStart, U16 wYStart, U16 wLength, GRAPHBA
  *****************************************************************************/
 void GraphBasic_DrawHorizontalLine( U16 wXStart, U16 wYstart, U16 wWidth, GRAPHBASICCLR eColor )
 {
+  // check for a valid width
+  if ( wWidth != 0 )
+  {
+    // fill it
+    FillClipped( wXStart, wYstart, wXStart + wWidth - 1, wYstart, eColor );
+  }
+  
+  // commit the changes
+  CommitPending( );
+}
+
+/******************************************************************************
+ * @function CommitPending
+ *
+ * @brief commit the pending rectangle
+ *
+ * This function will add the pending rectangle to the dirty rectangles and,
+ * if not in a frame, push the dirty rectangles to the display
+ *
+ *****************************************************************************/
+static void CommitPending( void )
+{
+  // check for pending changes
+  if ( tPendingRect.wXMin <= tPendingRect.wXMax )
+  {
+    // add it/reset it
+    AddDirtyRect( &tPendingRect );
+    ResetRect( &tPendingRect );
+  }
+  
+  // if not in a frame, flush
+  if ( nFrameDepth == 0 )
+  {
+    FlushDirtyRects( );
+  }
+}
+
+/******************************************************************************
+ * @function FillClipped
+ *
+ * @brief fill a clipped rectangle
+ *
+ * This function will clip the rectangle to the display, fill it and add it
+ * to the pending rectangle
+ *
+ * @param[in]   wXMin     left coordinate
+ * @param[in]   wYMin     top coordinate
+ * @param[in]   wXMax     right coordinate, inclusive
+ * @param[in]   wYMax     bottom coordinate, inclusive
+ * @param[in]   eColor    desired color
+ *
+ *****************************************************************************/
+static void FillClipped( U16 wXMin, U16 wYMin, U16 wXMax, U16 wYMax, GRAPHBASICCLR eColor )
+{
+  // clip to the display
+  wXMax = MIN( wXMax, GraphBasic_GetMaxX( ) - 1 );
+  wYMax = MIN( wYMax, GraphBasic_GetMaxY( ) - 1 );
+  if (( wXMin <= wXMax ) && ( wYMin <= wYMax ))
+  {
+    // fill it
+    GraphBasic_RectDraw( wXMin, wYMin, wXMax, wYMax, GRAPHBASIC_PIXACT_SET, eColor );
+
+    // adjust the pending rectangle
+    tPendingRect.wXMin = MIN( tPendingRect.wXMin, wXMin );
+    tPendingRect.wYMin = MIN( tPendingRect.wYMin, wYMin );
+    tPendingRect.wXMax = MAX( tPendingRect.wXMax, wXMax );
+    tPendingRect.wYMax = MAX( tPendingRect.wYMax, wYMax );
+  }
+}
+
+/******************************************************************************
+ * @function AddDirtyRect
+ *
+ * @brief add a dirty rectangle
+ *
+ * This function will merge the rectangle into an overlapping or adjacent 
+ * dirty rectangle, add it if none and there is room, or merge it into the 
+ * dirty rectangle that grows the least.  A merged rectangle can grow into
+ * others, so it then absorbs any it touches until none do
+ *
+ * @param[in]   ptRect    pointer to the rectangle
+ *
+ *****************************************************************************/
+static void AddDirtyRect( PGRAPHBASICRECT ptRect )
+{
+  GRAPHBASICRECT  tUnion;
+  U32             uGrowth, uBestGrowth;
+  U8              nIdx, nMergeIdx;
+  BOOL            bMerged;
+  
+  // look for an overlapping/adjacent rectangle
+  for ( nMergeIdx = 0; ( nMergeIdx < nNumDirtyRects ) && ( !RectsTouch( ptRect, &atDirtyRects[ nMergeIdx ] )); nMergeIdx++ );
+  
+  // check for none
+  if ( nMergeIdx == nNumDirtyRects )
+  {
+    // check for room
+    if ( nNumDirtyRects < GRAPHBASIC_DIRTYRECT_NUM )
+    {
+      // add it/done
+      atDirtyRects[ nNumDirtyRects++ ] = *ptRect;
+      return;
+    }
+
+    // find the rectangle that grows the least
+    uBestGrowth = 0xFFFFFFFF;
+    nMergeIdx = 0;
+    for ( nIdx = 0; nIdx < nNumDirtyRects; nIdx++ )
+    {
+      // compute the growth
+      tUnion = atDirtyRects[ nIdx ];
+      UnionRect( &tUnion, ptRect );
+      uGrowth = ComputeArea( &tUnion ) - ComputeArea( &atDirtyRects[ nIdx ] );
+      
+      // check for better
+      if ( uGrowth < uBestGrowth )
+      {
+        uBestGrowth = uGrowth;
+        nMergeIdx = nIdx;
+      }
+    }
+  }
+  
+  // merge it
+  UnionRect( &atDirtyRects[ nMergeIdx ], ptRect );
+
+  // absorb any rectangles the merged one now touches
+  do
+  {
+    bMerged = FALSE;
+    for ( nIdx = 0; ( nIdx < nNumDirtyRects ) && ( !bMerged ); nIdx++ )
+    {
+      // check for touching
+      if (( nIdx != nMergeIdx ) && ( RectsTouch( &atDirtyRects[ nMergeIdx ], &atDirtyRects[ nIdx ] )))
+      {
+        // merge it, then remove it by moving the last rectangle down
+        UnionRect( &atDirtyRects[ nMergeIdx ], &atDirtyRects[ nIdx ] );
+        atDirtyRects[ nIdx ] = atDirtyRects[ --nNumDirtyRects ];
+        if ( nMergeIdx == nNumDirtyRects )
+        {
+          nMergeIdx = nIdx;
+        }
+        bMerged = TRUE;
+      }
+    }
+  } while ( bMerged );
+}
+
+/******************************************************************************
+ * @function FlushDirtyRects
+ *
+ * @brief flush the dirty rectangles
+ *
+ * This function will push each dirty rectangle to the display and clear them
+ *
+ *****************************************************************************/
+static void FlushDirtyRects( void )
+{
+  PGRAPHBASICRECT ptDirty;
+  U8              nIdx;
+  
+  // for each dirty rectangle
+  for ( nIdx = 0; nIdx < nNumDirtyRects; nIdx++ )
+  {
+    // refresh the region
+    ptDirty = &atDirtyRects[ nIdx ];
+    GraphBasic_RefreshRegion( ptDirty->wXMin, ptDirty->wYMin, ptDirty->wXMax, ptDirty->wYMax );
+  }
+  
+  // clear the count
+  nNumDirtyRects = 0;
+}
+
+/******************************************************************************
+ * @function ResetRect
+ *
+ * @brief reset a rectangle
+ *
+ * This function will set the rectangle to empty
+ *
+ * @param[in]   ptRect    pointer to the rectangle
+ *
+ *****************************************************************************/
+static void ResetRect( PGRAPHBASICRECT ptRect )
+{
+  // set min to highest, max to lowest
+  ptRect->wXMin = RECT_EMPTY_MIN;
+  ptRect->wYMin = RECT_EMPTY_MIN;
+  ptRect->wXMax = RECT_EMPTY_MAX;
+  ptRect->wYMax = RECT_EMPTY_MAX;
+}
+
+/******************************************************************************
+ * @function RectsTouch
+ *
+ * @brief check two rectangles for touching
+ *
+ * This function will check if two rectangles overlap or are adjacent
+ *
+ * @param[in]   ptRect1   pointer to the first rectangle
+ * @param[in]   ptRect2   pointer to the second rectangle
+ *
+ * @return      TRUE if they touch, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL RectsTouch( PGRAPHBASICRECT ptRect1, PGRAPHBASICRECT ptRect2 )
+{
+  // check for touching
+  return((( ptRect1->wXMin <= ( ptRect2->wXMax + 1 )) && (( ptRect1->wXMax + 1 ) >= ptRect2->wXMin ) &&
+          ( ptRect1->wYMin <= ( ptRect2->wYMax + 1 )) && (( ptRect1->wYMax + 1 ) >= ptRect2->wYMin )) ? TRUE : FALSE );
+}
+
+/******************************************************************************
+ * @function UnionRect
+ *
+ * @brief union of two rectangles
+ *
+ * This function will grow the destination rectangle to include the source
+ *
+ * @param[io]   ptDst     pointer to the destination rectangle
+ * @param[in]   ptSrc     pointer to the source rectangle
+ *
+ *****************************************************************************/
+static void UnionRect( PGRAPHBASICRECT ptDst, PGRAPHBASICRECT ptSrc )
+{
+  // grow it
+  ptDst->wXMin = MIN( ptDst->wXMin, ptSrc->wXMin );
+  ptDst->wYMin = MIN( ptDst->wYMin, ptSrc->wYMin );
+  ptDst->wXMax = MAX( ptDst->wXMax, ptSrc->wXMax );
+  ptDst->wYMax = MAX( ptDst->wYMax, ptSrc->wYMax );
+}
+
+/******************************************************************************
+ * @function ComputeArea
+ *
+ * @brief compute the area of a rectangle
+ *
+ * This function will return the number of pixels in a rectangle
+ *
+ * @param[in]   ptRect    pointer to the rectangle
+ *
+ * @return      the area
+ *
+ *****************************************************************************/
+static U32 ComputeArea( PGRAPHBASICRECT ptRect )
+{
+  // return the area
+  return(( U32 )( ptRect->wXMax - ptRect->wXMin + 1 ) * ( U32 )( ptRect->wYMax - ptRect->wYMin + 1 ));
 }
 
 /**@} EOF GraphBasic.c */
@@ -42,6 +42,8 @@
 
 // global function prototypes --------------------------------------------------
 extern  BOOL  GraphBasic_Initialize( void );
+extern  void  GraphBasic_BeginFrame( void );
+extern  void  GraphBasic_EndFrame( void );
 extern  void  GraphBasic_DrawPixel( U16 wX, U16 wY, GRAPHBASICPIXACT eAction, GRAPHBASICCLR eColor );
 extern  void  GraphBasic_DrawLine( U16 wStartX, U16 wStartY, U16 wEndX, U16 wEndY, GRAPHBASICCLR eColor );
 extern  void  GraphBasic_DrawRectangle( U16 wTopLeft, U16 wTopRight, U16 wLength, U16 wWidth, GRAPHBASICCLR eColor );
@@ -51,6 +53,10 @@ extern  void  GraphBasic_DrawString( U16 wStartX, U16 wStartY, PC8 pszString, GR
 extern  void  GraphBasic_DrawChar( U16 wStartX, U16 wStartY, C8 cChar, GRAPHBASICCLR eColor );
 extern  void  GraphBasic_DrawVerticalLine( U16 wXStart, U16 wYStart, U16 wLength, GRAPHBASICCLR eColor );
 extern  void  GraphBasic_DrawHorizontalLine( U16 wXStart, U16 wYstart, U16 wWidth, GRAPHBASICCLR eColor );
+extern  void  GraphBasic_FillSpan( U16 wXStart, U16 wY, U16 wWidth, GRAPHBASICCLR eColor );
+extern  void  GraphBasic_FillRect( U16 wXLeft, U16 wYTop, U16 wWidth, U16 wHeight, GRAPHBASICCLR eColor );
+extern  void  GraphBasic_FillCircle( U16 wXPoint, U16 wYPoint, U16 wRadius, GRAPHBASICCLR eColor );
+extern  void  GraphBasic_BlitGlyph1bpp( U16 wXLeft, U16 wYTop, const CODE U8* pnColumns, U8 nWidth, U8 nHeight, GRAPHBASICCLR eFgColor, GRAPHBASICCLR eBgColor );
 
 /**@} EOF GraphBasic.h */
 
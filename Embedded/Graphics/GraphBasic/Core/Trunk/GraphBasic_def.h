@@ -28,6 +28,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
+#include "GraphBasic/GraphBasic_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -59,6 +60,15 @@ typedef enum _GRAPHBASICPIXACT
 } GRAPHBASICPIXACT;
 
 // structures -----------------------------------------------------------------
+/// define the rectangle structure, all coordinates are inclusive
+typedef struct _GRAPHBASICRECT
+{
+  U16   wXMin;          ///< left
+  U16   wYMin;          ///< top
+  U16   wXMax;          ///< right
+  U16   wYMax;          ///< bottom
+} GRAPHBASICRECT, *PGRAPHBASICRECT;
+#define GRAPHBASICRECT_SIZE                     sizeof( GRAPHBASICRECT )
 
 /**@} EOF GraphBasic_def.h */
 
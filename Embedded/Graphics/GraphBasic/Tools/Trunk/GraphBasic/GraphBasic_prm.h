@@ -0,0 +1,51 @@
+/******************************************************************************
+ * @file GraphBasic_prm.h
+ *
+ * @brief graphics basic test parameter declarations
+ *
+ * This file declares the customization for the graphics basic test, it
+ * selects the in memory display so the pixels can be checked
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup GraphBasic
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _GRAPHBASIC_PRM_H
+#define _GRAPHBASIC_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the display selections
+#define GRAPHBASIC_DISPLAY_SSD1306              ( 0 )
+#define GRAPHBASIC_DISPLAY_ST7565R              ( 1 )
+#define GRAPHBASIC_DISPLAY_ILI9341              ( 2 )
+#define GRAPHBASIC_DISPLAY_MEMORY               ( 3 )
+
+/// define the display selection
+#define GRAPHBASIC_DISPLAY_SELECT               ( GRAPHBASIC_DISPLAY_MEMORY )
+
+/// define the number of dirty rectangles tracked between refreshes
+#define GRAPHBASIC_DIRTYRECT_NUM                ( 4 )
+
+/// define the in memory display size, height must be a multiple of 8
+#define GRAPHBASIC_MEMORY_WIDTH                 ( 128 )
+#define GRAPHBASIC_MEMORY_HEIGHT                ( 64 )
+
+/**@} EOF GraphBasic_prm.h */
+
+#endif  // _GRAPHBASIC_PRM_H
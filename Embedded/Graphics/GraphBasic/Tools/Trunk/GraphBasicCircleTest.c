@@ -0,0 +1,181 @@
+/******************************************************************************
+ * @file GraphBasicCircleTest.c
+ *
+ * @brief graphics basic circle test
+ *
+ * This file provides a host tool that draws circles on the in memory display
+ * and checks them a pixel at a time on the panel.  For each radius it checks
+ * the four apex pixels are set, that the outline is symmetric about both axes
+ * and the diagonals, that every pixel lies within a pixel of the radius and
+ * that the outline has no gaps.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o GraphBasicCircleTest
+ *             GraphBasicCircleTest.c ../../Core/Trunk/GraphBasic.c
+ *             ../../Config/Trunk/GraphBasic_cfg.c
+ *             <GraphFont5x7 root>/Core/Trunk/GraphFont5x7.c -lm
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup GraphBasic
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// local includes -------------------------------------------------------------
+#include "GraphBasic/GraphBasic.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the circle center
+#define CENTER_X                                    ( 64 )
+#define CENTER_Y                                    ( 32 )
+
+/// define the largest radius that fits
+#define MAX_RADIUS                                  ( 31 )
+
+/// define the allowed distance from the radius
+#define RADIUS_TOLERANCE                            ( 1.0 )
+
+// local function prototypes --------------------------------------------------
+static  BOOL  GetPixel( S16 sX, S16 sY );
+static  int   CheckCircle( U16 wRadius );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will check each radius
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+  U16 wRadius;
+
+  // check each radius
+  for ( wRadius = 1; wRadius <= MAX_RADIUS; wRadius++ )
+  {
+    iErrors += CheckCircle( wRadius );
+  }
+
+  // report
+  printf( "%d radii, %d errors\n%s\n", MAX_RADIUS, iErrors, ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function GetPixel
+ *
+ * @brief get a panel pixel
+ *
+ * This function will return the state of a pixel on the panel relative to
+ * the circle center
+ *
+ * @param[in]   sX          X offset from the center
+ * @param[in]   sY          Y offset from the center
+ *
+ * @return      TRUE if set, FALSE if clear
+ *
+ *****************************************************************************/
+static BOOL GetPixel( S16 sX, S16 sY )
+{
+  PU8 pnPanel = GraphBasic_MemoryGetPanel( );
+  U16 wX = CENTER_X + sX;
+  U16 wY = CENTER_Y + sY;
+
+  // get the bit from the page organized panel
+  return(( pnPanel[ wX + (( wY / 8 ) * GRAPHBASIC_MEMORY_WIDTH ) ] & BIT(( wY & 0x07 ))) ? TRUE : FALSE );
+}
+
+/******************************************************************************
+ * @function CheckCircle
+ *
+ * @brief check a circle
+ *
+ * This function will draw a circle on a cleared display and check it
+ *
+ * @param[in]   wRadius     radius
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckCircle( U16 wRadius )
+{
+  int     iErrors = 0;
+  S16     sX, sY, sNx, sNy, sRadius = ( S16 )wRadius;
+  int     iNeighbors;
+  double  dDist;
+
+  // clear/draw
+  GraphBasic_Initialize( );
+  GraphBasic_DrawCircle( CENTER_X, CENTER_Y, wRadius, GRAPHBASIC_CLR_ENUM_WHT );
+
+  // the four apex pixels
+  if ( !GetPixel( 0, -sRadius ) || !GetPixel( 0, sRadius ) || !GetPixel( -sRadius, 0 ) || !GetPixel( sRadius, 0 ))
+  {
+    printf( "  radius %2d: apex missing, top %d bottom %d left %d right %d\n", wRadius,
+            GetPixel( 0, -sRadius ), GetPixel( 0, sRadius ), GetPixel( -sRadius, 0 ), GetPixel( sRadius, 0 ));
+    iErrors++;
+  }
+
+  // every pixel in the bounding box
+  for ( sY = -sRadius - 1; sY <= sRadius + 1; sY++ )
+  {
+    for ( sX = -sRadius - 1; sX <= sRadius + 1; sX++ )
+    {
+      if ( GetPixel( sX, sY ))
+      {
+        // symmetric about both axes and the diagonal
+        if ( !GetPixel( -sX, sY ) || !GetPixel( sX, -sY ) || !GetPixel( sY, sX ))
+        {
+          printf( "  radius %2d: %d,%d not symmetric\n", wRadius, sX, sY );
+          iErrors++;
+        }
+
+        // on the radius
+        dDist = sqrt(( double )(( sX * sX ) + ( sY * sY )));
+        if ( fabs( dDist - sRadius ) > RADIUS_TOLERANCE )
+        {
+          printf( "  radius %2d: %d,%d at %.2f\n", wRadius, sX, sY, dDist );
+          iErrors++;
+        }
+
+        // connected to two neighbors
+        iNeighbors = 0;
+        for ( sNy = -1; sNy <= 1; sNy++ )
+        {
+          for ( sNx = -1; sNx <= 1; sNx++ )
+          {
+            iNeighbors += ((( sNx != 0 ) || ( sNy != 0 )) && GetPixel( sX + sNx, sY + sNy ));
+          }
+        }
+        if ( iNeighbors < 2 )
+        {
+          printf( "  radius %2d: %d,%d has %d neighbors\n", wRadius, sX, sY, iNeighbors );
+          iErrors++;
+        }
+      }
+    }
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/**@} EOF GraphBasicCircleTest.c */
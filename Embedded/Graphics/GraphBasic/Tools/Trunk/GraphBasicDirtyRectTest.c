@@ -0,0 +1,463 @@
+/******************************************************************************
+ * @file GraphBasicDirtyRectTest.c
+ *
+ * @brief graphics basic dirty rectangle test
+ *
+ * This file provides a host tool that draws on the in memory display and
+ * checks the dirty rectangle tracking through the panel, which only holds
+ * what has been pushed.  It checks that a rectangle bridging two dirty
+ * rectangles merges all three, that a rectangle merged for lack of room
+ * absorbs a rectangle it grows into, and then draws random frames of fills
+ * and pixel actions against a reference, checking the panel after each frame.
+ * It then times a frame of scattered small updates pushed per draw, batched
+ * in a frame and as a full screen refresh, reporting the regions and bytes
+ * pushed.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o GraphBasicDirtyRectTest
+ *             GraphBasicDirtyRectTest.c ../../Core/Trunk/GraphBasic.c
+ *             ../../Config/Trunk/GraphBasic_cfg.c
+ *             <GraphFont5x7 root>/Core/Trunk/GraphFont5x7.c
+ * usage:      GraphBasicDirtyRectTest [frames] [seed]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup GraphBasic
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "GraphBasic/GraphBasic.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of frames/seed
+#define DEFAULT_FRAMES                              ( 2000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the most draws in a random frame/largest random rectangle
+#define MAX_FRAME_DRAWS                             ( 12 )
+#define MAX_RECT_SIZE                               ( 24 )
+
+/// define the benchmark updates per frame/update size/number of frames
+#define BENCH_UPDATES                               ( 6 )
+#define BENCH_UPDATE_WIDTH                          ( 12 )
+#define BENCH_UPDATE_HEIGHT                         ( 7 )
+#define BENCH_FRAMES                                ( 20000 )
+
+/// define the panel size
+#define PANEL_SIZE                                  (( GRAPHBASIC_MEMORY_WIDTH * GRAPHBASIC_MEMORY_HEIGHT ) / 8 )
+
+// local parameter declarations -----------------------------------------------
+static  U32   uRandom;
+static  U32   uErrors;
+static  U8    anReference[ PANEL_SIZE ];
+
+// local function prototypes --------------------------------------------------
+static  U32     Random( U32 uRange );
+static  void    Check( BOOL bCondition, PC8 pszWhat );
+static  double  GetSeconds( void );
+static  void    Restart( void );
+static  void    RefFill( U16 wXLeft, U16 wYTop, U16 wWidth, U16 wHeight );
+static  void    RefPixel( U16 wX, U16 wY, GRAPHBASICPIXACT eAction );
+static  void    CheckRegions( PC8 pszWhat, U32 uExpected );
+static  void    CheckBridge( void );
+static  void    CheckOverflow( void );
+static  void    RunRandom( U32 uFrames );
+static  void    RunBenchmark( void );
+static  void    DrawUpdates( U32 uFrame );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  U32 uFrames = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : DEFAULT_FRAMES;
+
+  // run the checks
+  uRandom = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+  CheckBridge( );
+  CheckOverflow( );
+  RunRandom( uFrames );
+  RunBenchmark( );
+
+  // report
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", ( unsigned )uErrors );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief random number
+ *
+ * @param[in]   uRange    range
+ *
+ * @return      random number below the range
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // xorshift
+  uRandom ^= uRandom << 13;
+  uRandom ^= uRandom >> 17;
+  uRandom ^= uRandom << 5;
+  return( uRandom % uRange );
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * @param[in]   bCondition  condition that must be true
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, PC8 pszWhat )
+{
+  // report the first few failures
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      fprintf( stderr, "fail: %s\n", pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function GetSeconds
+ *
+ * @brief get the monotonic time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time in seconds
+ *
+ *****************************************************************************/
+static double GetSeconds( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/******************************************************************************
+ * @function Restart
+ *
+ * @brief restart on a cleared display
+ *
+ * This function will clear the display, the reference and the statistics
+ *
+ *****************************************************************************/
+static void Restart( void )
+{
+  GRAPHBASICMEMSTATS  tStats;
+
+  // clear it all
+  GraphBasic_Initialize( );
+  memset( anReference, 0, PANEL_SIZE );
+  GraphBasic_MemoryGetStats( &tStats, TRUE );
+}
+
+/******************************************************************************
+ * @function RefFill
+ *
+ * @brief fill a rectangle in the reference
+ *
+ * This function will set the pixels of a rectangle, clipped to the display,
+ * the monochrome display sets the pixels for any fill color
+ *
+ * @param[in]   wXLeft    left coordinate
+ * @param[in]   wYTop     top coordinate
+ * @param[in]   wWidth    width
+ * @param[in]   wHeight   height
+ *
+ *****************************************************************************/
+static void RefFill( U16 wXLeft, U16 wYTop, U16 wWidth, U16 wHeight )
+{
+  U16 wX, wY;
+
+  // for each pixel
+  for ( wY = wYTop; ( wY < wYTop + wHeight ) && ( wY < GRAPHBASIC_MEMORY_HEIGHT ); wY++ )
+  {
+    for ( wX = wXLeft; ( wX < wXLeft + wWidth ) && ( wX < GRAPHBASIC_MEMORY_WIDTH ); wX++ )
+    {
+      RefPixel( wX, wY, GRAPHBASIC_PIXACT_SET );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function RefPixel
+ *
+ * @brief apply a pixel action to the reference
+ *
+ * @param[in]   wX        X location
+ * @param[in]   wY        Y location
+ * @param[in]   eAction   pixel action
+ *
+ *****************************************************************************/
+static void RefPixel( U16 wX, U16 wY, GRAPHBASICPIXACT eAction )
+{
+  PU8 pnByte = &anReference[ wX + (( wY / 8 ) * GRAPHBASIC_MEMORY_WIDTH ) ];
+  U8  nMask = BIT(( wY & 0x07 ));
+
+  // determine the action
+  switch( eAction )
+  {
+    case GRAPHBASIC_PIXACT_CLR :
+      *pnByte &= ~nMask;
+      break;
+
+    case GRAPHBASIC_PIXACT_SET :
+      *pnByte |= nMask;
+      break;
+
+    default :
+      *pnByte ^= nMask;
+      break;
+  }
+}
+
+/******************************************************************************
+ * @function CheckRegions
+ *
+ * @brief check the pushed regions and the panel
+ *
+ * @param[in]   pszWhat     description
+ * @param[in]   uExpected   expected number of regions
+ *
+ *****************************************************************************/
+static void CheckRegions( PC8 pszWhat, U32 uExpected )
+{
+  GRAPHBASICMEMSTATS  tStats;
+
+  // get the stats/check them
+  GraphBasic_MemoryGetStats( &tStats, TRUE );
+  if ( tStats.uRegions != uExpected )
+  {
+    fprintf( stderr, "%s: %u regions, expected %u\n", pszWhat, ( unsigned )tStats.uRegions, ( unsigned )uExpected );
+  }
+  Check( tStats.uRegions == uExpected, pszWhat );
+  Check( memcmp( GraphBasic_MemoryGetPanel( ), anReference, PANEL_SIZE ) == 0, pszWhat );
+}
+
+/******************************************************************************
+ * @function CheckBridge
+ *
+ * @brief check a rectangle that bridges two others
+ *
+ * This function will draw two separate rectangles and a third touching both
+ * in a frame, all three must be pushed as one region
+ *
+ *****************************************************************************/
+static void CheckBridge( void )
+{
+  // draw them
+  Restart( );
+  GraphBasic_BeginFrame( );
+  GraphBasic_FillRect( 0, 0, 4, 4, GRAPHBASIC_CLR_ENUM_WHT );
+  GraphBasic_FillRect( 20, 0, 4, 4, GRAPHBASIC_CLR_ENUM_WHT );
+  GraphBasic_FillRect( 3, 10, 18, 2, GRAPHBASIC_CLR_ENUM_WHT );
+  GraphBasic_FillRect( 2, 4, 20, 6, GRAPHBASIC_CLR_ENUM_WHT );
+  GraphBasic_EndFrame( );
+  RefFill( 0, 0, 4, 4 );
+  RefFill( 20, 0, 4, 4 );
+  RefFill( 3, 10, 18, 2 );
+  RefFill( 2, 4, 20, 6 );
+  CheckRegions( "bridge merges all", 1 );
+}
+
+/******************************************************************************
+ * @function CheckOverflow
+ *
+ * @brief check a merge for lack of room
+ *
+ * This function will fill the dirty rectangles with separate rectangles then
+ * add one that grows the first into the second, they must be pushed as one
+ *
+ *****************************************************************************/
+static void CheckOverflow( void )
+{
+  U8  nIdx;
+
+  // fill the dirty rectangles, the first two separated by a column
+  Restart( );
+  GraphBasic_BeginFrame( );
+  for ( nIdx = 0; nIdx < GRAPHBASIC_DIRTYRECT_NUM; nIdx++ )
+  {
+    GraphBasic_FillRect( nIdx * 12, ( nIdx < 2 ) ? 0 : 50, 10, 10, GRAPHBASIC_CLR_ENUM_WHT );
+    RefFill( nIdx * 12, ( nIdx < 2 ) ? 0 : 50, 10, 10 );
+  }
+
+  // a separate rectangle, growing the first least, over the second
+  GraphBasic_FillRect( 5, 20, 12, 2, GRAPHBASIC_CLR_ENUM_WHT );
+  RefFill( 5, 20, 12, 2 );
+  GraphBasic_EndFrame( );
+  CheckRegions( "overflow absorbs", GRAPHBASIC_DIRTYRECT_NUM - 1 );
+}
+
+/******************************************************************************
+ * @function RunRandom
+ *
+ * @brief random frames
+ *
+ * This function draws random fills and pixel actions in frames and checks
+ * the panel matches the reference after each frame
+ *
+ * @param[in]   uFrames   number of frames
+ *
+ *****************************************************************************/
+static void RunRandom( U32 uFrames )
+{
+  GRAPHBASICMEMSTATS  tStats;
+  GRAPHBASICPIXACT    eAction;
+  U32                 uFrame, uDraws, uRegions = 0;
+  U16                 wX, wY, wWidth, wHeight;
+  BOOL                bMatch = TRUE;
+
+  // for each frame
+  Restart( );
+  for ( uFrame = 0; uFrame < uFrames; uFrame++ )
+  {
+    // draw it
+    GraphBasic_BeginFrame( );
+    for ( uDraws = 1 + Random( MAX_FRAME_DRAWS ); uDraws != 0; uDraws-- )
+    {
+      wX = Random( GRAPHBASIC_MEMORY_WIDTH );
+      wY = Random( GRAPHBASIC_MEMORY_HEIGHT );
+      if ( Random( 2 ) == 0 )
+      {
+        // fill, may run off the display
+        wWidth = 1 + Random( MAX_RECT_SIZE );
+        wHeight = 1 + Random( MAX_RECT_SIZE );
+        GraphBasic_FillRect( wX, wY, wWidth, wHeight, GRAPHBASIC_CLR_ENUM_WHT );
+        RefFill( wX, wY, wWidth, wHeight );
+      }
+      else
+      {
+        // pixel
+        eAction = ( GRAPHBASICPIXACT )Random( GRAPHBASIC_PIXACT_MAX );
+        GraphBasic_DrawPixel( wX, wY, eAction, GRAPHBASIC_CLR_ENUM_WHT );
+        RefPixel( wX, wY, eAction );
+      }
+    }
+    GraphBasic_EndFrame( );
+
+    // check it
+    GraphBasic_MemoryGetStats( &tStats, TRUE );
+    Check( tStats.uRegions <= GRAPHBASIC_DIRTYRECT_NUM, "regions per frame" );
+    bMatch &= ( memcmp( GraphBasic_MemoryGetPanel( ), anReference, PANEL_SIZE ) == 0 ) ? TRUE : FALSE;
+    uRegions += tStats.uRegions;
+  }
+  Check( bMatch, "random frames" );
+  printf( "random: %u frames, %.2f regions per frame\n", ( unsigned )uFrames, ( double )uRegions / MAX( uFrames, 1 ));
+}
+
+/******************************************************************************
+ * @function RunBenchmark
+ *
+ * @brief time the refresh strategies
+ *
+ * This function draws the same frames of scattered updates pushed per draw,
+ * batched in a frame, and batched with a full screen refresh, reporting the
+ * time and the regions and bytes pushed per frame
+ *
+ *****************************************************************************/
+static void RunBenchmark( void )
+{
+  static  const PC8   apszModes[ ] = { "per draw", "frame batched", "full screen" };
+  GRAPHBASICMEMSTATS  tStats;
+  U32                 uFrame, uMode;
+  double              dStart, dElapsed;
+
+  // for each mode
+  for ( uMode = 0; uMode < 3; uMode++ )
+  {
+    // draw the frames
+    Restart( );
+    dStart = GetSeconds( );
+    for ( uFrame = 0; uFrame < BENCH_FRAMES; uFrame++ )
+    {
+      if ( uMode != 0 )
+      {
+        GraphBasic_BeginFrame( );
+      }
+      DrawUpdates( uFrame );
+      if ( uMode != 0 )
+      {
+        GraphBasic_EndFrame( );
+      }
+      if ( uMode == 2 )
+      {
+        GraphBasic_RefreshScreen( );
+      }
+    }
+    dElapsed = GetSeconds( ) - dStart;
+
+    // report
+    GraphBasic_MemoryGetStats( &tStats, TRUE );
+    if ( uMode == 2 )
+    {
+      // discount the batched regions, only the full screen is of interest
+      tStats.uRegions = BENCH_FRAMES;
+      tStats.uBytes = BENCH_FRAMES * PANEL_SIZE;
+    }
+    printf( "%-14s %7.0f ns/frame, %5.2f regions, %6.1f bytes per frame\n", apszModes[ uMode ],
+            ( dElapsed * 1e9 ) / BENCH_FRAMES, ( double )tStats.uRegions / BENCH_FRAMES, ( double )tStats.uBytes / BENCH_FRAMES );
+  }
+}
+
+/******************************************************************************
+ * @function DrawUpdates
+ *
+ * @brief draw the scattered updates of a frame
+ *
+ * This function will redraw a few small value fields, as a status screen
+ * would, each as a cleared box with a changing bar
+ *
+ * @param[in]   uFrame    frame number
+ *
+ *****************************************************************************/
+static void DrawUpdates( U32 uFrame )
+{
+  U16 wUpdate, wX, wY;
+
+  // for each update
+  for ( wUpdate = 0; wUpdate < BENCH_UPDATES; wUpdate++ )
+  {
+    // fields in two columns, three rows
+    wX = ( wUpdate % 2 ) * ( GRAPHBASIC_MEMORY_WIDTH / 2 ) + 40;
+    wY = ( wUpdate / 2 ) * ( GRAPHBASIC_MEMORY_HEIGHT / 3 ) + 4;
+    GraphBasic_FillRect( wX, wY, BENCH_UPDATE_WIDTH, BENCH_UPDATE_HEIGHT, GRAPHBASIC_CLR_ENUM_BLK );
+    GraphBasic_DrawHorizontalLine( wX, wY + 3, 1 + (( uFrame + wUpdate ) % BENCH_UPDATE_WIDTH ), GRAPHBASIC_CLR_ENUM_WHT );
+  }
+}
+
+/**@} EOF GraphBasicDirtyRectTest.c */
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * @file I2c_cfg.c
+ *
+ * @brief I2C configuration implementation
+ *
+ * This file provides the device table for the Linux I2C devices
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2C
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2C/I2c_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+// static U8 anSimRegs0[ 256 ];
+
+// static const I2CSIMDEV atSimDevs[ ] =
+// {
+//   I2C_SIMDEV( 0x50, anSimRegs0 ),
+// };
+
+/// device configuration table
+const I2CDEF atI2cDefs[ I2C_DEV_ENUM_MAX ] =
+{
+  // I2C_DEVICE_LINUX( name )
+  // I2C_DEVICE_SIM( simdevs )
+};  
+
+/**@} EOF I2c_cfg.c */
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * @file I2c_cfg.h
+ *
+ * @brief I2C configuraiton declarations
+ *
+ * This file provides the configuration declarations for the Linux I2C devices
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2C
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _I2C_CFG_H
+#define _I2C_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2C/I2c_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// declare the I2C enuemrations
+typedef enum  _I2CDEVENUM
+{
+  // add enuemrations below
+ 
+  // do not remove the below items
+  I2C_DEV_ENUM_MAX,
+  I2C_DEV_ENUM_ILLEGAL
+} I2CDEVENUM;
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  const I2CDEF atI2cDefs[ ];
+
+/**@} EOF I2c_cfg.h */
+
+#endif  // _I2C_CFG_H
@@ -0,0 +1,637 @@
+/******************************************************************************
+ * @file I2c.c
+ *
+ * @brief I2C implementation
+ *
+ * This file provides the implementation for the Linux I2C interface.  Each
+ * device is either an i2c-dev adapter, where a register read is issued as
+ * a single I2C_RDWR combined transfer with a repeated start, or a simulated
+ * bus of register file devices that is used for testing and benchmarking
+ * the upper layers without hardware
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2C
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// local includes -------------------------------------------------------------
+#include "I2C/I2c.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the maximum address length
+#define MAX_ADDR_LEN                            ( 4 )
+
+/// define the local buffer size
+#define LCL_BUF_SIZE                            ( 256 + MAX_ADDR_LEN )
+
+/// define the i2c-dev timeout resolution in msecs
+#define I2CDEV_TIMEOUT_RES_MSECS                ( 10 )
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the local control structure
+typedef struct _LCLCTL
+{
+  int             iFileDescriptor;    ///< handle
+  U8              nDevAddr;           ///< current device address
+  U8              nSimIndex;          ///< last addressed simulated device
+  U16             wSimRegister;       ///< simulated register pointer
+  I2CSTATS        tStats;             ///< statistics
+} LCLCTL, *PLCLCTL;
+#define LCLCTL_SIZE           sizeof( LCLCTL )
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  LCLCTL  atLclCtls[ I2C_DEV_ENUM_MAX ];
+static  U8      anLclBuffer[ LCL_BUF_SIZE ];
+
+// local function prototypes --------------------------------------------------
+static  I2CERR      LinuxTransfer( PLCLCTL ptCtl, PI2CXFRCTL ptXfrCtl, BOOL bRead );
+static  I2CERR      SimTransfer( PI2CDEF ptDef, PLCLCTL ptCtl, PI2CXFRCTL ptXfrCtl, BOOL bRead );
+static  PI2CSIMDEV  FindSimDevice( PI2CDEF ptDef, U8 nDevAddr, PU8 pnIndex );
+static  U8          LoadAddress( PI2CXFRCTL ptXfrCtl );
+static  I2CERR      MapErrno( int iError );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function I2c_Initialize
+ *
+ * @brief I2C initialization
+ *
+ * This function will open each i2c-dev adapter and reset the simulated
+ * register pointers
+ *
+ *****************************************************************************/
+void I2c_Initialize( void )
+{
+  I2CDEVENUM  eDev;
+  PI2CDEF     ptDef;
+  PLCLCTL     ptCtl;
+
+  // for each device
+  for ( eDev = 0; eDev < I2C_DEV_ENUM_MAX; eDev++ )
+  {
+    // get pointers to the definition/control
+    ptDef = ( PI2CDEF )&atI2cDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // clear the control
+    memset( ptCtl, 0, LCLCTL_SIZE );
+    ptCtl->iFileDescriptor = -1;
+
+    // open the adapter
+    if ( ptDef->eBackend == I2C_BACKEND_LINUX )
+    {
+      ptCtl->iFileDescriptor = open( ptDef->pszDevName, O_RDWR );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function I2c_CloseAll
+ *
+ * @brief close all the I2C devices
+ *
+ * This function will close all the devices
+ *
+ *****************************************************************************/
+void I2c_CloseAll( void )
+{
+  I2CDEVENUM  eDev;
+
+  // for each device
+  for ( eDev = 0; eDev < I2C_DEV_ENUM_MAX; eDev++ )
+  {
+    // close it
+    I2c_Close( eDev );
+  }
+}
+
+/******************************************************************************
+ * @function I2c_Write
+ *
+ * @brief write some characters to the I2C
+ *
+ * This function will write the address bytes, MSB first, followed by the
+ * data in a single write message
+ *
+ * @param[in]   eDev        Device enumeration
+ * @param[in]   ptXfrCtl    pointer to the transfer control
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+I2CERR I2c_Write( I2CDEVENUM eDev, PI2CXFRCTL ptXfrCtl )
+{
+  I2CERR  eError = I2C_ERROR_NONE;
+  PI2CDEF ptDef;
+  PLCLCTL ptCtl;
+
+  // check for a valid device/parameters
+  if ( eDev >= I2C_DEV_ENUM_MAX )
+  {
+    // illegal device
+    eError = I2C_ERROR_ILLDEV;
+  }
+  else if (( ptXfrCtl == NULL ) || ( ptXfrCtl->nAddrLen > MAX_ADDR_LEN ) || (( ptXfrCtl->wDataLen != 0 ) && ( ptXfrCtl->pnData == NULL )))
+  {
+    // illegal parameter
+    eError = I2C_ERROR_ILLPRM;
+  }
+  else
+  {
+    // get pointers to the definition/control
+    ptDef = ( PI2CDEF )&atI2cDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // process the backend
+    eError = ( ptDef->eBackend == I2C_BACKEND_LINUX ) ? LinuxTransfer( ptCtl, ptXfrCtl, FALSE ) : SimTransfer( ptDef, ptCtl, ptXfrCtl, FALSE );
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function I2c_Read
+ *
+ * @brief read some characters from the I2C
+ *
+ * This function will write the address bytes and then read the data after
+ * a repeated start
+ *
+ * @param[in]   eDev        Device enumeration
+ * @param[in]   ptXfrCtl    pointer to the transfer control
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+I2CERR I2c_Read( I2CDEVENUM eDev, PI2CXFRCTL ptXfrCtl )
+{
+  I2CERR  eError = I2C_ERROR_NONE;
+  PI2CDEF ptDef;
+  PLCLCTL ptCtl;
+
+  // check for a valid device/parameters
+  if ( eDev >= I2C_DEV_ENUM_MAX )
+  {
+    // illegal device
+    eError = I2C_ERROR_ILLDEV;
+  }
+  else if (( ptXfrCtl == NULL ) || ( ptXfrCtl->nAddrLen > MAX_ADDR_LEN ) || ( ptXfrCtl->wDataLen == 0 ) || ( ptXfrCtl->pnData == NULL ))
+  {
+    // illegal parameter
+    eError = I2C_ERROR_ILLPRM;
+  }
+  else
+  {
+    // get pointers to the definition/control
+    ptDef = ( PI2CDEF )&atI2cDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // process the backend
+    eError = ( ptDef->eBackend == I2C_BACKEND_LINUX ) ? LinuxTransfer( ptCtl, ptXfrCtl, TRUE ) : SimTransfer( ptDef, ptCtl, ptXfrCtl, TRUE );
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function I2c_Ioctl
+ *
+ * @brief I2C IOCTL functions
+ *
+ * This function provides functionality to modify the I2Cs parameters
+ *
+ * @param[in]   eDev        Device enumeration
+ * @param[in]   eAction     action to take
+ * @param[io]   pvData      pointer to data storage/retrieval
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+I2CERR I2c_Ioctl( I2CDEVENUM eDev, I2CACTION eAction, PVOID pvData )
+{
+  I2CERR      eError = I2C_ERROR_NONE;
+  PI2CDEF     ptDef;
+  PLCLCTL     ptCtl;
+  PI2CCHKBSY  ptChkBsy;
+  U8          nDummy;
+
+  // check for a valid device
+  if ( eDev < I2C_DEV_ENUM_MAX )
+  {
+    // get pointers to the definition/control
+    ptDef = ( PI2CDEF )&atI2cDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // process the action
+    switch( eAction )
+    {
+      case I2C_ACTION_POLL_DEVICE :
+        // get the pointer to the check busy structure
+        ptChkBsy = ( PI2CCHKBSY )pvData;
+
+        // check the backend
+        if ( ptDef->eBackend == I2C_BACKEND_LINUX )
+        {
+          // select the slave and attempt a single byte read
+          if (( ioctl( ptCtl->iFileDescriptor, I2C_SLAVE, ptChkBsy->nDevAddr ) < 0 ) || ( read( ptCtl->iFileDescriptor, &nDummy, 1 ) != 1 ))
+          {
+            // no response
+            eError = I2C_ERROR_SLVNAK;
+          }
+        }
+        else if ( FindSimDevice( ptDef, ptChkBsy->nDevAddr, &nDummy ) == NULL )
+        {
+          // no simulated device at this address
+          eError = I2C_ERROR_SLVNAK;
+        }
+        break;
+
+      case I2C_ACTION_SET_DEVADDR :
+        // set the device address
+        ptCtl->nDevAddr = *( PU8 )pvData;
+        break;
+
+      case I2C_ACTION_GET_DEVADDR :
+        // return the device address
+        *( PU8 )pvData = ptCtl->nDevAddr;
+        break;
+
+      case I2C_ACTION_GET_STATS :
+        // copy the statistics
+        memcpy( pvData, &ptCtl->tStats, I2CSTATS_SIZE );
+        break;
+
+      case I2C_ACTION_CLR_STATS :
+        // clear the statistics
+        memset( &ptCtl->tStats, 0, I2CSTATS_SIZE );
+        break;
+
+      default :
+        // illegal action
+        eError = I2C_ERROR_ILLACT;
+        break;
+    }
+  }
+  else
+  {
+    // illegal device
+    eError = I2C_ERROR_ILLDEV;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function I2c_Close
+ *
+ * @brief Close the I2C
+ *
+ * This function will close the adapter
+ *
+ * @param[in]   eDev        Device enumeration
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+I2CERR I2c_Close( I2CDEVENUM eDev )
+{
+  I2CERR  eError = I2C_ERROR_NONE;
+  PLCLCTL ptCtl;
+
+  // check for a valid device
+  if ( eDev < I2C_DEV_ENUM_MAX )
+  {
+    // get the control and close the handle
+    ptCtl = &atLclCtls[ eDev ];
+    if ( ptCtl->iFileDescriptor != -1 )
+    {
+      close( ptCtl->iFileDescriptor );
+      ptCtl->iFileDescriptor = -1;
+    }
+  }
+  else
+  {
+    // illegal device
+    eError = I2C_ERROR_ILLDEV;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function LinuxTransfer
+ *
+ * @brief perform an i2c-dev transfer
+ *
+ * This function builds the I2C_RDWR message list, a single write for a
+ * write transfer and an address write followed by a read for a read
+ * transfer
+ *
+ * @param[in]   ptCtl       pointer to the control
+ * @param[in]   ptXfrCtl    pointer to the transfer control
+ * @param[in]   bRead       TRUE for a read transfer
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+static I2CERR LinuxTransfer( PLCLCTL ptCtl, PI2CXFRCTL ptXfrCtl, BOOL bRead )
+{
+  I2CERR                      eError = I2C_ERROR_NONE;
+  struct i2c_msg              atMsgs[ 2 ];
+  struct i2c_rdwr_ioctl_data  tRdWr;
+  U8                          nAddrLen;
+
+  // check for an open adapter
+  if ( ptCtl->iFileDescriptor == -1 )
+  {
+    // report a bus fault
+    eError = I2C_ERROR_BUSFAULT;
+  }
+  else if (( bRead == FALSE ) && ( ptXfrCtl->wDataLen > ( LCL_BUF_SIZE - MAX_ADDR_LEN )))
+  {
+    // write will not fit in the local buffer
+    eError = I2C_ERROR_ILLPRM;
+  }
+  else
+  {
+    // set the timeout if requested
+    if ( ptXfrCtl->uTimeout != 0 )
+    {
+      ioctl( ptCtl->iFileDescriptor, I2C_TIMEOUT, ( ptXfrCtl->uTimeout + I2CDEV_TIMEOUT_RES_MSECS - 1 ) / I2CDEV_TIMEOUT_RES_MSECS );
+    }
+
+    // load the address
+    nAddrLen = LoadAddress( ptXfrCtl );
+    tRdWr.msgs = atMsgs;
+    tRdWr.nmsgs = 0;
+
+    if ( bRead )
+    {
+      // write the address if any
+      if ( nAddrLen != 0 )
+      {
+        atMsgs[ tRdWr.nmsgs ].addr = ptXfrCtl->nDevAddr;
+        atMsgs[ tRdWr.nmsgs ].flags = 0;
+        atMsgs[ tRdWr.nmsgs ].len = nAddrLen;
+        atMsgs[ tRdWr.nmsgs++ ].buf = anLclBuffer;
+      }
+
+      // now read the data after the repeated start
+      atMsgs[ tRdWr.nmsgs ].addr = ptXfrCtl->nDevAddr;
+      atMsgs[ tRdWr.nmsgs ].flags = I2C_M_RD;
+      atMsgs[ tRdWr.nmsgs ].len = ptXfrCtl->wDataLen;
+      atMsgs[ tRdWr.nmsgs++ ].buf = ptXfrCtl->pnData;
+    }
+    else
+    {
+      // append the data to the address
+      memcpy( &anLclBuffer[ nAddrLen ], ptXfrCtl->pnData, ptXfrCtl->wDataLen );
+      atMsgs[ tRdWr.nmsgs ].addr = ptXfrCtl->nDevAddr;
+      atMsgs[ tRdWr.nmsgs ].flags = 0;
+      atMsgs[ tRdWr.nmsgs ].len = nAddrLen + ptXfrCtl->wDataLen;
+      atMsgs[ tRdWr.nmsgs++ ].buf = anLclBuffer;
+    }
+
+    // perform the transfer
+    if ( ioctl( ptCtl->iFileDescriptor, I2C_RDWR, &tRdWr ) < 0 )
+    {
+      // map the error
+      eError = MapErrno( errno );
+    }
+
+    // update the statistics
+    ptCtl->tStats.uTransfers++;
+    ptCtl->tStats.uBytes += nAddrLen + ptXfrCtl->wDataLen;
+  }
+
+  // count errors
+  if ( eError != I2C_ERROR_NONE )
+  {
+    ptCtl->tStats.uErrors++;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function SimTransfer
+ *
+ * @brief perform a simulated transfer
+ *
+ * This function emulates a typical register file device, the address
+ * bytes load the register pointer, which then auto-increments as data is
+ * read or written.  A read without address bytes continues from the last
+ * register pointer
+ *
+ * @param[in]   ptDef       pointer to the definition
+ * @param[in]   ptCtl       pointer to the control
+ * @param[in]   ptXfrCtl    pointer to the transfer control
+ * @param[in]   bRead       TRUE for a read transfer
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+static I2CERR SimTransfer( PI2CDEF ptDef, PLCLCTL ptCtl, PI2CXFRCTL ptXfrCtl, BOOL bRead )
+{
+  I2CERR      eError = I2C_ERROR_NONE;
+  PI2CSIMDEV  ptSimDev;
+  U8          nIndex;
+  U32         uRegister;
+
+  // find the device
+  if (( ptSimDev = FindSimDevice( ptDef, ptXfrCtl->nDevAddr, &nIndex )) == NULL )
+  {
+    // no device at this address
+    eError = I2C_ERROR_SLVNAK;
+  }
+  else
+  {
+    // determine the register pointer
+    if ( ptXfrCtl->nAddrLen != 0 )
+    {
+      uRegister = ptXfrCtl->tAddress.uValue;
+    }
+    else
+    {
+      uRegister = ( nIndex == ptCtl->nSimIndex ) ? ptCtl->wSimRegister : 0;
+    }
+
+    // check for room
+    if (( uRegister + ptXfrCtl->wDataLen ) > ptSimDev->wNumRegisters )
+    {
+      // device would NAK past the end of its register file
+      eError = I2C_ERROR_SLVNAK;
+    }
+    else
+    {
+      // copy the data
+      if ( bRead )
+      {
+        memcpy( ptXfrCtl->pnData, &ptSimDev->pnRegisters[ uRegister ], ptXfrCtl->wDataLen );
+      }
+      else
+      {
+        memcpy( &ptSimDev->pnRegisters[ uRegister ], ptXfrCtl->pnData, ptXfrCtl->wDataLen );
+      }
+
+      // update the register pointer
+      ptCtl->nSimIndex = nIndex;
+      ptCtl->wSimRegister = ( U16 )( uRegister + ptXfrCtl->wDataLen );
+    }
+  }
+
+  // update the statistics
+  ptCtl->tStats.uTransfers++;
+  ptCtl->tStats.uBytes += ptXfrCtl->nAddrLen + ptXfrCtl->wDataLen;
+  if ( eError != I2C_ERROR_NONE )
+  {
+    ptCtl->tStats.uErrors++;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FindSimDevice
+ *
+ * @brief find a simulated device
+ *
+ * This function will search the simulated devices for an address
+ *
+ * @param[in]   ptDef       pointer to the definition
+ * @param[in]   nDevAddr    device address
+ * @param[io]   pnIndex     pointer to store the device index
+ *
+ * @return      pointer to the device or NULL if not found
+ *
+ *****************************************************************************/
+static PI2CSIMDEV FindSimDevice( PI2CDEF ptDef, U8 nDevAddr, PU8 pnIndex )
+{
+  PI2CSIMDEV  ptSimDev = NULL;
+  U8          nIndex;
+
+  // search the table
+  for ( nIndex = 0; nIndex < ptDef->nNumSimDevs; nIndex++ )
+  {
+    if ( ptDef->ptSimDevs[ nIndex ].nDevAddr == nDevAddr )
+    {
+      // found it
+      ptSimDev = &ptDef->ptSimDevs[ nIndex ];
+      *pnIndex = nIndex;
+      break;
+    }
+  }
+
+  // return the device
+  return( ptSimDev );
+}
+
+/******************************************************************************
+ * @function LoadAddress
+ *
+ * @brief load the address bytes
+ *
+ * This function will copy the address into the local buffer, MSB first
+ *
+ * @param[in]   ptXfrCtl    pointer to the transfer control
+ *
+ * @return      the number of address bytes
+ *
+ *****************************************************************************/
+static U8 LoadAddress( PI2CXFRCTL ptXfrCtl )
+{
+  U8  nIndex;
+
+  // copy the address bytes
+  for ( nIndex = 0; nIndex < ptXfrCtl->nAddrLen; nIndex++ )
+  {
+    anLclBuffer[ nIndex ] = ptXfrCtl->tAddress.anValue[ ptXfrCtl->nAddrLen - nIndex - 1 ];
+  }
+
+  // return the length
+  return( ptXfrCtl->nAddrLen );
+}
+
+/******************************************************************************
+ * @function MapErrno
+ *
+ * @brief map an i2c-dev error
+ *
+ * This function will convert the errno from a failed transfer
+ *
+ * @param[in]   iError      errno value
+ *
+ * @return      appropriate error value
+ *
+ *****************************************************************************/
+static I2CERR MapErrno( int iError )
+{
+  I2CERR  eError;
+
+  // map the error
+  switch( iError )
+  {
+    case ENXIO :
+    case EREMOTEIO :
+      eError = I2C_ERROR_SLVNAK;
+      break;
+
+    case ETIMEDOUT :
+      eError = I2C_ERROR_TIMEOUT;
+      break;
+
+    case EAGAIN :
+      eError = I2C_ERROR_ARBLOST;
+      break;
+
+    case EBUSY :
+      eError = I2C_ERROR_BUSBUSY;
+      break;
+
+    case EINVAL :
+      eError = I2C_ERROR_ILLPRM;
+      break;
+
+    default :
+      eError = I2C_ERROR_BUSFAULT;
+      break;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/**@} EOF I2c.c */
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * @file I2c_def.h
+ *
+ * @brief I2C definition declarations
+ *
+ * This file provides the definition declarations for the Linux I2C devices
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2C
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _I2C_DEF_H
+#define _I2C_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the helper macro for creating an i2c-dev adapter
+#define I2C_DEVICE_LINUX( name ) \
+  { \
+    .eBackend = I2C_BACKEND_LINUX, \
+    .pszDevName = name, \
+    .ptSimDevs = NULL, \
+    .nNumSimDevs = 0 \
+  }
+
+/// define the helper macro for creating a simulated bus
+#define I2C_DEVICE_SIM( simdevs ) \
+  { \
+    .eBackend = I2C_BACKEND_SIM, \
+    .pszDevName = NULL, \
+    .ptSimDevs = ( PI2CSIMDEV )simdevs, \
+    .nNumSimDevs = sizeof( simdevs ) / I2CSIMDEV_SIZE \
+  }
+
+/// define the helper macro for creating a simulated register file device
+#define I2C_SIMDEV( addr, regs ) \
+  { \
+    .nDevAddr = addr, \
+    .pnRegisters = regs, \
+    .wNumRegisters = sizeof( regs ) \
+  }
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the backends
+typedef enum _I2CBACKEND
+{
+  I2C_BACKEND_LINUX = 0,    ///< /dev/i2c-N adapter
+  I2C_BACKEND_SIM,          ///< simulated register file devices
+  I2C_BACKEND_MAX
+} I2CBACKEND;
+
+// structures -----------------------------------------------------------------
+/// define the simulated device structure
+typedef struct _I2CSIMDEV
+{
+  U8                nDevAddr;       ///< device address
+  PU8               pnRegisters;    ///< pointer to the register file
+  U16               wNumRegisters;  ///< size of the register file
+} I2CSIMDEV, *PI2CSIMDEV;
+#define I2CSIMDEV_SIZE  sizeof( I2CSIMDEV )
+
+/// define the I2C definition structure
+typedef struct _I2CDEF
+{
+  I2CBACKEND        eBackend;       ///< backend
+  PC8               pszDevName;     ///< adapter name
+  PI2CSIMDEV        ptSimDevs;      ///< pointer to the simulated devices
+  U8                nNumSimDevs;    ///< number of simulated devices
+} I2CDEF, *PI2CDEF;
+#define I2CDEF_SIZE     sizeof( I2CDEF )
+
+/**@} EOF I2c_def.h */
+
+#endif  // _I2C_DEF_H
@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file Spi_cfg.c
+ *
+ * @brief SPI configuration implementation
+ *
+ * This file provides the device table for the Linux SPI devices
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SPI
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SPI/Spi_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+/// device configuration table
+const SPIDEF atSpiDefs[ SPI_DEV_ENUM_MAX ] =
+{
+  // SPI_DEVICE_LINUX( name, clkpol, clkphase, speed )
+  // SPI_DEVICE_LOOPBACK( clkpol, clkphase, speed )
+};  
+
+/**@} EOF Spi_cfg.c */
@@ -0,0 +1,413 @@
+/******************************************************************************
+ * @file Spi.c
+ *
+ * @brief SPI implementation
+ *
+ * This file provides the implementation for the Linux SPI interface.  A
+ * spidev device drives the kernel driver with SPI_IOC_MESSAGE, and while
+ * the chip select is held each transfer is flagged with cs_change so the
+ * kernel leaves the chip select asserted between calls.  The loopback
+ * device returns the transmitted data and counts the traffic for host
+ * testing
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SPI
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+// local includes -------------------------------------------------------------
+#include "SPI/Spi.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the local fill buffer size
+#define LCL_BUF_SIZE                            ( 256 )
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the local control structure
+typedef struct _LCLCTL
+{
+  int             iFileDescriptor;    ///< handle
+  SPICLKPOL       eClkPol;            ///< current clock polarity
+  SPICLKPHASE     eClkPhase;          ///< current clock phase
+  U32             uSpeed;             ///< current speed
+  BOOL            bCsHeld;            ///< chip select is held
+  BOOL            bEnabled;           ///< device enabled
+  SPISTATS        tStats;             ///< statistics
+} LCLCTL, *PLCLCTL;
+#define LCLCTL_SIZE           sizeof( LCLCTL )
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  LCLCTL  atLclCtls[ SPI_DEV_ENUM_MAX ];
+static  U8      anFillBuffer[ LCL_BUF_SIZE ];
+
+// local function prototypes --------------------------------------------------
+static  SPIERR  Transfer( SPIDEVENUM eDev, PU8 pnXmt, PU8 pnRcv, U16 wSize );
+static  void    ApplyMode( SPIDEVENUM eDev );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function Spi_Initialize
+ *
+ * @brief SPI initialization
+ *
+ * This function will open each spidev device and set its mode and speed
+ *
+ *****************************************************************************/
+void Spi_Initialize( void )
+{
+  SPIDEVENUM  eDev;
+  PSPIDEF     ptDef;
+  PLCLCTL     ptCtl;
+
+  // for each device
+  for ( eDev = 0; eDev < SPI_DEV_ENUM_MAX; eDev++ )
+  {
+    // get pointers to the definition/control
+    ptDef = ( PSPIDEF )&atSpiDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // clear the control, set the defaults
+    memset( ptCtl, 0, LCLCTL_SIZE );
+    ptCtl->iFileDescriptor = -1;
+    ptCtl->eClkPol = ptDef->eClkPol;
+    ptCtl->eClkPhase = ptDef->eClkPhase;
+    ptCtl->uSpeed = ptDef->uSpeed;
+    ptCtl->bEnabled = TRUE;
+
+    // open the device
+    if ( ptDef->eBackend == SPI_BACKEND_LINUX )
+    {
+      ptCtl->iFileDescriptor = open( ptDef->pszDevName, O_RDWR );
+    }
+
+    // apply the mode
+    ApplyMode( eDev );
+  }
+}
+
+/******************************************************************************
+ * @function Spi_Write
+ *
+ * @brief write a byte to the SPI
+ *
+ * This function will write a byte to the SPI
+ *
+ * @param[in]   eDev      SPI selection enumeration
+ * @param[in]   nData     data to write
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+SPIERR Spi_Write( SPIDEVENUM eDev, U8 nData )
+{
+  // transfer it
+  return( Transfer( eDev, &nData, NULL, 1 ));
+}
+
+/******************************************************************************
+ * @function Spi_Read
+ *
+ * @brief read a byte from the SPI
+ *
+ * This function will write a byte and return the byte read
+ *
+ * @param[in]   eDev        SPI selection enumeration
+ * @param[in]   nXmtData    data to write
+ * @param[io]   pnRcvData   pointer to the receive data
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+SPIERR Spi_Read( SPIDEVENUM eDev, U8 nXmtData, PU8 pnRcvData )
+{
+  // transfer it
+  return( Transfer( eDev, &nXmtData, pnRcvData, 1 ));
+}
+
+/******************************************************************************
+ * @function Spi_WriteBlock
+ *
+ * @brief write a block of data to the SPI
+ *
+ * This function will write a block of data, optionally storing the read
+ * data back into the buffer
+ *
+ * @param[in]   eDev        SPI selection enumeration
+ * @param[in]   pnBuffer    pointer to the buffer
+ * @param[in]   wSize       size of the block
+ * @param[in]   bStoreRead  TRUE to store the read data
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+SPIERR Spi_WriteBlock( SPIDEVENUM eDev, PU8 pnBuffer, U16 wSize, BOOL bStoreRead )
+{
+  // transfer it
+  return( Transfer( eDev, pnBuffer, ( bStoreRead ) ? pnBuffer : NULL, wSize ));
+}
+
+/******************************************************************************
+ * @function Spi_ReadBlock
+ *
+ * @brief read a block of data from the SPI
+ *
+ * This function will read a block of data while transmitting the fill byte
+ *
+ * @param[in]   eDev        SPI selection enumeration
+ * @param[in]   nOutData    fill data to write
+ * @param[in]   pnBuffer    pointer to the buffer
+ * @param[in]   wSize       size of the block
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+SPIERR Spi_ReadBlock( SPIDEVENUM eDev, U8 nOutData, PU8 pnBuffer, U16 wSize )
+{
+  SPIERR  eSpiErr = SPI_ERR_NONE;
+  U16     wChunk;
+
+  // fill the transmit buffer
+  memset( anFillBuffer, nOutData, LCL_BUF_SIZE );
+
+  // transfer in buffer sized chunks
+  while (( wSize != 0 ) && ( eSpiErr == SPI_ERR_NONE ))
+  {
+    wChunk = MIN( wSize, LCL_BUF_SIZE );
+    eSpiErr = Transfer( eDev, anFillBuffer, pnBuffer, wChunk );
+    pnBuffer += wChunk;
+    wSize -= wChunk;
+  }
+
+  // return the error
+  return( eSpiErr );
+}
+
+/******************************************************************************
+ * @function Spi_Ioctl
+ *
+ * @brief ioctl control of the SPI
+ *
+ * This function will modifiy the SPI according to the action
+ *
+ * @param[in]   eDev      SPI selection enumeration
+ * @param[in]   eAction   SPI IOCTL action
+ * @param[io]   pvValue   pointer to the passed value
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+SPIERR Spi_Ioctl( SPIDEVENUM eDev, SPIIOCTLACTIONS eAction, PVOID pvValue )
+{
+  SPIERR  eSpiErr = SPI_ERR_NONE;
+  PLCLCTL ptCtl;
+
+  // check for valid device
+  if ( eDev < SPI_DEV_ENUM_MAX )
+  {
+    // get the pointer to the control
+    ptCtl = &atLclCtls[ eDev ];
+
+    // determine action
+    switch( eAction )
+    {
+      case SPI_IOCTLACTIONS_SETPOL :
+        // set the polarity if changed
+        if ( ptCtl->eClkPol != ( SPICLKPOL )*(( PU32 )pvValue ))
+        {
+          ptCtl->eClkPol = ( SPICLKPOL )*(( PU32 )pvValue );
+          ApplyMode( eDev );
+        }
+        break;
+
+      case SPI_IOCTLACTIONS_SETPHA :
+        // set the phase if changed
+        if ( ptCtl->eClkPhase != ( SPICLKPHASE )*(( PU32 )pvValue ))
+        {
+          ptCtl->eClkPhase = ( SPICLKPHASE )*(( PU32 )pvValue );
+          ApplyMode( eDev );
+        }
+        break;
+
+      case SPI_IOCTLACTIONS_SETSPEED :
+        // set the speed if changed
+        if ( ptCtl->uSpeed != *(( PU32 )pvValue ))
+        {
+          ptCtl->uSpeed = *(( PU32 )pvValue );
+          ApplyMode( eDev );
+        }
+        break;
+
+      case SPI_IOCTLACTION_ENABLEDISABLE :
+        // set the enable state
+        ptCtl->bEnabled = ( *(( PU32 )pvValue ) != 0 ) ? TRUE : FALSE;
+        break;
+
+      case SPI_IOCTLACTIONS_CSASSERT :
+        // hold the chip select on the following transfers
+        ptCtl->bCsHeld = TRUE;
+        break;
+
+      case SPI_IOCTLACTIONS_CSRELEASE :
+        // clear the hold, and issue an empty transfer to drop the chip select
+        if ( ptCtl->bCsHeld )
+        {
+          ptCtl->bCsHeld = FALSE;
+          Transfer( eDev, NULL, NULL, 0 );
+        }
+        break;
+
+      case SPI_IOCTLACTIONS_GETSTATS :
+        // copy the statistics
+        memcpy( pvValue, &ptCtl->tStats, SPISTATS_SIZE );
+        break;
+
+      case SPI_IOCTLACTIONS_CLRSTATS :
+        // clear the statistics
+        memset( &ptCtl->tStats, 0, SPISTATS_SIZE );
+        break;
+
+      default :
+        eSpiErr = SPI_ERR_ILLACT;
+        break;
+    }
+  }
+  else
+  {
+    // set the error
+    eSpiErr = SPI_ERR_ILLDEV;
+  }
+
+  // return the error
+  return( eSpiErr ); 
+}
+
+/******************************************************************************
+ * @function Transfer
+ *
+ * @brief perform a full duplex transfer
+ *
+ * This function will perform the transfer on the selected backend
+ *
+ * @param[in]   eDev      SPI selection enumeration
+ * @param[in]   pnXmt     pointer to the transmit data, NULL for none
+ * @param[in]   pnRcv     pointer to the receive data, NULL to discard
+ * @param[in]   wSize     size of the transfer
+ *
+ * @return  error   appropriate error value
+ *
+ *****************************************************************************/
+static SPIERR Transfer( SPIDEVENUM eDev, PU8 pnXmt, PU8 pnRcv, U16 wSize )
+{
+  SPIERR                  eSpiErr = SPI_ERR_NONE;
+  PSPIDEF                 ptDef;
+  PLCLCTL                 ptCtl;
+  struct spi_ioc_transfer tXfer;
+
+  // check for valid device
+  if ( eDev < SPI_DEV_ENUM_MAX )
+  {
+    // get pointers to the definition/control
+    ptDef = ( PSPIDEF )&atSpiDefs[ eDev ];
+    ptCtl = &atLclCtls[ eDev ];
+
+    // check for enabled
+    if ( !ptCtl->bEnabled )
+    {
+      eSpiErr = SPI_ERR_ILLMODE;
+    }
+    else if ( ptDef->eBackend == SPI_BACKEND_LINUX )
+    {
+      // fill out the transfer
+      memset( &tXfer, 0, sizeof( tXfer ));
+      tXfer.tx_buf = ( unsigned long )pnXmt;
+      tXfer.rx_buf = ( unsigned long )pnRcv;
+      tXfer.len = wSize;
+      tXfer.speed_hz = ptCtl->uSpeed;
+      tXfer.bits_per_word = 8;
+      tXfer.cs_change = ( ptCtl->bCsHeld ) ? 1 : 0;
+
+      // do it
+      if (( ptCtl->iFileDescriptor == -1 ) || ( ioctl( ptCtl->iFileDescriptor, SPI_IOC_MESSAGE( 1 ), &tXfer ) < 0 ))
+      {
+        eSpiErr = SPI_ERR_COLLISION;
+      }
+    }
+    else if (( pnRcv != NULL ) && ( pnXmt != NULL ) && ( pnRcv != pnXmt ))
+    {
+      // loop the data back
+      memcpy( pnRcv, pnXmt, wSize );
+    }
+
+    // update the statistics
+    if ( wSize != 0 )
+    {
+      ptCtl->tStats.uTransfers++;
+      ptCtl->tStats.uBytes += wSize;
+    }
+  }
+  else
+  {
+    // set the error
+    eSpiErr = SPI_ERR_ILLDEV;
+  }
+
+  // return the error
+  return( eSpiErr );
+}
+
+/******************************************************************************
+ * @function ApplyMode
+ *
+ * @brief apply the mode/speed
+ *
+ * This function will set the clock mode and speed on the device
+ *
+ * @param[in]   eDev      SPI selection enumeration
+ *
+ *****************************************************************************/
+static void ApplyMode( SPIDEVENUM eDev )
+{
+  PLCLCTL ptCtl = &atLclCtls[ eDev ];
+  U8      nMode;
+
+  // build the mode
+  nMode = ( ptCtl->eClkPol == SPI_CLKPOL_FALLING ) ? SPI_CPOL : 0;
+  nMode |= ( ptCtl->eClkPhase == SPI_CLKPHASE_TRAILING ) ? SPI_CPHA : 0;
+
+  // set it on the device
+  if ( ptCtl->iFileDescriptor != -1 )
+  {
+    ioctl( ptCtl->iFileDescriptor, SPI_IOC_WR_MODE, &nMode );
+    ioctl( ptCtl->iFileDescriptor, SPI_IOC_WR_MAX_SPEED_HZ, &ptCtl->uSpeed );
+  }
+
+  // count it
+  ptCtl->tStats.uModeChanges++;
+}
+
+/**@} EOF Spi.c */
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * @file Spi.h
+ *
+ * @brief SPI declarations
+ *
+ * This file provides the declarations for the Linux SPI interface, which
+ * supports both spidev devices and a loopback mock for host testing
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SPI
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation, the kernel spi.h already uses _SPI_H
+#ifndef _SPI_LINUX_H
+#define _SPI_LINUX_H
+
+// system includes
+
+// local includes -------------------------------------------------------------
+#include "SPI/Spi_cfg.h"
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the SPI errors
+typedef enum _SPIERR
+{
+  SPI_ERR_NONE = 0,    ///< no error
+  SPI_ERR_ILLDEV,      ///, illegal device
+  SPI_ERR_ILLACT,      ///< illegal IOCTL action
+  SPI_ERR_ILLMODE,     ///< illegal mode
+  SPI_ERR_BUFFAIL,     ///< no room for buffer
+  SPI_ERR_COLLISION,   ///< bus collision
+} SPIERR;
+
+/// enumerate the IOCTL actions
+typedef enum _SPIIOCTLACTIONS
+{
+  SPI_IOCTLACTIONS_SETPOL = 0,
+  SPI_IOCTLACTIONS_SETPHA,
+  SPI_IOCTLACTIONS_SETSPEED,
+  SPI_IOCTLACTION_ENABLEDISABLE,
+  SPI_IOCTLACTIONS_CSASSERT,      ///< hold chip select across transfers
+  SPI_IOCTLACTIONS_CSRELEASE,     ///< release chip select
+  SPI_IOCTLACTIONS_GETSTATS,      ///< get the statistics
+  SPI_IOCTLACTIONS_CLRSTATS,      ///< clear the statistics
+  SPI_IOCTLACTIONS_MAX
+} SPIIOCTLACTIONS;
+
+// structures -----------------------------------------------------------------
+/// define the statistics structure
+typedef struct _SPISTATS
+{
+  U32   uTransfers;         ///< number of transfers
+  U32   uBytes;             ///< number of bytes
+  U32   uModeChanges;       ///< number of clock/mode/speed changes
+} SPISTATS, *PSPISTATS;
+#define SPISTATS_SIZE         sizeof( SPISTATS )
+
+// global function prototypes --------------------------------------------------
+extern  void    Spi_Initialize( void );
+extern  SPIERR  Spi_Write( SPIDEVENUM eDev, U8 nData );
+extern  SPIERR  Spi_Read( SPIDEVENUM eDev, U8 nXmtData, PU8 pnRcvData );
+extern  SPIERR  Spi_WriteBlock( SPIDEVENUM eDev, PU8 pnBuffer, U16 wSize, BOOL bStoreRead );
+extern  SPIERR  Spi_ReadBlock( SPIDEVENUM eDev, U8 nOutData, PU8 pnBuffer, U16 wSize );
+extern  SPIERR  Spi_Ioctl( SPIDEVENUM eDev, SPIIOCTLACTIONS eAction, PVOID pvValue );
+
+/**@} EOF Spi.h */
+
+#endif  // _SPI_LINUX_H
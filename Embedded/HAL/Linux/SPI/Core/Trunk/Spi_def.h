@@ -0,0 +1,95 @@
+/******************************************************************************
+ * @file Spi_def.h
+ *
+ * @brief SPI definition declarations
+ *
+ * This file provides the definition declarations for the Linux SPI devices
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SPI
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _SPI_DEF_H
+#define _SPI_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the helper macro for creating a spidev device
+#define SPI_DEVICE_LINUX( name, clkpol, clkphase, speed ) \
+  { \
+    .eBackend       = SPI_BACKEND_LINUX, \
+    .pszDevName     = name, \
+    .eClkPol        = clkpol, \
+    .eClkPhase      = clkphase, \
+    .uSpeed         = speed \
+  }
+
+/// define the helper macro for creating a loopback device
+#define SPI_DEVICE_LOOPBACK( clkpol, clkphase, speed ) \
+  { \
+    .eBackend       = SPI_BACKEND_LOOPBACK, \
+    .pszDevName     = NULL, \
+    .eClkPol        = clkpol, \
+    .eClkPhase      = clkphase, \
+    .uSpeed         = speed \
+  }
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the backends
+typedef enum _SPIBACKEND
+{
+  SPI_BACKEND_LINUX = 0,    ///< spidev device
+  SPI_BACKEND_LOOPBACK,     ///< MOSI looped back to MISO
+  SPI_BACKEND_MAX
+} SPIBACKEND;
+
+/// enumerate the clock polarity
+typedef enum _SPICLKPOL
+{
+  SPI_CLKPOL_RISING = 0,
+  SPI_CLKPOL_FALLING,
+  SPI_CLKPOL_MAX
+} SPICLKPOL;
+
+/// enumerate the clock phase
+typedef enum _SPICLKPHASE
+{
+  SPI_CLKPHASE_LEADING = 0,
+  SPI_CLKPHASE_TRAILING,
+  SPI_CLKPHASE_MAX
+} SPICLKPHASE;
+
+// structures -----------------------------------------------------------------
+/// define the structure to define a SPI device
+typedef struct _SPIDEF
+{
+  SPIBACKEND    eBackend;       ///< backend
+  PC8           pszDevName;     ///< spidev name
+  SPICLKPOL     eClkPol;        ///< clock polarity
+  SPICLKPHASE   eClkPhase;      ///< clock phase
+  U32           uSpeed;         ///< clock speed in HZ
+} SPIDEF, *PSPIDEF;
+#define SPIDEF_SIZE        sizeof( SPIDEF )
+
+/**@} EOF Spi_def.h */
+
+#endif  // _SPI_DEF_H
@@ -32,6 +32,9 @@
 #include "RTCManager/RTCManager.h"
 #include "SensorManager/SensorManager.h"
 #include "SerialNumber/SerialNumber.h"
+#if ( MQTTCONNECTMNGR_ENABLE_TELEMETRY == ON )
+  #include "MQTTTelemetryManager/MQTTTelemetryManager.h"
+#endif // MQTTCONNECTMNGR_ENABLE_TELEMETRY
 
 /////////////////////////////////////////////////
 // FOR DEBUG ONLY
@@ -141,6 +144,11 @@ BOOL MQTTConnectionManager_Initialize( void )
   // clear the connected state
   bConnected = FALSE;
 
+  #if ( MQTTCONNECTMNGR_ENABLE_TELEMETRY == ON )
+  // initialize the telemetry batching
+  MQTTTelemetryManager_Initialize( );
+  #endif // MQTTCONNECTMNGR_ENABLE_TELEMETRY
+
   // return the status
   return( FALSE );
 }
@@ -390,9 +398,14 @@ DebugManager_AddElement( 0x4100, xArg );
 BOOL MQTTConnectionManager_ProcessPubEvent( TASKARG xArg )
 {
   MQTTString  tTopic = MQTTString_initializer;
+  int         iLength, iResult;
+  #if ( MQTTCONNECTMNGR_ENABLE_TELEMETRY == ON )
+  PU8         pnPayload;
+  U16         wPayloadLength;
+  #else
   FLOAT       fBatVolt, fEvnTemp, fEvnHumd, fEvnPres;
   DATETIME    tDateTime;
-  int         iLength, iResult;
+  #endif // MQTTCONNECTMNGR_ENABLE_TELEMETRY
 
 /////////////////////////////////////////////////
 // FOR DEBUG ONLY
@@ -405,6 +418,16 @@ DebugManager_AddElement( 0x4200, xArg );
       // timeout ocurred
       tTopic.cstring = tConfigActl.acTopicString;
 
+      #if ( MQTTCONNECTMNGR_ENABLE_TELEMETRY == ON )
+      // add a sample, only publish when the batch is full
+      if (( MQTTTelemetryManager_Sample( ) != MQTTTELEM_STS_READY ) || ( MQTTTelemetryManager_GetPayload( &pnPayload, &wPayloadLength )))
+      {
+        break;
+      }
+
+      // serialize it
+      iLength = MQTTSerialize_publish( anBuffer, MQTT_BUFFER_SIZE, 0, 0, 0, 0, tTopic, pnPayload, wPayloadLength );
+      #else
       // get the values
       SensorManager_GetValue( SENMAN_ENUM_BATVOLT, &fBatVolt );
       //SensorManager_GetValue( SENMAN_ENUM_ENVTEMP, &fEvnTemp );
@@ -422,6 +445,7 @@ DebugManager_AddElement( 0x4200, xArg );
 
       // serialize it
       iLength = MQTTSerialize_publish( anBuffer, MQTT_BUFFER_SIZE, 0, 0, 0, 0, tTopic, anTopicPayload, iLength );
+      #endif // MQTTCONNECTMNGR_ENABLE_TELEMETRY
 
       // send it
       if (( iResult != transport_sendPacketBuffer( iTransportSocket, anBuffer, iLength )) == iLength )
@@ -44,6 +44,10 @@
 /// define the number of events
 #define MQTTCONNECTMGR_PUBNUM_EVENTS            ( 2 )
 
+/// define the macro to enable the batched telemetry payloads, when enabled the
+/// publish rate becomes the sample rate
+#define MQTTCONNECTMNGR_ENABLE_TELEMETRY        ( OFF )
+
 /// define the user name/password max length
 #define USER_NAME_MAXLEN                        ( 32 )
 #define USER_PSWD_MAXLEN                        ( 32 )
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager_cfg.c
+ *
+ * @brief MQTT telemetry manager configuration implementation
+ *
+ * This file provides the channel table for the MQTT telemetry manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+#include "SensorManager/SensorManager.h"
+#include "SystemMonitor/SystemMonitor.h"
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+/// instantiate the channel table, the order here is the order of the values
+/// in each encoded sample
+const CODE MQTTTELEMCHNDEF  g_atMqttTelemChnDefs[ MQTTTELEM_CHN_ENUM_MAX ] =
+{
+  // add entries here using one of the macros provided
+  // MQTTTELEMSENMANDEFM( senenum, scale )
+  // MQTTTELEMSYSMONDEFM( sysenum, scale )
+};
+
+/**@} EOF MQTTTelemetryManager_cfg.c */
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager_cfg.h
+ *
+ * @brief MQTT telemetry manager configuration declarations
+ *
+ * This file provides the configuration declarations for the MQTT telemetry
+ * manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _MQTTTELEMETRYMANAGER_CFG_H
+#define _MQTTTELEMETRYMANAGER_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the telemetry channels
+typedef enum _MQTTTELEMCHNENUM
+{
+  // enumerate user defined channels here
+
+  // do not remove the below entries
+  MQTTTELEM_CHN_ENUM_MAX
+} MQTTTELEMCHNENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE MQTTTELEMCHNDEF  g_atMqttTelemChnDefs[ ];
+
+// global function prototypes --------------------------------------------------
+
+/**@} EOF MQTTTelemetryManager_cfg.h */
+
+#endif  // _MQTTTELEMETRYMANAGER_CFG_H
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager_prm.h
+ *
+ * @brief MQTT telemetry manager parameter declarations
+ *
+ * This file declares any customization for the MQTT telemetry manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _MQTTTELEMETRYMANAGER_PRM_H
+#define _MQTTTELEMETRYMANAGER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of samples that are batched into a single publish
+#define MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH      ( 10 )
+
+/// define the macro to enable the zstd compression stage
+#define MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION       ( OFF )
+
+/// define the compression level and window log ( 10 is the smallest window allowed )
+#define MQTTTELEMETRYMANAGER_COMPRESSION_LEVEL        ( 1 )
+#define MQTTTELEMETRYMANAGER_COMPRESSION_WINDOWLOG    ( 10 )
+
+/// define the size of the static compression workspace
+#define MQTTTELEMETRYMANAGER_COMPRESSION_WORKSIZE     ( 40 * 1024 )
+
+/**@} EOF MQTTTelemetryManager_prm.h */
+
+#endif  // _MQTTTELEMETRYMANAGER_PRM_H
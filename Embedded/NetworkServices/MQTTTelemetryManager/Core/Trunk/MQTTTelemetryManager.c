@@ -0,0 +1,377 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager.c
+ *
+ * @brief MQTT telemetry manager implementation
+ *
+ * This file provides the implementation for the MQTT telemetry manager.  The
+ * configured channels are sampled, encoded with nanopb into a static arena
+ * as a TelemetryBatch ( see MQTTTelemetry.proto ) and handed to the
+ * connection manager once enough samples have been collected
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager.h"
+
+// library includes -----------------------------------------------------------
+#include "NanoProtoBuf/pb_encode.h"
+#include "RTCManager/RTCManager.h"
+#include "SensorManager/SensorManager.h"
+#include "SystemMonitor/SystemMonitor.h"
+#include "TimeHandler/TimeHandler.h"
+#if ( MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION == ON )
+  #define ZSTD_STATIC_LINKING_ONLY
+  #include "Ztp/zstd.h"
+#endif // MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION
+
+// Macros and Defines ---------------------------------------------------------
+/// define the field numbers, these must match MQTTTelemetry.proto
+#define FIELD_BATCH_BASETIME                    ( 1 )
+#define FIELD_BATCH_CHANNELCOUNT                ( 2 )
+#define FIELD_BATCH_SAMPLES                     ( 3 )
+#define FIELD_SAMPLE_TIMEDELTA                  ( 1 )
+#define FIELD_SAMPLE_VALUES                     ( 2 )
+
+/// define the worst case sizes, tag + varint for each field
+#define BATCH_HEADER_MAXSIZE                    ( 2 * ( 1 + 5 ))
+#define SAMPLE_VALUES_MAXSIZE                   ( MQTTTELEM_CHN_ENUM_MAX * 5 )
+#define SAMPLE_MAXSIZE                          ( 1 + 2 + ( 1 + 5 ) + ( 1 + 2 ) + SAMPLE_VALUES_MAXSIZE )
+
+/// define the arena size, sized so a full batch can never overflow
+#define ARENA_SIZE                              ( BATCH_HEADER_MAXSIZE + ( MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH * SAMPLE_MAXSIZE ))
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// ensure at least one channel is configured, the channel count is an
+/// enumeration so it can not be checked with #if, a negative size fails here
+typedef U8  MQTTTELEMNOCHANNELS[ ( MQTTTELEM_CHN_ENUM_MAX > 0 ) ? 1 : -1 ];
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  U8            anArena[ ARENA_SIZE ];
+static  pb_ostream_t  tArenaStream;
+static  U16           wSampleCount;
+static  U32           uLastTime;
+static  S32           alLastValues[ MQTTTELEM_CHN_ENUM_MAX ];
+#if ( MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION == ON )
+static  U8            anCompBuffer[ ZSTD_COMPRESSBOUND( ARENA_SIZE ) ];
+static  U8            anCompWorkspace[ MQTTTELEMETRYMANAGER_COMPRESSION_WORKSIZE ] ALIGNED8;
+static  ZSTD_CCtx*    ptCompCtx;
+#endif // MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION
+
+// local function prototypes --------------------------------------------------
+static  S32   GetChannelValue( MQTTTELEMCHNENUM eChannel, S32 lPrevious );
+static  BOOL  EncodeSample( pb_ostream_t* ptStream, U32 uTimeDelta, PS32 plValues );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function MQTTTelemetryManager_Initialize
+ *
+ * @brief initialization
+ *
+ * This function will initialize the telemetry manager
+ *
+ * @return TRUE if errors detected, FALSE if not
+ *
+ *****************************************************************************/
+BOOL MQTTTelemetryManager_Initialize( void )
+{
+  BOOL bStatus = FALSE;
+
+  // reset the batch
+  MQTTTelemetryManager_Reset( );
+
+  #if ( MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION == ON )
+  // create the compression context in the static workspace
+  if (( ptCompCtx = ZSTD_initStaticCCtx( anCompWorkspace, MQTTTELEMETRYMANAGER_COMPRESSION_WORKSIZE )) != NULL )
+  {
+    // set the level and keep the window small
+    ZSTD_CCtx_setParameter( ptCompCtx, ZSTD_c_compressionLevel, MQTTTELEMETRYMANAGER_COMPRESSION_LEVEL );
+    ZSTD_CCtx_setParameter( ptCompCtx, ZSTD_c_windowLog, MQTTTELEMETRYMANAGER_COMPRESSION_WINDOWLOG );
+  }
+  else
+  {
+    // flag the error, payloads will be sent uncompressed
+    bStatus = TRUE;
+  }
+  #endif // MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function MQTTTelemetryManager_Sample
+ *
+ * @brief sample the channels
+ *
+ * This function will sample every configured channel and append the encoded
+ * sample to the current batch
+ *
+ * @return      the sample status
+ *
+ *****************************************************************************/
+MQTTTELEMSTS MQTTTelemetryManager_Sample( void )
+{
+  MQTTTELEMSTS      eStatus = MQTTTELEM_STS_NONE;
+  DATETIME          tDateTime;
+  U32               uTime;
+  S32               alDeltas[ MQTTTELEM_CHN_ENUM_MAX ];
+  S32               lValue;
+  MQTTTELEMCHNENUM  eChannel;
+  pb_ostream_t      tSizing = PB_OSTREAM_SIZING;
+  BOOL              bOk;
+
+  // get the current time
+  RTCManager_GetDateTime( &tDateTime );
+  uTime = ( U32 )TimeHandler_TimeToHuge( TIME_OS_UNIX, &tDateTime );
+
+  // check for a full batch that was never collected, start over
+  if ( wSampleCount >= MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH )
+  {
+    MQTTTelemetryManager_Reset( );
+  }
+
+  // check for the start of a batch
+  bOk = TRUE;
+  if ( wSampleCount == 0 )
+  {
+    // rewind the arena
+    tArenaStream = pb_ostream_from_buffer( anArena, ARENA_SIZE );
+    uLastTime = uTime;
+
+    // encode the batch header
+    bOk  = pb_encode_tag( &tArenaStream, PB_WT_VARINT, FIELD_BATCH_BASETIME );
+    bOk &= pb_encode_varint( &tArenaStream, uTime );
+    bOk &= pb_encode_tag( &tArenaStream, PB_WT_VARINT, FIELD_BATCH_CHANNELCOUNT );
+    bOk &= pb_encode_varint( &tArenaStream, MQTTTELEM_CHN_ENUM_MAX );
+  }
+
+  // get each value and delta it against the previous sample, the first
+  // sample carries absolute values, a failed read repeats the last value
+  for ( eChannel = 0; eChannel < MQTTTELEM_CHN_ENUM_MAX; eChannel++ )
+  {
+    lValue = GetChannelValue( eChannel, alLastValues[ eChannel ] );
+    alDeltas[ eChannel ] = ( wSampleCount == 0 ) ? lValue : lValue - alLastValues[ eChannel ];
+    alLastValues[ eChannel ] = lValue;
+  }
+
+  // size the sample, then encode it as a length delimited submessage
+  bOk &= EncodeSample( &tSizing, uTime - uLastTime, alDeltas );
+  bOk &= pb_encode_tag( &tArenaStream, PB_WT_STRING, FIELD_BATCH_SAMPLES );
+  bOk &= pb_encode_varint( &tArenaStream, tSizing.bytes_written );
+  bOk &= EncodeSample( &tArenaStream, uTime - uLastTime, alDeltas );
+  uLastTime = uTime;
+
+  // check for errors
+  if ( bOk )
+  {
+    // increment the count/check for ready
+    if ( ++wSampleCount >= MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH )
+    {
+      // set the status
+      eStatus = MQTTTELEM_STS_READY;
+    }
+  }
+  else
+  {
+    // drop the batch
+    MQTTTelemetryManager_Reset( );
+    eStatus = MQTTTELEM_STS_ERROR;
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function MQTTTelemetryManager_GetPayload
+ *
+ * @brief get the batch payload
+ *
+ * This function will close the current batch and return a pointer to the
+ * payload, compressing it if enabled and smaller.  The payload remains valid
+ * until the next call to sample
+ *
+ * @param[io]   ppnPayload    pointer to store the payload pointer
+ * @param[io]   pwLength      pointer to store the payload length
+ *
+ * @return      TRUE if no samples available, FALSE otherwise
+ *
+ *****************************************************************************/
+BOOL MQTTTelemetryManager_GetPayload( PU8* ppnPayload, PU16 pwLength )
+{
+  BOOL    bStatus = TRUE;
+  #if ( MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION == ON )
+  size_t  tCompLength;
+  #endif // MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION
+
+  // check for samples
+  if ( wSampleCount != 0 )
+  {
+    // default to the raw arena
+    *( ppnPayload ) = anArena;
+    *( pwLength ) = ( U16 )tArenaStream.bytes_written;
+
+    #if ( MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION == ON )
+    // compress it, only use it if it helps
+    if ( ptCompCtx != NULL )
+    {
+      tCompLength = ZSTD_compress2( ptCompCtx, anCompBuffer, sizeof( anCompBuffer ), anArena, tArenaStream.bytes_written );
+      if (( !ZSTD_isError( tCompLength )) && ( tCompLength < tArenaStream.bytes_written ))
+      {
+        // use the compressed buffer
+        *( ppnPayload ) = anCompBuffer;
+        *( pwLength ) = ( U16 )tCompLength;
+      }
+    }
+    #endif // MQTTTELEMETRYMANAGER_ENABLE_COMPRESSION
+
+    // batch is closed, next sample starts a new one
+    wSampleCount = 0;
+    bStatus = FALSE;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function MQTTTelemetryManager_Reset
+ *
+ * @brief reset the batch
+ *
+ * This function will discard any samples in the current batch
+ *
+ *****************************************************************************/
+void MQTTTelemetryManager_Reset( void )
+{
+  // clear the count, arena is rewound on the next sample
+  wSampleCount = 0;
+}
+
+/******************************************************************************
+ * @function GetChannelValue
+ *
+ * @brief get a channel value
+ *
+ * This function will get the value for a channel as a scaled integer
+ *
+ * @param[in]   eChannel    channel enumeration
+ * @param[in]   lPrevious   previous value, returned if the read fails
+ *
+ * @return      the channel value
+ *
+ *****************************************************************************/
+static S32 GetChannelValue( MQTTTELEMCHNENUM eChannel, S32 lPrevious )
+{
+  S32               lValue = lPrevious;
+  PMQTTTELEMCHNDEF  ptDef;
+  FLOAT             fScale;
+  SENMANARG         xSenValue;
+  SYSMONENTTYPE     eEntType;
+  U32UN             tValue;
+
+  // get the definition
+  ptDef = ( PMQTTTELEMCHNDEF )&g_atMqttTelemChnDefs[ eChannel ];
+  fScale = PGM_RDDWRD( ptDef->fScale );
+
+  // determine the source
+  switch( PGM_RDBYTE( ptDef->eSource ))
+  {
+    case MQTTTELEM_SOURCE_SENMAN :
+      if ( SensorManager_GetValue(( SENMANENUM )PGM_RDBYTE( ptDef->nEnum ), &xSenValue ) == SENMAN_ERROR_NONE )
+      {
+        #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+        lValue = ( S32 )ROUND( xSenValue * fScale );
+        #else
+        lValue = ( S32 )xSenValue;
+        #endif // SENSORMANAGER_ARGUMENT_TYPE
+      }
+      break;
+
+    case MQTTTELEM_SOURCE_SYSMON :
+      if ( !SystemMonitor_GetEntryValue(( SYSMONENUM )PGM_RDBYTE( ptDef->nEnum ), &eEntType, &tValue ))
+      {
+        // scale floats, integers are sent as is
+        if (( eEntType == SYSMON_ENTTYPE_FLOAT ) || ( eEntType == SYSMON_ENTTYPE_OPT_FLOAT ))
+        {
+          lValue = ( S32 )ROUND( tValue.fValue * fScale );
+        }
+        else
+        {
+          lValue = tValue.lValue;
+        }
+      }
+      break;
+
+    default :
+      break;
+  }
+
+  // return the value
+  return( lValue );
+}
+
+/******************************************************************************
+ * @function EncodeSample
+ *
+ * @brief encode a sample
+ *
+ * This function will encode the body of a TelemetrySample message
+ *
+ * @param[in]   ptStream      pointer to the output stream
+ * @param[in]   uTimeDelta    time since the previous sample
+ * @param[in]   plValues      pointer to the channel values
+ *
+ * @return      TRUE if encoded, FALSE on stream error
+ *
+ *****************************************************************************/
+static BOOL EncodeSample( pb_ostream_t* ptStream, U32 uTimeDelta, PS32 plValues )
+{
+  BOOL              bOk;
+  pb_ostream_t      tSizing = PB_OSTREAM_SIZING;
+  MQTTTELEMCHNENUM  eChannel;
+
+  // encode the time delta
+  bOk  = pb_encode_tag( ptStream, PB_WT_VARINT, FIELD_SAMPLE_TIMEDELTA );
+  bOk &= pb_encode_varint( ptStream, uTimeDelta );
+
+  // size the packed values
+  for ( eChannel = 0; eChannel < MQTTTELEM_CHN_ENUM_MAX; eChannel++ )
+  {
+    pb_encode_svarint( &tSizing, plValues[ eChannel ] );
+  }
+
+  // encode the packed values
+  bOk &= pb_encode_tag( ptStream, PB_WT_STRING, FIELD_SAMPLE_VALUES );
+  bOk &= pb_encode_varint( ptStream, tSizing.bytes_written );
+  for ( eChannel = 0; eChannel < MQTTTELEM_CHN_ENUM_MAX; eChannel++ )
+  {
+    bOk &= pb_encode_svarint( ptStream, plValues[ eChannel ] );
+  }
+
+  // return the status
+  return( bOk );
+}
+
+/**@} EOF MQTTTelemetryManager.c */
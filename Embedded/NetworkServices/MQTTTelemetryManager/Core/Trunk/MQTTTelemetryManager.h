@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager.h
+ *
+ * @brief MQTT telemetry manager declarations
+ *
+ * This file provides the declarations for the MQTT telemetry manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _MQTTTELEMETRYMANAGER_H
+#define _MQTTTELEMETRYMANAGER_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the sample status
+typedef enum _MQTTTELEMSTS
+{
+  MQTTTELEM_STS_NONE = 0,         ///< sample added
+  MQTTTELEM_STS_READY,            ///< sample added, batch is ready to publish
+  MQTTTELEM_STS_ERROR,            ///< encode error
+} MQTTTELEMSTS;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  BOOL          MQTTTelemetryManager_Initialize( void );
+extern  MQTTTELEMSTS  MQTTTelemetryManager_Sample( void );
+extern  BOOL          MQTTTelemetryManager_GetPayload( PU8* ppnPayload, PU16 pwLength );
+extern  void          MQTTTelemetryManager_Reset( void );
+
+/**@} EOF MQTTTelemetryManager.h */
+
+#endif  // _MQTTTELEMETRYMANAGER_H
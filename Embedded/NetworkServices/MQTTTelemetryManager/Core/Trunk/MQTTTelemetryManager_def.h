@@ -0,0 +1,75 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager_def.h
+ *
+ * @brief MQTT telemetry manager definition declarations
+ *
+ * This file provides the definition declarations for the MQTT telemetry
+ * manager channel table
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _MQTTTELEMETRYMANAGER_DEF_H
+#define _MQTTTELEMETRYMANAGER_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager_prm.h"
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the helper macro for a sensor manager channel
+#define MQTTTELEMSENMANDEFM( senenum, scale ) \
+  { \
+    .eSource  = MQTTTELEM_SOURCE_SENMAN, \
+    .nEnum    = senenum, \
+    .fScale   = scale, \
+  }
+
+/// define the helper macro for a system monitor channel
+#define MQTTTELEMSYSMONDEFM( sysenum, scale ) \
+  { \
+    .eSource  = MQTTTELEM_SOURCE_SYSMON, \
+    .nEnum    = sysenum, \
+    .fScale   = scale, \
+  }
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the channel sources
+typedef enum _MQTTTELEMSOURCE
+{
+  MQTTTELEM_SOURCE_SENMAN = 0,    ///< sensor manager value
+  MQTTTELEM_SOURCE_SYSMON,        ///< system monitor value
+  MQTTTELEM_SOURCE_MAX
+} MQTTTELEMSOURCE;
+
+// structures -----------------------------------------------------------------
+/// define the channel definition structure
+typedef struct _MQTTTELEMCHNDEF
+{
+  MQTTTELEMSOURCE eSource;        ///< value source
+  U8              nEnum;          ///< sensor manager/system monitor enumeration
+  FLOAT           fScale;         ///< scale applied to floating point values
+} MQTTTELEMCHNDEF, *PMQTTTELEMCHNDEF;
+#define MQTTTELEMCHNDEF_SIZE                    sizeof( MQTTTELEMCHNDEF )
+
+/**@} EOF MQTTTelemetryManager_def.h */
+
+#endif  // _MQTTTELEMETRYMANAGER_DEF_H
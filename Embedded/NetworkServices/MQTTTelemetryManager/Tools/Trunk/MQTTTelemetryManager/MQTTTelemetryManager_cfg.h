@@ -0,0 +1,61 @@
+/******************************************************************************
+ * @file MQTTTelemetryManager_cfg.h
+ *
+ * @brief MQTT telemetry manager payload test configuration declarations
+ *
+ * This file provides the configuration declarations for the payload test,
+ * two sensor manager and two system monitor channels
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _MQTTTELEMETRYMANAGER_CFG_H
+#define _MQTTTELEMETRYMANAGER_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the telemetry channels
+typedef enum _MQTTTELEMCHNENUM
+{
+  // enumerate user defined channels here
+  MQTTTELEM_CHN_ENUM_TEMP = 0,
+  MQTTTELEM_CHN_ENUM_HUMIDITY,
+  MQTTTELEM_CHN_ENUM_VOLTAGE,
+  MQTTTELEM_CHN_ENUM_COUNTER,
+
+  // do not remove the below entries
+  MQTTTELEM_CHN_ENUM_MAX
+} MQTTTELEMCHNENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE MQTTTELEMCHNDEF  g_atMqttTelemChnDefs[ ];
+
+// global function prototypes --------------------------------------------------
+
+/**@} EOF MQTTTelemetryManager_cfg.h */
+
+#endif  // _MQTTTELEMETRYMANAGER_CFG_H
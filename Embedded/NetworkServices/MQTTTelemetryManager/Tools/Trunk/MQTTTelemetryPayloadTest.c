@@ -0,0 +1,540 @@
+/******************************************************************************
+ * @file MQTTTelemetryPayloadTest.c
+ *
+ * @brief MQTT telemetry manager payload test
+ *
+ * This file provides a host tool that runs the telemetry manager against
+ * simulated sensor manager and system monitor channels and a simulated clock.
+ * It replaces MQTTTelemetryManager_cfg.c, samples random values, some of them
+ * failed reads and some at the worst case varint sizes, and decodes every
+ * published batch with the nanopb decoder as a TelemetryBatch.  The base time,
+ * channel count, sample count, time deltas and the delta decoded values are
+ * checked against what was sampled.  It also checks that an uncollected full
+ * batch is restarted and that an empty batch returns no payload, then reports
+ * the average payload size.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o MQTTTelemetryPayloadTest
+ *             MQTTTelemetryPayloadTest.c ../../Core/Trunk/MQTTTelemetryManager.c
+ *             <pb_encode.c> <pb_decode.c> <pb_common.c>
+ * usage:      MQTTTelemetryPayloadTest [batches] [seed]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup MQTTTelemetryManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "MQTTTelemetryManager/MQTTTelemetryManager.h"
+
+// library includes -----------------------------------------------------------
+#include "NanoProtoBuf/pb_decode.h"
+#include "RTCManager/RTCManager.h"
+#include "SensorManager/SensorManager.h"
+#include "SystemMonitor/SystemMonitor.h"
+#include "TimeHandler/TimeHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of batches/seed
+#define DEFAULT_BATCHES                             ( 200 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the field numbers from MQTTTelemetry.proto
+#define FIELD_BATCH_BASETIME                        ( 1 )
+#define FIELD_BATCH_CHANNELCOUNT                    ( 2 )
+#define FIELD_BATCH_SAMPLES                         ( 3 )
+#define FIELD_SAMPLE_TIMEDELTA                      ( 1 )
+#define FIELD_SAMPLE_VALUES                         ( 2 )
+
+/// define the sources enumerations used by the channel table
+#define SENMAN_TEMP                                 ( 0 )
+#define SENMAN_HUMIDITY                             ( 1 )
+#define SYSMON_VOLTAGE                              ( 0 )
+#define SYSMON_COUNTER                              ( 1 )
+
+/// define the scale of the float channel
+#define VOLTAGE_SCALE                               ( 100.0f )
+
+/// define the start time
+#define START_TIME                                  ( 1600000000UL )
+
+// structures -----------------------------------------------------------------
+/// define the expected batch
+typedef struct _EXPECTED
+{
+  U32   uBaseTime;                                                      ///< time of the first sample
+  U16   wNumSamples;                                                    ///< number of samples
+  U32   auTimes[ MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH ];             ///< sample times
+  S32   alValues[ MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH ][ MQTTTELEM_CHN_ENUM_MAX ];  ///< reported values
+} EXPECTED;
+
+// global parameter declarations ----------------------------------------------
+/// instantiate the channel table
+const CODE MQTTTELEMCHNDEF  g_atMqttTelemChnDefs[ MQTTTELEM_CHN_ENUM_MAX ] =
+{
+  MQTTTELEMSENMANDEFM( SENMAN_TEMP, 1.0f ),
+  MQTTTELEMSENMANDEFM( SENMAN_HUMIDITY, 1.0f ),
+  MQTTTELEMSYSMONDEFM( SYSMON_VOLTAGE, VOLTAGE_SCALE ),
+  MQTTTELEMSYSMONDEFM( SYSMON_COUNTER, 1.0f ),
+};
+
+// local parameter declarations -----------------------------------------------
+static  unsigned long ulState;
+static  U32           uUnixTime;
+static  S16           awSenValues[ 2 ];
+static  BOOL          abSenFail[ 2 ];
+static  FLOAT         fVoltage;
+static  S32           lCounter;
+static  BOOL          abSysFail[ 2 ];
+static  S32           alReported[ MQTTTELEM_CHN_ENUM_MAX ];
+static  EXPECTED      tExpected;
+static  unsigned      uErrors;
+
+// local function prototypes --------------------------------------------------
+static  void      NewValues( BOOL bWorstCase );
+static  void      SampleAndRecord( void );
+static  void      CheckBatch( void );
+static  BOOL      DecodeBatch( PU8 pnPayload, U16 wLength );
+static  BOOL      DecodeSample( pb_istream_t* ptStream, U16 wSample, PU32 puTime, PS32 plValues );
+static  void      Check( BOOL bCondition, const char* pszWhat );
+static  U32       Random( U32 uRange );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * This function runs the batches and the restart checks
+ *
+ * @param[in]   argc        argument count
+ * @param[in]   argv        arguments
+ *
+ * @return      0 if all checks passed
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  unsigned  uBatches, uBatch, uTotalBytes = 0, uTotalSamples = 0;
+  PU8       pnPayload;
+  U16       wLength, wSample;
+
+  // get the arguments
+  uBatches = ( argc > 1 ) ? ( unsigned )atoi( argv[ 1 ] ) : DEFAULT_BATCHES;
+  ulState = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+
+  // initialize
+  uUnixTime = START_TIME;
+  Check( !MQTTTelemetryManager_Initialize( ), "initialize" );
+
+  // an empty batch has no payload
+  Check( MQTTTelemetryManager_GetPayload( &pnPayload, &wLength ), "empty batch returns no payload" );
+
+  // run the batches, every eighth one at the worst case sizes
+  for ( uBatch = 0; uBatch < uBatches; uBatch++ )
+  {
+    // sample a full batch, the last one is ready
+    memset( &tExpected, 0, sizeof( tExpected ));
+    for ( wSample = 0; wSample < MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH; wSample++ )
+    {
+      NewValues(( uBatch % 8 ) == 7 );
+      SampleAndRecord( );
+    }
+
+    // decode it
+    Check( MQTTTelemetryManager_GetPayload( &pnPayload, &wLength ) == FALSE, "full batch returns a payload" );
+    Check( DecodeBatch( pnPayload, wLength ), "batch decodes" );
+    uTotalBytes += wLength;
+    uTotalSamples += MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH;
+  }
+
+  // a partial batch is published as is
+  memset( &tExpected, 0, sizeof( tExpected ));
+  NewValues( FALSE );
+  SampleAndRecord( );
+  NewValues( FALSE );
+  SampleAndRecord( );
+  CheckBatch( );
+
+  // a full batch that is never collected is restarted by the next sample
+  memset( &tExpected, 0, sizeof( tExpected ));
+  for ( wSample = 0; wSample < MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH; wSample++ )
+  {
+    NewValues( FALSE );
+    SampleAndRecord( );
+  }
+  memset( &tExpected, 0, sizeof( tExpected ));
+  NewValues( FALSE );
+  SampleAndRecord( );
+  CheckBatch( );
+
+  // report
+  if ( uTotalSamples != 0 )
+  {
+    printf( "%u batches of %u samples, %u channels: %.1f bytes per batch, %.1f bytes per sample\n",
+            uBatches, MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH, MQTTTELEM_CHN_ENUM_MAX,
+            ( double )uTotalBytes / uBatches, ( double )uTotalBytes / uTotalSamples );
+  }
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", uErrors );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function NewValues
+ *
+ * @brief set new source values
+ *
+ * This function advances the clock and sets new source values, some reads
+ * fail.  The worst case sets the largest values of alternating sign so each
+ * delta needs the longest varint
+ *
+ * @param[in]   bWorstCase  TRUE for the worst case sizes
+ *
+ *****************************************************************************/
+static void NewValues( BOOL bWorstCase )
+{
+  U8  nIdx;
+
+  // advance the clock
+  uUnixTime += 1 + Random( 120 );
+
+  // check for worst case
+  if ( bWorstCase )
+  {
+    // flip the signs of the largest values
+    awSenValues[ 0 ] = ( awSenValues[ 0 ] > 0 ) ? -32768 : 32767;
+    awSenValues[ 1 ] = ( awSenValues[ 1 ] > 0 ) ? -32768 : 32767;
+    fVoltage = ( fVoltage > 0 ) ? -5000000.0f : 5000000.0f;
+    lCounter = ( lCounter > 0 ) ? -1000000000L : 1000000000L;
+  }
+  else
+  {
+    // small random changes, as real channels make
+    awSenValues[ 0 ] += ( S16 )Random( 21 ) - 10;
+    awSenValues[ 1 ] = ( S16 )Random( 1001 );
+    fVoltage = ( FLOAT )(( S32 )Random( 200001 ) - 100000 ) / 8.0f;
+    lCounter += Random( 5 );
+  }
+
+  // fail some reads
+  for ( nIdx = 0; nIdx < 2; nIdx++ )
+  {
+    abSenFail[ nIdx ] = ( Random( 8 ) == 0 );
+    abSysFail[ nIdx ] = ( Random( 8 ) == 0 );
+  }
+}
+
+/******************************************************************************
+ * @function SampleAndRecord
+ *
+ * @brief sample and record the expected values
+ *
+ * This function takes a sample and records the values it should report, a
+ * failed read reports the last reported value
+ *
+ *****************************************************************************/
+static void SampleAndRecord( void )
+{
+  MQTTTELEMSTS  eStatus;
+  U16           wSample = tExpected.wNumSamples;
+
+  // compute the expected values
+  if ( !abSenFail[ 0 ] )
+  {
+    alReported[ MQTTTELEM_CHN_ENUM_TEMP ] = awSenValues[ 0 ];
+  }
+  if ( !abSenFail[ 1 ] )
+  {
+    alReported[ MQTTTELEM_CHN_ENUM_HUMIDITY ] = awSenValues[ 1 ];
+  }
+  if ( !abSysFail[ 0 ] )
+  {
+    alReported[ MQTTTELEM_CHN_ENUM_VOLTAGE ] = ( S32 )ROUND( fVoltage * VOLTAGE_SCALE );
+  }
+  if ( !abSysFail[ 1 ] )
+  {
+    alReported[ MQTTTELEM_CHN_ENUM_COUNTER ] = lCounter;
+  }
+
+  // record them
+  if ( wSample == 0 )
+  {
+    tExpected.uBaseTime = uUnixTime;
+  }
+  tExpected.auTimes[ wSample ] = uUnixTime;
+  memcpy( tExpected.alValues[ wSample ], alReported, sizeof( alReported ));
+  tExpected.wNumSamples++;
+
+  // sample it
+  eStatus = MQTTTelemetryManager_Sample( );
+  Check( eStatus != MQTTTELEM_STS_ERROR, "sample encodes" );
+  Check(( eStatus == MQTTTELEM_STS_READY ) == ( tExpected.wNumSamples == MQTTTELEMETRYMANAGER_SAMPLES_PER_PUBLISH ), "ready on the last sample" );
+}
+
+/******************************************************************************
+ * @function CheckBatch
+ *
+ * @brief collect and check a batch
+ *
+ * This function collects the current batch and decodes it
+ *
+ *****************************************************************************/
+static void CheckBatch( void )
+{
+  PU8 pnPayload;
+  U16 wLength;
+
+  // collect it/decode it
+  Check( MQTTTelemetryManager_GetPayload( &pnPayload, &wLength ) == FALSE, "partial batch returns a payload" );
+  Check( DecodeBatch( pnPayload, wLength ), "partial batch decodes" );
+}
+
+/******************************************************************************
+ * @function DecodeBatch
+ *
+ * @brief decode a batch
+ *
+ * This function decodes a TelemetryBatch and compares it to the expected
+ * batch
+ *
+ * @param[in]   pnPayload   pointer to the payload
+ * @param[in]   wLength     payload length
+ *
+ * @return      TRUE if it matches
+ *
+ *****************************************************************************/
+static BOOL DecodeBatch( PU8 pnPayload, U16 wLength )
+{
+  pb_istream_t    tStream, tSubStream;
+  pb_wire_type_t  eWireType;
+  uint32_t        uTag, uBaseTime = 0, uChannels = 0, uTime = 0;
+  bool            bEof;
+  BOOL            bOk = TRUE;
+  U16             wSample = 0;
+  S32             alValues[ MQTTTELEM_CHN_ENUM_MAX ];
+
+  // decode each field
+  tStream = pb_istream_from_buffer( pnPayload, wLength );
+  while (( bOk ) && ( pb_decode_tag( &tStream, &eWireType, &uTag, &bEof )))
+  {
+    switch( uTag )
+    {
+      case FIELD_BATCH_BASETIME :
+        bOk = ( eWireType == PB_WT_VARINT ) && pb_decode_varint32( &tStream, &uBaseTime );
+        uTime = uBaseTime;
+        break;
+
+      case FIELD_BATCH_CHANNELCOUNT :
+        bOk = ( eWireType == PB_WT_VARINT ) && pb_decode_varint32( &tStream, &uChannels );
+        break;
+
+      case FIELD_BATCH_SAMPLES :
+        // samples follow the header
+        bOk = ( eWireType == PB_WT_STRING ) && ( uChannels == MQTTTELEM_CHN_ENUM_MAX ) && ( wSample < tExpected.wNumSamples );
+        if ( bOk )
+        {
+          bOk = pb_make_string_substream( &tStream, &tSubStream );
+          bOk = bOk && DecodeSample( &tSubStream, wSample, &uTime, alValues );
+          bOk = bOk && ( tSubStream.bytes_left == 0 );
+          pb_close_string_substream( &tStream, &tSubStream );
+          wSample++;
+        }
+        break;
+
+      default :
+        bOk = pb_skip_field( &tStream, eWireType );
+        break;
+    }
+  }
+
+  // check the end and the header
+  bOk = bOk && ( tStream.bytes_left == 0 );
+  bOk = bOk && ( uBaseTime == tExpected.uBaseTime );
+  bOk = bOk && ( uChannels == MQTTTELEM_CHN_ENUM_MAX );
+  bOk = bOk && ( wSample == tExpected.wNumSamples );
+
+  // return the status
+  return( bOk );
+}
+
+/******************************************************************************
+ * @function DecodeSample
+ *
+ * @brief decode a sample
+ *
+ * This function decodes a TelemetrySample, accumulates the time and values
+ * and compares them to the expected sample
+ *
+ * @param[in]   ptStream    pointer to the sample stream
+ * @param[in]   wSample     sample index
+ * @param[io]   puTime      pointer to the running time
+ * @param[io]   plValues    pointer to the running values
+ *
+ * @return      TRUE if it matches
+ *
+ *****************************************************************************/
+static BOOL DecodeSample( pb_istream_t* ptStream, U16 wSample, PU32 puTime, PS32 plValues )
+{
+  pb_istream_t    tValues;
+  pb_wire_type_t  eWireType;
+  uint32_t        uTag, uDelta = 0;
+  int64_t         hDelta;
+  bool            bEof;
+  BOOL            bOk = TRUE, bHaveValues = FALSE;
+  U8              nChannel = 0;
+
+  // decode each field
+  while (( bOk ) && ( pb_decode_tag( ptStream, &eWireType, &uTag, &bEof )))
+  {
+    switch( uTag )
+    {
+      case FIELD_SAMPLE_TIMEDELTA :
+        bOk = ( eWireType == PB_WT_VARINT ) && pb_decode_varint32( ptStream, &uDelta );
+        break;
+
+      case FIELD_SAMPLE_VALUES :
+        // packed, first sample absolute, the rest deltas
+        bOk = ( eWireType == PB_WT_STRING ) && pb_make_string_substream( ptStream, &tValues );
+        while (( bOk ) && ( tValues.bytes_left != 0 ) && ( nChannel < MQTTTELEM_CHN_ENUM_MAX ))
+        {
+          bOk = pb_decode_svarint( &tValues, &hDelta );
+          plValues[ nChannel ] = ( wSample == 0 ) ? ( S32 )hDelta : ( S32 )(( U32 )plValues[ nChannel ] + ( U32 )hDelta );
+          nChannel++;
+        }
+        bOk = bOk && ( tValues.bytes_left == 0 );
+        pb_close_string_substream( ptStream, &tValues );
+        bHaveValues = TRUE;
+        break;
+
+      default :
+        bOk = pb_skip_field( ptStream, eWireType );
+        break;
+    }
+  }
+
+  // check the values
+  *( puTime ) += uDelta;
+  bOk = bOk && ( bHaveValues ) && ( nChannel == MQTTTELEM_CHN_ENUM_MAX );
+  bOk = bOk && ( *( puTime ) == tExpected.auTimes[ wSample ] );
+  bOk = bOk && ( memcmp( plValues, tExpected.alValues[ wSample ], sizeof( tExpected.alValues[ wSample ] )) == 0 );
+  if ( !bOk )
+  {
+    printf( "  sample %u: time %u, expected %u\n", wSample, *( puTime ), tExpected.auTimes[ wSample ] );
+  }
+
+  // return the status
+  return( bOk );
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * This function counts and reports a failed check
+ *
+ * @param[in]   bCondition  condition
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, const char* pszWhat )
+{
+  // report it
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      printf( "  failed: %s\n", pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief get a random number
+ *
+ * This function returns a pseudo random number in a range
+ *
+ * @param[in]   uRange      range
+ *
+ * @return      number from 0 to range - 1
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // next state
+  ulState = ( ulState * 6364136223846793005ULL ) + 1442695040888963407ULL;
+  return(( U32 )(( ulState >> 33 ) % uRange ));
+}
+
+//******************************************************************************
+// source functions
+//******************************************************************************
+void RTCManager_GetDateTime( PDATETIME ptDateTime )
+{
+  // the time is passed through the time handler
+  memset( ptDateTime, 0, sizeof( DATETIME ));
+}
+
+U64 TimeHandler_TimeToHuge( TIMEOSTYPE eOsType, PDATETIME ptDateTime )
+{
+  // return the simulated time
+  ( void )eOsType;
+  ( void )ptDateTime;
+  return( uUnixTime );
+}
+
+SENMANERROR SensorManager_GetValue( SENMANENUM eSenEnum, PSENMANARG pxValue )
+{
+  SENMANERROR eError = SENMAN_ERROR_NONE;
+
+  // get the value or fail
+  if ( abSenFail[ eSenEnum ] )
+  {
+    eError = SENMAN_ERROR_VALNOTVALID;
+  }
+  else
+  {
+    *( pxValue ) = awSenValues[ eSenEnum ];
+  }
+  return( eError );
+}
+
+BOOL SystemMonitor_GetEntryValue( SYSMONENUM eEntry, PSYSMONENTTYPE peEntType, PU32UN ptValue )
+{
+  // fail it
+  if ( abSysFail[ eEntry ] )
+  {
+    return( TRUE );
+  }
+
+  // get the value
+  if ( eEntry == SYSMON_VOLTAGE )
+  {
+    *( peEntType ) = SYSMON_ENTTYPE_FLOAT;
+    ptValue->fValue = fVoltage;
+  }
+  else
+  {
+    *( peEntType ) = SYSMON_ENTTYPE_S32;
+    ptValue->lValue = lCounter;
+  }
+  return( FALSE );
+}
+
+/**@} EOF MQTTTelemetryPayloadTest.c */
@@ -30,10 +30,11 @@
 // library includes -----------------------------------------------------------
 #include "GPIO/Gpio.h"
 #include "ManchesterCodec/ManchesterCodec.h"
+#include "SystemControlManager/SystemControlManager.h"
 
 // Macros and Defines ---------------------------------------------------------
-/// define the put event for the incoming queue
-#define DALIBUSMASTER_XMTMSG_QUEUEEVENT         ( QUEUEPUT_EVENT( QUEUE_ENUM_DALIMASTERXMT ))
+/// define the mode that allows broadcast queries
+#define DALIBUSMASTER_DALIDEBUG_MODE            ( SYSCTRLMNGR_LCLMODE_DIAGNOSTICS )
 
 // enumerations ---------------------------------------------------------------
 
@@ -195,6 +196,22 @@ BOOL DALIBusMaster_GetBusState( void )
   return( bBusState );
 }
 
+/******************************************************************************
+ * @function DALIBusMaster_IsDebugMode
+ *
+ * @brief check for DALI debug mode
+ *
+ * This function returns TRUE if broadcast/group queries are allowed
+ *
+ * @return  TRUE if in DALI debug mode
+ *
+ *****************************************************************************/
+BOOL DALIBusMaster_IsDebugMode( void )
+{
+  // return the state
+  return(( SYSCTRLMGRLCLMODE )SystemControlManager_GetMode( ) == DALIBUSMASTER_DALIDEBUG_MODE );
+}
+
 /******************************************************************************
  * @function DALIBusMaster_QueuePutRcvMsg
  *
@@ -213,31 +230,15 @@ void DALIBusMaster_QueuePutRcvMsg( PDALIBUSMASTERMSG ptCurMessage )
   if (( pvCallback = ptCurMessage->pvCallbackFunc ) != NULL )
   {
     // execute the callback
-    pvCallback(( PVOID)ptCurMessage );
+    pvCallback( ptCurMessage->tDaliXmtRcvMsg.eStatus, ptCurMessage->tDaliXmtRcvMsg.nRcvMsg );
   }
   else
   {
     // must be a queue entry, post the event
-    QueueManager_PutTail( ptCurMessage->nOption, ( PU8 )ptCurMessage );
+    QueueManager_PutTail(( QUEUEENUM )ptCurMessage->uOption, ( PU8 )ptCurMessage );
   }
 }
 
-/******************************************************************************
- * @function DALIBusMaster_QueueGetXmtMsg
- *
- * @brief get the lastest transmit message from the queue
- *
- * This function gets the latest message from the transmit queue
- *
- * @param[in]   ptCurMessage    pointero the message structure
- *
- *****************************************************************************/
-void DALIBusMaster_QueueGetXmtMsg( PDALIBUSMASTERMSG ptCurMessage )
-{
-  // get the message from the queue
-  QueueManager_Get( QUEUE_ENUM_DALIMASTERXMT, ( PU8 )ptCurMessage );
-}
-
 /******************************************************************************
  * @function DALIBusMaster_PostBusTask
  *
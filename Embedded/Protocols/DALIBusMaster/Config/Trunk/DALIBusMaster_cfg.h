@@ -37,8 +37,13 @@
 #include "Types/Types.h"
 
 // Macros and Defines ---------------------------------------------------------
-/// define the number of transmit queue events
-#define DALIBUSMASTER_XMT_QUEUE_SIZE            ( 2 )
+/// define the number of transmit queue entries, sized for a level to every device
+#define DALIBUSMASTER_XMT_QUEUE_SIZE            ( 64 )
+
+/// define the settling times from the last edge of a forward/backward frame to
+/// the start of the next forward frame, DALI requires at least 13.5/2.4 msecs
+#define DALIBUSMASTER_FWDSETTLE_TIME_MS         ( 14 )
+#define DALIBUSMASTER_BWDSETTLE_TIME_MS         ( 3 )
 
 /// define the number of events
 #define DALIBUSMASTER_XMT_NUM_EVENTS            ( 4 )
@@ -91,8 +96,8 @@ extern  void  DALIBusMaster_Transmit( PU8 pnBuffer, U8 nLength );
 extern  void  DALIBusMaster_Receive( PU8 pnBuffer, U8 nLength );
 extern  void  DALIBusMaster_StopReceive( void );
 extern  BOOL  DALIBusMaster_GetBusState( void );
+extern  BOOL  DALIBusMaster_IsDebugMode( void );
 extern  void  DALIBusMaster_QueuePutRcvMsg( PDALIBUSMASTERMSG ptCurMessage );
-extern  void  DALIBusMaster_QueueGetXmtMsg( PDALIBUSMASTERMSG ptCurMessage ); 
 extern  void  DALIBusMaster_PostCtlTask( DALIBUSMASTERCTLEVENT eEvent );
 extern  void  DALIBusMaster_PostXmtTask( DALIBUSMASTERXMTEVENT eEvent );
 extern  void  DALIBusMaster_XmtTaskTimer( BOOL bState, U32 uTimeMsecs );
@@ -3,7 +3,12 @@
  *
  * @brief DALI Bus Master implementation 
  *
- * This file provides the implementation for the DALI bus master
+ * This file provides the implementation for the DALI bus master.  Messages
+ * are held in a prioritized transmit queue and the transmit state machine
+ * starts the next one as soon as the settling time of the last frame expires,
+ * reporting each result while the bus settles.  A level to an address that
+ * still has a level waiting replaces it, and send twice configuration
+ * commands go out back to back
  *
  * @copyright Copyright (c) 2012 Cyber Intergration
  * This document contains proprietary data and information of Cyber Integration 
@@ -32,25 +37,27 @@
 #endif // DALIBUSMASTER_ENABLE_DEBUG
 #include "StateExecutionEngine/StateExecutionEngine.h"
 
+
 // Macros and Defines ---------------------------------------------------------
 /// define the bus error threshhold count
 #define BUS_ERROR_THRESHOLD                     ( 8 )
 
 /// define the wait times for receive
 #define XMITECHO_WAIT_TIME_MS                   ( 22 )
-#define INTERFRAME_WAIT_TIME_MS                 ( 12 )
 #define RECV_WAIT_TIME_MS                       ( 16 )
-#define BACKFRM_WAIT_TIME_MS                    (  9 )
 
 /// define the DALI response size
 #define DALI_RESPONSE_SIZE                      ( sizeof( U8 ))
 
+/// define the empty queue index
+#define XMTQUEUE_INDEX_NONE                     ( 0xFF )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the bus states
 typedef enum _CTLSTATE
 {
   CTL_STATE_IDLE = 0,           ///< idle state
-  CTL_STATE_WAIT,               ///< wait for message to complete
+  CTL_STATE_WAIT,               ///< wait for the queue to drain
   CTL_STATE_MAX
 } CTLSTATE;
 
@@ -76,25 +83,41 @@ typedef enum _RSPTYPE
 } RSPTYPE;
 
 // structures -----------------------------------------------------------------
+/// define the transmit queue entry
+typedef struct _XMTQUEUEENTRY
+{
+  DALIBUSMASTERMSG  tMessage;         ///< message
+  U16               wSequence;        ///< sequence number, orders entries of equal priority
+  U8                nPriority;        ///< priority
+  BOOL              bInUse;           ///< entry in use
+} XMTQUEUEENTRY, *PXMTQUEUEENTRY;
+#define XMTQUEUEENTRY_SIZE                      sizeof( XMTQUEUEENTRY )
 
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
 static  STATEEXECENGCONTROL     tXmtStateCtl;     ///< transmit state control
 static  STATEEXECENGCONTROL     tCtlStateCtl;     ///< control state control
-static  BOOL                    bFlushEvent;      ///< flush the event
 static  BOOL                    bEdgeEvent;       ///< edge event received
 static  BOOL                    bBusError;        ///< bus error
 static  U8                      nBusErrorCount;   ///< bus error count
 static  RSPTYPE                 eAnswerExp;       ///< answer expected
 static  BOOL                    bRepeatCmd;       ///< repeat command
-static  BOOL                    bEdgeEvent;       ///< edge event received
+static  BOOL                    bCtlPosted;       ///< message in queue posted to the control
 static  DALIXMTMSG              tLclRcvMsg;       ///< local transmit message
 static  DALIBUSMASTERMSG        tCurMessage;      ///< current message
+static  XMTQUEUEENTRY           atXmtQueue[ DALIBUSMASTER_XMT_QUEUE_SIZE ];  ///< transmit queue
+static  U8                      nXmtQueueCount;   ///< number of entries in the queue
+static  U16                     wXmtSequence;     ///< next sequence number
 
 // local function prototypes --------------------------------------------------
 static  RSPTYPE CheckForAnswer( PDALIXMTMSG ptMsg );
 static  BOOL    CheckForRepeat( PDALIXMTMSG ptMsg );
+static  BOOL    GetNextMessage( void );
+static  void    CompleteMessage( void );
+static  void    SendFrame( void );
+static  U8      StartNextMessage( void );
+static  U8      FinishFrame( void );
 
 //******************************************************************************
 // CTL state functions
@@ -108,10 +131,6 @@ static  U8    CtlStateWaitExec( STATEEXECENGARG xArg );
 //******************************************************************************
 /// XMT_STATE_IDLE functions
 static  U8    XmtStateIdleExc( STATEEXECENGARG xArg );
-static  void  XmtStateIdleExt( void );
-
-/// XMT_STATE_ANY  exit function
-static  void  XmtStateAnyExt( void );
 
 /// XMT_STATE_WAITXMTDONE function
 static  void  XmtStateWaitXmtDoneEnt( void );
@@ -129,7 +148,7 @@ static  U8    XmtStateWaitRcvDoneExc( STATEEXECENGARG xArg );
 static  void  XmtStateWaitFrmTimeEnt( void );
 static  U8    XmtStateWaitFrmTimeExc( STATEEXECENGARG xArg );
 
-/// XMT_STATE_WAITFRMTIME functions
+/// XMT_STATE_WAITBFMTIME functions
 static  void  XmtStateWaitBfmTimeEnt( void );
 static  U8    XmtStateWaitBfmTimeExc( STATEEXECENGARG xArg );
 
@@ -145,6 +164,8 @@ static  const C8  szStsTmoRcv[ ]      = { "RCVTMO" };
 static  const C8  szStsBusCol[ ]      = { "BUSCOL" };
 static  const C8  szStsIllOpr[ ]      = { "ILLOPR" };
 static  const C8  szStsBusMon[ ]      = { "BADBUS" };
+static  const C8  szStsSuperseded[ ]  = { "SUPRSD" };
+static  const C8  szStsUnknown[ ]     = { "UNKNOWN" };
 
 /// define the table
 static  const PC8 pszStatuses[ ] =
@@ -158,7 +179,9 @@ static  const PC8 pszStatuses[ ] =
   ( PC8 )szStsTmoRcv,
   ( PC8 )szStsBusCol,
   ( PC8 )szStsIllOpr,
-  ( PC8 )szStsBusMon
+  ( PC8 )szStsBusMon,
+  ( PC8 )szStsSuperseded,
+  ( PC8 )szStsUnknown
 };
 
 //******************************************************************************
@@ -179,22 +202,15 @@ static  const STATEEXECENGTABLE  atCtlStates[ CTL_STATE_MAX ] =
 //******************************************************************************
 // transmit state transition table and state table
 //******************************************************************************
-/// 
-static  const CODE STATEEXECENGEVENT  atWaitTmoEvents[ ] =
-{
-  STATEEXECENGEVENT_ENTRY( DALIBUSMASTER_XMTEVENT_TIMEOUT, XMT_STATE_IDLE, TRUE  ),
-  STATEEXECENGEVENT_END( )
-};
-
 /// initialize the main state table
 const CODE STATEEXECENGTABLE  atTransmitHandlerStates[ XMT_STATE_MAX ] =
 {
-  STATEXECENGETABLE_ENTRY( XMT_STATE_IDLE,        NULL,                   XmtStateIdleExc,        XmtStateIdleExt,  NULL                ),
-  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITXMTDONE, XmtStateWaitXmtDoneEnt, XmtStateWaitXmtDoneExc, XmtStateAnyExt,   atWaitTmoEvents     ),
-  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITXMTECHO, XmtStateWaitXmtEchoEnt, XmtStateWaitXmtEchoExc, XmtStateAnyExt,   atWaitTmoEvents     ),
-  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITRCVDONE, XmtStateWaitRcvDoneEnt, XmtStateWaitRcvDoneExc, XmtStateAnyExt,   NULL                ),
-  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITFRMTIME, XmtStateWaitFrmTimeEnt, XmtStateWaitFrmTimeExc, XmtStateAnyExt,   NULL                ),
-  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITBFMTIME, XmtStateWaitBfmTimeEnt, XmtStateWaitBfmTimeExc, XmtStateAnyExt,   NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_IDLE,        NULL,                   XmtStateIdleExc,        NULL,             NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITXMTDONE, XmtStateWaitXmtDoneEnt, XmtStateWaitXmtDoneExc, NULL,             NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITXMTECHO, XmtStateWaitXmtEchoEnt, XmtStateWaitXmtEchoExc, NULL,             NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITRCVDONE, XmtStateWaitRcvDoneEnt, XmtStateWaitRcvDoneExc, NULL,             NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITFRMTIME, XmtStateWaitFrmTimeEnt, XmtStateWaitFrmTimeExc, NULL,             NULL                ),
+  STATEXECENGETABLE_ENTRY( XMT_STATE_WAITBFMTIME, XmtStateWaitBfmTimeEnt, XmtStateWaitBfmTimeExc, NULL,             NULL                ),
 };
 
 /******************************************************************************
@@ -221,6 +237,12 @@ BOOL DALIBusMaster_Initialize( void )
   bBusError = FALSE;
   nBusErrorCount = 0;
 
+  // clear the queue
+  memset( atXmtQueue, 0, sizeof( atXmtQueue ));
+  nXmtQueueCount = 0;
+  wXmtSequence = 0;
+  bCtlPosted = FALSE;
+
   // return no errors
   return( FALSE );
 }
@@ -230,7 +252,7 @@ BOOL DALIBusMaster_Initialize( void )
  *
  * @brief transmit a message
  *
- * This function will place a message in the transmit queue
+ * This function will place a message in the transmit queue at normal priority
  *
  * @param[in]   ptMsg           pointer to the message
  * @param[in]   pvCallback      pointer to the callback
@@ -241,22 +263,141 @@ BOOL DALIBusMaster_Initialize( void )
  *****************************************************************************/
 BOOL DALIBusMaster_TransmitMessage( PDALIXMTMSG ptMsg, PVDALIBUSMSTRCB pvCallback, U32 uOption )
 {
-  BOOL              bStatus = FALSE;
-  DALIBUSMASTERMSG  tBusMessage;
+  // queue it at normal priority
+  return( DALIBusMaster_TransmitMessagePriority( ptMsg, DALIBUSMASTER_PRIO_NORMAL, pvCallback, uOption ));
+}
+
+/******************************************************************************
+ * @function DALIBusMaster_TransmitMessagePriority
+ *
+ * @brief transmit a message with a priority
+ *
+ * This function will place a message in the transmit queue.  A level to an
+ * address that already has a level waiting replaces the waiting one, which
+ * keeps its place and is reported as superseded, unless a later message that
+ * may reach the same gear is waiting behind it
+ *
+ * @param[in]   ptMsg           pointer to the message
+ * @param[in]   ePriority       priority
+ * @param[in]   pvCallback      pointer to the callback
+ * @param[in]   uOption         option 
+ *
+ * @return  TRUE if the queue is full, or FALSE if ok
+ *
+ *****************************************************************************/
+BOOL DALIBusMaster_TransmitMessagePriority( PDALIXMTMSG ptMsg, DALIBUSMASTERPRIO ePriority, PVDALIBUSMSTRCB pvCallback, U32 uOption )
+{
+  BOOL            bStatus = FALSE;
+  PXMTQUEUEENTRY  ptEntry;
+  U8              nIdx, nLevelIdx, nFreeIdx;
+  DALIBUSMASTERMSG tOldMessage;
+
+  // find a free entry and the latest level waiting for this address
+  nLevelIdx = nFreeIdx = XMTQUEUE_INDEX_NONE;
+  for ( nIdx = 0; nIdx < DALIBUSMASTER_XMT_QUEUE_SIZE; nIdx++ )
+  {
+    ptEntry = &atXmtQueue[ nIdx ];
+    if ( !ptEntry->bInUse )
+    {
+      // remember the first free one
+      if ( nFreeIdx == XMTQUEUE_INDEX_NONE )
+      {
+        nFreeIdx = nIdx;
+      }
+    }
+    else if (( ptMsg->tFields.tAddr.bLvlCmd == FALSE ) && ( ptEntry->tMessage.tDaliXmtRcvMsg.tXmtMsg.tFields.tAddr.bLvlCmd == FALSE ) &&
+             ( ptEntry->tMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ] == ptMsg->anBuffer[ 0 ] ))
+    {
+      // same target, keep the latest
+      if (( nLevelIdx == XMTQUEUE_INDEX_NONE ) || (( S16 )( ptEntry->wSequence - atXmtQueue[ nLevelIdx ].wSequence ) > 0 ))
+      {
+        nLevelIdx = nIdx;
+      }
+    }
+  }
+
+  // a level can not be moved past a later message that may reach the same
+  // gear, group and broadcast addresses may overlap anything
+  for ( nIdx = 0; ( nLevelIdx != XMTQUEUE_INDEX_NONE ) && ( nIdx < DALIBUSMASTER_XMT_QUEUE_SIZE ); nIdx++ )
+  {
+    ptEntry = &atXmtQueue[ nIdx ];
+    if (( ptEntry->bInUse ) &&
+        (( ptEntry->tMessage.tDaliXmtRcvMsg.tXmtMsg.tFields.tAddr.bDirGrp == TRUE ) || ( ptMsg->tFields.tAddr.bDirGrp == TRUE ) ||
+         (( ptEntry->tMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ] >> 1 ) == ( ptMsg->anBuffer[ 0 ] >> 1 ))) &&
+        (( S16 )( ptEntry->wSequence - atXmtQueue[ nLevelIdx ].wSequence ) > 0 ))
+    {
+      // leave it, queue a new one
+      nLevelIdx = XMTQUEUE_INDEX_NONE;
+    }
+  }
+
+  // determine the entry
+  if ( nLevelIdx != XMTQUEUE_INDEX_NONE )
+  {
+    // replace the level, keeping its place/raising the priority if needed
+    ptEntry = &atXmtQueue[ nLevelIdx ];
+    memcpy( &tOldMessage, &ptEntry->tMessage, DALIBUSMASTERMSG_SIZE );
+    ptEntry->nPriority = MIN( ptEntry->nPriority, ( U8 )ePriority );
+  }
+  else if ( nFreeIdx != XMTQUEUE_INDEX_NONE )
+  {
+    // use the free entry
+    ptEntry = &atXmtQueue[ nFreeIdx ];
+    ptEntry->bInUse = TRUE;
+    ptEntry->nPriority = ( U8 )ePriority;
+    ptEntry->wSequence = wXmtSequence++;
+    nXmtQueueCount++;
+  }
+  else
+  {
+    // queue is full
+    ptEntry = NULL;
+    bStatus = TRUE;
+  }
 
   // build the message
-  tBusMessage.pvCallbackFunc = pvCallback;
-  tBusMessage.uOption = uOption;
-  tBusMessage.tDaliXmtRcvMsg.tXmtMsg.tFields.tAddr.nAddr = ptMsg->tFields.tAddr.nAddr;
-  tBusMessage.tDaliXmtRcvMsg.tXmtMsg.tFields.nDataCmd = ptMsg->tFields.nDataCmd;
+  if ( ptEntry != NULL )
+  {
+    ptEntry->tMessage.pvCallbackFunc = pvCallback;
+    ptEntry->tMessage.uOption = uOption;
+    memcpy( &ptEntry->tMessage.tDaliXmtRcvMsg.tXmtMsg, ptMsg, DALIXMTMSG_SIZE );
+    ptEntry->tMessage.tDaliXmtRcvMsg.nRcvMsg = 0;
+
+    // report the replaced level
+    if ( nLevelIdx != XMTQUEUE_INDEX_NONE )
+    {
+      tOldMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_SUPERSEDED;
+      DALIBusMaster_QueuePutRcvMsg( &tOldMessage );
+    }
 
-  // stuff in queue
-  bStatus = DALIBusMaster_QueuePutXmtMsg( &tBusMessage );
+    // wake up the control if idle
+    if (( tCtlStateCtl.nCurState == CTL_STATE_IDLE ) && ( !bCtlPosted ))
+    {
+      bCtlPosted = TRUE;
+      DALIBusMaster_PostCtlTask( DALIBUSMASTER_CTLEVENT_MSGINQUEUE );
+    }
+  }
 
   // return the status
   return( bStatus );
 }
 
+/******************************************************************************
+ * @function DALIBusMaster_GetQueueCount
+ *
+ * @brief get the queue count
+ *
+ * This function will return the number of messages waiting to be sent
+ *
+ * @return      number of messages
+ *
+ *****************************************************************************/
+U8 DALIBusMaster_GetQueueCount( void )
+{
+  // return the count
+  return( nXmtQueueCount );
+}
+
 /******************************************************************************
  * @function DALIBusMaster_GetStatusDescription
  *
@@ -436,7 +577,7 @@ static RSPTYPE CheckForAnswer(  PDALIXMTMSG ptMsg )
       else
       {
         // check for DALI Debug mode
-        eAnswer = (( SYSCTRLMGRLCLMODE )SystemControlManager_GetMode( ) == DALIBUSMASTER_DALIDEBUG_MODE ) ? RSP_TYPE_REQUIRED : RSP_TYPE_ERROR;
+        eAnswer = ( DALIBusMaster_IsDebugMode( )) ? RSP_TYPE_REQUIRED : RSP_TYPE_ERROR;
       }
     }
     else if ((( ptMsg->tFields.nDataCmd >= DALI_CMD_QUERYCONTROLGEAR ) && ( ptMsg->tFields.nDataCmd <= DALI_CMD_QUERYMISSINGSHORTADDR )) ||
@@ -451,7 +592,7 @@ static RSPTYPE CheckForAnswer(  PDALIXMTMSG ptMsg )
       else
       {
         // check for DALI Debug mode
-        eAnswer = (( SYSCTRLMGRLCLMODE )SystemControlManager_GetMode( ) == DALIBUSMASTER_DALIDEBUG_MODE ) ? RSP_TYPE_MAYBE : RSP_TYPE_ERROR;
+        eAnswer = ( DALIBusMaster_IsDebugMode( )) ? RSP_TYPE_MAYBE : RSP_TYPE_ERROR;
       }
     }
   }
@@ -503,33 +644,210 @@ static BOOL CheckForRepeat( PDALIXMTMSG ptMsg )
   return( bRepeat );
 }
 
+/******************************************************************************
+ * @function GetNextMessage
+ *
+ * @brief get the next message
+ *
+ * This function removes the oldest message of the highest priority from the
+ * transmit queue into the current message
+ *
+ * @return      TRUE if a message was found
+ *
+ *****************************************************************************/
+static BOOL GetNextMessage( void )
+{
+  PXMTQUEUEENTRY  ptEntry;
+  U8              nIdx, nBestIdx = XMTQUEUE_INDEX_NONE;
+
+  // find the best entry
+  for ( nIdx = 0; ( nXmtQueueCount != 0 ) && ( nIdx < DALIBUSMASTER_XMT_QUEUE_SIZE ); nIdx++ )
+  {
+    ptEntry = &atXmtQueue[ nIdx ];
+    if (( ptEntry->bInUse ) &&
+        (( nBestIdx == XMTQUEUE_INDEX_NONE ) ||
+         ( ptEntry->nPriority < atXmtQueue[ nBestIdx ].nPriority ) ||
+         (( ptEntry->nPriority == atXmtQueue[ nBestIdx ].nPriority ) && (( S16 )( ptEntry->wSequence - atXmtQueue[ nBestIdx ].wSequence ) < 0 ))))
+    {
+      nBestIdx = nIdx;
+    }
+  }
+
+  // if found, remove it
+  if ( nBestIdx != XMTQUEUE_INDEX_NONE )
+  {
+    memcpy( &tCurMessage, &atXmtQueue[ nBestIdx ].tMessage, DALIBUSMASTERMSG_SIZE );
+    atXmtQueue[ nBestIdx ].bInUse = FALSE;
+    nXmtQueueCount--;
+  }
+
+  // return the status
+  return( nBestIdx != XMTQUEUE_INDEX_NONE );
+}
+
+/******************************************************************************
+ * @function CompleteMessage
+ *
+ * @brief complete the current message
+ *
+ * This function reports the result of the current message
+ *
+ *****************************************************************************/
+static void CompleteMessage( void )
+{
+  #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
+    DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0020, tCurMessage.tDaliXmtRcvMsg.eStatus );
+  #endif // DALIBUSMASTER_ENABLE_DEBUG
+
+  // post the response
+  DALIBusMaster_QueuePutRcvMsg( &tCurMessage );
+}
+
+/******************************************************************************
+ * @function SendFrame
+ *
+ * @brief send the current frame
+ *
+ * This function arms the echo receive and sends the current message
+ *
+ *****************************************************************************/
+static void SendFrame( void )
+{
+  // clear the local/receive messages
+  memset( &tLclRcvMsg, 0, DALIXMTMSG_SIZE );
+
+  // now send the message
+  DALIBusMaster_Receive(( PU8 )&tLclRcvMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
+  DALIBusMaster_Transmit(( PU8 )&tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
+
+  // start a timer
+  DALIBusMaster_XmtTaskTimer( ON, XMITECHO_WAIT_TIME_MS );
+}
+
+/******************************************************************************
+ * @function StartNextMessage
+ *
+ * @brief start the next message
+ *
+ * This function takes messages from the queue until one can be sent, messages
+ * that can not be sent are completed with an error.  If the queue is empty the
+ * control is told the transmitter is done
+ *
+ * @return      next state
+ *
+ *****************************************************************************/
+static U8 StartNextMessage( void )
+{
+  U8  nNextState = XMT_STATE_IDLE;
+
+  // while no message has been started
+  while (( nNextState == XMT_STATE_IDLE ) && ( GetNextMessage( )))
+  {
+    // check for a answer/repeat
+    eAnswerExp = CheckForAnswer( &tCurMessage.tDaliXmtRcvMsg.tXmtMsg );
+    bRepeatCmd = CheckForRepeat( &tCurMessage.tDaliXmtRcvMsg.tXmtMsg );
+
+    #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
+      DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0010, bRepeatCmd << 4 | eAnswerExp );
+      DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0080, (( tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ] << 8 ) | tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 1 ] ));
+    #endif // DALIBUSMASTER_ENABLE_DEBUG
+
+    // test for bus error/illegal query operation
+    if ( bBusError )
+    {
+      // report it
+      tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_BUSMONITORBAD;
+      CompleteMessage( );
+    }
+    else if ( eAnswerExp == RSP_TYPE_ERROR )
+    {
+      // report it
+      tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_ILLOPERATION;
+      CompleteMessage( );
+    }
+    else
+    {
+      // send it
+      SendFrame( );
+      nNextState = XMT_STATE_WAITXMTDONE;
+    }
+  }
+
+  // if nothing was sent, tell the control
+  if ( nNextState == XMT_STATE_IDLE )
+  {
+    DALIBusMaster_PostCtlTask( DALIBUSMASTER_CTLEVENT_DONE );
+  }
+
+  // return the next state
+  return( nNextState );
+}
+
+/******************************************************************************
+ * @function FinishFrame
+ *
+ * @brief finish a frame
+ *
+ * This function is called when the current frame is done.  The first frame
+ * of a good send twice command waits the settling time for its repeat, any
+ * other frame completes the message so the result is reported while the bus
+ * settles
+ *
+ * @return      next state
+ *
+ *****************************************************************************/
+static U8 FinishFrame( void )
+{
+  U8  nNextState;
+
+  // check for a pending repeat
+  if (( bRepeatCmd ) && ( tCurMessage.tDaliXmtRcvMsg.eStatus == DALIBUSMASTER_STS_NOERROR ))
+  {
+    // wait for the settling time before repeating
+    nNextState = XMT_STATE_WAITFRMTIME;
+  }
+  else
+  {
+    // complete the message
+    bRepeatCmd = FALSE;
+    CompleteMessage( );
+
+    // a backward frame has a shorter settling time
+    nNextState = ( tCurMessage.tDaliXmtRcvMsg.eStatus == DALIBUSMASTER_STS_NOERRRCV ) ? XMT_STATE_WAITBFMTIME : XMT_STATE_WAITFRMTIME;
+  }
+
+  // return the next state
+  return( nNextState );
+}
+
 //******************************************************************************
 // Ctl wait state functions
 //******************************************************************************
 static void CtlStateWaitEnty( void )
 {
-  // Get the response to the DALI message
-  DALIBusMaster_QueueGetXmtMsg( &tCurMessage );
-  tCurMessage.tDaliXmtRcvMsg.nRcvMsg = 0;
-
-  // now send it
+  // clear the posted flag/start the transmitter
+  bCtlPosted = FALSE;
   DALIBusMaster_PostXmtTask( DALIBUSMASTER_XMTEVENT_START );
 }
 
 static U8 CtlStateWaitExec( STATEEXECENGARG xArg )
 {
-  U8              nNextState = 	STATEEXECENG_STATE_NONE;
-  PVDALIBUSMSTRCB pvRcvCallback;
+  U8  nNextState = STATEEXECENG_STATE_NONE;
 
   // process the argument
   switch( xArg )
   {
     case DALIBUSMASTER_CTLEVENT_DONE :
-      // post the response
-      DALIBusMaster_OutputRcvMsg( &tCurMessage );
-
-      // set next state back to idle
-      nNextState = CTL_STATE_IDLE;
+      // restart if a message arrived while the transmitter was stopping
+      if ( nXmtQueueCount != 0 )
+      {
+        DALIBusMaster_PostXmtTask( DALIBUSMASTER_XMTEVENT_START );
+      }
+      else
+      {
+        // set next state back to idle
+        nNextState = CTL_STATE_IDLE;
+      }
       break;
 
     default :
@@ -550,64 +868,11 @@ static U8 XmtStateIdleExc( STATEEXECENGARG xArg )
   // check the argument
   if ( xArg == DALIBUSMASTER_XMTEVENT_START )
   {
-    // get the message from the quque
-    DALIBusMaster_QueueGetXmtMsg( &tCurMessage );
-
-    // test for bus error
-    if ( bBusError )
-    {
-      // set the error state
-      tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_BUSMONITORBAD;
-      
-      // post the error event
-      #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
-        DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0021, tCurMessage.tDaliXmtRcvMsg.eStatus );
-      #endif // DALIBUSMASTER_ENABLE_DEBUG
-      
-      // set the done event in the bus state machine
-      DALIBusMaster_PostCtlTask( DALIBUSMASTER_CTLEVENT_DONE );
-      
-      // do not execute the exit function
-      tXmtStateCtl.bExecExit = FALSE;
-    }
-    else
+    // start the next message
+    if (( nNextState = StartNextMessage( )) == XMT_STATE_IDLE )
     {
-      // clear the local/receive messages
-      memset( &tLclRcvMsg, 0, DALIXMTMSG_SIZE );
-  
-      // check for a answer
-      eAnswerExp = CheckForAnswer( &tCurMessage.tDaliXmtRcvMsg.tXmtMsg );
-
-      // check for a repeat
-      bRepeatCmd = CheckForRepeat( &tCurMessage.tDaliXmtRcvMsg.tXmtMsg );
-
-      #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
-        DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0010, bRepeatCmd << 4 | eAnswerExp );
-        DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0080, (( tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ] << 8 ) | tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 1 ] ));
-      #endif // DALIBUSMASTER_ENABLE_DEBUG
-
-      // now check for an illegal query operation
-      if ( eAnswerExp == RSP_TYPE_ERROR )
-      {
-        // set the error state
-        tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_ILLOPERATION;
-    
-        // post the error event
-        #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
-          DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0021, tCurMessage.tDaliXmtRcvMsg.eStatus );
-        #endif // DALIBUSMASTER_ENABLE_DEBUG
-    
-        // set the done event in the bus state machine
-        DALIBusMaster_PostCtlTask( DALIBUSMASTER_CTLEVENT_DONE );
-      
-        // do not execute the exit function
-        tXmtStateCtl.bExecExit = FALSE;
-      }
-      else
-      {
-        // set the state to wait exit
-        nNextState = XMT_STATE_WAITXMTDONE;
-      }
+      // stay here
+      nNextState = STATEEXECENG_STATE_NONE;
     }
   }
  
@@ -615,16 +880,6 @@ static U8 XmtStateIdleExc( STATEEXECENGARG xArg )
   return( nNextState );
 }
 
-static void XmtStateIdleExt( void )
-{
-  // now send the message
-  DALIBusMaster_ManReceive(( PU8 )&tLclRcvMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
-  DALIBusMaster_ManTransmit(( PU8 )&tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
-
-  // start a timer
-  DALIBusMaster_XmtTaskTimer( ON, XMITECHO_WAIT_TIME_MS );
-}
-
 /******************************************************************************
  * XMT_STATE_WAITXMTDONE functions
  *****************************************************************************/
@@ -634,7 +889,7 @@ static void XmtStateWaitXmtDoneEnt( void )
   tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_TMOXMT;
 }
 
-static BOOL XmtStateWaitXmtDoneExc( STATEEXECENGARG xArg )
+static U8 XmtStateWaitXmtDoneExc( STATEEXECENGARG xArg )
 {
   U8  nNextState = STATEEXECENG_STATE_NONE;
   
@@ -643,12 +898,16 @@ static BOOL XmtStateWaitXmtDoneExc( STATEEXECENGARG xArg )
   {
     case DALIBUSMASTER_XMTEVENT_MANXMTDONE :
       nNextState = XMT_STATE_WAITXMTECHO; 
-      tXmtStateCtl.bExecExit = FALSE;
       break;
       
     case DALIBUSMASTER_XMTEVENT_MANRCVEROR :
-      nNextState = XMT_STATE_IDLE;
+      DALIBusMaster_XmtTaskTimer( OFF, 0 );
       tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_BUSERR;
+      nNextState = FinishFrame( );
+      break;
+
+    case TASK_TIMEOUT_EVENT :
+      nNextState = FinishFrame( );
       break;
     
     default :
@@ -668,7 +927,7 @@ static void XmtStateWaitXmtEchoEnt( void )
   tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_BUSERR;
 }
 
-static BOOL XmtStateWaitXmtEchoExc( STATEEXECENGARG xArg )
+static U8 XmtStateWaitXmtEchoExc( STATEEXECENGARG xArg )
 {
   U8  nNextState = STATEEXECENG_STATE_NONE;
   
@@ -685,7 +944,7 @@ static BOOL XmtStateWaitXmtEchoExc( STATEEXECENGARG xArg )
       // compare for equal
       if ( memcmp( &tLclRcvMsg, &tCurMessage.tDaliXmtRcvMsg.tXmtMsg, DALIXMTMSG_SIZE ) == 0 )
       {
-        // good compare - determine if we are to wait for an echo
+        // good compare - determine if we are to wait for an answer
         if ( eAnswerExp != RSP_TYPE_NONE )
         {
           // next state is rcv done
@@ -693,21 +952,25 @@ static BOOL XmtStateWaitXmtEchoExc( STATEEXECENGARG xArg )
         }
         else
         {
-          // next state is wait frm time/clear error
-          nNextState = XMT_STATE_WAITFRMTIME;
+          // clear error/finish the frame
           tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_NOERROR;
+          nNextState = FinishFrame( );
         }
-        tXmtStateCtl.bExecExit = FALSE;
       }
       else
       {
         // set the compare error
         tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_CMPERR;
-        
-        // set the idle state
-        nNextState = XMT_STATE_IDLE;
+        nNextState = FinishFrame( );
       }
       break;
+
+    case DALIBUSMASTER_XMTEVENT_MANRCVEROR :
+    case TASK_TIMEOUT_EVENT :
+      // no echo
+      DALIBusMaster_XmtTaskTimer( OFF, 0 );
+      nNextState = FinishFrame( );
+      break;
       
     default :
       break;
@@ -717,21 +980,20 @@ static BOOL XmtStateWaitXmtEchoExc( STATEEXECENGARG xArg )
   return( nNextState );
 }
 
-
 /******************************************************************************
  * XMT_STATE_WAITRCVDONE functions
  *****************************************************************************/
 static void XmtStateWaitRcvDoneEnt( void )
 {
   // start a receive
-  DALIBusMaster_ManReceive( &tCurMessage.tDaliXmtRcvMsg.nRcvMsg, DALI_RESPONSE_SIZE );
+  DALIBusMaster_Receive( &tCurMessage.tDaliXmtRcvMsg.nRcvMsg, DALI_RESPONSE_SIZE );
   tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_TMORCV;
 
   // start a timer
   DALIBusMaster_XmtTaskTimer( ON, RECV_WAIT_TIME_MS );
 }
 
-static BOOL XmtStateWaitRcvDoneExc( STATEEXECENGARG xArg )
+static U8 XmtStateWaitRcvDoneExc( STATEEXECENGARG xArg )
 {
   U8  nNextState = STATEEXECENG_STATE_NONE;
   
@@ -744,26 +1006,26 @@ static BOOL XmtStateWaitRcvDoneExc( STATEEXECENGARG xArg )
       break;
     
     case DALIBUSMASTER_XMTEVENT_MANRCVDONE :
-      // stop the timer/set the answer rcvd flag/go to idle/
+      // stop the timer/set the answer rcvd flag
       DALIBusMaster_XmtTaskTimer( OFF, 0 );
-      nNextState = XMT_STATE_WAITBFMTIME;
       tCurMessage.tDaliXmtRcvMsg.eStatus = DALIBUSMASTER_STS_NOERRRCV;
-      tXmtStateCtl.bExecExit = FALSE;
+      nNextState = FinishFrame( );
       break;
 
     case DALIBUSMASTER_XMTEVENT_MANRCVEROR :
-      // go to wait frametime/set the error status/clear the repeat command
-      nNextState = XMT_STATE_WAITFRMTIME;
+      // set the error status/clear the repeat command
+      DALIBusMaster_XmtTaskTimer( OFF, 0 );
       tCurMessage.tDaliXmtRcvMsg.eStatus = ( bEdgeEvent ) ? DALIBUSMASTER_STS_COLLISION : DALIBUSMASTER_STS_TMORCV;
       bRepeatCmd = FALSE;
-      tXmtStateCtl.bExecExit = FALSE;
+      nNextState = FinishFrame( );
       break;
       
     case TASK_TIMEOUT_EVENT :
-      // stop the receive/go to wait frametime/set the error status/clear the repeat command/
+      // stop the receive/set the error status/clear the repeat command
       DALIBusMaster_StopReceive( );
-      nNextState = XMT_STATE_IDLE;
       tCurMessage.tDaliXmtRcvMsg.eStatus = ( eAnswerExp == RSP_TYPE_REQUIRED ) ? DALIBUSMASTER_STS_TMORCV : DALIBUSMASTER_STS_NOERRNORCV;
+      bRepeatCmd = FALSE;
+      nNextState = FinishFrame( );
       break;
     
     default :
@@ -780,7 +1042,7 @@ static BOOL XmtStateWaitRcvDoneExc( STATEEXECENGARG xArg )
 static void XmtStateWaitFrmTimeEnt( void )
 {
   // start a timer
-  DALIBusMaster_XmtTaskTimer( ON, INTERFRAME_WAIT_TIME_MS );
+  DALIBusMaster_XmtTaskTimer( ON, DALIBUSMASTER_FWDSETTLE_TIME_MS );
 }
 
 static U8 XmtStateWaitFrmTimeExc( STATEEXECENGARG xArg )
@@ -797,32 +1059,16 @@ static U8 XmtStateWaitFrmTimeExc( STATEEXECENGARG xArg )
         #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
           DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE, 0 );
         #endif // DALIBUSMASTER_ENABLE_DEBUG
-        // clear the command
+        // clear the command/send it again before anything else
         bRepeatCmd = FALSE;
-
-        // clear the local/receive messages
-        memset( &tLclRcvMsg, 0, DALIXMTMSG_SIZE );
-      
-        // now send the message
-        DALIBusMaster_ManReceive(( PU8 )&tLclRcvMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
-        DALIBusMaster_ManTransmit(( PU8 )&tCurMessage.tDaliXmtRcvMsg.tXmtMsg.anBuffer[ 0 ], DALIXMTMSG_SIZE );
-
-        // start a timer
-        DALIBusMaster_XmtTaskTimer( ON, XMITECHO_WAIT_TIME_MS );
-
-        // set state back to wait transmit
+        SendFrame( );
         nNextState = XMT_STATE_WAITXMTDONE;
-
-        // do not execute exit
-        tXmtStateCtl.bExecExit = FALSE;
       }
       else
       {
-        // set state back to idle/ execute the exit
-        nNextState = XMT_STATE_IDLE;
-        tXmtStateCtl.bExecExit = TRUE;
+        // start the next message
+        nNextState = StartNextMessage( );
       }
-
       break;
 
     default :
@@ -839,7 +1085,7 @@ static U8 XmtStateWaitFrmTimeExc( STATEEXECENGARG xArg )
 static void XmtStateWaitBfmTimeEnt( void )
 {
   // start a timer
-  DALIBusMaster_XmtTaskTimer( ON, BACKFRM_WAIT_TIME_MS);
+  DALIBusMaster_XmtTaskTimer( ON, DALIBUSMASTER_BWDSETTLE_TIME_MS );
 }
 
 static U8 XmtStateWaitBfmTimeExc( STATEEXECENGARG xArg )
@@ -850,9 +1096,8 @@ static U8 XmtStateWaitBfmTimeExc( STATEEXECENGARG xArg )
   switch( xArg )
   {
     case TASK_TIMEOUT_EVENT :
-      // set state back to idle/execute the exit
-      nNextState = XMT_STATE_IDLE;
-      tXmtStateCtl.bExecExit = TRUE;
+      // start the next message
+      nNextState = StartNextMessage( );
       break;
 
     default :
@@ -863,17 +1108,4 @@ static U8 XmtStateWaitBfmTimeExc( STATEEXECENGARG xArg )
   return( nNextState );
 }
 
-/******************************************************************************
- * XMT_STATE_ANY_EXIT functions
- *****************************************************************************/
-static void XmtStateAnyExt( void )
-{
-  #if ( DALIBUSMASTER_ENABLE_DEBUG == 1 )
-    DebugManager_AddElement( DALIBUSMASTER_XMT_DEBUG_BASE | 0x0020, tCurMessage.tDaliXmtRcvMsg.eStatus );
-  #endif // DALIBUSMASTER_ENABLE_DEBUG
-
-  // set the done event in the bus state machine
-  DALIBusMaster_PostCtlTask( DALIBUSMASTER_CTLEVENT_DONE );
-}
-
 /**@} EOF DALIBusMaster.c */
@@ -140,6 +140,8 @@
 // global function prototypes --------------------------------------------------
 extern  BOOL  DALIBusMaster_Initialize( void );
 extern  BOOL  DALIBusMaster_TransmitMessage( PDALIXMTMSG ptMsg, PVDALIBUSMSTRCB pvCallback, U32 uOption );
+extern  BOOL  DALIBusMaster_TransmitMessagePriority( PDALIXMTMSG ptMsg, DALIBUSMASTERPRIO ePriority, PVDALIBUSMSTRCB pvCallback, U32 uOption );
+extern  U8    DALIBusMaster_GetQueueCount( void );
 extern  PC8   DALIBusMaster_GetStatusDescription( DALIBUSMASTERSTS eStatus );
 extern  U8    DALIBusMaster_GetDevPresentCnt( void );
 extern  void  DALIBusMaster_CtlEventHandler( DALIBUSMASTERARG xArg );
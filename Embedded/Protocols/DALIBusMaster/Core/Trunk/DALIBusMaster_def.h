@@ -47,9 +47,19 @@ typedef enum _DALIBUSMASTERSTS
   DALIBUSMASTER_STS_COLLISION,        ///< 0x07 - bus activity - collision
   DALIBUSMASTER_STS_ILLOPERATION,     ///< 0x08 - illegal operation, (i.e. a broadcast query request)
   DALIBUSMASTER_STS_BUSMONITORBAD,    ///< 0x09 - bus monitor indicates bad bus
+  DALIBUSMASTER_STS_SUPERSEDED,       ///< 0x0A - level replaced by a later level to the same address
   DALIBUSMASTER_STS_MAX,
 } DALIBUSMASTERSTS;
 
+/// enumerate the transmit priorities
+typedef enum _DALIBUSMASTERPRIO
+{
+  DALIBUSMASTER_PRIO_HIGH = 0,        ///< high priority, user interaction
+  DALIBUSMASTER_PRIO_NORMAL,          ///< normal priority
+  DALIBUSMASTER_PRIO_LOW,             ///< low priority, background polling
+  DALIBUSMASTER_PRIO_MAX
+} DALIBUSMASTERPRIO;
+
 /// enumerate the bus events
 typedef enum _DALIBUSMASTERCTLEVENT
 {
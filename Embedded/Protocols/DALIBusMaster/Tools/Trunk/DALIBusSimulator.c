@@ -0,0 +1,1022 @@
+/******************************************************************************
+ * @file DALIBusSimulator.c
+ *
+ * @brief DALI bus master simulator
+ *
+ * This file provides a host tool that runs the bus master against a simulated
+ * bus with a number of virtual control gear.  It replaces DALIBusMaster_cfg.c
+ * with a discrete event clock in microseconds, frames take their real time on
+ * the wire, gear answer queries and only accept configuration commands that
+ * are received twice.  Every forward frame is checked for the minimum
+ * settling time from the last frame on the bus.  The scenarios time a scene
+ * update to every gear, a rapid fade that relies on level collapsing, send
+ * twice commands with a high priority level injected between them, and a
+ * query of every gear.  It exits non zero if any check fails.
+ *
+ * build with: cc -O2 -I. -I<include root> -o DALIBusSimulator
+ *             DALIBusSimulator.c ../../Core/Trunk/DALIBusMaster.c
+ *             <StateExecutionEngine.c>
+ * usage:      DALIBusSimulator [gear count]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup DALIBusMaster
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "DALIBusMaster/DALIBusMaster.h"
+
+// library includes -----------------------------------------------------------
+#include "DebugManager/DebugManager.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the bit time, 2 Te of 416.67 usecs
+#define BIT_TIME_US                                 ( 833.33 )
+
+/// define the frame times from the first to the last edge
+#define FWD_FRAME_US                                (( U64 )( 17 * BIT_TIME_US ))
+#define BWD_FRAME_US                                (( U64 )( 9 * BIT_TIME_US ))
+
+/// define the gear response delay from the end of the forward frame
+#define GEAR_RESPONSE_US                            ( 5500 )
+
+/// define the minimum settling times after a forward/backward frame
+#define MIN_FWD_SETTLE_US                           ( 13500 )
+#define MIN_BWD_SETTLE_US                           ( 2400 )
+
+/// define the send twice window
+#define SEND_TWICE_WINDOW_US                        ( 100000 )
+
+/// define the limits
+#define MAX_EVENTS                                  ( 256 )
+#define MAX_FRAMES                                  ( 1024 )
+#define MAX_TOKENS                                  ( 1024 )
+#define NUM_SCENES                                  ( 16 )
+
+/// define the fade scenario
+#define FADE_NUM_GEAR                               ( 16 )
+#define FADE_NUM_STEPS                              ( 10 )
+#define FADE_STEP_US                                ( 100000 )
+
+/// define the send twice scenario
+#define TWICE_NUM_GEAR                              ( 8 )
+#define TWICE_SCENE                                 ( 3 )
+#define TWICE_INJECT_ADDR                           ( 20 )
+#define TWICE_INJECT_LEVEL                          ( 77 )
+
+/// define the DALI address bytes
+#define ADDR_SHORT_LEVEL( a )                       (( U8 )(( a ) << 1 ))
+#define ADDR_SHORT_COMMAND( a )                     (( U8 )((( a ) << 1 ) | 1 ))
+#define ADDR_BROADCAST_LEVEL                        ( 0xFE )
+#define ADDR_BROADCAST_COMMAND                      ( 0xFF )
+#define ADDR_GROUP_COMMAND( g )                     (( U8 )( 0x81 | (( g ) << 1 )))
+
+/// define the gear commands that are modeled
+#define GEAR_CMD_GOTOSCENE                          ( 0x10 )
+#define GEAR_CMD_STOREDTRASSCENE                    ( 0x40 )
+#define GEAR_CMD_ADDTOGROUP                         ( 0x60 )
+#define GEAR_CMD_REMOVEFROMGROUP                    ( 0x70 )
+#define GEAR_CMD_CONFIG_FIRST                       ( 0x20 )
+#define GEAR_CMD_CONFIG_LAST                        ( 0x81 )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the event types
+typedef enum _EVTTYPE
+{
+  EVT_TYPE_CTL = 0,           ///< control task event
+  EVT_TYPE_XMT,               ///< transmit task event
+  EVT_TYPE_RCV,               ///< receive event, dropped if no receive is armed
+  EVT_TYPE_APP,               ///< application function
+} EVTTYPE;
+
+// structures -----------------------------------------------------------------
+/// define the application function
+typedef void ( *PVAPPFUNC )( U32 uArg );
+
+/// define the event
+typedef struct _SIMEVENT
+{
+  U64       hTime;              ///< time in usecs
+  U32       uSequence;          ///< sequence, orders events at the same time
+  EVTTYPE   eType;              ///< type
+  U16       wArg;               ///< task argument
+  U8        anData[ 2 ];        ///< receive data
+  U8        nLength;            ///< receive length
+  PVAPPFUNC pvFunc;             ///< application function
+  U32       uArg;               ///< application argument
+  BOOL      bInUse;             ///< event in use
+} SIMEVENT, *PSIMEVENT;
+
+/// define the gear
+typedef struct _GEAR
+{
+  U8        nShortAddr;         ///< short address
+  U16       wGroups;            ///< group membership
+  U8        nLevel;             ///< actual level
+  U8        nDtr;               ///< data transfer register
+  U8        anScenes[ NUM_SCENES ]; ///< scene levels
+} GEAR;
+
+/// define a frame on the bus
+typedef struct _FRAME
+{
+  U64       hTime;              ///< start time
+  U8        anData[ 2 ];        ///< data
+} FRAME;
+
+/// define the result of a message
+typedef struct _RESULT
+{
+  DALIBUSMASTERSTS  eStatus;    ///< status
+  U8                nData;      ///< received data
+  U8                nCount;     ///< number of completions
+  U64               hTime;      ///< completion time
+} RESULT;
+
+// local parameter declarations -----------------------------------------------
+static  U64       hNow;
+static  U32       uEventSequence;
+static  SIMEVENT  atEvents[ MAX_EVENTS ];
+static  BOOL      bTimerOn;
+static  U64       hTimerTime;
+static  PU8       pnRcvBuffer;
+static  U8        nRcvLength;
+static  BOOL      bRcvArmed;
+static  U64       hBusIdleTime;
+static  BOOL      bBusBackward;
+static  BOOL      bBusUsed;
+static  U8        anTwicePending[ 2 ];
+static  U64       hTwiceTime;
+static  BOOL      bTwicePending;
+static  GEAR      atGear[ DALI_MAX_NUM_OF_DEVICES ];
+static  U8        nNumGear;
+static  FRAME     atFrames[ MAX_FRAMES ];
+static  U16       wNumFrames;
+static  RESULT    atResults[ MAX_TOKENS ];
+static  U16       wNumSuperseded;
+static  U16       wSettleErrors;
+static  BOOL      bInjectArmed;
+static  U16       wFailures;
+
+// local function prototypes --------------------------------------------------
+static  void      PostEvent( U64 hTime, EVTTYPE eType, U16 wArg, PU8 pnData, U8 nLength, PVAPPFUNC pvFunc, U32 uArg );
+static  void      Run( void );
+static  void      Reset( void );
+static  void      Check( BOOL bCondition, const char* pszText, unsigned uValue );
+static  BOOL      Send( U8 nAddr, U8 nData, DALIBUSMASTERPRIO ePriority, U16 wToken );
+static  void      Callback( DALIBUSMASTERSTS eStatus, U8 nData );
+static  void      GearFrame( U32 uFrame );
+static  BOOL      GearMatch( GEAR* ptGear, U8 nAddr );
+static  U64       LastCompletion( U16 wFirst, U16 wCount );
+static  void      FadeStep( U32 uStep );
+static  void      Inject( U32 uArg );
+static  void      SceneUpdate( void );
+static  void      Fade( void );
+static  void      Ordering( void );
+static  void      SendTwice( void );
+static  void      Queries( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * This function sets up the gear and runs the scenarios
+ *
+ * @param[in]   argc        argument count
+ * @param[in]   argv        arguments
+ *
+ * @return      0 if all checks passed
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  U8  nIdx;
+
+  // get the gear count
+  nNumGear = ( argc > 1 ) ? ( U8 )atoi( argv[ 1 ] ) : DALI_MAX_NUM_OF_DEVICES;
+  if (( nNumGear == 0 ) || ( nNumGear > DALI_MAX_NUM_OF_DEVICES ))
+  {
+    fprintf( stderr, "usage: %s [gear count 1-%d]\n", argv[ 0 ], DALI_MAX_NUM_OF_DEVICES );
+    return( 1 );
+  }
+
+  // set up the gear
+  for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+  {
+    atGear[ nIdx ].nShortAddr = nIdx;
+    atGear[ nIdx ].wGroups = 1 << ( nIdx % DALI_MAX_NUM_OF_GROUPS );
+    atGear[ nIdx ].nLevel = 0;
+    memset( atGear[ nIdx ].anScenes, 0xFF, NUM_SCENES );
+  }
+
+  // initialize the master
+  DALIBusMaster_Initialize( );
+  printf( "%u gear, forward frame %.2f ms, settling %d/%d ms\n", nNumGear, FWD_FRAME_US / 1000.0, DALIBUSMASTER_FWDSETTLE_TIME_MS, DALIBUSMASTER_BWDSETTLE_TIME_MS );
+
+  // run the scenarios
+  SceneUpdate( );
+  Fade( );
+  Ordering( );
+  SendTwice( );
+  Queries( );
+
+  // report
+  Check( wSettleErrors == 0, "settling time violations", wSettleErrors );
+  printf( "%s, %u failures\n", ( wFailures == 0 ) ? "PASS" : "FAIL", wFailures );
+  return(( wFailures == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function SceneUpdate
+ *
+ * @brief scene update scenario
+ *
+ * This function sends a level to every gear and times it
+ *
+ *****************************************************************************/
+static void SceneUpdate( void )
+{
+  U8  nIdx;
+  U64 hStart, hElapsed;
+
+  // queue a level to every gear
+  Reset( );
+  hStart = hNow;
+  for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+  {
+    Check( !Send( ADDR_SHORT_LEVEL( nIdx ), 10 + ( nIdx * 3 ), DALIBUSMASTER_PRIO_NORMAL, nIdx ), "scene update queue full", nIdx );
+  }
+  Run( );
+
+  // check the results
+  for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+  {
+    Check( atResults[ nIdx ].eStatus == DALIBUSMASTER_STS_NOERROR, "scene update status", nIdx );
+    Check( atGear[ nIdx ].nLevel == 10 + ( nIdx * 3 ), "scene update level", nIdx );
+  }
+  Check( wNumFrames == nNumGear, "scene update frames", wNumFrames );
+
+  // report the time, the frame rate is from the frame starts
+  hElapsed = LastCompletion( 0, nNumGear ) - hStart;
+  printf( "scene update: %u frames in %.1f ms, %.2f ms/frame, minimum %.2f ms/frame\n",
+          wNumFrames, hElapsed / 1000.0, ( wNumFrames > 1 ) ? ( atFrames[ wNumFrames - 1 ].hTime - atFrames[ 0 ].hTime ) / 1000.0 / ( wNumFrames - 1 ) : 0.0,
+          ( FWD_FRAME_US + MIN_FWD_SETTLE_US ) / 1000.0 );
+}
+
+/******************************************************************************
+ * @function Fade
+ *
+ * @brief fade scenario
+ *
+ * This function steps a group of gear through a fade faster than the bus can
+ * send it, stale levels are collapsed
+ *
+ *****************************************************************************/
+static void Fade( void )
+{
+  U8  nIdx, nNumFade = MIN( FADE_NUM_GEAR, nNumGear );
+  U64 hStart, hElapsed;
+
+  // post the steps
+  Reset( );
+  hStart = hNow;
+  for ( nIdx = 0; nIdx < FADE_NUM_STEPS; nIdx++ )
+  {
+    PostEvent( hStart + ( nIdx * FADE_STEP_US ), EVT_TYPE_APP, 0, NULL, 0, FadeStep, nIdx );
+  }
+  Run( );
+
+  // check the results
+  for ( nIdx = 0; nIdx < nNumFade; nIdx++ )
+  {
+    Check( atGear[ nIdx ].nLevel == FADE_NUM_STEPS * 20, "fade level", nIdx );
+  }
+  Check( wNumFrames + wNumSuperseded == nNumFade * FADE_NUM_STEPS, "fade accounting", wNumFrames );
+
+  // report the time
+  hElapsed = LastCompletion( 0, nNumFade * FADE_NUM_STEPS ) - hStart;
+  printf( "fade: %u levels requested, %u sent, %u superseded, done in %.1f ms, %.1f ms without collapsing\n",
+          nNumFade * FADE_NUM_STEPS, wNumFrames, wNumSuperseded, hElapsed / 1000.0,
+          ( nNumFade * FADE_NUM_STEPS * ( FWD_FRAME_US + DALIBUSMASTER_FWDSETTLE_TIME_MS * 1000 )) / 1000.0 );
+}
+
+/******************************************************************************
+ * @function FadeStep
+ *
+ * @brief fade step
+ *
+ * This function queues one fade step
+ *
+ * @param[in]   uStep       step
+ *
+ *****************************************************************************/
+static void FadeStep( U32 uStep )
+{
+  U8  nIdx, nNumFade = MIN( FADE_NUM_GEAR, nNumGear );
+
+  // queue the level to each gear
+  for ( nIdx = 0; nIdx < nNumFade; nIdx++ )
+  {
+    Check( !Send( ADDR_SHORT_LEVEL( nIdx ), ( uStep + 1 ) * 20, DALIBUSMASTER_PRIO_NORMAL, ( uStep * nNumFade ) + nIdx ), "fade queue full", uStep );
+  }
+}
+
+/******************************************************************************
+ * @function Ordering
+ *
+ * @brief ordering scenario
+ *
+ * This function checks that levels are only collapsed when nothing that may
+ * reach the same gear is waiting behind them
+ *
+ *****************************************************************************/
+static void Ordering( void )
+{
+  U8  nIdx;
+
+  // a command between two levels keeps both
+  Reset( );
+  Send( ADDR_SHORT_LEVEL( 0 ), 100, DALIBUSMASTER_PRIO_NORMAL, 0 );
+  Send( ADDR_SHORT_COMMAND( 0 ), DALI_CMD_OFF, DALIBUSMASTER_PRIO_NORMAL, 1 );
+  Send( ADDR_SHORT_LEVEL( 0 ), 200, DALIBUSMASTER_PRIO_NORMAL, 2 );
+  Run( );
+  Check(( wNumFrames == 3 ) && ( wNumSuperseded == 0 ), "command between levels frames", wNumFrames );
+  Check( atGear[ 0 ].nLevel == 200, "command between levels level", atGear[ 0 ].nLevel );
+
+  // a broadcast between two levels keeps both
+  Reset( );
+  Send( ADDR_SHORT_LEVEL( 0 ), 50, DALIBUSMASTER_PRIO_NORMAL, 0 );
+  Send( ADDR_BROADCAST_LEVEL, 30, DALIBUSMASTER_PRIO_NORMAL, 1 );
+  Send( ADDR_SHORT_LEVEL( 0 ), 70, DALIBUSMASTER_PRIO_NORMAL, 2 );
+  Run( );
+  Check(( wNumFrames == 3 ) && ( wNumSuperseded == 0 ), "broadcast between levels frames", wNumFrames );
+  Check( atGear[ 0 ].nLevel == 70, "broadcast between levels level", atGear[ 0 ].nLevel );
+  for ( nIdx = 1; nIdx < nNumGear; nIdx++ )
+  {
+    Check( atGear[ nIdx ].nLevel == 30, "broadcast level", nIdx );
+  }
+
+  // back to back levels collapse, and a higher priority raises the entry
+  Reset( );
+  Send( ADDR_SHORT_LEVEL( 1 ), 10, DALIBUSMASTER_PRIO_LOW, 0 );
+  Send( ADDR_SHORT_LEVEL( 2 ), 20, DALIBUSMASTER_PRIO_NORMAL, 1 );
+  Send( ADDR_SHORT_LEVEL( 1 ), 11, DALIBUSMASTER_PRIO_LOW, 2 );
+  Send( ADDR_SHORT_LEVEL( 1 ), 12, DALIBUSMASTER_PRIO_HIGH, 3 );
+  Run( );
+  Check(( wNumFrames == 2 ) && ( wNumSuperseded == 2 ), "collapse frames", wNumFrames );
+  Check(( atResults[ 0 ].eStatus == DALIBUSMASTER_STS_SUPERSEDED ) && ( atResults[ 2 ].eStatus == DALIBUSMASTER_STS_SUPERSEDED ), "collapse status", 0 );
+  Check(( atFrames[ 0 ].anData[ 0 ] == ADDR_SHORT_LEVEL( 1 )) && ( atFrames[ 0 ].anData[ 1 ] == 12 ), "collapse priority", atFrames[ 0 ].anData[ 1 ] );
+  printf( "ordering: collapse rules ok\n" );
+}
+
+/******************************************************************************
+ * @function SendTwice
+ *
+ * @brief send twice scenario
+ *
+ * This function stores a scene in each gear with DTR/store DTR as scene and
+ * injects a high priority level when the first store frame goes out, the
+ * pair must not be split
+ *
+ *****************************************************************************/
+static void SendTwice( void )
+{
+  U8  nIdx, nNumTwice = MIN( TWICE_NUM_GEAR, nNumGear );
+  U16 wFrame, wInject = MAX_FRAMES, wLastDtr = 0;
+
+  // queue the DTR/store pairs
+  Reset( );
+  for ( nIdx = 0; nIdx < nNumTwice; nIdx++ )
+  {
+    Send( DALI_CMD_DTR, 100 + nIdx, DALIBUSMASTER_PRIO_NORMAL, nIdx * 2 );
+    Send( ADDR_SHORT_COMMAND( nIdx ), GEAR_CMD_STOREDTRASSCENE | TWICE_SCENE, DALIBUSMASTER_PRIO_NORMAL, ( nIdx * 2 ) + 1 );
+  }
+  bInjectArmed = TRUE;
+  Run( );
+
+  // check the frames
+  for ( wFrame = 0; wFrame < wNumFrames; wFrame++ )
+  {
+    if (( atFrames[ wFrame ].anData[ 1 ] == ( GEAR_CMD_STOREDTRASSCENE | TWICE_SCENE )) && (( atFrames[ wFrame ].anData[ 0 ] & 1 ) != 0 ))
+    {
+      // must be followed by the same frame
+      Check(( wFrame + 1 < wNumFrames ) && ( memcmp( atFrames[ wFrame ].anData, atFrames[ wFrame + 1 ].anData, 2 ) == 0 ), "send twice split", wFrame );
+      wFrame++;
+    }
+    else if ( atFrames[ wFrame ].anData[ 0 ] == ADDR_SHORT_LEVEL( TWICE_INJECT_ADDR % nNumGear ))
+    {
+      wInject = wFrame;
+    }
+    else if ( atFrames[ wFrame ].anData[ 0 ] == DALI_CMD_DTR )
+    {
+      wLastDtr = wFrame;
+    }
+  }
+  Check( wInject < wLastDtr, "high priority not ahead", wInject );
+  for ( nIdx = 0; nIdx < nNumTwice; nIdx++ )
+  {
+    Check( atGear[ nIdx ].anScenes[ TWICE_SCENE ] == 100 + nIdx, "send twice scene", nIdx );
+  }
+
+  // recall the scene
+  Reset( );
+  Send( ADDR_BROADCAST_COMMAND, GEAR_CMD_GOTOSCENE | TWICE_SCENE, DALIBUSMASTER_PRIO_NORMAL, 0 );
+  Run( );
+  for ( nIdx = 0; nIdx < nNumTwice; nIdx++ )
+  {
+    Check( atGear[ nIdx ].nLevel == 100 + nIdx, "recall scene", nIdx );
+  }
+  printf( "send twice: %u pairs back to back, high priority level sent as frame %u\n", nNumTwice, wInject );
+}
+
+/******************************************************************************
+ * @function Inject
+ *
+ * @brief inject a level
+ *
+ * This function queues the high priority level
+ *
+ * @param[in]   uArg        unused
+ *
+ *****************************************************************************/
+static void Inject( U32 uArg )
+{
+  // queue it
+  Send( ADDR_SHORT_LEVEL( TWICE_INJECT_ADDR % nNumGear ), TWICE_INJECT_LEVEL, DALIBUSMASTER_PRIO_HIGH, 0x100 + uArg );
+}
+
+/******************************************************************************
+ * @function Queries
+ *
+ * @brief queries scenario
+ *
+ * This function queries the actual level of every address with the queue
+ * full, missing gear must time out and a group query is refused
+ *
+ *****************************************************************************/
+static void Queries( void )
+{
+  U8  nIdx;
+  U64 hStart, hElapsed;
+
+  // set known levels
+  for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+  {
+    atGear[ nIdx ].nLevel = 254 - nIdx;
+  }
+
+  // query every address
+  Reset( );
+  hStart = hNow;
+  for ( nIdx = 0; nIdx < DALI_MAX_NUM_OF_DEVICES; nIdx++ )
+  {
+    Send( ADDR_SHORT_COMMAND( nIdx ), DALI_CMD_QUERYACTUALLVL, DALIBUSMASTER_PRIO_LOW, nIdx );
+  }
+  Check( Send( ADDR_GROUP_COMMAND( 0 ), DALI_CMD_QUERYACTUALLVL, DALIBUSMASTER_PRIO_LOW, DALI_MAX_NUM_OF_DEVICES ), "queue full not reported", 0 );
+  Run( );
+
+  // check the results
+  for ( nIdx = 0; nIdx < DALI_MAX_NUM_OF_DEVICES; nIdx++ )
+  {
+    if ( nIdx < nNumGear )
+    {
+      Check(( atResults[ nIdx ].eStatus == DALIBUSMASTER_STS_NOERRRCV ) && ( atResults[ nIdx ].nData == 254 - nIdx ), "query answer", nIdx );
+    }
+    else
+    {
+      Check( atResults[ nIdx ].eStatus == DALIBUSMASTER_STS_TMORCV, "query missing gear", nIdx );
+    }
+  }
+  Check( wNumFrames == DALI_MAX_NUM_OF_DEVICES, "query frames", wNumFrames );
+  hElapsed = LastCompletion( 0, DALI_MAX_NUM_OF_DEVICES ) - hStart;
+
+  // a group query is refused without a frame
+  Reset( );
+  Send( ADDR_GROUP_COMMAND( 0 ), DALI_CMD_QUERYACTUALLVL, DALIBUSMASTER_PRIO_LOW, 0 );
+  Run( );
+  Check(( atResults[ 0 ].eStatus == DALIBUSMASTER_STS_ILLOPERATION ) && ( wNumFrames == 0 ), "group query", atResults[ 0 ].eStatus );
+
+  // report the time
+  printf( "queries: %u answered in %.1f ms, %.2f ms/query\n", nNumGear, hElapsed / 1000.0, hElapsed / 1000.0 / DALI_MAX_NUM_OF_DEVICES );
+}
+
+/******************************************************************************
+ * @function Reset
+ *
+ * @brief reset the scenario counters
+ *
+ * This function clears the frames and the results
+ *
+ *****************************************************************************/
+static void Reset( void )
+{
+  // clear them
+  wNumFrames = 0;
+  wNumSuperseded = 0;
+  bInjectArmed = FALSE;
+  memset( atResults, 0, sizeof( atResults ));
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * This function reports a failed check
+ *
+ * @param[in]   bCondition  condition
+ * @param[in]   pszText     description
+ * @param[in]   uValue      value to display
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, const char* pszText, unsigned uValue )
+{
+  // report it
+  if ( !bCondition )
+  {
+    printf( "  FAILED: %s (%u)\n", pszText, uValue );
+    wFailures++;
+  }
+}
+
+/******************************************************************************
+ * @function Send
+ *
+ * @brief send a message
+ *
+ * This function queues a message to the bus master
+ *
+ * @param[in]   nAddr       address byte
+ * @param[in]   nData       data byte
+ * @param[in]   ePriority   priority
+ * @param[in]   wToken      result index
+ *
+ * @return      TRUE if the queue was full
+ *
+ *****************************************************************************/
+static BOOL Send( U8 nAddr, U8 nData, DALIBUSMASTERPRIO ePriority, U16 wToken )
+{
+  DALIXMTMSG  tMsg;
+
+  // build it/queue it
+  tMsg.anBuffer[ 0 ] = nAddr;
+  tMsg.anBuffer[ 1 ] = nData;
+  return( DALIBusMaster_TransmitMessagePriority( &tMsg, ePriority, Callback, wToken ));
+}
+
+/******************************************************************************
+ * @function Callback
+ *
+ * @brief message callback
+ *
+ * This function is the callback given to the bus master, the results are
+ * stored by DALIBusMaster_QueuePutRcvMsg which has the token
+ *
+ * @param[in]   eStatus     status
+ * @param[in]   nData       received data
+ *
+ *****************************************************************************/
+static void Callback( DALIBUSMASTERSTS eStatus, U8 nData )
+{
+  // the data is not used
+  ( void )nData;
+
+  // count the superseded ones
+  if ( eStatus == DALIBUSMASTER_STS_SUPERSEDED )
+  {
+    wNumSuperseded++;
+  }
+}
+
+/******************************************************************************
+ * @function LastCompletion
+ *
+ * @brief get the last completion
+ *
+ * This function returns the latest completion time of a range of results
+ *
+ * @param[in]   wFirst      first token
+ * @param[in]   wCount      number of tokens
+ *
+ * @return      time in usecs
+ *
+ *****************************************************************************/
+static U64 LastCompletion( U16 wFirst, U16 wCount )
+{
+  U64 hLast = 0;
+  U16 wIdx;
+
+  // find the latest
+  for ( wIdx = wFirst; wIdx < wFirst + wCount; wIdx++ )
+  {
+    Check( atResults[ wIdx ].nCount == 1, "message completions", wIdx );
+    hLast = MAX( hLast, atResults[ wIdx ].hTime );
+  }
+
+  // return it
+  return( hLast );
+}
+
+/******************************************************************************
+ * @function PostEvent
+ *
+ * @brief post an event
+ *
+ * This function adds an event to the event list
+ *
+ * @param[in]   hTime       time
+ * @param[in]   eType       type
+ * @param[in]   wArg        task argument
+ * @param[in]   pnData      pointer to the receive data
+ * @param[in]   nLength     receive length
+ * @param[in]   pvFunc      application function
+ * @param[in]   uArg        application argument
+ *
+ *****************************************************************************/
+static void PostEvent( U64 hTime, EVTTYPE eType, U16 wArg, PU8 pnData, U8 nLength, PVAPPFUNC pvFunc, U32 uArg )
+{
+  U16 wIdx;
+
+  // find a free event
+  for ( wIdx = 0; ( wIdx < MAX_EVENTS ) && ( atEvents[ wIdx ].bInUse ); wIdx++ );
+  if ( wIdx == MAX_EVENTS )
+  {
+    fprintf( stderr, "event list full\n" );
+    exit( 2 );
+  }
+
+  // fill it
+  atEvents[ wIdx ].hTime = hTime;
+  atEvents[ wIdx ].uSequence = uEventSequence++;
+  atEvents[ wIdx ].eType = eType;
+  atEvents[ wIdx ].wArg = wArg;
+  atEvents[ wIdx ].nLength = MIN( nLength, 2 );
+  if ( pnData != NULL )
+  {
+    memcpy( atEvents[ wIdx ].anData, pnData, atEvents[ wIdx ].nLength );
+  }
+  atEvents[ wIdx ].pvFunc = pvFunc;
+  atEvents[ wIdx ].uArg = uArg;
+  atEvents[ wIdx ].bInUse = TRUE;
+}
+
+/******************************************************************************
+ * @function Run
+ *
+ * @brief run the simulation
+ *
+ * This function dispatches events in time order until nothing is left
+ *
+ *****************************************************************************/
+static void Run( void )
+{
+  SIMEVENT  tEvent;
+  U16       wIdx, wBest;
+
+  // loop
+  FOREVER
+  {
+    // find the earliest event
+    wBest = MAX_EVENTS;
+    for ( wIdx = 0; wIdx < MAX_EVENTS; wIdx++ )
+    {
+      if (( atEvents[ wIdx ].bInUse ) &&
+          (( wBest == MAX_EVENTS ) || ( atEvents[ wIdx ].hTime < atEvents[ wBest ].hTime ) ||
+           (( atEvents[ wIdx ].hTime == atEvents[ wBest ].hTime ) && ( atEvents[ wIdx ].uSequence < atEvents[ wBest ].uSequence ))))
+      {
+        wBest = wIdx;
+      }
+    }
+
+    // the timer goes if it is earlier
+    if (( bTimerOn ) && (( wBest == MAX_EVENTS ) || ( hTimerTime < atEvents[ wBest ].hTime )))
+    {
+      bTimerOn = FALSE;
+      hNow = hTimerTime;
+      DALIBusMaster_XmtEventHandler( TASK_TIMEOUT_EVENT );
+    }
+    else if ( wBest != MAX_EVENTS )
+    {
+      // remove it
+      tEvent = atEvents[ wBest ];
+      atEvents[ wBest ].bInUse = FALSE;
+      hNow = tEvent.hTime;
+
+      // dispatch it
+      switch( tEvent.eType )
+      {
+        case EVT_TYPE_CTL :
+          DALIBusMaster_CtlEventHandler( tEvent.wArg );
+          break;
+
+        case EVT_TYPE_XMT :
+          DALIBusMaster_XmtEventHandler( tEvent.wArg );
+          break;
+
+        case EVT_TYPE_RCV :
+          // only with a receive armed
+          if ( bRcvArmed )
+          {
+            if ( tEvent.wArg == DALIBUSMASTER_XMTEVENT_MANRCVDONE )
+            {
+              // store the data
+              memcpy( pnRcvBuffer, tEvent.anData, MIN( tEvent.nLength, nRcvLength ));
+              bRcvArmed = FALSE;
+            }
+            else if ( tEvent.wArg == DALIBUSMASTER_XMTEVENT_MANRCVEROR )
+            {
+              bRcvArmed = FALSE;
+            }
+            DALIBusMaster_XmtEventHandler( tEvent.wArg );
+          }
+          break;
+
+        case EVT_TYPE_APP :
+          tEvent.pvFunc( tEvent.uArg );
+          break;
+
+        default :
+          break;
+      }
+    }
+    else
+    {
+      // done
+      break;
+    }
+  }
+}
+
+/******************************************************************************
+ * @function GearMatch
+ *
+ * @brief check the address of a gear
+ *
+ * This function checks if an address byte selects a gear
+ *
+ * @param[in]   ptGear      pointer to the gear
+ * @param[in]   nAddr       address byte
+ *
+ * @return      TRUE if selected
+ *
+ *****************************************************************************/
+static BOOL GearMatch( GEAR* ptGear, U8 nAddr )
+{
+  BOOL  bMatch = FALSE;
+
+  // determine the address type
+  if (( nAddr & 0x80 ) == 0 )
+  {
+    bMatch = ((( nAddr >> 1 ) & 0x3F ) == ptGear->nShortAddr );
+  }
+  else if (( nAddr & 0xE0 ) == 0x80 )
+  {
+    bMatch = (( ptGear->wGroups & ( 1 << (( nAddr >> 1 ) & 0x0F ))) != 0 );
+  }
+  else if (( nAddr & 0xFE ) == 0xFE )
+  {
+    bMatch = TRUE;
+  }
+
+  // return the match
+  return( bMatch );
+}
+
+/******************************************************************************
+ * @function GearFrame
+ *
+ * @brief process a forward frame in the gear
+ *
+ * This function executes a forward frame in every gear at the end of the
+ * frame and schedules the backward frame
+ *
+ * @param[in]   uFrame      frame index
+ *
+ *****************************************************************************/
+static void GearFrame( U32 uFrame )
+{
+  U8    nAddr = atFrames[ uFrame ].anData[ 0 ];
+  U8    nData = atFrames[ uFrame ].anData[ 1 ];
+  U8    nIdx, nAnswers = 0, nAnswer = 0;
+  BOOL  bConfig, bExecute = TRUE;
+  GEAR* ptGear;
+
+  // check for send twice
+  bConfig = ((( nAddr & 0x81 ) == 0x01 ) || (( nAddr & 0xE1 ) == 0x81 ) || ( nAddr == ADDR_BROADCAST_COMMAND )) &&
+            ( nData >= GEAR_CMD_CONFIG_FIRST ) && ( nData <= GEAR_CMD_CONFIG_LAST );
+  if ( bConfig )
+  {
+    // execute on the second identical frame only
+    bExecute = ( bTwicePending ) && ( memcmp( anTwicePending, atFrames[ uFrame ].anData, 2 ) == 0 ) && ( hNow - hTwiceTime <= SEND_TWICE_WINDOW_US );
+    bTwicePending = !bExecute;
+    memcpy( anTwicePending, atFrames[ uFrame ].anData, 2 );
+    hTwiceTime = hNow;
+  }
+  else
+  {
+    bTwicePending = FALSE;
+  }
+
+  // special commands
+  if ( nAddr == DALI_CMD_DTR )
+  {
+    for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+    {
+      atGear[ nIdx ].nDtr = nData;
+    }
+  }
+  else if ( bExecute )
+  {
+    // execute in each selected gear
+    for ( nIdx = 0; nIdx < nNumGear; nIdx++ )
+    {
+      ptGear = &atGear[ nIdx ];
+      if ( GearMatch( ptGear, nAddr ))
+      {
+        if (( nAddr & 1 ) == 0 )
+        {
+          // direct level
+          if ( nData != 0xFF )
+          {
+            ptGear->nLevel = nData;
+          }
+        }
+        else if ( nData == DALI_CMD_OFF )
+        {
+          ptGear->nLevel = 0;
+        }
+        else if ( nData == DALI_CMD_RECALLMAXLVL )
+        {
+          ptGear->nLevel = 254;
+        }
+        else if (( nData & 0xF0 ) == GEAR_CMD_GOTOSCENE )
+        {
+          if ( ptGear->anScenes[ nData & 0x0F ] != 0xFF )
+          {
+            ptGear->nLevel = ptGear->anScenes[ nData & 0x0F ];
+          }
+        }
+        else if (( nData & 0xF0 ) == GEAR_CMD_STOREDTRASSCENE )
+        {
+          ptGear->anScenes[ nData & 0x0F ] = ptGear->nDtr;
+        }
+        else if (( nData & 0xF0 ) == GEAR_CMD_ADDTOGROUP )
+        {
+          ptGear->wGroups |= 1 << ( nData & 0x0F );
+        }
+        else if (( nData & 0xF0 ) == GEAR_CMD_REMOVEFROMGROUP )
+        {
+          ptGear->wGroups &= ~( 1 << ( nData & 0x0F ));
+        }
+        else if ( nData == DALI_CMD_QUERYACTUALLVL )
+        {
+          nAnswer = ptGear->nLevel;
+          nAnswers++;
+        }
+        else if ( nData == DALI_CMD_QUERYCONTENTDTR )
+        {
+          nAnswer = ptGear->nDtr;
+          nAnswers++;
+        }
+      }
+    }
+  }
+
+  // schedule the backward frame, more than one answer collides
+  if ( nAnswers != 0 )
+  {
+    PostEvent( hNow + GEAR_RESPONSE_US, EVT_TYPE_RCV, DALIBUSMASTER_XMTEVENT_MANRCVEDGE, NULL, 0, NULL, 0 );
+    PostEvent( hNow + GEAR_RESPONSE_US + BWD_FRAME_US, EVT_TYPE_RCV, ( nAnswers == 1 ) ? DALIBUSMASTER_XMTEVENT_MANRCVDONE : DALIBUSMASTER_XMTEVENT_MANRCVEROR, &nAnswer, 1, NULL, 0 );
+    hBusIdleTime = hNow + GEAR_RESPONSE_US + BWD_FRAME_US;
+    bBusBackward = TRUE;
+  }
+}
+
+//******************************************************************************
+// bus master configuration functions
+//******************************************************************************
+void DALIBusMaster_Transmit( PU8 pnBuffer, U8 nLength )
+{
+  U64 hSettle = ( bBusBackward ) ? MIN_BWD_SETTLE_US : MIN_FWD_SETTLE_US;
+
+  // check the settling time
+  if (( bBusUsed ) && (( hNow < hBusIdleTime ) || ( hNow - hBusIdleTime < hSettle )))
+  {
+    printf( "  settling violation at %.3f ms\n", hNow / 1000.0 );
+    wSettleErrors++;
+  }
+
+  // log the frame
+  if ( wNumFrames < MAX_FRAMES )
+  {
+    atFrames[ wNumFrames ].hTime = hNow;
+    memcpy( atFrames[ wNumFrames ].anData, pnBuffer, MIN( nLength, 2 ));
+  }
+
+  // inject on the first send twice frame
+  if (( bInjectArmed ) && ( pnBuffer[ 1 ] == ( GEAR_CMD_STOREDTRASSCENE | TWICE_SCENE )))
+  {
+    bInjectArmed = FALSE;
+    PostEvent( hNow + 1000, EVT_TYPE_APP, 0, NULL, 0, Inject, 0 );
+  }
+
+  // done/echo at the end of the frame, then the gear
+  hBusIdleTime = hNow + FWD_FRAME_US;
+  bBusBackward = FALSE;
+  bBusUsed = TRUE;
+  PostEvent( hBusIdleTime, EVT_TYPE_XMT, DALIBUSMASTER_XMTEVENT_MANXMTDONE, NULL, 0, NULL, 0 );
+  PostEvent( hBusIdleTime, EVT_TYPE_RCV, DALIBUSMASTER_XMTEVENT_MANRCVDONE, pnBuffer, nLength, NULL, 0 );
+  PostEvent( hBusIdleTime, EVT_TYPE_APP, 0, NULL, 0, GearFrame, wNumFrames++ );
+}
+
+void DALIBusMaster_Receive( PU8 pnBuffer, U8 nLength )
+{
+  // arm it
+  pnRcvBuffer = pnBuffer;
+  nRcvLength = nLength;
+  bRcvArmed = TRUE;
+}
+
+void DALIBusMaster_StopReceive( void )
+{
+  // disarm it
+  bRcvArmed = FALSE;
+}
+
+BOOL DALIBusMaster_GetBusState( void )
+{
+  // bus is always good
+  return( FALSE );
+}
+
+BOOL DALIBusMaster_IsDebugMode( void )
+{
+  // never in debug
+  return( FALSE );
+}
+
+void DALIBusMaster_QueuePutRcvMsg( PDALIBUSMASTERMSG ptCurMessage )
+{
+  RESULT* ptResult;
+
+  // store the result
+  if ( ptCurMessage->uOption < MAX_TOKENS )
+  {
+    ptResult = &atResults[ ptCurMessage->uOption ];
+    ptResult->eStatus = ptCurMessage->tDaliXmtRcvMsg.eStatus;
+    ptResult->nData = ptCurMessage->tDaliXmtRcvMsg.nRcvMsg;
+    ptResult->hTime = hNow;
+    ptResult->nCount++;
+  }
+
+  // call the callback
+  if ( ptCurMessage->pvCallbackFunc != NULL )
+  {
+    ptCurMessage->pvCallbackFunc( ptCurMessage->tDaliXmtRcvMsg.eStatus, ptCurMessage->tDaliXmtRcvMsg.nRcvMsg );
+  }
+}
+
+void DALIBusMaster_PostCtlTask( DALIBUSMASTERCTLEVENT eEvent )
+{
+  // post it now
+  PostEvent( hNow, EVT_TYPE_CTL, ( U16 )eEvent, NULL, 0, NULL, 0 );
+}
+
+void DALIBusMaster_PostXmtTask( DALIBUSMASTERXMTEVENT eEvent )
+{
+  // post it now
+  PostEvent( hNow, EVT_TYPE_XMT, ( U16 )eEvent, NULL, 0, NULL, 0 );
+}
+
+void DALIBusMaster_XmtTaskTimer( BOOL bState, U32 uTimeMsecs )
+{
+  // set/clear the timer
+  bTimerOn = bState;
+  hTimerTime = hNow + (( U64 )uTimeMsecs * 1000 );
+}
+
+void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
+{
+  // not used
+  ( void )xArg1;
+  ( void )xArg2;
+}
+
+/**@} EOF DALIBusSimulator.c */
@@ -32,8 +32,14 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
-/// define the talker identifier for this implementation
-#define GPSNEMA0183PROTOCOL_TALKER_IDENTIFIER       ( "GG" )
+/// define the maximum sentence length, excluding the start and checksum
+#define GPSNEMA0183PROTOCOL_MAX_SENTENCE_LEN        ( 96 )
+
+/// define the maximum number of fields in a sentence
+#define GPSNEMA0183PROTOCOL_MAX_NUM_FIELDS          ( 24 )
+
+/// define the macro to enable the floating point data/getters
+#define GPSNEMA0183PROTOCOL_ENABLE_FLOAT            ( ON )
 
 /**@} EOF GpsNEMA0183ProtocolHandler_prm.h */
 
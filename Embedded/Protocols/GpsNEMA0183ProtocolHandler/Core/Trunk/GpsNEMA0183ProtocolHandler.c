@@ -3,7 +3,13 @@
  *
  * @brief GPS NEMA-0183 protocol handler implementation
  *
- * This file provides the NEMA-0183 proocol handler
+ * This file provides the NEMA-0183 proocol handler.  Sentences are collected
+ * once, either into the line buffer by ProcessChar or left in the caller's
+ * buffer by ProcessBlock, and tokenized in place by recording the field
+ * offsets in the same pass that computes the checksum.  Sentence types are
+ * dispatched on a
+ * packed four byte key and numeric fields are parsed directly into fixed
+ * point, so no floating point library is needed to track position.
  *
  * @copyright Copyright (c) 2012 Cyber Intergration
  * This document contains proprietary data and information of Cyber Integration 
@@ -28,7 +34,6 @@
 #include "GpsNEMA0183ProtocolHandler/GpsNEMA0183ProtocolHandler.h"
 
 // library includes -----------------------------------------------------------
-#include "StateExecutionEngine/StateExecutionEngine.h"
 
 // Macros and Defines ---------------------------------------------------------
 /// define the start character
@@ -43,44 +48,54 @@
 /// define the end of line
 #define CH_GPS_EOL                              ( '\n' )
 
-/// define the maximum command length
-#define CMD_MAX_LENGTH                          ( 8 )
+/// define the highest framing character, all of the framing characters sort
+/// at or below the delimiter so one compare screens out ordinary data
+#define CH_GPS_FRAMING_MAX                      ( CH_GPS_DELIM )
 
-/// define the maximum argument length
-#define ARG_MAX_LENGTH                          ( 16 )
+/// define the carriage return
+#define CH_GPS_CR                               ( '\r' )
 
-/// define the maximum number of arguments
-#define CMD_NUM_ARGS                            ( 128 )
+/// define the offset of the formatter/first field after the talker
+#define SENTENCE_FORMATTER_OFFSET               ( 2 )
+#define SENTENCE_FIRST_FIELD_OFFSET             ( 6 )
+
+/// define the macro to pack a sentence formatter into its dispatch key
+#define GPS_SENTENCE_KEY( a, b, c, d )          (( U32 )( U8 )( a ) | (( U32 )( U8 )( b ) << 8 ) | (( U32 )( U8 )( c ) << 16 ) | (( U32 )( U8 )( d ) << 24 ))
 
 /// define the maximum number of satellites/messages
-#define NUM_SATS_PER_MESSAGE                    ( 12 )
-#define NUM_SAT_MESSAGES                        ( 3 )
+#define NUM_SATS_PER_MESSAGE                    ( 4 )
+#define NUM_SAT_MESSAGES                        ( 9 )
 #define MAX_NUM_SATELLITES                      ( NUM_SATS_PER_MESSAGE * NUM_SAT_MESSAGES )
 
+/// define the fixed point scaling
+#define COORD_SCALE                             ( 10000000ul )
+#define COORD_FRAC_DIGITS                       ( 7 )
+#define MSECS_PER_HOUR                          ( 3600000ul )
+#define MSECS_PER_MINUTE                        ( 60000ul )
+
+/// define the knots * 1000 to millimeters per second ratio, 1852 / 3600
+#define KNOTS_TO_MMPS_NUM                       ( 463ul )
+#define KNOTS_TO_MMPS_DEN                       ( 900ul )
+
+/// define the illegal nibble value
+#define HEX_NIBBLE_ILLEGAL                      ( 0xFF )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the protocol states
 typedef enum _GPSSTATE
 {
   GPS_STATE_IDLE = 0,
-  GPS_STATE_CMND,
   GPS_STATE_DATA,
-  GPS_STATE_CHEK,
+  GPS_STATE_CHK1,
+  GPS_STATE_CHK2,
   GPS_STATE_MAX
 } GPSSTATE;
 
 // structures -----------------------------------------------------------------
-/// define the GPS argument
-typedef struct _GPSARG
-{
-  C8    acArgument[ ARG_MAX_LENGTH ];
-} GPSARG, *PGPSARG;
-#define GPSARG_SIZE                             sizeof( GPSARG )
-
 /// define the command table
 typedef struct _GPSCMDTBL
 {
-  PC8       pszCommand;               ///< command
-  U8        nCompareLen;              ///< compare length
+  U32       uKey;                     ///< packed formatter and delimiter
   void      ( *pvFunction )( void );  ///< command function 
 } GPSCMDTBL, *PGPSCMDTBL;
 #define GPSCMDTBL_SIZE                          sizeof( GPSCMDTBL )
@@ -89,96 +104,53 @@ typedef struct _GPSCMDTBL
 
 // local parameter declarations -----------------------------------------------
 static  GPSSTATE            eGpsState;
-static  STATEEXECENGCONTROL tStateCtl;
-static  C8                  acCommand[ CMD_MAX_LENGTH ];
+static  C8                  acSentence[ GPSNEMA0183PROTOCOL_MAX_SENTENCE_LEN + 1 ];
 static  U8                  nBufIndex;
-static  U8                  nTalkerIndex;
-static  U8                  nTalkerLength;
-static  U8                  nArgCount;
-static  GPSARG              atGpsArgs[ CMD_NUM_ARGS ];
+static  U8                  nCalcChecksum;
+static  U8                  nRcvdChecksum;
+static  PC8                 pcFields;
+static  U8                  anFieldOffsets[ GPSNEMA0183PROTOCOL_MAX_NUM_FIELDS ];
+static  U8                  nNumFields;
+static  U32                 uSentenceCount;
+static  U32                 uChecksumErrors;
 static  GPSDATA             tGpsData;
 static  GPSSATELLITE        atSatellites[ MAX_NUM_SATELLITES ];
-static  U8                  anSatellitesInView[ NUM_SAT_MESSAGES ];
+static  U8                  nSatellitesInView;
 
 // local function prototypes --------------------------------------------------
 static  void  CmdGGA( void );
 static  void  CmdGLL( void );
-static  void  CmdGSA( void );
 static  void  CmdGSV( void );
 static  void  CmdRMC( void );
 static  void  CmdVTG( void );
-
-// GPS_STATE_CMND functions
-static  void  GpsStateCmndEnt( void );
-static  U8    GpsStateCmndExc( STATEEXECENGARG xArg );
-static  void  GpsStateCmndExt( void );
-
-// GPS_STATE_DATA functions
-static  void  GpsStateDataEnt( void );
-static  U8    GpsStateDataExc( STATEEXECENGARG xArg );
-
-// GPS_STATE_CHEK functions
-static  void  GpsStateChekExt( void );
+static  void  CheckSentence( PC8 pcSentence, U8 nLength, U8 nChecksum );
+static  void  ParseSentence( PC8 pcSentence, U8 nLength );
+static  PC8   GetField( U8 nField );
+static  BOOL  ParseFixed( PC8 pcField, U8 nDecimals, PS32 plValue );
+static  BOOL  ParseCoordinate( PC8 pcField, PS32 plValueE7 );
+static  void  ParsePosition( U8 nField );
+static  void  ParseUtcTime( U8 nField );
+static  void  ParseSpeedKnots( U8 nField );
+static  void  ParseCourse( U8 nField );
+static  U8    GetHexNibble( U8 nChar );
+#if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+static  FLOAT CoordinateToNmea( S32 lValueE7 );
+#endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
 
 // constant parameter initializations -----------------------------------------
-/// define the talker identifiers
-static  const CODE C8 szTalker[ ] = GPSNEMA0183PROTOCOL_TALKER_IDENTIFIER;
-
-/// define the sentence identifiers
-static  const CODE C8 szCmdGGA[ ]  = { "NGGA" };
-static  const CODE C8 szCmdGLL[ ]  = { "NGLL" };
-static  const CODE C8 szCmdGSA[ ]  = { "NGSA" };
-static  const CODE C8 szCmdGSV[ ]  = { "LGSV" };
-static  const CODE C8 szCmdRMC[ ]  = { "NRMC" };
-static  const CODE C8 szCmdVTG[ ]  = { "NVTG" };
-
 /// define the command table
 static  const CODE GPSCMDTBL  atCmdTable[ ] =
 {
-  { ( PC8 )&szCmdGGA, 4, CmdGGA },
-  { ( PC8 )&szCmdGLL, 4, CmdGLL },
-  { ( PC8 )&szCmdGSA, 4, CmdGSA },
-  { ( PC8 )&szCmdGSV, 4, CmdGSV },
-  { ( PC8 )&szCmdRMC, 4, CmdRMC },
-  { ( PC8 )&szCmdVTG, 4, CmdVTG },
-  { NULL,             0, NULL   }
+  { GPS_SENTENCE_KEY( 'G', 'G', 'A', CH_GPS_DELIM ), CmdGGA },
+  { GPS_SENTENCE_KEY( 'R', 'M', 'C', CH_GPS_DELIM ), CmdRMC },
+  { GPS_SENTENCE_KEY( 'V', 'T', 'G', CH_GPS_DELIM ), CmdVTG },
+  { GPS_SENTENCE_KEY( 'G', 'S', 'V', CH_GPS_DELIM ), CmdGSV },
+  { GPS_SENTENCE_KEY( 'G', 'L', 'L', CH_GPS_DELIM ), CmdGLL },
+  { 0,                                               NULL   }
 };
 
-/// initialize the IDLE events
-static  const CODE STATEEXECENGEVENT  atIdleEvents[ ] =
-{
-  STATEEXECENGEVENT_ENTRY( CH_GPS_START, GPS_STATE_CMND, TRUE  ),
-  STATEEXECENGEVENT_END( )
-};
-
-/// initialize the CMND events
-static  const CODE STATEEXECENGEVENT  atCmndEvents[ ] =
-{
-  STATEEXECENGEVENT_ENTRY( CH_GPS_DELIM, GPS_STATE_DATA, TRUE  ),
-  STATEEXECENGEVENT_ENTRY( CH_GPS_EOL,   GPS_STATE_IDLE, TRUE  ),
-};
-
-/// initialize the DATA events
-static  const CODE STATEEXECENGEVENT  atDataEvents[ ] =
-{
-  STATEEXECENGEVENT_ENTRY( CH_GPS_TERM, GPS_STATE_CHEK, TRUE  ),
-  STATEEXECENGEVENT_ENTRY( CH_GPS_EOL,  GPS_STATE_IDLE, TRUE  ),
-};
-
-/// initialize the CHEK events
-static  const CODE STATEEXECENGEVENT  atChekEvents[ ] =
-{
-  STATEEXECENGEVENT_ENTRY( CH_GPS_EOL, GPS_STATE_IDLE, TRUE  ),
-};
-
-/// initialize the main state table
-static  const CODE STATEEXECENGTABLE  atGpsStates[ GPS_STATE_MAX ] =
-{
-  STATEXECENGETABLE_ENTRY( GPS_STATE_IDLE, NULL,            NULL,            NULL,            atIdleEvents ),
-  STATEXECENGETABLE_ENTRY( GPS_STATE_CMND, GpsStateCmndEnt, GpsStateCmndExc, GpsStateCmndExt, atCmndEvents ),
-  STATEXECENGETABLE_ENTRY( GPS_STATE_DATA, GpsStateDataEnt, GpsStateDataExc, NULL,            atDataEvents ),
-  STATEXECENGETABLE_ENTRY( GPS_STATE_CHEK, NULL,            NULL,            GpsStateChekExt, atChekEvents ),
-};
+/// define the empty field, returned for fields missing from a sentence
+static  const C8  acEmptyField[ ] = { CH_GPS_TERM, '\0' };
 
 /******************************************************************************
  * @function GpsNEMA0183ProtocolHandler_Initialize
@@ -190,14 +162,11 @@ static  const CODE STATEEXECENGTABLE  atGpsStates[ GPS_STATE_MAX ] =
  *****************************************************************************/
 void GpsNEMA0183ProtocolHandler_Initialize( void )
 {
-  // initialize the states
-  tStateCtl.ptStates = atGpsStates;
-  
-  // calculate the length of the talker identifier
-  nTalkerLength = strlen( szTalker );
-
   // initialize the state
-  StateExecutionEngine_Initialize( &tStateCtl, GPS_STATE_IDLE );
+  eGpsState = GPS_STATE_IDLE;
+  uSentenceCount = 0;
+  uChecksumErrors = 0;
+  nSatellitesInView = 0;
 }
 
 /******************************************************************************
@@ -217,35 +186,49 @@ void GpsNEMA0183ProtocolHandler_GetData( PGPSDATA ptData )
 }
 
 /******************************************************************************
- * @function GpsNEMA0183ProtocolHandler_GetLatitude
+ * @function GpsNEMA0183ProtocolHandler_GetSattelites
  *
- * @brief get the latitude
+ * @brief get a satellite
  *
- * This function will return the latitude
+ * This function will copy the satellite from the last GSV sequence
  *
- * @return  current latitude
+ * @param[in]   nSatelliteIndex   satellite index
+ * @param[io]   ptSattelite       pointer to store the satellite in
+ *
+ * @return      TRUE if illegal index, FALSE if OK
  *
  *****************************************************************************/
-FLOAT GpsNEMA0183ProtocolHandler_GetLatitude( void )
+BOOL GpsNEMA0183ProtocolHandler_GetSattelites( U8 nSatelliteIndex, PGPSSATELLITE ptSattelite )
 {
-  // return the latitude
-  return( tGpsData.fLatitude );
+  BOOL  bStatus = TRUE;
+
+  // check for a valid index
+  if ( nSatelliteIndex < MIN( nSatellitesInView, MAX_NUM_SATELLITES ))
+  {
+    // copy it
+    memcpy( ptSattelite, &atSatellites[ nSatelliteIndex ], GPSSATELLITE_SIZE );
+    bStatus = FALSE;
+  }
+
+  // return the status
+  return( bStatus );
 }
 
+#if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
 /******************************************************************************
- * @function GpsNEMA0183ProtocolHandler_GetNorthSouth
+ * @function GpsNEMA0183ProtocolHandler_GetLatitude
  *
- * @brief get the North SOuth indicator
+ * @brief get the latitude
  *
- * This function will return the north/south indicator
+ * This function will return the latitude
  *
- * @return north/south
+ * @return  current latitude
  *
  *****************************************************************************/
-GPSLATNS GpsNEMA0183ProtocolHandler_GetNorthSouth( void )
+FLOAT GpsNEMA0183ProtocolHandler_GetLatitude( void )
 {
-  // return the north south
-  return( tGpsData.eNorthSouth );
+  // return the latitude
+  return( tGpsData.fLatitude );
 }
 
 /******************************************************************************
@@ -264,22 +247,6 @@ FLOAT GpsNEMA0183ProtocolHandler_GetLongitude( void )
   return( tGpsData.fLongitude );
 }
 
-/******************************************************************************
- * @function GpsNEMA0183ProtocolHandler_GetEastWest
- *
- * @brief get the east/west indicator
- *
- * This function will return the east/west indicator
- *
- * @return current value
- *
- *****************************************************************************/
-GPSLONEW GpsNEMA0183ProtocolHandler_GetEastWest( void )
-{
-  // return the latitude
-  return( tGpsData.eEastWest );
-}
-
 /******************************************************************************
  * @function GpsNEMA0183ProtocolHandler_GetAltitude
  *
@@ -327,11 +294,140 @@ FLOAT GpsNEMA0183ProtocolHandler_GetSpeed( void )
   // return the latitude
   return( tGpsData.fSpeed );
 }
+#endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
 
 /******************************************************************************
- * @function GpsNEMA0183ProtocolHandler_GetSpeed
+ * @function GpsNEMA0183ProtocolHandler_GetNorthSouth
  *
- * @brief get the speed
+ * @brief get the North SOuth indicator
+ *
+ * This function will return the north/south indicator
+ *
+ * @return north/south
+ *
+ *****************************************************************************/
+GPSLATNS GpsNEMA0183ProtocolHandler_GetNorthSouth( void )
+{
+  // return the north south
+  return( tGpsData.eNorthSouth );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetEastWest
+ *
+ * @brief get the east/west indicator
+ *
+ * This function will return the east/west indicator
+ *
+ * @return current value
+ *
+ *****************************************************************************/
+GPSLONEW GpsNEMA0183ProtocolHandler_GetEastWest( void )
+{
+  // return the latitude
+  return( tGpsData.eEastWest );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetLatitudeE7
+ *
+ * @brief get the latitude in fixed point
+ *
+ * This function will return the latitude in degrees * 1E7, south negative
+ *
+ * @return  current latitude
+ *
+ *****************************************************************************/
+S32 GpsNEMA0183ProtocolHandler_GetLatitudeE7( void )
+{
+  // return the latitude
+  return( tGpsData.lLatitudeE7 );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetLongitudeE7
+ *
+ * @brief get the longitude in fixed point
+ *
+ * This function will return the longitude in degrees * 1E7, west negative
+ *
+ * @return  current longitude
+ *
+ *****************************************************************************/
+S32 GpsNEMA0183ProtocolHandler_GetLongitudeE7( void )
+{
+  // return the longitude
+  return( tGpsData.lLongitudeE7 );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetAltitudeCm
+ *
+ * @brief get the altitude in centimeters
+ *
+ * This function will return the current altitude in centimeters
+ *
+ * @return  current altitude
+ *
+ *****************************************************************************/
+S32 GpsNEMA0183ProtocolHandler_GetAltitudeCm( void )
+{
+  // return the altitude
+  return( tGpsData.lAltitudeCm );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetCourseCdeg
+ *
+ * @brief get the course in hundredths of a degree
+ *
+ * This function will return the current course in hundredths of a degree
+ *
+ * @return  current course
+ *
+ *****************************************************************************/
+U16 GpsNEMA0183ProtocolHandler_GetCourseCdeg( void )
+{
+  // return the course
+  return( tGpsData.wCourseCdeg );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetSpeedMmps
+ *
+ * @brief get the speed in millimeters per second
+ *
+ * This function will return the current speed in millimeters per second
+ *
+ * @return  current speed
+ *
+ *****************************************************************************/
+U32 GpsNEMA0183ProtocolHandler_GetSpeedMmps( void )
+{
+  // return the speed
+  return( tGpsData.uSpeedMmps );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetUtcTimeMsec
+ *
+ * @brief get the UTC time
+ *
+ * This function will return the UTC time in milliseconds since midnight
+ *
+ * @return  current UTC time
+ *
+ *****************************************************************************/
+U32 GpsNEMA0183ProtocolHandler_GetUtcTimeMsec( void )
+{
+  // return the time
+  return( tGpsData.uUtcTimeMsec );
+}
+
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_GetNumSatellites
+ *
+ * @brief get the number of satellites
  *
  * This function will return the current number of satellites
  *
@@ -361,163 +457,657 @@ U8 GpsNEMA0183ProtocolHandler_GetFixStatus( void )
 }
 
 /******************************************************************************
- * @function GpsNEMA0183ProtocolHandler_ProcessChar
+ * @function GpsNEMA0183ProtocolHandler_GetSentenceCount
  *
- * @brief process character
+ * @brief get the sentence count
  *
- * This function will process the character 
+ * This function will return the number of sentences dispatched
  *
- * @param[in]   nChar   received chracter to process
+ * @return sentence count
  *
  *****************************************************************************/
-void GpsNEMA0183ProtocolHandler_ProcessChar( U8 nChar )
+U32 GpsNEMA0183ProtocolHandler_GetSentenceCount( void )
 {
-  // process the event through the state engine
-  StateExecutionEngine_Process( &tStateCtl, nChar );
+  // return the count
+  return( uSentenceCount );
 }
 
 /******************************************************************************
-// GPS_STATE_CMND functions
+ * @function GpsNEMA0183ProtocolHandler_GetChecksumErrors
+ *
+ * @brief get the checksum error count
+ *
+ * This function will return the number of sentences dropped on checksum
+ *
+ * @return checksum error count
+ *
  *****************************************************************************/
-static void GpsStateCmndEnt( void )
+U32 GpsNEMA0183ProtocolHandler_GetChecksumErrors( void )
 {
-  // clear the index
-  nBufIndex = 0;
-  nTalkerIndex = 0;
+  // return the count
+  return( uChecksumErrors );
 }
 
-static U8 GpsStateCmndExc( STATEEXECENGARG xArg )
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_ProcessChar
+ *
+ * @brief process character
+ *
+ * This function will process the character, accumulating the sentence and
+ * its checksum in the line buffer
+ *
+ * @param[in]   nChar   received chracter to process
+ *
+ *****************************************************************************/
+void GpsNEMA0183ProtocolHandler_ProcessChar( U8 nChar )
 {
-  U8  nNextState = STATEEXECENG_STATE_NONE;
-  
-  // skip the talker identifier
-  if ( nTalkerIndex++ >= nTalkerLength )
+  U8  nNibble;
+
+  // a start always resynchronizes
+  if ( nChar == CH_GPS_START )
   {
-    // if room, add character to buffer
-    if ( nBufIndex < ( CMD_MAX_LENGTH - 1 ))
+    // reset the buffer/checksum/fields
+    nBufIndex = 0;
+    nCalcChecksum = 0;
+    nNumFields = 0;
+    eGpsState = GPS_STATE_DATA;
+  }
+  else
+  {
+    // process the state
+    switch( eGpsState )
     {
-      // add it to buffer
-      acCommand[ nBufIndex++ ] = ( C8 )xArg;
+      case GPS_STATE_DATA :
+        if ( nChar == CH_GPS_TERM )
+        {
+          // terminate the sentence/get the checksum
+          acSentence[ nBufIndex ] = CH_GPS_TERM;
+          nRcvdChecksum = 0;
+          eGpsState = GPS_STATE_CHK1;
+        }
+        else if (( nChar == CH_GPS_EOL ) || ( nChar == CH_GPS_CR ) || ( nBufIndex >= GPSNEMA0183PROTOCOL_MAX_SENTENCE_LEN ))
+        {
+          // no checksum or too long, drop it
+          eGpsState = GPS_STATE_IDLE;
+        }
+        else
+        {
+          // record the start of the next field
+          if (( nChar == CH_GPS_DELIM ) && ( nNumFields < GPSNEMA0183PROTOCOL_MAX_NUM_FIELDS ))
+          {
+            anFieldOffsets[ nNumFields++ ] = nBufIndex + 1;
+          }
+
+          // store it/update the checksum
+          acSentence[ nBufIndex++ ] = ( C8 )nChar;
+          nCalcChecksum ^= nChar;
+        }
+        break;
+
+      case GPS_STATE_CHK1 :
+      case GPS_STATE_CHK2 :
+        // get the nibble
+        if (( nNibble = GetHexNibble( nChar )) == HEX_NIBBLE_ILLEGAL )
+        {
+          // drop it
+          eGpsState = GPS_STATE_IDLE;
+        }
+        else
+        {
+          // add the nibble
+          nRcvdChecksum = ( nRcvdChecksum << 4 ) | nNibble;
+          if ( eGpsState == GPS_STATE_CHK2 )
+          {
+            // check it/back to idle
+            CheckSentence( acSentence, nBufIndex, nRcvdChecksum );
+            eGpsState = GPS_STATE_IDLE;
+          }
+          else
+          {
+            // get the second nibble
+            eGpsState = GPS_STATE_CHK2;
+          }
+        }
+        break;
+
+      default :
+        break;
     }
   }
-  
-  // return next state
-  return( nNextState );
 }
 
-static void GpsStateCmndExt( void )
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_ProcessBlock
+ *
+ * @brief process a block of characters
+ *
+ * This function will process a block of received characters.  Sentences that
+ * lie entirely within the block are checksummed and parsed in place without
+ * copying, partial sentences at either end go through the line buffer
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ *****************************************************************************/
+void GpsNEMA0183ProtocolHandler_ProcessBlock( PU8 pnData, U16 wLength )
 {
-  // terminate the string
-  acCommand[ nBufIndex ] = '\0';
+  PU8 pnEnd, pnStart, pnScan, pnLimit;
+  U8  nChecksum, nHigh, nLow, nChar;
+
+  // process the block
+  pnEnd = pnData + wLength;
+  while ( pnData < pnEnd )
+  {
+    // finish any sentence started in a previous block
+    if ( eGpsState != GPS_STATE_IDLE )
+    {
+      // process the character
+      GpsNEMA0183ProtocolHandler_ProcessChar( *( pnData++ ));
+    }
+    else if (( pnStart = ( PU8 )memchr( pnData, CH_GPS_START, pnEnd - pnData )) == NULL )
+    {
+      // nothing left
+      pnData = pnEnd;
+    }
+    else
+    {
+      // scan the sentence in place
+      nChecksum = 0;
+      nNumFields = 0;
+      pnLimit = (( pnEnd - pnStart ) > GPSNEMA0183PROTOCOL_MAX_SENTENCE_LEN ) ? pnStart + GPSNEMA0183PROTOCOL_MAX_SENTENCE_LEN + 1 : pnEnd;
+      for ( pnScan = pnStart + 1; pnScan < pnLimit; pnScan++ )
+      {
+        // only framing characters need a closer look
+        if (( nChar = *pnScan ) <= CH_GPS_FRAMING_MAX )
+        {
+          if ( nChar == CH_GPS_DELIM )
+          {
+            // record the start of the next field
+            if ( nNumFields < GPSNEMA0183PROTOCOL_MAX_NUM_FIELDS )
+            {
+              anFieldOffsets[ nNumFields++ ] = ( U8 )( pnScan - pnStart );
+            }
+          }
+          else if (( nChar == CH_GPS_TERM ) || ( nChar == CH_GPS_START ) || ( nChar == CH_GPS_EOL ) || ( nChar == CH_GPS_CR ))
+          {
+            // stop on any terminator
+            break;
+          }
+        }
+
+        // update the checksum
+        nChecksum ^= nChar;
+      }
+
+      // determine what was found
+      if (( pnScan < pnEnd ) && ( *pnScan == CH_GPS_TERM ) && (( pnEnd - pnScan ) >= 3 ))
+      {
+        // get the checksum
+        nHigh = GetHexNibble( *( pnScan + 1 ));
+        nLow = GetHexNibble( *( pnScan + 2 ));
+        if (( nHigh != HEX_NIBBLE_ILLEGAL ) && ( nLow != HEX_NIBBLE_ILLEGAL ) && ( nChecksum == (( nHigh << 4 ) | nLow )))
+        {
+          // parse it in place
+          ParseSentence(( PC8 )( pnStart + 1 ), ( U8 )( pnScan - pnStart - 1 ));
+        }
+        else
+        {
+          // count the error
+          uChecksumErrors++;
+        }
+
+        // skip past it
+        pnData = pnScan + 3;
+      }
+      else if ((( pnScan == pnEnd ) && ( pnLimit == pnEnd )) || (( pnScan < pnEnd ) && ( *pnScan == CH_GPS_TERM )))
+      {
+        // runs off the end of the block, buffer the remainder
+        while ( pnStart < pnEnd )
+        {
+          // process the character
+          GpsNEMA0183ProtocolHandler_ProcessChar( *( pnStart++ ));
+        }
+        pnData = pnEnd;
+      }
+      else
+      {
+        // malformed or too long, resume from here
+        pnData = pnScan;
+      }
+    }
+  }
 }
 
 /******************************************************************************
-// GPS_STATE_DATA functions
+ * @function CheckSentence
+ *
+ * @brief check a buffered sentence
+ *
+ * This function will check the received checksum and parse the sentence
+ *
+ * @param[in]   pcSentence    pointer to the sentence after the start
+ * @param[in]   nLength       length up to the terminator
+ * @param[in]   nChecksum     received checksum
+ *
  *****************************************************************************/
-static void GpsStateDataEnt( void )
+static void CheckSentence( PC8 pcSentence, U8 nLength, U8 nChecksum )
 {
-  // clear the index/argument count
-  nBufIndex = 0;
-  nArgCount = 0;
+  // check the checksum
+  if ( nChecksum == nCalcChecksum )
+  {
+    // parse it
+    ParseSentence( pcSentence, nLength );
+  }
+  else
+  {
+    // count the error
+    uChecksumErrors++;
+  }
 }
 
-static U8 GpsStateDataExc( STATEEXECENGARG xArg )
+/******************************************************************************
+ * @function ParseSentence
+ *
+ * @brief parse a validated sentence
+ *
+ * This function will look up the formatter following the talker and call the
+ * handler with the field offsets recorded while scanning.  The sentence must
+ * be followed by the terminator
+ *
+ * @param[in]   pcSentence    pointer to the sentence after the start
+ * @param[in]   nLength       length up to the terminator
+ *
+ *****************************************************************************/
+static void ParseSentence( PC8 pcSentence, U8 nLength )
 {
-  U8  nNextState = STATEEXECENG_STATE_NONE;
-  
-  // is there room in the argument array
-  if ( nArgCount < CMD_NUM_ARGS )
+  U32 uKey, uTblKey;
+  U8  nIdx;
+
+  // ensure there is a talker/formatter/delimiter starting the first field
+  if (( nLength >= SENTENCE_FIRST_FIELD_OFFSET ) && ( nNumFields != 0 ) && ( anFieldOffsets[ 0 ] == SENTENCE_FIRST_FIELD_OFFSET ))
   {
-    // check for delimited
-    if ( xArg != CH_GPS_DELIM )
+    // build the key
+    uKey = GPS_SENTENCE_KEY( pcSentence[ SENTENCE_FORMATTER_OFFSET ], pcSentence[ SENTENCE_FORMATTER_OFFSET + 1 ], pcSentence[ SENTENCE_FORMATTER_OFFSET + 2 ], pcSentence[ SENTENCE_FORMATTER_OFFSET + 3 ] );
+
+    // find the command in the table
+    nIdx = 0;
+    while(( uTblKey = PGM_RDDWRD( atCmdTable[ nIdx ].uKey )) != 0 )
     {
-      // if room, add character to buffer
-      if ( nBufIndex < ( ARG_MAX_LENGTH - 1 ))
+      // is this our command
+      if ( uTblKey == uKey )
       {
-        // add it to buffer
-        atGpsArgs[ nArgCount ].acArgument[ nBufIndex++ ] = ( C8 )xArg;
+        // set the fields/execute it/exit
+        pcFields = pcSentence;
+        uSentenceCount++;
+        atCmdTable[ nIdx ].pvFunction( );
+        break;
+      }
+      else
+      {
+        // increment the index
+        nIdx++;
       }
-    }
-    else
-    {
-      // terminate the string
-      atGpsArgs[ nArgCount ].acArgument[ nBufIndex ] = '\0';
-      
-      // increment the argument count
-      nArgCount++;
-      
-      // reset the buffer index
-      nBufIndex = 0;
     }
   }
-  
-  // return next state
-  return( nNextState );
 }
 
 /******************************************************************************
-// GPS_STATE_CHEK functions
+ * @function GetField
+ *
+ * @brief get a field
+ *
+ * This function will return a pointer to the field, missing fields return an
+ * empty field
+ *
+ * @param[in]   nField      field index
+ *
+ * @return      pointer to the field
+ *
  *****************************************************************************/
-static void GpsStateChekExt( void )
+static PC8 GetField( U8 nField )
 {
-  PC8 pszTblCmd;
-  U8  nIdx;
-  
-  // find the command in the table
-  nIdx = 0;
-  while(( pszTblCmd = ( PC8 )PGM_RDWORD( atCmdTable[ nIdx ].pszCommand )) != NULL )
+  // return the field
+  return(( nField < nNumFields ) ? ( pcFields + anFieldOffsets[ nField ] ) : ( PC8 )acEmptyField );
+}
+
+/******************************************************************************
+ * @function ParseFixed
+ *
+ * @brief parse a decimal field into fixed point
+ *
+ * This function will parse a signed decimal field scaled by 10^nDecimals,
+ * excess fractional digits are truncated
+ *
+ * @param[in]   pcField     pointer to the field
+ * @param[in]   nDecimals   number of decimals to scale by
+ * @param[io]   plValue     pointer to store the value
+ *
+ * @return      TRUE if the field is empty, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL ParseFixed( PC8 pcField, U8 nDecimals, PS32 plValue )
+{
+  BOOL  bEmpty = TRUE;
+  BOOL  bNegative = FALSE;
+  U32   uValue = 0;
+  U8    nDigit;
+
+  // check for a sign
+  if ( *pcField == '-' )
+  {
+    bNegative = TRUE;
+    pcField++;
+  }
+
+  // get the whole part
+  while (( nDigit = ( U8 )( *pcField - '0' )) <= 9 )
   {
-    // is this our command
-    if ( STRNCMP_P(( char const* )acCommand, ( char const* )pszTblCmd, atCmdTable[ nIdx ].nCompareLen ) == 0 )
+    uValue = ( uValue * 10 ) + nDigit;
+    bEmpty = FALSE;
+    pcField++;
+  }
+
+  // get the fraction
+  if ( *pcField == '.' )
+  {
+    pcField++;
+    while (( nDigit = ( U8 )( *pcField - '0' )) <= 9 )
     {
-      // get the function and execute it/ exit
-      atCmdTable[ nIdx ].pvFunction( );
-      break;
+      // only keep the requested digits
+      if ( nDecimals != 0 )
+      {
+        uValue = ( uValue * 10 ) + nDigit;
+        nDecimals--;
+      }
+      bEmpty = FALSE;
+      pcField++;
     }
-    else
+  }
+
+  // scale any remaining decimals
+  while ( nDecimals-- != 0 )
+  {
+    uValue *= 10;
+  }
+
+  // store it
+  *plValue = ( bNegative ) ? -( S32 )uValue : ( S32 )uValue;
+
+  // return the status
+  return( bEmpty );
+}
+
+/******************************************************************************
+ * @function ParseCoordinate
+ *
+ * @brief parse a coordinate field
+ *
+ * This function will parse a (d)ddmm.mmmm coordinate into degrees * 1E7
+ *
+ * @param[in]   pcField     pointer to the field
+ * @param[io]   plValueE7   pointer to store the value
+ *
+ * @return      TRUE if the field is empty, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL ParseCoordinate( PC8 pcField, PS32 plValueE7 )
+{
+  BOOL  bEmpty = TRUE;
+  U32   uWhole = 0, uFraction = 0;
+  U8    nDigit, nDecimals = COORD_FRAC_DIGITS;
+
+  // get the whole part, degrees * 100 + minutes
+  while (( nDigit = ( U8 )( *pcField - '0' )) <= 9 )
+  {
+    uWhole = ( uWhole * 10 ) + nDigit;
+    bEmpty = FALSE;
+    pcField++;
+  }
+
+  // get the fraction of the minutes
+  if ( *pcField == '.' )
+  {
+    pcField++;
+    while (( nDigit = ( U8 )( *pcField - '0' )) <= 9 )
     {
-      // increment the index
-      nIdx++;
+      // only keep the resolution needed
+      if ( nDecimals != 0 )
+      {
+        uFraction = ( uFraction * 10 ) + nDigit;
+        nDecimals--;
+      }
+      pcField++;
     }
   }
+
+  // scale any remaining decimals
+  while ( nDecimals-- != 0 )
+  {
+    uFraction *= 10;
+  }
+
+  // convert the minutes to degrees with rounding
+  if ( !bEmpty )
+  {
+    *plValueE7 = ( S32 )((( uWhole / 100 ) * COORD_SCALE ) + (((( uWhole % 100 ) * COORD_SCALE ) + uFraction + 30 ) / 60 ));
+  }
+
+  // return the status
+  return( bEmpty );
 }
 
 /******************************************************************************
- * @function CmdGGA
+ * @function ParsePosition
  *
- * @brief GGA command handler
+ * @brief parse a position
+ *
+ * This function will parse the latitude, north/south, longitude and east/west
+ * fields starting at the given field, empty positions are ignored
+ *
+ * @param[in]   nField      field index of the latitude
  *
  *****************************************************************************/
-static void CmdGGA( void )
+static void ParsePosition( U8 nField )
 {
-  // parse the message
-  tGpsData.fUtcPosition = ( FLOAT )atof( atGpsArgs[ 0 ].acArgument );
-  tGpsData.fLatitude = ( FLOAT )atof( atGpsArgs[ 1 ].acArgument );
-  tGpsData.eNorthSouth = ( atGpsArgs[ 2 ].acArgument[ 0 ] == 'N' ) ? GPS_LATNS_NORTH : GPS_LATNS_SOUTH;
-  tGpsData.fLongitude = ( FLOAT )atof( atGpsArgs[ 3 ].acArgument );
-  tGpsData.eEastWest = ( atGpsArgs[ 4 ].acArgument[ 0 ] == 'E' ) ? GPS_LONEW_EAST : GPS_LONEW_WEST;
-  tGpsData.nPosFixStatus = ( U8 )atoi( atGpsArgs[ 5 ].acArgument );
-  tGpsData.nNumOfSatelites = ( U8 )atoi( atGpsArgs[ 6 ].acArgument );
+  S32 lLatitude, lLongitude;
+
+  // parse the coordinates
+  if (( ParseCoordinate( GetField( nField ), &lLatitude ) == FALSE ) && ( ParseCoordinate( GetField( nField + 2 ), &lLongitude ) == FALSE ))
+  {
+    // set the hemispheres
+    tGpsData.eNorthSouth = ( *GetField( nField + 1 ) == 'S' ) ? GPS_LATNS_SOUTH : GPS_LATNS_NORTH;
+    tGpsData.eEastWest = ( *GetField( nField + 3 ) == 'W' ) ? GPS_LONEW_WEST : GPS_LONEW_EAST;
+
+    #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+    tGpsData.fLatitude = CoordinateToNmea( lLatitude );
+    tGpsData.fLongitude = CoordinateToNmea( lLongitude );
+    #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+
+    // store the signed values
+    tGpsData.lLatitudeE7 = ( tGpsData.eNorthSouth == GPS_LATNS_SOUTH ) ? -lLatitude : lLatitude;
+    tGpsData.lLongitudeE7 = ( tGpsData.eEastWest == GPS_LONEW_WEST ) ? -lLongitude : lLongitude;
+  }
 }
 
 /******************************************************************************
- * @function CmdGLL
+ * @function ParseUtcTime
  *
- * @brief GLL command handler
+ * @brief parse the UTC time
+ *
+ * This function will parse a hhmmss.sss field into milliseconds
+ *
+ * @param[in]   nField      field index
  *
  *****************************************************************************/
-static void CmdGLL( void )
+static void ParseUtcTime( U8 nField )
 {
+  S32 lTime;
+  U32 uTime;
+
+  // parse it, hhmmss * 1000 + milliseconds
+  if ( ParseFixed( GetField( nField ), 3, &lTime ) == FALSE )
+  {
+    #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+    tGpsData.fUtcPosition = ( FLOAT )lTime / 1000.0f;
+    #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+
+    // convert it
+    uTime = ( U32 )lTime;
+    tGpsData.uUtcTimeMsec = (( uTime / 10000000ul ) * MSECS_PER_HOUR ) + ((( uTime / 100000ul ) % 100 ) * MSECS_PER_MINUTE ) + ( uTime % 100000ul );
+  }
 }
 
 /******************************************************************************
- * @function CmdGSA
+ * @function ParseSpeedKnots
+ *
+ * @brief parse the speed in knots
+ *
+ * This function will parse a speed field in knots
  *
- * @brief GSA command handler
+ * @param[in]   nField      field index
  *
  *****************************************************************************/
-static void CmdGSA( void )
+static void ParseSpeedKnots( U8 nField )
 {
+  S32 lKnots;
+
+  // parse it in knots * 1000
+  if ( ParseFixed( GetField( nField ), 3, &lKnots ) == FALSE )
+  {
+    #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+    tGpsData.fSpeed = ( FLOAT )lKnots / 1000.0f;
+    #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+
+    // convert it
+    tGpsData.uSpeedMmps = ((( U32 )lKnots * KNOTS_TO_MMPS_NUM ) + ( KNOTS_TO_MMPS_DEN / 2 )) / KNOTS_TO_MMPS_DEN;
+  }
+}
+
+/******************************************************************************
+ * @function ParseCourse
+ *
+ * @brief parse the course
+ *
+ * This function will parse a course field in degrees
+ *
+ * @param[in]   nField      field index
+ *
+ *****************************************************************************/
+static void ParseCourse( U8 nField )
+{
+  S32 lCourse;
+
+  // parse it in hundredths
+  if ( ParseFixed( GetField( nField ), 2, &lCourse ) == FALSE )
+  {
+    #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+    tGpsData.fCourse = ( FLOAT )lCourse / 100.0f;
+    #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+
+    // store it
+    tGpsData.wCourseCdeg = ( U16 )lCourse;
+  }
+}
+
+/******************************************************************************
+ * @function GetHexNibble
+ *
+ * @brief convert a hex character
+ *
+ * This function will convert a hex character to its value
+ *
+ * @param[in]   nChar       character
+ *
+ * @return      value or HEX_NIBBLE_ILLEGAL
+ *
+ *****************************************************************************/
+static U8 GetHexNibble( U8 nChar )
+{
+  U8  nValue = HEX_NIBBLE_ILLEGAL;
+
+  // convert it
+  if (( nChar >= '0' ) && ( nChar <= '9' ))
+  {
+    nValue = nChar - '0';
+  }
+  else if (( nChar >= 'A' ) && ( nChar <= 'F' ))
+  {
+    nValue = nChar - 'A' + 10;
+  }
+  else if (( nChar >= 'a' ) && ( nChar <= 'f' ))
+  {
+    nValue = nChar - 'a' + 10;
+  }
+
+  // return the value
+  return( nValue );
+}
+
+#if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+/******************************************************************************
+ * @function CoordinateToNmea
+ *
+ * @brief convert a coordinate back to NMEA format
+ *
+ * This function will convert degrees * 1E7 to the (d)ddmm.mmmm format that
+ * the floating point data has always carried
+ *
+ * @param[in]   lValueE7    unsigned coordinate
+ *
+ * @return      coordinate in NMEA format
+ *
+ *****************************************************************************/
+static FLOAT CoordinateToNmea( S32 lValueE7 )
+{
+  U32 uDegrees;
+
+  // split the degrees/convert the fraction to minutes
+  uDegrees = ( U32 )lValueE7 / COORD_SCALE;
+  return(( FLOAT )( uDegrees * 100 ) + (( FLOAT )(( U32 )lValueE7 - ( uDegrees * COORD_SCALE )) * 60.0f / ( FLOAT )COORD_SCALE ));
+}
+#endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+
+/******************************************************************************
+ * @function CmdGGA
+ *
+ * @brief GGA command handler
+ *
+ *****************************************************************************/
+static void CmdGGA( void )
+{
+  S32 lValue;
+
+  // parse the message
+  ParseUtcTime( 0 );
+  ParsePosition( 1 );
+  ParseFixed( GetField( 5 ), 0, &lValue );
+  tGpsData.nPosFixStatus = ( U8 )lValue;
+  ParseFixed( GetField( 6 ), 0, &lValue );
+  tGpsData.nNumOfSatelites = ( U8 )lValue;
+  if ( ParseFixed( GetField( 8 ), 2, &lValue ) == FALSE )
+  {
+    #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+    tGpsData.fAltitude = ( FLOAT )lValue / 100.0f;
+    #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+    tGpsData.lAltitudeCm = lValue;
+  }
+}
+
+/******************************************************************************
+ * @function CmdGLL
+ *
+ * @brief GLL command handler
+ *
+ *****************************************************************************/
+static void CmdGLL( void )
+{
+  // only take valid positions
+  if ( *GetField( 5 ) != 'V' )
+  {
+    // parse the message
+    ParsePosition( 0 );
+    ParseUtcTime( 4 );
+  }
 }
 
 /******************************************************************************
@@ -528,25 +1118,39 @@ static void CmdGSA( void )
  *****************************************************************************/
 static void CmdGSV( void )
 {
-  U8  nMsgNum, nSatIdx, nDataIdx;
+  S32 lValue;
+  U8  nMsgNum, nSatIdx, nDataIdx, nField;
 
-  // determine the message number
-  nMsgNum = ( U8 )atoi( atGpsArgs[ 1 ].acArgument );
+  // determine the message number, these are one based
+  ParseFixed( GetField( 1 ), 0, &lValue );
+  nMsgNum = ( U8 )lValue;
+  if (( nMsgNum != 0 ) && ( nMsgNum <= NUM_SAT_MESSAGES ))
+  {
+    // set the satellites in view
+    ParseFixed( GetField( 2 ), 0, &lValue );
+    nSatellitesInView = ( U8 )lValue;
 
-  // set the satellites in view
-  anSatellitesInView[ nMsgNum ] = ( U8 )atoi( atGpsArgs[ 2 ].acArgument );
+    // now for each satellite in this message
+    for ( nSatIdx = 0; nSatIdx < NUM_SATS_PER_MESSAGE; nSatIdx++ )
+    {
+      // compute the data/field index
+      nDataIdx = (( nMsgNum - 1 ) * NUM_SATS_PER_MESSAGE ) + nSatIdx;
+      nField = 3 + ( nSatIdx * 4 );
+      if ( nField >= nNumFields )
+      {
+        break;
+      }
 
-  // now for each satellite
-  for ( nSatIdx = 0; nSatIdx < anSatellitesInView[ nMsgNum ]; nSatIdx++ )
-  {
-    // now compute the data index
-    nDataIdx = ( nMsgNum * NUM_SATS_PER_MESSAGE ) + nSatIdx;
-
-    // store the data
-    atSatellites[ nDataIdx ].nId = ( U8 )atoi( atGpsArgs[ 3 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].nElevation = ( U8 )atoi( atGpsArgs[ 4 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].wAzimuth = ( U16 )atoi( atGpsArgs[ 5 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].nSigNoiseRatio = ( U8 )atoi( atGpsArgs[ 6 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
+      // store the data
+      ParseFixed( GetField( nField ), 0, &lValue );
+      atSatellites[ nDataIdx ].nId = ( U8 )lValue;
+      ParseFixed( GetField( nField + 1 ), 0, &lValue );
+      atSatellites[ nDataIdx ].nElevation = ( U8 )lValue;
+      ParseFixed( GetField( nField + 2 ), 0, &lValue );
+      atSatellites[ nDataIdx ].wAzimuth = ( U16 )lValue;
+      ParseFixed( GetField( nField + 3 ), 0, &lValue );
+      atSatellites[ nDataIdx ].nSigNoiseRatio = ( U8 )lValue;
+    }
   }
 }
 
@@ -558,6 +1162,15 @@ static void CmdGSV( void )
  *****************************************************************************/
 static void CmdRMC( void )
 {
+  // parse the message
+  ParseUtcTime( 0 );
+  tGpsData.bValid = ( *GetField( 1 ) == 'A' ) ? TRUE : FALSE;
+  if ( tGpsData.bValid )
+  {
+    ParsePosition( 2 );
+    ParseSpeedKnots( 6 );
+    ParseCourse( 7 );
+  }
 }
 
 /******************************************************************************
@@ -569,8 +1182,8 @@ static void CmdRMC( void )
 static void CmdVTG( void )
 {
   // parse the message
-  tGpsData.fCourse = ( FLOAT )atof( atGpsArgs[ 0 ].acArgument );
-  tGpsData.fSpeed = ( FLOAT )atof( atGpsArgs[ 1 ].acArgument );
+  ParseCourse( 0 );
+  ParseSpeedKnots( 4 );
 }
 
 /**@} EOF GpsNEMA0183ProtocolHandler.c */
@@ -28,6 +28,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
+#include "GpsNEMA0183ProtocolHandler/GpsNEMA0183ProtocolHandler_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -53,16 +54,31 @@ typedef enum _GPSLONEW
 /// define the GPS data structure
 typedef struct _GPSDATA
 {
-  FLOAT     fUtcPosition;         ///< UTC position
-  FLOAT     fLatitude;            ///< latitude
+  #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+  FLOAT     fUtcPosition;         ///< UTC position, hhmmss.sss
+  FLOAT     fLatitude;            ///< latitude, ddmm.mmmm
+  #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
   GPSLATNS  eNorthSouth;          ///< North/South
-  FLOAT     fLongitude;           ///< longitude
+  #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+  FLOAT     fLongitude;           ///< longitude, dddmm.mmmm
+  #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
   GPSLONEW  eEastWest;            ///< east west
-  FLOAT     fAltitude;            ///< altitude
+  #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+  FLOAT     fAltitude;            ///< altitude in meters
+  #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
   U8        nPosFixStatus;        ///< fix status
   U8        nNumOfSatelites;      ///< number of satellites
-  FLOAT     fCourse;              ///< course
-  FLOAT     fSpeed;               ///< speed
+  #if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
+  FLOAT     fCourse;              ///< course in degrees
+  FLOAT     fSpeed;               ///< speed in knots
+  #endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+  U32       uUtcTimeMsec;         ///< UTC time in milliseconds since midnight
+  S32       lLatitudeE7;          ///< latitude in degrees * 1E7, south is negative
+  S32       lLongitudeE7;         ///< longitude in degrees * 1E7, west is negative
+  S32       lAltitudeCm;          ///< altitude in centimeters
+  U16       wCourseCdeg;          ///< course in hundredths of a degree
+  U32       uSpeedMmps;           ///< speed in millimeters per second
+  BOOL      bValid;               ///< RMC status valid
 } GPSDATA, *PGPSDATA;
 #define GPSDATA_SIZE              sizeof( GPSDATA )
 
@@ -81,17 +97,28 @@ typedef struct _GPSSATELLITE
 // global function prototypes --------------------------------------------------
 extern  void      GpsNEMA0183ProtocolHandler_Initialize( void );
 extern  void      GpsNEMA0183ProtocolHandler_GetData( PGPSDATA ptData );
-extern  void      GpsNEMA0183ProtocolHandler_GetSattelites( U8 nSatelliteIndex, PGPSSATELLITE ptSattelite );
+extern  BOOL      GpsNEMA0183ProtocolHandler_GetSattelites( U8 nSatelliteIndex, PGPSSATELLITE ptSattelite );
+#if ( GPSNEMA0183PROTOCOL_ENABLE_FLOAT == ON )
 extern  FLOAT     GpsNEMA0183ProtocolHandler_GetLatitude( void );
-extern  GPSLATNS  GpsNEMA0183ProtocolHandler_GetNorthSouth( void );
 extern  FLOAT     GpsNEMA0183ProtocolHandler_GetLongitude( void );
-extern  GPSLONEW  GpsNEMA0183ProtocolHandler_GetEastWest( void );
 extern  FLOAT     GpsNEMA0183ProtocolHandler_GetAltitude( void );
 extern  FLOAT     GpsNEMA0183ProtocolHandler_GetCourse( void );
 extern  FLOAT     GpsNEMA0183ProtocolHandler_GetSpeed( void );
+#endif // GPSNEMA0183PROTOCOL_ENABLE_FLOAT
+extern  GPSLATNS  GpsNEMA0183ProtocolHandler_GetNorthSouth( void );
+extern  GPSLONEW  GpsNEMA0183ProtocolHandler_GetEastWest( void );
+extern  S32       GpsNEMA0183ProtocolHandler_GetLatitudeE7( void );
+extern  S32       GpsNEMA0183ProtocolHandler_GetLongitudeE7( void );
+extern  S32       GpsNEMA0183ProtocolHandler_GetAltitudeCm( void );
+extern  U16       GpsNEMA0183ProtocolHandler_GetCourseCdeg( void );
+extern  U32       GpsNEMA0183ProtocolHandler_GetSpeedMmps( void );
+extern  U32       GpsNEMA0183ProtocolHandler_GetUtcTimeMsec( void );
 extern  U8        GpsNEMA0183ProtocolHandler_GetNumSatellites( void );
 extern  U8        GpsNEMA0183ProtocolHandler_GetFixStatus( void );
+extern  U32       GpsNEMA0183ProtocolHandler_GetSentenceCount( void );
+extern  U32       GpsNEMA0183ProtocolHandler_GetChecksumErrors( void );
 extern  void      GpsNEMA0183ProtocolHandler_ProcessChar( U8 nChar );
+extern  void      GpsNEMA0183ProtocolHandler_ProcessBlock( PU8 pnData, U16 wLength );
 
 /**@} EOF GpsNEMA0183ProtocolHandler.h */
 
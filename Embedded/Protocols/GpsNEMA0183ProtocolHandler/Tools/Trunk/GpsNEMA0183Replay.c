@@ -0,0 +1,693 @@
+/******************************************************************************
+ * @file GpsNEMA0183Replay.c
+ *
+ * @brief GPS NEMA-0183 replay benchmark
+ *
+ * This file provides a host tool that replays a recorded NMEA log through the
+ * protocol handler, both a character at a time and in blocks as a DMA
+ * receiver would deliver them, and times it against a copy/atof reference
+ * parser.  Every parsed sentence is then checked against the reference and
+ * the first mismatch fails the run.  With -g it writes a synthetic multi-GNSS
+ * log at the given epoch rate to replay when no recording is at hand.
+ *
+ * build with: cc -O2 -I. -I<include root> -o GpsNEMA0183Replay
+ *             GpsNEMA0183Replay.c ../../Core/Trunk/GpsNEMA0183ProtocolHandler.c
+ * usage:      GpsNEMA0183Replay [-p passes] [-b blocksize] <log>
+ *             GpsNEMA0183Replay -g <log> [seconds] [rate]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup GpsNEMA0183ProtocolHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "GpsNEMA0183ProtocolHandler/GpsNEMA0183ProtocolHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default passes/block size
+#define DEFAULT_PASSES                              ( 50 )
+#define DEFAULT_BLOCK_SIZE                          ( 256 )
+
+/// define the default synthetic log length/rate
+#define DEFAULT_GEN_SECONDS                         ( 600 )
+#define DEFAULT_GEN_RATE                            ( 20 )
+
+/// define the reference parser limits
+#define REF_NUM_ARGS                                ( 32 )
+#define REF_ARG_LENGTH                              ( 16 )
+
+/// define the reference conversions, 1852 meters per nautical mile
+#define REF_KNOTS_TO_MMPS                           ( 1852000.0 / 3600.0 )
+#define REF_ROUND( d )                              (( long long )(( d ) + ((( d ) < 0 ) ? -0.5 : 0.5 )))
+
+// structures -----------------------------------------------------------------
+/// define the reference data
+typedef struct _REFDATA
+{
+  double    dUtc;                   ///< UTC hhmmss.sss
+  double    dLatitude;              ///< latitude in degrees
+  double    dLongitude;             ///< longitude in degrees
+  double    dAltitude;              ///< altitude in meters
+  double    dCourse;                ///< course in degrees
+  double    dSpeed;                 ///< speed in knots
+  unsigned  uSatSum;                ///< sum of the satellite fields
+  unsigned  uSentences;             ///< sentences parsed
+} REFDATA;
+
+// local parameter declarations -----------------------------------------------
+static  char    acRefArgs[ REF_NUM_ARGS ][ REF_ARG_LENGTH ];
+static  REFDATA tRefData;
+
+// local function prototypes --------------------------------------------------
+static  double    GetSeconds( void );
+static  char*     LoadFile( const char* pszName, size_t* ptLength );
+static  int       Generate( const char* pszName, unsigned uSeconds, unsigned uRate );
+static  void      WriteSentence( FILE* pfOut, const char* pszBody );
+static  void      ReferenceParse( const char* pcData, size_t tLength );
+static  void      ReferencePosition( unsigned uArg );
+static  double    ReferenceCoordinate( const char* pszField, const char* pszHemisphere );
+static  int       Verify( const char* pcData, size_t tLength );
+static  int       CompareFix( const GPSDATA* ptData );
+static  unsigned  ReplayChar( const char* pcData, size_t tLength, unsigned uPasses );
+static  unsigned  ReplayBlock( const char* pcData, size_t tLength, unsigned uPasses, unsigned uBlockSize );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  char*     pcData;
+  size_t    tLength;
+  unsigned  uPasses = DEFAULT_PASSES, uBlockSize = DEFAULT_BLOCK_SIZE, uPass, uEpochs = 0, uSentences;
+  unsigned  uCharSentences, uBlockSentences;
+  double    dStart, dChar, dBlock, dRef, dEpochRate;
+  GPSDATA   tData;
+  int       iArg, iStatus = 0;
+  const char* pcScan;
+
+  // check for generate
+  if (( argc >= 3 ) && ( strcmp( argv[ 1 ], "-g" ) == 0 ))
+  {
+    return( Generate( argv[ 2 ], ( argc > 3 ) ? atoi( argv[ 3 ] ) : DEFAULT_GEN_SECONDS, ( argc > 4 ) ? atoi( argv[ 4 ] ) : DEFAULT_GEN_RATE ));
+  }
+
+  // get the options
+  for ( iArg = 1; ( iArg < argc - 2 ) && ( argv[ iArg ][ 0 ] == '-' ); iArg += 2 )
+  {
+    if ( strcmp( argv[ iArg ], "-p" ) == 0 )
+    {
+      uPasses = atoi( argv[ iArg + 1 ] );
+    }
+    else if ( strcmp( argv[ iArg ], "-b" ) == 0 )
+    {
+      uBlockSize = atoi( argv[ iArg + 1 ] );
+    }
+  }
+  if (( iArg != argc - 1 ) || ( uPasses == 0 ) || ( uBlockSize == 0 ) || ( uBlockSize > 65535 ))
+  {
+    fprintf( stderr, "usage: %s [-p passes] [-b blocksize] <log>\n", argv[ 0 ] );
+    fprintf( stderr, "       %s -g <log> [seconds] [rate]\n", argv[ 0 ] );
+    return( 1 );
+  }
+
+  // load the log/count the epochs, one GGA per epoch
+  if (( pcData = LoadFile( argv[ iArg ], &tLength )) == NULL )
+  {
+    return( 1 );
+  }
+  for ( pcScan = pcData; ( pcScan = strstr( pcScan, "GGA," )) != NULL; pcScan += 4 )
+  {
+    uEpochs++;
+  }
+
+  // check every sentence first, the handler data is only cleared at startup
+  iStatus = Verify( pcData, tLength );
+
+  // time the reference
+  dStart = GetSeconds( );
+  for ( uPass = 0; uPass < uPasses; uPass++ )
+  {
+    memset( &tRefData, 0, sizeof( tRefData ));
+    ReferenceParse( pcData, tLength );
+  }
+  dRef = GetSeconds( ) - dStart;
+
+  // time the character and block paths
+  dStart = GetSeconds( );
+  uCharSentences = ReplayChar( pcData, tLength, uPasses );
+  dChar = GetSeconds( ) - dStart;
+  dStart = GetSeconds( );
+  uBlockSentences = ReplayBlock( pcData, tLength, uPasses, uBlockSize );
+  dBlock = GetSeconds( ) - dStart;
+  uSentences = uBlockSentences / uPasses;
+
+  // report
+  printf( "%s: %u bytes, %u epochs, %u handled sentences, %u checksum errors\n", argv[ iArg ], ( unsigned )tLength, uEpochs, uSentences, ( unsigned )GpsNEMA0183ProtocolHandler_GetChecksumErrors( ));
+  printf( "  %-22s %9.1f ns/sentence %8.1f MB/s\n", "reference copy/atof", dRef * 1E9 / (( double )tRefData.uSentences * uPasses ), ( tLength * ( double )uPasses ) / ( dRef * 1048576.0 ));
+  printf( "  %-22s %9.1f ns/sentence %8.1f MB/s\n", "handler char", dChar * 1E9 / (( double )uCharSentences ), ( tLength * ( double )uPasses ) / ( dChar * 1048576.0 ));
+  printf( "  %-22s %9.1f ns/sentence %8.1f MB/s\n", "handler block", dBlock * 1E9 / (( double )uBlockSentences ), ( tLength * ( double )uPasses ) / ( dBlock * 1048576.0 ));
+  if ( uEpochs != 0 )
+  {
+    // show the per epoch cost
+    dEpochRate = ( double )uEpochs * uPasses;
+    printf( "  per epoch: reference %.2f us, char %.2f us, block %.2f us\n", dRef * 1E6 / dEpochRate, dChar * 1E6 / dEpochRate, dBlock * 1E6 / dEpochRate );
+  }
+
+  // show the last fix/check the paths agree
+  GpsNEMA0183ProtocolHandler_GetData( &tData );
+  printf( "last fix: %.7f %.7f alt %.2f m course %.2f speed %u mm/s utc %u ms\n", tData.lLatitudeE7 / 1E7, tData.lLongitudeE7 / 1E7, tData.lAltitudeCm / 100.0, tData.wCourseCdeg / 100.0, ( unsigned )tData.uSpeedMmps, ( unsigned )tData.uUtcTimeMsec );
+  if ( uCharSentences != uBlockSentences )
+  {
+    fprintf( stderr, "char/block sentence counts differ: %u %u\n", uCharSentences, uBlockSentences );
+    iStatus = 1;
+  }
+  printf( "%s\n", ( iStatus == 0 ) ? "PASS" : "FAIL" );
+
+  // clean up
+  free( pcData );
+  return( iStatus );
+}
+
+/******************************************************************************
+ * @function GetSeconds
+ *
+ * @brief get the monotonic time
+ *
+ * @return      time in seconds
+ *
+ *****************************************************************************/
+static double GetSeconds( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec / 1E9 ));
+}
+
+/******************************************************************************
+ * @function LoadFile
+ *
+ * @brief load a file
+ *
+ * @param[in]   pszName     file name
+ * @param[io]   ptLength    pointer to store the length
+ *
+ * @return      allocated, NUL terminated contents or NULL on error
+ *
+ *****************************************************************************/
+static char* LoadFile( const char* pszName, size_t* ptLength )
+{
+  FILE* pfIn;
+  char* pcData = NULL;
+  long  lLength;
+
+  // open it/get the length
+  if (( pfIn = fopen( pszName, "rb" )) == NULL )
+  {
+    perror( pszName );
+  }
+  else
+  {
+    fseek( pfIn, 0, SEEK_END );
+    lLength = ftell( pfIn );
+    fseek( pfIn, 0, SEEK_SET );
+    if ((( pcData = malloc( lLength + 1 )) != NULL ) && ( fread( pcData, 1, lLength, pfIn ) == ( size_t )lLength ))
+    {
+      pcData[ lLength ] = '\0';
+      *ptLength = lLength;
+    }
+    else
+    {
+      fprintf( stderr, "%s: read error\n", pszName );
+      free( pcData );
+      pcData = NULL;
+    }
+    fclose( pfIn );
+  }
+
+  // return the data
+  return( pcData );
+}
+
+/******************************************************************************
+ * @function Generate
+ *
+ * @brief generate a synthetic log
+ *
+ * This function writes a multi-GNSS log, each epoch carries GGA/RMC/VTG/GSA
+ * and GSV sequences for GPS, GLONASS, Galileo and BeiDou
+ *
+ * @param[in]   pszName     file name
+ * @param[in]   uSeconds    length of the log
+ * @param[in]   uRate       epochs per second
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+static int Generate( const char* pszName, unsigned uSeconds, unsigned uRate )
+{
+  static const char* apszTalkers[ ] = { "GP", "GL", "GA", "GB" };
+  static const unsigned auSats[ ] = { 11, 7, 6, 9 };
+  FILE*     pfOut;
+  char      acBody[ 128 ];
+  unsigned  uEpoch, uTalker, uMsg, uMsgs, uSat, uMsec, uLen;
+  double    dLatitude = 42.3601, dLongitude = -71.0589, dLatMin, dLonMin;
+  int       iLatDeg, iLonDeg;
+
+  // open it
+  if (( uRate == 0 ) || (( pfOut = fopen( pszName, "wb" )) == NULL ))
+  {
+    perror( pszName );
+    return( 1 );
+  }
+
+  // for each epoch
+  for ( uEpoch = 0; uEpoch < uSeconds * uRate; uEpoch++ )
+  {
+    // move along a track/build the time and coordinates
+    dLatitude += 0.0000071;
+    dLongitude -= 0.0000093;
+    uMsec = ( 12 * 3600000 ) + (( uEpoch * 1000 ) / uRate );
+    iLatDeg = ( int )dLatitude;
+    dLatMin = ( dLatitude - iLatDeg ) * 60.0;
+    iLonDeg = ( int )-dLongitude;
+    dLonMin = ( -dLongitude - iLonDeg ) * 60.0;
+
+    // position/velocity
+    sprintf( acBody, "GNGGA,%02u%02u%02u.%03u,%02d%010.7f,N,%03d%010.7f,W,4,%u,0.6,%u.%02u,M,-33.9,M,1.0,0000", uMsec / 3600000, ( uMsec / 60000 ) % 60, ( uMsec / 1000 ) % 60, uMsec % 1000, iLatDeg, dLatMin, iLonDeg, dLonMin, 33, 25 + ( uEpoch % 7 ), uEpoch % 100 );
+    WriteSentence( pfOut, acBody );
+    sprintf( acBody, "GNRMC,%02u%02u%02u.%03u,A,%02d%010.7f,N,%03d%010.7f,W,%u.%03u,%u.%02u,190526,,,R,V", uMsec / 3600000, ( uMsec / 60000 ) % 60, ( uMsec / 1000 ) % 60, uMsec % 1000, iLatDeg, dLatMin, iLonDeg, dLonMin, 12 + ( uEpoch % 3 ), uEpoch % 1000, 232, uEpoch % 100 );
+    WriteSentence( pfOut, acBody );
+    sprintf( acBody, "GNVTG,%u.%02u,T,,M,%u.%03u,N,%u.%03u,K,R", 232, uEpoch % 100, 12 + ( uEpoch % 3 ), uEpoch % 1000, 22 + ( uEpoch % 5 ), uEpoch % 1000 );
+    WriteSentence( pfOut, acBody );
+    sprintf( acBody, "GNGSA,A,3,02,05,07,13,15,18,20,23,29,30,,,1.1,0.6,0.9,1" );
+    WriteSentence( pfOut, acBody );
+
+    // satellites in view for each constellation
+    for ( uTalker = 0; uTalker < 4; uTalker++ )
+    {
+      uMsgs = ( auSats[ uTalker ] + 3 ) / 4;
+      for ( uMsg = 0; uMsg < uMsgs; uMsg++ )
+      {
+        uLen = sprintf( acBody, "%sGSV,%u,%u,%02u", apszTalkers[ uTalker ], uMsgs, uMsg + 1, auSats[ uTalker ] );
+        for ( uSat = uMsg * 4; ( uSat < ( uMsg + 1 ) * 4 ) && ( uSat < auSats[ uTalker ] ); uSat++ )
+        {
+          uLen += sprintf( acBody + uLen, ",%02u,%02u,%03u,%02u", uSat + 1 + ( uTalker * 32 ), ( uSat * 7 ) % 90, ( uSat * 37 ) % 360, 20 + (( uSat + uEpoch ) % 30 ));
+        }
+        WriteSentence( pfOut, acBody );
+      }
+    }
+  }
+
+  // close it
+  fclose( pfOut );
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function WriteSentence
+ *
+ * @brief write a sentence
+ *
+ * This function writes the start, body, checksum and line ending
+ *
+ * @param[in]   pfOut       output file
+ * @param[in]   pszBody     sentence body
+ *
+ *****************************************************************************/
+static void WriteSentence( FILE* pfOut, const char* pszBody )
+{
+  const char* pcScan;
+  unsigned    uChecksum = 0;
+
+  // compute the checksum/write it
+  for ( pcScan = pszBody; *pcScan != '\0'; pcScan++ )
+  {
+    uChecksum ^= ( unsigned char )*pcScan;
+  }
+  fprintf( pfOut, "$%s*%02X\r\n", pszBody, uChecksum );
+}
+
+/******************************************************************************
+ * @function ReferenceParse
+ *
+ * @brief reference parser
+ *
+ * This function parses the log the way the handler used to, copying every
+ * field and converting with atof
+ *
+ * @param[in]   pcData      log data
+ * @param[in]   tLength     log length
+ *
+ *****************************************************************************/
+static void ReferenceParse( const char* pcData, size_t tLength )
+{
+  const char* pcEnd = pcData + tLength;
+  char        acCommand[ 8 ];
+  unsigned    uArg, uIdx, uCmdLen, uSat;
+
+  // for each sentence
+  while (( pcData < pcEnd ) && (( pcData = memchr( pcData, '$', pcEnd - pcData )) != NULL ))
+  {
+    // copy the address
+    pcData++;
+    for ( uCmdLen = 0; ( pcData < pcEnd ) && ( *pcData != ',' ) && ( *pcData != '*' ); pcData++ )
+    {
+      if ( uCmdLen < sizeof( acCommand ) - 1 )
+      {
+        acCommand[ uCmdLen++ ] = *pcData;
+      }
+    }
+    acCommand[ uCmdLen ] = '\0';
+
+    // copy the fields
+    memset( acRefArgs, 0, sizeof( acRefArgs ));
+    for ( uArg = 0, uIdx = 0; ( pcData < pcEnd ) && ( *pcData != '*' ) && ( *pcData != '\n' ); pcData++ )
+    {
+      if ( *pcData == ',' )
+      {
+        // terminate the field, the first one is the empty address remainder
+        acRefArgs[ uArg ][ uIdx ] = '\0';
+        uArg = ( uArg < REF_NUM_ARGS - 1 ) ? uArg + 1 : uArg;
+        uIdx = 0;
+      }
+      else if ( uIdx < REF_ARG_LENGTH - 1 )
+      {
+        acRefArgs[ uArg ][ uIdx++ ] = *pcData;
+      }
+    }
+
+    // dispatch on the formatter
+    if ( uCmdLen == 5 )
+    {
+      // empty fields leave the previous value, as the handler does
+      if ( strcmp( &acCommand[ 2 ], "GGA" ) == 0 )
+      {
+        tRefData.dUtc = ( acRefArgs[ 1 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 1 ] ) : tRefData.dUtc;
+        ReferencePosition( 2 );
+        tRefData.dAltitude = ( acRefArgs[ 9 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 9 ] ) : tRefData.dAltitude;
+        tRefData.uSentences++;
+      }
+      else if ( strcmp( &acCommand[ 2 ], "GLL" ) == 0 )
+      {
+        if ( acRefArgs[ 6 ][ 0 ] != 'V' )
+        {
+          ReferencePosition( 1 );
+          tRefData.dUtc = ( acRefArgs[ 5 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 5 ] ) : tRefData.dUtc;
+        }
+        tRefData.uSentences++;
+      }
+      else if ( strcmp( &acCommand[ 2 ], "RMC" ) == 0 )
+      {
+        tRefData.dUtc = ( acRefArgs[ 1 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 1 ] ) : tRefData.dUtc;
+        if ( acRefArgs[ 2 ][ 0 ] == 'A' )
+        {
+          ReferencePosition( 3 );
+          tRefData.dSpeed = ( acRefArgs[ 7 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 7 ] ) : tRefData.dSpeed;
+          tRefData.dCourse = ( acRefArgs[ 8 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 8 ] ) : tRefData.dCourse;
+        }
+        tRefData.uSentences++;
+      }
+      else if ( strcmp( &acCommand[ 2 ], "VTG" ) == 0 )
+      {
+        tRefData.dCourse = ( acRefArgs[ 1 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 1 ] ) : tRefData.dCourse;
+        tRefData.dSpeed = ( acRefArgs[ 5 ][ 0 ] != '\0' ) ? atof( acRefArgs[ 5 ] ) : tRefData.dSpeed;
+        tRefData.uSentences++;
+      }
+      else if ( strcmp( &acCommand[ 2 ], "GSV" ) == 0 )
+      {
+        for ( uSat = 4; uSat < REF_NUM_ARGS - 3; uSat += 4 )
+        {
+          tRefData.uSatSum += atoi( acRefArgs[ uSat ] ) + atoi( acRefArgs[ uSat + 1 ] ) + atoi( acRefArgs[ uSat + 2 ] ) + atoi( acRefArgs[ uSat + 3 ] );
+        }
+        tRefData.uSentences++;
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function ReferencePosition
+ *
+ * @brief reference position conversion
+ *
+ * This function converts the latitude, north/south, longitude and east/west
+ * fields, a position with an empty coordinate is ignored
+ *
+ * @param[in]   uArg        argument index of the latitude
+ *
+ *****************************************************************************/
+static void ReferencePosition( unsigned uArg )
+{
+  // convert it if both coordinates are present
+  if (( acRefArgs[ uArg ][ 0 ] != '\0' ) && ( acRefArgs[ uArg + 2 ][ 0 ] != '\0' ))
+  {
+    tRefData.dLatitude = ReferenceCoordinate( acRefArgs[ uArg ], acRefArgs[ uArg + 1 ] );
+    tRefData.dLongitude = ReferenceCoordinate( acRefArgs[ uArg + 2 ], acRefArgs[ uArg + 3 ] );
+  }
+}
+
+/******************************************************************************
+ * @function ReferenceCoordinate
+ *
+ * @brief reference coordinate conversion
+ *
+ * @param[in]   pszField        (d)ddmm.mmmm field
+ * @param[in]   pszHemisphere   hemisphere field
+ *
+ * @return      signed degrees
+ *
+ *****************************************************************************/
+static double ReferenceCoordinate( const char* pszField, const char* pszHemisphere )
+{
+  double  dValue, dDegrees;
+
+  // convert it
+  dValue = atof( pszField );
+  dDegrees = ( int )( dValue / 100 );
+  dValue = dDegrees + (( dValue - ( dDegrees * 100 )) / 60.0 );
+  return((( *pszHemisphere == 'S' ) || ( *pszHemisphere == 'W' )) ? -dValue : dValue );
+}
+
+/******************************************************************************
+ * @function Verify
+ *
+ * @brief verify every sentence against the reference
+ *
+ * This function feeds the log a sentence at a time to both the handler and
+ * the reference parser and compares the fix after each one, sentences that
+ * fail the checksum are dropped from the reference as well.  It must run
+ * before any other replay as the handler keeps its fix across initialization
+ *
+ * @param[in]   pcData      log data
+ * @param[in]   tLength     log length
+ *
+ * @return      0 if OK, 1 on the first mismatch
+ *
+ *****************************************************************************/
+static int Verify( const char* pcData, size_t tLength )
+{
+  const char* pcEnd = pcData + tLength;
+  const char* pcNext;
+  REFDATA     tPrevRef;
+  GPSDATA     tData;
+  unsigned    uLine = 0, uChecked = 0;
+  U32         uErrors, uSentences;
+
+  // start both parsers clean
+  GpsNEMA0183ProtocolHandler_Initialize( );
+  memset( &tRefData, 0, sizeof( tRefData ));
+
+  // for each sentence
+  while (( pcData < pcEnd ) && (( pcData = memchr( pcData, '$', pcEnd - pcData )) != NULL ))
+  {
+    // find the end of the line, sentences longer than a block are not valid
+    pcNext = memchr( pcData, '\n', pcEnd - pcData );
+    pcNext = ( pcNext != NULL ) ? pcNext + 1 : pcEnd;
+    uLine++;
+
+    // parse it with both
+    tPrevRef = tRefData;
+    uErrors = GpsNEMA0183ProtocolHandler_GetChecksumErrors( );
+    uSentences = GpsNEMA0183ProtocolHandler_GetSentenceCount( );
+    GpsNEMA0183ProtocolHandler_ProcessBlock(( PU8 )pcData, ( U16 )MIN( pcNext - pcData, 65535 ));
+    ReferenceParse( pcData, pcNext - pcData );
+    if ( GpsNEMA0183ProtocolHandler_GetChecksumErrors( ) != uErrors )
+    {
+      // the handler dropped it
+      tRefData = tPrevRef;
+    }
+    else if (( GpsNEMA0183ProtocolHandler_GetSentenceCount( ) - uSentences ) != ( tRefData.uSentences - tPrevRef.uSentences ))
+    {
+      fprintf( stderr, "sentence %u: handled by %s only: %.*s", uLine, ( tRefData.uSentences != tPrevRef.uSentences ) ? "reference" : "handler", ( int )( pcNext - pcData ), pcData );
+      return( 1 );
+    }
+    else if ( tRefData.uSentences != tPrevRef.uSentences )
+    {
+      // compare the fix
+      GpsNEMA0183ProtocolHandler_GetData( &tData );
+      if ( CompareFix( &tData ) != 0 )
+      {
+        fprintf( stderr, "sentence %u: %.*s", uLine, ( int )( pcNext - pcData ), pcData );
+        return( 1 );
+      }
+      uChecked++;
+    }
+
+    // next sentence
+    pcData = pcNext;
+  }
+
+  // report
+  printf( "verified %u sentences against the reference\n", uChecked );
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function CompareFix
+ *
+ * @brief compare the handler fix against the reference
+ *
+ * This function compares the time, position, altitude, course and speed,
+ * allowing one count of rounding in the fixed point values
+ *
+ * @param[in]   ptData      pointer to the handler data
+ *
+ * @return      0 if OK, 1 on a mismatch
+ *
+ *****************************************************************************/
+static int CompareFix( const GPSDATA* ptData )
+{
+  long long llUtc, llRefMsec;
+  int       iStatus = 0;
+
+  // convert the reference hhmmss.sss time to milliseconds
+  llUtc = REF_ROUND( tRefData.dUtc * 1000.0 );
+  llRefMsec = (( llUtc / 10000000 ) * 3600000 ) + ((( llUtc / 100000 ) % 100 ) * 60000 ) + ( llUtc % 100000 );
+
+  // compare each field
+  if ( ptData->uUtcTimeMsec != llRefMsec )
+  {
+    fprintf( stderr, "time %u ms, reference %lld ms\n", ( unsigned )ptData->uUtcTimeMsec, llRefMsec );
+    iStatus = 1;
+  }
+  if ( llabs( ptData->lLatitudeE7 - REF_ROUND( tRefData.dLatitude * 1E7 )) > 1 )
+  {
+    fprintf( stderr, "latitude %.7f, reference %.7f\n", ptData->lLatitudeE7 / 1E7, tRefData.dLatitude );
+    iStatus = 1;
+  }
+  if ( llabs( ptData->lLongitudeE7 - REF_ROUND( tRefData.dLongitude * 1E7 )) > 1 )
+  {
+    fprintf( stderr, "longitude %.7f, reference %.7f\n", ptData->lLongitudeE7 / 1E7, tRefData.dLongitude );
+    iStatus = 1;
+  }
+  if ( llabs( ptData->lAltitudeCm - REF_ROUND( tRefData.dAltitude * 100.0 )) > 1 )
+  {
+    fprintf( stderr, "altitude %.2f m, reference %.2f m\n", ptData->lAltitudeCm / 100.0, tRefData.dAltitude );
+    iStatus = 1;
+  }
+  if ( llabs( ptData->wCourseCdeg - REF_ROUND( tRefData.dCourse * 100.0 )) > 1 )
+  {
+    fprintf( stderr, "course %.2f, reference %.2f\n", ptData->wCourseCdeg / 100.0, tRefData.dCourse );
+    iStatus = 1;
+  }
+  if ( llabs(( long long )ptData->uSpeedMmps - REF_ROUND( tRefData.dSpeed * REF_KNOTS_TO_MMPS )) > 1 )
+  {
+    fprintf( stderr, "speed %u mm/s, reference %.3f knots\n", ( unsigned )ptData->uSpeedMmps, tRefData.dSpeed );
+    iStatus = 1;
+  }
+
+  // return the status
+  return( iStatus );
+}
+
+/******************************************************************************
+ * @function ReplayChar
+ *
+ * @brief replay a character at a time
+ *
+ * @param[in]   pcData      log data
+ * @param[in]   tLength     log length
+ * @param[in]   uPasses     number of passes
+ *
+ * @return      sentences handled
+ *
+ *****************************************************************************/
+static unsigned ReplayChar( const char* pcData, size_t tLength, unsigned uPasses )
+{
+  size_t    tIndex;
+  unsigned  uPass;
+
+  // replay it
+  GpsNEMA0183ProtocolHandler_Initialize( );
+  for ( uPass = 0; uPass < uPasses; uPass++ )
+  {
+    for ( tIndex = 0; tIndex < tLength; tIndex++ )
+    {
+      GpsNEMA0183ProtocolHandler_ProcessChar(( U8 )pcData[ tIndex ] );
+    }
+  }
+
+  // return the count
+  return( GpsNEMA0183ProtocolHandler_GetSentenceCount( ));
+}
+
+/******************************************************************************
+ * @function ReplayBlock
+ *
+ * @brief replay in blocks
+ *
+ * @param[in]   pcData      log data
+ * @param[in]   tLength     log length
+ * @param[in]   uPasses     number of passes
+ * @param[in]   uBlockSize  block size
+ *
+ * @return      sentences handled
+ *
+ *****************************************************************************/
+static unsigned ReplayBlock( const char* pcData, size_t tLength, unsigned uPasses, unsigned uBlockSize )
+{
+  size_t    tIndex;
+  unsigned  uPass;
+
+  // replay it
+  GpsNEMA0183ProtocolHandler_Initialize( );
+  for ( uPass = 0; uPass < uPasses; uPass++ )
+  {
+    for ( tIndex = 0; tIndex < tLength; tIndex += uBlockSize )
+    {
+      GpsNEMA0183ProtocolHandler_ProcessBlock(( PU8 )pcData + tIndex, ( U16 )MIN( uBlockSize, tLength - tIndex ));
+    }
+  }
+
+  // return the count
+  return( GpsNEMA0183ProtocolHandler_GetSentenceCount( ));
+}
+
+/**@} EOF GpsNEMA0183Replay.c */
@@ -37,6 +37,9 @@
 /// define the sensor manager argument type using on eof the three above defines
 #define ALARMHANDLER_ARGUMENT_TYPE             ( ALARMHANDLER_TYPE_SIGNED16 )
 
+/// define the macro to enable the multi-channel table evaluation
+#define ALARMHANDLER_ENABLE_TABLE              ( ON )
+
 /**@} EOF AlarmHandler_prm.h */
 
 #endif  // _ALARMHANDLER_PRM_H
\ No newline at end of file
@@ -29,6 +29,8 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the number of channels checked per block, one changed mask word
+#define ALARM_BLOCK_CHANNELS          ( 32 )
 
 // enumerations ---------------------------------------------------------------
 
@@ -41,6 +43,27 @@
 // local function prototypes --------------------------------------------------
 
 // constant parameter initializations -----------------------------------------
+#if ( ALARMHANDLER_ENABLE_TABLE == ON )
+/// define the severity of each status, used to hold latched alarms
+static  const CODE U8 anSeverity[ ALARM_STS_MAX ] =
+{
+  0,      ///< ALARM_STS_NONE
+  2,      ///< ALARM_STS_LOLO
+  1,      ///< ALARM_STS_LO
+  1,      ///< ALARM_STS_HI
+  2,      ///< ALARM_STS_HIHI
+};
+
+/// define the status for each combination of threshold tests, indexed by the
+/// enable flags of the thresholds that tested true
+static  const CODE U8 aePriority[ 16 ] =
+{
+  ALARM_STS_NONE, ALARM_STS_LOLO, ALARM_STS_LO,   ALARM_STS_LOLO,
+  ALARM_STS_HI,   ALARM_STS_LOLO, ALARM_STS_LO,   ALARM_STS_LOLO,
+  ALARM_STS_HIHI, ALARM_STS_LOLO, ALARM_STS_LO,   ALARM_STS_LOLO,
+  ALARM_STS_HIHI, ALARM_STS_LOLO, ALARM_STS_LO,   ALARM_STS_LOLO,
+};
+#endif // ALARMHANDLER_ENABLE_TABLE
 
 /******************************************************************************
  * @function AlarmHandler_CheckAlarm
@@ -86,4 +109,223 @@ ALARMSTS AlarmHandler_CheckAlarm( ALARMARG xArg, PALARMDEF ptAlarmDef )
   return( eStatus );
 }
  
+#if ( ALARMHANDLER_ENABLE_TABLE == ON )
+/******************************************************************************
+ * @function AlarmHandler_ResetTable
+ *
+ * @brief reset a multi-channel alarm table
+ *
+ * This function will clear the status, qualification and acknowledge state
+ * of every channel in the table
+ *
+ * @param[in]   ptDef       pointer to the table definition
+ * @param[in]   ptState     pointer to the table state
+ *
+ *****************************************************************************/
+void AlarmHandler_ResetTable( PALARMTBLDEF ptDef, PALARMTBLSTATE ptState )
+{
+  U16 wChan;
+
+  // for each channel
+  for ( wChan = 0; wChan < ptDef->wNumChannels; wChan++ )
+  {
+    // clear the state
+    ptState->pnStatus[ wChan ] = ALARM_STS_NONE;
+    ptState->pnPending[ wChan ] = ALARM_STS_NONE;
+    ptState->pwCount[ wChan ] = 0;
+    ptState->pnFlags[ wChan ] = 0;
+  }
+}
+
+/******************************************************************************
+ * @function AlarmHandler_CheckTable
+ *
+ * @brief check a block of values against a multi-channel alarm table
+ *
+ * This function will check one sample per channel in a single pass over the
+ * table arrays. The thresholds are tested in the same order as
+ * AlarmHandler_CheckAlarm, an active alarm only clears once the value is past
+ * its threshold by the hysteresis, a new status must be seen for the delay
+ * count of consecutive samples before it is taken, and a latched alarm will
+ * not drop in severity until it has been acknowledged. A bit is set in the
+ * changed mask for each channel whose status changed. A quiet channel, one
+ * with no alarm, nothing pending and inside its enabled thresholds, is
+ * passed over after the same tests as the single check, so the table costs
+ * no more than a loop of single checks in the normal case
+ *
+ * @param[in]   pxArgs      pointer to the values, one per channel
+ * @param[in]   ptDef       pointer to the table definition
+ * @param[in]   ptState     pointer to the table state
+ * @param[io]   puChanged   pointer to the changed mask, ALARM_CHANGED_WORDS long
+ *
+ * @return      number of channels that changed
+ *
+ *****************************************************************************/
+U16 AlarmHandler_CheckTable( PALARMARG pxArgs, PALARMTBLDEF ptDef, PALARMTBLSTATE ptState, PU32 puChanged )
+{
+  U16       wBase, wBlock, wIdx, wChan, wNumChans, wNumChanged, wDelay;
+  U32       uMask;
+  ALARMARG  xArg, xLoLoHyst, xLoHyst, xHiHyst, xHiHiHyst;
+  ALARMSTS  eCurStatus, eNewStatus;
+  U8        nFlags, nTests;
+  PALARMARG pxLoLo, pxLo, pxHi, pxHiHi;
+  PU8       pnDefFlags, pnStatus;
+  PU16      pwCount;
+
+  // copy the arrays used for every channel to locals, the state stores would otherwise force a reload of each one per channel
+  wNumChans = ptDef->wNumChannels;
+  pxLoLo = ptDef->pxLoLoThreshold;
+  pxLo = ptDef->pxLoThreshold;
+  pxHi = ptDef->pxHiThreshold;
+  pxHiHi = ptDef->pxHiHiThreshold;
+  pnDefFlags = ptDef->pnFlags;
+  pnStatus = ptState->pnStatus;
+  pwCount = ptState->pwCount;
+
+  // clear the changed count
+  wNumChanged = 0;
+
+  // for each block of channels, one changed mask word each
+  for ( wBase = 0; wBase < wNumChans; wBase += ALARM_BLOCK_CHANNELS )
+  {
+    // get the block size/clear the mask
+    wBlock = MIN( wNumChans - wBase, ALARM_BLOCK_CHANNELS );
+    uMask = 0;
+
+    // for each channel in the block
+    for ( wIdx = 0; wIdx < wBlock; wIdx++ )
+    {
+      // a quiet channel, no alarm, nothing pending and inside its enabled thresholds, needs no more work
+      wChan = wBase + wIdx;
+      eCurStatus = ( ALARMSTS )pnStatus[ wChan ];
+      xArg = pxArgs[ wChan ];
+      nFlags = pnDefFlags[ wChan ];
+      if (( eCurStatus == ALARM_STS_NONE ) && ( pwCount[ wChan ] == 0 ) &&
+          (( xArg > pxLo[ wChan ] ) || !( nFlags & ALARM_FLAG_LOENABLE )) &&
+          (( xArg < pxHi[ wChan ] ) || !( nFlags & ALARM_FLAG_HIENABLE )) &&
+          (( xArg > pxLoLo[ wChan ] ) || !( nFlags & ALARM_FLAG_LLENABLE )) &&
+          (( xArg < pxHiHi[ wChan ] ) || !( nFlags & ALARM_FLAG_HHENABLE )))
+      {
+        continue;
+      }
+
+      // only the active alarms need their hysteresis
+      xLoLoHyst = xLoHyst = xHiHyst = xHiHiHyst = 0;
+      switch( eCurStatus )
+      {
+        case ALARM_STS_LOLO :
+          xLoLoHyst = ( ptDef->pxLoLoHysteresis != NULL ) ? ptDef->pxLoLoHysteresis[ wChan ] : 0;
+          xLoHyst = ( ptDef->pxLoHysteresis != NULL ) ? ptDef->pxLoHysteresis[ wChan ] : 0;
+          break;
+
+        case ALARM_STS_LO :
+          xLoHyst = ( ptDef->pxLoHysteresis != NULL ) ? ptDef->pxLoHysteresis[ wChan ] : 0;
+          break;
+
+        case ALARM_STS_HI :
+          xHiHyst = ( ptDef->pxHiHysteresis != NULL ) ? ptDef->pxHiHysteresis[ wChan ] : 0;
+          break;
+
+        case ALARM_STS_HIHI :
+          xHiHiHyst = ( ptDef->pxHiHiHysteresis != NULL ) ? ptDef->pxHiHiHysteresis[ wChan ] : 0;
+          xHiHyst = ( ptDef->pxHiHysteresis != NULL ) ? ptDef->pxHiHysteresis[ wChan ] : 0;
+          break;
+
+        default :
+          break;
+      }
+
+      // test all the thresholds without branching, masked by the enables
+      nTests  = ( xArg <= ( pxLoLo[ wChan ] + xLoLoHyst )) ? ALARM_FLAG_LLENABLE : 0;
+      nTests |= ( xArg <= ( pxLo[ wChan ] + xLoHyst )) ? ALARM_FLAG_LOENABLE : 0;
+      nTests |= ( xArg >= ( pxHi[ wChan ] - xHiHyst )) ? ALARM_FLAG_HIENABLE : 0;
+      nTests |= ( xArg >= ( pxHiHi[ wChan ] - xHiHiHyst )) ? ALARM_FLAG_HHENABLE : 0;
+      nTests &= nFlags;
+
+      // pick the status in the same order as the single check
+      eNewStatus = ( ALARMSTS )PGM_RDBYTE( aePriority[ nTests ] );
+
+      // check for a change
+      if ( eNewStatus != eCurStatus )
+      {
+        // a latched unacknowledged alarm can not drop in severity
+        if (( ptState->pnFlags[ wChan ] & ALARM_STATE_UNACKED ) && ( PGM_RDBYTE( anSeverity[ eNewStatus ] ) < PGM_RDBYTE( anSeverity[ eCurStatus ] )))
+        {
+          // hold the current status, clear any pending qualification
+          ptState->pnPending[ wChan ] = eCurStatus;
+          pwCount[ wChan ] = 0;
+        }
+        else
+        {
+          // get the delay
+          wDelay = ( ptDef->pwDelay != NULL ) ? ptDef->pwDelay[ wChan ] : 0;
+
+          // check for the same pending status
+          if ( eNewStatus == ( ALARMSTS )ptState->pnPending[ wChan ] )
+          {
+            // increment the count
+            pwCount[ wChan ]++;
+          }
+          else
+          {
+            // start a new qualification
+            ptState->pnPending[ wChan ] = eNewStatus;
+            pwCount[ wChan ] = 1;
+          }
+
+          // check for qualified
+          if ( pwCount[ wChan ] >= wDelay )
+          {
+            // take the new status
+            pnStatus[ wChan ] = eNewStatus;
+            ptState->pnPending[ wChan ] = eNewStatus;
+            pwCount[ wChan ] = 0;
+
+            // if latched and entering an alarm, set the unacknowledged flag
+            if (( nFlags & ALARM_FLAG_LATCH ) && ( eNewStatus != ALARM_STS_NONE ))
+            {
+              ptState->pnFlags[ wChan ] |= ALARM_STATE_UNACKED;
+            }
+
+            // flag the change
+            uMask |= ( U32 )1 << wIdx;
+            wNumChanged++;
+          }
+        }
+      }
+      else if ( pwCount[ wChan ] != 0 )
+      {
+        // clear the pending qualification
+        ptState->pnPending[ wChan ] = eCurStatus;
+        pwCount[ wChan ] = 0;
+      }
+    }
+
+    // store the mask word
+    *( puChanged++ ) = uMask;
+  }
+
+  // return the number changed
+  return( wNumChanged );
+}
+
+/******************************************************************************
+ * @function AlarmHandler_Acknowledge
+ *
+ * @brief acknowledge a latched alarm
+ *
+ * This function will acknowledge a latched alarm, the status will follow the
+ * value from the next check
+ *
+ * @param[in]   ptState     pointer to the table state
+ * @param[in]   wChannel    channel to acknowledge
+ *
+ *****************************************************************************/
+void AlarmHandler_Acknowledge( PALARMTBLSTATE ptState, U16 wChannel )
+{
+  // clear the unacknowledged flag
+  ptState->pnFlags[ wChannel ] &= ~ALARM_STATE_UNACKED;
+}
+#endif // ALARMHANDLER_ENABLE_TABLE
+
 /**@} EOF AlarmHandler.c */
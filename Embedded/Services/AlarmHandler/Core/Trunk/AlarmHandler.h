@@ -47,6 +47,19 @@
     .tEnableFlags.bHHEnable = hhenab, \
   }
 
+/// define the table channel flags
+#define ALARM_FLAG_LLENABLE                   ( 0x01 )
+#define ALARM_FLAG_LOENABLE                   ( 0x02 )
+#define ALARM_FLAG_HIENABLE                   ( 0x04 )
+#define ALARM_FLAG_HHENABLE                   ( 0x08 )
+#define ALARM_FLAG_LATCH                      ( 0x10 )
+
+/// define the table channel state flags
+#define ALARM_STATE_UNACKED                   ( 0x01 )
+
+/// define the number of changed words for a number of channels
+#define ALARM_CHANGED_WORDS( chans )          ((( chans ) + 31 ) / 32 )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the return status
 typedef enum _ALARMSTS
@@ -56,6 +69,7 @@ typedef enum _ALARMSTS
   ALARM_STS_LO,
   ALARM_STS_HI,
   ALARM_STS_HIHI,
+  ALARM_STS_MAX
 } ALARMSTS;
 
 // structures -----------------------------------------------------------------
@@ -91,10 +105,45 @@ typedef struct _ALARMDEF
 } ALARMDEF, *PALARMDEF;
 #define ALARMDEF_SIZE             sizeof( ALARMDEF )
 
+#if ( ALARMHANDLER_ENABLE_TABLE == ON )
+/// define the multi-channel table, each member is an array of one entry per
+/// channel, the hysteresis and delay arrays may be NULL for none
+typedef struct _ALARMTBLDEF
+{
+  U16       wNumChannels;       ///< number of channels
+  PALARMARG pxLoLoThreshold;    ///< lo-lo thresholds
+  PALARMARG pxLoThreshold;      ///< lo thresholds
+  PALARMARG pxHiThreshold;      ///< hi thresholds
+  PALARMARG pxHiHiThreshold;    ///< hi-hi thresholds
+  PALARMARG pxLoLoHysteresis;   ///< lo-lo hysteresis, added to leave the alarm
+  PALARMARG pxLoHysteresis;     ///< lo hysteresis, added to leave the alarm
+  PALARMARG pxHiHysteresis;     ///< hi hysteresis, subtracted to leave the alarm
+  PALARMARG pxHiHiHysteresis;   ///< hi-hi hysteresis, subtracted to leave the alarm
+  PU16      pwDelay;            ///< samples a new status must persist before it is taken
+  PU8       pnFlags;            ///< enable/latch flags
+} ALARMTBLDEF, *PALARMTBLDEF;
+#define ALARMTBLDEF_SIZE          sizeof( ALARMTBLDEF )
+
+/// define the multi-channel state, each member is an array of one entry per channel
+typedef struct _ALARMTBLSTATE
+{
+  PU8       pnStatus;           ///< current status
+  PU8       pnPending;          ///< status waiting for qualification
+  PU16      pwCount;            ///< qualification count
+  PU8       pnFlags;            ///< state flags
+} ALARMTBLSTATE, *PALARMTBLSTATE;
+#define ALARMTBLSTATE_SIZE        sizeof( ALARMTBLSTATE )
+#endif // ALARMHANDLER_ENABLE_TABLE
+
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
 extern  ALARMSTS  AlarmHandler_CheckAlarm( ALARMARG xArg, PALARMDEF ptAlarmDef );
+#if ( ALARMHANDLER_ENABLE_TABLE == ON )
+extern  void      AlarmHandler_ResetTable( PALARMTBLDEF ptDef, PALARMTBLSTATE ptState );
+extern  U16       AlarmHandler_CheckTable( PALARMARG pxArgs, PALARMTBLDEF ptDef, PALARMTBLSTATE ptState, PU32 puChanged );
+extern  void      AlarmHandler_Acknowledge( PALARMTBLSTATE ptState, U16 wChannel );
+#endif // ALARMHANDLER_ENABLE_TABLE
 
 /**@} EOF AlarmHandler.h */
 
@@ -0,0 +1,539 @@
+/******************************************************************************
+ * @file AlarmHandlerBenchmark.c
+ *
+ * @brief alarm handler benchmark
+ *
+ * This file provides a host tool that checks a bank of channels with the
+ * multi-channel table and with a loop of single channel checks.  It first
+ * runs random samples through both with no hysteresis, delay or latching and
+ * checks the status and changed mask of every channel agree, then times
+ * both, interleaved over several rounds with the best round of each
+ * reported, counts the status changes on noisy channels with and without
+ * hysteresis and delay, and checks a latched alarm holds until acknowledged.
+ * It exits non zero on any mismatch.
+ *
+ * build with: cc -O2 -I. -I<include root> -o AlarmHandlerBenchmark
+ *             AlarmHandlerBenchmark.c ../../Core/Trunk/AlarmHandler.c
+ * usage:      AlarmHandlerBenchmark [channels] [passes] [seed]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup AlarmHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "AlarmHandler/AlarmHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the defaults
+#define DEFAULT_CHANNELS                            ( 1000 )
+#define DEFAULT_PASSES                              ( 4000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the number of sample sets the timing cycles through
+#define POOL_SETS                                   ( 64 )
+
+/// define the number of interleaved timing rounds
+#define TIMING_ROUNDS                               ( 7 )
+
+/// define the number of samples for the equivalence/chatter checks
+#define CHECK_SAMPLES                               ( 2000 )
+
+/// define the noise and filtering for the chatter check
+#define NOISE_AMPLITUDE                             ( 20 )
+#define CHATTER_HYSTERESIS                          ( 25 )
+#define CHATTER_DELAY                               ( 3 )
+
+// local parameter declarations -----------------------------------------------
+static  int           iNumChannels;
+static  ALARMDEF*     ptSingleDefs;
+static  ALARMARG*     pxLoLo;
+static  ALARMARG*     pxLo;
+static  ALARMARG*     pxHi;
+static  ALARMARG*     pxHiHi;
+static  ALARMARG*     pxHyst;
+static  U16*          pwDelay;
+static  U8*           pnDefFlags;
+static  ALARMARG*     pxValues;
+static  U8*           pnSingleStatus;
+static  U32*          puChanged;
+static  ALARMTBLDEF   tDef;
+static  ALARMTBLSTATE tState;
+
+// local function prototypes --------------------------------------------------
+static  void    BuildTables( BOOL bFilter, BOOL bLatch );
+static  void    RandomSamples( void );
+static  void    TypicalSamples( void );
+static  void    NoisySamples( int iSample );
+static  int     CheckEquivalence( void );
+static  void    RunTiming( int iPasses );
+static  void    RunChatter( void );
+static  int     CheckLatch( void );
+static  double  GetSeconds( void );
+static  void*   Allocate( size_t tSize );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will allocate the tables and run each check
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int iPasses, iErrors;
+
+  // get the arguments
+  iNumChannels = ( iArgc > 1 ) ? atoi( ppszArgv[ 1 ] ) : DEFAULT_CHANNELS;
+  iPasses = ( iArgc > 2 ) ? atoi( ppszArgv[ 2 ] ) : DEFAULT_PASSES;
+  srand(( iArgc > 3 ) ? atoi( ppszArgv[ 3 ] ) : DEFAULT_SEED );
+
+  // allocate the arrays
+  ptSingleDefs = Allocate( iNumChannels * sizeof( ALARMDEF ));
+  pxLoLo = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pxLo = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pxHi = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pxHiHi = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pxHyst = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pwDelay = Allocate( iNumChannels * sizeof( U16 ));
+  pnDefFlags = Allocate( iNumChannels );
+  pxValues = Allocate( iNumChannels * sizeof( ALARMARG ));
+  pnSingleStatus = Allocate( iNumChannels );
+  puChanged = Allocate( ALARM_CHANGED_WORDS( iNumChannels ) * sizeof( U32 ));
+  tState.pnStatus = Allocate( iNumChannels );
+  tState.pnPending = Allocate( iNumChannels );
+  tState.pwCount = Allocate( iNumChannels * sizeof( U16 ));
+  tState.pnFlags = Allocate( iNumChannels );
+
+  // run the checks
+  printf( "channels %d, argument size %d bytes\n", iNumChannels, ( int )sizeof( ALARMARG ));
+  iErrors = CheckEquivalence( );
+  RunTiming( iPasses );
+  RunChatter( );
+  iErrors += CheckLatch( );
+
+  // report
+  printf( "%s\n", ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function BuildTables
+ *
+ * @brief build random thresholds
+ *
+ * This function will build random ordered thresholds and enables, and fill
+ * the single channel definitions and the table with the same values
+ *
+ * @param[in]   bFilter     TRUE to add hysteresis and delay
+ * @param[in]   bLatch      TRUE to latch every channel
+ *
+ *****************************************************************************/
+static void BuildTables( BOOL bFilter, BOOL bLatch )
+{
+  int iChan;
+  U8  nFlags;
+
+  // for each channel
+  for ( iChan = 0; iChan < iNumChannels; iChan++ )
+  {
+    // thresholds are ordered around a center
+    pxLoLo[ iChan ] = -1000 - ( rand( ) % 500 );
+    pxLo[ iChan ] = -200 - ( rand( ) % 500 );
+    pxHi[ iChan ] = 200 + ( rand( ) % 500 );
+    pxHiHi[ iChan ] = 1000 + ( rand( ) % 500 );
+    pxHyst[ iChan ] = ( bFilter ) ? CHATTER_HYSTERESIS : 0;
+    pwDelay[ iChan ] = ( bFilter ) ? CHATTER_DELAY : 0;
+
+    // random enables, mostly all on
+    nFlags = ( rand( ) % 4 ) ? 0x0F : ( rand( ) & 0x0F );
+    nFlags |= ( bLatch ) ? ALARM_FLAG_LATCH : 0;
+    pnDefFlags[ iChan ] = nFlags;
+
+    // fill the single definition
+    ptSingleDefs[ iChan ].xLoLoThreshold = pxLoLo[ iChan ];
+    ptSingleDefs[ iChan ].xLoThreshold = pxLo[ iChan ];
+    ptSingleDefs[ iChan ].xHiThreshold = pxHi[ iChan ];
+    ptSingleDefs[ iChan ].xHiHiThreshold = pxHiHi[ iChan ];
+    ptSingleDefs[ iChan ].tEnableFlags.bLLEnable = ( nFlags & ALARM_FLAG_LLENABLE ) ? 1 : 0;
+    ptSingleDefs[ iChan ].tEnableFlags.bLoEnable = ( nFlags & ALARM_FLAG_LOENABLE ) ? 1 : 0;
+    ptSingleDefs[ iChan ].tEnableFlags.bHiEnable = ( nFlags & ALARM_FLAG_HIENABLE ) ? 1 : 0;
+    ptSingleDefs[ iChan ].tEnableFlags.bHHEnable = ( nFlags & ALARM_FLAG_HHENABLE ) ? 1 : 0;
+    pnSingleStatus[ iChan ] = ALARM_STS_NONE;
+  }
+
+  // fill the table
+  tDef.wNumChannels = iNumChannels;
+  tDef.pxLoLoThreshold = pxLoLo;
+  tDef.pxLoThreshold = pxLo;
+  tDef.pxHiThreshold = pxHi;
+  tDef.pxHiHiThreshold = pxHiHi;
+  tDef.pxLoLoHysteresis = pxHyst;
+  tDef.pxLoHysteresis = pxHyst;
+  tDef.pxHiHysteresis = pxHyst;
+  tDef.pxHiHiHysteresis = pxHyst;
+  tDef.pwDelay = pwDelay;
+  tDef.pnFlags = pnDefFlags;
+  AlarmHandler_ResetTable( &tDef, &tState );
+}
+
+/******************************************************************************
+ * @function RandomSamples
+ *
+ * @brief fill the values with random samples
+ *
+ * This function will fill the values with random samples across every band
+ *
+ *****************************************************************************/
+static void RandomSamples( void )
+{
+  int iChan;
+
+  // for each channel
+  for ( iChan = 0; iChan < iNumChannels; iChan++ )
+  {
+    pxValues[ iChan ] = ( rand( ) % 4000 ) - 2000;
+  }
+}
+
+/******************************************************************************
+ * @function TypicalSamples
+ *
+ * @brief fill the values with typical samples
+ *
+ * This function will fill the values with samples in the normal band with
+ * one in a hundred anywhere
+ *
+ *****************************************************************************/
+static void TypicalSamples( void )
+{
+  int iChan;
+
+  // for each channel
+  for ( iChan = 0; iChan < iNumChannels; iChan++ )
+  {
+    pxValues[ iChan ] = (( rand( ) % 100 ) == 0 ) ? ( rand( ) % 4000 ) - 2000 : ( rand( ) % 300 ) - 150;
+  }
+}
+
+/******************************************************************************
+ * @function NoisySamples
+ *
+ * @brief fill the values with a slow ramp plus noise
+ *
+ * This function will fill the values with a triangle that crosses the hi
+ * threshold slowly with noise added, the worst case for chatter
+ *
+ * @param[in]   iSample     sample number
+ *
+ *****************************************************************************/
+static void NoisySamples( int iSample )
+{
+  int iChan, iRamp;
+
+  // for each channel
+  for ( iChan = 0; iChan < iNumChannels; iChan++ )
+  {
+    // triangle from hi - 100 to hi + 100 over the run
+    iRamp = ( iSample + iChan ) % 400;
+    iRamp = ( iRamp < 200 ) ? iRamp : 400 - iRamp;
+    pxValues[ iChan ] = pxHi[ iChan ] - 100 + iRamp + ( rand( ) % ( 2 * NOISE_AMPLITUDE + 1 )) - NOISE_AMPLITUDE;
+  }
+}
+
+/******************************************************************************
+ * @function CheckEquivalence
+ *
+ * @brief check the table against the single channel check
+ *
+ * This function will run random samples through both and compare the status
+ * and changed mask of every channel
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckEquivalence( void )
+{
+  int       iSample, iChan, iErrors, iChanges;
+  ALARMSTS  eStatus;
+  BOOL      bChanged;
+  U16       wNumChanged;
+
+  // build the tables, no filtering
+  BuildTables( FALSE, FALSE );
+  iErrors = 0;
+
+  // for each sample
+  for ( iSample = 0; iSample < CHECK_SAMPLES; iSample++ )
+  {
+    // get the samples/check the table
+    RandomSamples( );
+    wNumChanged = AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+
+    // check each channel
+    iChanges = 0;
+    for ( iChan = 0; iChan < iNumChannels; iChan++ )
+    {
+      eStatus = AlarmHandler_CheckAlarm( pxValues[ iChan ], &ptSingleDefs[ iChan ] );
+      bChanged = ( eStatus != pnSingleStatus[ iChan ] );
+      pnSingleStatus[ iChan ] = eStatus;
+      iChanges += bChanged;
+      if (( eStatus != tState.pnStatus[ iChan ] ) || ( bChanged != (( puChanged[ iChan / 32 ] >> ( iChan % 32 )) & 1 )))
+      {
+        if ( iErrors++ < 10 )
+        {
+          printf( "  mismatch sample %d channel %d: single %d table %d\n", iSample, iChan, eStatus, tState.pnStatus[ iChan ] );
+        }
+      }
+    }
+
+    // check the count
+    if ( wNumChanged != iChanges )
+    {
+      iErrors++;
+    }
+  }
+
+  // report
+  printf( "equivalence: %d samples x %d channels, %d mismatches\n", CHECK_SAMPLES, iNumChannels, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief time both checks
+ *
+ * This function will time the single channel loop, the table check and the
+ * table check with hysteresis and delay over the same samples, interleaved
+ * over several rounds, and report the best round of each
+ *
+ * @param[in]   iPasses     number of passes per round
+ *
+ *****************************************************************************/
+static void RunTiming( int iPasses )
+{
+  int               iRound, iPass, iChan;
+  double            dStart, dSingle, dTable, dFiltered;
+  volatile U32      uSink;
+  ALARMARG*         pxPool;
+  ALARMARG*         pxSave;
+
+  // build the tables with filtering, and a pool of sample sets
+  BuildTables( TRUE, FALSE );
+  pxSave = pxValues;
+  pxPool = Allocate( POOL_SETS * iNumChannels * sizeof( ALARMARG ));
+  for ( iPass = 0; iPass < POOL_SETS; iPass++ )
+  {
+    pxValues = pxPool + iPass * iNumChannels;
+    TypicalSamples( );
+  }
+  uSink = 0;
+  dSingle = dTable = dFiltered = 1e9;
+
+  // for each round
+  for ( iRound = 0; iRound < TIMING_ROUNDS; iRound++ )
+  {
+    // time the single channel loop, tracking changes as the caller must
+    dStart = GetSeconds( );
+    for ( iPass = 0; iPass < iPasses; iPass++ )
+    {
+      pxValues = pxPool + ( iPass % POOL_SETS ) * iNumChannels;
+      memset( puChanged, 0, ALARM_CHANGED_WORDS( iNumChannels ) * sizeof( U32 ));
+      for ( iChan = 0; iChan < iNumChannels; iChan++ )
+      {
+        ALARMSTS eStatus = AlarmHandler_CheckAlarm( pxValues[ iChan ], &ptSingleDefs[ iChan ] );
+        if ( eStatus != pnSingleStatus[ iChan ] )
+        {
+          pnSingleStatus[ iChan ] = eStatus;
+          puChanged[ iChan / 32 ] |= 1UL << ( iChan % 32 );
+        }
+      }
+      uSink += puChanged[ 0 ];
+    }
+    dSingle = MIN( dSingle, GetSeconds( ) - dStart );
+
+    // time the table, no hysteresis or delay
+    tDef.pxLoLoHysteresis = tDef.pxLoHysteresis = tDef.pxHiHysteresis = tDef.pxHiHiHysteresis = NULL;
+    tDef.pwDelay = NULL;
+    AlarmHandler_ResetTable( &tDef, &tState );
+    dStart = GetSeconds( );
+    for ( iPass = 0; iPass < iPasses; iPass++ )
+    {
+      pxValues = pxPool + ( iPass % POOL_SETS ) * iNumChannels;
+      uSink += AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+    }
+    dTable = MIN( dTable, GetSeconds( ) - dStart );
+
+    // time the table with hysteresis and delay
+    tDef.pxLoLoHysteresis = tDef.pxLoHysteresis = tDef.pxHiHysteresis = tDef.pxHiHiHysteresis = pxHyst;
+    tDef.pwDelay = pwDelay;
+    AlarmHandler_ResetTable( &tDef, &tState );
+    dStart = GetSeconds( );
+    for ( iPass = 0; iPass < iPasses; iPass++ )
+    {
+      pxValues = pxPool + ( iPass % POOL_SETS ) * iNumChannels;
+      uSink += AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+    }
+    dFiltered = MIN( dFiltered, GetSeconds( ) - dStart );
+  }
+  free( pxPool );
+  pxValues = pxSave;
+
+  // report
+  printf( "timing: best of %d rounds of %d passes\n", TIMING_ROUNDS, iPasses );
+  printf( "  single channel loop  %8.2f ns/channel\n", dSingle * 1e9 / (( double )iPasses * iNumChannels ));
+  printf( "  table                %8.2f ns/channel\n", dTable * 1e9 / (( double )iPasses * iNumChannels ));
+  printf( "  table filtered       %8.2f ns/channel\n", dFiltered * 1e9 / (( double )iPasses * iNumChannels ));
+}
+
+/******************************************************************************
+ * @function RunChatter
+ *
+ * @brief count status changes on noisy channels
+ *
+ * This function will run a noisy ramp across the hi threshold through the
+ * single check and the filtered table and count the status changes
+ *
+ *****************************************************************************/
+static void RunChatter( void )
+{
+  int       iSample, iChan;
+  long      lSingle, lTable;
+  ALARMSTS  eStatus;
+
+  // build the tables with filtering
+  BuildTables( TRUE, FALSE );
+  lSingle = lTable = 0;
+
+  // for each sample
+  for ( iSample = 0; iSample < CHECK_SAMPLES; iSample++ )
+  {
+    NoisySamples( iSample );
+    lTable += AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+    for ( iChan = 0; iChan < iNumChannels; iChan++ )
+    {
+      eStatus = AlarmHandler_CheckAlarm( pxValues[ iChan ], &ptSingleDefs[ iChan ] );
+      lSingle += ( eStatus != pnSingleStatus[ iChan ] );
+      pnSingleStatus[ iChan ] = eStatus;
+    }
+  }
+
+  // report, each channel crosses the threshold 10 times
+  printf( "chatter: %d samples, +/-%d noise, about %ld real crossings\n", CHECK_SAMPLES, NOISE_AMPLITUDE, ( long )iNumChannels * ( CHECK_SAMPLES / 200 ));
+  printf( "  single channel       %8ld changes\n", lSingle );
+  printf( "  table hyst %d dly %d  %8ld changes\n", CHATTER_HYSTERESIS, CHATTER_DELAY, lTable );
+}
+
+/******************************************************************************
+ * @function CheckLatch
+ *
+ * @brief check a latched alarm
+ *
+ * This function will raise a latched alarm, clear the condition and check it
+ * holds until acknowledged
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckLatch( void )
+{
+  int iErrors = 0;
+
+  // build the tables, latched, no filtering, all enabled on channel 0
+  BuildTables( FALSE, TRUE );
+  pnDefFlags[ 0 ] = ALARM_FLAG_LLENABLE | ALARM_FLAG_LOENABLE | ALARM_FLAG_HIENABLE | ALARM_FLAG_HHENABLE | ALARM_FLAG_LATCH;
+  memset( pxValues, 0, iNumChannels * sizeof( ALARMARG ));
+
+  // raise the hi-hi
+  pxValues[ 0 ] = pxHiHi[ 0 ];
+  AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+  iErrors += ( tState.pnStatus[ 0 ] != ALARM_STS_HIHI ) || !( puChanged[ 0 ] & 1 );
+
+  // drop to hi then normal, must hold
+  pxValues[ 0 ] = pxHi[ 0 ];
+  AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+  pxValues[ 0 ] = 0;
+  AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+  iErrors += ( tState.pnStatus[ 0 ] != ALARM_STS_HIHI ) || ( puChanged[ 0 ] & 1 );
+
+  // acknowledge, must clear on the next check
+  AlarmHandler_Acknowledge( &tState, 0 );
+  AlarmHandler_CheckTable( pxValues, &tDef, &tState, puChanged );
+  iErrors += ( tState.pnStatus[ 0 ] != ALARM_STS_NONE ) || !( puChanged[ 0 ] & 1 );
+
+  // report
+  printf( "latch: %s\n", ( iErrors == 0 ) ? "ok" : "failed" );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function GetSeconds
+ *
+ * @brief get the monotonic time
+ *
+ * This function will return the monotonic time in seconds
+ *
+ * @return      time in seconds
+ *
+ *****************************************************************************/
+static double GetSeconds( void )
+{
+  struct timespec tTime;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return( tTime.tv_sec + ( tTime.tv_nsec * 1e-9 ));
+}
+
+/******************************************************************************
+ * @function Allocate
+ *
+ * @brief allocate a cleared block
+ *
+ * This function will allocate a cleared block or exit
+ *
+ * @param[in]   tSize       size of the block
+ *
+ * @return      pointer to the block
+ *
+ *****************************************************************************/
+static void* Allocate( size_t tSize )
+{
+  void* pvBlock;
+
+  // allocate it
+  if (( pvBlock = calloc( 1, tSize )) == NULL )
+  {
+    fprintf( stderr, "out of memory\n" );
+    exit( 1 );
+  }
+
+  // return it
+  return( pvBlock );
+}
+
+/**@} EOF AlarmHandlerBenchmark.c */
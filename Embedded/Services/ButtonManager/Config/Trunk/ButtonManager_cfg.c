@@ -196,4 +196,23 @@ static BOOL GetKeyStatus( U32 uKeyEnum )
   return( bButtonStatus );
 }
 
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+/******************************************************************************
+ * @function ButtonManager_ReadKeys
+ *
+ * @brief button manager read all keys
+ *
+ * This function reads each input port once and sets the bit for each pressed
+ * key, bit 0 of the first word is the first key enumeration.  The words are
+ * cleared before this is called
+ *
+ * @param[io]   puKeys        pointer to the key words
+ *
+ *****************************************************************************/
+void ButtonManager_ReadKeys( PU32 puKeys )
+{
+  // read the ports and set the bits for the pressed keys
+}
+#endif // BTNMNGR_ENABLE_PORTSCAN
+
 /**@} EOF ButtonManager_cfg.c */
@@ -63,6 +63,9 @@ extern  const CODE BTNMNGRDEF g_atBtnMgrDefs[ ];
 
 // global function prototypes --------------------------------------------------
 extern  void  ButtonManager_LocalInitialize( void );
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+  extern  void  ButtonManager_ReadKeys( PU32 puKeys );
+#endif // BTNMNGR_ENABLE_PORTSCAN
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
   extern  BOOL  ButtonManager_ProcessTask( TASKARG xArg );
 #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
@@ -37,6 +37,12 @@
 // define the button manager argument size override
 #define BTNMNGR_ARGSIZE_OVERRIDE_SELECTION    ( BTNMNGR_ARGSIZE_OVERRIDE_SIZE1 )
 
+/// define the macro to enable reading whole ports and debouncing with vertical counters
+#define BTNMNGR_ENABLE_PORTSCAN               ( OFF )
+
+/// define the number of vertical counter bits, limits the debounce to 2^bits - 1 process counts
+#define BTNMNGR_PORTSCAN_COUNTER_BITS         ( 3 )
+
 /**@} EOF ButtonManager_prm.h */
 
 #endif  // _BUTTONMANAGER_PRM_H
\ No newline at end of file
@@ -36,6 +36,11 @@
 }
 #endif
 
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+  /// define the bit for a key in a key word
+  #define KEY_BIT( bit )                    (( U32 )1 << ( bit ))
+#endif // BTNMNGR_ENABLE_PORTSCAN
+
 // enumerations ---------------------------------------------------------------
 // define the button states
 typedef enum
@@ -68,9 +73,21 @@ typedef struct
 // local parameter declarations -----------------------------------------------
 static  BTNMNGRCFG  tConfig;
 static  BTNCTL      atBtnCtls[ BTNMNGR_ENUM_MAX ];
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+  static  U32       auKeyStates[ BTNMNGR_NUM_KEYWORDS ];
+  static  U32       auHeldKeys[ BTNMNGR_NUM_KEYWORDS ];
+  static  U32       aauCounters[ BTNMNGR_PORTSCAN_COUNTER_BITS ][ BTNMNGR_NUM_KEYWORDS ];
+#endif // BTNMNGR_ENABLE_PORTSCAN
 
 // local function prototypes --------------------------------------------------
 static  void  PostEvent( BTNMNGRENUM eKey, BTNMNGREVENTS eEvent, PBTNMNGRDEF ptDef );
+static  void  ProcessPress( BTNMNGRENUM eBtn, PBTNCTL ptBtnCtl, PBTNMNGRDEF ptBtnDef );
+static  void  ProcessHeld( BTNMNGRENUM eBtn, PBTNCTL ptBtnCtl, PBTNMNGRDEF ptBtnDef );
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+  static  void  ScanKeys( void );
+#else
+  static  void  PollKeys( void );
+#endif // BTNMNGR_ENABLE_PORTSCAN
 
 // constant parameter initializations -----------------------------------------
 
@@ -100,8 +117,14 @@ BOOL ButtonManager_Initialize( void )
   tConfig.wLongHoldTimeMsecs /= BTNMANAGER_PROCESS_RATE_MSECS;
   tConfig.wStuckTimeMsecs /= BTNMANAGER_PROCESS_RATE_MSECS;
   
-  // clear the control structure
-  memset( atBtnCtls, 0, sizeof( atBtnCtls ));
+  #if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+    // the debounce count must fit the vertical counters
+    tConfig.wDebounceTimeMsecs = MAX( tConfig.wDebounceTimeMsecs, 1 );
+    tConfig.wDebounceTimeMsecs = MIN( tConfig.wDebounceTimeMsecs, ( 1 << BTNMNGR_PORTSCAN_COUNTER_BITS ) - 1 );
+  #endif // BTNMNGR_ENABLE_PORTSCAN
+
+  // clear the control structures
+  ButtonManager_ResetAllStates( );
   
   // return the status
   return( bStatus );
@@ -119,6 +142,13 @@ void ButtonManager_ResetAllStates( void )
 {
   // clear the control structure
   memset( atBtnCtls, 0, sizeof( atBtnCtls ));
+
+  #if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+    // clear the debounced states/counters
+    memset( auKeyStates, 0, sizeof( auKeyStates ));
+    memset( auHeldKeys, 0, sizeof( auHeldKeys ));
+    memset( aauCounters, 0, sizeof( aauCounters ));
+  #endif // BTNMNGR_ENABLE_PORTSCAN
 }
 
 /******************************************************************************
@@ -152,6 +182,135 @@ void ButtonManager_ForceButton( BTNMNGRENUM eBtnEnum, BTNMNGREVENTS eBtnEvent )
  *
  *****************************************************************************/
 void ButtonManager_Process( void )
+{
+  #if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+    // scan the ports
+    ScanKeys( );
+  #else
+    // poll each key
+    PollKeys( );
+  #endif // BTNMNGR_ENABLE_PORTSCAN
+}
+
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+/******************************************************************************
+ * @function ScanKeys
+ *
+ * @brief scan all keys
+ *
+ * This function reads every key at once and debounces 32 keys per word with
+ * vertical counters, each bit plane of the counters holds one bit of the count
+ * for every key in the word.  A key that differs from its debounced state
+ * counts up, and changes state when the count reaches the debounce time, a
+ * key that matches resets its count.  Only keys that changed or are being held
+ * are processed further
+ *
+ *****************************************************************************/
+static void ScanKeys( void )
+{
+  U32           auSample[ BTNMNGR_NUM_KEYWORDS ];
+  U32           uDelta, uCarry, uPlane, uChanged, uBits;
+  U8            nWord, nPlane, nBit;
+  BTNMNGRENUM   eBtn;
+  BTNCTL*       ptBtnCtl;
+  BTNMNGRDEF    tBtnDef;
+
+  // read the keys
+  memset( auSample, 0, sizeof( auSample ));
+  ButtonManager_ReadKeys( auSample );
+
+  // for each word
+  for ( nWord = 0; nWord < BTNMNGR_NUM_KEYWORDS; nWord++ )
+  {
+    // increment the counts of the keys that differ, reset the others
+    uDelta = auSample[ nWord ] ^ auKeyStates[ nWord ];
+    uCarry = uDelta;
+    uChanged = uDelta;
+    for ( nPlane = 0; nPlane < BTNMNGR_PORTSCAN_COUNTER_BITS; nPlane++ )
+    {
+      // add the carry to this plane
+      uPlane = aauCounters[ nPlane ][ nWord ];
+      aauCounters[ nPlane ][ nWord ] = ( uPlane ^ uCarry ) & uDelta;
+      uCarry &= uPlane;
+
+      // keep the keys whose count matches the debounce time in this bit
+      uPlane = aauCounters[ nPlane ][ nWord ];
+      uChanged &= ( tConfig.wDebounceTimeMsecs & BIT( nPlane )) ? uPlane : ~uPlane;
+    }
+
+    // change the state of the keys that reached the count/reset their counts
+    if ( uChanged != 0 )
+    {
+      auKeyStates[ nWord ] ^= uChanged;
+      for ( nPlane = 0; nPlane < BTNMNGR_PORTSCAN_COUNTER_BITS; nPlane++ )
+      {
+        aauCounters[ nPlane ][ nWord ] &= ~uChanged;
+      }
+    }
+
+    // held keys are the ones that were held or were just pressed
+    auHeldKeys[ nWord ] = ( auHeldKeys[ nWord ] | uChanged ) & auKeyStates[ nWord ];
+
+    // process the changed and held keys
+    uBits = uChanged | auHeldKeys[ nWord ];
+    for ( nBit = 0; uBits != 0; nBit++, uBits >>= 1 )
+    {
+      // skip idle keys
+      if (( uBits & 1 ) == 0 )
+      {
+        continue;
+      }
+
+      // get the key/stop past the last key
+      eBtn = ( nWord * 32 ) + nBit;
+      if ( eBtn >= BTNMNGR_ENUM_MAX )
+      {
+        break;
+      }
+
+      // get the control/def
+      ptBtnCtl = &atBtnCtls[ eBtn ];
+      MEMCPY_P( &tBtnDef, &g_atBtnMgrDefs[ eBtn ], BTNMNGRDEF_SIZE );
+
+      // check for a change
+      if ( uChanged & KEY_BIT( nBit ))
+      {
+        if ( auKeyStates[ nWord ] & KEY_BIT( nBit ))
+        {
+          // process the press
+          ProcessPress( eBtn, ptBtnCtl, &tBtnDef );
+          ptBtnCtl->wHoldCounts = 0;
+        }
+        else
+        {
+          // back to released/generate an event/reset the hold counts
+          ptBtnCtl->eState = BTN_STATE_RELEASED;
+          PostEvent( eBtn, BTNMNGR_EVENT_RELEASED, &tBtnDef );
+          ptBtnCtl->wHoldCounts = 0;
+        }
+      }
+      else
+      {
+        // process the hold, a stuck key is no longer timed
+        ProcessHeld( eBtn, ptBtnCtl, &tBtnDef );
+        if ( ptBtnCtl->eState == BTN_STATE_STUCK )
+        {
+          auHeldKeys[ nWord ] &= ~KEY_BIT( nBit );
+        }
+      }
+    }
+  }
+}
+#else
+/******************************************************************************
+ * @function PollKeys
+ *
+ * @brief poll each key
+ *
+ * This function gets the status of each key and runs its debounce state
+ *
+ *****************************************************************************/
+static void PollKeys( void )
 {
   BTNMNGRENUM   eBtn;
   BTNCTL*       ptBtnCtl;
@@ -198,27 +357,8 @@ void ButtonManager_Process( void )
         // check to see if key is still pressed
         if ( bKeyState )
         {
-          // set the delay to repeat delay/set state to pressed/generate an event
-          ptBtnCtl->wDelayCounts = tConfig.wRepeatDelayMsecs;
-          ptBtnCtl->eState = BTN_STATE_PRESSED;
-          
-          // clear the hold events
-          ptBtnCtl->tHoldDets.bShort = OFF;
-          ptBtnCtl->tHoldDets.bMedium = OFF;
-          ptBtnCtl->tHoldDets.bLong = OFF;
-          
-          // check for tobble
-          if ( tBtnDef.tEventFlags.bToggleEnable )
-          {
-            // toggle the button off/on state/post the toggle event
-            ptBtnCtl->bOffOn ^= TRUE;
-            PostEvent( eBtn, ( ptBtnCtl->bOffOn ) ? BTNMNGR_EVENT_BTNON : BTNMNGR_EVENT_BTNOFF, &tBtnDef );
-          }
-          else
-          {
-            // post a pressed event
-            PostEvent( eBtn, BTNMNGR_EVENT_PRESSED, &tBtnDef );
-          }
+          // process the press
+          ProcessPress( eBtn, ptBtnCtl, &tBtnDef );
         }
         else
         {
@@ -232,55 +372,8 @@ void ButtonManager_Process( void )
         // check to see if key is still pressed
         if ( bKeyState )
         {
-          if ( --ptBtnCtl->wDelayCounts == 0 )
-          {
-            // set delay time for repeat delay/goto press
-            ptBtnCtl->wDelayCounts = tConfig.wRepeatRateMsecs;
-            PostEvent( eBtn, BTNMNGR_EVENT_REPEAT, &tBtnDef );
-          }
-          
-          // increment the hold time
-          ptBtnCtl->wHoldCounts++;
-
-          // check for short hold
-          if (( ptBtnCtl->wHoldCounts >= tConfig.wShortHoldTimeMsecs ) & ( !ptBtnCtl->tHoldDets.bShort ))
-          {
-            // mark it
-            ptBtnCtl->tHoldDets.bShort = ON;
-            
-            // generate an event
-            PostEvent( eBtn, BTNMNGR_EVENT_SHORTHOLD, &tBtnDef );
-          }
-          
-          // check for medimum hold
-          if (( ptBtnCtl->wHoldCounts >= tConfig.wMediumHoldTimeMsecs ) & ( !ptBtnCtl->tHoldDets.bMedium ))
-          {
-            // mark it
-            ptBtnCtl->tHoldDets.bMedium = ON;
-            
-            // generate an event
-            PostEvent( eBtn, BTNMNGR_EVENT_MEDIUMHOLD, &tBtnDef );
-          }
-          
-          // check for long hold
-          if (( ptBtnCtl->wHoldCounts >= tConfig.wLongHoldTimeMsecs ) && ( !ptBtnCtl->tHoldDets.bLong ))
-          {
-            // mark it
-            ptBtnCtl->tHoldDets.bLong = ON;
-            
-            // generate an event
-            PostEvent( eBtn, BTNMNGR_EVENT_LONGHOLD, &tBtnDef );
-          }
-          
-          // check for stuck key
-          if ( ptBtnCtl->wHoldCounts >= tConfig.wStuckTimeMsecs )
-          {
-            // generate an event
-            PostEvent( eBtn, BTNMNGR_EVENT_STUCK, &tBtnDef );
-            
-            // goto stuck key state
-            ptBtnCtl->eState = BTN_STATE_STUCK;
-          }
+          // process the hold
+          ProcessHeld( eBtn, ptBtnCtl, &tBtnDef );
         }
         else
         {
@@ -313,6 +406,111 @@ void ButtonManager_Process( void )
     }
   }
 }
+#endif // BTNMNGR_ENABLE_PORTSCAN
+
+/******************************************************************************
+ * @function ProcessPress
+ *
+ * @brief process a debounced press
+ *
+ * This function will set the repeat delay, clear the hold detections and
+ * post the press or toggle event
+ *
+ * @param[in]   eBtn        button enumerator
+ * @param[in]   ptBtnCtl    pointer to the button control
+ * @param[in]   ptBtnDef    pointer to the button definition
+ *  
+ *****************************************************************************/
+static void ProcessPress( BTNMNGRENUM eBtn, PBTNCTL ptBtnCtl, PBTNMNGRDEF ptBtnDef )
+{
+  // set the delay to repeat delay/set state to pressed/generate an event
+  ptBtnCtl->wDelayCounts = tConfig.wRepeatDelayMsecs;
+  ptBtnCtl->eState = BTN_STATE_PRESSED;
+  
+  // clear the hold events
+  ptBtnCtl->tHoldDets.bShort = OFF;
+  ptBtnCtl->tHoldDets.bMedium = OFF;
+  ptBtnCtl->tHoldDets.bLong = OFF;
+  
+  // check for tobble
+  if ( ptBtnDef->tEventFlags.bToggleEnable )
+  {
+    // toggle the button off/on state/post the toggle event
+    ptBtnCtl->bOffOn ^= TRUE;
+    PostEvent( eBtn, ( ptBtnCtl->bOffOn ) ? BTNMNGR_EVENT_BTNON : BTNMNGR_EVENT_BTNOFF, ptBtnDef );
+  }
+  else
+  {
+    // post a pressed event
+    PostEvent( eBtn, BTNMNGR_EVENT_PRESSED, ptBtnDef );
+  }
+}
+
+/******************************************************************************
+ * @function ProcessHeld
+ *
+ * @brief process a held key
+ *
+ * This function will generate the repeat, hold and stuck events for a key
+ * that is still pressed
+ *
+ * @param[in]   eBtn        button enumerator
+ * @param[in]   ptBtnCtl    pointer to the button control
+ * @param[in]   ptBtnDef    pointer to the button definition
+ *  
+ *****************************************************************************/
+static void ProcessHeld( BTNMNGRENUM eBtn, PBTNCTL ptBtnCtl, PBTNMNGRDEF ptBtnDef )
+{
+  if ( --ptBtnCtl->wDelayCounts == 0 )
+  {
+    // set delay time for repeat delay/goto press
+    ptBtnCtl->wDelayCounts = tConfig.wRepeatRateMsecs;
+    PostEvent( eBtn, BTNMNGR_EVENT_REPEAT, ptBtnDef );
+  }
+  
+  // increment the hold time
+  ptBtnCtl->wHoldCounts++;
+
+  // check for short hold
+  if (( ptBtnCtl->wHoldCounts >= tConfig.wShortHoldTimeMsecs ) & ( !ptBtnCtl->tHoldDets.bShort ))
+  {
+    // mark it
+    ptBtnCtl->tHoldDets.bShort = ON;
+    
+    // generate an event
+    PostEvent( eBtn, BTNMNGR_EVENT_SHORTHOLD, ptBtnDef );
+  }
+  
+  // check for medimum hold
+  if (( ptBtnCtl->wHoldCounts >= tConfig.wMediumHoldTimeMsecs ) & ( !ptBtnCtl->tHoldDets.bMedium ))
+  {
+    // mark it
+    ptBtnCtl->tHoldDets.bMedium = ON;
+    
+    // generate an event
+    PostEvent( eBtn, BTNMNGR_EVENT_MEDIUMHOLD, ptBtnDef );
+  }
+  
+  // check for long hold
+  if (( ptBtnCtl->wHoldCounts >= tConfig.wLongHoldTimeMsecs ) && ( !ptBtnCtl->tHoldDets.bLong ))
+  {
+    // mark it
+    ptBtnCtl->tHoldDets.bLong = ON;
+    
+    // generate an event
+    PostEvent( eBtn, BTNMNGR_EVENT_LONGHOLD, ptBtnDef );
+  }
+  
+  // check for stuck key
+  if ( ptBtnCtl->wHoldCounts >= tConfig.wStuckTimeMsecs )
+  {
+    // generate an event
+    PostEvent( eBtn, BTNMNGR_EVENT_STUCK, ptBtnDef );
+    
+    // goto stuck key state
+    ptBtnCtl->eState = BTN_STATE_STUCK;
+  }
+}
 
 /******************************************************************************
  * @function PostEvent
@@ -45,6 +45,11 @@
   #define BTNMNGR_MAKE_EVENT( event, key )  ( MAKEU16( event, key ))
 #endif
 
+#if ( BTNMNGR_ENABLE_PORTSCAN == ON )
+  /// define the number of key words
+  #define BTNMNGR_NUM_KEYWORDS              (( BTNMNGR_ENUM_MAX + 31 ) / 32 )
+#endif // BTNMNGR_ENABLE_PORTSCAN
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the events
 typedef enum _BTNMNGREVENTS
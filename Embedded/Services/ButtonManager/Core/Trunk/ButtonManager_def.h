@@ -53,7 +53,7 @@
 #define BTNMNGR_DEFCB_ENTRY( keyenum, rel_enb, prs_enb, rep_enb, shh_enb, mdh_enb, lng_enb, tgl_enb, getstatus, callback ) \
   {\
     .eRptMethod = BTNMNGR_RPTMETHOD_CB, \
-    .nKeyEnum = keyenum, \
+    .uKeyEnum = keyenum, \
     .tEventFlags = \
     { \
       .bReleaseEnable = rel_enb, \
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * @file ButtonManager_cfg.h
+ *
+ * @brief button manager harness configuration declarations
+ *
+ * This file declares the configuration for the button manager test harness,
+ * a 48 key panel
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup ButtonManager
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _BUTTONMANAGR_CFG_H
+#define _BUTTONMANAGR_CFG_H
+
+// local includes -------------------------------------------------------------
+#include "ButtonManager/ButtonManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of keys
+#define HARNESS_NUM_KEYS                      ( 48 )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the buttons
+typedef enum BTNMNGRENUM
+{
+  // the keys are numbered, the last one toggles
+  BTNMNGR_ENUM_TOGGLE = HARNESS_NUM_KEYS - 1,
+
+  // do not remove the below entries
+  BTNMNGR_ENUM_MAX,
+  BTNMNGR_ENUM_ILLEGAL
+} BTNMNGRENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE BTNMNGRCFG g_tBtnMgrCfg;
+extern  const CODE BTNMNGRDEF g_atBtnMgrDefs[ ];
+
+// global function prototypes --------------------------------------------------
+extern  void  ButtonManager_LocalInitialize( void );
+extern  void  ButtonManager_ReadKeys( PU32 puKeys );
+extern  void  ButtonManager_PostEvent( PBTNMNGRDEF ptDef, U8 nEvent, U8 nKey );
+
+/**@} EOF ButtonManager_cfg.h */
+
+#endif  // _BUTTONMANAGR_CFG_H
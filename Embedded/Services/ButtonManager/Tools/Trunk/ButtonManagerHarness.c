@@ -0,0 +1,630 @@
+/******************************************************************************
+ * @file ButtonManagerHarness.c
+ *
+ * @brief button manager test harness
+ *
+ * This file provides a host tool that runs the button manager port scan mode
+ * against scripted key patterns.  It replaces ButtonManager_cfg.c with a 48
+ * key panel read from a pattern instead of the ports.  Each script drives a
+ * key with a bounce pattern and checks the number of press and release
+ * events, the hold script checks the repeat, hold and stuck events, and the
+ * random script bounces every key at once and checks each press and release
+ * lands on the same tick as a simple per key counter.  It then times the
+ * process call with every key idle and every key held.  It exits non zero on
+ * any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o ButtonManagerHarness
+ *             ButtonManagerHarness.c ../../Core/Trunk/ButtonManager.c
+ * usage:      ButtonManagerHarness [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup ButtonManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "ButtonManager/ButtonManager.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the configuration, in msecs
+#define DEBOUNCE_MSECS                              ( 30 )
+#define REPEAT_DELAY_MSECS                          ( 500 )
+#define REPEAT_RATE_MSECS                           ( 100 )
+#define SHORT_HOLD_MSECS                            ( 1000 )
+#define MEDIUM_HOLD_MSECS                           ( 2000 )
+#define LONG_HOLD_MSECS                             ( 3000 )
+#define STUCK_MSECS                                 ( 7000 )
+
+/// define the same times in ticks
+#define DEBOUNCE_TICKS                              ( DEBOUNCE_MSECS / BTNMANAGER_PROCESS_RATE_MSECS )
+#define REPEAT_DELAY_TICKS                          ( REPEAT_DELAY_MSECS / BTNMANAGER_PROCESS_RATE_MSECS )
+#define REPEAT_RATE_TICKS                           ( REPEAT_RATE_MSECS / BTNMANAGER_PROCESS_RATE_MSECS )
+#define STUCK_TICKS                                 ( STUCK_MSECS / BTNMANAGER_PROCESS_RATE_MSECS )
+
+/// define the size of the event log
+#define MAX_EVENTS                                  ( 100000 )
+
+/// define the random run length and timing passes
+#define RANDOM_TICKS                                ( 20000 )
+#define TIMING_TICKS                                ( 1000000 )
+
+/// define the helper to fill eight keys
+#define KEYS8( first ) \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 0, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 1, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 2, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 3, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 4, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 5, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 6, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ), \
+  BTNMNGR_DEFCB_ENTRY(( first ) + 7, 1, 1, 1, 1, 1, 1, 0, NULL, Callback )
+
+// structures -----------------------------------------------------------------
+/// define the logged event
+typedef struct _LOGEVENT
+{
+  long  lTick;
+  U8    nKey;
+  U8    nEvent;
+} LOGEVENT;
+
+/// define a bounce script
+typedef struct _SCRIPT
+{
+  const char* pszName;          ///< name
+  const char* pszPattern;       ///< pattern, one character per tick
+  int         iPresses;         ///< expected presses
+  int         iReleases;        ///< expected releases
+} SCRIPT;
+
+// local parameter declarations -----------------------------------------------
+static  U32       auPins[ BTNMNGR_NUM_KEYWORDS ];
+static  LOGEVENT  atLog[ MAX_EVENTS ];
+static  int       iNumLogged;
+static  long      lTick;
+static  BOOL      bLogEnabled = TRUE;
+
+// local function prototypes --------------------------------------------------
+static  void  Callback( U8 nKey, U8 nEvent );
+static  void  Restart( void );
+static  void  SetKey( int iKey, BOOL bPressed );
+static  void  Tick( void );
+static  int   CountEvents( int iKey, BTNMNGREVENTS eEvent );
+static  int   RunScripts( void );
+static  int   RunHold( void );
+static  int   RunToggle( void );
+static  int   RunRandom( void );
+static  void  RunTiming( void );
+
+// constant parameter initializations -----------------------------------------
+/// fill out the config
+const CODE BTNMNGRCFG g_tBtnMgrCfg = 
+{
+  BTNMNGR_CFG_ENTRY( DEBOUNCE_MSECS, REPEAT_DELAY_MSECS, REPEAT_RATE_MSECS, SHORT_HOLD_MSECS, MEDIUM_HOLD_MSECS, LONG_HOLD_MSECS, STUCK_MSECS )
+};
+
+/// fill out the button defs, the last key toggles
+const CODE BTNMNGRDEF g_atBtnMgrDefs[ BTNMNGR_ENUM_MAX ]  =
+{
+  KEYS8( 0 ), KEYS8( 8 ), KEYS8( 16 ), KEYS8( 24 ), KEYS8( 32 ),
+  BTNMNGR_DEFCB_ENTRY( 40, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 41, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 42, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 43, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 44, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 45, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 46, 1, 1, 1, 1, 1, 1, 0, NULL, Callback ),
+  BTNMNGR_DEFCB_ENTRY( 47, 1, 1, 1, 1, 1, 1, 1, NULL, Callback ),
+};
+
+/// define the bounce scripts, 1 is pressed
+static  const SCRIPT atScripts[ ] =
+{
+  { "clean",           "0001111111111111111111000000000",          1, 1 },
+  { "bouncy press",    "0101101101111111111111111000000000",       1, 1 },
+  { "glitches",        "00100001100000110110011000000",            0, 0 },
+  { "bouncy release",  "1111111111111111111010110100101000000000", 1, 1 },
+  { "chatter held",    "11111111101111110111110011111111000000",   1, 1 },
+  { "double tap",      "0111111000000111111000000",                2, 2 },
+  { "too fast taps",   "0110110110110110110000000",                0, 0 },
+};
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int iErrors;
+
+  // seed the random patterns
+  srand(( iArgc > 1 ) ? atoi( ppszArgv[ 1 ] ) : 1 );
+
+  // initialize/run the checks
+  ButtonManager_Initialize( );
+  printf( "keys %d, tick %d msecs, debounce %d ticks\n", BTNMNGR_ENUM_MAX, BTNMANAGER_PROCESS_RATE_MSECS, DEBOUNCE_TICKS );
+  iErrors = RunScripts( );
+  iErrors += RunHold( );
+  iErrors += RunToggle( );
+  iErrors += RunRandom( );
+  RunTiming( );
+
+  // report
+  printf( "%s\n", ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function ButtonManager_ReadKeys
+ *
+ * @brief read all keys
+ *
+ * This function returns the simulated pins
+ *
+ * @param[io]   puKeys        pointer to the key words
+ *
+ *****************************************************************************/
+void ButtonManager_ReadKeys( PU32 puKeys )
+{
+  // copy the pins
+  memcpy( puKeys, auPins, sizeof( auPins ));
+}
+
+/******************************************************************************
+ * @function ButtonManager_PostEvent
+ *
+ * @brief post event
+ *
+ * This function is not used, all keys use the callback
+ *
+ * @param[in]   ptDef         pointer to the definition
+ * @param[in]   nEvent        event
+ * @param[in]   nKey          key
+ *
+ *****************************************************************************/
+void ButtonManager_PostEvent( PBTNMNGRDEF ptDef, U8 nEvent, U8 nKey )
+{
+  // not used
+  ( void )ptDef;
+  ( void )nEvent;
+  ( void )nKey;
+}
+
+/******************************************************************************
+ * @function Callback
+ *
+ * @brief key callback
+ *
+ * This function will log the event
+ *
+ * @param[in]   nKey          key
+ * @param[in]   nEvent        event
+ *
+ *****************************************************************************/
+static void Callback( U8 nKey, U8 nEvent )
+{
+  // log it
+  if (( bLogEnabled ) && ( iNumLogged < MAX_EVENTS ))
+  {
+    atLog[ iNumLogged ].lTick = lTick;
+    atLog[ iNumLogged ].nKey = nKey;
+    atLog[ iNumLogged ].nEvent = nEvent;
+    iNumLogged++;
+  }
+}
+
+/******************************************************************************
+ * @function Restart
+ *
+ * @brief restart a check
+ *
+ * This function will release every key, reset the manager and the log
+ *
+ *****************************************************************************/
+static void Restart( void )
+{
+  memset( auPins, 0, sizeof( auPins ));
+  ButtonManager_ResetAllStates( );
+  iNumLogged = 0;
+  lTick = 0;
+}
+
+/******************************************************************************
+ * @function SetKey
+ *
+ * @brief set a key pin
+ *
+ * This function will set the pin for a key
+ *
+ * @param[in]   iKey          key
+ * @param[in]   bPressed      TRUE for pressed
+ *
+ *****************************************************************************/
+static void SetKey( int iKey, BOOL bPressed )
+{
+  if ( bPressed )
+  {
+    auPins[ iKey / 32 ] |= ( U32 )1 << ( iKey % 32 );
+  }
+  else
+  {
+    auPins[ iKey / 32 ] &= ~(( U32 )1 << ( iKey % 32 ));
+  }
+}
+
+/******************************************************************************
+ * @function Tick
+ *
+ * @brief run one tick
+ *
+ * This function will run the process and advance the tick
+ *
+ *****************************************************************************/
+static void Tick( void )
+{
+  ButtonManager_Process( );
+  lTick++;
+}
+
+/******************************************************************************
+ * @function CountEvents
+ *
+ * @brief count logged events
+ *
+ * This function will count the logged events for a key
+ *
+ * @param[in]   iKey          key
+ * @param[in]   eEvent        event
+ *
+ * @return      number of events
+ *
+ *****************************************************************************/
+static int CountEvents( int iKey, BTNMNGREVENTS eEvent )
+{
+  int iIndex, iCount = 0;
+
+  // count them
+  for ( iIndex = 0; iIndex < iNumLogged; iIndex++ )
+  {
+    iCount += (( atLog[ iIndex ].nKey == iKey ) && ( atLog[ iIndex ].nEvent == eEvent ));
+  }
+
+  // return the count
+  return( iCount );
+}
+
+/******************************************************************************
+ * @function RunScripts
+ *
+ * @brief run the bounce scripts
+ *
+ * This function will run each script on a key and check the press/release
+ * counts, and that no key other than the scripted one reported anything
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunScripts( void )
+{
+  int         iScript, iKey, iPresses, iReleases, iErrors = 0;
+  const char* pszPattern;
+
+  // for each script
+  printf( "scripts:\n" );
+  for ( iScript = 0; iScript < ( int )( sizeof( atScripts ) / sizeof( SCRIPT )); iScript++ )
+  {
+    // run it on a different key each time, across the word boundary
+    iKey = 29 + iScript;
+    Restart( );
+    for ( pszPattern = atScripts[ iScript ].pszPattern; *pszPattern != '\0'; pszPattern++ )
+    {
+      SetKey( iKey, ( *pszPattern == '1' ));
+      Tick( );
+    }
+
+    // check it
+    iPresses = CountEvents( iKey, BTNMNGR_EVENT_PRESSED );
+    iReleases = CountEvents( iKey, BTNMNGR_EVENT_RELEASED );
+    if (( iPresses != atScripts[ iScript ].iPresses ) || ( iReleases != atScripts[ iScript ].iReleases ) || ( iNumLogged != iPresses + iReleases ))
+    {
+      iErrors++;
+    }
+    printf( "  %-16s key %2d  %d press %d release  %s\n", atScripts[ iScript ].pszName, iKey, iPresses, iReleases,
+            (( iPresses == atScripts[ iScript ].iPresses ) && ( iReleases == atScripts[ iScript ].iReleases )) ? "ok" : "FAILED" );
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunHold
+ *
+ * @brief run the hold checks
+ *
+ * This function will hold a key through the hold times and then until it is
+ * stuck, and check the repeat, hold and stuck events
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunHold( void )
+{
+  int   iHeld, iTick, iRepeats, iErrors = 0;
+
+  // hold a key for 4 seconds, the press lands on the last debounce tick
+  Restart( );
+  iHeld = 4000 / BTNMANAGER_PROCESS_RATE_MSECS;
+  SetKey( 5, TRUE );
+  for ( iTick = 0; iTick < ( DEBOUNCE_TICKS + iHeld ); iTick++ )
+  {
+    Tick( );
+  }
+  SetKey( 5, FALSE );
+  for ( iTick = 0; iTick < 10; iTick++ )
+  {
+    Tick( );
+  }
+
+  // the held ticks include the ones before the release is debounced
+  iHeld += DEBOUNCE_TICKS - 1;
+  iRepeats = 1 + (( iHeld - REPEAT_DELAY_TICKS ) / REPEAT_RATE_TICKS );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_PRESSED ) != 1 );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_REPEAT ) != iRepeats );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_SHORTHOLD ) != 1 );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_MEDIUMHOLD ) != 1 );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_LONGHOLD ) != 1 );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_STUCK ) != 0 );
+  iErrors += ( CountEvents( 5, BTNMNGR_EVENT_RELEASED ) != 1 );
+  printf( "hold: %d repeats expected %d, short/medium/long %d/%d/%d\n", CountEvents( 5, BTNMNGR_EVENT_REPEAT ), iRepeats,
+          CountEvents( 5, BTNMNGR_EVENT_SHORTHOLD ), CountEvents( 5, BTNMNGR_EVENT_MEDIUMHOLD ), CountEvents( 5, BTNMNGR_EVENT_LONGHOLD ));
+
+  // hold a key until it is stuck, it must stop repeating and still release, there is
+  // no enable for the stuck event so it is never reported
+  Restart( );
+  SetKey( 40, TRUE );
+  for ( iTick = 0; iTick < ( DEBOUNCE_TICKS + STUCK_TICKS + 200 ); iTick++ )
+  {
+    Tick( );
+  }
+  SetKey( 40, FALSE );
+  for ( iTick = 0; iTick < 10; iTick++ )
+  {
+    Tick( );
+  }
+  iRepeats = 1 + (( STUCK_TICKS - REPEAT_DELAY_TICKS ) / REPEAT_RATE_TICKS );
+  iErrors += ( CountEvents( 40, BTNMNGR_EVENT_STUCK ) != 0 );
+  iErrors += ( CountEvents( 40, BTNMNGR_EVENT_REPEAT ) != iRepeats );
+  iErrors += ( CountEvents( 40, BTNMNGR_EVENT_RELEASED ) != 1 );
+  printf( "stuck: %d repeats expected %d, %d release\n", CountEvents( 40, BTNMNGR_EVENT_REPEAT ), iRepeats, CountEvents( 40, BTNMNGR_EVENT_RELEASED ));
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunToggle
+ *
+ * @brief run the toggle check
+ *
+ * This function will press the toggle key twice with bounce
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunToggle( void )
+{
+  const char* pszPattern = "0110111111100100000001011111111101000000";
+  int         iErrors = 0;
+
+  // run the pattern
+  Restart( );
+  for ( ; *pszPattern != '\0'; pszPattern++ )
+  {
+    SetKey( BTNMNGR_ENUM_TOGGLE, ( *pszPattern == '1' ));
+    Tick( );
+  }
+
+  // must have seen on then off
+  iErrors += ( iNumLogged != 4 );
+  iErrors += ( atLog[ 0 ].nEvent != BTNMNGR_EVENT_BTNON );
+  iErrors += ( atLog[ 2 ].nEvent != BTNMNGR_EVENT_BTNOFF );
+  printf( "toggle: %s\n", ( iErrors == 0 ) ? "on/off ok" : "FAILED" );
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunRandom
+ *
+ * @brief run random bounce on every key
+ *
+ * This function will drive every key with presses of random length that
+ * bounce on both edges and check each press and release against a simple per
+ * key counter that changes state after the debounce count of samples
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunRandom( void )
+{
+  int   iKey, iTick, iIndex, iErrors = 0, iChecked = 0;
+  BOOL  abLevel[ BTNMNGR_ENUM_MAX ];
+  BOOL  abState[ BTNMNGR_ENUM_MAX ];
+  int   aiCount[ BTNMNGR_ENUM_MAX ];
+  int   aiRun[ BTNMNGR_ENUM_MAX ];
+  int   aiBounce[ BTNMNGR_ENUM_MAX ];
+  int   aiNextLog[ BTNMNGR_ENUM_MAX ];
+  BOOL  bPressed;
+
+  // start all released
+  Restart( );
+  memset( abLevel, 0, sizeof( abLevel ));
+  memset( abState, 0, sizeof( abState ));
+  memset( aiCount, 0, sizeof( aiCount ));
+  memset( aiBounce, 0, sizeof( aiBounce ));
+  memset( aiNextLog, 0, sizeof( aiNextLog ));
+  for ( iKey = 0; iKey < BTNMNGR_ENUM_MAX; iKey++ )
+  {
+    aiRun[ iKey ] = rand( ) % 50;
+  }
+
+  // for each tick
+  for ( iTick = 0; iTick < RANDOM_TICKS; iTick++ )
+  {
+    // move each key
+    for ( iKey = 0; iKey < BTNMNGR_ENUM_MAX; iKey++ )
+    {
+      if ( aiBounce[ iKey ] > 0 )
+      {
+        // bouncing, random level
+        aiBounce[ iKey ]--;
+        SetKey( iKey, rand( ) & 1 );
+      }
+      else if ( --aiRun[ iKey ] <= 0 )
+      {
+        // edge, bounce for a few ticks then settle at the new level, runs stay short of stuck
+        abLevel[ iKey ] ^= TRUE;
+        aiBounce[ iKey ] = rand( ) % 6;
+        aiRun[ iKey ] = 1 + ( rand( ) % ( abLevel[ iKey ] ? 300 : 60 ));
+        SetKey( iKey, abLevel[ iKey ] );
+      }
+      else
+      {
+        // settled
+        SetKey( iKey, abLevel[ iKey ] );
+      }
+    }
+
+    // run the tick
+    Tick( );
+
+    // run the reference and check its changes against the log
+    for ( iKey = 0; iKey < BTNMNGR_ENUM_MAX; iKey++ )
+    {
+      bPressed = ( auPins[ iKey / 32 ] >> ( iKey % 32 )) & 1;
+      aiCount[ iKey ] = ( bPressed != abState[ iKey ] ) ? aiCount[ iKey ] + 1 : 0;
+      if ( aiCount[ iKey ] == DEBOUNCE_TICKS )
+      {
+        // the reference changed, find the next press/release for this key
+        abState[ iKey ] = bPressed;
+        aiCount[ iKey ] = 0;
+        for ( iIndex = aiNextLog[ iKey ]; iIndex < iNumLogged; iIndex++ )
+        {
+          if (( atLog[ iIndex ].nKey == iKey ) && (( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_PRESSED ) ||
+              ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_RELEASED ) || ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_BTNON ) ||
+              ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_BTNOFF )))
+          {
+            break;
+          }
+        }
+
+        // check it
+        if (( iIndex == iNumLogged ) || ( atLog[ iIndex ].lTick != iTick ) ||
+            ((( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_RELEASED ) ? FALSE : TRUE ) != bPressed ))
+        {
+          if ( iErrors++ < 10 )
+          {
+            printf( "  key %d tick %d: reference %s not matched\n", iKey, iTick, bPressed ? "press" : "release" );
+          }
+        }
+        aiNextLog[ iKey ] = iIndex + 1;
+        iChecked++;
+      }
+    }
+  }
+
+  // every press/release must have been checked
+  for ( iIndex = 0; iIndex < iNumLogged; iIndex++ )
+  {
+    if (( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_PRESSED ) || ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_RELEASED ) ||
+        ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_BTNON ) || ( atLog[ iIndex ].nEvent == BTNMNGR_EVENT_BTNOFF ))
+    {
+      iChecked--;
+    }
+  }
+  iErrors += ( iChecked != 0 );
+
+  // report
+  printf( "random: %d keys x %d ticks, %d events, %d mismatches\n", BTNMNGR_ENUM_MAX, RANDOM_TICKS, iNumLogged, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief time the process
+ *
+ * This function will time the process with every key idle and with every key
+ * held
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  struct timespec tStart, tStop;
+  long            lIndex;
+  double          dIdle, dHeld;
+  int             iKey;
+
+  // time idle
+  bLogEnabled = FALSE;
+  Restart( );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( lIndex = 0; lIndex < TIMING_TICKS; lIndex++ )
+  {
+    ButtonManager_Process( );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+  dIdle = (( tStop.tv_sec - tStart.tv_sec ) * 1e9 + ( tStop.tv_nsec - tStart.tv_nsec )) / TIMING_TICKS;
+
+  // time all held, short of stuck
+  Restart( );
+  for ( iKey = 0; iKey < BTNMNGR_ENUM_MAX; iKey++ )
+  {
+    SetKey( iKey, TRUE );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( lIndex = 0; lIndex < TIMING_TICKS; lIndex++ )
+  {
+    if (( lIndex % ( STUCK_TICKS / 2 )) == 0 )
+    {
+      ButtonManager_ResetAllStates( );
+    }
+    ButtonManager_Process( );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+  dHeld = (( tStop.tv_sec - tStart.tv_sec ) * 1e9 + ( tStop.tv_nsec - tStart.tv_nsec )) / TIMING_TICKS;
+  bLogEnabled = TRUE;
+
+  // report
+  printf( "timing: %d keys, %.1f ns per tick idle, %.1f ns per tick all held\n", BTNMNGR_ENUM_MAX, dIdle, dHeld );
+}
+
+/**@} EOF ButtonManagerHarness.c */
@@ -40,6 +40,13 @@
 /// define the number of nested command tables
 #define BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH  ( 4 )
 
+/// define the macro to enable the scatter/gather send
+#define BINCMDHAND_ENABLE_SCATTERGATHER         ( 0 )
+
+/// define the size of the scatter/gather output chunk, the write function
+/// must consume the chunk before returning as it is reused
+#define BINCMDHAND_SCATTERGATHER_CHUNK_SIZE     ( 64 )
+
 /**@} EOF BinaryCommandHandler_prm.h */
 
 #endif  // _BINARYCOMMANDHANDLER_PRM_H
\ No newline at end of file
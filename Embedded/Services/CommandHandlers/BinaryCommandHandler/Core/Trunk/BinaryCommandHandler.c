@@ -41,6 +41,15 @@
 /// define the broadcast address
 #define BINPROT_BROADCAST_ADDR  ( 0 )
 
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  /// define the smallest chunk, the chunk must hold the largest header, the
+  /// data header and one escaped byte before it is first flushed
+  #define SCATTERGATHER_MIN_CHUNK_SIZE  ( 18 )
+  #if ( BINCMDHAND_SCATTERGATHER_CHUNK_SIZE < SCATTERGATHER_MIN_CHUNK_SIZE )
+    #error BINCMDHAND_SCATTERGATHER_CHUNK_SIZE is too small to hold a message header!
+  #endif
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
+
 // enumerations ---------------------------------------------------------------
 /// define the receive states
 typedef enum _RCVSTATE
@@ -137,6 +146,9 @@ static  PROTCTRL                atCtrls[ BINCMD_ENUM_MAX ];
 static  PPROTCTRL               ptLclCtl;  
 static  PBINCMDDEF              ptLclDef;
 static  PVBINWRITEFUNC          pvLclWriteFunc;
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  static  U8                    anChunk[ BINCMDHAND_SCATTERGATHER_CHUNK_SIZE ];
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
 
 // local function prototypes --------------------------------------------------
 #if ( BINCMDHAND_ENABLE_MASTERMODE == 1 )
@@ -145,6 +157,12 @@ static  PVBINWRITEFUNC          pvLclWriteFunc;
 static  BOOL        CheckAddress( U8 nAddr );
 static  BOOL        StuffRcvData( U8 nRcvChar );
 static  void        StuffXmtData( PLCLBUFCTL ptBufCtl, U8 nData, BOOL bEscapeEnb, BOOL bEnableChk );
+static  void        ResetXmtCheck( PLCLBUFCTL ptBufCtl );
+static  void        StuffXmtHeader( PLCLBUFCTL ptBufCtl, U8 nCommand, U8 nOption1, U8 nOption2 );
+static  void        StuffXmtTrailer( PLCLBUFCTL ptBufCtl );
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  static  void        FlushChunk( PLCLBUFCTL ptChunkCtl, U16 wReserve );
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
 static  BINCMDSTS   ProcessRcvdMsg( BINCMDENUM eProtEnum, U8 nCompareValue );
 static  BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareValue );
 
@@ -619,48 +637,14 @@ BINCMDSTS BinaryCommandHandler_BeginMessage( BINCMDENUM eProtEnum, U8 nCommand,
     ptBufCtl = &ptLclCtl->tXmtBuffer;
     
     // reset the check
-    switch( ptBufCtl->eCheckMode )
-    {
-      case BINCMD_CHECKMODE_EOR :
-      case BINCMD_CHECKMODE_CMP :
-        ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ] = 0;
-        break;
-            
-      case BINCMD_CHECKMODE_CRC :
-        ptBufCtl->tCheck.wValue = BinaryCommandHandler_GetInitialValue( );
-        break;
-            
-      default :
-        break;
-    }
+    ResetXmtCheck( ptBufCtl );
 
     // now reset the length/clear data block
     ptBufCtl->wIndex = 0;
     ptBufCtl->bDataBlock = FALSE;
     
     // now add the header
-    StuffXmtData( ptBufCtl, CH_DLE, FALSE, TRUE );
-    StuffXmtData( ptBufCtl, CH_SOH, FALSE, TRUE );
-    
-    // test for multidrop
-    if ( PGM_RDBYTE( ptLclDef->bMultiDropMode ) == TRUE)
-    {
-      // send the destination/source address's
-      StuffXmtData( ptBufCtl, ptBufCtl->nSrcDstAddr, TRUE, TRUE );
-      StuffXmtData( ptBufCtl, ptLclCtl->nLclAddr, TRUE, TRUE );
-    }
-    
-    // send the command/option bytes
-    StuffXmtData( ptBufCtl, nCommand, TRUE, TRUE );
-    StuffXmtData( ptBufCtl, nOption1, TRUE, TRUE );
-    StuffXmtData( ptBufCtl, nOption2, TRUE, TRUE );
-
-    // check for sequence numbers
-    if ( PGM_RDBYTE( ptLclDef->bSequenceEnable ))
-    {
-      // send the sequence number
-      StuffXmtData( ptBufCtl, ptBufCtl->nSequence, TRUE, TRUE );
-    }
+    StuffXmtHeader( ptBufCtl, nCommand, nOption1, nOption2 );
     
     // set status to idle
     eStatus = BINCMD_STS_IDLE;
@@ -1492,33 +1476,7 @@ BINCMDSTS BinaryCommandHandler_SendMessage( BINCMDENUM eProtEnum )
     pvLclWriteFunc = ( PVBINWRITEFUNC )PGM_RDWORD( ptLclDef->pvWriteFunc );
     
     // send the trailer
-    StuffXmtData( ptBufCtl, CH_DLE, FALSE, TRUE );
-    StuffXmtData( ptBufCtl, CH_EOT, FALSE, TRUE );
-    
-    // reset the check
-    switch( ptBufCtl->eCheckMode )
-    {
-      case BINCMD_CHECKMODE_EOR :
-        // send the character
-        StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, TRUE );
-        break;
-
-      case BINCMD_CHECKMODE_CMP :
-        // send the two's complement
-        ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ] = ~ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ];
-        ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ]++;
-        StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, TRUE );
-        break;
-        
-      case BINCMD_CHECKMODE_CRC :
-        // just just the CRC MSB first
-        StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_MSB_IDX ], FALSE, FALSE );
-        StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, FALSE );
-        break;
-        
-      default :
-        break;
-    }
+    StuffXmtTrailer( ptBufCtl );
     
     // now send the message
     pvLclWriteFunc( ptBufCtl->pnBuffer, ptBufCtl->wIndex );
@@ -1528,6 +1486,127 @@ BINCMDSTS BinaryCommandHandler_SendMessage( BINCMDENUM eProtEnum )
   return( eStatus );
 }
 
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  /******************************************************************************
+   * @function BinaryCommandHandler_SendMessageFragments
+   *
+   * @brief send a message from a list of fragments
+   *
+   * This function will build and send a complete message in one pass, the
+   * header, each payload fragment and the trailer are escaped and checked
+   * directly into a small output chunk which is handed to the write function
+   * as it fills, so the payload is never copied into the transmit buffer
+   *
+   * @param[in]   eProtEnum   protocol enumeration
+   * @param[in]   nCommand    command 
+   * @param[in]   nOption1    option1
+   * @param[in]   nOption2    option2
+   * @param[in]   ptFrags     pointer to the list of fragments
+   * @param[in]   nNumFrags   number of fragments
+   *
+   * @return      appropriate protocol status/error
+   *
+   *****************************************************************************/
+  BINCMDSTS BinaryCommandHandler_SendMessageFragments( BINCMDENUM eProtEnum, U8 nCommand, U8 nOption1, U8 nOption2, PBINCMDFRAG ptFrags, U8 nNumFrags )
+  {
+    BINCMDSTS   eStatus = BINCMD_STS_ILLPROTENUM;
+    LCLBUFCTL   tChunkCtl;
+    PU8         pnData;
+    U16         wLength;
+    BOOL        bProgMem;
+    U8          nFrag;
+  
+    // check for a valid protocol
+    if ( eProtEnum < BINCMD_ENUM_MAX )
+    {
+      // get the pointers to the control/definition structures
+      ptLclCtl = &atCtrls[ eProtEnum ];  
+      ptLclDef = ( PBINCMDDEF )&g_atBinCmdDefs[ eProtEnum ];
+      pvLclWriteFunc = ( PVBINWRITEFUNC )PGM_RDWORD( ptLclDef->pvWriteFunc );
+
+      // set up the chunk control from the transmit buffer control
+      tChunkCtl = ptLclCtl->tXmtBuffer;
+      tChunkCtl.pnBuffer = anChunk;
+      tChunkCtl.wIndex = 0;
+      tChunkCtl.bDataBlock = FALSE;
+      ResetXmtCheck( &tChunkCtl );
+
+      // add the header
+      StuffXmtHeader( &tChunkCtl, nCommand, nOption1, nOption2 );
+
+      // for each fragment
+      for ( nFrag = 0; nFrag < nNumFrags; nFrag++, ptFrags++ )
+      {
+        // get the fragment
+        pnData = ptFrags->pnData;
+        wLength = ptFrags->wLength;
+        bProgMem = ptFrags->bProgMem;
+
+        // check for data header
+        if (( wLength != 0 ) && ( tChunkCtl.bDataBlock == FALSE ))
+        {
+          // set it true/stuff the data header
+          tChunkCtl.bDataBlock = TRUE;
+          StuffXmtData( &tChunkCtl, CH_DLE, FALSE, TRUE );
+          StuffXmtData( &tChunkCtl, CH_STX, FALSE, TRUE );
+        }
+
+        // for each byte
+        while ( wLength-- != 0 )
+        {
+          // stuff the data, room for an escape is always reserved
+          StuffXmtData( &tChunkCtl, ( bProgMem ) ? PGM_RDBYTE( *( pnData ) ) : *( pnData ), TRUE, TRUE );
+          pnData++;
+          FlushChunk( &tChunkCtl, 2 );
+        }
+      }
+
+      // make room for the trailer, add it and send the remainder
+      FlushChunk( &tChunkCtl, 4 );
+      StuffXmtTrailer( &tChunkCtl );
+      FlushChunk( &tChunkCtl, BINCMDHAND_SCATTERGATHER_CHUNK_SIZE );
+
+      // set status to idle
+      eStatus = BINCMD_STS_IDLE;
+    }
+
+    // return the status
+    return( eStatus );
+  }
+
+  /******************************************************************************
+   * @function BinaryCommandHandler_SendResponseFragments
+   *
+   * @brief send the response to the current command from a list of fragments
+   *
+   * This function is called from a command handler, it sends the same ACK
+   * response that would be sent for BINPARSE_STS_SND_RESP with the fragments
+   * as the data, the handler must then return BINPARSE_STS_SND_NORESP
+   *
+   * @param[in]   eProtEnum   protocol enumeration
+   * @param[in]   ptFrags     pointer to the list of fragments
+   * @param[in]   nNumFrags   number of fragments
+   *
+   * @return      appropriate protocol status/error
+   *
+   *****************************************************************************/
+  BINCMDSTS BinaryCommandHandler_SendResponseFragments( BINCMDENUM eProtEnum, PBINCMDFRAG ptFrags, U8 nNumFrags )
+  {
+    BINCMDSTS   eStatus = BINCMD_STS_ILLPROTENUM;
+  
+    // check for a valid protocol
+    if ( eProtEnum < BINCMD_ENUM_MAX )
+    {
+      // send it with the received command
+      ptLclCtl = &atCtrls[ eProtEnum ];  
+      eStatus = BinaryCommandHandler_SendMessageFragments( eProtEnum, ptLclCtl->tRcvBuffer.nCommand, CH_ACK, ptLclCtl->tXmtBuffer.nOption2, ptFrags, nNumFrags );
+    }
+
+    // return the status
+    return( eStatus );
+  }
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
+
 /******************************************************************************
  * RCV_STATE_IDLE functions
  *****************************************************************************/
@@ -1990,6 +2069,143 @@ static void StuffXmtData( PLCLBUFCTL ptBufCtl, U8 nData, BOOL bEscapeEnb, BOOL b
   }
 }
 
+/******************************************************************************
+ * @function ResetXmtCheck
+ *
+ * @brief reset the transmit check
+ *
+ * This function will reset the check value for the selected check mode
+ *
+ * @param[in]   ptBufCtl    pointer to the local buffer control
+ *
+ *****************************************************************************/
+static void ResetXmtCheck( PLCLBUFCTL ptBufCtl )
+{
+  // reset the check
+  switch( ptBufCtl->eCheckMode )
+  {
+    case BINCMD_CHECKMODE_EOR :
+    case BINCMD_CHECKMODE_CMP :
+      ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ] = 0;
+      break;
+          
+    case BINCMD_CHECKMODE_CRC :
+      ptBufCtl->tCheck.wValue = BinaryCommandHandler_GetInitialValue( );
+      break;
+          
+    default :
+      break;
+  }
+}
+
+/******************************************************************************
+ * @function StuffXmtHeader
+ *
+ * @brief stuff the message header
+ *
+ * This function will add the header, the address's if multidrop, the 
+ * command/option bytes and the sequence number if enabled
+ *
+ * @param[in]   ptBufCtl    pointer to the local buffer control
+ * @param[in]   nCommand    command 
+ * @param[in]   nOption1    option1
+ * @param[in]   nOption2    option2
+ *
+ *****************************************************************************/
+static void StuffXmtHeader( PLCLBUFCTL ptBufCtl, U8 nCommand, U8 nOption1, U8 nOption2 )
+{
+  // now add the header
+  StuffXmtData( ptBufCtl, CH_DLE, FALSE, TRUE );
+  StuffXmtData( ptBufCtl, CH_SOH, FALSE, TRUE );
+  
+  // test for multidrop
+  if ( PGM_RDBYTE( ptLclDef->bMultiDropMode ) == TRUE)
+  {
+    // send the destination/source address's
+    StuffXmtData( ptBufCtl, ptBufCtl->nSrcDstAddr, TRUE, TRUE );
+    StuffXmtData( ptBufCtl, ptLclCtl->nLclAddr, TRUE, TRUE );
+  }
+  
+  // send the command/option bytes
+  StuffXmtData( ptBufCtl, nCommand, TRUE, TRUE );
+  StuffXmtData( ptBufCtl, nOption1, TRUE, TRUE );
+  StuffXmtData( ptBufCtl, nOption2, TRUE, TRUE );
+
+  // check for sequence numbers
+  if ( PGM_RDBYTE( ptLclDef->bSequenceEnable ))
+  {
+    // send the sequence number
+    StuffXmtData( ptBufCtl, ptBufCtl->nSequence, TRUE, TRUE );
+  }
+}
+
+/******************************************************************************
+ * @function StuffXmtTrailer
+ *
+ * @brief stuff the message trailer
+ *
+ * This function will add the trailer and the check characters
+ *
+ * @param[in]   ptBufCtl    pointer to the local buffer control
+ *
+ *****************************************************************************/
+static void StuffXmtTrailer( PLCLBUFCTL ptBufCtl )
+{
+  // send the trailer
+  StuffXmtData( ptBufCtl, CH_DLE, FALSE, TRUE );
+  StuffXmtData( ptBufCtl, CH_EOT, FALSE, TRUE );
+  
+  // send the check
+  switch( ptBufCtl->eCheckMode )
+  {
+    case BINCMD_CHECKMODE_EOR :
+      // send the character
+      StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, TRUE );
+      break;
+
+    case BINCMD_CHECKMODE_CMP :
+      // send the two's complement
+      ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ] = ~ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ];
+      ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ]++;
+      StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, TRUE );
+      break;
+      
+    case BINCMD_CHECKMODE_CRC :
+      // just just the CRC MSB first
+      StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_MSB_IDX ], FALSE, FALSE );
+      StuffXmtData( ptBufCtl, ptBufCtl->tCheck.anValue[ LE_U16_LSB_IDX ], FALSE, FALSE );
+      break;
+      
+    default :
+      break;
+  }
+}
+
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  /******************************************************************************
+   * @function FlushChunk
+   *
+   * @brief flush the output chunk
+   *
+   * This function will write the chunk out if there are fewer than the 
+   * reserved number of bytes left in it
+   *
+   * @param[in]   ptChunkCtl  pointer to the chunk buffer control
+   * @param[in]   wReserve    number of bytes that must remain free
+   *
+   *****************************************************************************/
+  static void FlushChunk( PLCLBUFCTL ptChunkCtl, U16 wReserve )
+  {
+    // check for not enough room left
+    if (( ptChunkCtl->wIndex != 0 ) && (( BINCMDHAND_SCATTERGATHER_CHUNK_SIZE - ptChunkCtl->wIndex ) < wReserve ))
+    {
+      // write it/reset the index
+      pvLclWriteFunc( ptChunkCtl->pnBuffer, ptChunkCtl->wIndex );
+      ptChunkCtl->wIndex = 0;
+    }
+  }
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
+
 
 /******************************************************************************
  * @function ProcessRcvdMsg
@@ -68,6 +68,10 @@ extern  BINCMDSTS BinaryCommandHandler_ResetProtocol( BINCMDENUM eProtEnum );
 extern  BINCMDSTS BinaryCommandHandler_ResetXmtLength( BINCMDENUM eProtEnum );
 extern  BINCMDSTS BinaryCommandHandler_BeginMessage( BINCMDENUM eProtEnum, U8 nCommand, U8 nOption1, U8 nOption2 );
 extern  BINCMDSTS BinaryCommandHandler_SendMessage( BINCMDENUM eProtEnum );
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+  extern  BINCMDSTS BinaryCommandHandler_SendMessageFragments( BINCMDENUM eProtEnum, U8 nCommand, U8 nOption1, U8 nOption2, PBINCMDFRAG ptFrags, U8 nNumFrags );
+  extern  BINCMDSTS BinaryCommandHandler_SendResponseFragments( BINCMDENUM eProtEnum, PBINCMDFRAG ptFrags, U8 nNumFrags );
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
 extern  BINCMDSTS BinaryCommandHandler_SetOption1( BINCMDENUM eProtEnum, U8 nOption );
 extern  BINCMDSTS BinaryCommandHandler_SetOption2( BINCMDENUM eProtEnum, U8 nOption );
 extern  BINCMDSTS BinaryCommandHandler_SetSequence( BINCMDENUM eProtEnum, U8 nSequence );
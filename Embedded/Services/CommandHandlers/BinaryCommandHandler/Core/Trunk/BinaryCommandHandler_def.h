@@ -323,6 +323,17 @@ typedef void        ( *PVBINWRITEFUNC )( PU8, U16 );
 /// define the command handler function
 typedef BINPARSESTS ( *PVBINCMDFUNC )( U8 );
 
+#if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+/// define the scatter/gather fragment structure
+typedef struct _BINCMDFRAG
+{
+  PU8                       pnData;         ///< pointer to the fragment data
+  U16                       wLength;        ///< length of the fragment
+  BOOL                      bProgMem;       ///< fragment resides in program memory
+} BINCMDFRAG, *PBINCMDFRAG;
+#define BINCMDFRAG_SIZE         sizeof( BINCMDFRAG )
+#endif // BINCMDHAND_ENABLE_SCATTERGATHER
+
 #if ( BINCMDHAND_ENABLE_MASTERMODE == 1 )
 /// define the master command response function
 typedef void        ( *PVBINMSTCMDRSPFUNC )( void );
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * @file BinaryCommandHandler_cfg.h
+ *
+ * @brief binary command handler scatter/gather test configuration declarations
+ *
+ * This file provides the protocol enumeration for the scatter/gather test,
+ * each link setup has a client, a server that buffers its response and a
+ * server that sends its response from fragments
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup BinaryCommandHandler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _BINARYCOMMANDHANDLER_CFG_H
+#define _BINARYCOMMANDHANDLER_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "BinaryCommandHandler/BinaryCommandHandler_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of protocols per link setup
+#define BINCMD_ENUM_PER_LINK    ( 3 )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the number of defined protocols
+typedef enum _BINCMDENUM
+{
+  BINCMD_ENUM_EORPP_CLI = 0,  ///< EOR, point to point
+  BINCMD_ENUM_EORPP_BUF,
+  BINCMD_ENUM_EORPP_FRG,
+  BINCMD_ENUM_CMPPP_CLI,      ///< complement, point to point, sequence
+  BINCMD_ENUM_CMPPP_BUF,
+  BINCMD_ENUM_CMPPP_FRG,
+  BINCMD_ENUM_CRCPP_CLI,      ///< CRC, point to point
+  BINCMD_ENUM_CRCPP_BUF,
+  BINCMD_ENUM_CRCPP_FRG,
+  BINCMD_ENUM_EORMD_CLI,      ///< EOR, multidrop, sequence
+  BINCMD_ENUM_EORMD_BUF,
+  BINCMD_ENUM_EORMD_FRG,
+  BINCMD_ENUM_CMPMD_CLI,      ///< complement, multidrop
+  BINCMD_ENUM_CMPMD_BUF,
+  BINCMD_ENUM_CMPMD_FRG,
+  BINCMD_ENUM_CRCMD_CLI,      ///< CRC, multidrop, sequence
+  BINCMD_ENUM_CRCMD_BUF,
+  BINCMD_ENUM_CRCMD_FRG,
+  
+  // do not remove the entries below
+  BINCMD_ENUM_MAX,
+  BINCMD_ENUM_ILLEGAL = 0xFF
+} BINCMDENUM;
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE  BINCMDDEF   g_atBinCmdDefs[ BINCMD_ENUM_MAX ];
+
+// global function prototypes --------------------------------------------------
+extern  U16 BinaryCommandHandler_GetInitialValue( void ); 
+extern  U16 BinaryCommandHandler_ComputeCrcByte( U16 wCurrentCrc, U8 nData );
+
+/**@} EOF BinaryCommandHandler_cfg.h */
+
+#endif  // _BINARYCOMMANDHANDLER_CFG_H
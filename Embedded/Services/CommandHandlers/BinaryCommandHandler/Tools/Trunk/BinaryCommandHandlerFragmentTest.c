@@ -0,0 +1,569 @@
+/******************************************************************************
+ * @file BinaryCommandHandlerFragmentTest.c
+ *
+ * @brief binary command handler scatter/gather test
+ *
+ * This file provides a host tool that checks the scatter/gather send against
+ * the buffered send.  It replaces BinaryCommandHandler_cfg.c with six link
+ * setups covering each check mode, point to point and multidrop, with and
+ * without sequence numbers, and uses the smallest chunk so every message
+ * crosses many chunk boundaries.  For random fragment lists, heavy in DLE
+ * characters, with empty fragments and fragments in program memory like the
+ * log dump, it checks that BinaryCommandHandler_SendMessageFragments writes
+ * the same bytes as BinaryCommandHandler_BeginMessage/SetMessageBlock/
+ * SendMessage and that no write is larger than a chunk.  It then sends a
+ * request from a client to a server that buffers its response and to one
+ * that answers with BinaryCommandHandler_SendResponseFragments, checks the
+ * two responses are identical and that the client receives the payload.
+ * It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o BinaryCommandHandlerFragmentTest
+ *             BinaryCommandHandlerFragmentTest.c
+ *             ../../Core/Trunk/BinaryCommandHandler.c
+ *             <StateExecutionEngine root>/Core/Trunk/StateExecutionEngine.c
+ * usage:      BinaryCommandHandlerFragmentTest [messages] [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup BinaryCommandHandler
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "BinaryCommandHandler/BinaryCommandHandler.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of messages/seed
+#define DEFAULT_MESSAGES                            ( 2000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the test command/addresses
+#define TEST_COMMAND                                ( 0x42 )
+#define SERVER_ADDR                                 ( 0x30 )
+#define CLIENT_ADDR                                 ( 0x21 )
+
+/// define the fragment limits
+#define MAX_FRAGS                                   ( 24 )
+#define MAX_FRAG_LEN                                ( 40 )
+#define MAX_PAYLOAD                                 ( MAX_FRAGS * MAX_FRAG_LEN )
+#define MAX_REQUEST                                 ( 16 )
+
+/// define the buffer sizes, the payload may double with escapes
+#define XMT_BUF_SIZE                                (( MAX_PAYLOAD * 2 ) + 32 )
+#define RCV_BUF_SIZE                                ( MAX_PAYLOAD )
+#define CAPTURE_SIZE                                ( XMT_BUF_SIZE )
+
+/// define the description length/count, like the log descriptions
+#define DESCR_LEN                                   ( 20 )
+#define NUM_DESCRS                                  ( 3 )
+
+/// define the declaration helper for a link setup
+#define LINK_BUFFERS( name ) \
+  BINCMD_DBLBUF( name ## Cli, XMT_BUF_SIZE, RCV_BUF_SIZE ) \
+  BINCMD_DBLBUF( name ## Buf, XMT_BUF_SIZE, RCV_BUF_SIZE ) \
+  BINCMD_DBLBUF( name ## Frg, XMT_BUF_SIZE, RCV_BUF_SIZE )
+
+// local parameter declarations -----------------------------------------------
+static  U32         uRandom;
+static  U32         uErrors;
+static  U8          anCapture[ CAPTURE_SIZE ];
+static  U16         wCaptureLen;
+static  U16         wNumWrites;
+static  U16         wMaxWrite;
+static  BINCMDFRAG  atFrags[ MAX_FRAGS ];
+static  U8          nNumFrags;
+static  U8          anPool[ MAX_PAYLOAD ];
+static  U8          anPayload[ MAX_PAYLOAD ];
+static  U16         wPayloadLen;
+static  U8          anClientRcvd[ MAX_PAYLOAD ];
+static  U16         wClientRcvdLen;
+static  BOOL        bClientCalled;
+
+// local function prototypes --------------------------------------------------
+static  U32         Random( U32 uRange );
+static  void        Check( BOOL bCondition, PC8 pszWhat );
+static  void        WriteFunc( PU8 pnData, U16 wLength );
+static  BINPARSESTS CmdBuffered( U8 nCmdEnum );
+static  BINPARSESTS CmdFragments( U8 nCmdEnum );
+static  BINPARSESTS CmdClient( U8 nCmdEnum );
+static  void        MakeFragments( void );
+static  void        CheckDirect( BINCMDENUM eProtEnum );
+static  BINCMDSTS   Deliver( BINCMDENUM eProtEnum, PU8 pnData, U16 wLength );
+static  void        CheckResponse( BINCMDENUM eClient );
+
+// constant parameter initializations -----------------------------------------
+/// define the descriptions, in program memory
+static  const CODE C8 aszDescrs[ NUM_DESCRS ][ DESCR_LEN ] =
+{
+  "Power up",
+  "Watchdog\x10reset",
+  "\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10\x10",
+};
+
+/// define the command tables
+static  const CODE BINCMDSLVENTRY atCliCmds[ ] =
+{
+  BINCMD_SLV_INTENTRY( TEST_COMMAND, 0, -1, BINCOMP_FLAG_NONE, 0, CmdClient ),
+  BINCMD_SLV_ENDENTRY( )
+};
+static  const CODE BINCMDSLVENTRY atBufCmds[ ] =
+{
+  BINCMD_SLV_INTENTRY( TEST_COMMAND, 0, -1, BINCOMP_FLAG_NONE, 0, CmdBuffered ),
+  BINCMD_SLV_ENDENTRY( )
+};
+static  const CODE BINCMDSLVENTRY atFrgCmds[ ] =
+{
+  BINCMD_SLV_INTENTRY( TEST_COMMAND, 0, -1, BINCOMP_FLAG_NONE, 0, CmdFragments ),
+  BINCMD_SLV_ENDENTRY( )
+};
+
+/// declare the buffers
+LINK_BUFFERS( EorPp )
+LINK_BUFFERS( CmpPp )
+LINK_BUFFERS( CrcPp )
+LINK_BUFFERS( EorMd )
+LINK_BUFFERS( CmpMd )
+LINK_BUFFERS( CrcMd )
+
+/// define the protocols
+const CODE  BINCMDDEF   g_atBinCmdDefs[ BINCMD_ENUM_MAX ] =
+{
+  BINCMD_SLV_DEFDBPP( EorPpCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, FALSE, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBPP( EorPpBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, FALSE, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBPP( EorPpFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, FALSE, WriteFunc, atFrgCmds ),
+  BINCMD_SLV_DEFDBPP( CmpPpCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, TRUE, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBPP( CmpPpBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, TRUE, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBPP( CmpPpFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, TRUE, WriteFunc, atFrgCmds ),
+  BINCMD_SLV_DEFDBPP( CrcPpCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, FALSE, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBPP( CrcPpBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, FALSE, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBPP( CrcPpFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, FALSE, WriteFunc, atFrgCmds ),
+  BINCMD_SLV_DEFDBMD( EorMdCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, TRUE, CLIENT_ADDR, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBMD( EorMdBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, TRUE, SERVER_ADDR, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBMD( EorMdFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_EOR, TRUE, SERVER_ADDR, WriteFunc, atFrgCmds ),
+  BINCMD_SLV_DEFDBMD( CmpMdCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, FALSE, CLIENT_ADDR, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBMD( CmpMdBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, FALSE, SERVER_ADDR, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBMD( CmpMdFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CMP, FALSE, SERVER_ADDR, WriteFunc, atFrgCmds ),
+  BINCMD_SLV_DEFDBMD( CrcMdCli, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, TRUE, CLIENT_ADDR, WriteFunc, atCliCmds ),
+  BINCMD_SLV_DEFDBMD( CrcMdBuf, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, TRUE, SERVER_ADDR, WriteFunc, atBufCmds ),
+  BINCMD_SLV_DEFDBMD( CrcMdFrg, XMT_BUF_SIZE, RCV_BUF_SIZE, BINCMD_CHECKMODE_CRC, TRUE, SERVER_ADDR, WriteFunc, atFrgCmds ),
+};
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  U32         uMessages = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : DEFAULT_MESSAGES;
+  U32         uMsg;
+  BINCMDENUM  eClient;
+
+  // initialize
+  uRandom = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+  BinaryCommandHandler_Initialize( );
+
+  // for each message
+  for ( uMsg = 0; uMsg < uMessages; uMsg++ )
+  {
+    // for each link setup
+    for ( eClient = 0; eClient < BINCMD_ENUM_MAX; eClient += BINCMD_ENUM_PER_LINK )
+    {
+      // check the direct send/the response
+      CheckDirect( eClient );
+      CheckResponse( eClient );
+    }
+  }
+
+  // report
+  printf( "%u messages on %u links\n", ( unsigned )uMessages, ( unsigned )( BINCMD_ENUM_MAX / BINCMD_ENUM_PER_LINK ));
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", ( unsigned )uErrors );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function BinaryCommandHandler_GetInitialValue
+ *
+ * @brief get the initial CRC value
+ *
+ * @return      initial value
+ *
+ *****************************************************************************/
+U16 BinaryCommandHandler_GetInitialValue( void )
+{
+  // return the CCITT initial value
+  return( 0xFFFF );
+}
+
+/******************************************************************************
+ * @function BinaryCommandHandler_ComputeCrcByte
+ *
+ * @brief add a byte to the CRC
+ *
+ * @param[in]   wCurrentCrc   current CRC
+ * @param[in]   nData         data
+ *
+ * @return      new CRC
+ *
+ *****************************************************************************/
+U16 BinaryCommandHandler_ComputeCrcByte( U16 wCurrentCrc, U8 nData )
+{
+  U8  nBit;
+
+  // CCITT
+  wCurrentCrc ^= ( U16 )nData << 8;
+  for ( nBit = 0; nBit < 8; nBit++ )
+  {
+    wCurrentCrc = ( wCurrentCrc & 0x8000 ) ? ( U16 )(( wCurrentCrc << 1 ) ^ 0x1021 ) : ( U16 )( wCurrentCrc << 1 );
+  }
+
+  // return the new CRC
+  return( wCurrentCrc );
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief random number
+ *
+ * @param[in]   uRange    range
+ *
+ * @return      random number below the range
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // xorshift
+  uRandom ^= uRandom << 13;
+  uRandom ^= uRandom >> 17;
+  uRandom ^= uRandom << 5;
+  return( uRandom % uRange );
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * @param[in]   bCondition  condition that must be true
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, PC8 pszWhat )
+{
+  // report the first few failures
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      fprintf( stderr, "fail: %s\n", pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function WriteFunc
+ *
+ * @brief protocol write function
+ *
+ * This function appends the data to the capture and counts the writes
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length
+ *
+ *****************************************************************************/
+static void WriteFunc( PU8 pnData, U16 wLength )
+{
+  // capture it
+  if (( wCaptureLen + wLength ) <= CAPTURE_SIZE )
+  {
+    memcpy( &anCapture[ wCaptureLen ], pnData, wLength );
+  }
+  wCaptureLen += wLength;
+  wNumWrites++;
+  wMaxWrite = ( wLength > wMaxWrite ) ? wLength : wMaxWrite;
+}
+
+/******************************************************************************
+ * @function CmdBuffered
+ *
+ * @brief test command, buffered response
+ *
+ * @param[in]   nCmdEnum    protocol enumeration
+ *
+ * @return      send the response
+ *
+ *****************************************************************************/
+static BINPARSESTS CmdBuffered( U8 nCmdEnum )
+{
+  U8  nFrag;
+
+  // add each fragment to the transmit buffer
+  for ( nFrag = 0; nFrag < nNumFrags; nFrag++ )
+  {
+    if ( atFrags[ nFrag ].wLength != 0 )
+    {
+      BinaryCommandHandler_SetMessageBlock( nCmdEnum, atFrags[ nFrag ].pnData, atFrags[ nFrag ].wLength );
+    }
+  }
+
+  // return the send response
+  return( BINPARSE_STS_SND_RESP );
+}
+
+/******************************************************************************
+ * @function CmdFragments
+ *
+ * @brief test command, response from fragments
+ *
+ * @param[in]   nCmdEnum    protocol enumeration
+ *
+ * @return      no response, it has been sent
+ *
+ *****************************************************************************/
+static BINPARSESTS CmdFragments( U8 nCmdEnum )
+{
+  // send it
+  BinaryCommandHandler_SendResponseFragments( nCmdEnum, atFrags, nNumFrags );
+
+  // return no response
+  return( BINPARSE_STS_SND_NORESP );
+}
+
+/******************************************************************************
+ * @function CmdClient
+ *
+ * @brief client side of the test command, store the response
+ *
+ * @param[in]   nCmdEnum    protocol enumeration
+ *
+ * @return      no response
+ *
+ *****************************************************************************/
+static BINPARSESTS CmdClient( U8 nCmdEnum )
+{
+  PU8 pnBuffer;
+
+  // store the received payload
+  BinaryCommandHandler_GetRcvBufferPointer( nCmdEnum, &pnBuffer );
+  BinaryCommandHandler_GetRcvLength( nCmdEnum, &wClientRcvdLen );
+  if ( wClientRcvdLen <= MAX_PAYLOAD )
+  {
+    memcpy( anClientRcvd, pnBuffer, wClientRcvdLen );
+  }
+  bClientCalled = TRUE;
+
+  // return no response
+  return( BINPARSE_STS_SND_NORESP );
+}
+
+/******************************************************************************
+ * @function MakeFragments
+ *
+ * @brief make a random fragment list
+ *
+ * This function fills the pool with data heavy in DLE characters and cuts
+ * it into fragments, some empty and some pointing at the descriptions in
+ * program memory, and records the expected payload
+ *
+ *****************************************************************************/
+static void MakeFragments( void )
+{
+  U16 wIdx, wPoolIdx = 0, wLength;
+
+  // fill the pool
+  for ( wIdx = 0; wIdx < MAX_PAYLOAD; wIdx++ )
+  {
+    anPool[ wIdx ] = ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 );
+  }
+
+  // cut the fragments
+  nNumFrags = Random( MAX_FRAGS + 1 );
+  wPayloadLen = 0;
+  for ( wIdx = 0; wIdx < nNumFrags; wIdx++ )
+  {
+    switch( Random( 4 ))
+    {
+      case 0 :
+        // a description
+        atFrags[ wIdx ].pnData = ( PU8 )aszDescrs[ Random( NUM_DESCRS ) ];
+        atFrags[ wIdx ].wLength = DESCR_LEN;
+        atFrags[ wIdx ].bProgMem = TRUE;
+        break;
+
+      case 1 :
+        // empty
+        atFrags[ wIdx ].pnData = &anPool[ wPoolIdx ];
+        atFrags[ wIdx ].wLength = 0;
+        atFrags[ wIdx ].bProgMem = FALSE;
+        break;
+
+      default :
+        // data
+        wLength = 1 + Random( MAX_FRAG_LEN );
+        atFrags[ wIdx ].pnData = &anPool[ wPoolIdx ];
+        atFrags[ wIdx ].wLength = wLength;
+        atFrags[ wIdx ].bProgMem = FALSE;
+        wPoolIdx += wLength;
+        break;
+    }
+
+    // add it to the expected payload
+    memcpy( &anPayload[ wPayloadLen ], atFrags[ wIdx ].pnData, atFrags[ wIdx ].wLength );
+    wPayloadLen += atFrags[ wIdx ].wLength;
+  }
+}
+
+/******************************************************************************
+ * @function CheckDirect
+ *
+ * @brief check a direct send
+ *
+ * This function sends a random fragment list with random header values both
+ * ways and compares the bytes written
+ *
+ * @param[in]   eProtEnum   protocol enumeration
+ *
+ *****************************************************************************/
+static void CheckDirect( BINCMDENUM eProtEnum )
+{
+  static  U8  anBuffered[ CAPTURE_SIZE ];
+  U16         wBufferedLen;
+  U8          nCommand, nOption1, nOption2, nFrag;
+
+  // pick the header/fragments
+  nCommand = ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 );
+  nOption1 = ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 );
+  nOption2 = ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 );
+  BinaryCommandHandler_SetSequence( eProtEnum, ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 ));
+  BinaryCommandHandler_SetDstAddr( eProtEnum, ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 ));
+  MakeFragments( );
+
+  // send it buffered
+  wCaptureLen = 0;
+  BinaryCommandHandler_BeginMessage( eProtEnum, nCommand, nOption1, nOption2 );
+  for ( nFrag = 0; nFrag < nNumFrags; nFrag++ )
+  {
+    if ( atFrags[ nFrag ].wLength != 0 )
+    {
+      BinaryCommandHandler_SetMessageBlock( eProtEnum, atFrags[ nFrag ].pnData, atFrags[ nFrag ].wLength );
+    }
+  }
+  BinaryCommandHandler_SendMessage( eProtEnum );
+  wBufferedLen = wCaptureLen;
+  memcpy( anBuffered, anCapture, wBufferedLen );
+
+  // send it from the fragments
+  wCaptureLen = 0;
+  wNumWrites = 0;
+  wMaxWrite = 0;
+  BinaryCommandHandler_SendMessageFragments( eProtEnum, nCommand, nOption1, nOption2, atFrags, nNumFrags );
+
+  // check it
+  Check(( wCaptureLen == wBufferedLen ) && ( memcmp( anCapture, anBuffered, wBufferedLen ) == 0 ), "fragments match the buffered message" );
+  Check( wMaxWrite <= BINCMDHAND_SCATTERGATHER_CHUNK_SIZE, "write no larger than a chunk" );
+  Check( wNumWrites >= (( wCaptureLen + BINCMDHAND_SCATTERGATHER_CHUNK_SIZE - 1 ) / BINCMDHAND_SCATTERGATHER_CHUNK_SIZE ), "enough writes" );
+}
+
+/******************************************************************************
+ * @function Deliver
+ *
+ * @brief deliver a message to a protocol
+ *
+ * @param[in]   eProtEnum   protocol enumeration
+ * @param[in]   pnData      pointer to the message
+ * @param[in]   wLength     length
+ *
+ * @return      status from the last character
+ *
+ *****************************************************************************/
+static BINCMDSTS Deliver( BINCMDENUM eProtEnum, PU8 pnData, U16 wLength )
+{
+  BINCMDSTS eStatus = BINCMD_STS_IDLE;
+
+  // process each character
+  while ( wLength-- != 0 )
+  {
+    eStatus = BinaryCommandHandler_ProcessChar( eProtEnum, *( pnData++ ), 0 );
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function CheckResponse
+ *
+ * @brief check the response to a request
+ *
+ * This function sends a request from the client to both servers, compares
+ * their responses and delivers the response back to the client
+ *
+ * @param[in]   eClient     client protocol enumeration
+ *
+ *****************************************************************************/
+static void CheckResponse( BINCMDENUM eClient )
+{
+  static  U8  anRequest[ CAPTURE_SIZE ];
+  static  U8  anBuffered[ CAPTURE_SIZE ];
+  U8          anData[ MAX_REQUEST ];
+  U16         wRequestLen, wBufferedLen, wIdx;
+  BINCMDSTS   eStatus;
+
+  // build the request
+  for ( wIdx = 0; wIdx < MAX_REQUEST; wIdx++ )
+  {
+    anData[ wIdx ] = ( Random( 4 ) == 0 ) ? 0x10 : Random( 256 );
+  }
+  MakeFragments( );
+  wCaptureLen = 0;
+  BinaryCommandHandler_SetDstAddr( eClient, SERVER_ADDR );
+  BinaryCommandHandler_BeginMessage( eClient, TEST_COMMAND, 0, 0 );
+  BinaryCommandHandler_SetMessageBlock( eClient, anData, Random( MAX_REQUEST + 1 ));
+  BinaryCommandHandler_SendMessage( eClient );
+  wRequestLen = wCaptureLen;
+  memcpy( anRequest, anCapture, wRequestLen );
+
+  // buffered server
+  wCaptureLen = 0;
+  eStatus = Deliver( eClient + 1, anRequest, wRequestLen );
+  Check( eStatus == BINCMD_STS_MSGRCVD_PROC, "buffered server processed the request" );
+  wBufferedLen = wCaptureLen;
+  memcpy( anBuffered, anCapture, wBufferedLen );
+
+  // fragment server
+  wCaptureLen = 0;
+  Deliver( eClient + 2, anRequest, wRequestLen );
+  Check(( wCaptureLen == wBufferedLen ) && ( memcmp( anCapture, anBuffered, wBufferedLen ) == 0 ), "fragment response matches the buffered response" );
+
+  // deliver it to the client
+  bClientCalled = FALSE;
+  wCaptureLen = 0;
+  Deliver( eClient, anBuffered, wBufferedLen );
+  Check( bClientCalled, "client received the response" );
+  Check(( wClientRcvdLen == wPayloadLen ) && ( memcmp( anClientRcvd, anPayload, wPayloadLen ) == 0 ), "client payload" );
+  Check( wCaptureLen == 0, "client sent nothing" );
+}
+
+/**@} EOF BinaryCommandHandlerFragmentTest.c */
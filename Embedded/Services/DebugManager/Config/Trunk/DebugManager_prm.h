@@ -27,6 +27,9 @@
 #ifndef _DEBUGMANAGER_PRM_H
 #define _DEBUGMANAGER_PRM_H
 
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
 // Macros and Defines ---------------------------------------------------------
 /// define the task argument size - valid values are 1, 2 or 4
 #define DEBUGMANAGER_ARGSIZE_BYTES              ( 2 )
@@ -45,6 +48,36 @@
 #define DEBUGMANAGER_GETTIME_MSECS              ( )
 #endif // DEBUGMANAGER_ENABLE_TIMESTAMP
 
+/// define the macro to enable the wraparound trace ring
+#define DEBUGMANAGER_ENABLE_RING                ( OFF )
+
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+/// define the ring order, the number of records is 2^order ( 1 to 12 )
+#define DEBUGMANAGER_RING_ORDER                 ( 8 )
+
+/// define the macro to get the free running record time stamp
+#define DEBUGMANAGER_RING_GETTIME( )            ( 0 )
+
+/// define the macro to use a critical section for the read/modify/writes, set for cores without exclusive access ( Cortex-M0 )
+#define DEBUGMANAGER_RING_USE_CRITICAL          ( OFF )
+
+#if ( DEBUGMANAGER_RING_USE_CRITICAL == ON )
+/// define the critical section, the interrupt mask is saved so it nests
+#define DEBUGMANAGER_RING_CRITICAL_ENTER( s )   { s = __get_PRIMASK( ); __disable_irq( ); }
+#define DEBUGMANAGER_RING_CRITICAL_EXIT( s )    { __set_PRIMASK( s ); }
+#else
+/// define the atomic read/modify/writes, the compare exchange updates the expected value on a failure
+#define DEBUGMANAGER_RING_FETCHADD( p, v )      __atomic_fetch_add( p, v, __ATOMIC_RELEASE )
+#define DEBUGMANAGER_RING_EXCHANGE( p, v )      __atomic_exchange_n( p, v, __ATOMIC_ACQ_REL )
+#define DEBUGMANAGER_RING_CAS( p, pe, v )       __atomic_compare_exchange_n( p, pe, v, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+#endif // DEBUGMANAGER_RING_USE_CRITICAL
+
+/// define the atomic loads/stores/fence, word sized so lock free on every core
+#define DEBUGMANAGER_RING_LOAD( p )             __atomic_load_n( p, __ATOMIC_ACQUIRE )
+#define DEBUGMANAGER_RING_STORE( p, v )         __atomic_store_n( p, v, __ATOMIC_RELEASE )
+#define DEBUGMANAGER_RING_FENCE( )              __atomic_thread_fence( __ATOMIC_ACQ_REL )
+#endif // DEBUGMANAGER_ENABLE_RING
+
 /**@} EOF DebugManager_prm.h */
 
 #endif  // _DEBUGMANAGER_PRM_H
@@ -55,15 +55,57 @@ typedef struct _DBGENTRY
 } DBGENTRY, *PDBGENTRY;
 #define DBGENTRY_SIZE   sizeof( DBGENTRY )
 
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+/// define the trace ring slot
+typedef struct _DBGSLOT
+{
+  U32     uSeq;         ///< index of the record, complemented while it is written
+  U32     uTime;        ///< time stamp taken with the claim
+  DBGARG  xId;          ///< module/event ID ( argument #1 )
+  DBGARG  xArg;         ///< argument ( argument #2 )
+} DBGSLOT, *PDBGSLOT;
+#define DBGSLOT_SIZE    sizeof( DBGSLOT )
+
+/// define the macros for the slot sequence, the complement of an index never maps to its own slot
+#define SEQ_BUSY( idx )               ( ~( U32 )( idx ))
+#define SEQ_IS_BUSY( seq, slot )      ((( seq ) & DEBUGMANAGER_RING_MASK ) != ( slot ))
+
+/// map the read/modify/writes to the critical section functions
+#if ( DEBUGMANAGER_RING_USE_CRITICAL == ON )
+#define DEBUGMANAGER_RING_FETCHADD( p, v )      RingFetchAdd( p, v )
+#define DEBUGMANAGER_RING_EXCHANGE( p, v )      RingExchange( p, v )
+#define DEBUGMANAGER_RING_CAS( p, pe, v )       RingCompareExchange( p, pe, v )
+#endif // DEBUGMANAGER_RING_USE_CRITICAL
+#endif // DEBUGMANAGER_ENABLE_RING
+
 // local parameter declarations -----------------------------------------------
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+static  DBGSLOT   atDbgRing[ DEBUGMANAGER_RING_SIZE ];
+static  U32       uRingHead;
+static  U32       uRingTail;
+static  U32       uReadTime;
+static  U32       uRingLost;
+static  U32       uRingDropped;
+static  BOOL      bFrozen;
+#else
 static  DBGENTRY  atDbgEntries[ DEBUGMANAGER_NUM_ENTRIES ];
 static  U16       wIndex;
+#endif // DEBUGMANAGER_ENABLE_RING
 
 // local function prototypes --------------------------------------------------
+#if (( DEBUGMANAGER_ENABLE_RING == ON ) && ( DEBUGMANAGER_RING_USE_CRITICAL == ON ))
+  static  U32   RingFetchAdd( PU32 puValue, U32 uAdd );
+  static  U32   RingExchange( PU32 puValue, U32 uNew );
+  static  BOOL  RingCompareExchange( PU32 puValue, PU32 puExpected, U32 uNew );
+#endif // DEBUGMANAGER_RING_USE_CRITICAL
 
 /// command handlers
 #if ( DEBUGMANAGER_ENABLE_DEBUG_COMMANDS == 1 )
   static  ASCCMDSTS CmdDmpDbg( U8 nCmdEnum );
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+    static  ASCCMDSTS CmdDrnRng( U8 nCmdEnum );
+    static  ASCCMDSTS CmdFrzRng( U8 nCmdEnum );
+  #endif // DEBUGMANAGER_ENABLE_RING
 #endif  // DEBUGMANAGER_ENABLE_DEBUG_COMMANDS
 
 // constant parameter initializations -----------------------------------------
@@ -84,15 +126,36 @@ static  U16       wIndex;
     static  const CODE C8 szFmtDec[ ]   = { "%3d:%3d " };
   #endif
 
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+    /// define the ring drain strings, sequence, delta, ID, argument
+    #if ( DEBUGMANAGER_ARGSIZE_BYTES == 4 )
+      static  const CODE C8 szFmtRec[ ]   = { "R %08lX %04X %08lX %08lX\n\r" };
+    #elif ( DEBUGMANAGER_ARGSIZE_BYTES == 2 )
+      static  const CODE C8 szFmtRec[ ]   = { "R %08lX %04X %04X %04X\n\r" };
+    #else
+      static  const CODE C8 szFmtRec[ ]   = { "R %08lX %04X %02X %02X\n\r" };
+    #endif
+    static  const CODE C8 szFmtLost[ ]  = { "L %lu\n\r" };
+    static  const CODE C8 szRngEnd[ ]   = { "E\n\r" };
+  #endif // DEBUGMANAGER_ENABLE_RING
+
   /// declare the command strings
   static  const CODE C8 szDmpDbg[ ]   = { "DDBG" };
   static  const CODE C8 szDmpDbg1[ ]  = { "DMPDBG" };
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+    static  const CODE C8 szDrnRng[ ]   = { "DRNG" };
+    static  const CODE C8 szFrzRng[ ]   = { "DFRZ" };
+  #endif // DEBUGMANAGER_ENABLE_RING
 
   /// initialize the command table
   const CODE ASCCMDENTRY g_atDebugManagerCmdHandlerTable[ ] =
   {
     ASCCMD_ENTRY( szDmpDbg,  4, 1, ASCFLAG_COMPARE_NONE, 0, CmdDmpDbg ),
     ASCCMD_ENTRY( szDmpDbg1, 6, 1, ASCFLAG_COMPARE_NONE, 0, CmdDmpDbg ),
+    #if ( DEBUGMANAGER_ENABLE_RING == ON )
+      ASCCMD_ENTRY( szDrnRng,  4, 1, ASCFLAG_COMPARE_NONE, 0, CmdDrnRng ),
+      ASCCMD_ENTRY( szFrzRng,  4, 1, ASCFLAG_COMPARE_NONE, 0, CmdFrzRng ),
+    #endif // DEBUGMANAGER_ENABLE_RING
 
     // the entry below must be here
     ASCCMD_ENDTBL( )
@@ -111,8 +174,24 @@ static  U16       wIndex;
  *****************************************************************************/
 BOOL DebugManager_Initialize( void )
 {
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+  U16 wSlot;
+
+  // mark every slot as a published record of the previous lap
+  for ( wSlot = 0; wSlot < DEBUGMANAGER_RING_SIZE; wSlot++ )
+  {
+    atDbgRing[ wSlot ].uSeq = ( U32 )wSlot - DEBUGMANAGER_RING_SIZE;
+  }
+
+  // reset the indices/time
+  uRingHead = uRingTail = 0;
+  uReadTime = DEBUGMANAGER_RING_GETTIME( );
+  uRingLost = uRingDropped = 0;
+  bFrozen = FALSE;
+  #else
   // reset/clear
   wIndex = 0;
+  #endif // DEBUGMANAGER_ENABLE_RING
 
   // return ok
   return( FALSE );
@@ -123,7 +202,12 @@ BOOL DebugManager_Initialize( void )
  *
  * @brief add an element
  *
- * This function will add an element to the array and adjust the indices
+ * This function will add an element to the array and adjust the indices.
+ * On the ring the head is claimed with a compare exchange and the time stamp
+ * is taken inside the same attempt, so the times follow the record order.
+ * The slot is then claimed with a compare exchange against the previous lap's
+ * published index.  If that writer is still filling it the element is dropped
+ * and counted, the older record is never overwritten under its writer.
  *
  * @param[in]   xArg1     argument #1
  * @param[in]   xArg2     argument #2
@@ -131,6 +215,51 @@ BOOL DebugManager_Initialize( void )
  *****************************************************************************/
 void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
 {
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+  U32         uIndex, uNow, uSeq;
+  BOOL        bClaimed = FALSE;
+  BOOL        bStuck = FALSE;
+  PDBGSLOT    ptSlot;
+
+  // ignore while frozen
+  if ( !DEBUGMANAGER_RING_LOAD( &bFrozen ))
+  {
+    // claim the head, taking the time stamp with it
+    do
+    {
+      uIndex = DEBUGMANAGER_RING_LOAD( &uRingHead );
+      uNow = DEBUGMANAGER_RING_GETTIME( );
+      ptSlot = &atDbgRing[ uIndex & DEBUGMANAGER_RING_MASK ];
+      if ( DEBUGMANAGER_RING_LOAD( &ptSlot->uSeq ) == ( uIndex - DEBUGMANAGER_RING_SIZE ))
+      {
+        // slot is free, claim the index
+        bClaimed = DEBUGMANAGER_RING_CAS( &uRingHead, &uIndex, uIndex + 1 );
+      }
+      else if ( DEBUGMANAGER_RING_LOAD( &uRingHead ) == uIndex )
+      {
+        // the previous lap's writer still owns the slot
+        bStuck = TRUE;
+      }
+    } while (( bClaimed == FALSE ) && ( bStuck == FALSE ));
+
+    // claim the slot from the previous lap
+    uSeq = uIndex - DEBUGMANAGER_RING_SIZE;
+    if ( bClaimed && DEBUGMANAGER_RING_CAS( &ptSlot->uSeq, &uSeq, SEQ_BUSY( uIndex )))
+    {
+      // fill it and publish the index
+      DEBUGMANAGER_RING_FENCE( );
+      ptSlot->uTime = uNow;
+      ptSlot->xId = xArg1;
+      ptSlot->xArg = xArg2;
+      DEBUGMANAGER_RING_STORE( &ptSlot->uSeq, uIndex );
+    }
+    else
+    {
+      // count the dropped element
+      DEBUGMANAGER_RING_FETCHADD( &uRingDropped, 1 );
+    }
+  }
+  #else
   #if (( DEBUGMANAGER_ENABLE_TIMESTAMP == 1) && ( DEBUGMANAGER_ARGSIZE_BYTES != 1 ))
   U32UN tTimeStamp;
   tTimeStamp.uValue = DEBUGMANAGER_GETTIME_MSECS( );
@@ -157,8 +286,205 @@ void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
     // increment the index
     wIndex++;
   }
+  #endif // DEBUGMANAGER_ENABLE_RING
+}
+
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+/******************************************************************************
+ * @function DebugManager_ReadRecord
+ *
+ * @brief read the oldest record
+ *
+ * This function will read the oldest record from the ring.  If the writers
+ * have lapped the reader it skips to the oldest record still in the ring.  It
+ * never waits, a record that is still being written ends the read.  The
+ * delta is from the previous record read so the times stay exact across a
+ * loss.  There must only be one reader.
+ *
+ * @param[io]   ptRecord    pointer to store the record
+ * @param[io]   puLost      pointer to store the records lost or dropped before this one
+ *
+ * @return      TRUE if a record was read, FALSE if none available
+ *
+ *****************************************************************************/
+BOOL DebugManager_ReadRecord( PDBGRECORD ptRecord, PU32 puLost )
+{
+  BOOL        bRead = FALSE;
+  BOOL        bStop = FALSE;
+  U32         uHead, uSkip, uSeq, uTime;
+  U16         wSlot;
+  PDBGSLOT    ptSlot;
+
+  // skip to the oldest record if lapped
+  uHead = DEBUGMANAGER_RING_LOAD( &uRingHead );
+  if (( uHead - uRingTail ) > DEBUGMANAGER_RING_SIZE )
+  {
+    uSkip = ( uHead - uRingTail ) - DEBUGMANAGER_RING_SIZE;
+    uRingLost += uSkip;
+    uRingTail += uSkip;
+  }
+
+  // loop until a record is read or none are ready
+  while (( bRead == FALSE ) && ( bStop == FALSE ) && ( uRingTail != uHead ))
+  {
+    // copy the slot between two reads of its sequence
+    wSlot = uRingTail & DEBUGMANAGER_RING_MASK;
+    ptSlot = &atDbgRing[ wSlot ];
+    uSeq = DEBUGMANAGER_RING_LOAD( &ptSlot->uSeq );
+    uTime = ptSlot->uTime;
+    ptRecord->xId = ptSlot->xId;
+    ptRecord->xArg = ptSlot->xArg;
+    DEBUGMANAGER_RING_FENCE( );
+
+    // determine the state of the slot
+    if ( uSeq == uRingTail )
+    {
+      // valid if unchanged, otherwise a later lap claimed it during the copy
+      if ( DEBUGMANAGER_RING_LOAD( &ptSlot->uSeq ) == uSeq )
+      {
+        ptRecord->uSeq = uRingTail;
+        ptRecord->wDelta = ( U16 )MIN( uTime - uReadTime, DEBUGMANAGER_DELTA_MAX );
+        uReadTime = uTime;
+        uRingTail++;
+        bRead = TRUE;
+      }
+    }
+    else if (( S32 )(( SEQ_IS_BUSY( uSeq, wSlot ) ? SEQ_BUSY( uSeq ) : uSeq ) - uRingTail ) > 0 )
+    {
+      // overwritten by a later lap, skip it
+      uRingLost++;
+      uRingTail++;
+    }
+    else
+    {
+      // not yet written or still being written, try again later
+      bStop = TRUE;
+    }
+  }
+
+  // report the lost count with the record
+  if ( bRead )
+  {
+    uRingLost += DEBUGMANAGER_RING_EXCHANGE( &uRingDropped, 0 );
+    *( puLost ) = uRingLost;
+    uRingLost = 0;
+  }
+
+  // return the status
+  return( bRead );
 }
 
+/******************************************************************************
+ * @function DebugManager_Freeze
+ *
+ * @brief freeze the ring
+ *
+ * This function will freeze or thaw the ring.  While frozen new elements are
+ * dropped so the records leading up to the freeze are kept for the drain.
+ *
+ * @param[in]   bFreeze     TRUE to freeze, FALSE to resume recording
+ *
+ *****************************************************************************/
+void DebugManager_Freeze( BOOL bFreeze )
+{
+  // set the state
+  DEBUGMANAGER_RING_STORE( &bFrozen, bFreeze );
+}
+
+#if ( DEBUGMANAGER_RING_USE_CRITICAL == ON )
+/******************************************************************************
+ * @function RingFetchAdd
+ *
+ * @brief fetch and add
+ *
+ * This function will add to the value in a critical section
+ *
+ * @param[io]   puValue     pointer to the value
+ * @param[in]   uAdd        amount to add
+ *
+ * @return      the previous value
+ *
+ *****************************************************************************/
+static U32 RingFetchAdd( PU32 puValue, U32 uAdd )
+{
+  U32 uState, uOld;
+
+  // add it
+  DEBUGMANAGER_RING_CRITICAL_ENTER( uState );
+  uOld = *( puValue );
+  *( puValue ) = uOld + uAdd;
+  DEBUGMANAGER_RING_CRITICAL_EXIT( uState );
+
+  // return the previous value
+  return( uOld );
+}
+
+/******************************************************************************
+ * @function RingExchange
+ *
+ * @brief exchange
+ *
+ * This function will exchange the value in a critical section
+ *
+ * @param[io]   puValue     pointer to the value
+ * @param[in]   uNew        new value
+ *
+ * @return      the previous value
+ *
+ *****************************************************************************/
+static U32 RingExchange( PU32 puValue, U32 uNew )
+{
+  U32 uState, uOld;
+
+  // exchange it
+  DEBUGMANAGER_RING_CRITICAL_ENTER( uState );
+  uOld = *( puValue );
+  *( puValue ) = uNew;
+  DEBUGMANAGER_RING_CRITICAL_EXIT( uState );
+
+  // return the previous value
+  return( uOld );
+}
+
+/******************************************************************************
+ * @function RingCompareExchange
+ *
+ * @brief compare and exchange
+ *
+ * This function will store the new value if the value matches the expected
+ * one in a critical section, otherwise the expected value is updated
+ *
+ * @param[io]   puValue     pointer to the value
+ * @param[io]   puExpected  pointer to the expected value
+ * @param[in]   uNew        new value
+ *
+ * @return      TRUE if exchanged, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL RingCompareExchange( PU32 puValue, PU32 puExpected, U32 uNew )
+{
+  U32   uState;
+  BOOL  bExchanged = FALSE;
+
+  // compare/exchange it
+  DEBUGMANAGER_RING_CRITICAL_ENTER( uState );
+  if ( *( puValue ) == *( puExpected ))
+  {
+    *( puValue ) = uNew;
+    bExchanged = TRUE;
+  }
+  else
+  {
+    *( puExpected ) = *( puValue );
+  }
+  DEBUGMANAGER_RING_CRITICAL_EXIT( uState );
+
+  // return the status
+  return( bExchanged );
+}
+#endif // DEBUGMANAGER_RING_USE_CRITICAL
+#endif // DEBUGMANAGER_ENABLE_RING
+
 
 #if ( DEBUGMANAGER_ENABLE_DEBUG_COMMANDS == 1 )
   /******************************************************************************
@@ -174,8 +500,13 @@ void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
   {
     U32UN tTemp;
     U8    nElementCount, nElementSize;
-    U16   wBufIdx;
     PC8   pszFormat, pcBuffer;
+    #if ( DEBUGMANAGER_ENABLE_RING == ON )
+    DBGRECORD tRecord;
+    U32       uLost;
+    #else
+    U16   wBufIdx;
+    #endif // DEBUGMANAGER_ENABLE_RING
 
     // get the argument
     AsciiCommandHandler_GetValue( nCmdEnum, 0, &tTemp.uValue );
@@ -206,11 +537,19 @@ void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
 
     // loop
     nElementCount = 0;
+    #if ( DEBUGMANAGER_ENABLE_RING == ON )
+    while ( DebugManager_ReadRecord( &tRecord, &uLost ))
+    {
+      // output the buffer
+      SPRINTF_P( pcBuffer, pszFormat, tRecord.xId, tRecord.xArg );
+      AsciiCommandHandler_OutputBuffer( nCmdEnum );
+    #else
     for ( wBufIdx = 0; wBufIdx < wIndex; wBufIdx++ )
     {
       // output the buffer   
       SPRINTF_P( pcBuffer, pszFormat, atDbgEntries[ wBufIdx ].xArg1, atDbgEntries[ wBufIdx ].xArg2 );
       AsciiCommandHandler_OutputBuffer( nCmdEnum );
+    #endif // DEBUGMANAGER_ENABLE_RING
 
       // check for a new line
       if ( ++nElementCount == nElementSize )
@@ -224,12 +563,83 @@ void DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 )
     // new line
     AsciiCommandHandler_OutputString( nCmdEnum, ( PC8 )szNewLine );
     
+    #if ( DEBUGMANAGER_ENABLE_RING == OFF )
     // clear the index
     wIndex = 0;
+    #endif // DEBUGMANAGER_ENABLE_RING
       
     // return no error
     return( ASCCMD_STS_NONE );	
   }
+
+  #if ( DEBUGMANAGER_ENABLE_RING == ON )
+  /******************************************************************************
+   * @function CmdDrnRng
+   *
+   * @brief drain ring command handler
+   *
+   * This function drains up to the requested number of records, zero for all,
+   * one record per line for the host decoder
+   *
+   * @return  A
+   *****************************************************************************/
+  static ASCCMDSTS CmdDrnRng( U8 nCmdEnum )
+  {
+    U32UN     tTemp;
+    U32       uCount, uLost;
+    DBGRECORD tRecord;
+    PC8       pcBuffer;
+
+    // get the argument/buffer
+    AsciiCommandHandler_GetValue( nCmdEnum, 0, &tTemp.uValue );
+    AsciiCommandHandler_GetBuffer( nCmdEnum, &pcBuffer );
+    uCount = ( tTemp.uValue == 0 ) ? DEBUGMANAGER_RING_SIZE : tTemp.uValue;
+
+    // output each record
+    while (( uCount != 0 ) && ( DebugManager_ReadRecord( &tRecord, &uLost )))
+    {
+      // report any records lost before this one
+      if ( uLost != 0 )
+      {
+        SPRINTF_P( pcBuffer, ( PC8 )szFmtLost, uLost );
+        AsciiCommandHandler_OutputBuffer( nCmdEnum );
+      }
+
+      // output the record
+      SPRINTF_P( pcBuffer, ( PC8 )szFmtRec, tRecord.uSeq, tRecord.wDelta, tRecord.xId, tRecord.xArg );
+      AsciiCommandHandler_OutputBuffer( nCmdEnum );
+      uCount--;
+    }
+
+    // output the end marker
+    AsciiCommandHandler_OutputString( nCmdEnum, ( PC8 )szRngEnd );
+
+    // return no error
+    return( ASCCMD_STS_NONE );
+  }
+
+  /******************************************************************************
+   * @function CmdFrzRng
+   *
+   * @brief freeze ring command handler
+   *
+   * This function freezes the ring for a non zero argument, resumes it for
+   * zero
+   *
+   * @return  A
+   *****************************************************************************/
+  static ASCCMDSTS CmdFrzRng( U8 nCmdEnum )
+  {
+    U32UN tTemp;
+
+    // get the argument/set the state
+    AsciiCommandHandler_GetValue( nCmdEnum, 0, &tTemp.uValue );
+    DebugManager_Freeze(( tTemp.uValue != 0 ) ? TRUE : FALSE );
+
+    // return no error
+    return( ASCCMD_STS_NONE );
+  }
+  #endif // DEBUGMANAGER_ENABLE_RING
 #endif  // DEBUGMANAGER_ENABLE_DEBUG_COMMANDS
 
 /**@} EOF DebugManager.c */
@@ -39,6 +39,14 @@
 #endif  // DEBUGMANAGER_ENABLE_DEBUG_COMMANDS
 
 // Macros and Defines ---------------------------------------------------------
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+/// define the number of ring records/index mask
+#define DEBUGMANAGER_RING_SIZE        ( 1 << DEBUGMANAGER_RING_ORDER )
+#define DEBUGMANAGER_RING_MASK        ( DEBUGMANAGER_RING_SIZE - 1 )
+
+/// define the saturated time stamp delta
+#define DEBUGMANAGER_DELTA_MAX        ( 0xFFFF )
+#endif // DEBUGMANAGER_ENABLE_RING
 
 // enumerations ---------------------------------------------------------------
 /// enumerate the dump mode
@@ -64,6 +72,18 @@ typedef enum _DEBUGDUMPMODE
 	typedef	PU8		PDBGARG;
 #endif
 
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+/// define the trace ring record as read
+typedef struct _DBGRECORD
+{
+  U32     uSeq;         ///< record sequence
+  U16     wDelta;       ///< time since the previous record read, saturated
+  DBGARG  xId;          ///< module/event ID ( argument #1 )
+  DBGARG  xArg;         ///< argument ( argument #2 )
+} DBGRECORD, *PDBGRECORD;
+#define DBGRECORD_SIZE  sizeof( DBGRECORD )
+#endif // DEBUGMANAGER_ENABLE_RING
+
 // global parameter declarations -----------------------------------------------
 #if ( DEBUGMANAGER_ENABLE_DEBUG_COMMANDS == 1 )
   extern  const CODE ASCCMDENTRY g_atDebugManagerCmdHandlerTable[ ];
@@ -72,6 +92,10 @@ typedef enum _DEBUGDUMPMODE
 // global function prototypes --------------------------------------------------
 extern  BOOL  DebugManager_Initialize( void );
 extern  void  DebugManager_AddElement( DBGARG xArg1, DBGARG xArg2 );
+#if ( DEBUGMANAGER_ENABLE_RING == ON )
+extern  BOOL  DebugManager_ReadRecord( PDBGRECORD ptRecord, PU32 puLost );
+extern  void  DebugManager_Freeze( BOOL bFreeze );
+#endif // DEBUGMANAGER_ENABLE_RING
 
 /**@} EOF DebugManager.h */
 
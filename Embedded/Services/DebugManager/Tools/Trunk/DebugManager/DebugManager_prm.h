@@ -0,0 +1,82 @@
+/******************************************************************************
+ * @file DebugManager_prm.h
+ *
+ * @brief debug manager ring test parameters
+ *
+ * This file supplies the debug manager parameters for the ring test, the ring
+ * is enabled and time stamped from the host monotonic clock in microseconds
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup DebugManager
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _DEBUGMANAGER_PRM_H
+#define _DEBUGMANAGER_PRM_H
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the task argument size - valid values are 1, 2 or 4
+#define DEBUGMANAGER_ARGSIZE_BYTES              ( 2 )
+
+/// define the maximum number of debug entries
+#define DEBUGMANAGER_NUM_ENTRIES                ( 128 )
+
+/// define the macro to enable time stamps
+#define DEBUGMANAGER_ENABLE_TIMESTAMP           ( OFF )
+
+/// define the macro to enable debug commands
+#define DEBUGMANAGER_ENABLE_DEBUG_COMMANDS      ( OFF )
+
+/// define the macro to enable the wraparound trace ring
+#define DEBUGMANAGER_ENABLE_RING                ( ON )
+
+/// define the ring order, the number of records is 2^order ( 1 to 12 )
+#define DEBUGMANAGER_RING_ORDER                 ( 10 )
+
+/// define the macro to get the free running record time stamp
+extern  U32 DebugManagerRingTest_GetTime( void );
+#define DEBUGMANAGER_RING_GETTIME( )            DebugManagerRingTest_GetTime( )
+
+/// define the macro to use the critical section fallback, set on the command line to test it
+#ifndef DEBUGMANAGER_RING_USE_CRITICAL
+#define DEBUGMANAGER_RING_USE_CRITICAL          ( OFF )
+#endif
+
+#if ( DEBUGMANAGER_RING_USE_CRITICAL == ON )
+/// define the critical section as a host lock
+extern  void  DebugManagerRingTest_Lock( void );
+extern  void  DebugManagerRingTest_Unlock( void );
+#define DEBUGMANAGER_RING_CRITICAL_ENTER( s )   { s = 0; DebugManagerRingTest_Lock( ); }
+#define DEBUGMANAGER_RING_CRITICAL_EXIT( s )    { ( void )s; DebugManagerRingTest_Unlock( ); }
+#else
+/// define the atomic read/modify/writes
+#define DEBUGMANAGER_RING_FETCHADD( p, v )      __atomic_fetch_add( p, v, __ATOMIC_RELEASE )
+#define DEBUGMANAGER_RING_EXCHANGE( p, v )      __atomic_exchange_n( p, v, __ATOMIC_ACQ_REL )
+#define DEBUGMANAGER_RING_CAS( p, pe, v )       __atomic_compare_exchange_n( p, pe, v, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE )
+#endif // DEBUGMANAGER_RING_USE_CRITICAL
+
+/// define the atomic loads/stores/fence
+#define DEBUGMANAGER_RING_LOAD( p )             __atomic_load_n( p, __ATOMIC_ACQUIRE )
+#define DEBUGMANAGER_RING_STORE( p, v )         __atomic_store_n( p, v, __ATOMIC_RELEASE )
+#define DEBUGMANAGER_RING_FENCE( )              __atomic_thread_fence( __ATOMIC_ACQ_REL )
+
+/**@} EOF DebugManager_prm.h */
+
+#endif  // _DEBUGMANAGER_PRM_H
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * @file DebugManagerDecode.c
+ *
+ * @brief debug manager trace ring decoder
+ *
+ * This file provides a host tool that decodes a capture of the DRNG command
+ * output.  Each record line holds the sequence, the time stamp delta, the ID
+ * and the argument in hex.  The decoder rebuilds the time of each record from
+ * the deltas, splits the ID into the module base and event, and marks the
+ * records lost to an overrun and the deltas that saturated, after which the
+ * times are a lower bound.  It ends with a count of the records per module.
+ * Lines that are not records are ignored so a raw terminal log can be fed in.
+ *
+ * build with: cc -O2 -o DebugManagerDecode DebugManagerDecode.c
+ * usage:      DebugManagerDecode [capture file]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup DebugManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Macros and Defines ---------------------------------------------------------
+/// define the saturated delta
+#define DELTA_MAX                                   ( 0xFFFF )
+
+/// define the number of modules, the high byte of the ID
+#define NUM_MODULES                                 ( 256 )
+
+/// define the line size
+#define LINE_SIZE                                   ( 256 )
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will decode each line of the capture
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for success, 1 for errors
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  FILE*               ptFile = stdin;
+  char                acLine[ LINE_SIZE ];
+  unsigned int        uSeq, uDelta, uId, uArg, uLost;
+  unsigned int        uExpSeq = 0, uGapLost = 0;
+  unsigned long       auModCounts[ NUM_MODULES ] = { 0 };
+  unsigned long long  ullTime = 0;
+  unsigned long       ulRecords = 0, ulLost = 0;
+  int                 iFirst = 1, iSaturated = 0, iModule;
+
+  // open the capture
+  if (( iArgc > 1 ) && (( ptFile = fopen( ppszArgv[ 1 ], "r" )) == NULL ))
+  {
+    fprintf( stderr, "unable to open %s\n", ppszArgv[ 1 ] );
+    return( 1 );
+  }
+
+  // for each line
+  printf( "%12s %8s %8s %6s %6s %10s\n", "time", "delta", "seq", "module", "event", "argument" );
+  while ( fgets( acLine, sizeof( acLine ), ptFile ) != NULL )
+  {
+    // lost count reported by the ring
+    if ( sscanf( acLine, "L %u", &uLost ) == 1 )
+    {
+      printf( "---- %u records lost ----\n", uLost );
+      ulLost += uLost;
+      uGapLost += uLost;
+    }
+    else if ( sscanf( acLine, "R %x %x %x %x", &uSeq, &uDelta, &uId, &uArg ) == 4 )
+    {
+      // check for a gap the ring did not report, a drain split over captures
+      if (( !iFirst ) && (( uSeq - uExpSeq ) > uGapLost ))
+      {
+        printf( "---- sequence gap of %u ----\n", uSeq - uExpSeq - uGapLost );
+      }
+      iFirst = 0;
+      uExpSeq = uSeq + 1;
+      uGapLost = 0;
+
+      // accumulate the time
+      ullTime += uDelta;
+      iSaturated |= ( uDelta == DELTA_MAX );
+
+      // output the record
+      printf( "%c%11llu %c%7u %8X %6X %6X %10X\n", ( iSaturated ) ? '>' : ' ', ullTime, ( uDelta == DELTA_MAX ) ? '>' : '+', uDelta,
+              uSeq, uId >> 8, uId & 0xFF, uArg );
+
+      // count it
+      iModule = ( uId >> 8 ) & ( NUM_MODULES - 1 );
+      auModCounts[ iModule ]++;
+      ulRecords++;
+    }
+  }
+
+  // close the capture
+  if ( ptFile != stdin )
+  {
+    fclose( ptFile );
+  }
+
+  // summary
+  printf( "\n%lu records, %lu lost, span %s%llu\n", ulRecords, ulLost, ( iSaturated ) ? ">" : "", ullTime );
+  for ( iModule = 0; iModule < NUM_MODULES; iModule++ )
+  {
+    if ( auModCounts[ iModule ] != 0 )
+    {
+      printf( "  module %02X: %lu\n", iModule, auModCounts[ iModule ] );
+    }
+  }
+
+  // return ok
+  return( 0 );
+}
+
+/**@} EOF DebugManagerDecode.c */
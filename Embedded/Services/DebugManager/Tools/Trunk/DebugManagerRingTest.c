@@ -0,0 +1,481 @@
+/******************************************************************************
+ * @file DebugManagerRingTest.c
+ *
+ * @brief debug manager trace ring test
+ *
+ * This file provides a host tool that hammers the debug manager trace ring
+ * from several writer threads while a reader thread drains it.  Each writer
+ * logs an ID holding its thread number and the low byte of its count, with
+ * the count as the argument, so the reader can check that no record is torn,
+ * that each thread's records follow on between losses and that the records read
+ * plus those reported lost add up to the records written.  It also checks
+ * the freeze, times a single writer and the contended writers, and with the
+ * capture argument prints a drain in the DRNG command format for the
+ * decoder.  It exits non zero on any failure.  Adding
+ * -DDEBUGMANAGER_RING_USE_CRITICAL=1 builds the critical section fallback
+ * with a host lock standing in for the interrupt mask.
+ *
+ * build with: cc -O2 -pthread -I. -I<include root> -o DebugManagerRingTest
+ *             DebugManagerRingTest.c ../../Core/Trunk/DebugManager.c
+ * usage:      DebugManagerRingTest [capture]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup DebugManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+// local includes -------------------------------------------------------------
+#include "DebugManager/DebugManager.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of writer threads/records per writer
+#define NUM_WRITERS                                 ( 4 )
+#define RECORDS_PER_WRITER                          ( 2000000 )
+
+/// define the number of single writer timing records
+#define TIMING_RECORDS                              ( 10000000 )
+
+/// define the ID base for the writers
+#define WRITER_ID_BASE                              ( 0x1000 )
+
+/// define the number of capture records
+#define CAPTURE_RECORDS                             ( 40 )
+
+// structures -----------------------------------------------------------------
+/// define the writer control
+typedef struct _WRITER
+{
+  pthread_t tThread;          ///< thread
+  U16       wNumber;          ///< writer number
+} WRITER;
+
+// local parameter declarations -----------------------------------------------
+static  WRITER        atWriters[ NUM_WRITERS ];
+static  volatile int  iWritersDone;
+static  U32           auLastCount[ NUM_WRITERS ];
+static  BOOL          abSeen[ NUM_WRITERS ];
+static  U32           uNumRead;
+static  U32           uNumLost;
+static  U32           uNumErrors;
+static  pthread_mutex_t tLock = PTHREAD_MUTEX_INITIALIZER;
+
+// local function prototypes --------------------------------------------------
+static  void*   Writer( void* pvArg );
+static  void    CheckRecord( PDBGRECORD ptRecord );
+static  int     RunHammer( void );
+static  int     RunFreeze( void );
+static  void    RunTiming( void );
+static  void    RunCapture( void );
+static  double  ElapsedNsecs( struct timespec* ptStart );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check or the capture
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int iErrors;
+
+  // check for capture
+  if (( iArgc > 1 ) && ( strcmp( ppszArgv[ 1 ], "capture" ) == 0 ))
+  {
+    RunCapture( );
+    return( 0 );
+  }
+
+  // run the checks
+  printf( "ring %d records of %d bytes, %d writers x %d records\n", DEBUGMANAGER_RING_SIZE, ( int )DBGRECORD_SIZE, NUM_WRITERS, RECORDS_PER_WRITER );
+  iErrors = RunHammer( );
+  iErrors += RunFreeze( );
+  RunTiming( );
+
+  // report
+  printf( "%s\n", ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function DebugManagerRingTest_GetTime
+ *
+ * @brief get the time stamp
+ *
+ * This function returns the monotonic clock in microseconds
+ *
+ * @return      time in microseconds
+ *
+ *****************************************************************************/
+U32 DebugManagerRingTest_GetTime( void )
+{
+  struct timespec tNow;
+
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tNow );
+  return(( U32 )(( tNow.tv_sec * 1000000ULL ) + ( tNow.tv_nsec / 1000 )));
+}
+
+/******************************************************************************
+ * @function DebugManagerRingTest_Lock
+ *
+ * @brief lock
+ *
+ * This function enters the critical section for the fallback build
+ *
+ *****************************************************************************/
+void DebugManagerRingTest_Lock( void )
+{
+  pthread_mutex_lock( &tLock );
+}
+
+/******************************************************************************
+ * @function DebugManagerRingTest_Unlock
+ *
+ * @brief unlock
+ *
+ * This function exits the critical section for the fallback build
+ *
+ *****************************************************************************/
+void DebugManagerRingTest_Unlock( void )
+{
+  pthread_mutex_unlock( &tLock );
+}
+
+/******************************************************************************
+ * @function Writer
+ *
+ * @brief writer thread
+ *
+ * This function logs its records as fast as it can
+ *
+ * @param[in]   pvArg       pointer to the writer
+ *
+ * @return      NULL
+ *
+ *****************************************************************************/
+static void* Writer( void* pvArg )
+{
+  WRITER* ptWriter = ( WRITER* )pvArg;
+  U32     uCount;
+
+  // log each record
+  for ( uCount = 1; uCount <= RECORDS_PER_WRITER; uCount++ )
+  {
+    DebugManager_AddElement( WRITER_ID_BASE | ( ptWriter->wNumber << 8 ) | ( uCount & 0xFF ), ( DBGARG )uCount );
+  }
+
+  // flag done
+  __atomic_fetch_add( &iWritersDone, 1, __ATOMIC_RELEASE );
+  return( NULL );
+}
+
+/******************************************************************************
+ * @function CheckRecord
+ *
+ * @brief check a record
+ *
+ * This function checks the ID matches the argument and that the count for
+ * the writer follows on from its previous record
+ *
+ * @param[in]   ptRecord    pointer to the record
+ *
+ *****************************************************************************/
+static void CheckRecord( PDBGRECORD ptRecord )
+{
+  U16 wWriter, wDiff;
+
+  // check the ID
+  wWriter = ( ptRecord->xId >> 8 ) & 0x0F;
+  if ((( ptRecord->xId & 0xF000 ) != WRITER_ID_BASE ) || ( wWriter >= NUM_WRITERS ) || (( ptRecord->xId & 0xFF ) != ( ptRecord->xArg & 0xFF )))
+  {
+    if ( uNumErrors++ < 5 )
+    {
+      printf( "  torn record %04X %04X\n", ptRecord->xId, ptRecord->xArg );
+    }
+  }
+  else
+  {
+    // with nothing lost the next count must follow on
+    wDiff = ( U16 )( ptRecord->xArg - auLastCount[ wWriter ] );
+    if ( abSeen[ wWriter ] && ( wDiff != 1 ))
+    {
+      if ( uNumErrors++ < 5 )
+      {
+        printf( "  writer %d out of order %04X after %04X\n", wWriter, ptRecord->xArg, auLastCount[ wWriter ] );
+      }
+    }
+    auLastCount[ wWriter ] = ptRecord->xArg;
+    abSeen[ wWriter ] = TRUE;
+  }
+}
+
+/******************************************************************************
+ * @function RunHammer
+ *
+ * @brief run the hammer check
+ *
+ * This function starts the writers and drains the ring until they finish
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunHammer( void )
+{
+  DBGRECORD       tRecord;
+  U32             uExpSeq = 0;
+  U32             uLost;
+  U32             uIdx, uRemaining = 0;
+  BOOL            bDone = FALSE;
+  struct timespec tStart;
+  double          dNsecs;
+
+  // initialize/start the writers
+  DebugManager_Initialize( );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( uIdx = 0; uIdx < NUM_WRITERS; uIdx++ )
+  {
+    atWriters[ uIdx ].wNumber = uIdx;
+    pthread_create( &atWriters[ uIdx ].tThread, NULL, Writer, &atWriters[ uIdx ] );
+  }
+
+  // drain until the writers are done and the ring is empty
+  while ( !bDone )
+  {
+    // check for done before the last drain
+    bDone = ( __atomic_load_n( &iWritersDone, __ATOMIC_ACQUIRE ) == NUM_WRITERS );
+    while ( DebugManager_ReadRecord( &tRecord, &uLost ))
+    {
+      // check the sequence gap is covered by the lost records, dropped ones never took an index
+      if (( tRecord.uSeq - uExpSeq ) > uLost )
+      {
+        if ( uNumErrors++ < 5 )
+        {
+          printf( "  sequence %08X, expected %08X + %u lost\n", tRecord.uSeq, uExpSeq, uLost );
+        }
+      }
+      uExpSeq = tRecord.uSeq + 1;
+      uNumLost += uLost;
+
+      // restart the order checks after a loss
+      if ( uLost != 0 )
+      {
+        memset( abSeen, 0, sizeof( abSeen ));
+      }
+      uNumRead++;
+      CheckRecord( &tRecord );
+    }
+  }
+  dNsecs = ElapsedNsecs( &tStart );
+
+  // join the writers/check nothing is left
+  for ( uIdx = 0; uIdx < NUM_WRITERS; uIdx++ )
+  {
+    pthread_join( atWriters[ uIdx ].tThread, NULL );
+  }
+  while ( DebugManager_ReadRecord( &tRecord, &uLost ))
+  {
+    uRemaining++;
+  }
+
+  // check the totals
+  if (( uNumRead + uNumLost ) != ( NUM_WRITERS * RECORDS_PER_WRITER ))
+  {
+    printf( "  read %u + lost %u != written %u\n", uNumRead, uNumLost, NUM_WRITERS * RECORDS_PER_WRITER );
+    uNumErrors++;
+  }
+  if ( uRemaining != 0 )
+  {
+    printf( "  %u records left after the drain\n", uRemaining );
+    uNumErrors++;
+  }
+
+  // report
+  printf( "hammer: read %u, lost %u, %u errors, %.1f nsecs per record\n", uNumRead, uNumLost, uNumErrors,
+          dNsecs / ( NUM_WRITERS * RECORDS_PER_WRITER ));
+  return( uNumErrors );
+}
+
+/******************************************************************************
+ * @function RunFreeze
+ *
+ * @brief run the freeze check
+ *
+ * This function fills the ring, freezes it, adds more and checks the drain
+ * holds the records written before the freeze
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunFreeze( void )
+{
+  int       iErrors = 0;
+  DBGRECORD tRecord;
+  U16       wLast = 0;
+  U32       uLost;
+  U32       uIdx, uTotalLost = 0, uRead = 0;
+
+  // fill twice over, freeze, then add records that must be dropped
+  DebugManager_Initialize( );
+  for ( uIdx = 1; uIdx <= ( DEBUGMANAGER_RING_SIZE * 2 ); uIdx++ )
+  {
+    DebugManager_AddElement( 0x2000, ( DBGARG )uIdx );
+  }
+  DebugManager_Freeze( TRUE );
+  for ( uIdx = 0; uIdx < 100; uIdx++ )
+  {
+    DebugManager_AddElement( 0x3000, ( DBGARG )uIdx );
+  }
+
+  // drain
+  while ( DebugManager_ReadRecord( &tRecord, &uLost ))
+  {
+    uTotalLost += uLost;
+    uRead++;
+    wLast = tRecord.xArg;
+    iErrors += ( tRecord.xId != 0x2000 );
+  }
+  DebugManager_Freeze( FALSE );
+
+  // the ring holds the newest records up to the freeze
+  if (( uRead != DEBUGMANAGER_RING_SIZE ) || ( uTotalLost != DEBUGMANAGER_RING_SIZE ) || ( wLast != ( DEBUGMANAGER_RING_SIZE * 2 )))
+  {
+    iErrors++;
+  }
+
+  // report
+  printf( "freeze: read %u, lost %u, last %u, %d errors\n", uRead, uTotalLost, wLast, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunTiming
+ *
+ * @brief run the timing
+ *
+ * This function times a single writer with no reader and the time stamp
+ * on its own
+ *
+ *****************************************************************************/
+static void RunTiming( void )
+{
+  struct timespec tStart;
+  U32             uIdx;
+  volatile U32    uTime;
+  double          dNsecs, dClock;
+
+  // time the time stamp on its own
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( uIdx = 0; uIdx < TIMING_RECORDS; uIdx++ )
+  {
+    uTime = DebugManagerRingTest_GetTime( );
+  }
+  dClock = ElapsedNsecs( &tStart );
+  ( void )uTime;
+
+  // time the writer
+  DebugManager_Initialize( );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( uIdx = 0; uIdx < TIMING_RECORDS; uIdx++ )
+  {
+    DebugManager_AddElement( 0x4000, ( DBGARG )uIdx );
+  }
+  dNsecs = ElapsedNsecs( &tStart );
+
+  // report
+  printf( "single writer: %.1f nsecs per record, %.1f of it the time stamp\n", dNsecs / TIMING_RECORDS, dClock / TIMING_RECORDS );
+}
+
+/******************************************************************************
+ * @function RunCapture
+ *
+ * @brief run the capture
+ *
+ * This function logs a short sequence with a few pauses, overflows the ring
+ * part way through and prints the drain in the DRNG command format
+ *
+ *****************************************************************************/
+static void RunCapture( void )
+{
+  DBGRECORD       tRecord;
+  U32             uLost;
+  U32             uIdx;
+  struct timespec tPause = { 0, 2000000 };
+
+  // log a short run, then overflow the ring and log a few more with pauses
+  DebugManager_Initialize( );
+  for ( uIdx = 0; uIdx < CAPTURE_RECORDS; uIdx++ )
+  {
+    DebugManager_AddElement( 0x7000 | ( uIdx & 7 ), ( DBGARG )uIdx );
+  }
+  for ( uIdx = 0; uIdx < ( DEBUGMANAGER_RING_SIZE - 8 ); uIdx++ )
+  {
+    DebugManager_AddElement( 0x7100, ( DBGARG )uIdx );
+  }
+  for ( uIdx = 0; uIdx < 8; uIdx++ )
+  {
+    nanosleep( &tPause, NULL );
+    DebugManager_AddElement( 0x2100 | uIdx, ( DBGARG )( uIdx * 3 ));
+  }
+  DebugManager_AddElement( 0xFF00, 0xBEEF );
+  DebugManager_AddElement( 0xFF01, 0xDEAD );
+  DebugManager_Freeze( TRUE );
+
+  // drain
+  while ( DebugManager_ReadRecord( &tRecord, &uLost ))
+  {
+    if ( uLost != 0 )
+    {
+      printf( "L %u\n", uLost );
+    }
+    printf( "R %08X %04X %04X %04X\n", tRecord.uSeq, tRecord.wDelta, tRecord.xId, tRecord.xArg );
+  }
+  printf( "E\n" );
+}
+
+/******************************************************************************
+ * @function ElapsedNsecs
+ *
+ * @brief get the elapsed time
+ *
+ * This function will return the nanoseconds since the start time
+ *
+ * @param[in]   ptStart     pointer to the start time
+ *
+ * @return      elapsed nanoseconds
+ *
+ *****************************************************************************/
+static double ElapsedNsecs( struct timespec* ptStart )
+{
+  struct timespec tStop;
+
+  // get the stop time
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+  return((( tStop.tv_sec - ptStart->tv_sec ) * 1e9 ) + ( tStop.tv_nsec - ptStart->tv_nsec ));
+}
+
+/**@} EOF DebugManagerRingTest.c */
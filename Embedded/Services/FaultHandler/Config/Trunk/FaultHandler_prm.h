@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file FaultHandler_prm.h
+ *
+ * @brief fault handler parameter declarations 
+ *
+ * This file provides the parameter declarations for the fault handler
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup FaultHandler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _FAULTHANDLER_PRM_H
+#define _FAULTHANDLER_PRM_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to record the fault and freeze the debug trace ring
+#define FAULTHANDLER_ENABLE_DEBUGFREEZE           ( OFF )
+
+#if ( FAULTHANDLER_ENABLE_DEBUGFREEZE == ON )
+/// define the debug ID used to record the fault
+#define FAULTHANDLER_DEBUG_BASE                   ( 0xFF00 )
+#endif // FAULTHANDLER_ENABLE_DEBUGFREEZE
+
+/**@} EOF FaultHandler_prm.h */
+
+#endif  // _FAULTHANDLER_PRM_H
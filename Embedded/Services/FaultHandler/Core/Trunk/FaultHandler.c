@@ -27,6 +27,9 @@
 #include "FaultHandler/FaultHandler.h"
 
 // library includes -----------------------------------------------------------
+#if ( FAULTHANDLER_ENABLE_DEBUGFREEZE == ON )
+#include "DebugManager/DebugManager.h"
+#endif // FAULTHANDLER_ENABLE_DEBUGFREEZE
 
 // Macros and Defines ---------------------------------------------------------
 /// define the on/off times
@@ -89,6 +92,13 @@ void FaultHandler_Display( U32 uFault )
   U16         wDelayMsecs;
   BOOL        bGpioState;
 
+  #if ( FAULTHANDLER_ENABLE_DEBUGFREEZE == ON )
+  // record the fault and freeze the trace so it ends at the fault
+  DebugManager_AddElement( FAULTHANDLER_DEBUG_BASE | 0x00, ( DBGARG )( uFault & 0xFFFF ));
+  DebugManager_AddElement( FAULTHANDLER_DEBUG_BASE | 0x01, ( DBGARG )(( uFault >> 16 ) & 0xFFFF ));
+  DebugManager_Freeze( TRUE );
+  #endif // FAULTHANDLER_ENABLE_DEBUGFREEZE
+
   // configure the fault GPIO
   FaultHandler_GpioConfigure( );
 
@@ -29,6 +29,7 @@
 
 // local includes -------------------------------------------------------------
 #include "FaultHandler/FaultHandler_cfg.h"
+#include "FaultHandler/FaultHandler_prm.h"
 
 // library includes -----------------------------------------------------------
 
@@ -27,6 +27,12 @@
 #include "FlashFileManager/FlashFileManager_cfg.h"
 
 // library includes -----------------------------------------------------------
+#if ( FLASHFILEMANAGER_BACKEND == FLASHFILEMANAGER_BACKEND_MMAP )
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif // FLASHFILEMANAGER_BACKEND
 
 // Macros and Defines ---------------------------------------------------------
 
@@ -37,13 +43,66 @@
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+#if ( FLASHFILEMANAGER_BACKEND == FLASHFILEMANAGER_BACKEND_MMAP )
+  static  PU8   pnImage;
+  static  U32   uImageSize;
+#endif // FLASHFILEMANAGER_BACKEND
 
 // local function prototypes --------------------------------------------------
 
 // constant parameter initializations -----------------------------------------
 
 /******************************************************************************
- * @function FlashFileManager_ReadBlock
+ * @function FlashFileManager_LocalInitialize
+ *
+ * @brief flash file manager local initialization
+ *
+ * This function will perform any local initialization, the mmap backend
+ * maps the image file here
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL FlashFileManager_LocalInitialize( void )
+{
+  BOOL        bStatus = FALSE;
+  #if ( FLASHFILEMANAGER_BACKEND == FLASHFILEMANAGER_BACKEND_MMAP )
+  int         iFd;
+  struct stat tStat;
+
+  // open the image/get its size
+  pnImage = NULL;
+  uImageSize = 0;
+  if (( iFd = open( FLASHFILEMANAGER_MMAP_IMAGE_NAME, O_RDONLY )) >= 0 )
+  {
+    if (( fstat( iFd, &tStat ) == 0 ) && ( tStat.st_size != 0 ))
+    {
+      // map it
+      pnImage = ( PU8 )mmap( NULL, tStat.st_size, PROT_READ, MAP_SHARED, iFd, 0 );
+      if ( pnImage == ( PU8 )MAP_FAILED )
+      {
+        pnImage = NULL;
+      }
+      else
+      {
+        uImageSize = ( U32 )tStat.st_size;
+      }
+    }
+
+    // the mapping stays valid after the close
+    close( iFd );
+  }
+
+  // set the status
+  bStatus = ( pnImage == NULL ) ? TRUE : FALSE;
+  #endif // FLASHFILEMANAGER_BACKEND
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_LocalReadBlock
  *
  * @brief flash file manager read a block
  *
@@ -54,8 +113,45 @@
  * @param[in]  	wBufLength	length to read
  *
  *****************************************************************************/
-void FlashFileManager_ReadBlock( U32 uAddress, PU8 pnBuffer, U16 wBufLength )
+void FlashFileManager_LocalReadBlock( U32 uAddress, PU8 pnBuffer, U16 wBufLength )
 {
+  #if ( FLASHFILEMANAGER_BACKEND == FLASHFILEMANAGER_BACKEND_MMAP )
+  // copy from the mapping, erased flash beyond the image
+  memset( pnBuffer, 0xFF, wBufLength );
+  if ( uAddress < uImageSize )
+  {
+    memcpy( pnBuffer, pnImage + uAddress, MIN( wBufLength, uImageSize - uAddress ));
+  }
+  #endif // FLASHFILEMANAGER_BACKEND
+}
+
+/******************************************************************************
+ * @function FlashFileManager_LocalGetPointer
+ *
+ * @brief get a pointer to the image
+ *
+ * This function will return a pointer to an address in the image if the
+ * image is memory mapped
+ *
+ * @param[in]   uAddress		address of data
+ *
+ * @return      pointer to the data or NULL if not mapped
+ *
+ *****************************************************************************/
+PU8 FlashFileManager_LocalGetPointer( U32 uAddress )
+{
+  PU8 pnData = NULL;
+
+  #if ( FLASHFILEMANAGER_BACKEND == FLASHFILEMANAGER_BACKEND_MMAP )
+  // return the pointer into the mapping
+  if ( uAddress < uImageSize )
+  {
+    pnData = pnImage + uAddress;
+  }
+  #endif // FLASHFILEMANAGER_BACKEND
+
+  // return the pointer
+  return( pnData );
 }
 
 /**@} EOF FlashFileManager_cfg.c */
@@ -29,6 +29,7 @@
 #include "Types/Types.h"
 
 // local includes -------------------------------------------------------------
+#include "FlashFileManager/FlashFileManager_prm.h"
 
 // library includes -----------------------------------------------------------
 
@@ -41,7 +42,9 @@
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
-extern	void	FlashFileManager_ReadBlock( U32 uAddress, PU8 pnBuffer, U16 wBufLength );
+extern  BOOL  FlashFileManager_LocalInitialize( void );
+extern	void	FlashFileManager_LocalReadBlock( U32 uAddress, PU8 pnBuffer, U16 wBufLength );
+extern  PU8   FlashFileManager_LocalGetPointer( U32 uAddress );
 
 /**@} EOF FlashFileManager_cfg.h */
 
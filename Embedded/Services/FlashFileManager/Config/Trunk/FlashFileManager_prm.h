@@ -0,0 +1,69 @@
+/******************************************************************************
+ * @file FlashFileManager_prm.h
+ *
+ * @brief flash file manager parameter declarations
+ *
+ * This file declares any customization for the flash file manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup FlashFileManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _FLASHFILEMANAGER_PRM_H
+#define _FLASHFILEMANAGER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the maximum number of open files
+#define FLASHFILEMANAGER_MAX_FILE_HANDLES           ( 4 )
+
+/// define the address of the image in the flash
+#define FLASHFILEMANAGER_IMAGE_BASE_ADDR            ( 0 )
+
+/// define the backend selections
+#define FLASHFILEMANAGER_BACKEND_FLASH              ( 0 )
+#define FLASHFILEMANAGER_BACKEND_MMAP               ( 1 )
+
+/// set the macro below to one of the above backends, the mmap backend maps
+/// an image file on Linux and allows zero-copy reads
+#define FLASHFILEMANAGER_BACKEND                    ( FLASHFILEMANAGER_BACKEND_FLASH )
+
+/// define the image file name for the mmap backend
+#define FLASHFILEMANAGER_MMAP_IMAGE_NAME            ( "flashfiles.img" )
+
+/// define the macro to enable the zstd decompression of compressed files
+#define FLASHFILEMANAGER_ENABLE_COMPRESSION         ( OFF )
+
+/// define the maximum window log accepted by the decoder, this must match
+/// the window log the image builder compresses with ( 10 is the smallest )
+#define FLASHFILEMANAGER_DECOMP_WINDOWLOG           ( 10 )
+
+/// define the size of the static decoder workspace, the decoder context
+/// includes a fixed 128K literal buffer so this is dominated by that and not
+/// by the window size
+#define FLASHFILEMANAGER_DECOMP_WORKSIZE            ( 164 * 1024 )
+
+/// define the number of decoders, open compressed files share these
+#define FLASHFILEMANAGER_NUM_DECODERS               ( 1 )
+
+/// define the size of the compressed input buffer for non-mapped backends
+#define FLASHFILEMANAGER_DECOMP_INBUF_SIZE          ( 256 )
+
+/**@} EOF FlashFileManager_prm.h */
+
+#endif  // _FLASHFILEMANAGER_PRM_H
@@ -25,47 +25,68 @@
 
 // local includes -------------------------------------------------------------
 #include "FlashFileManager/FlashFileManager.h"
+#include "FlashFileManager/FlashFileManager_def.h"
 
 // library includes -----------------------------------------------------------
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+  #define ZSTD_STATIC_LINKING_ONLY
+  #include "Ztp/zstd.h"
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
 
 // Macros and Defines ---------------------------------------------------------
 
-/// define the maximum number of open files
-#define	MAX_FILE_HANDLES                                            ( 4 )
-
-/// define the size of the h
-
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
-/// define the flash file entry structure
-typedef struct _FLASHFILEENTRY
-{
-  U32 uEntrySize;
-  U32 uFileSizeSize;
-  U32 uEntryOffset;
-  U16 wNameLength;
-} FLASHFILEENTRY, *PFLASHFILEENTRY;
-#define	FLASHFILEENTRY_SIZE                         sizeof( FLASHFILEENTRY )
-
 /// define the local control structure
 typedef struct _LCLCTL
 {
   BOOL  bInUse;                       ///< in use
+  BOOL  bRaw;                         ///< read the stored data as is
+  U16   wFlags;                       ///< file flags
   U32   uFileLength;                  ///< file length
+  U32   uDataLength;                  ///< length of the stored data
   U32   uBaseAddress;                 ///< base address of file
   U32   uCurOffset;                   ///< current offset
 } LCLCTL, *PLCLCTL;
 #define	LCLCTL_SIZE                                 sizeof( LCLCTL )
 
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+/// define the decoder control structure
+typedef struct _DECCTL
+{
+  ZSTD_DStream* ptStream;             ///< decoder stream
+  S16           iOwner;               ///< handle that owns the decoder, -1 if none
+  U32           uSrcOffset;           ///< offset into the stored data
+  U32           uDecOffset;           ///< offset into the decompressed data
+} DECCTL, *PDECCTL;
+#define DECCTL_SIZE                                 sizeof( DECCTL )
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
-static  LCLCTL  atLclCtls[ MAX_FILE_HANDLES ];
-static  C8      acCurFileName[ FLASHFILE_MAX_FILE_NAME ];
+static  LCLCTL          atLclCtls[ FLASHFILEMANAGER_MAX_FILE_HANDLES ];
+static  C8              acCurFileName[ FLASHFILE_MAX_FILE_NAME ];
+static  FLASHFILEHEADER tHeader;
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+static  DECCTL          atDecCtls[ FLASHFILEMANAGER_NUM_DECODERS ];
+static  U8              anDecWorkspace[ FLASHFILEMANAGER_NUM_DECODERS ][ FLASHFILEMANAGER_DECOMP_WORKSIZE ] ALIGNED8;
+static  U8              anDecInBuf[ FLASHFILEMANAGER_DECOMP_INBUF_SIZE ];
+static  U8              nNextDecoder;
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
 
 // local function prototypes --------------------------------------------------
-static  S16 FindEmptyControl( void );
+static  S16     FindEmptyControl( void );
+static  PLCLCTL GetControl( FLASHFILEHANDLE tHandle );
+static  U32     ComputeHash( PC8 pszFileName, PU16 pwLength );
+static  void    ReadEntry( U16 wIndex, PFLASHFILEENTRY ptEntry );
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+static  FLASHFILEERROR  ReadCompressed( FLASHFILEHANDLE tHandle, PLCLCTL ptLclCtl, PU8 pnBuffer, U32 uLength, PU32 puBytesRead );
+static  FLASHFILEERROR  Decode( PLCLCTL ptLclCtl, PDECCTL ptDecCtl, PU8 pnBuffer, U32 uLength, PU32 puBytesOut );
+static  PDECCTL         GetDecoder( FLASHFILEHANDLE tHandle );
+static  void            ReleaseDecoder( FLASHFILEHANDLE tHandle );
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
 
 // constant parameter initializations -----------------------------------------
 
@@ -74,13 +95,52 @@ static  S16 FindEmptyControl( void );
  *
  * @brief file manager initialization
  *
- * This function will perform any needed initialization
+ * This function will perform any needed initialization and validate the
+ * image header, the static decoders are created here if enabled
+ *
+ * @return      TRUE if errors, FALSE if OK
  *
  *****************************************************************************/
-void FlashFileManager_Initialize( void )
+BOOL FlashFileManager_Initialize( void )
 {
+  BOOL  bStatus;
+  #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+  U8    nDecIdx;
+  #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
   // clear all controls
-  memset( atLclCtls, 0, ( LCLCTL_SIZE * MAX_FILE_HANDLES ));
+  memset( atLclCtls, 0, ( LCLCTL_SIZE * FLASHFILEMANAGER_MAX_FILE_HANDLES ));
+
+  #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+  // create the decoders in their static workspaces
+  nNextDecoder = 0;
+  for ( nDecIdx = 0; nDecIdx < FLASHFILEMANAGER_NUM_DECODERS; nDecIdx++ )
+  {
+    atDecCtls[ nDecIdx ].iOwner = -1;
+    if (( atDecCtls[ nDecIdx ].ptStream = ZSTD_initStaticDStream( anDecWorkspace[ nDecIdx ], FLASHFILEMANAGER_DECOMP_WORKSIZE )) != NULL )
+    {
+      // limit the window to what the workspace was sized for
+      ZSTD_DCtx_setParameter( atDecCtls[ nDecIdx ].ptStream, ZSTD_d_windowLogMax, FLASHFILEMANAGER_DECOMP_WINDOWLOG );
+    }
+  }
+  #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
+  // perform the local initialization/read the header
+  if (( bStatus = FlashFileManager_LocalInitialize( )) == FALSE )
+  {
+    FlashFileManager_LocalReadBlock( FLASHFILEMANAGER_IMAGE_BASE_ADDR, ( PU8 )&tHeader, FLASHFILEHEADER_SIZE );
+  }
+
+  // validate the header
+  if (( bStatus ) || ( tHeader.uMagic != FLASHFILEIMAGE_MAGIC ) || ( tHeader.wVersion != FLASHFILEIMAGE_VERSION ))
+  {
+    // no files
+    memset( &tHeader, 0, FLASHFILEHEADER_SIZE );
+    bStatus = TRUE;
+  }
+
+  // return the status
+  return( bStatus );
 }
 
 /******************************************************************************
@@ -88,7 +148,10 @@ void FlashFileManager_Initialize( void )
  *
  * @brief find a file
  *
- * This function will search for a file and return the approprite file handle
+ * This function will search for a file and return the approprite file handle.
+ * The directory is sorted by name hash, so the first entry with the hash is
+ * found with a binary search and the names are only compared for entries
+ * with a matching hash
  *
  * @param[in]   pszFileName pointer to the file name to open
  *
@@ -98,25 +161,52 @@ void FlashFileManager_Initialize( void )
 FLASHFILEHANDLE	FlashFileManager_Find( PC8 pszFileName )
 {
   FLASHFILEHANDLE   tHandle = -1;
-  BOOL              bRunFlag = TRUE;
-  U32               uCurrentAddress = 0;
+  U32               uHash;
+  U16               wLength, wLow, wHigh, wMid;
   FLASHFILEENTRY    tFileEntry;
   PLCLCTL           ptLclCtl;	
 
-  // loop
-  while( bRunFlag )
+  // compute the hash
+  uHash = ComputeHash( pszFileName, &wLength );
+
+  // find the first entry with this hash
+  wLow = 0;
+  wHigh = tHeader.wNumFiles;
+  while( wLow < wHigh )
   {
-    // read a block
-    FlashFileManager_LocalReadBlock( uCurrentAddress, ( PU8 )&tFileEntry, FLASHFILEENTRY_SIZE );
+    // read the middle entry
+    wMid = wLow + (( wHigh - wLow ) / 2 );
+    ReadEntry( wMid, &tFileEntry );
 
-    // check for done
-    if ( tFileEntry.uEntrySize != 0 )
+    // adjust the range
+    if ( tFileEntry.uHash < uHash )
+    {
+      wLow = wMid + 1;
+    }
+    else
+    {
+      wHigh = wMid;
+    }
+  }
+
+  // now check each entry with a matching hash
+  for ( ; wLow < tHeader.wNumFiles; wLow++ )
+  {
+    // read the entry/exit if the hash differs
+    ReadEntry( wLow, &tFileEntry );
+    if ( tFileEntry.uHash != uHash )
+    {
+      break;
+    }
+
+    // check the name
+    if ( tFileEntry.wNameLength == wLength )
     {
       // now read the file name
-      FlashFileManager_LocalReadBlock( uCurrentAddress + FLASHFILEENTRY_SIZE, ( PU8 )&acCurFileName, tFileEntry.wNameLength );
+      FlashFileManager_LocalReadBlock( FLASHFILEMANAGER_IMAGE_BASE_ADDR + tFileEntry.uNameOffset, ( PU8 )&acCurFileName, wLength );
 
       // compare the file name
-      if ( strncmp( pszFileName, acCurFileName, tFileEntry.wNameLength ) == 0 )
+      if ( strncmp( pszFileName, acCurFileName, wLength ) == 0 )
       {
         // file name found-search for an empty file handle
         if (( tHandle = FindEmptyControl( )) != -1 )
@@ -125,25 +215,18 @@ FLASHFILEHANDLE	FlashFileManager_Find( PC8 pszFileName )
           ptLclCtl = &atLclCtls[ tHandle ];
 
           // copy the information from the file entry to the control structure
-          ptLclCtl->uBaseAddress = tFileEntry.uEntryOffset;
+          ptLclCtl->uBaseAddress = FLASHFILEMANAGER_IMAGE_BASE_ADDR + tFileEntry.uDataOffset;
           ptLclCtl->uCurOffset = 0;
-          ptLclCtl->uFileLength = tFileEntry.uEntrySize;
+          ptLclCtl->uFileLength = tFileEntry.uFileSize;
+          ptLclCtl->uDataLength = tFileEntry.uDataSize;
+          ptLclCtl->wFlags = tFileEntry.wFlags;
+          ptLclCtl->bRaw = FALSE;
         }
 
-        // clear the run flag
-        bRunFlag = FALSE;
-      }
-      else
-      {
-        // move to the next entry
-        uCurrentAddress += tFileEntry.uEntrySize;
+        // exit
+        break;
       }
     }
-    else
-    {
-      // not found - clear run flag
-      bRunFlag = 0;
-    }
   }
 
   // return the handle
@@ -155,7 +238,8 @@ FLASHFILEHANDLE	FlashFileManager_Find( PC8 pszFileName )
  *
  * @brief read data from a file
  *
- * This function will read data from a file
+ * This function will read data from a file, compressed files are
+ * decompressed unless the handle has been set to raw
  *
  * @param[in]   tHandle       file handle
  * @param[in]   pnBuffer      pointer to the data buffer
@@ -172,22 +256,36 @@ FLASHFILEERROR FlashFileManager_Read( FLASHFILEHANDLE tHandle, PU8 pnBuffer, U16
   U32             uBytesRead;
 
   // ensure valid handle
-  if ( tHandle != -1 )
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
   {
-    // get a pointer to the control block
-    ptLclCtl = &atLclCtls[ tHandle ];
-
     // check for end of file
     if ( ptLclCtl->uCurOffset < ptLclCtl->uFileLength )
     {
       // now set the number bytes to read
       uBytesRead = MIN(( ptLclCtl->uFileLength - ptLclCtl->uCurOffset ), wLength );
 
-      // now read the bytes
-      FlashFileManager_LocalReadBlock( ptLclCtl->uBaseAddress + ptLclCtl->uCurOffset, pnBuffer, uBytesRead );
+      // check for compressed
+      if (( ptLclCtl->wFlags & FLASHFILEENTRY_FLAG_COMPRESSED ) && ( !ptLclCtl->bRaw ))
+      {
+        #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+        // decompress the bytes
+        eError = ReadCompressed( tHandle, ptLclCtl, pnBuffer, uBytesRead, &uBytesRead );
+        #else
+        // no decoder
+        eError = FLASHFILE_ERROR_DECOMPRESS;
+        uBytesRead = 0;
+        #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+      }
+      else
+      {
+        // now read the bytes
+        FlashFileManager_LocalReadBlock( ptLclCtl->uBaseAddress + ptLclCtl->uCurOffset, pnBuffer, uBytesRead );
+
+        // adjust the current address
+        ptLclCtl->uCurOffset += uBytesRead;
+      }
 
-      // adjust the current address
-      ptLclCtl->uCurOffset += uBytesRead;
+      // return the count
       *( puBytesRead ) = uBytesRead;
     }
     else
@@ -206,6 +304,312 @@ FLASHFILEERROR FlashFileManager_Read( FLASHFILEHANDLE tHandle, PU8 pnBuffer, U16
   return( eError );
 }
 
+/******************************************************************************
+ * @function FlashFileManager_ReadPointer
+ *
+ * @brief read data from a file without a copy
+ *
+ * This function will return a pointer to the data at the current offset
+ * and advance the offset, this is only available if the image is memory
+ * mapped and the file is not compressed or has been set to raw
+ *
+ * @param[in]   tHandle       file handle
+ * @param[io]   ppnData       pointer to store the data pointer
+ * @param[in]   uLength       length of the data to read
+ * @param[io]   puBytesRead   pointer to store the number of bytes read
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_ReadPointer( FLASHFILEHANDLE tHandle, PU8* ppnData, U32 uLength, PU32 puBytesRead )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+  PU8             pnData;
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    // check for end of file
+    if ( ptLclCtl->uCurOffset < ptLclCtl->uFileLength )
+    {
+      // compressed data can not be returned in place
+      if (( ptLclCtl->wFlags & FLASHFILEENTRY_FLAG_COMPRESSED ) && ( !ptLclCtl->bRaw ))
+      {
+        // return not mapped
+        eError = FLASHFILE_ERROR_NOTMAPPED;
+      }
+      else if (( pnData = FlashFileManager_LocalGetPointer( ptLclCtl->uBaseAddress + ptLclCtl->uCurOffset )) != NULL )
+      {
+        // return the pointer/length, adjust the current address
+        *( ppnData ) = pnData;
+        *( puBytesRead ) = MIN(( ptLclCtl->uFileLength - ptLclCtl->uCurOffset ), uLength );
+        ptLclCtl->uCurOffset += *( puBytesRead );
+      }
+      else
+      {
+        // return not mapped
+        eError = FLASHFILE_ERROR_NOTMAPPED;
+      }
+    }
+    else
+    {
+      // return end of file
+      eError = FLASHFILE_ERROR_ENDOFFILE;
+    }
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_Seek
+ *
+ * @brief set the current offset
+ *
+ * This function will set the current offset of a file, for a compressed
+ * file the decoder catches up on the next read
+ *
+ * @param[in]   tHandle       file handle
+ * @param[in]   lOffset       offset
+ * @param[in]   eOrigin       origin of the offset
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_Seek( FLASHFILEHANDLE tHandle, S32 lOffset, FLASHFILESEEK eOrigin )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+  S64             hOffset;
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    // compute the new offset
+    switch( eOrigin )
+    {
+      case FLASHFILE_SEEK_SET :
+        hOffset = lOffset;
+        break;
+
+      case FLASHFILE_SEEK_CUR :
+        hOffset = ( S64 )ptLclCtl->uCurOffset + lOffset;
+        break;
+
+      case FLASHFILE_SEEK_END :
+        hOffset = ( S64 )ptLclCtl->uFileLength + lOffset;
+        break;
+
+      default :
+        hOffset = -1;
+        break;
+    }
+
+    // check for valid
+    if (( hOffset >= 0 ) && ( hOffset <= ( S64 )ptLclCtl->uFileLength ))
+    {
+      // set it
+      ptLclCtl->uCurOffset = ( U32 )hOffset;
+    }
+    else
+    {
+      // return illegal seek
+      eError = FLASHFILE_ERROR_ILLSEEK;
+    }
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_Tell
+ *
+ * @brief get the current offset
+ *
+ * This function will return the current offset of a file
+ *
+ * @param[in]   tHandle       file handle
+ * @param[io]   puOffset      pointer to store the offset
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_Tell( FLASHFILEHANDLE tHandle, PU32 puOffset )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    // return the offset
+    *( puOffset ) = ptLclCtl->uCurOffset;
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_Size
+ *
+ * @brief get the size of a file
+ *
+ * This function will return the size of a file
+ *
+ * @param[in]   tHandle       file handle
+ * @param[io]   puSize        pointer to store the size
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_Size( FLASHFILEHANDLE tHandle, PU32 puSize )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    // return the size
+    *( puSize ) = ptLclCtl->uFileLength;
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_Close
+ *
+ * @brief close a file
+ *
+ * This function will release the file handle
+ *
+ * @param[in]   tHandle       file handle
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_Close( FLASHFILEHANDLE tHandle )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+    // release the decoder
+    ReleaseDecoder( tHandle );
+    #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
+    // release it
+    ptLclCtl->bInUse = FALSE;
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_IsCompressed
+ *
+ * @brief test for a compressed file
+ *
+ * This function will return TRUE if the file is stored compressed
+ *
+ * @param[in]   tHandle       file handle
+ *
+ * @return      TRUE if compressed, FALSE if not or illegal handle
+ *
+ *****************************************************************************/
+BOOL FlashFileManager_IsCompressed( FLASHFILEHANDLE tHandle )
+{
+  BOOL    bCompressed = FALSE;
+  PLCLCTL ptLclCtl;	
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    // test the flag
+    bCompressed = ( ptLclCtl->wFlags & FLASHFILEENTRY_FLAG_COMPRESSED ) ? TRUE : FALSE;
+  }
+
+  // return the status
+  return( bCompressed );
+}
+
+/******************************************************************************
+ * @function FlashFileManager_SetRaw
+ *
+ * @brief set a file to raw
+ *
+ * This function will set the file to return the stored data as is, a
+ * compressed file then reads as its zstd frame and the size reflects the
+ * stored size, the offset is reset to the start of the file
+ *
+ * @param[in]   tHandle       file handle
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+FLASHFILEERROR FlashFileManager_SetRaw( FLASHFILEHANDLE tHandle )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PLCLCTL         ptLclCtl;	
+
+  // ensure valid handle
+  if (( ptLclCtl = GetControl( tHandle )) != NULL )
+  {
+    #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+    // the decoder is no longer needed
+    ReleaseDecoder( tHandle );
+    #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
+    // set raw, the length is now the stored length
+    ptLclCtl->bRaw = TRUE;
+    ptLclCtl->uFileLength = ptLclCtl->uDataLength;
+    ptLclCtl->uCurOffset = 0;
+  }
+  else
+  {
+    // return the illegal handle
+    eError = FLASHFILE_ERROR_ILLHANDLE;
+  }
+
+  // return the error
+  return( eError );
+}
+
 /******************************************************************************
  * @function FindEmptyControl
  *
@@ -222,7 +626,7 @@ static S16 FindEmptyControl( void )
   S16   iHandle = -1;
 
   // for each control block
-  for ( nCtlIdx = 0; nCtlIdx < MAX_FILE_HANDLES; nCtlIdx++ )
+  for ( nCtlIdx = 0; nCtlIdx < FLASHFILEMANAGER_MAX_FILE_HANDLES; nCtlIdx++ )
   {
     // set the pointer
     // check for non valid block
@@ -241,4 +645,293 @@ static S16 FindEmptyControl( void )
   return( iHandle );
 }
 
+/******************************************************************************
+ * @function GetControl
+ *
+ * @brief get the control block for a handle
+ *
+ * This function will validate a handle and return its control block
+ *
+ * @param[in]   tHandle       file handle
+ *
+ * @return  pointer to the control block or NULL if illegal
+ *
+ *****************************************************************************/
+static PLCLCTL GetControl( FLASHFILEHANDLE tHandle )
+{
+  PLCLCTL ptLclCtl = NULL;
+
+  // check for valid and open
+  if (( tHandle >= 0 ) && ( tHandle < FLASHFILEMANAGER_MAX_FILE_HANDLES ) && ( atLclCtls[ tHandle ].bInUse ))
+  {
+    ptLclCtl = &atLclCtls[ tHandle ];
+  }
+
+  // return the pointer
+  return( ptLclCtl );
+}
+
+/******************************************************************************
+ * @function ComputeHash
+ *
+ * @brief compute the hash of a name
+ *
+ * This function will compute the FNV-1a hash of a file name
+ *
+ * @param[in]   pszFileName   pointer to the file name
+ * @param[io]   pwLength      pointer to store the name length
+ *
+ * @return  the hash
+ *
+ *****************************************************************************/
+static U32 ComputeHash( PC8 pszFileName, PU16 pwLength )
+{
+  U32   uHash = FLASHFILEIMAGE_HASH_SEED;
+  U16   wLength = 0;
+
+  // for each character
+  while( *( pszFileName + wLength ) != '\0' )
+  {
+    uHash ^= ( U8 )*( pszFileName + wLength++ );
+    uHash *= FLASHFILEIMAGE_HASH_PRIME;
+  }
+
+  // return the length/hash
+  *( pwLength ) = wLength;
+  return( uHash );
+}
+
+/******************************************************************************
+ * @function ReadEntry
+ *
+ * @brief read a directory entry
+ *
+ * This function will read a directory entry from the image
+ *
+ * @param[in]   wIndex        entry index
+ * @param[io]   ptEntry       pointer to the entry storage
+ *
+ *****************************************************************************/
+static void ReadEntry( U16 wIndex, PFLASHFILEENTRY ptEntry )
+{
+  // read it
+  FlashFileManager_LocalReadBlock( FLASHFILEMANAGER_IMAGE_BASE_ADDR + tHeader.uDirOffset + (( U32 )wIndex * FLASHFILEENTRY_SIZE ), ( PU8 )ptEntry, FLASHFILEENTRY_SIZE );
+}
+
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+/******************************************************************************
+ * @function ReadCompressed
+ *
+ * @brief read data from a compressed file
+ *
+ * This function will get a decoder for the file, restart it if it is past
+ * the current offset, decode and discard up to the current offset and then
+ * decode the requested data
+ *
+ * @param[in]   tHandle       file handle
+ * @param[in]   ptLclCtl      pointer to the control block
+ * @param[in]   pnBuffer      pointer to the data buffer
+ * @param[in]   uLength       length of the data to read
+ * @param[io]   puBytesRead   pointer to store the number of bytes read
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+static FLASHFILEERROR ReadCompressed( FLASHFILEHANDLE tHandle, PLCLCTL ptLclCtl, PU8 pnBuffer, U32 uLength, PU32 puBytesRead )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  PDECCTL         ptDecCtl;
+  U32             uBytesOut, uBytesRead = 0;
+
+  // get a decoder
+  if (( ptDecCtl = GetDecoder( tHandle )) != NULL )
+  {
+    // restart if a seek went backwards
+    if ( ptDecCtl->uDecOffset > ptLclCtl->uCurOffset )
+    {
+      ZSTD_DCtx_reset( ptDecCtl->ptStream, ZSTD_reset_session_only );
+      ptDecCtl->uSrcOffset = 0;
+      ptDecCtl->uDecOffset = 0;
+    }
+
+    // skip forward to the current offset using the buffer as scratch
+    while (( eError == FLASHFILE_ERROR_NONE ) && ( uLength != 0 ) && ( ptDecCtl->uDecOffset < ptLclCtl->uCurOffset ))
+    {
+      eError = Decode( ptLclCtl, ptDecCtl, pnBuffer, MIN( uLength, ptLclCtl->uCurOffset - ptDecCtl->uDecOffset ), &uBytesOut );
+    }
+
+    // now decode the data
+    while (( eError == FLASHFILE_ERROR_NONE ) && ( uBytesRead < uLength ))
+    {
+      eError = Decode( ptLclCtl, ptDecCtl, pnBuffer + uBytesRead, uLength - uBytesRead, &uBytesOut );
+      uBytesRead += uBytesOut;
+    }
+
+    // update the offset
+    ptLclCtl->uCurOffset += uBytesRead;
+
+    // on error, give up the decoder so the next read restarts
+    if ( eError != FLASHFILE_ERROR_NONE )
+    {
+      ReleaseDecoder( tHandle );
+    }
+  }
+  else
+  {
+    // no decoder
+    eError = FLASHFILE_ERROR_DECOMPRESS;
+  }
+
+  // return the count/error
+  *( puBytesRead ) = uBytesRead;
+  return( eError );
+}
+
+/******************************************************************************
+ * @function Decode
+ *
+ * @brief decode a block
+ *
+ * This function will run the decoder once, the stored data is used in place
+ * if the image is mapped, otherwise a block is read into the input buffer
+ * and whatever the decoder does not consume is read again next time
+ *
+ * @param[in]   ptLclCtl      pointer to the control block
+ * @param[in]   ptDecCtl      pointer to the decoder
+ * @param[in]   pnBuffer      pointer to the output buffer
+ * @param[in]   uLength       size of the output buffer
+ * @param[io]   puBytesOut    pointer to store the number of bytes decoded
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+static FLASHFILEERROR Decode( PLCLCTL ptLclCtl, PDECCTL ptDecCtl, PU8 pnBuffer, U32 uLength, PU32 puBytesOut )
+{
+  FLASHFILEERROR  eError = FLASHFILE_ERROR_NONE;
+  ZSTD_inBuffer   tInBuf;
+  ZSTD_outBuffer  tOutBuf;
+  size_t          tResult;
+  U32             uAvail;
+
+  // set up the input
+  uAvail = ptLclCtl->uDataLength - ptDecCtl->uSrcOffset;
+  if (( tInBuf.src = FlashFileManager_LocalGetPointer( ptLclCtl->uBaseAddress + ptDecCtl->uSrcOffset )) == NULL )
+  {
+    uAvail = MIN( uAvail, FLASHFILEMANAGER_DECOMP_INBUF_SIZE );
+    FlashFileManager_LocalReadBlock( ptLclCtl->uBaseAddress + ptDecCtl->uSrcOffset, anDecInBuf, uAvail );
+    tInBuf.src = anDecInBuf;
+  }
+  tInBuf.size = uAvail;
+  tInBuf.pos = 0;
+
+  // set up the output
+  tOutBuf.dst = pnBuffer;
+  tOutBuf.size = uLength;
+  tOutBuf.pos = 0;
+
+  // decode/adjust the offsets
+  tResult = ZSTD_decompressStream( ptDecCtl->ptStream, &tOutBuf, &tInBuf );
+  ptDecCtl->uSrcOffset += tInBuf.pos;
+  ptDecCtl->uDecOffset += tOutBuf.pos;
+  *( puBytesOut ) = tOutBuf.pos;
+
+  // check for an error or a truncated frame
+  if (( ZSTD_isError( tResult )) || (( tInBuf.pos == 0 ) && ( tOutBuf.pos == 0 )))
+  {
+    eError = FLASHFILE_ERROR_DECOMPRESS;
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function GetDecoder
+ *
+ * @brief get a decoder for a handle
+ *
+ * This function will return the decoder owned by the handle, a free one or
+ * the next one in turn, a decoder taken over is restarted
+ *
+ * @param[in]   tHandle       file handle
+ *
+ * @return  pointer to the decoder or NULL if none
+ *
+ *****************************************************************************/
+static PDECCTL GetDecoder( FLASHFILEHANDLE tHandle )
+{
+  PDECCTL ptDecCtl = NULL;
+  PDECCTL ptFreeCtl = NULL;
+  U8      nDecIdx;
+
+  // look for the owned one, remember a free one
+  for ( nDecIdx = 0; nDecIdx < FLASHFILEMANAGER_NUM_DECODERS; nDecIdx++ )
+  {
+    if ( atDecCtls[ nDecIdx ].iOwner == tHandle )
+    {
+      // found it
+      ptDecCtl = &atDecCtls[ nDecIdx ];
+      break;
+    }
+    else if (( atDecCtls[ nDecIdx ].iOwner == -1 ) && ( ptFreeCtl == NULL ))
+    {
+      ptFreeCtl = &atDecCtls[ nDecIdx ];
+    }
+  }
+
+  // check for not owned
+  if ( ptDecCtl == NULL )
+  {
+    // use the free one or the next one in turn
+    if (( ptDecCtl = ptFreeCtl ) == NULL )
+    {
+      ptDecCtl = &atDecCtls[ nNextDecoder ];
+      nNextDecoder = ( nNextDecoder + 1 ) % FLASHFILEMANAGER_NUM_DECODERS;
+    }
+
+    // check for a valid decoder
+    if ( ptDecCtl->ptStream != NULL )
+    {
+      // take it over and restart it
+      ptDecCtl->iOwner = tHandle;
+      ptDecCtl->uSrcOffset = 0;
+      ptDecCtl->uDecOffset = 0;
+      ZSTD_DCtx_reset( ptDecCtl->ptStream, ZSTD_reset_session_only );
+    }
+    else
+    {
+      // not created
+      ptDecCtl = NULL;
+    }
+  }
+
+  // return the decoder
+  return( ptDecCtl );
+}
+
+/******************************************************************************
+ * @function ReleaseDecoder
+ *
+ * @brief release a decoder
+ *
+ * This function will release the decoder owned by a handle
+ *
+ * @param[in]   tHandle       file handle
+ *
+ *****************************************************************************/
+static void ReleaseDecoder( FLASHFILEHANDLE tHandle )
+{
+  U8  nDecIdx;
+
+  // find the owned one
+  for ( nDecIdx = 0; nDecIdx < FLASHFILEMANAGER_NUM_DECODERS; nDecIdx++ )
+  {
+    if ( atDecCtls[ nDecIdx ].iOwner == tHandle )
+    {
+      atDecCtls[ nDecIdx ].iOwner = -1;
+    }
+  }
+}
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+
 /**@} EOF FlashFileManager.c */
@@ -44,17 +44,35 @@ typedef enum _FLASHFILEERROR
   FLASHFILE_ERROR_NOTFOUND,
   FLASHFILE_ERROR_ILLHANDLE,
   FLASHFILE_ERROR_ENDOFFILE,
+  FLASHFILE_ERROR_ILLSEEK,
+  FLASHFILE_ERROR_NOTMAPPED,
+  FLASHFILE_ERROR_DECOMPRESS,
 } FLASHFILEERROR;
 
+/// enumerate the seek origins
+typedef enum _FLASHFILESEEK
+{
+  FLASHFILE_SEEK_SET = 0,         ///< from the start of the file
+  FLASHFILE_SEEK_CUR,             ///< from the current offset
+  FLASHFILE_SEEK_END,             ///< from the end of the file
+} FLASHFILESEEK;
+
 // structures -----------------------------------------------------------------
 typedef S16         FLASHFILEHANDLE;
 
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
-extern	void            FlashFileManager_Initialize( void );
+extern	BOOL            FlashFileManager_Initialize( void );
 extern	FLASHFILEHANDLE	FlashFileManager_Find( PC8 pszFileName );
 extern	FLASHFILEERROR	FlashFileManager_Read( FLASHFILEHANDLE tHandle, PU8 pnBuffer, U16 wLength, PU16	puBytesRead );
+extern  FLASHFILEERROR  FlashFileManager_ReadPointer( FLASHFILEHANDLE tHandle, PU8* ppnData, U32 uLength, PU32 puBytesRead );
+extern  FLASHFILEERROR  FlashFileManager_Seek( FLASHFILEHANDLE tHandle, S32 lOffset, FLASHFILESEEK eOrigin );
+extern  FLASHFILEERROR  FlashFileManager_Tell( FLASHFILEHANDLE tHandle, PU32 puOffset );
+extern  FLASHFILEERROR  FlashFileManager_Size( FLASHFILEHANDLE tHandle, PU32 puSize );
+extern  FLASHFILEERROR  FlashFileManager_Close( FLASHFILEHANDLE tHandle );
+extern  BOOL            FlashFileManager_IsCompressed( FLASHFILEHANDLE tHandle );
+extern  FLASHFILEERROR  FlashFileManager_SetRaw( FLASHFILEHANDLE tHandle );
 
 /**@} EOF FlashFileManager.h */
 
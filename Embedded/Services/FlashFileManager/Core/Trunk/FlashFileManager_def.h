@@ -0,0 +1,80 @@
+/******************************************************************************
+ * @file FlashFileManager_def.h
+ *
+ * @brief flash file manager image format declarations
+ *
+ * This file provides the declarations for the flash file image.  The image
+ * starts with a header, followed by a directory sorted by name hash, the
+ * name table and the file data.  All values are little endian and all
+ * offsets are relative to the start of the image.
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup FlashFileManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _FLASHFILEMANAGER_DEF_H
+#define _FLASHFILEMANAGER_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the image magic ( "FFMI" ) and version
+#define FLASHFILEIMAGE_MAGIC                        ( 0x494D4646 )
+#define FLASHFILEIMAGE_VERSION                      ( 1 )
+
+/// define the name hash ( FNV-1a ) parameters
+#define FLASHFILEIMAGE_HASH_SEED                    ( 0x811C9DC5 )
+#define FLASHFILEIMAGE_HASH_PRIME                   ( 0x01000193 )
+
+/// define the file flags, a compressed file stores a single zstd frame of
+/// data size bytes that decompresses to file size bytes
+#define FLASHFILEENTRY_FLAG_COMPRESSED              ( 0x0001 )
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the image header
+typedef struct _FLASHFILEHEADER
+{
+  U32   uMagic;                   ///< image magic
+  U16   wVersion;                 ///< image version
+  U16   wNumFiles;                ///< number of directory entries
+  U32   uDirOffset;               ///< offset of the directory
+  U32   uImageSize;               ///< total size of the image
+} FLASHFILEHEADER, *PFLASHFILEHEADER;
+#define FLASHFILEHEADER_SIZE                        sizeof( FLASHFILEHEADER )
+
+/// define the directory entry, entries are sorted by hash
+typedef struct _FLASHFILEENTRY
+{
+  U32   uHash;                    ///< hash of the name
+  U32   uNameOffset;              ///< offset of the name
+  U32   uDataOffset;              ///< offset of the data
+  U32   uDataSize;                ///< size of the stored data
+  U32   uFileSize;                ///< size of the file
+  U16   wNameLength;              ///< length of the name, without the terminator
+  U16   wFlags;                   ///< file flags
+} FLASHFILEENTRY, *PFLASHFILEENTRY;
+#define FLASHFILEENTRY_SIZE                         sizeof( FLASHFILEENTRY )
+
+/**@} EOF FlashFileManager_def.h */
+
+#endif  // _FLASHFILEMANAGER_DEF_H
@@ -0,0 +1,457 @@
+/******************************************************************************
+ * @file FlashFileImageBuilder.c
+ *
+ * @brief flash file image builder
+ *
+ * This file provides a host tool that builds a flash file manager image from
+ * a directory tree.  Each file is stored with its path relative to the root
+ * directory, prefixed with a "/", so "www/index.html" built from "www" is
+ * found as "/index.html".  The layout must match FlashFileManager_def.h.
+ * With -z each file is compressed into a single zstd frame and stored
+ * compressed if that is smaller.
+ *
+ * build with: cc -O2 -I<zstd lib> -o FlashFileImageBuilder FlashFileImageBuilder.c -lzstd
+ *             where the zstd library is ThirdPartyLibraries/Ztp/zstd-dev/lib
+ * usage:      FlashFileImageBuilder [-z] <image> <root directory>
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup FlashFileManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "zstd.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the image magic/version, these must match FlashFileManager_def.h
+#define FLASHFILEIMAGE_MAGIC                        ( 0x494D4646 )
+#define FLASHFILEIMAGE_VERSION                      ( 1 )
+#define FLASHFILEIMAGE_HASH_SEED                    ( 0x811C9DC5 )
+#define FLASHFILEIMAGE_HASH_PRIME                   ( 0x01000193 )
+
+/// define the sizes of the header/directory entry
+#define FLASHFILEHEADER_SIZE                        ( 16 )
+#define FLASHFILEENTRY_SIZE                         ( 24 )
+
+/// define the maximum name length, this must match FLASHFILE_MAX_FILE_NAME
+#define MAX_NAME_LENGTH                             ( 255 )
+
+/// define the data alignment
+#define DATA_ALIGNMENT                              ( 4 )
+
+/// define the file flags, these must match FlashFileManager_def.h
+#define FLASHFILEENTRY_FLAG_COMPRESSED              ( 0x0001 )
+
+/// define the compression level and window log, the window log must not
+/// exceed FLASHFILEMANAGER_DECOMP_WINDOWLOG
+#define COMPRESSION_LEVEL                           ( 19 )
+#define COMPRESSION_WINDOWLOG                       ( 10 )
+
+// structures -----------------------------------------------------------------
+/// define the file structure
+typedef struct _FILEENT
+{
+  char*     pszPath;                ///< host path
+  char*     pszName;                ///< image name
+  uint32_t  uHash;                  ///< name hash
+  uint32_t  uSize;                  ///< file size
+  uint32_t  uDataSize;              ///< size of the stored data
+  uint16_t  wFlags;                 ///< file flags
+  uint8_t*  pnData;                 ///< stored data
+  uint32_t  uNameOffset;            ///< offset of the name
+  uint32_t  uDataOffset;            ///< offset of the data
+} FILEENT;
+
+// local parameter declarations -----------------------------------------------
+static  FILEENT*  ptFiles;
+static  size_t    tNumFiles;
+static  size_t    tMaxFiles;
+
+// local function prototypes --------------------------------------------------
+static  int       AddTree( const char* pszRoot, const char* pszRelative );
+static  int       LoadFile( FILEENT* ptEntry, ZSTD_CCtx* ptCCtx );
+static  uint32_t  ComputeHash( const char* pszName );
+static  int       CompareEntries( const void* pvA, const void* pvB );
+static  void      PutU16( FILE* ptFile, uint16_t wValue );
+static  void      PutU32( FILE* ptFile, uint32_t uValue );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * This function will build the image
+ *
+ * @param[in]   argc      argument count
+ * @param[in]   argv      arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  FILE*       ptImage;
+  ZSTD_CCtx*  ptCCtx = NULL;
+  size_t      tIndex;
+  uint32_t    uOffset;
+  int         iArg = 1;
+
+  // check the arguments
+  if (( argc == 4 ) && ( strcmp( argv[ 1 ], "-z" ) == 0 ))
+  {
+    // create the compressor
+    ptCCtx = ZSTD_createCCtx( );
+    ZSTD_CCtx_setParameter( ptCCtx, ZSTD_c_compressionLevel, COMPRESSION_LEVEL );
+    ZSTD_CCtx_setParameter( ptCCtx, ZSTD_c_windowLog, COMPRESSION_WINDOWLOG );
+    iArg++;
+  }
+  else if ( argc != 3 )
+  {
+    fprintf( stderr, "usage: %s [-z] <image> <root directory>\n", argv[ 0 ] );
+    return( 1 );
+  }
+
+  // collect the files/sort them by hash then name
+  if ( AddTree( argv[ iArg + 1 ], "" ) != 0 )
+  {
+    return( 1 );
+  }
+  if ( tNumFiles > 0xFFFF )
+  {
+    fprintf( stderr, "too many files\n" );
+    return( 1 );
+  }
+  qsort( ptFiles, tNumFiles, sizeof( FILEENT ), CompareEntries );
+
+  // load the files
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    if ( LoadFile( &ptFiles[ tIndex ], ptCCtx ) != 0 )
+    {
+      return( 1 );
+    }
+  }
+  ZSTD_freeCCtx( ptCCtx );
+
+  // lay out the names after the directory
+  uOffset = FLASHFILEHEADER_SIZE + ( uint32_t )( tNumFiles * FLASHFILEENTRY_SIZE );
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    ptFiles[ tIndex ].uNameOffset = uOffset;
+    uOffset += ( uint32_t )strlen( ptFiles[ tIndex ].pszName ) + 1;
+  }
+
+  // lay out the data
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    uOffset = ( uOffset + DATA_ALIGNMENT - 1 ) & ~( DATA_ALIGNMENT - 1 );
+    ptFiles[ tIndex ].uDataOffset = uOffset;
+    uOffset += ptFiles[ tIndex ].uDataSize;
+  }
+
+  // create the image
+  if (( ptImage = fopen( argv[ iArg ], "wb" )) == NULL )
+  {
+    perror( argv[ iArg ] );
+    return( 1 );
+  }
+
+  // write the header
+  PutU32( ptImage, FLASHFILEIMAGE_MAGIC );
+  PutU16( ptImage, FLASHFILEIMAGE_VERSION );
+  PutU16( ptImage, ( uint16_t )tNumFiles );
+  PutU32( ptImage, FLASHFILEHEADER_SIZE );
+  PutU32( ptImage, uOffset );
+
+  // write the directory
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    PutU32( ptImage, ptFiles[ tIndex ].uHash );
+    PutU32( ptImage, ptFiles[ tIndex ].uNameOffset );
+    PutU32( ptImage, ptFiles[ tIndex ].uDataOffset );
+    PutU32( ptImage, ptFiles[ tIndex ].uDataSize );
+    PutU32( ptImage, ptFiles[ tIndex ].uSize );
+    PutU16( ptImage, ( uint16_t )strlen( ptFiles[ tIndex ].pszName ));
+    PutU16( ptImage, ptFiles[ tIndex ].wFlags );
+  }
+
+  // write the names
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    fwrite( ptFiles[ tIndex ].pszName, 1, strlen( ptFiles[ tIndex ].pszName ) + 1, ptImage );
+  }
+
+  // write the data
+  for ( tIndex = 0; tIndex < tNumFiles; tIndex++ )
+  {
+    // pad to the data offset
+    while ( ftell( ptImage ) < ( long )ptFiles[ tIndex ].uDataOffset )
+    {
+      fputc( 0xFF, ptImage );
+    }
+
+    // write the stored data
+    fwrite( ptFiles[ tIndex ].pnData, 1, ptFiles[ tIndex ].uDataSize, ptImage );
+
+    // report it
+    printf( "%08X %8u %8u %s\n", ptFiles[ tIndex ].uHash, ptFiles[ tIndex ].uSize, ptFiles[ tIndex ].uDataSize, ptFiles[ tIndex ].pszName );
+  }
+
+  // done
+  printf( "%u files, %u bytes\n", ( unsigned )tNumFiles, uOffset );
+  fclose( ptImage );
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function AddTree
+ *
+ * @brief add a directory tree
+ *
+ * This function will recursively add the regular files in a directory
+ *
+ * @param[in]   pszRoot       root directory
+ * @param[in]   pszRelative   path relative to the root
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+static int AddTree( const char* pszRoot, const char* pszRelative )
+{
+  DIR*            ptDir;
+  struct dirent*  ptDirEnt;
+  struct stat     tStat;
+  char            acPath[ 4096 ];
+  char            acName[ MAX_NAME_LENGTH + 2 ];
+  int             iStatus = 0;
+
+  // open the directory
+  snprintf( acPath, sizeof( acPath ), "%s%s", pszRoot, pszRelative );
+  if (( ptDir = opendir( acPath )) == NULL )
+  {
+    perror( acPath );
+    return( 1 );
+  }
+
+  // for each entry
+  while (( iStatus == 0 ) && (( ptDirEnt = readdir( ptDir )) != NULL ))
+  {
+    // skip the dot entries
+    if ( ptDirEnt->d_name[ 0 ] == '.' )
+    {
+      continue;
+    }
+
+    // build the paths
+    snprintf( acPath, sizeof( acPath ), "%s%s/%s", pszRoot, pszRelative, ptDirEnt->d_name );
+    if ( snprintf( acName, sizeof( acName ), "%s/%s", pszRelative, ptDirEnt->d_name ) > MAX_NAME_LENGTH )
+    {
+      fprintf( stderr, "name too long: %s\n", acPath );
+      iStatus = 1;
+    }
+    else if ( stat( acPath, &tStat ) != 0 )
+    {
+      perror( acPath );
+      iStatus = 1;
+    }
+    else if ( S_ISDIR( tStat.st_mode ))
+    {
+      // recurse
+      iStatus = AddTree( pszRoot, acName );
+    }
+    else if ( S_ISREG( tStat.st_mode ))
+    {
+      // grow the table
+      if ( tNumFiles == tMaxFiles )
+      {
+        tMaxFiles = ( tMaxFiles == 0 ) ? 64 : tMaxFiles * 2;
+        ptFiles = realloc( ptFiles, tMaxFiles * sizeof( FILEENT ));
+      }
+
+      // add the file
+      ptFiles[ tNumFiles ].pszPath = strdup( acPath );
+      ptFiles[ tNumFiles ].pszName = strdup( acName );
+      ptFiles[ tNumFiles ].uHash = ComputeHash( acName );
+      ptFiles[ tNumFiles ].uSize = ( uint32_t )tStat.st_size;
+      tNumFiles++;
+    }
+  }
+
+  // close the directory
+  closedir( ptDir );
+  return( iStatus );
+}
+
+/******************************************************************************
+ * @function LoadFile
+ *
+ * @brief load a file
+ *
+ * This function will read a file into memory and, if a compressor is given,
+ * replace it with its zstd frame when that is smaller
+ *
+ * @param[in]   ptEntry       file entry
+ * @param[in]   ptCCtx        compressor or NULL
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+static int LoadFile( FILEENT* ptEntry, ZSTD_CCtx* ptCCtx )
+{
+  FILE*     ptInput;
+  uint8_t*  pnFrame;
+  size_t    tBound, tLength;
+
+  // read the file
+  ptEntry->pnData = malloc( ptEntry->uSize + 1 );
+  ptEntry->uDataSize = ptEntry->uSize;
+  ptEntry->wFlags = 0;
+  if (( ptInput = fopen( ptEntry->pszPath, "rb" )) == NULL )
+  {
+    perror( ptEntry->pszPath );
+    return( 1 );
+  }
+  tLength = fread( ptEntry->pnData, 1, ptEntry->uSize, ptInput );
+  fclose( ptInput );
+  if ( tLength != ptEntry->uSize )
+  {
+    fprintf( stderr, "short read: %s\n", ptEntry->pszPath );
+    return( 1 );
+  }
+
+  // compress it if requested
+  if ( ptCCtx != NULL )
+  {
+    tBound = ZSTD_compressBound( ptEntry->uSize );
+    pnFrame = malloc( tBound );
+    tLength = ZSTD_compress2( ptCCtx, pnFrame, tBound, ptEntry->pnData, ptEntry->uSize );
+    if ( ZSTD_isError( tLength ))
+    {
+      fprintf( stderr, "compress %s: %s\n", ptEntry->pszPath, ZSTD_getErrorName( tLength ));
+      free( pnFrame );
+      return( 1 );
+    }
+
+    // only keep it if smaller
+    if ( tLength < ptEntry->uSize )
+    {
+      free( ptEntry->pnData );
+      ptEntry->pnData = pnFrame;
+      ptEntry->uDataSize = ( uint32_t )tLength;
+      ptEntry->wFlags |= FLASHFILEENTRY_FLAG_COMPRESSED;
+    }
+    else
+    {
+      free( pnFrame );
+    }
+  }
+
+  // return OK
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function ComputeHash
+ *
+ * @brief compute the hash of a name
+ *
+ * This function will compute the FNV-1a hash of a name
+ *
+ * @param[in]   pszName       pointer to the name
+ *
+ * @return      the hash
+ *
+ *****************************************************************************/
+static uint32_t ComputeHash( const char* pszName )
+{
+  uint32_t  uHash = FLASHFILEIMAGE_HASH_SEED;
+
+  // for each character
+  while ( *pszName != '\0' )
+  {
+    uHash ^= ( uint8_t )*pszName++;
+    uHash *= FLASHFILEIMAGE_HASH_PRIME;
+  }
+
+  // return the hash
+  return( uHash );
+}
+
+/******************************************************************************
+ * @function CompareEntries
+ *
+ * @brief compare two entries
+ *
+ * This function will order entries by hash then name
+ *
+ * @param[in]   pvA           first entry
+ * @param[in]   pvB           second entry
+ *
+ * @return      compare result
+ *
+ *****************************************************************************/
+static int CompareEntries( const void* pvA, const void* pvB )
+{
+  const FILEENT*  ptA = pvA;
+  const FILEENT*  ptB = pvB;
+
+  // compare the hash then the name
+  if ( ptA->uHash != ptB->uHash )
+  {
+    return(( ptA->uHash < ptB->uHash ) ? -1 : 1 );
+  }
+  return( strcmp( ptA->pszName, ptB->pszName ));
+}
+
+/******************************************************************************
+ * @function PutU16
+ *
+ * @brief write a little endian value
+ *
+ * This function will write a 16 bit little endian value
+ *
+ * @param[in]   ptFile        file
+ * @param[in]   wValue        value
+ *
+ *****************************************************************************/
+static void PutU16( FILE* ptFile, uint16_t wValue )
+{
+  fputc( wValue & 0xFF, ptFile );
+  fputc( wValue >> 8, ptFile );
+}
+
+/******************************************************************************
+ * @function PutU32
+ *
+ * @brief write a little endian value
+ *
+ * This function will write a 32 bit little endian value
+ *
+ * @param[in]   ptFile        file
+ * @param[in]   uValue        value
+ *
+ *****************************************************************************/
+static void PutU32( FILE* ptFile, uint32_t uValue )
+{
+  PutU16( ptFile, ( uint16_t )( uValue & 0xFFFF ));
+  PutU16( ptFile, ( uint16_t )( uValue >> 16 ));
+}
+
+/**@} EOF FlashFileImageBuilder.c */
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * @file I2cTransactionManager_cfg.c
+ *
+ * @brief I2C transaction manager configuration implementation
+ *
+ * This file provides the client table and the process task hooks for the
+ * I2C transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+
+// local function prototypes --------------------------------------------------
+
+// constant parameter initializations -----------------------------------------
+/// fill out the client table
+const CODE I2CTRANSCLIENTDEF g_atI2cTransClientDefs[ I2CTRANS_CLIENT_ENUM_MAX ] =
+{
+  // I2CTRANSCLIENTDEFM( bus )
+  // I2CTRANSCLIENTDEFMRGM( bus )
+};
+
+/******************************************************************************
+ * @function I2cTransactionManager_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function will perform any custom initialization
+ *
+ *****************************************************************************/
+void I2cTransactionManager_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_LocalKick
+ *
+ * @brief kick the process
+ *
+ * This function is called when a transaction is submitted or work remains
+ * after a process pass, and should schedule I2cTransactionManager_Process
+ *
+ *****************************************************************************/
+void I2cTransactionManager_LocalKick( void )
+{
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+    // post an event to the process task
+    TaskManager_PostEvent( TASK_SCHD_ENUM_I2CTRANS, 0 );
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+/******************************************************************************
+ * @function I2cTransactionManager_ProcessTask
+ *
+ * @brief process task
+ *
+ * This function will run a process pass
+ *
+ * @param[in]   xArg      task argument
+ *
+ * @return      TRUE to flush event
+ *
+ *****************************************************************************/
+BOOL I2cTransactionManager_ProcessTask( TASKARG xArg )
+{
+  // run a pass
+  I2cTransactionManager_Process( );
+
+  // return true to flush event
+  return( TRUE );
+}
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+/**@} EOF I2cTransactionManager_cfg.c */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * @file I2cTransactionManager_cfg.h
+ *
+ * @brief I2C transaction manager configuration declarations
+ *
+ * This file provides the configuration declarations for the I2C transaction
+ * manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _I2CTRANSACTIONMANAGER_CFG_H
+#define _I2CTRANSACTIONMANAGER_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  #define I2CTRANSMNGR_PROCESS_NUM_EVENTS       ( 4 )
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the clients
+typedef enum _I2CTRANSCLIENTENUM
+{
+  // enumerate clients here
+
+  // do not remove the below entries
+  I2CTRANS_CLIENT_ENUM_MAX,
+  I2CTRANS_CLIENT_ENUM_ILLEGAL
+} I2CTRANSCLIENTENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE I2CTRANSCLIENTDEF g_atI2cTransClientDefs[ ];
+
+// global function prototypes --------------------------------------------------
+extern  void  I2cTransactionManager_LocalInitialize( void );
+extern  void  I2cTransactionManager_LocalKick( void );
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  extern  BOOL  I2cTransactionManager_ProcessTask( TASKARG xArg );
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+/**@} EOF I2cTransactionManager_cfg.h */
+
+#endif  // _I2CTRANSACTIONMANAGER_CFG_H
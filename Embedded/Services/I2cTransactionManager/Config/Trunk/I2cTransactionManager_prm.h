@@ -0,0 +1,49 @@
+/******************************************************************************
+ * @file I2cTransactionManager_prm.h
+ *
+ * @brief I2C transaction manager parameter declarations
+ *
+ * This file declares any customization for the I2C transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _I2CTRANSACTIONMANAGER_PRM_H
+#define _I2CTRANSACTIONMANAGER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the maximum number of segments in a transaction
+#define I2CTRANSMNGR_MAX_SEGMENTS                 ( 4 )
+
+/// define the number of transactions executed per bus on each process pass
+#define I2CTRANSMNGR_TRANSACTIONS_PER_PASS        ( 4 )
+
+/// define the macro to enable merging of adjacent register reads
+#define I2CTRANSMNGR_ENABLE_MERGE                 ( ON )
+
+/// define the size of the merged read buffer
+#define I2CTRANSMNGR_MERGE_BUFFER_SIZE            ( 64 )
+
+/// define the maximum number of transactions merged into one read
+#define I2CTRANSMNGR_MAX_MERGE                    ( 8 )
+
+/**@} EOF I2cTransactionManager_prm.h */
+
+#endif  // _I2CTRANSACTIONMANAGER_PRM_H
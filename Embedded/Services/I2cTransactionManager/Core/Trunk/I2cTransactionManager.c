@@ -0,0 +1,567 @@
+/******************************************************************************
+ * @file I2cTransactionManager.c
+ *
+ * @brief I2C transaction manager implementation
+ *
+ * This file provides the implementation for the I2C transaction manager.
+ * Drivers submit caller owned transactions into their own client queue and
+ * return immediately.  Each process pass services one transaction per bus,
+ * selecting the least recently serviced client that has work on that bus,
+ * so a chatty driver cannot starve its neighbours.  Single segment register
+ * reads to the same device from clients that enable merging, that sit at the
+ * head of the queues and cover adjacent registers are merged into one bus
+ * read, and the data is then scattered back to each transaction.  Ranges that
+ * share a register are never merged, as a FIFO or clear on read register
+ * must be read once per client
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the client control structure
+typedef struct _CLIENTCTL
+{
+  PI2CTRANSACTION   ptHead;         ///< queue head
+  PI2CTRANSACTION   ptTail;         ///< queue tail
+  U32               uLastService;   ///< service stamp of the last transaction
+} CLIENTCTL, *PCLIENTCTL;
+#define CLIENTCTL_SIZE                          sizeof( CLIENTCTL )
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  CLIENTCTL         atClientCtls[ I2CTRANS_CLIENT_ENUM_MAX ];
+static  U32               uServiceStamp;
+static  I2CTRANSMNGRSTATS tStats;
+#if ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+static  U8                anMergeBuffer[ I2CTRANSMNGR_MERGE_BUFFER_SIZE ];
+static  PI2CTRANSACTION   aptMerged[ I2CTRANSMNGR_MAX_MERGE ];
+#endif // ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+
+// local function prototypes --------------------------------------------------
+static  PI2CTRANSACTION PopHead( I2CTRANSCLIENTENUM eClient );
+static  void            ExecuteTransaction( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans );
+static  void            CompleteTransaction( PI2CTRANSACTION ptTrans, I2CERR eError );
+#if ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+static  BOOL            IsMergeable( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans );
+static  BOOL            MergeReads( I2CDEVENUM eBus, PI2CTRANSACTION ptTrans );
+#endif // ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function I2cTransactionManager_Initialize
+ *
+ * @brief initialization
+ *
+ * This function will clear the client queues and statistics
+ *
+ * @return      FALSE if no errors, TRUE otherwise
+ *
+ *****************************************************************************/
+BOOL I2cTransactionManager_Initialize( void )
+{
+  // clear the queues/statistics
+  memset( atClientCtls, 0, sizeof( atClientCtls ));
+  memset( &tStats, 0, I2CTRANSMNGRSTATS_SIZE );
+  uServiceStamp = 0;
+
+  // call the local initialization
+  I2cTransactionManager_LocalInitialize( );
+
+  // return ok
+  return( FALSE );
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_SetupRegister
+ *
+ * @brief set up a single register access
+ *
+ * This function will fill out a transaction with a single segment, and
+ * clear the completion callback and task, which the caller may then set
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ * @param[in]   nDevAddr    device address
+ * @param[in]   eType       segment type
+ * @param[in]   nAddrLen    register address length
+ * @param[in]   uAddress    register address
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wDataLen    data length
+ *
+ *****************************************************************************/
+void I2cTransactionManager_SetupRegister( PI2CTRANSACTION ptTrans, U8 nDevAddr, I2CTRANSSEGTYPE eType, U8 nAddrLen, U32 uAddress, PU8 pnData, U16 wDataLen )
+{
+  // clear the transaction
+  memset( ptTrans, 0, I2CTRANSACTION_SIZE );
+
+  // fill out the segment
+  ptTrans->nDevAddr = nDevAddr;
+  ptTrans->nNumSegs = 1;
+  ptTrans->atSegs[ 0 ].eType = eType;
+  ptTrans->atSegs[ 0 ].nAddrLen = nAddrLen;
+  ptTrans->atSegs[ 0 ].uAddress = uAddress;
+  ptTrans->atSegs[ 0 ].pnData = pnData;
+  ptTrans->atSegs[ 0 ].wDataLen = wDataLen;
+
+  // no completion reporting
+  ptTrans->pvCallback = NULL;
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  ptTrans->eTaskEnum = TASK_SCHD_ILLEGAL;
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_Submit
+ *
+ * @brief submit a transaction
+ *
+ * This function will append a transaction to the client queue, the
+ * transaction and its data buffers must remain valid until it completes
+ *
+ * @param[in]   eClient     client enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+I2CTRANSMNGRERR I2cTransactionManager_Submit( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans )
+{
+  I2CTRANSMNGRERR eError = I2CTRANSMNGR_ERR_NONE;
+  PCLIENTCTL      ptCtl;
+  U8              nSeg;
+
+  // check for a valid client
+  if ( eClient >= I2CTRANS_CLIENT_ENUM_MAX )
+  {
+    // illegal client
+    eError = I2CTRANSMNGR_ERR_ILLCLIENT;
+  }
+  else if (( ptTrans == NULL ) || ( ptTrans->nNumSegs == 0 ) || ( ptTrans->nNumSegs > I2CTRANSMNGR_MAX_SEGMENTS ))
+  {
+    // illegal transaction
+    eError = I2CTRANSMNGR_ERR_ILLPRM;
+  }
+  else if ( ptTrans->eStatus == I2CTRANS_STS_QUEUED )
+  {
+    // already in a queue
+    eError = I2CTRANSMNGR_ERR_BUSY;
+  }
+  else
+  {
+    // check each segment
+    for ( nSeg = 0; nSeg < ptTrans->nNumSegs; nSeg++ )
+    {
+      if (( ptTrans->atSegs[ nSeg ].eType >= I2CTRANS_SEGTYPE_MAX ) || (( ptTrans->atSegs[ nSeg ].wDataLen != 0 ) && ( ptTrans->atSegs[ nSeg ].pnData == NULL )))
+      {
+        // illegal segment
+        eError = I2CTRANSMNGR_ERR_ILLPRM;
+      }
+    }
+
+    if ( eError == I2CTRANSMNGR_ERR_NONE )
+    {
+      // append to the queue
+      ptCtl = &atClientCtls[ eClient ];
+      ptTrans->ptNext = NULL;
+      ptTrans->eStatus = I2CTRANS_STS_QUEUED;
+      ptTrans->eError = I2C_ERROR_NONE;
+      if ( ptCtl->ptTail != NULL )
+      {
+        ptCtl->ptTail->ptNext = ptTrans;
+      }
+      else
+      {
+        ptCtl->ptHead = ptTrans;
+      }
+      ptCtl->ptTail = ptTrans;
+      tStats.uSubmitted++;
+
+      // kick the process
+      I2cTransactionManager_LocalKick( );
+    }
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_Process
+ *
+ * @brief process the queues
+ *
+ * This function will run up to I2CTRANSMNGR_TRANSACTIONS_PER_PASS rounds,
+ * each round executing one transaction per bus for the least recently
+ * serviced client with work on that bus
+ *
+ *****************************************************************************/
+void I2cTransactionManager_Process( void )
+{
+  I2CTRANSCLIENTENUM  eClient, eCand, eBest;
+  I2CDEVENUM          eBus;
+  U32                 uBusesServed;
+  U8                  nRound;
+  BOOL                bWork;
+
+  // for each round
+  for ( nRound = 0; nRound < I2CTRANSMNGR_TRANSACTIONS_PER_PASS; nRound++ )
+  {
+    // clear the served buses/work flag
+    uBusesServed = 0;
+    bWork = FALSE;
+
+    // for each client
+    for ( eClient = 0; eClient < I2CTRANS_CLIENT_ENUM_MAX; eClient++ )
+    {
+      // skip empty queues and buses already served this round
+      eBus = g_atI2cTransClientDefs[ eClient ].eBus;
+      if (( atClientCtls[ eClient ].ptHead == NULL ) || ( uBusesServed & BIT(( eBus ))))
+      {
+        continue;
+      }
+
+      // find the least recently serviced client on this bus
+      eBest = eClient;
+      for ( eCand = eClient + 1; eCand < I2CTRANS_CLIENT_ENUM_MAX; eCand++ )
+      {
+        if (( g_atI2cTransClientDefs[ eCand ].eBus == eBus ) && ( atClientCtls[ eCand ].ptHead != NULL ) && ( atClientCtls[ eCand ].uLastService < atClientCtls[ eBest ].uLastService ))
+        {
+          eBest = eCand;
+        }
+      }
+
+      // mark the bus and execute
+      uBusesServed |= BIT(( eBus ));
+      atClientCtls[ eBest ].uLastService = ++uServiceStamp;
+      ExecuteTransaction( eBest, PopHead( eBest ));
+      bWork = TRUE;
+    }
+
+    // exit if nothing was done
+    if ( !bWork )
+    {
+      break;
+    }
+  }
+
+  // if work remains, kick again
+  if ( !I2cTransactionManager_IsIdle( ))
+  {
+    I2cTransactionManager_LocalKick( );
+  }
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_IsIdle
+ *
+ * @brief check for idle
+ *
+ * This function will return TRUE if all the client queues are empty
+ *
+ * @return      TRUE if idle
+ *
+ *****************************************************************************/
+BOOL I2cTransactionManager_IsIdle( void )
+{
+  I2CTRANSCLIENTENUM  eClient;
+  BOOL                bIdle = TRUE;
+
+  // check each queue
+  for ( eClient = 0; eClient < I2CTRANS_CLIENT_ENUM_MAX; eClient++ )
+  {
+    if ( atClientCtls[ eClient ].ptHead != NULL )
+    {
+      bIdle = FALSE;
+      break;
+    }
+  }
+
+  // return the status
+  return( bIdle );
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_GetStats
+ *
+ * @brief get the statistics
+ *
+ * This function will copy the statistics and optionally reset them
+ *
+ * @param[io]   ptStats     pointer to the statistics storage
+ * @param[in]   bReset      TRUE to reset the statistics
+ *
+ *****************************************************************************/
+void I2cTransactionManager_GetStats( PI2CTRANSMNGRSTATS ptStats, BOOL bReset )
+{
+  // copy the statistics
+  memcpy( ptStats, &tStats, I2CTRANSMNGRSTATS_SIZE );
+
+  // reset if requested
+  if ( bReset )
+  {
+    memset( &tStats, 0, I2CTRANSMNGRSTATS_SIZE );
+  }
+}
+
+/******************************************************************************
+ * @function PopHead
+ *
+ * @brief remove the head of a client queue
+ *
+ * This function will unlink and return the first transaction of a queue
+ *
+ * @param[in]   eClient     client enumeration
+ *
+ * @return      pointer to the transaction
+ *
+ *****************************************************************************/
+static PI2CTRANSACTION PopHead( I2CTRANSCLIENTENUM eClient )
+{
+  PCLIENTCTL      ptCtl = &atClientCtls[ eClient ];
+  PI2CTRANSACTION ptTrans;
+
+  // unlink the head
+  ptTrans = ptCtl->ptHead;
+  ptCtl->ptHead = ptTrans->ptNext;
+  if ( ptCtl->ptHead == NULL )
+  {
+    ptCtl->ptTail = NULL;
+  }
+  ptTrans->ptNext = NULL;
+
+  // return it
+  return( ptTrans );
+}
+
+/******************************************************************************
+ * @function ExecuteTransaction
+ *
+ * @brief execute a transaction
+ *
+ * This function will attempt to merge a register read, otherwise it will
+ * issue each segment in order, stopping at the first error
+ *
+ * @param[in]   eClient     client enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ *****************************************************************************/
+static void ExecuteTransaction( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans )
+{
+  I2CXFRCTL     tXfrCtl;
+  PI2CTRANSSEG  ptSeg;
+  I2CERR        eError = I2C_ERROR_NONE;
+  I2CDEVENUM    eBus = g_atI2cTransClientDefs[ eClient ].eBus;
+  U8            nSeg;
+
+  #if ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+  // try to merge
+  if ( IsMergeable( eClient, ptTrans ) && MergeReads( eBus, ptTrans ))
+  {
+    // done
+    return;
+  }
+  #endif // ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+
+  // for each segment
+  for ( nSeg = 0; ( nSeg < ptTrans->nNumSegs ) && ( eError == I2C_ERROR_NONE ); nSeg++ )
+  {
+    // fill out the transfer control
+    ptSeg = &ptTrans->atSegs[ nSeg ];
+    tXfrCtl.nDevAddr = ptTrans->nDevAddr;
+    tXfrCtl.nAddrLen = ptSeg->nAddrLen;
+    tXfrCtl.tAddress.uValue = ptSeg->uAddress;
+    tXfrCtl.pnData = ptSeg->pnData;
+    tXfrCtl.wDataLen = ptSeg->wDataLen;
+    tXfrCtl.uTimeout = ptTrans->uTimeout;
+
+    // issue it
+    eError = ( ptSeg->eType == I2CTRANS_SEGTYPE_READ ) ? I2c_Read( eBus, &tXfrCtl ) : I2c_Write( eBus, &tXfrCtl );
+    tStats.uBusOps++;
+  }
+
+  // complete it
+  CompleteTransaction( ptTrans, eError );
+}
+
+/******************************************************************************
+ * @function CompleteTransaction
+ *
+ * @brief complete a transaction
+ *
+ * This function will set the status and report the completion
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ * @param[in]   eError      completion error
+ *
+ *****************************************************************************/
+static void CompleteTransaction( PI2CTRANSACTION ptTrans, I2CERR eError )
+{
+  // set the status
+  ptTrans->eError = eError;
+  ptTrans->eStatus = ( eError == I2C_ERROR_NONE ) ? I2CTRANS_STS_DONE : I2CTRANS_STS_ERROR;
+  tStats.uCompleted++;
+  if ( eError != I2C_ERROR_NONE )
+  {
+    tStats.uErrors++;
+  }
+
+  // report it
+  if ( ptTrans->pvCallback != NULL )
+  {
+    ptTrans->pvCallback( ptTrans );
+  }
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  if ( ptTrans->eTaskEnum != TASK_SCHD_ILLEGAL )
+  {
+    TaskManager_PostEvent( ptTrans->eTaskEnum, ptTrans->xTaskArg );
+  }
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+#if ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+/******************************************************************************
+ * @function IsMergeable
+ *
+ * @brief check if a transaction can be merged
+ *
+ * This function will return TRUE for a single segment addressed register
+ * read that fits in the merge buffer from a client that enables merging
+ *
+ * @param[in]   eClient     client enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ * @return      TRUE if mergeable
+ *
+ *****************************************************************************/
+static BOOL IsMergeable( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans )
+{
+  PI2CTRANSSEG  ptSeg = &ptTrans->atSegs[ 0 ];
+
+  // return the status
+  return(( g_atI2cTransClientDefs[ eClient ].bMergeReads ) && ( ptTrans->nNumSegs == 1 ) && ( ptSeg->eType == I2CTRANS_SEGTYPE_READ ) && ( ptSeg->nAddrLen != 0 ) && ( ptSeg->wDataLen != 0 ) && ( ptSeg->wDataLen <= I2CTRANSMNGR_MERGE_BUFFER_SIZE ));
+}
+
+/******************************************************************************
+ * @function MergeReads
+ *
+ * @brief merge register reads
+ *
+ * This function will gather the queue heads on the same bus that read
+ * registers of the same device directly before or after the current range,
+ * issue one read covering them all and scatter the data back.  Only queue
+ * heads are considered so each client's own ordering is preserved, and a
+ * range that shares a register with the current one is left for its own
+ * read so side effects of the read are seen by each client
+ *
+ * @param[in]   eBus        bus enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ * @return      TRUE if the transaction was merged and completed
+ *
+ *****************************************************************************/
+static BOOL MergeReads( I2CDEVENUM eBus, PI2CTRANSACTION ptTrans )
+{
+  I2CTRANSCLIENTENUM  eClient;
+  PI2CTRANSACTION     ptCand;
+  PI2CTRANSSEG        ptSeg;
+  I2CXFRCTL           tXfrCtl;
+  I2CERR              eError;
+  U32                 uStart, uEnd, uCandEnd;
+  U8                  nMerged, nIndex;
+  BOOL                bFound;
+
+  // start with the current transaction
+  aptMerged[ 0 ] = ptTrans;
+  nMerged = 1;
+  uStart = ptTrans->atSegs[ 0 ].uAddress;
+  uEnd = uStart + ptTrans->atSegs[ 0 ].wDataLen;
+
+  // gather until nothing else fits
+  do
+  {
+    bFound = FALSE;
+    for ( eClient = 0; ( eClient < I2CTRANS_CLIENT_ENUM_MAX ) && ( nMerged < I2CTRANSMNGR_MAX_MERGE ); eClient++ )
+    {
+      // check the head for the same bus/device/address length
+      ptCand = atClientCtls[ eClient ].ptHead;
+      if (( ptCand == NULL ) || ( g_atI2cTransClientDefs[ eClient ].eBus != eBus ) || ( ptCand->nDevAddr != ptTrans->nDevAddr ) || !IsMergeable( eClient, ptCand ) || ( ptCand->atSegs[ 0 ].nAddrLen != ptTrans->atSegs[ 0 ].nAddrLen ))
+      {
+        continue;
+      }
+
+      // check for adjacent registers within the buffer, never a shared register
+      ptSeg = &ptCand->atSegs[ 0 ];
+      uCandEnd = ptSeg->uAddress + ptSeg->wDataLen;
+      if ((( uCandEnd != uStart ) && ( ptSeg->uAddress != uEnd )) || (( MAX( uEnd, uCandEnd ) - MIN( uStart, ptSeg->uAddress )) > I2CTRANSMNGR_MERGE_BUFFER_SIZE ))
+      {
+        continue;
+      }
+
+      // extend the range and take it
+      uStart = MIN( uStart, ptSeg->uAddress );
+      uEnd = MAX( uEnd, uCandEnd );
+      aptMerged[ nMerged++ ] = PopHead( eClient );
+      atClientCtls[ eClient ].uLastService = ++uServiceStamp;
+      bFound = TRUE;
+    }
+  } while ( bFound );
+
+  // if nothing merged, execute normally
+  if ( nMerged == 1 )
+  {
+    return( FALSE );
+  }
+
+  // issue the merged read
+  tXfrCtl.nDevAddr = ptTrans->nDevAddr;
+  tXfrCtl.nAddrLen = ptTrans->atSegs[ 0 ].nAddrLen;
+  tXfrCtl.tAddress.uValue = uStart;
+  tXfrCtl.pnData = anMergeBuffer;
+  tXfrCtl.wDataLen = ( U16 )( uEnd - uStart );
+  tXfrCtl.uTimeout = ptTrans->uTimeout;
+  eError = I2c_Read( eBus, &tXfrCtl );
+  tStats.uBusOps++;
+  tStats.uMerged += nMerged;
+
+  // scatter the data and complete
+  for ( nIndex = 0; nIndex < nMerged; nIndex++ )
+  {
+    ptSeg = &aptMerged[ nIndex ]->atSegs[ 0 ];
+    if ( eError == I2C_ERROR_NONE )
+    {
+      memcpy( ptSeg->pnData, &anMergeBuffer[ ptSeg->uAddress - uStart ], ptSeg->wDataLen );
+    }
+    CompleteTransaction( aptMerged[ nIndex ], eError );
+  }
+
+  // return merged
+  return( TRUE );
+}
+#endif // ( I2CTRANSMNGR_ENABLE_MERGE == ON )
+
+/**@} EOF I2cTransactionManager.c */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * @file I2cTransactionManager.h
+ *
+ * @brief I2C transaction manager declarations
+ *
+ * This file provides the declarations for the I2C transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _I2CTRANSACTIONMANAGER_H
+#define _I2CTRANSACTIONMANAGER_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the errors
+typedef enum _I2CTRANSMNGRERR
+{
+  I2CTRANSMNGR_ERR_NONE = 0,      ///< no error
+  I2CTRANSMNGR_ERR_ILLCLIENT,     ///< illegal client
+  I2CTRANSMNGR_ERR_ILLPRM,        ///< illegal transaction
+  I2CTRANSMNGR_ERR_BUSY,          ///< transaction is already queued
+} I2CTRANSMNGRERR;
+
+// structures -----------------------------------------------------------------
+/// define the statistics structure
+typedef struct _I2CTRANSMNGRSTATS
+{
+  U32   uSubmitted;               ///< transactions submitted
+  U32   uCompleted;               ///< transactions completed
+  U32   uErrors;                  ///< transactions completed with an error
+  U32   uMerged;                  ///< transactions satisfied by a merged read
+  U32   uBusOps;                  ///< bus read/write calls issued
+} I2CTRANSMNGRSTATS, *PI2CTRANSMNGRSTATS;
+#define I2CTRANSMNGRSTATS_SIZE                  sizeof( I2CTRANSMNGRSTATS )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  BOOL            I2cTransactionManager_Initialize( void );
+extern  void            I2cTransactionManager_SetupRegister( PI2CTRANSACTION ptTrans, U8 nDevAddr, I2CTRANSSEGTYPE eType, U8 nAddrLen, U32 uAddress, PU8 pnData, U16 wDataLen );
+extern  I2CTRANSMNGRERR I2cTransactionManager_Submit( I2CTRANSCLIENTENUM eClient, PI2CTRANSACTION ptTrans );
+extern  void            I2cTransactionManager_Process( void );
+extern  BOOL            I2cTransactionManager_IsIdle( void );
+extern  void            I2cTransactionManager_GetStats( PI2CTRANSMNGRSTATS ptStats, BOOL bReset );
+
+/**@} EOF I2cTransactionManager.h */
+
+#endif  // _I2CTRANSACTIONMANAGER_H
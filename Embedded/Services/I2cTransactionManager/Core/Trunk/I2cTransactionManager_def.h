@@ -0,0 +1,120 @@
+/******************************************************************************
+ * @file I2cTransactionManager_def.h
+ *
+ * @brief I2C transaction manager definition declarations
+ *
+ * This file provides the definition declarations for the I2C transaction
+ * manager clients and transactions
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _I2CTRANSACTIONMANAGER_DEF_H
+#define _I2CTRANSACTIONMANAGER_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager_prm.h"
+
+// library includes -----------------------------------------------------------
+#include "I2C/I2c.h"
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  #include "TaskManager/TaskManager.h"
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+// Macros and Defines ---------------------------------------------------------
+/// define the helper macro for a client
+#define I2CTRANSCLIENTDEFM( bus ) \
+  { \
+    .eBus = bus, \
+    .bMergeReads = FALSE, \
+  }
+
+/// define the helper macro for a client whose register reads may be merged
+#define I2CTRANSCLIENTDEFMRGM( bus ) \
+  { \
+    .eBus = bus, \
+    .bMergeReads = TRUE, \
+  }
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the segment types
+typedef enum _I2CTRANSSEGTYPE
+{
+  I2CTRANS_SEGTYPE_WRITE = 0,     ///< write address/data
+  I2CTRANS_SEGTYPE_READ,          ///< write address, repeated start, read data
+  I2CTRANS_SEGTYPE_MAX
+} I2CTRANSSEGTYPE;
+
+/// enumerate the transaction status
+typedef enum _I2CTRANSSTS
+{
+  I2CTRANS_STS_IDLE = 0,          ///< not submitted
+  I2CTRANS_STS_QUEUED,            ///< waiting in a client queue
+  I2CTRANS_STS_DONE,              ///< completed without error
+  I2CTRANS_STS_ERROR,             ///< completed with an error
+} I2CTRANSSTS;
+
+// structures -----------------------------------------------------------------
+/// define the segment structure
+typedef struct _I2CTRANSSEG
+{
+  I2CTRANSSEGTYPE eType;          ///< segment type
+  U8              nAddrLen;       ///< register address length
+  U32             uAddress;       ///< register address
+  PU8             pnData;         ///< pointer to the data
+  U16             wDataLen;       ///< data length
+} I2CTRANSSEG, *PI2CTRANSSEG;
+#define I2CTRANSSEG_SIZE                        sizeof( I2CTRANSSEG )
+
+/// forward declare the transaction for the callback
+struct _I2CTRANSACTION;
+
+/// define the completion callback
+typedef void ( *PVI2CTRANSCALLBACK )( struct _I2CTRANSACTION* ptTrans );
+
+/// define the transaction structure, owned by the caller until completion
+typedef struct _I2CTRANSACTION
+{
+  struct _I2CTRANSACTION* ptNext;         ///< queue link
+  U8                      nDevAddr;       ///< device address
+  U8                      nNumSegs;       ///< number of segments
+  I2CTRANSSEG             atSegs[ I2CTRANSMNGR_MAX_SEGMENTS ];  ///< segments
+  U32                     uTimeout;       ///< per segment timeout in MSEC
+  PVI2CTRANSCALLBACK      pvCallback;     ///< completion callback
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  TASKSCHDENUMS           eTaskEnum;      ///< completion task
+  TASKARG                 xTaskArg;       ///< completion event
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  PVOID                   pvUserData;     ///< user data
+  volatile I2CTRANSSTS    eStatus;        ///< status
+  I2CERR                  eError;         ///< completion error
+} I2CTRANSACTION, *PI2CTRANSACTION;
+#define I2CTRANSACTION_SIZE                     sizeof( I2CTRANSACTION )
+
+/// define the client definition structure
+typedef struct _I2CTRANSCLIENTDEF
+{
+  I2CDEVENUM      eBus;           ///< bus this client is attached to
+  BOOL            bMergeReads;    ///< TRUE if its register reads have no side effects and may be merged
+} I2CTRANSCLIENTDEF, *PI2CTRANSCLIENTDEF;
+#define I2CTRANSCLIENTDEF_SIZE                  sizeof( I2CTRANSCLIENTDEF )
+
+/**@} EOF I2cTransactionManager_def.h */
+
+#endif  // _I2CTRANSACTIONMANAGER_DEF_H
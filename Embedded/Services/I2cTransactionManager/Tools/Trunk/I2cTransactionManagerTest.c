@@ -0,0 +1,358 @@
+/******************************************************************************
+ * @file I2cTransactionManagerTest.c
+ *
+ * @brief I2C transaction manager merge test
+ *
+ * This file provides a host tool that runs the transaction manager against
+ * the simulated register file bus of the Linux I2C HAL.  It replaces
+ * I2cTransactionManager_cfg.c with three clients that enable merging and two
+ * that keep the default.  It checks that adjacent reads from merging clients
+ * become one bus read with the data scattered back, that the default clients
+ * are never merged, and that reads sharing a register, exactly or in part,
+ * are each issued on their own.  It then benchmarks three adjacent two byte
+ * reads per round merged and unmerged, reporting the bus transfers, the
+ * bytes, the wire time at 400 kHz and the host time.  It exits non zero on
+ * any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o I2cTransactionManagerTest
+ *             I2cTransactionManagerTest.c
+ *             ../../Core/Trunk/I2cTransactionManager.c
+ *             <HAL/Linux/I2C root>/Core/Trunk/I2c.c
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup I2cTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// local includes -------------------------------------------------------------
+#include "I2cTransactionManager/I2cTransactionManager.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the simulated device address/register file size
+#define SIM_DEV_ADDR                                ( 0x68 )
+#define SIM_NUM_REGS                                ( 256 )
+
+/// define the number of benchmark rounds
+#define BENCH_ROUNDS                                ( 200000 )
+
+/// define the benchmark register base/read length
+#define BENCH_REG_BASE                              ( 0x3B )
+#define BENCH_READ_LEN                              ( 2 )
+
+/// define the bus rate for the wire time, the bits per byte and per transfer
+#define BUS_RATE_HZ                                 ( 400000.0 )
+#define BITS_PER_BYTE                               ( 9 )
+#define BITS_PER_TRANSFER                           ( 3 )
+
+/// define the number of transactions per check
+#define MAX_CHECK_TRANS                             ( 3 )
+
+// structures -----------------------------------------------------------------
+/// define a check read
+typedef struct _CHECKREAD
+{
+  I2CTRANSCLIENTENUM  eClient;      ///< client
+  U8                  nRegister;    ///< register
+  U8                  nLength;      ///< length
+} CHECKREAD;
+
+/// define a check
+typedef struct _CHECK
+{
+  PC8                 pszName;      ///< name
+  U8                  nNumReads;    ///< number of reads
+  CHECKREAD           atReads[ MAX_CHECK_TRANS ];   ///< reads
+  U32                 uExpBusOps;   ///< expected bus operations
+} CHECK;
+
+// local parameter declarations -----------------------------------------------
+static  U8              anSimRegs[ SIM_NUM_REGS ];
+static  const I2CSIMDEV atSimDevs[ ] =
+{
+  I2C_SIMDEV( SIM_DEV_ADDR, anSimRegs ),
+};
+static  U32             uCallbacks;
+
+// constant parameter initializations -----------------------------------------
+/// fill out the client table
+const CODE I2CTRANSCLIENTDEF g_atI2cTransClientDefs[ I2CTRANS_CLIENT_ENUM_MAX ] =
+{
+  I2CTRANSCLIENTDEFMRGM( I2C_DEV_ENUM_SIM ),
+  I2CTRANSCLIENTDEFMRGM( I2C_DEV_ENUM_SIM ),
+  I2CTRANSCLIENTDEFMRGM( I2C_DEV_ENUM_SIM ),
+  I2CTRANSCLIENTDEFM( I2C_DEV_ENUM_SIM ),
+  I2CTRANSCLIENTDEFM( I2C_DEV_ENUM_SIM ),
+};
+
+/// device configuration table
+const I2CDEF atI2cDefs[ I2C_DEV_ENUM_MAX ] =
+{
+  I2C_DEVICE_SIM( atSimDevs ),
+};
+
+/// define the checks
+static  const CHECK atChecks[ ] =
+{
+  { "adjacent, merging",        3, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x10, 2 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x12, 2 }, { I2CTRANS_CLIENT_ENUM_MRG2, 0x14, 2 }}, 1 },
+  { "adjacent, reversed",       3, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x14, 2 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x12, 2 }, { I2CTRANS_CLIENT_ENUM_MRG2, 0x10, 2 }}, 1 },
+  { "adjacent, default",        2, {{ I2CTRANS_CLIENT_ENUM_PLAIN0, 0x10, 2 }, { I2CTRANS_CLIENT_ENUM_PLAIN1, 0x12, 2 }}, 2 },
+  { "adjacent, mixed",          2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x10, 2 }, { I2CTRANS_CLIENT_ENUM_PLAIN0, 0x12, 2 }}, 2 },
+  { "same register",            2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x20, 1 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x20, 1 }}, 2 },
+  { "same range",               2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x20, 4 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x20, 4 }}, 2 },
+  { "partial overlap",          2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x20, 4 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x22, 4 }}, 2 },
+  { "contained",                2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x20, 8 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x23, 1 }}, 2 },
+  { "overlap then adjacent",    3, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x30, 2 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x30, 2 }, { I2CTRANS_CLIENT_ENUM_MRG2, 0x32, 2 }}, 2 },
+  { "gap",                      2, {{ I2CTRANS_CLIENT_ENUM_MRG0, 0x40, 2 }, { I2CTRANS_CLIENT_ENUM_MRG1, 0x43, 2 }}, 2 },
+};
+
+// local function prototypes --------------------------------------------------
+static  void    Callback( PI2CTRANSACTION ptTrans );
+static  void    RunUntilIdle( void );
+static  int     RunCheck( const CHECK* ptCheck );
+static  void    RunBench( I2CTRANSCLIENTENUM eFirst, PC8 pszName );
+static  double  ElapsedNsecs( struct timespec* ptStart );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check and the benchmark
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+  U16 wIdx;
+
+  // fill the register file
+  for ( wIdx = 0; wIdx < SIM_NUM_REGS; wIdx++ )
+  {
+    anSimRegs[ wIdx ] = ( U8 )(( wIdx * 7 ) + 3 );
+  }
+
+  // initialize
+  I2c_Initialize( );
+  I2cTransactionManager_Initialize( );
+
+  // run the checks
+  for ( wIdx = 0; wIdx < NUMELEMENTS( atChecks ); wIdx++ )
+  {
+    iErrors += RunCheck( &atChecks[ wIdx ] );
+  }
+
+  // run the benchmark
+  RunBench( I2CTRANS_CLIENT_ENUM_PLAIN0, "unmerged" );
+  RunBench( I2CTRANS_CLIENT_ENUM_MRG0, "merged" );
+
+  // report
+  printf( "%d errors\n%s\n", iErrors, ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function has nothing to do for the test
+ *
+ *****************************************************************************/
+void I2cTransactionManager_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function I2cTransactionManager_LocalKick
+ *
+ * @brief kick the process
+ *
+ * This function has nothing to do, the test runs the process until idle
+ *
+ *****************************************************************************/
+void I2cTransactionManager_LocalKick( void )
+{
+}
+
+/******************************************************************************
+ * @function Callback
+ *
+ * @brief completion callback
+ *
+ * This function counts the completions
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ *****************************************************************************/
+static void Callback( PI2CTRANSACTION ptTrans )
+{
+  ( void )ptTrans;
+  uCallbacks++;
+}
+
+/******************************************************************************
+ * @function RunUntilIdle
+ *
+ * @brief run until idle
+ *
+ * This function runs process passes until every queue is empty
+ *
+ *****************************************************************************/
+static void RunUntilIdle( void )
+{
+  // process
+  while ( !I2cTransactionManager_IsIdle( ))
+  {
+    I2cTransactionManager_Process( );
+  }
+}
+
+/******************************************************************************
+ * @function RunCheck
+ *
+ * @brief run a check
+ *
+ * This function queues the reads of a check before processing so they sit
+ * at the queue heads together, then checks the bus operations and the data
+ *
+ * @param[in]   ptCheck     pointer to the check
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int RunCheck( const CHECK* ptCheck )
+{
+  int                 iErrors = 0;
+  I2CTRANSACTION      atTrans[ MAX_CHECK_TRANS ];
+  U8                  aanData[ MAX_CHECK_TRANS ][ 16 ];
+  I2CTRANSMNGRSTATS   tStats;
+  const CHECKREAD*    ptRead;
+  U8                  nIdx;
+
+  // queue each read
+  I2cTransactionManager_GetStats( &tStats, TRUE );
+  uCallbacks = 0;
+  memset( aanData, 0, sizeof( aanData ));
+  for ( nIdx = 0; nIdx < ptCheck->nNumReads; nIdx++ )
+  {
+    ptRead = &ptCheck->atReads[ nIdx ];
+    I2cTransactionManager_SetupRegister( &atTrans[ nIdx ], SIM_DEV_ADDR, I2CTRANS_SEGTYPE_READ, 1, ptRead->nRegister, aanData[ nIdx ], ptRead->nLength );
+    atTrans[ nIdx ].pvCallback = Callback;
+    I2cTransactionManager_Submit( ptRead->eClient, &atTrans[ nIdx ] );
+  }
+
+  // process/check the bus operations and completions
+  RunUntilIdle( );
+  I2cTransactionManager_GetStats( &tStats, TRUE );
+  if (( tStats.uBusOps != ptCheck->uExpBusOps ) || ( uCallbacks != ptCheck->nNumReads ))
+  {
+    printf( "  %s: %u bus operations, expected %u, %u of %u completed\n", ptCheck->pszName, tStats.uBusOps, ptCheck->uExpBusOps, uCallbacks, ptCheck->nNumReads );
+    iErrors++;
+  }
+
+  // check the data
+  for ( nIdx = 0; nIdx < ptCheck->nNumReads; nIdx++ )
+  {
+    ptRead = &ptCheck->atReads[ nIdx ];
+    if (( atTrans[ nIdx ].eStatus != I2CTRANS_STS_DONE ) || ( memcmp( aanData[ nIdx ], &anSimRegs[ ptRead->nRegister ], ptRead->nLength ) != 0 ))
+    {
+      printf( "  %s: read %d wrong data or status %d\n", ptCheck->pszName, nIdx, atTrans[ nIdx ].eStatus );
+      iErrors++;
+    }
+  }
+
+  // report
+  printf( "%-24s %u bus operations, %u merged, %d errors\n", ptCheck->pszName, tStats.uBusOps, tStats.uMerged, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function RunBench
+ *
+ * @brief run the benchmark
+ *
+ * This function reads three adjacent two byte registers per round from
+ * three clients starting at the given one
+ *
+ * @param[in]   eFirst      first client
+ * @param[in]   pszName     name for the report
+ *
+ *****************************************************************************/
+static void RunBench( I2CTRANSCLIENTENUM eFirst, PC8 pszName )
+{
+  I2CTRANSACTION  atTrans[ MAX_CHECK_TRANS ];
+  U8              aanData[ MAX_CHECK_TRANS ][ BENCH_READ_LEN ];
+  I2CSTATS        tBusStats;
+  struct timespec tStart;
+  double          dNsecs, dWireUsecs;
+  U32             uRound;
+  U8              nIdx, nNumClients;
+
+  // the unmerged run has only two default clients, cycle the third read through them
+  nNumClients = ( eFirst == I2CTRANS_CLIENT_ENUM_MRG0 ) ? 3 : 2;
+
+  // run the rounds
+  I2c_Ioctl( I2C_DEV_ENUM_SIM, I2C_ACTION_CLR_STATS, NULL );
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  for ( uRound = 0; uRound < BENCH_ROUNDS; uRound++ )
+  {
+    for ( nIdx = 0; nIdx < MAX_CHECK_TRANS; nIdx++ )
+    {
+      I2cTransactionManager_SetupRegister( &atTrans[ nIdx ], SIM_DEV_ADDR, I2CTRANS_SEGTYPE_READ, 1, BENCH_REG_BASE + ( nIdx * BENCH_READ_LEN ), aanData[ nIdx ], BENCH_READ_LEN );
+      I2cTransactionManager_Submit( eFirst + ( nIdx % nNumClients ), &atTrans[ nIdx ] );
+    }
+    RunUntilIdle( );
+  }
+  dNsecs = ElapsedNsecs( &tStart );
+  I2c_Ioctl( I2C_DEV_ENUM_SIM, I2C_ACTION_GET_STATS, &tBusStats );
+
+  // compute the wire time, each transfer adds the two device address bytes and start/restart/stop
+  dWireUsecs = ((( double )tBusStats.uBytes + ( 2.0 * tBusStats.uTransfers )) * BITS_PER_BYTE + (( double )tBusStats.uTransfers * BITS_PER_TRANSFER )) * 1e6 / BUS_RATE_HZ;
+
+  // report
+  printf( "bench %-8s %.2f transfers, %.2f bytes, %.1f usecs at 400 kHz per round, %.1f nsecs host per transaction\n", pszName,
+          ( double )tBusStats.uTransfers / BENCH_ROUNDS, ( double )tBusStats.uBytes / BENCH_ROUNDS, dWireUsecs / BENCH_ROUNDS,
+          dNsecs / ( BENCH_ROUNDS * MAX_CHECK_TRANS ));
+}
+
+/******************************************************************************
+ * @function ElapsedNsecs
+ *
+ * @brief get the elapsed time
+ *
+ * This function will return the nanoseconds since the start time
+ *
+ * @param[in]   ptStart     pointer to the start time
+ *
+ * @return      elapsed nanoseconds
+ *
+ *****************************************************************************/
+static double ElapsedNsecs( struct timespec* ptStart )
+{
+  struct timespec tStop;
+
+  // get the stop time
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+  return((( tStop.tv_sec - ptStart->tv_sec ) * 1e9 ) + ( tStop.tv_nsec - ptStart->tv_nsec ));
+}
+
+/**@} EOF I2cTransactionManagerTest.c */
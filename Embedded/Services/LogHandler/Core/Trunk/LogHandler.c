@@ -35,6 +35,9 @@
 #define RDIDXCHK_EEP_OFFSET   ( RDIDXADR_EEP_OFFSET + sizeof( U16 ))
 #define LOGDATA_EEP_OFFSET    ( RDIDXCHK_EEP_OFFSET + sizeof( U16 ))
 
+/// define the maximum number of entries in a binary dump
+#define DMPLOG_MAX_ENTRIES    ( 16 )
+
 // enumerations ---------------------------------------------------------------
 #if ( LOGHANDLER_ENABLE_DBGBINCOMMANDS == ON )
   typedef enum _LOGBINCMD
@@ -492,7 +495,7 @@ void LogHandler_ClearAllEntries( void )
       case LOG_DISPMODE_NEWEST_LAST16 :
         eFirstPos = LOG_POS_NEWEST;
         eNextPos = LOG_POS_PREV;
-        wCount = MIN( wCurNumEntries, 16 );
+        wCount = MIN( wCurNumEntries, DMPLOG_MAX_ENTRIES );
         break;
 
       case LOG_DISPMODE_OLDEST_ONLY :
@@ -503,7 +506,7 @@ void LogHandler_ClearAllEntries( void )
       case LOG_DISPMODE_OLDEST_NEXT16 :
         eFirstPos = LOG_POS_OLDEST;
         eNextPos = LOG_POS_NEXT;
-        wCount = MIN( wCurNumEntries, 16 );
+        wCount = MIN( wCurNumEntries, DMPLOG_MAX_ENTRIES );
         break;
 
       default :
@@ -594,7 +597,14 @@ void LogHandler_ClearAllEntries( void )
     LOGPOS      eFirstPos, eNextPos;
     PC8         pcDescription;
     U16         wTemp;
-    LOGDATA     tData;
+    #if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+      static  LOGDATA     atData[ DMPLOG_MAX_ENTRIES ];
+      static  BINCMDFRAG  atFrags[ DMPLOG_MAX_ENTRIES * 2 ];
+      U8                  nNumFrags = 0;
+      PLOGDATA            ptData;
+    #else
+      LOGDATA     tData;
+    #endif // BINCMDHAND_ENABLE_SCATTERGATHER
 
     // get the dump option
     BinaryCommandHandler_GetOption1( nCmdEnum, ( PU8 )&eMode );
@@ -613,7 +623,7 @@ void LogHandler_ClearAllEntries( void )
       case LOG_DISPMODE_NEWEST_LAST16 :
         eFirstPos = LOG_POS_NEWEST;
         eNextPos = LOG_POS_PREV;
-        wCount = MIN( wCurNumEntries, 16 );
+        wCount = MIN( wCurNumEntries, DMPLOG_MAX_ENTRIES );
         break;
 
       case LOG_DISPMODE_OLDEST_ONLY :
@@ -624,10 +634,12 @@ void LogHandler_ClearAllEntries( void )
       case LOG_DISPMODE_OLDEST_NEXT16 :
         eFirstPos = LOG_POS_OLDEST;
         eNextPos = LOG_POS_NEXT;
-        wCount = MIN( wCurNumEntries, 16 );
+        wCount = MIN( wCurNumEntries, DMPLOG_MAX_ENTRIES );
         break;
 
       default :
+        eFirstPos = LOG_POS_NEWEST;
+        wCount = 0;
         break;
     }
 
@@ -637,21 +649,44 @@ void LogHandler_ClearAllEntries( void )
       // get the entry/description
       if ( !CalculateAddressFromPosition( eFirstPos, &wTemp ))
       {
-        // now read the entry
-        LogHandler_RdBlock( LOGDATA_EEP_OFFSET + ( wCurIndex * LOGDATA_SIZE ), ( PU8 )&tData, LOGDATA_SIZE );
-        pcDescription = LogHandler_GetDescription( tData.eType );
+        #if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+          // now read the entry
+          ptData = &atData[ nNumFrags / 2 ];
+          LogHandler_RdBlock( LOGDATA_EEP_OFFSET + ( wCurIndex * LOGDATA_SIZE ), ( PU8 )ptData, LOGDATA_SIZE );
+          pcDescription = LogHandler_GetDescription( ptData->eType );
+
+          // add the entry and the description straight from program memory
+          atFrags[ nNumFrags ].pnData = ( PU8 )ptData;
+          atFrags[ nNumFrags ].wLength = LOGDATA_SIZE;
+          atFrags[ nNumFrags++ ].bProgMem = FALSE;
+          atFrags[ nNumFrags ].pnData = ( PU8 )pcDescription;
+          atFrags[ nNumFrags ].wLength = LOGHANDLER_MAX_DESCR_LEN;
+          atFrags[ nNumFrags++ ].bProgMem = TRUE;
+        #else
+          // now read the entry
+          LogHandler_RdBlock( LOGDATA_EEP_OFFSET + ( wCurIndex * LOGDATA_SIZE ), ( PU8 )&tData, LOGDATA_SIZE );
+          pcDescription = LogHandler_GetDescription( tData.eType );
         
-        // now stuff in buffer
-        BinaryCommandHandler_SetMessageBlock( nCmdEnum, ( PU8 )&tData, LOGDATA_SIZE );      
-        BinaryCommandHandler_SetMessageBlock( nCmdEnum, pcDescription, LOGHANDLER_MAX_DESCR_LEN );
+          // now stuff in buffer
+          BinaryCommandHandler_SetMessageBlock( nCmdEnum, ( PU8 )&tData, LOGDATA_SIZE );      
+          BinaryCommandHandler_SetMessageBlock( nCmdEnum, pcDescription, LOGHANDLER_MAX_DESCR_LEN );
+        #endif // BINCMDHAND_ENABLE_SCATTERGATHER
       
         // adjust the position
         eFirstPos = eNextPos;
       }
     }
 
-    // return no error
-    return( BINPARSE_STS_SND_RESP );	
+    #if ( BINCMDHAND_ENABLE_SCATTERGATHER == 1 )
+      // send the entries without copying them into the transmit buffer
+      BinaryCommandHandler_SendResponseFragments( nCmdEnum, atFrags, nNumFrags );
+
+      // response has been sent
+      return( BINPARSE_STS_SND_NORESP );
+    #else
+      // return no error
+      return( BINPARSE_STS_SND_RESP );	
+    #endif // BINCMDHAND_ENABLE_SCATTERGATHER
   }
   
   /******************************************************************************
@@ -38,6 +38,19 @@
 /// define the enumeration for the config manager
 #define SCHDMNGR_CONFIGCHANGE_ENUM          ( TASK_SCHD_ENUM_CFGMGR )
 
+/// define the enumeration for this task, its timer is armed for the next transition
+#define SCHDMNGR_TASK_ENUM                  ( TASK_SCHD_ENUM_SCHDMNGR )
+
+/// define the value of the first day of the week from the RTC, the week is 7 days
+#define SCHDMNGR_DOW_FIRST                  ( 0 )
+
+/// define the maximum number of compiled intervals, if exceeded the schedule is scanned every minute
+#define SCHDMNGR_MAX_INTERVALS              ( 64 )
+
+/// define the longest single timer and the delay past a transition minute
+#define SCHDMNGR_MAX_TIMER_MINS             ( 60 )
+#define SCHDMNGR_TIMER_GUARD_SECS           ( 1 )
+
 /// define the system control manager fast mode
 #define SCHDMNGR_SYSCTRLMNGR_FASTMODE_ENUM  ( SYSCTRLMNGR_MODE_ILLEGAL )
 
@@ -3,7 +3,11 @@
  *
  * @brief light control manager implementation
  *
- * This file provides the implementation for the light control manager
+ * This file provides the implementation for the schedule manager.  The
+ * schedule is compiled into a list of intervals sorted by minute of the week,
+ * each holding the entry that the reverse order search would pick, so the
+ * task only runs at a transition.  Its timer is armed for the next transition
+ * and recompiled or re-evaluated when the schedule, RTC or time zone changes
  *
  * @copyright Copyright (c) 2012 CyberIntegration
  * This document contains proprietary data and information of CyberIntegration 
@@ -40,22 +44,35 @@
 /// define the base event for the light control manager
 #if ( SCHDMNGR_ENABLE_DEBUG == 1 )
 #define SCHDMMNGR_DEBUG_BASE        ( 0x5000 )
+#define SCHDMMNGR_DEBUG_OVERFLOW    ( SCHDMMNGR_DEBUG_BASE | 0x0F00 )
 #endif // SCHDMMNGR_ENABLE_DEBUG
 
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+/// define the compiled interval
+typedef struct _SCHDMNGRINTERVAL
+{
+  U16               wStartMins;         ///< start in minutes of the week
+  U8                nIndex;             ///< schedule index
+} SCHDMNGRINTERVAL, *PSCHDMNGRINTERVAL;
+#define SCHDMNGRINTERVAL_SIZE         sizeof( SCHDMNGRINTERVAL )
 
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
 static  SCHDMNGRDEFTBL      tSchedule;        ///< the acutal schedule
-static  PSCHDMNGRDEFENTRY   ptSchedEntry;     ///< schedule entry
 static  SCHDMNGRDEFENUM     eCurIndex;        ///< cyurrent index                  
+static  SCHDMNGRINTERVAL    atIntervals[ SCHDMNGR_MAX_INTERVALS ];  ///< compiled intervals
+static  U16                 wNumIntervals;    ///< number of intervals
+static  BOOL                bCompiled;        ///< intervals are valid
 
 // local function prototypes --------------------------------------------------
-static  SCHDMNGRDEFENUM     FindScheduleEntry( void );
+static  SCHDMNGRDEFENUM     FindScheduleEntry( U8 nDayOfWeek, U16 wCurTime );
 static  void                ProcessScheduleChange( SCHDMNGRDEFENUM eIndex );
+static  void                CompileSchedule( void );
+static  U16                 NextBoundary( U16 wMinutes );
+static  void                EvaluateSchedule( void );
 
 // constant parameter initializations -----------------------------------------
 
@@ -71,6 +88,10 @@ void ScheduleManager_Initialize( void )
 {
   // set the index to default
   eCurIndex = SCHDMNGRDEF_ENUM_DFLT;
+
+  // compile the schedule/evaluate it when the task runs
+  CompileSchedule( );
+  TaskManager_PostEvent( SCHDMNGR_TASK_ENUM, SCHDMNGR_EVENT_TIMECHANGE );
 }
 
 /******************************************************************************
@@ -150,7 +171,10 @@ SCHDMNGRERROR ScheduleManager_SetSchdRule( SCHDMNGRDEFENUM eRuleIndex, PSCHDMNGR
   if ( eRuleIndex < SCHDMNGRDEF_ENUM_MAX )
   {
     // copy the data
-    memcpy(( PSCHDMNGRDEFENTRY )&tSchdDefTable.atRules[ eRuleIndex ], ptRule, SCHDMNGRDEFENTRY_SIZE );
+    memcpy( &tSchedule.atEntries[ eRuleIndex ], ptRule, SCHDMNGRDEFENTRY_SIZE );
+
+    // recompile the schedule
+    TaskManager_PostEvent( SCHDMNGR_TASK_ENUM, SCHDMNGR_EVENT_SCHDCHANGE );
 
     // check for an update of the NV
     if ( bUpdateNVRom )
@@ -164,6 +188,9 @@ SCHDMNGRERROR ScheduleManager_SetSchdRule( SCHDMNGRDEFENUM eRuleIndex, PSCHDMNGR
     // report the error
     eError = SCHDMNGR_ERROR_ILLRULEINDEX;
   }
+
+  // return the error
+  return( eError );
 }
 
 /******************************************************************************
@@ -187,13 +214,16 @@ SCHDMNGRERROR ScheduleManager_GetSchdRule( SCHDMNGRDEFENUM eRuleIndex, PSCHDMNGR
   if ( eRuleIndex < SCHDMNGRDEF_ENUM_MAX )
   {
     // set the pointer to the entry
-    *( pptRule ) = ( PSCHDMNGRDEFENTRY )&tSchdDefTable.atRules[ eRuleIndex ];
+    *( pptRule ) = &tSchedule.atEntries[ eRuleIndex ];
   }
   else
   {
     // report the error
     eError = SCHDMNGR_ERROR_ILLRULEINDEX;
   }
+
+  // return the error
+  return( eError );
 }
 
 /******************************************************************************
@@ -248,6 +278,36 @@ void ScheduleManager_ForceNVRomUpdate( void )
   TaskManager_PostEvent( SCHDMNGR_CONFIGCHANGE_ENUM, CONFIG_TYPE_SCHDMNGR );
 }
 
+/******************************************************************************
+ * @function ScheduleManager_TimeChanged
+ *
+ * @brief the time has changed
+ *
+ * This function must be called when the RTC is set or the time zone changes,
+ * the schedule is evaluated and the timer re-armed for the new time
+ *
+ *****************************************************************************/
+void ScheduleManager_TimeChanged( void )
+{
+  // post the event
+  TaskManager_PostEvent( SCHDMNGR_TASK_ENUM, SCHDMNGR_EVENT_TIMECHANGE );
+}
+
+/******************************************************************************
+ * @function ScheduleManager_ScheduleChanged
+ *
+ * @brief the schedule has changed
+ *
+ * This function must be called when the actual table is changed other than
+ * with ScheduleManager_SetSchdRule, such as when it is loaded from NV
+ *
+ *****************************************************************************/
+void ScheduleManager_ScheduleChanged( void )
+{
+  // post the event
+  TaskManager_PostEvent( SCHDMNGR_TASK_ENUM, SCHDMNGR_EVENT_SCHDCHANGE );
+}
+
 /******************************************************************************
  * @function ScheduleManager_GetScheduleIndex
  *
@@ -276,29 +336,219 @@ U8 ScheduleManager_GetScheduleIndex( void )
  *****************************************************************************/
 BOOL ScheduleManager_ProcessEvent( TASKARG xArg )
 {
-   SCHDMNGRDEFENUM eNewIndex;
-
   // add the event for debug
   #if ( SCHDMNGR_ENABLE_DEBUG == 1 )
-  DebugManager_AddElement( SCHDMMNGR_DEBUG_BASEE | tStateCtl.nCurState, xArg  );
+  DebugManager_AddElement( SCHDMMNGR_DEBUG_BASE | eCurIndex, xArg  );
   #endif // SCHDMMNGR_DEBUG_BASE
 
-  // process the timeout event
-  if ( xArg == TASK_TIMEOUT_EVENT )
+  // process the event
+  switch( xArg )
   {
-    // find a schedule entry
-    eNewIndex = FindScheduleEntry( );
+    case SCHDMNGR_EVENT_SCHDCHANGE :
+      // recompile/evaluate
+      CompileSchedule( );
+      EvaluateSchedule( );
+      break;
+
+    case SCHDMNGR_EVENT_TIMECHANGE :
+    case TASK_TIMEOUT_EVENT :
+      // evaluate
+      EvaluateSchedule( );
+      break;
+
+    default :
+      break;
+  }
 
-    // check to see if different
-    if ( eNewIndex != eCurIndex )
+  // return the status
+  return( TRUE );
+}
+
+/******************************************************************************
+ * @function   EvaluateSchedule
+ *
+ * @brief evaluate the schedule
+ *
+ * This function will find the interval for the current time, process a
+ * change and arm the timer for the next transition.  Without a valid RTC or a
+ * compiled schedule it is checked every minute
+ *
+ *****************************************************************************/
+static void EvaluateSchedule( void )
+{
+  SCHDMNGRDEFENUM eNewIndex = SCHDMNGRDEF_ENUM_DFLT;
+  DATETIME        tTime;
+  U16             wCurMins, wLow, wHigh, wMid, wNextMins;
+  U32             uDelaySecs = SECS_PER_MIN;
+  U8              nDay;
+
+  // check for valid RTC time
+  if ( ScheduleManager_CheckValidDateTime( ) == TRUE )
+  {
+    // get the current time
+    ScheduleManager_GetDateTime( &tTime );
+    nDay = tTime.nDayOfWeek - SCHDMNGR_DOW_FIRST;
+    wCurMins = SCHD_TIME_MINS( tTime.nHours, tTime.nMinutes );
+
+    // check for a usable day
+    if (( bCompiled ) && ( nDay < DAYS_PER_WEEK ) && ( wCurMins < MINS_PER_DAY ))
+    {
+      // find the last interval starting at or before now, the first starts at 0
+      wCurMins += nDay * MINS_PER_DAY;
+      wLow = 0;
+      wHigh = wNumIntervals - 1;
+      while ( wLow < wHigh )
+      {
+        wMid = ( wLow + wHigh + 1 ) / 2;
+        if ( atIntervals[ wMid ].wStartMins <= wCurMins )
+        {
+          wLow = wMid;
+        }
+        else
+        {
+          wHigh = wMid - 1;
+        }
+      }
+      eNewIndex = ( SCHDMNGRDEFENUM )atIntervals[ wLow ].nIndex;
+
+      // get the next transition, the week wraps if the last interval matches the first
+      if ( wLow + 1 < wNumIntervals )
+      {
+        wNextMins = atIntervals[ wLow + 1 ].wStartMins;
+      }
+      else if (( atIntervals[ 0 ].nIndex != eNewIndex ) || ( wNumIntervals == 1 ))
+      {
+        wNextMins = MINS_PER_WEEK;
+      }
+      else
+      {
+        wNextMins = MINS_PER_WEEK + atIntervals[ 1 ].wStartMins;
+      }
+
+      // compute the delay to just past the transition
+      uDelaySecs = ((( U32 )( wNextMins - wCurMins ) * SECS_PER_MIN ) - tTime.nSeconds ) + SCHDMNGR_TIMER_GUARD_SECS;
+      uDelaySecs = MIN( uDelaySecs, ( SCHDMNGR_MAX_TIMER_MINS * SECS_PER_MIN ));
+    }
+    else
     {
-      // process the new schedule entry
-      ProcessScheduleChange( eNewIndex );
+      // scan the table
+      eNewIndex = FindScheduleEntry( tTime.nDayOfWeek, wCurMins );
     }
   }
 
-  // return the status
-  return( TRUE );
+  // check to see if different
+  if ( eNewIndex != eCurIndex )
+  {
+    // process the new schedule entry
+    ProcessScheduleChange( eNewIndex );
+  }
+
+  // arm the timer
+  TaskManager_StartTimer( SCHDMNGR_TASK_ENUM, uDelaySecs * TASK_TIME_SECS( 1 ));
+}
+
+/******************************************************************************
+ * @function   CompileSchedule
+ *
+ * @brief compile the schedule
+ *
+ * This function sweeps the week from one boundary, the start or the minute
+ * after the stop of an entry on a day, to the next and resolves each with the
+ * table search, only boundaries that change the index are kept
+ *
+ *****************************************************************************/
+static void CompileSchedule( void )
+{
+  SCHDMNGRDEFENUM   eIndex;
+  U16               wMinutes = 0;
+
+  // start with the beginning of the week
+  atIntervals[ 0 ].wStartMins = 0;
+  atIntervals[ 0 ].nIndex = FindScheduleEntry( SCHDMNGR_DOW_FIRST, 0 );
+  wNumIntervals = 1;
+  bCompiled = TRUE;
+
+  // sweep the boundaries
+  while (( bCompiled ) && (( wMinutes = NextBoundary( wMinutes )) < MINS_PER_WEEK ))
+  {
+    // resolve it/add it if the index changes
+    eIndex = FindScheduleEntry(( wMinutes / MINS_PER_DAY ) + SCHDMNGR_DOW_FIRST, wMinutes % MINS_PER_DAY );
+    if ( atIntervals[ wNumIntervals - 1 ].nIndex != eIndex )
+    {
+      if ( wNumIntervals < SCHDMNGR_MAX_INTERVALS )
+      {
+        atIntervals[ wNumIntervals ].wStartMins = wMinutes;
+        atIntervals[ wNumIntervals++ ].nIndex = eIndex;
+      }
+      else
+      {
+        // too many, scan instead
+        bCompiled = FALSE;
+        
+        // report the boundary that overflowed
+        #if ( SCHDMNGR_ENABLE_DEBUG == 1 )
+        DebugManager_AddElement( SCHDMMNGR_DEBUG_OVERFLOW, wMinutes );
+        #endif // SCHDMNGR_ENABLE_DEBUG
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function   NextBoundary
+ *
+ * @brief find the next boundary
+ *
+ * This function finds the first minute of the week after the given one
+ * where an entry starts or stops
+ *
+ * @param[in]   wMinutes    minutes of the week
+ *
+ * @return      next boundary, or minutes per week if none
+ *
+ *****************************************************************************/
+static U16 NextBoundary( U16 wMinutes )
+{
+  SCHDMNGRDEFENTRY  tEntry;
+  SCHDMNGRDEFENUM   eIndex;
+  U16               wNext = MINS_PER_WEEK, wBase, wStart, wStop;
+  U8                nDay;
+
+  // for each entry
+  for ( eIndex = SCHDMNGRDEF_ENUM_MAX - 1; eIndex > SCHDMNGRDEF_ENUM_DFLT; eIndex-- )
+  {
+    // copy the data
+    MEMCPY_P( &tEntry, &tSchedule.atEntries[ eIndex ], SCHDMNGRDEFENTRY_SIZE );
+
+    // only valid entries that can match
+    if (( tEntry.tStartTime.nDayOfWeek != SCHDMNGR_DOW_ILLEGAL ) && ( tEntry.tStartTime.wHrsMins <= tEntry.tStopTime.wHrsMins ) &&
+        ( tEntry.tStartTime.wHrsMins < MINS_PER_DAY ))
+    {
+      // the stop boundary is the minute after, at most the end of the day
+      wStart = tEntry.tStartTime.wHrsMins;
+      wStop = MIN( tEntry.tStopTime.wHrsMins + 1, MINS_PER_DAY );
+
+      // check each day in the week
+      for ( nDay = SCHDMNGR_DOW_FIRST; nDay < SCHDMNGR_DOW_FIRST + DAYS_PER_WEEK; nDay++ )
+      {
+        if (( nDay >= tEntry.tStartTime.nDayOfWeek ) && ( nDay <= tEntry.tStopTime.nDayOfWeek ))
+        {
+          wBase = ( nDay - SCHDMNGR_DOW_FIRST ) * MINS_PER_DAY;
+          if (( wBase + wStart > wMinutes ) && ( wBase + wStart < wNext ))
+          {
+            wNext = wBase + wStart;
+          }
+          if (( wBase + wStop > wMinutes ) && ( wBase + wStop < wNext ))
+          {
+            wNext = wBase + wStop;
+          }
+        }
+      }
+    }
+  }
+
+  // return the next boundary
+  return( wNext );
 }
 
 /******************************************************************************
@@ -326,7 +576,7 @@ static void ProcessScheduleChange( SCHDMNGRDEFENUM eIndex )
   for( eExternalIndex = 0; eExternalIndex < SCHDMNGREXT_ENUM_MAX; eExternalIndex++ )
   {
     // now fetch the set rule function
-    pvSetRuleIndex = ( PVSETRULEINDEX )PGM_RDWORD( tSchdExtTable.atExtRules[ eIndex ].pvSetRuleIndex );
+    pvSetRuleIndex = ( PVSETRULEINDEX )PGM_RDWORD( tSchdExtTable.atExtRules[ eExternalIndex ].pvSetRuleIndex );
 
     // get the rule index
     tRuleIndex = PGM_RDBYTE( tSchedule.atRules[ eIndex ].atRuleIndex[ eExternalIndex ]);
@@ -339,58 +589,46 @@ static void ProcessScheduleChange( SCHDMNGRDEFENUM eIndex )
 /******************************************************************************
  * @function FindScheduleEntry
  *
- * @brief find a schedule entry which matches our current time
+ * @brief find a schedule entry which matches a time
+ *
+ * This function will attempt to find a schedule entry that matches a day of
+ * the week and time, the last matching entry wins
  *
- * This function will attempt to find a schedule entry that matches our 
- * current time
+ * @param[in]   nDayOfWeek  day of the week
+ * @param[in]   wCurTime    time in minutes of the day
  *
  * @return      rule index
  *
  *****************************************************************************/
-static SCHDMNGRDEFENUM FindScheduleEntry( void )
+static SCHDMNGRDEFENUM FindScheduleEntry( U8 nDayOfWeek, U16 wCurTime )
 {
   SCHDMNGRDEFENTRY  tEntry;
   SCHDMNGRDEFENUM   eIndex;
-  DATETIME          tTime;
-  U16               wCurTime;
 
-  // check for valid RTC time
-  if ( ScheduleManager_CheckValidDateTime( ) == TRUE )
+  // for each schedule entry - search in reverse order
+  for ( eIndex = SCHDMNGRDEF_ENUM_MAX - 1; eIndex > SCHDMNGRDEF_ENUM_DFLT; eIndex-- )
   {
-    // get the current time
-    ScheduleManager_GetDateTime( &tTime );
-    wCurTime = SCHD_TIME_MINS( tTime.nHours, tTime.nMinutes );
+    // copy the data
+    MEMCPY_P( &tEntry, &tSchedule.atEntries[ eIndex ], SCHDMNGRDEFENTRY_SIZE );
 
-    // for each schedule entry - search in reverse order
-    for ( eIndex = SCHDMNGRDEF_ENUM_MAX; eIndex > 0; eIndex-- )
+    // first test for a valid entry
+    if ( tEntry.tStartTime.nDayOfWeek != SCHDMNGR_DOW_ILLEGAL )
     {
-      // copy the data
-      MEMCPY_P( &tEntry, &tSchedule.atEntries[ eIndex ], SCHDMNGRDEFENTRY_SIZE );
-
-      // first test for a valid entry
-      if ( tEntry.tStartTime.nDayOfWeek != SCHDMNGR_DOW_ILLEGAL )
+      // compare for day of week
+      if (( nDayOfWeek >= tEntry.tStartTime.nDayOfWeek ) && ( nDayOfWeek <= tEntry.tStopTime.nDayOfWeek ))
       {
-        // compare for day of week
-        if (( tTime.nDayOfWeek >= tEntry.tStartTime.nDayOfWeek ) && ( tTime.nDayOfWeek <= tEntry.tStopTime.nDayOfWeek ))
+        // compare for hour
+        if (( wCurTime >= tEntry.tStartTime.wHrsMins ) && ( wCurTime <= tEntry.tStopTime.wHrsMins ))
         {
-          // compare for hour
-          if (( wCurTime >= tEntry.tStartTime.wHrsMins ) && ( wCurTime <= tEntry.tStopTime.wHrsMins ))
-          {
-            // break out of the search index
-            break;
-          }
+          // break out of the search index
+          break;
         }
       }
     }
   }
-  else
-  {
-    // return the default index
-    eIndex = SCHDMNGRDEF_ENUM_DFLT;
-  }
 
   // return the indes
   return( eIndex );
 }
 
-/**@} EOF .c */
+/**@} EOF ScheduleManager.c */
@@ -42,6 +42,10 @@
 /// define the execution rate
 #define SCHDMNGR_EXEC_RATE           ( TASK_TIME_MINS( 1 ))
 
+/// define the events
+#define SCHDMNGR_EVENT_TIMECHANGE    ( 0xC0 )
+#define SCHDMNGR_EVENT_SCHDCHANGE    ( 0xC1 )
+
 // enumerations ---------------------------------------------------------------
 /// enumerate the errors
 typedef enum _SCHDMNGRERROR
@@ -64,6 +68,8 @@ extern  SCHDMNGRERROR       ScheduleManager_GetSchdRule( SCHDMNGRDEFENUM eRuleIn
 extern  SCHDMNGRERROR       ScheduleManager_SetScheduleIndex( SCHDMNGRDEFENUM eScheduleIndex );
 extern  U8                  ScheduleManager_GetScheduleIndex( void );
 extern  void                ScheduleManager_ForceNVRomUpdate( void );
+extern  void                ScheduleManager_TimeChanged( void );
+extern  void                ScheduleManager_ScheduleChanged( void );
 extern  BOOL                ScheduleManager_ProcessEvent( TASKARG xArg );
 
 /**@} EOF ScheduleManager.h */
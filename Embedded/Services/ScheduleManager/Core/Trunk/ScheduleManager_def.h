@@ -38,6 +38,10 @@
 /// define the mins in an hour
 #define MINS_PER_HOUR                   ( 60 )
 #define HOURS_PER_DAY                   ( 24 )
+#define DAYS_PER_WEEK                   ( 7 )
+#define SECS_PER_MIN                    ( 60 )
+#define MINS_PER_DAY                    ( MINS_PER_HOUR * HOURS_PER_DAY )
+#define MINS_PER_WEEK                   ( MINS_PER_DAY * DAYS_PER_WEEK )
 
 /// define the macro for converting hours/mins to a value
 #define SCHD_TIME_MINS(hrs, mins)       (( hrs * MINS_PER_HOUR) + mins)
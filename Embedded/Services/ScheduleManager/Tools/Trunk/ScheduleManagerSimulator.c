@@ -0,0 +1,510 @@
+/******************************************************************************
+ * @file ScheduleManagerSimulator.c
+ *
+ * @brief schedule manager simulator
+ *
+ * This file provides a host tool that runs the schedule manager against a
+ * simulated clock for a year.  It replaces ScheduleManager_cfg.c and the task
+ * manager timer, builds random schedules and checks the index at the end of
+ * every minute against the reverse order table scan the manager used to run
+ * every minute.  Along the way the RTC is set forward and back, the time zone
+ * changes for daylight saving and a rule is rewritten.  It exits non zero on
+ * any mismatch.
+ *
+ * build with: cc -O2 -I. -I<include root> -o ScheduleManagerSimulator
+ *             ScheduleManagerSimulator.c ../../Core/Trunk/ScheduleManager.c
+ * usage:      ScheduleManagerSimulator [schedules] [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup schedulerManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "ScheduleManager/ScheduleManager.h"
+#include "ScheduleManager/ScheduleManager_prm.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default number of schedules/seed
+#define DEFAULT_SCHEDULES                           ( 8 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the length of the run
+#define SECS_PER_DAY                                ( 86400L )
+#define RUN_DAYS                                    ( 365 )
+
+/// define the time changes, RTC sets are random, daylight saving on fixed days
+#define NUM_RTC_SETS                                ( 12 )
+#define DST_START_DAY                               ( 69 )
+#define DST_STOP_DAY                                ( 307 )
+#define DST_HOUR                                    ( 2 )
+#define RULE_CHANGE_DAY                             ( 180 )
+
+/// define the number of events that can be pending
+#define MAX_PENDING                                 ( 8 )
+
+// structures -----------------------------------------------------------------
+/// define the time change
+typedef struct _TIMECHANGE
+{
+  long      lTime;              ///< time of the change in UTC seconds
+  long      lClockDelta;        ///< RTC set delta in seconds
+  long      lZoneDelta;         ///< zone delta in seconds
+} TIMECHANGE;
+
+// global parameter declarations ----------------------------------------------
+const CODE  SCHDMNGRDEFTBL    tSchdDefTable;
+const CODE  SCHDMNGREXTTBL    tSchdExtTable;
+
+// local parameter declarations -----------------------------------------------
+static  long            lUtcTime;
+static  long            lClockOffset;
+static  long            lZoneOffset;
+static  BOOL            bRtcValid;
+static  BOOL            bTimerOn;
+static  long            lTimerTime;
+static  TASKARG         axPending[ MAX_PENDING ];
+static  U8              nNumPending;
+static  SCHDMNGRDEFTBL  tRefTable;
+static  unsigned long   ulState;
+static  unsigned        uWakeups;
+static  unsigned        uTimerArms;
+
+// local function prototypes --------------------------------------------------
+static  void            RandomSchedule( void );
+static  U32             Random( U32 uRange );
+static  SCHDMNGRDEFENUM ReferenceScan( long lLocalTime );
+static  long            LocalTime( void );
+static  void            Deliver( void );
+static  unsigned        RunYear( unsigned uSchedule );
+static  void            CheckIntervals( unsigned uSchedule );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * This function runs each schedule for a year
+ *
+ * @param[in]   argc        argument count
+ * @param[in]   argv        arguments
+ *
+ * @return      0 if all schedules matched
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  unsigned  uSchedules, uSchedule, uErrors = 0;
+
+  // get the arguments
+  uSchedules = ( argc > 1 ) ? ( unsigned )atoi( argv[ 1 ] ) : DEFAULT_SCHEDULES;
+  ulState = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 0 ) : DEFAULT_SEED;
+
+  // run each schedule
+  for ( uSchedule = 0; uSchedule < uSchedules; uSchedule++ )
+  {
+    uErrors += RunYear( uSchedule );
+  }
+
+  // report
+  printf( "%s, %u mismatched minutes\n", ( uErrors == 0 ) ? "PASS" : "FAIL", uErrors );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function RunYear
+ *
+ * @brief run a schedule for a year
+ *
+ * This function runs a random schedule for a year, checking the index at the
+ * end of every minute
+ *
+ * @param[in]   uSchedule   schedule number
+ *
+ * @return      number of mismatched minutes
+ *
+ *****************************************************************************/
+static unsigned RunYear( unsigned uSchedule )
+{
+  TIMECHANGE        atChanges[ NUM_RTC_SETS + 3 ];
+  TIMECHANGE        tSwap;
+  SCHDMNGRDEFENTRY  tRule;
+  SCHDMNGRDEFENUM   eRefIndex, eLastIndex = SCHDMNGRDEF_ENUM_DFLT;
+  unsigned          uChange, uNumChanges = 0, uErrors = 0, uTransitions = 0, uIdx;
+  long              lNextCheck, lNext, lEnd;
+
+  // build the schedule/load it as the config manager would
+  RandomSchedule( );
+  memcpy( ScheduleManager_GetActlTable( ), &tRefTable, SCHDMNGRDEFTBL_SIZE );
+  CheckIntervals( uSchedule );
+
+  // build the time changes, RTC sets of up to two days either way
+  for ( uChange = 0; uChange < NUM_RTC_SETS; uChange++ )
+  {
+    atChanges[ uNumChanges ].lTime = 60 + Random( RUN_DAYS * SECS_PER_DAY - 120 );
+    atChanges[ uNumChanges ].lClockDelta = ( long )Random( 4 * SECS_PER_DAY ) - ( 2 * SECS_PER_DAY );
+    atChanges[ uNumChanges++ ].lZoneDelta = 0;
+  }
+  atChanges[ uNumChanges ].lTime = ( DST_START_DAY * SECS_PER_DAY ) + ( DST_HOUR * 3600 );
+  atChanges[ uNumChanges ].lClockDelta = 0;
+  atChanges[ uNumChanges++ ].lZoneDelta = 3600;
+  atChanges[ uNumChanges ].lTime = ( DST_STOP_DAY * SECS_PER_DAY ) + ( DST_HOUR * 3600 );
+  atChanges[ uNumChanges ].lClockDelta = 0;
+  atChanges[ uNumChanges++ ].lZoneDelta = -3600;
+
+  // sort them
+  for ( uChange = 1; uChange < uNumChanges; uChange++ )
+  {
+    for ( uIdx = uChange; ( uIdx > 0 ) && ( atChanges[ uIdx - 1 ].lTime > atChanges[ uIdx ].lTime ); uIdx-- )
+    {
+      tSwap = atChanges[ uIdx ];
+      atChanges[ uIdx ] = atChanges[ uIdx - 1 ];
+      atChanges[ uIdx - 1 ] = tSwap;
+    }
+  }
+
+  // start with an invalid RTC, it is set a minute later
+  lUtcTime = 0;
+  lClockOffset = 0;
+  lZoneOffset = 0;
+  bRtcValid = FALSE;
+  bTimerOn = FALSE;
+  nNumPending = 0;
+  uWakeups = uTimerArms = 0;
+  ScheduleManager_Initialize( );
+  ScheduleManager_ScheduleChanged( );
+  Deliver( );
+
+  // run it
+  lEnd = RUN_DAYS * SECS_PER_DAY;
+  lNextCheck = 59;
+  uChange = 0;
+  while ( lUtcTime < lEnd )
+  {
+    // find the next thing to happen
+    lNext = lNextCheck;
+    if (( bTimerOn ) && ( lTimerTime < lNext ))
+    {
+      lNext = lTimerTime;
+    }
+    if (( uChange < uNumChanges ) && ( atChanges[ uChange ].lTime < lNext ))
+    {
+      lNext = atChanges[ uChange ].lTime;
+    }
+    if (( !bRtcValid ) && ( lNext > 60 ))
+    {
+      lNext = 60;
+    }
+    lUtcTime = lNext;
+
+    // process it
+    if (( !bRtcValid ) && ( lUtcTime == 60 ))
+    {
+      // the RTC is set
+      bRtcValid = TRUE;
+      ScheduleManager_TimeChanged( );
+    }
+    if (( bTimerOn ) && ( lTimerTime == lUtcTime ))
+    {
+      // timer expired
+      bTimerOn = FALSE;
+      uWakeups++;
+      ScheduleManager_ProcessEvent( TASK_TIMEOUT_EVENT );
+    }
+    if (( uChange < uNumChanges ) && ( atChanges[ uChange ].lTime == lUtcTime ))
+    {
+      // set the clock/zone, whole minutes as an RTC set from a minute display
+      lClockOffset += ( atChanges[ uChange ].lClockDelta / 60 ) * 60;
+      lZoneOffset += atChanges[ uChange ].lZoneDelta;
+      uChange++;
+      ScheduleManager_TimeChanged( );
+    }
+    if ( lUtcTime == ( RULE_CHANGE_DAY * SECS_PER_DAY ) + 59 - 60 * 30 )
+    {
+      // rewrite a rule to cover the afternoon all week
+      tRule.tStartTime.nDayOfWeek = SCHDMNGR_DOW_FIRST;
+      tRule.tStartTime.wHrsMins = SCHD_TIME_MINS( 12, 0 );
+      tRule.tStopTime.nDayOfWeek = SCHDMNGR_DOW_FIRST + DAYS_PER_WEEK - 1;
+      tRule.tStopTime.wHrsMins = SCHD_TIME_MINS( 17, 59 );
+      memcpy( &tRefTable.atEntries[ SCHDMNGRDEF_ENUM_MAX - 1 ], &tRule, SCHDMNGRDEFENTRY_SIZE );
+      ScheduleManager_SetSchdRule( SCHDMNGRDEF_ENUM_MAX - 1, &tRule, FALSE );
+      CheckIntervals( uSchedule );
+    }
+    Deliver( );
+
+    // check at the end of each minute
+    if ( lUtcTime == lNextCheck )
+    {
+      eRefIndex = ( bRtcValid ) ? ReferenceScan( LocalTime( )) : SCHDMNGRDEF_ENUM_DFLT;
+      if ( eRefIndex != ScheduleManager_GetScheduleIndex( ))
+      {
+        if ( uErrors++ < 10 )
+        {
+          printf( "  schedule %u at %ld: index %u, scan %u\n", uSchedule, LocalTime( ), ScheduleManager_GetScheduleIndex( ), eRefIndex );
+        }
+      }
+      if ( eRefIndex != eLastIndex )
+      {
+        uTransitions++;
+        eLastIndex = eRefIndex;
+      }
+      lNextCheck += 60;
+    }
+  }
+
+  // report
+  printf( "schedule %u: %u transitions, %u wakeups, %u timer arms instead of %ld minute scans, %u mismatches\n",
+          uSchedule, uTransitions, uWakeups, uTimerArms, lEnd / 60, uErrors );
+  return( uErrors );
+}
+
+/******************************************************************************
+ * @function CheckIntervals
+ *
+ * @brief check the compiled interval count
+ *
+ * This function sweeps the week with the reference scan and reports when
+ * the schedule has more intervals than the manager compiles, in which case
+ * it falls back to scanning every minute
+ *
+ * @param[in]   uSchedule   schedule number
+ *
+ *****************************************************************************/
+static void CheckIntervals( unsigned uSchedule )
+{
+  SCHDMNGRDEFENUM eIndex, eLastIndex;
+  unsigned        uIntervals = 1;
+  long            lMinute;
+
+  // count the index changes over the week
+  eLastIndex = ReferenceScan( 0 );
+  for ( lMinute = 1; lMinute < MINS_PER_WEEK; lMinute++ )
+  {
+    eIndex = ReferenceScan( lMinute * 60 );
+    if ( eIndex != eLastIndex )
+    {
+      uIntervals++;
+      eLastIndex = eIndex;
+    }
+  }
+
+  // report an overflow
+  if ( uIntervals > SCHDMNGR_MAX_INTERVALS )
+  {
+    printf( "  schedule %u: %u intervals exceed SCHDMNGR_MAX_INTERVALS (%u), scanning every minute\n",
+            uSchedule, uIntervals, SCHDMNGR_MAX_INTERVALS );
+  }
+}
+
+/******************************************************************************
+ * @function RandomSchedule
+ *
+ * @brief build a random schedule
+ *
+ * This function fills the reference table with random entries, some of
+ * them illegal, inverted or ending at midnight
+ *
+ *****************************************************************************/
+static void RandomSchedule( void )
+{
+  PSCHDMNGRDEFENTRY ptEntry;
+  U8                nIdx, nNumEntries;
+
+  // clear it
+  memset( &tRefTable, 0, SCHDMNGRDEFTBL_SIZE );
+  nNumEntries = 1 + Random( SCHDMNGRDEF_ENUM_MAX - 1 );
+
+  // fill the entries
+  for ( nIdx = 1; nIdx < SCHDMNGRDEF_ENUM_MAX; nIdx++ )
+  {
+    ptEntry = &tRefTable.atEntries[ nIdx ];
+    if (( nIdx > nNumEntries ) || ( Random( 10 ) == 0 ))
+    {
+      ptEntry->tStartTime.nDayOfWeek = SCHDMNGR_DOW_ILLEGAL;
+    }
+    else
+    {
+      ptEntry->tStartTime.nDayOfWeek = SCHDMNGR_DOW_FIRST + Random( DAYS_PER_WEEK );
+      ptEntry->tStopTime.nDayOfWeek = ptEntry->tStartTime.nDayOfWeek + Random( SCHDMNGR_DOW_FIRST + DAYS_PER_WEEK - ptEntry->tStartTime.nDayOfWeek );
+      ptEntry->tStartTime.wHrsMins = Random( MINS_PER_DAY );
+      ptEntry->tStopTime.wHrsMins = ptEntry->tStartTime.wHrsMins + Random( MINS_PER_DAY - ptEntry->tStartTime.wHrsMins );
+      if ( Random( 8 ) == 0 )
+      {
+        // end at midnight
+        ptEntry->tStopTime.wHrsMins = MINS_PER_DAY - 1;
+      }
+      else if ( Random( 16 ) == 0 )
+      {
+        // inverted, never matches
+        ptEntry->tStopTime.wHrsMins = ptEntry->tStartTime.wHrsMins / 2;
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief get a random number
+ *
+ * This function returns a pseudo random number in a range
+ *
+ * @param[in]   uRange      range
+ *
+ * @return      number from 0 to range - 1
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // next state
+  ulState = ( ulState * 6364136223846793005ULL ) + 1442695040888963407ULL;
+  return(( U32 )(( ulState >> 33 ) % uRange ));
+}
+
+/******************************************************************************
+ * @function ReferenceScan
+ *
+ * @brief reference table scan
+ *
+ * This function is the per minute scan the manager used, the last matching
+ * entry wins and the default is index zero
+ *
+ * @param[in]   lLocalTime  local time in seconds
+ *
+ * @return      schedule index
+ *
+ *****************************************************************************/
+static SCHDMNGRDEFENUM ReferenceScan( long lLocalTime )
+{
+  PSCHDMNGRDEFENTRY ptEntry;
+  SCHDMNGRDEFENUM   eIndex;
+  U8                nDayOfWeek;
+  U16               wCurTime;
+
+  // get the day/time
+  nDayOfWeek = SCHDMNGR_DOW_FIRST + (( lLocalTime / SECS_PER_DAY ) % DAYS_PER_WEEK );
+  wCurTime = ( lLocalTime % SECS_PER_DAY ) / 60;
+
+  // for each schedule entry - search in reverse order
+  for ( eIndex = SCHDMNGRDEF_ENUM_MAX - 1; eIndex > 0; eIndex-- )
+  {
+    ptEntry = &tRefTable.atEntries[ eIndex ];
+    if (( ptEntry->tStartTime.nDayOfWeek != SCHDMNGR_DOW_ILLEGAL ) &&
+        ( nDayOfWeek >= ptEntry->tStartTime.nDayOfWeek ) && ( nDayOfWeek <= ptEntry->tStopTime.nDayOfWeek ) &&
+        ( wCurTime >= ptEntry->tStartTime.wHrsMins ) && ( wCurTime <= ptEntry->tStopTime.wHrsMins ))
+    {
+      break;
+    }
+  }
+
+  // return the index
+  return( eIndex );
+}
+
+/******************************************************************************
+ * @function LocalTime
+ *
+ * @brief get the local time
+ *
+ * This function returns the local time the RTC shows, kept positive
+ *
+ * @return      local time in seconds
+ *
+ *****************************************************************************/
+static long LocalTime( void )
+{
+  long  lTime = lUtcTime + lClockOffset + lZoneOffset;
+
+  // keep it positive
+  while ( lTime < 0 )
+  {
+    lTime += DAYS_PER_WEEK * SECS_PER_DAY;
+  }
+  return( lTime );
+}
+
+/******************************************************************************
+ * @function Deliver
+ *
+ * @brief deliver the pending events
+ *
+ * This function runs the task for each posted event
+ *
+ *****************************************************************************/
+static void Deliver( void )
+{
+  U8  nIdx;
+
+  // process them in order
+  for ( nIdx = 0; nIdx < nNumPending; nIdx++ )
+  {
+    ScheduleManager_ProcessEvent( axPending[ nIdx ] );
+  }
+  nNumPending = 0;
+}
+
+//******************************************************************************
+// schedule manager configuration functions
+//******************************************************************************
+BOOL ScheduleManager_CheckValidDateTime( void )
+{
+  // return the valid status
+  return( bRtcValid );
+}
+
+void ScheduleManager_GetDateTime( PDATETIME ptDateTime )
+{
+  long  lTime = LocalTime( );
+
+  // fill it
+  memset( ptDateTime, 0, sizeof( DATETIME ));
+  ptDateTime->nDayOfWeek = SCHDMNGR_DOW_FIRST + (( lTime / SECS_PER_DAY ) % DAYS_PER_WEEK );
+  ptDateTime->nHours = ( lTime % SECS_PER_DAY ) / 3600;
+  ptDateTime->nMinutes = ( lTime % 3600 ) / 60;
+  ptDateTime->nSeconds = lTime % 60;
+}
+
+//******************************************************************************
+// task manager functions
+//******************************************************************************
+BOOL TaskManager_PostEvent( TASKSCHDENUMS eTask, TASKARG xArg )
+{
+  // only events for this task
+  if (( eTask == SCHDMNGR_TASK_ENUM ) && ( nNumPending < MAX_PENDING ))
+  {
+    axPending[ nNumPending++ ] = xArg;
+  }
+  return( TRUE );
+}
+
+BOOL TaskManager_StartTimer( TASKSCHDENUMS eTask, U32 uTime )
+{
+  // only this task arms a timer
+  ( void )eTask;
+
+  // arm it, whole seconds
+  bTimerOn = TRUE;
+  lTimerTime = lUtcTime + ( uTime / TASK_TIME_SECS( 1 ));
+  uTimerArms++;
+  return( TRUE );
+}
+
+/**@} EOF ScheduleManagerSimulator.c */
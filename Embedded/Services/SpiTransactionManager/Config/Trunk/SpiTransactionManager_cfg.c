@@ -0,0 +1,103 @@
+/******************************************************************************
+ * @file SpiTransactionManager_cfg.c
+ *
+ * @brief SPI transaction manager configuration implementation
+ *
+ * This file provides the device table and the process task hooks for the
+ * SPI transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+
+// local function prototypes --------------------------------------------------
+
+// constant parameter initializations -----------------------------------------
+/// fill out the device table
+const CODE SPITRANSDEVDEF g_atSpiTransDevDefs[ SPITRANS_DEV_ENUM_MAX ] =
+{
+  // SPITRANSDEVDEFM( bus, clkpol, clkphase, speed, chipselect )
+};
+
+/******************************************************************************
+ * @function SpiTransactionManager_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function will perform any custom initialization
+ *
+ *****************************************************************************/
+void SpiTransactionManager_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_LocalKick
+ *
+ * @brief kick the process
+ *
+ * This function is called when a transaction is submitted or work remains
+ * after a process pass, and should schedule SpiTransactionManager_Process
+ *
+ *****************************************************************************/
+void SpiTransactionManager_LocalKick( void )
+{
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+    // post an event to the process task
+    TaskManager_PostEvent( TASK_SCHD_ENUM_SPITRANS, 0 );
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+/******************************************************************************
+ * @function SpiTransactionManager_ProcessTask
+ *
+ * @brief process task
+ *
+ * This function will run a process pass
+ *
+ * @param[in]   xArg      task argument
+ *
+ * @return      TRUE to flush event
+ *
+ *****************************************************************************/
+BOOL SpiTransactionManager_ProcessTask( TASKARG xArg )
+{
+  // run a pass
+  SpiTransactionManager_Process( );
+
+  // return true to flush event
+  return( TRUE );
+}
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+/**@} EOF SpiTransactionManager_cfg.c */
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * @file SpiTransactionManager_prm.h
+ *
+ * @brief SPI transaction manager parameter declarations
+ *
+ * This file declares any customization for the SPI transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _SPITRANSACTIONMANAGER_PRM_H
+#define _SPITRANSACTIONMANAGER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the maximum number of phases in a transaction
+#define SPITRANSMNGR_MAX_PHASES                   ( 6 )
+
+/// define the number of bytes moved per bus on each process pass
+#define SPITRANSMNGR_BYTES_PER_PASS               ( 512 )
+
+/// define the byte clocked out for read and dummy phases
+#define SPITRANSMNGR_FILL_BYTE                    ( 0xFF )
+
+/**@} EOF SpiTransactionManager_prm.h */
+
+#endif  // _SPITRANSACTIONMANAGER_PRM_H
@@ -0,0 +1,615 @@
+/******************************************************************************
+ * @file SpiTransactionManager.c
+ *
+ * @brief SPI transaction manager implementation
+ *
+ * This file provides the implementation for the SPI transaction manager.
+ * A transaction is a chain of command, address, dummy and data phases that
+ * runs with the device chip select asserted.  Drivers submit transactions
+ * into a per device queue and return immediately.  Each process pass moves
+ * at most SPITRANSMNGR_BYTES_PER_PASS bytes per bus, so a long display or
+ * flash transfer is sliced across passes with the chip select held rather
+ * than blocking the caller.  The clock polarity, phase and speed are only
+ * reprogrammed when the next device on a bus differs from the last one
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+/// define the maximum command/address length
+#define MAX_VALUE_BYTES                         ( 4 )
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the device control structure
+typedef struct _DEVCTL
+{
+  PSPITRANSACTION   ptHead;         ///< queue head
+  PSPITRANSACTION   ptTail;         ///< queue tail
+  U32               uLastService;   ///< service stamp of the last transaction
+} DEVCTL, *PDEVCTL;
+#define DEVCTL_SIZE                             sizeof( DEVCTL )
+
+/// define the bus control structure
+typedef struct _BUSCTL
+{
+  PSPITRANSACTION   ptActive;       ///< active transaction
+  SPITRANSDEVENUM   eDevice;        ///< currently configured device
+} BUSCTL, *PBUSCTL;
+#define BUSCTL_SIZE                             sizeof( BUSCTL )
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  DEVCTL            atDevCtls[ SPITRANS_DEV_ENUM_MAX ];
+static  BUSCTL            atBusCtls[ SPI_DEV_ENUM_MAX ];
+static  U32               uServiceStamp;
+static  SPITRANSMNGRSTATS tStats;
+
+// local function prototypes --------------------------------------------------
+static  SPITRANSDEVENUM SelectNextDevice( SPIDEVENUM eBus );
+static  void            ConfigureBus( SPIDEVENUM eBus, SPITRANSDEVENUM eDevice );
+static  BOOL            RunPhases( SPIDEVENUM eBus, PSPITRANSACTION ptTrans, PU16 pwBudget );
+static  void            CompleteTransaction( PSPITRANSACTION ptTrans );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function SpiTransactionManager_Initialize
+ *
+ * @brief initialization
+ *
+ * This function will clear the queues and statistics
+ *
+ * @return      FALSE if no errors, TRUE otherwise
+ *
+ *****************************************************************************/
+BOOL SpiTransactionManager_Initialize( void )
+{
+  SPIDEVENUM  eBus;
+
+  // clear the queues/statistics
+  memset( atDevCtls, 0, sizeof( atDevCtls ));
+  memset( &tStats, 0, SPITRANSMNGRSTATS_SIZE );
+  uServiceStamp = 0;
+
+  // no device is configured on any bus yet
+  for ( eBus = 0; eBus < SPI_DEV_ENUM_MAX; eBus++ )
+  {
+    atBusCtls[ eBus ].ptActive = NULL;
+    atBusCtls[ eBus ].eDevice = SPITRANS_DEV_ENUM_ILLEGAL;
+  }
+
+  // call the local initialization
+  SpiTransactionManager_LocalInitialize( );
+
+  // return ok
+  return( FALSE );
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_Clear
+ *
+ * @brief clear a transaction
+ *
+ * This function will clear the phases and the completion callback/task
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ *****************************************************************************/
+void SpiTransactionManager_Clear( PSPITRANSACTION ptTrans )
+{
+  // clear it
+  memset( ptTrans, 0, SPITRANSACTION_SIZE );
+  ptTrans->pvCallback = NULL;
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  ptTrans->eTaskEnum = TASK_SCHD_ILLEGAL;
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_AddPhase
+ *
+ * @brief add a phase
+ *
+ * This function will append a phase to a transaction
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ * @param[in]   eType       phase type
+ * @param[in]   nNumBytes   command/address/dummy length
+ * @param[in]   uValue      command/address value
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wDataLen    data length
+ *
+ * @return      TRUE if the transaction is full, FALSE otherwise
+ *
+ *****************************************************************************/
+BOOL SpiTransactionManager_AddPhase( PSPITRANSACTION ptTrans, SPITRANSPHASETYPE eType, U8 nNumBytes, U32 uValue, PU8 pnData, U16 wDataLen )
+{
+  BOOL            bError = TRUE;
+  PSPITRANSPHASE  ptPhase;
+
+  // check for room
+  if ( ptTrans->nNumPhases < SPITRANSMNGR_MAX_PHASES )
+  {
+    // fill out the phase
+    ptPhase = &ptTrans->atPhases[ ptTrans->nNumPhases++ ];
+    ptPhase->eType = eType;
+    ptPhase->nNumBytes = nNumBytes;
+    ptPhase->uValue = uValue;
+    ptPhase->pnData = pnData;
+    ptPhase->wDataLen = wDataLen;
+    bError = FALSE;
+  }
+
+  // return the status
+  return( bError );
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_Submit
+ *
+ * @brief submit a transaction
+ *
+ * This function will append a transaction to the device queue, the
+ * transaction and its data buffers must remain valid until it completes
+ *
+ * @param[in]   eDevice     device enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ * @return      appropriate error
+ *
+ *****************************************************************************/
+SPITRANSMNGRERR SpiTransactionManager_Submit( SPITRANSDEVENUM eDevice, PSPITRANSACTION ptTrans )
+{
+  SPITRANSMNGRERR eError = SPITRANSMNGR_ERR_NONE;
+  PSPITRANSPHASE  ptPhase;
+  PDEVCTL         ptCtl;
+  U8              nPhase;
+
+  // check for a valid device
+  if ( eDevice >= SPITRANS_DEV_ENUM_MAX )
+  {
+    // illegal device
+    eError = SPITRANSMNGR_ERR_ILLDEV;
+  }
+  else if (( ptTrans == NULL ) || ( ptTrans->nNumPhases == 0 ) || ( ptTrans->nNumPhases > SPITRANSMNGR_MAX_PHASES ))
+  {
+    // illegal transaction
+    eError = SPITRANSMNGR_ERR_ILLPRM;
+  }
+  else if (( ptTrans->eStatus == SPITRANS_STS_QUEUED ) || ( ptTrans->eStatus == SPITRANS_STS_ACTIVE ))
+  {
+    // already in progress
+    eError = SPITRANSMNGR_ERR_BUSY;
+  }
+  else
+  {
+    // check each phase
+    for ( nPhase = 0; nPhase < ptTrans->nNumPhases; nPhase++ )
+    {
+      ptPhase = &ptTrans->atPhases[ nPhase ];
+      switch( ptPhase->eType )
+      {
+        case SPITRANS_PHASETYPE_CMD :
+        case SPITRANS_PHASETYPE_ADDR :
+          if (( ptPhase->nNumBytes == 0 ) || ( ptPhase->nNumBytes > MAX_VALUE_BYTES ))
+          {
+            eError = SPITRANSMNGR_ERR_ILLPRM;
+          }
+          break;
+
+        case SPITRANS_PHASETYPE_DUMMY :
+          break;
+
+        case SPITRANS_PHASETYPE_WRITE :
+        case SPITRANS_PHASETYPE_READ :
+        case SPITRANS_PHASETYPE_XFER :
+          if (( ptPhase->wDataLen != 0 ) && ( ptPhase->pnData == NULL ))
+          {
+            eError = SPITRANSMNGR_ERR_ILLPRM;
+          }
+          break;
+
+        default :
+          eError = SPITRANSMNGR_ERR_ILLPRM;
+          break;
+      }
+    }
+
+    if ( eError == SPITRANSMNGR_ERR_NONE )
+    {
+      // reset the progress and append to the queue
+      ptCtl = &atDevCtls[ eDevice ];
+      ptTrans->ptNext = NULL;
+      ptTrans->nCurPhase = 0;
+      ptTrans->wCurOffset = 0;
+      ptTrans->eError = SPI_ERR_NONE;
+      ptTrans->eStatus = SPITRANS_STS_QUEUED;
+      if ( ptCtl->ptTail != NULL )
+      {
+        ptCtl->ptTail->ptNext = ptTrans;
+      }
+      else
+      {
+        ptCtl->ptHead = ptTrans;
+      }
+      ptCtl->ptTail = ptTrans;
+      tStats.uSubmitted++;
+
+      // kick the process
+      SpiTransactionManager_LocalKick( );
+    }
+  }
+
+  // return the error
+  return( eError );
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_Process
+ *
+ * @brief process the queues
+ *
+ * This function will move up to SPITRANSMNGR_BYTES_PER_PASS bytes on each
+ * bus, continuing the active transaction first and then starting the next
+ * one from the least recently serviced device on that bus
+ *
+ *****************************************************************************/
+void SpiTransactionManager_Process( void )
+{
+  SPIDEVENUM        eBus;
+  SPITRANSDEVENUM   eDevice;
+  PBUSCTL           ptBus;
+  PDEVCTL           ptDev;
+  PSPITRANSACTION   ptTrans;
+  U16               wBudget;
+
+  // for each bus
+  for ( eBus = 0; eBus < SPI_DEV_ENUM_MAX; eBus++ )
+  {
+    ptBus = &atBusCtls[ eBus ];
+    wBudget = SPITRANSMNGR_BYTES_PER_PASS;
+
+    // while there is budget left
+    while ( wBudget != 0 )
+    {
+      // start a new transaction if none active
+      if ( ptBus->ptActive == NULL )
+      {
+        // get the next device
+        if (( eDevice = SelectNextDevice( eBus )) == SPITRANS_DEV_ENUM_ILLEGAL )
+        {
+          // nothing to do on this bus
+          break;
+        }
+
+        // unlink the head
+        ptDev = &atDevCtls[ eDevice ];
+        ptTrans = ptDev->ptHead;
+        ptDev->ptHead = ptTrans->ptNext;
+        if ( ptDev->ptHead == NULL )
+        {
+          ptDev->ptTail = NULL;
+        }
+        ptTrans->ptNext = NULL;
+        ptDev->uLastService = ++uServiceStamp;
+
+        // configure the bus and assert the chip select
+        ConfigureBus( eBus, eDevice );
+        if ( g_atSpiTransDevDefs[ eDevice ].pvChipSelect != NULL )
+        {
+          g_atSpiTransDevDefs[ eDevice ].pvChipSelect( TRUE );
+        }
+        ptTrans->eStatus = SPITRANS_STS_ACTIVE;
+        ptBus->ptActive = ptTrans;
+      }
+
+      // run the phases
+      ptTrans = ptBus->ptActive;
+      if ( RunPhases( eBus, ptTrans, &wBudget ))
+      {
+        // release the chip select and complete
+        if ( g_atSpiTransDevDefs[ ptBus->eDevice ].pvChipSelect != NULL )
+        {
+          g_atSpiTransDevDefs[ ptBus->eDevice ].pvChipSelect( FALSE );
+        }
+        ptBus->ptActive = NULL;
+        CompleteTransaction( ptTrans );
+      }
+      else
+      {
+        // out of budget, continue on the next pass
+        tStats.uSlices++;
+      }
+    }
+  }
+
+  // if work remains, kick again
+  if ( !SpiTransactionManager_IsIdle( ))
+  {
+    SpiTransactionManager_LocalKick( );
+  }
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_IsIdle
+ *
+ * @brief check for idle
+ *
+ * This function will return TRUE if no transaction is queued or active
+ *
+ * @return      TRUE if idle
+ *
+ *****************************************************************************/
+BOOL SpiTransactionManager_IsIdle( void )
+{
+  SPITRANSDEVENUM eDevice;
+  SPIDEVENUM      eBus;
+  BOOL            bIdle = TRUE;
+
+  // check each queue
+  for ( eDevice = 0; eDevice < SPITRANS_DEV_ENUM_MAX; eDevice++ )
+  {
+    if ( atDevCtls[ eDevice ].ptHead != NULL )
+    {
+      bIdle = FALSE;
+    }
+  }
+
+  // check each bus
+  for ( eBus = 0; eBus < SPI_DEV_ENUM_MAX; eBus++ )
+  {
+    if ( atBusCtls[ eBus ].ptActive != NULL )
+    {
+      bIdle = FALSE;
+    }
+  }
+
+  // return the status
+  return( bIdle );
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_GetStats
+ *
+ * @brief get the statistics
+ *
+ * This function will copy the statistics and optionally reset them
+ *
+ * @param[io]   ptStats     pointer to the statistics storage
+ * @param[in]   bReset      TRUE to reset the statistics
+ *
+ *****************************************************************************/
+void SpiTransactionManager_GetStats( PSPITRANSMNGRSTATS ptStats, BOOL bReset )
+{
+  // copy the statistics
+  memcpy( ptStats, &tStats, SPITRANSMNGRSTATS_SIZE );
+
+  // reset if requested
+  if ( bReset )
+  {
+    memset( &tStats, 0, SPITRANSMNGRSTATS_SIZE );
+  }
+}
+
+/******************************************************************************
+ * @function SelectNextDevice
+ *
+ * @brief select the next device on a bus
+ *
+ * This function will return the least recently serviced device with a
+ * queued transaction on the bus
+ *
+ * @param[in]   eBus        bus enumeration
+ *
+ * @return      device enumeration or SPITRANS_DEV_ENUM_ILLEGAL if none
+ *
+ *****************************************************************************/
+static SPITRANSDEVENUM SelectNextDevice( SPIDEVENUM eBus )
+{
+  SPITRANSDEVENUM eDevice, eBest = SPITRANS_DEV_ENUM_ILLEGAL;
+
+  // for each device
+  for ( eDevice = 0; eDevice < SPITRANS_DEV_ENUM_MAX; eDevice++ )
+  {
+    if (( g_atSpiTransDevDefs[ eDevice ].eBus == eBus ) && ( atDevCtls[ eDevice ].ptHead != NULL ))
+    {
+      if (( eBest == SPITRANS_DEV_ENUM_ILLEGAL ) || ( atDevCtls[ eDevice ].uLastService < atDevCtls[ eBest ].uLastService ))
+      {
+        eBest = eDevice;
+      }
+    }
+  }
+
+  // return the device
+  return( eBest );
+}
+
+/******************************************************************************
+ * @function ConfigureBus
+ *
+ * @brief configure the bus for a device
+ *
+ * This function will reprogram only the clock settings that differ from
+ * the device last configured on the bus
+ *
+ * @param[in]   eBus        bus enumeration
+ * @param[in]   eDevice     device enumeration
+ *
+ *****************************************************************************/
+static void ConfigureBus( SPIDEVENUM eBus, SPITRANSDEVENUM eDevice )
+{
+  PBUSCTL         ptBus = &atBusCtls[ eBus ];
+  PSPITRANSDEVDEF ptNew, ptOld;
+  U32             uValue;
+
+  // check for a change of device
+  if ( ptBus->eDevice != eDevice )
+  {
+    ptNew = ( PSPITRANSDEVDEF )&g_atSpiTransDevDefs[ eDevice ];
+    ptOld = ( ptBus->eDevice != SPITRANS_DEV_ENUM_ILLEGAL ) ? ( PSPITRANSDEVDEF )&g_atSpiTransDevDefs[ ptBus->eDevice ] : NULL;
+
+    // update the changed settings
+    if (( ptOld == NULL ) || ( ptOld->uClkPol != ptNew->uClkPol ) || ( ptOld->uClkPhase != ptNew->uClkPhase ) || ( ptOld->uSpeed != ptNew->uSpeed ))
+    {
+      uValue = ptNew->uClkPol;
+      Spi_Ioctl( eBus, SPI_IOCTLACTIONS_SETPOL, &uValue );
+      uValue = ptNew->uClkPhase;
+      Spi_Ioctl( eBus, SPI_IOCTLACTIONS_SETPHA, &uValue );
+      uValue = ptNew->uSpeed;
+      Spi_Ioctl( eBus, SPI_IOCTLACTIONS_SETSPEED, &uValue );
+      tStats.uModeSwitches++;
+    }
+
+    // set the new device
+    ptBus->eDevice = eDevice;
+  }
+}
+
+/******************************************************************************
+ * @function RunPhases
+ *
+ * @brief run the phases of a transaction
+ *
+ * This function will run phases until the transaction is done, an error
+ * occurs or the budget is exhausted.  Only the data phases are split
+ *
+ * @param[in]   eBus        bus enumeration
+ * @param[in]   ptTrans     pointer to the transaction
+ * @param[io]   pwBudget    pointer to the remaining byte budget
+ *
+ * @return      TRUE if the transaction is finished
+ *
+ *****************************************************************************/
+static BOOL RunPhases( SPIDEVENUM eBus, PSPITRANSACTION ptTrans, PU16 pwBudget )
+{
+  PSPITRANSPHASE  ptPhase;
+  U8              anValue[ MAX_VALUE_BYTES ];
+  U16             wCount;
+  U8              nIndex;
+
+  // while phases remain
+  while (( ptTrans->nCurPhase < ptTrans->nNumPhases ) && ( ptTrans->eError == SPI_ERR_NONE ) && ( *pwBudget != 0 ))
+  {
+    // get the phase
+    ptPhase = &ptTrans->atPhases[ ptTrans->nCurPhase ];
+    switch( ptPhase->eType )
+    {
+      case SPITRANS_PHASETYPE_CMD :
+      case SPITRANS_PHASETYPE_ADDR :
+        // build the value, MSB first, and write it
+        wCount = ptPhase->nNumBytes;
+        for ( nIndex = 0; nIndex < wCount; nIndex++ )
+        {
+          anValue[ nIndex ] = ( U8 )( ptPhase->uValue >> (( wCount - nIndex - 1 ) * 8 ));
+        }
+        ptTrans->eError = Spi_WriteBlock( eBus, anValue, wCount, FALSE );
+        ptTrans->wCurOffset = wCount;
+        break;
+
+      case SPITRANS_PHASETYPE_DUMMY :
+        // clock the fill bytes
+        wCount = ptPhase->nNumBytes;
+        for ( nIndex = 0; ( nIndex < wCount ) && ( ptTrans->eError == SPI_ERR_NONE ); nIndex++ )
+        {
+          ptTrans->eError = Spi_Write( eBus, SPITRANSMNGR_FILL_BYTE );
+        }
+        ptTrans->wCurOffset = wCount;
+        break;
+
+      case SPITRANS_PHASETYPE_WRITE :
+      case SPITRANS_PHASETYPE_READ :
+      case SPITRANS_PHASETYPE_XFER :
+        // move as much as the budget allows
+        wCount = MIN( ptPhase->wDataLen - ptTrans->wCurOffset, *pwBudget );
+        if ( wCount != 0 )
+        {
+          if ( ptPhase->eType == SPITRANS_PHASETYPE_READ )
+          {
+            ptTrans->eError = Spi_ReadBlock( eBus, SPITRANSMNGR_FILL_BYTE, ptPhase->pnData + ptTrans->wCurOffset, wCount );
+          }
+          else
+          {
+            ptTrans->eError = Spi_WriteBlock( eBus, ptPhase->pnData + ptTrans->wCurOffset, wCount, ( ptPhase->eType == SPITRANS_PHASETYPE_XFER ));
+          }
+        }
+        ptTrans->wCurOffset += wCount;
+        break;
+
+      default :
+        wCount = 0;
+        break;
+    }
+
+    // charge the budget
+    *pwBudget -= MIN( wCount, *pwBudget );
+    tStats.uBytes += wCount;
+
+    // check for the phase done
+    if (( ptPhase->eType < SPITRANS_PHASETYPE_WRITE ) || ( ptTrans->wCurOffset >= ptPhase->wDataLen ))
+    {
+      ptTrans->nCurPhase++;
+      ptTrans->wCurOffset = 0;
+    }
+  }
+
+  // return done
+  return(( ptTrans->nCurPhase >= ptTrans->nNumPhases ) || ( ptTrans->eError != SPI_ERR_NONE ));
+}
+
+/******************************************************************************
+ * @function CompleteTransaction
+ *
+ * @brief complete a transaction
+ *
+ * This function will set the status and report the completion
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ *****************************************************************************/
+static void CompleteTransaction( PSPITRANSACTION ptTrans )
+{
+  // set the status
+  ptTrans->eStatus = ( ptTrans->eError == SPI_ERR_NONE ) ? SPITRANS_STS_DONE : SPITRANS_STS_ERROR;
+  tStats.uCompleted++;
+  if ( ptTrans->eError != SPI_ERR_NONE )
+  {
+    tStats.uErrors++;
+  }
+
+  // report it
+  if ( ptTrans->pvCallback != NULL )
+  {
+    ptTrans->pvCallback( ptTrans );
+  }
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  if ( ptTrans->eTaskEnum != TASK_SCHD_ILLEGAL )
+  {
+    TaskManager_PostEvent( ptTrans->eTaskEnum, ptTrans->xTaskArg );
+  }
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+}
+
+/**@} EOF SpiTransactionManager.c */
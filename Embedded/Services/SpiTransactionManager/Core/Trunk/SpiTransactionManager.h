@@ -0,0 +1,73 @@
+/******************************************************************************
+ * @file SpiTransactionManager.h
+ *
+ * @brief SPI transaction manager declarations
+ *
+ * This file provides the declarations for the SPI transaction manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _SPITRANSACTIONMANAGER_H
+#define _SPITRANSACTIONMANAGER_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the errors
+typedef enum _SPITRANSMNGRERR
+{
+  SPITRANSMNGR_ERR_NONE = 0,      ///< no error
+  SPITRANSMNGR_ERR_ILLDEV,        ///< illegal device
+  SPITRANSMNGR_ERR_ILLPRM,        ///< illegal transaction
+  SPITRANSMNGR_ERR_BUSY,          ///< transaction is already queued or active
+} SPITRANSMNGRERR;
+
+// structures -----------------------------------------------------------------
+/// define the statistics structure
+typedef struct _SPITRANSMNGRSTATS
+{
+  U32   uSubmitted;               ///< transactions submitted
+  U32   uCompleted;               ///< transactions completed
+  U32   uErrors;                  ///< transactions completed with an error
+  U32   uModeSwitches;            ///< clock/mode/speed reconfigurations
+  U32   uSlices;                  ///< passes that left a transaction in progress
+  U32   uBytes;                   ///< bytes clocked
+} SPITRANSMNGRSTATS, *PSPITRANSMNGRSTATS;
+#define SPITRANSMNGRSTATS_SIZE                  sizeof( SPITRANSMNGRSTATS )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  BOOL            SpiTransactionManager_Initialize( void );
+extern  void            SpiTransactionManager_Clear( PSPITRANSACTION ptTrans );
+extern  BOOL            SpiTransactionManager_AddPhase( PSPITRANSACTION ptTrans, SPITRANSPHASETYPE eType, U8 nNumBytes, U32 uValue, PU8 pnData, U16 wDataLen );
+extern  SPITRANSMNGRERR SpiTransactionManager_Submit( SPITRANSDEVENUM eDevice, PSPITRANSACTION ptTrans );
+extern  void            SpiTransactionManager_Process( void );
+extern  BOOL            SpiTransactionManager_IsIdle( void );
+extern  void            SpiTransactionManager_GetStats( PSPITRANSMNGRSTATS ptStats, BOOL bReset );
+
+/**@} EOF SpiTransactionManager.h */
+
+#endif  // _SPITRANSACTIONMANAGER_H
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * @file SpiTransactionManager_def.h
+ *
+ * @brief SPI transaction manager definition declarations
+ *
+ * This file provides the definition declarations for the SPI transaction
+ * manager devices and transactions
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _SPITRANSACTIONMANAGER_DEF_H
+#define _SPITRANSACTIONMANAGER_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager_prm.h"
+
+// library includes -----------------------------------------------------------
+#include "SPI/Spi.h"
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  #include "TaskManager/TaskManager.h"
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+// Macros and Defines ---------------------------------------------------------
+/// define the helper macro for a device
+#define SPITRANSDEVDEFM( bus, clkpol, clkphase, speed, chipselect ) \
+  { \
+    .eBus         = bus, \
+    .uClkPol      = clkpol, \
+    .uClkPhase    = clkphase, \
+    .uSpeed       = speed, \
+    .pvChipSelect = chipselect, \
+  }
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the phase types
+typedef enum _SPITRANSPHASETYPE
+{
+  SPITRANS_PHASETYPE_CMD = 0,     ///< command, nNumBytes of uValue MSB first
+  SPITRANS_PHASETYPE_ADDR,        ///< address, nNumBytes of uValue MSB first
+  SPITRANS_PHASETYPE_DUMMY,       ///< nNumBytes of fill
+  SPITRANS_PHASETYPE_WRITE,       ///< write data
+  SPITRANS_PHASETYPE_READ,        ///< read data
+  SPITRANS_PHASETYPE_XFER,        ///< full duplex, read data replaces write data
+  SPITRANS_PHASETYPE_MAX
+} SPITRANSPHASETYPE;
+
+/// enumerate the transaction status
+typedef enum _SPITRANSSTS
+{
+  SPITRANS_STS_IDLE = 0,          ///< not submitted
+  SPITRANS_STS_QUEUED,            ///< waiting in a device queue
+  SPITRANS_STS_ACTIVE,            ///< in progress, chip select asserted
+  SPITRANS_STS_DONE,              ///< completed without error
+  SPITRANS_STS_ERROR,             ///< completed with an error
+} SPITRANSSTS;
+
+// structures -----------------------------------------------------------------
+/// define the chip select callback
+typedef void ( *PVSPITRANSCHIPSELECT )( BOOL bAssert );
+
+/// define the phase structure
+typedef struct _SPITRANSPHASE
+{
+  SPITRANSPHASETYPE eType;        ///< phase type
+  U8                nNumBytes;    ///< command/address/dummy length
+  U32               uValue;       ///< command/address value
+  PU8               pnData;       ///< pointer to the data
+  U16               wDataLen;     ///< data length
+} SPITRANSPHASE, *PSPITRANSPHASE;
+#define SPITRANSPHASE_SIZE                      sizeof( SPITRANSPHASE )
+
+/// forward declare the transaction for the callback
+struct _SPITRANSACTION;
+
+/// define the completion callback
+typedef void ( *PVSPITRANSCALLBACK )( struct _SPITRANSACTION* ptTrans );
+
+/// define the transaction structure, owned by the caller until completion
+typedef struct _SPITRANSACTION
+{
+  struct _SPITRANSACTION* ptNext;         ///< queue link
+  U8                      nNumPhases;     ///< number of phases
+  SPITRANSPHASE           atPhases[ SPITRANSMNGR_MAX_PHASES ];  ///< phases
+  PVSPITRANSCALLBACK      pvCallback;     ///< completion callback
+  #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  TASKSCHDENUMS           eTaskEnum;      ///< completion task
+  TASKARG                 xTaskArg;       ///< completion event
+  #endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  PVOID                   pvUserData;     ///< user data
+  volatile SPITRANSSTS    eStatus;        ///< status
+  SPIERR                  eError;         ///< completion error
+  U8                      nCurPhase;      ///< current phase, managed internally
+  U16                     wCurOffset;     ///< current data offset, managed internally
+} SPITRANSACTION, *PSPITRANSACTION;
+#define SPITRANSACTION_SIZE                     sizeof( SPITRANSACTION )
+
+/// define the device definition structure
+typedef struct _SPITRANSDEVDEF
+{
+  SPIDEVENUM            eBus;           ///< bus this device is attached to
+  U32                   uClkPol;        ///< clock polarity
+  U32                   uClkPhase;      ///< clock phase
+  U32                   uSpeed;         ///< clock speed
+  PVSPITRANSCHIPSELECT  pvChipSelect;   ///< chip select control
+} SPITRANSDEVDEF, *PSPITRANSDEVDEF;
+#define SPITRANSDEVDEF_SIZE                     sizeof( SPITRANSDEVDEF )
+
+/**@} EOF SpiTransactionManager_def.h */
+
+#endif  // _SPITRANSACTIONMANAGER_DEF_H
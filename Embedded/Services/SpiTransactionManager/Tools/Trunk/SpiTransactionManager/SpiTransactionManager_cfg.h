@@ -0,0 +1,68 @@
+/******************************************************************************
+ * @file SpiTransactionManager_cfg.h
+ *
+ * @brief SPI transaction manager test configuration declarations
+ *
+ * This file provides the device enumeration for the transaction manager test
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _SPITRANSACTIONMANAGER_CFG_H
+#define _SPITRANSACTIONMANAGER_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  #define SPITRANSMNGR_PROCESS_NUM_EVENTS       ( 4 )
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the devices
+typedef enum _SPITRANSDEVENUM
+{
+  SPITRANS_DEV_ENUM_FLASH = 0,        ///< bus 0, mode 0, fast
+  SPITRANS_DEV_ENUM_DISPLAY,          ///< bus 0, same settings as the flash
+  SPITRANS_DEV_ENUM_ADC,              ///< bus 0, mode 3, slow
+  SPITRANS_DEV_ENUM_SENSOR,           ///< bus 1
+
+  // do not remove the below entries
+  SPITRANS_DEV_ENUM_MAX,
+  SPITRANS_DEV_ENUM_ILLEGAL
+} SPITRANSDEVENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE SPITRANSDEVDEF g_atSpiTransDevDefs[ ];
+
+// global function prototypes --------------------------------------------------
+extern  void  SpiTransactionManager_LocalInitialize( void );
+extern  void  SpiTransactionManager_LocalKick( void );
+#if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+  extern  BOOL  SpiTransactionManager_ProcessTask( TASKARG xArg );
+#endif // ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
+
+/**@} EOF SpiTransactionManager_cfg.h */
+
+#endif  // _SPITRANSACTIONMANAGER_CFG_H
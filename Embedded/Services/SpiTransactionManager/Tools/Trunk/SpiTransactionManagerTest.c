@@ -0,0 +1,714 @@
+/******************************************************************************
+ * @file SpiTransactionManagerTest.c
+ *
+ * @brief SPI transaction manager test
+ *
+ * This file provides a host tool that runs the transaction manager against
+ * two loopback buses of the Linux SPI HAL.  It replaces
+ * SpiTransactionManager_cfg.c with three devices on the first bus, two
+ * sharing clock settings, and one on the second.  It checks that each
+ * device queue completes in order and that the devices sharing a bus are
+ * serviced least recently used first, with the clock settings reprogrammed
+ * only when they change.  It checks that a transfer longer than the pass
+ * budget holds its chip select across the passes while the other devices
+ * on the bus wait, and that only one chip select on a bus is ever asserted.
+ * It then disables a bus, queued and in progress, and checks that the
+ * transactions complete with the bus error, release their chip select and
+ * leave the bus usable.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o SpiTransactionManagerTest
+ *             SpiTransactionManagerTest.c
+ *             ../../Core/Trunk/SpiTransactionManager.c
+ *             <HAL/Linux/SPI root>/Core/Trunk/Spi.c
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup SpiTransactionManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "SpiTransactionManager/SpiTransactionManager.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the clock speeds
+#define FAST_SPEED                                  ( 8000000 )
+#define SLOW_SPEED                                  ( 1000000 )
+
+/// define the number of transactions per check
+#define MAX_CHECK_TRANS                             ( 6 )
+
+/// define the data length of the short transactions
+#define SHORT_DATA_LEN                              ( 16 )
+
+/// define the data length of the long write, it spans three passes
+#define LONG_DATA_LEN                               (( SPITRANSMNGR_BYTES_PER_PASS * 2 ) + 276 )
+
+/// define the command/address bytes in front of every read and write
+#define HDR_BYTES                                   ( 4 )
+
+/// define the limit on process passes
+#define MAX_PASSES                                  ( 100 )
+
+// local parameter declarations -----------------------------------------------
+static  BOOL            abCsAsserted[ SPITRANS_DEV_ENUM_MAX ];
+static  U32             auCsAsserts[ SPITRANS_DEV_ENUM_MAX ];
+static  U32             auCsReleases[ SPITRANS_DEV_ENUM_MAX ];
+static  U32             uCsErrors;
+static  U32             uKicks;
+static  U8              anOrder[ MAX_CHECK_TRANS ];
+static  U8              nNumDone;
+static  U8              aanData[ MAX_CHECK_TRANS ][ LONG_DATA_LEN ];
+static  SPITRANSACTION  atTrans[ MAX_CHECK_TRANS ];
+
+// local function prototypes --------------------------------------------------
+static  void  ChipSelect( SPITRANSDEVENUM eDevice, BOOL bAssert );
+static  void  ChipSelectFlash( BOOL bAssert );
+static  void  ChipSelectDisplay( BOOL bAssert );
+static  void  ChipSelectAdc( BOOL bAssert );
+static  void  ChipSelectSensor( BOOL bAssert );
+static  void  Callback( PSPITRANSACTION ptTrans );
+static  void  Reset( void );
+static  void  SetupRead( U8 nIdx, U16 wLength );
+static  void  SetupWrite( U8 nIdx, U16 wLength );
+static  U32   RunUntilIdle( void );
+static  int   CheckCsBalanced( PC8 pszName );
+static  int   CheckOrdering( void );
+static  int   CheckSlicing( void );
+static  int   CheckErrors( void );
+static  int   CheckSubmit( void );
+
+// constant parameter initializations -----------------------------------------
+/// fill out the device table
+const CODE SPITRANSDEVDEF g_atSpiTransDevDefs[ SPITRANS_DEV_ENUM_MAX ] =
+{
+  SPITRANSDEVDEFM( SPI_DEV_ENUM_BUS0, SPI_CLKPOL_RISING, SPI_CLKPHASE_LEADING, FAST_SPEED, ChipSelectFlash ),
+  SPITRANSDEVDEFM( SPI_DEV_ENUM_BUS0, SPI_CLKPOL_RISING, SPI_CLKPHASE_LEADING, FAST_SPEED, ChipSelectDisplay ),
+  SPITRANSDEVDEFM( SPI_DEV_ENUM_BUS0, SPI_CLKPOL_FALLING, SPI_CLKPHASE_TRAILING, SLOW_SPEED, ChipSelectAdc ),
+  SPITRANSDEVDEFM( SPI_DEV_ENUM_BUS1, SPI_CLKPOL_RISING, SPI_CLKPHASE_LEADING, FAST_SPEED, ChipSelectSensor ),
+};
+
+/// device configuration table
+const SPIDEF atSpiDefs[ SPI_DEV_ENUM_MAX ] =
+{
+  SPI_DEVICE_LOOPBACK( SPI_CLKPOL_RISING, SPI_CLKPHASE_LEADING, FAST_SPEED ),
+  SPI_DEVICE_LOOPBACK( SPI_CLKPOL_RISING, SPI_CLKPHASE_LEADING, FAST_SPEED ),
+};
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run each check
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( void )
+{
+  int iErrors = 0;
+
+  // initialize
+  Spi_Initialize( );
+
+  // run the checks
+  iErrors += CheckOrdering( );
+  iErrors += CheckSlicing( );
+  iErrors += CheckErrors( );
+  iErrors += CheckSubmit( );
+
+  // report
+  printf( "%d errors\n%s\n", iErrors, ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_LocalInitialize
+ *
+ * @brief local initialization
+ *
+ * This function has nothing to do for the test
+ *
+ *****************************************************************************/
+void SpiTransactionManager_LocalInitialize( void )
+{
+}
+
+/******************************************************************************
+ * @function SpiTransactionManager_LocalKick
+ *
+ * @brief kick the process
+ *
+ * This function counts the kicks, the test runs the process itself
+ *
+ *****************************************************************************/
+void SpiTransactionManager_LocalKick( void )
+{
+  uKicks++;
+}
+
+/******************************************************************************
+ * @function ChipSelect
+ *
+ * @brief chip select
+ *
+ * This function tracks a chip select, flagging a second assert on the same
+ * bus or an unbalanced assert/release
+ *
+ * @param[in]   eDevice     device enumeration
+ * @param[in]   bAssert     TRUE to assert
+ *
+ *****************************************************************************/
+static void ChipSelect( SPITRANSDEVENUM eDevice, BOOL bAssert )
+{
+  SPITRANSDEVENUM eOther;
+
+  // check for an assert
+  if ( bAssert )
+  {
+    // no other chip select on the bus may be asserted
+    for ( eOther = 0; eOther < SPITRANS_DEV_ENUM_MAX; eOther++ )
+    {
+      if (( g_atSpiTransDevDefs[ eOther ].eBus == g_atSpiTransDevDefs[ eDevice ].eBus ) && ( abCsAsserted[ eOther ] ))
+      {
+        uCsErrors++;
+      }
+    }
+    auCsAsserts[ eDevice ]++;
+  }
+  else
+  {
+    // must be asserted
+    if ( !abCsAsserted[ eDevice ] )
+    {
+      uCsErrors++;
+    }
+    auCsReleases[ eDevice ]++;
+  }
+
+  // set the state
+  abCsAsserted[ eDevice ] = bAssert;
+}
+
+/******************************************************************************
+ * @function ChipSelectFlash
+ *
+ * @brief flash chip select
+ *
+ * @param[in]   bAssert     TRUE to assert
+ *
+ *****************************************************************************/
+static void ChipSelectFlash( BOOL bAssert )
+{
+  ChipSelect( SPITRANS_DEV_ENUM_FLASH, bAssert );
+}
+
+/******************************************************************************
+ * @function ChipSelectDisplay
+ *
+ * @brief display chip select
+ *
+ * @param[in]   bAssert     TRUE to assert
+ *
+ *****************************************************************************/
+static void ChipSelectDisplay( BOOL bAssert )
+{
+  ChipSelect( SPITRANS_DEV_ENUM_DISPLAY, bAssert );
+}
+
+/******************************************************************************
+ * @function ChipSelectAdc
+ *
+ * @brief ADC chip select
+ *
+ * @param[in]   bAssert     TRUE to assert
+ *
+ *****************************************************************************/
+static void ChipSelectAdc( BOOL bAssert )
+{
+  ChipSelect( SPITRANS_DEV_ENUM_ADC, bAssert );
+}
+
+/******************************************************************************
+ * @function ChipSelectSensor
+ *
+ * @brief sensor chip select
+ *
+ * @param[in]   bAssert     TRUE to assert
+ *
+ *****************************************************************************/
+static void ChipSelectSensor( BOOL bAssert )
+{
+  ChipSelect( SPITRANS_DEV_ENUM_SENSOR, bAssert );
+}
+
+/******************************************************************************
+ * @function Callback
+ *
+ * @brief completion callback
+ *
+ * This function records the completion order, the user data is the index
+ *
+ * @param[in]   ptTrans     pointer to the transaction
+ *
+ *****************************************************************************/
+static void Callback( PSPITRANSACTION ptTrans )
+{
+  // record it
+  if ( nNumDone < MAX_CHECK_TRANS )
+  {
+    anOrder[ nNumDone ] = ( U8 )( uintptr_t )ptTrans->pvUserData;
+  }
+  nNumDone++;
+}
+
+/******************************************************************************
+ * @function Reset
+ *
+ * @brief reset for a check
+ *
+ * This function reinitializes the manager and clears the tracking
+ *
+ *****************************************************************************/
+static void Reset( void )
+{
+  SPIDEVENUM  eBus;
+
+  // reinitialize/clear
+  SpiTransactionManager_Initialize( );
+  for ( eBus = 0; eBus < SPI_DEV_ENUM_MAX; eBus++ )
+  {
+    Spi_Ioctl( eBus, SPI_IOCTLACTIONS_CLRSTATS, NULL );
+  }
+  memset( abCsAsserted, 0, sizeof( abCsAsserted ));
+  memset( auCsAsserts, 0, sizeof( auCsAsserts ));
+  memset( auCsReleases, 0, sizeof( auCsReleases ));
+  memset( anOrder, 0xFF, sizeof( anOrder ));
+  uCsErrors = 0;
+  uKicks = 0;
+  nNumDone = 0;
+}
+
+/******************************************************************************
+ * @function SetupRead
+ *
+ * @brief set up a read
+ *
+ * This function builds a fast read, command, address, dummy and data, into
+ * a cleared buffer
+ *
+ * @param[in]   nIdx        transaction index
+ * @param[in]   wLength     data length
+ *
+ *****************************************************************************/
+static void SetupRead( U8 nIdx, U16 wLength )
+{
+  PSPITRANSACTION ptTrans = &atTrans[ nIdx ];
+
+  // build it
+  SpiTransactionManager_Clear( ptTrans );
+  memset( aanData[ nIdx ], 0, wLength );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_CMD, 1, 0x0B, NULL, 0 );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_ADDR, 3, 0x123456, NULL, 0 );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_DUMMY, 1, 0, NULL, 0 );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_READ, 0, 0, aanData[ nIdx ], wLength );
+  ptTrans->pvCallback = Callback;
+  ptTrans->pvUserData = ( PVOID )( uintptr_t )nIdx;
+}
+
+/******************************************************************************
+ * @function SetupWrite
+ *
+ * @brief set up a write
+ *
+ * This function builds a program, command, address and data
+ *
+ * @param[in]   nIdx        transaction index
+ * @param[in]   wLength     data length
+ *
+ *****************************************************************************/
+static void SetupWrite( U8 nIdx, U16 wLength )
+{
+  PSPITRANSACTION ptTrans = &atTrans[ nIdx ];
+
+  // build it
+  SpiTransactionManager_Clear( ptTrans );
+  memset( aanData[ nIdx ], nIdx, wLength );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_CMD, 1, 0x02, NULL, 0 );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_ADDR, 3, 0x000100, NULL, 0 );
+  SpiTransactionManager_AddPhase( ptTrans, SPITRANS_PHASETYPE_WRITE, 0, 0, aanData[ nIdx ], wLength );
+  ptTrans->pvCallback = Callback;
+  ptTrans->pvUserData = ( PVOID )( uintptr_t )nIdx;
+}
+
+/******************************************************************************
+ * @function RunUntilIdle
+ *
+ * @brief run until idle
+ *
+ * This function runs process passes until every queue is empty
+ *
+ * @return      number of passes
+ *
+ *****************************************************************************/
+static U32 RunUntilIdle( void )
+{
+  U32 uPasses = 0;
+
+  // process
+  while (( !SpiTransactionManager_IsIdle( )) && ( uPasses < MAX_PASSES ))
+  {
+    SpiTransactionManager_Process( );
+    uPasses++;
+  }
+
+  // return the passes
+  return( uPasses );
+}
+
+/******************************************************************************
+ * @function CheckCsBalanced
+ *
+ * @brief check the chip selects
+ *
+ * This function checks that every chip select is released and was never
+ * asserted alongside another on its bus
+ *
+ * @param[in]   pszName     name for the report
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckCsBalanced( PC8 pszName )
+{
+  int             iErrors = 0;
+  SPITRANSDEVENUM eDevice;
+
+  // check each device
+  for ( eDevice = 0; eDevice < SPITRANS_DEV_ENUM_MAX; eDevice++ )
+  {
+    if (( abCsAsserted[ eDevice ] ) || ( auCsAsserts[ eDevice ] != auCsReleases[ eDevice ] ))
+    {
+      printf( "  %s: device %d chip select left asserted, %u asserts, %u releases\n", pszName, eDevice, auCsAsserts[ eDevice ], auCsReleases[ eDevice ] );
+      iErrors++;
+    }
+  }
+  if ( uCsErrors != 0 )
+  {
+    printf( "  %s: %u chip select errors\n", pszName, uCsErrors );
+    iErrors++;
+  }
+
+  // return the errors
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function CheckOrdering
+ *
+ * @brief check the ordering
+ *
+ * This function queues three reads on the flash, one on the display and one
+ * on the ADC, all on the first bus, and one on the sensor.  The flash queue
+ * completes in order and the bus goes to the least recently used device
+ * each time, so the order is flash, display, ADC, flash, flash with the
+ * sensor on its own bus.  The display shares the flash settings so only the
+ * ADC and the return to the flash reprogram the bus
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckOrdering( void )
+{
+  static  const SPITRANSDEVENUM aeDevices[ ] = { SPITRANS_DEV_ENUM_FLASH, SPITRANS_DEV_ENUM_FLASH, SPITRANS_DEV_ENUM_FLASH, SPITRANS_DEV_ENUM_DISPLAY, SPITRANS_DEV_ENUM_ADC, SPITRANS_DEV_ENUM_SENSOR };
+  static  const U8              anExpOrder[ ] = { 0, 3, 4, 1, 2, 5 };
+  int                           iErrors = 0;
+  SPITRANSMNGRSTATS             tStats;
+  SPISTATS                      tBusStats;
+  U8                            nIdx;
+  U16                           wIdx;
+
+  // queue them
+  Reset( );
+  for ( nIdx = 0; nIdx < MAX_CHECK_TRANS; nIdx++ )
+  {
+    SetupRead( nIdx, SHORT_DATA_LEN );
+    if (( SpiTransactionManager_Submit( aeDevices[ nIdx ], &atTrans[ nIdx ] ) != SPITRANSMNGR_ERR_NONE ) || ( atTrans[ nIdx ].eStatus != SPITRANS_STS_QUEUED ))
+    {
+      printf( "  ordering: submit %d failed\n", nIdx );
+      iErrors++;
+    }
+  }
+
+  // nothing moves until processed, one pass does it all
+  if (( nNumDone != 0 ) || ( uKicks != MAX_CHECK_TRANS ))
+  {
+    printf( "  ordering: %d completed and %u kicks before processing\n", nNumDone, uKicks );
+    iErrors++;
+  }
+  if ( RunUntilIdle( ) != 1 )
+  {
+    printf( "  ordering: more than one pass\n" );
+    iErrors++;
+  }
+
+  // check the order
+  if (( nNumDone != MAX_CHECK_TRANS ) || ( memcmp( anOrder, anExpOrder, MAX_CHECK_TRANS ) != 0 ))
+  {
+    printf( "  ordering: order %d %d %d %d %d %d, expected %d %d %d %d %d %d\n", anOrder[ 0 ], anOrder[ 1 ], anOrder[ 2 ], anOrder[ 3 ], anOrder[ 4 ], anOrder[ 5 ],
+            anExpOrder[ 0 ], anExpOrder[ 1 ], anExpOrder[ 2 ], anExpOrder[ 3 ], anExpOrder[ 4 ], anExpOrder[ 5 ] );
+    iErrors++;
+  }
+
+  // check the status and the data, the loopback returns the fill byte
+  for ( nIdx = 0; nIdx < MAX_CHECK_TRANS; nIdx++ )
+  {
+    for ( wIdx = 0; ( wIdx < SHORT_DATA_LEN ) && ( aanData[ nIdx ][ wIdx ] == SPITRANSMNGR_FILL_BYTE ); wIdx++ );
+    if (( atTrans[ nIdx ].eStatus != SPITRANS_STS_DONE ) || ( wIdx != SHORT_DATA_LEN ))
+    {
+      printf( "  ordering: transaction %d status %d, data wrong at %d\n", nIdx, atTrans[ nIdx ].eStatus, wIdx );
+      iErrors++;
+    }
+  }
+
+  // check the chip selects, one assert per transaction
+  iErrors += CheckCsBalanced( "ordering" );
+  if (( auCsAsserts[ SPITRANS_DEV_ENUM_FLASH ] != 3 ) || ( auCsAsserts[ SPITRANS_DEV_ENUM_DISPLAY ] != 1 ) || ( auCsAsserts[ SPITRANS_DEV_ENUM_ADC ] != 1 ) || ( auCsAsserts[ SPITRANS_DEV_ENUM_SENSOR ] != 1 ))
+  {
+    printf( "  ordering: wrong chip select counts\n" );
+    iErrors++;
+  }
+
+  // check the bytes and the reprogramming, the first use of each bus, the ADC and back to the flash
+  SpiTransactionManager_GetStats( &tStats, TRUE );
+  Spi_Ioctl( SPI_DEV_ENUM_BUS0, SPI_IOCTLACTIONS_GETSTATS, &tBusStats );
+  if (( tStats.uCompleted != MAX_CHECK_TRANS ) || ( tStats.uErrors != 0 ) || ( tStats.uBytes != ( MAX_CHECK_TRANS * ( HDR_BYTES + 1 + SHORT_DATA_LEN ))) || ( tStats.uModeSwitches != 4 ))
+  {
+    printf( "  ordering: %u completed, %u errors, %u bytes, %u mode switches\n", tStats.uCompleted, tStats.uErrors, tStats.uBytes, tStats.uModeSwitches );
+    iErrors++;
+  }
+  if (( tBusStats.uBytes != ( 5 * ( HDR_BYTES + 1 + SHORT_DATA_LEN ))) || ( tBusStats.uModeChanges != 6 ))
+  {
+    printf( "  ordering: bus 0 %u bytes, %u mode changes\n", tBusStats.uBytes, tBusStats.uModeChanges );
+    iErrors++;
+  }
+
+  // report
+  printf( "%-12s %u transactions, %u bus 0 transfers, %u mode switches, %d errors\n", "ordering", tStats.uCompleted, tBusStats.uTransfers, tStats.uModeSwitches, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function CheckSlicing
+ *
+ * @brief check the slicing
+ *
+ * This function queues a long flash write and a display read behind it.  The
+ * write takes three passes with the flash chip select held throughout and
+ * the display waiting, then the display read runs in the third pass
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckSlicing( void )
+{
+  int               iErrors = 0;
+  SPITRANSMNGRSTATS tStats;
+  U32               uPass;
+
+  // queue them
+  Reset( );
+  SetupWrite( 0, LONG_DATA_LEN );
+  SetupRead( 1, SHORT_DATA_LEN );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 0 ] );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_DISPLAY, &atTrans[ 1 ] );
+
+  // the first two passes leave the write active
+  for ( uPass = 0; uPass < 2; uPass++ )
+  {
+    uKicks = 0;
+    SpiTransactionManager_Process( );
+    if (( atTrans[ 0 ].eStatus != SPITRANS_STS_ACTIVE ) || ( atTrans[ 1 ].eStatus != SPITRANS_STS_QUEUED ) ||
+        ( !abCsAsserted[ SPITRANS_DEV_ENUM_FLASH ] ) || ( abCsAsserted[ SPITRANS_DEV_ENUM_DISPLAY ] ) || ( uKicks != 1 ))
+    {
+      printf( "  slicing: pass %u, write %d, read %d, kicks %u\n", uPass, atTrans[ 0 ].eStatus, atTrans[ 1 ].eStatus, uKicks );
+      iErrors++;
+    }
+  }
+
+  // the third finishes both
+  uKicks = 0;
+  SpiTransactionManager_Process( );
+  if (( atTrans[ 0 ].eStatus != SPITRANS_STS_DONE ) || ( atTrans[ 1 ].eStatus != SPITRANS_STS_DONE ) || ( !SpiTransactionManager_IsIdle( )) || ( uKicks != 0 ))
+  {
+    printf( "  slicing: last pass, write %d, read %d, kicks %u\n", atTrans[ 0 ].eStatus, atTrans[ 1 ].eStatus, uKicks );
+    iErrors++;
+  }
+
+  // the flash chip select was asserted once for the whole write
+  iErrors += CheckCsBalanced( "slicing" );
+  SpiTransactionManager_GetStats( &tStats, TRUE );
+  if (( auCsAsserts[ SPITRANS_DEV_ENUM_FLASH ] != 1 ) || ( tStats.uSlices != 2 ) || ( nNumDone != 2 ) || ( anOrder[ 0 ] != 0 ) || ( anOrder[ 1 ] != 1 ))
+  {
+    printf( "  slicing: %u flash asserts, %u slices, %d completed\n", auCsAsserts[ SPITRANS_DEV_ENUM_FLASH ], tStats.uSlices, nNumDone );
+    iErrors++;
+  }
+
+  // report
+  printf( "%-12s %u byte write over %u slices, %d errors\n", "slicing", LONG_DATA_LEN, tStats.uSlices, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function CheckErrors
+ *
+ * @brief check the error completion
+ *
+ * This function disables the second bus with two sensor reads queued and
+ * checks both complete with the bus error while a flash read on the first
+ * bus completes normally.  It then starts a long flash write, disables the
+ * first bus part way through and checks that the write completes with the
+ * error, releasing its chip select, and that the flash read queued behind
+ * it also fails cleanly.  With the buses enabled again a read on each works
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckErrors( void )
+{
+  int               iErrors = 0;
+  SPITRANSMNGRSTATS tStats;
+  U32               uEnable;
+
+  // queued on a disabled bus
+  Reset( );
+  uEnable = 0;
+  Spi_Ioctl( SPI_DEV_ENUM_BUS1, SPI_IOCTLACTION_ENABLEDISABLE, &uEnable );
+  SetupRead( 0, SHORT_DATA_LEN );
+  SetupRead( 1, SHORT_DATA_LEN );
+  SetupRead( 2, SHORT_DATA_LEN );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_SENSOR, &atTrans[ 0 ] );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_SENSOR, &atTrans[ 1 ] );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 2 ] );
+  RunUntilIdle( );
+  if (( atTrans[ 0 ].eStatus != SPITRANS_STS_ERROR ) || ( atTrans[ 0 ].eError != SPI_ERR_ILLMODE ) ||
+      ( atTrans[ 1 ].eStatus != SPITRANS_STS_ERROR ) || ( atTrans[ 1 ].eError != SPI_ERR_ILLMODE ) ||
+      ( atTrans[ 2 ].eStatus != SPITRANS_STS_DONE ) || ( nNumDone != 3 ))
+  {
+    printf( "  errors: disabled bus, status %d %d %d, %d completed\n", atTrans[ 0 ].eStatus, atTrans[ 1 ].eStatus, atTrans[ 2 ].eStatus, nNumDone );
+    iErrors++;
+  }
+
+  // disabled part way through a write
+  SetupWrite( 3, LONG_DATA_LEN );
+  SetupRead( 4, SHORT_DATA_LEN );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 3 ] );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 4 ] );
+  SpiTransactionManager_Process( );
+  if (( atTrans[ 3 ].eStatus != SPITRANS_STS_ACTIVE ) || ( !abCsAsserted[ SPITRANS_DEV_ENUM_FLASH ] ))
+  {
+    printf( "  errors: write not in progress, status %d\n", atTrans[ 3 ].eStatus );
+    iErrors++;
+  }
+  Spi_Ioctl( SPI_DEV_ENUM_BUS0, SPI_IOCTLACTION_ENABLEDISABLE, &uEnable );
+  RunUntilIdle( );
+  if (( atTrans[ 3 ].eStatus != SPITRANS_STS_ERROR ) || ( atTrans[ 3 ].eError != SPI_ERR_ILLMODE ) ||
+      ( atTrans[ 4 ].eStatus != SPITRANS_STS_ERROR ) || ( nNumDone != 5 ) || ( anOrder[ 3 ] != 3 ) || ( anOrder[ 4 ] != 4 ))
+  {
+    printf( "  errors: disabled in progress, status %d %d, %d completed\n", atTrans[ 3 ].eStatus, atTrans[ 4 ].eStatus, nNumDone );
+    iErrors++;
+  }
+  iErrors += CheckCsBalanced( "errors" );
+  SpiTransactionManager_GetStats( &tStats, TRUE );
+  if (( tStats.uCompleted != 5 ) || ( tStats.uErrors != 4 ))
+  {
+    printf( "  errors: %u completed, %u errors\n", tStats.uCompleted, tStats.uErrors );
+    iErrors++;
+  }
+
+  // enable them, a completed transaction can be submitted again
+  uEnable = 1;
+  Spi_Ioctl( SPI_DEV_ENUM_BUS0, SPI_IOCTLACTION_ENABLEDISABLE, &uEnable );
+  Spi_Ioctl( SPI_DEV_ENUM_BUS1, SPI_IOCTLACTION_ENABLEDISABLE, &uEnable );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_SENSOR, &atTrans[ 0 ] );
+  SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_DISPLAY, &atTrans[ 4 ] );
+  RunUntilIdle( );
+  if (( atTrans[ 0 ].eStatus != SPITRANS_STS_DONE ) || ( atTrans[ 0 ].eError != SPI_ERR_NONE ) || ( atTrans[ 4 ].eStatus != SPITRANS_STS_DONE ))
+  {
+    printf( "  errors: after enable, status %d %d\n", atTrans[ 0 ].eStatus, atTrans[ 4 ].eStatus );
+    iErrors++;
+  }
+  iErrors += CheckCsBalanced( "errors" );
+
+  // report
+  printf( "%-12s %u completed with an error, %d errors\n", "errors", tStats.uErrors, iErrors );
+  return( iErrors );
+}
+
+/******************************************************************************
+ * @function CheckSubmit
+ *
+ * @brief check the submit errors
+ *
+ * This function checks an illegal device, illegal transactions, a full
+ * transaction and a second submit of a queued transaction
+ *
+ * @return      number of errors
+ *
+ *****************************************************************************/
+static int CheckSubmit( void )
+{
+  int   iErrors = 0;
+  U8    nPhase;
+
+  // illegal device/empty transaction
+  Reset( );
+  SetupRead( 0, SHORT_DATA_LEN );
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_MAX, &atTrans[ 0 ] ) != SPITRANSMNGR_ERR_ILLDEV );
+  SpiTransactionManager_Clear( &atTrans[ 1 ] );
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 1 ] ) != SPITRANSMNGR_ERR_ILLPRM );
+
+  // a command without bytes, data without a buffer
+  SpiTransactionManager_AddPhase( &atTrans[ 1 ], SPITRANS_PHASETYPE_CMD, 0, 0x9F, NULL, 0 );
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 1 ] ) != SPITRANSMNGR_ERR_ILLPRM );
+  SpiTransactionManager_Clear( &atTrans[ 1 ] );
+  SpiTransactionManager_AddPhase( &atTrans[ 1 ], SPITRANS_PHASETYPE_READ, 0, 0, NULL, 4 );
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 1 ] ) != SPITRANSMNGR_ERR_ILLPRM );
+
+  // a full transaction refuses another phase
+  SpiTransactionManager_Clear( &atTrans[ 1 ] );
+  for ( nPhase = 0; nPhase < SPITRANSMNGR_MAX_PHASES; nPhase++ )
+  {
+    iErrors += ( SpiTransactionManager_AddPhase( &atTrans[ 1 ], SPITRANS_PHASETYPE_DUMMY, 1, 0, NULL, 0 ) != FALSE );
+  }
+  iErrors += ( SpiTransactionManager_AddPhase( &atTrans[ 1 ], SPITRANS_PHASETYPE_DUMMY, 1, 0, NULL, 0 ) != TRUE );
+
+  // a queued transaction is busy
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_FLASH, &atTrans[ 0 ] ) != SPITRANSMNGR_ERR_NONE );
+  iErrors += ( SpiTransactionManager_Submit( SPITRANS_DEV_ENUM_DISPLAY, &atTrans[ 0 ] ) != SPITRANSMNGR_ERR_BUSY );
+  RunUntilIdle( );
+  iErrors += (( nNumDone != 1 ) || ( atTrans[ 0 ].eStatus != SPITRANS_STS_DONE ));
+  iErrors += CheckCsBalanced( "submit" );
+
+  // report
+  printf( "%-12s %d errors\n", "submit", iErrors );
+  return( iErrors );
+}
+
+/**@} EOF SpiTransactionManagerTest.c */
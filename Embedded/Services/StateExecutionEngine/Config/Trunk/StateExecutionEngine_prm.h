@@ -56,6 +56,9 @@
   #define STATEEXECENG_ARG_SIZE_BYTES             ( 2 )
 #endif  // SYSTEMDEFINE_OS_SELECTION
 
+/// define the macro to enable compiling the event tables into RAM
+#define STATEEXECENG_ENABLE_COMPILE               ( ON )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
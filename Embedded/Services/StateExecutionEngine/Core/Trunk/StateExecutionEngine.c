@@ -27,6 +27,10 @@
 // local function prototypes --------------------------------------------------
 static  void            ChangeStates( PSTATEEXECENGCONTROL ptControl, U8 nNewState );
 static  STATEEXECENGARG GetEventFromTable( STATEEXECENGEVENT const* ptEvents, U8 nEventIndex );
+#if ( STATEEXECENG_ENABLE_COMPILE == ON )
+static  U8              GetNumEvents( STATEEXECENGEVENT const* ptEvents );
+static  STATEEXECENGEVENT const* FindCompiledEvent( PSTATEEXECENGCONTROL ptControl, STATEEXECENGARG xEvent );
+#endif  // STATEEXECENG_ENABLE_COMPILE
 
 /******************************************************************************
  * @function StateExecutionEngine_Initialize
@@ -77,6 +81,9 @@ void StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGA
   PVSTATEEXECENGEXCFUNC		  pvExecFunc;
   STATEEXECENGEVENT const*  ptEvents;
   STATEEXECENGTABLE const*  ptStates;
+  #if ( STATEEXECENG_ENABLE_COMPILE == ON )
+  STATEEXECENGEVENT const*  ptCmpEvent;
+  #endif  // STATEEXECENG_ENABLE_COMPILE
   
   // get the pointer to the current state table
   ptStates = &ptControl->ptStates[ ptControl->nCurState ];
@@ -91,6 +98,24 @@ void StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGA
   // clear the state change flag
   bStateChangeReq = FALSE;
 
+  #if ( STATEEXECENG_ENABLE_COMPILE == ON )
+  // are the event tables compiled
+  if ( ptControl->ptCmpStates != NULL )
+  {
+    // search the sorted events
+    if (( ptCmpEvent = FindCompiledEvent( ptControl, xEvent )) != NULL )
+    {
+      // set the found flag
+      bStateChangeReq = TRUE;
+
+      // set the next state/exit flag
+      nNextState = ptCmpEvent->nNextState;
+      ptControl->bExecExit = ptCmpEvent->bExecuteExit;
+    }
+  }
+  else
+  #endif  // STATEEXECENG_ENABLE_COMPILE
+
   // do we have an event table
   if ( ptEvents != NULL )
   {
@@ -142,6 +167,137 @@ void StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGA
   }
 }
 
+#if ( STATEEXECENG_ENABLE_COMPILE == ON )
+/******************************************************************************
+ * @function StateExecutionEngine_GetCompiledSize
+ *
+ * @brief get the size of the compiled tables
+ *
+ * This function will return the number of bytes of RAM needed to compile the
+ * event tables of a state table
+ *
+ * @param[in]   ptStates    pointer to the state table
+ * @param[in]   nNumStates  number of states
+ *
+ * @return      size in bytes
+ *
+ *****************************************************************************/
+U16 StateExecutionEngine_GetCompiledSize( STATEEXECENGTABLE const* ptStates, U8 nNumStates )
+{
+  U16 wNumEvents = 0;
+  U8  nState;
+
+  // for each state
+  for ( nState = 0; nState < nNumStates; nState++ )
+  {
+    // add the number of events
+    wNumEvents += GetNumEvents(( PSTATEEXECENGEVENT )PGM_RDWORD( ptStates[ nState ].ptEventTable ));
+  }
+
+  // return the size
+  return(( wNumEvents * STATEEXECENGEVENT_SIZE ) + ( nNumStates * STATEEXECENGCMPSTATE_SIZE ));
+}
+
+/******************************************************************************
+ * @function StateExecutionEngine_Compile
+ *
+ * @brief compile the event tables
+ *
+ * This function will copy the event table of each state into the buffer
+ * sorted by event, so that process can binary search them instead of walking
+ * the table.  The first entry is kept when an event appears more than once, as
+ * the walk would.  If the buffer is NULL or too small, the tables will be
+ * walked as before.  The state table must be set in the control structure
+ * first, this can be called before or after initialize
+ *
+ * @param[in]   ptControl   pointer to the control structure
+ * @param[in]   nNumStates  number of states
+ * @param[in]   pvBuffer    pointer to the buffer
+ * @param[in]   wBufferSize size of the buffer
+ *
+ * @return      TRUE if the tables will be walked, FALSE if compiled
+ *
+ *****************************************************************************/
+BOOL StateExecutionEngine_Compile( PSTATEEXECENGCONTROL ptControl, U8 nNumStates, PVOID pvBuffer, U16 wBufferSize )
+{
+  BOOL                      bStatus = TRUE;
+  PSTATEEXECENGEVENT        ptSorted;
+  PSTATEEXECENGCMPSTATE     ptCmpStates;
+  STATEEXECENGEVENT const*  ptEvents;
+  STATEEXECENGARG           xEvent;
+  U16                       wNumEvents, wFirst, wIndex;
+  U8                        nState, nEventIndex, nNumSorted;
+
+  // clear the compiled tables
+  ptControl->ptCmpStates = NULL;
+  ptControl->ptCmpEvents = NULL;
+
+  // check for room
+  if (( pvBuffer != NULL ) && ( StateExecutionEngine_GetCompiledSize( ptControl->ptStates, nNumStates ) <= wBufferSize ))
+  {
+    // count the events, the sorted events go first, the states after them
+    wNumEvents = 0;
+    for ( nState = 0; nState < nNumStates; nState++ )
+    {
+      wNumEvents += GetNumEvents(( PSTATEEXECENGEVENT )PGM_RDWORD( ptControl->ptStates[ nState ].ptEventTable ));
+    }
+    ptSorted = ( PSTATEEXECENGEVENT )pvBuffer;
+    ptCmpStates = ( PSTATEEXECENGCMPSTATE )&ptSorted[ wNumEvents ];
+
+    // for each state
+    wFirst = 0;
+    for ( nState = 0; nState < nNumStates; nState++ )
+    {
+      // get the event table
+      ptEvents = ( PSTATEEXECENGEVENT )PGM_RDWORD( ptControl->ptStates[ nState ].ptEventTable );
+      nNumSorted = 0;
+
+      // insert each event in order
+      if ( ptEvents != NULL )
+      {
+        nEventIndex = 0;
+        while (( xEvent = GetEventFromTable( ptEvents, nEventIndex )) != 0 )
+        {
+          // skip a duplicate, the first one wins as it does in the walk
+          for ( wIndex = wFirst; ( wIndex < ( wFirst + nNumSorted )) && ( ptSorted[ wIndex ].xEvent != xEvent ); wIndex++ );
+          if ( wIndex == ( wFirst + nNumSorted ))
+          {
+            // move the larger events up
+            while (( wIndex > wFirst ) && ( ptSorted[ wIndex - 1 ].xEvent > xEvent ))
+            {
+              ptSorted[ wIndex ] = ptSorted[ wIndex - 1 ];
+              wIndex--;
+            }
+
+            // insert it
+            ptSorted[ wIndex ].xEvent = xEvent;
+            ptSorted[ wIndex ].nNextState = PGM_RDBYTE( ptEvents[ nEventIndex ].nNextState );
+            ptSorted[ wIndex ].bExecuteExit = PGM_RDBYTE( ptEvents[ nEventIndex ].bExecuteExit );
+            nNumSorted++;
+          }
+
+          // next event
+          nEventIndex++;
+        }
+      }
+
+      // set the compiled state
+      ptCmpStates[ nState ].wFirstEvent = wFirst;
+      ptCmpStates[ nState ].nNumEvents = nNumSorted;
+      wFirst += nNumSorted;
+    }
+
+    // set the compiled tables
+    ptControl->ptCmpEvents = ptSorted;
+    ptControl->ptCmpStates = ptCmpStates;
+    bStatus = FALSE;
+  }
+
+  // return the status
+  return( bStatus );
+}
+#endif  // STATEEXECENG_ENABLE_COMPILE
+
 /******************************************************************************
  * @function ChangeStates
  *
@@ -217,4 +373,82 @@ static STATEEXECENGARG GetEventFromTable( STATEEXECENGEVENT const* ptEvents, U8
   return( xEvent );
 }
 
+#if ( STATEEXECENG_ENABLE_COMPILE == ON )
+/******************************************************************************
+ * @function GetNumEvents
+ *
+ * @brief get the number of events in a table
+ *
+ * This function will count the events in a table up to the terminator
+ *
+ * @param[in]   ptEvents    pointer to the event table
+ *
+ * @return      number of events
+ *
+ *****************************************************************************/
+static U8 GetNumEvents( STATEEXECENGEVENT const* ptEvents )
+{
+  U8  nNumEvents = 0;
+
+  // do we have an event table
+  if ( ptEvents != NULL )
+  {
+    // count to the terminator
+    while ( GetEventFromTable( ptEvents, nNumEvents ) != 0 )
+    {
+      nNumEvents++;
+    }
+  }
+
+  // return the count
+  return( nNumEvents );
+}
+
+/******************************************************************************
+ * @function FindCompiledEvent
+ *
+ * @brief find an event in the compiled tables
+ *
+ * This function will binary search the sorted events of the current state
+ *
+ * @param[in]   ptControl   pointer to the control structure
+ * @param[in]   xEvent      event to find
+ *
+ * @return      pointer to the event or NULL if not found
+ *
+ *****************************************************************************/
+static STATEEXECENGEVENT const* FindCompiledEvent( PSTATEEXECENGCONTROL ptControl, STATEEXECENGARG xEvent )
+{
+  STATEEXECENGEVENT const*  ptBase;
+  STATEEXECENGEVENT const*  ptFound = NULL;
+  U8                        nCount, nHalf;
+
+  // get the events for the current state
+  ptBase = &ptControl->ptCmpEvents[ ptControl->ptCmpStates[ ptControl->nCurState ].wFirstEvent ];
+  nCount = ptControl->ptCmpStates[ ptControl->nCurState ].nNumEvents;
+
+  // check for events
+  if ( nCount != 0 )
+  {
+    // halve the range each pass, the select compiles without a branch
+    while ( nCount > 1 )
+    {
+      nHalf = nCount >> 1;
+      ptBase = ( ptBase[ nHalf ].xEvent <= xEvent ) ? &ptBase[ nHalf ] : ptBase;
+      nCount -= nHalf;
+    }
+
+    // check for a match
+    if ( ptBase->xEvent == xEvent )
+    {
+      // found it
+      ptFound = ptBase;
+    }
+  }
+
+  // return the event
+  return( ptFound );
+}
+#endif  // STATEEXECENG_ENABLE_COMPILE
+
 /**@} EOF StateExecutionEngine.c */
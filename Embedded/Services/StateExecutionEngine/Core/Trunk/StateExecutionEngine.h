@@ -111,6 +111,16 @@ typedef struct _STATEEXECENGTABLE
 } STATEEXECENGTABLE, *PSTATEEXECENGTABLE;
 #define STATEEXECENGTABLE_SIZE    sizeof( STATEEXECENGTABLE )
 
+#if ( STATEEXECENG_ENABLE_COMPILE == ON )
+/// define the compiled state structure
+typedef struct _STATEEXECENGCMPSTATE
+{
+  U16                       wFirstEvent;  ///< index of the first sorted event
+  U8                        nNumEvents;   ///< number of events
+} STATEEXECENGCMPSTATE, *PSTATEEXECENGCMPSTATE;
+#define STATEEXECENGCMPSTATE_SIZE sizeof( STATEEXECENGCMPSTATE )
+#endif  // STATEEXECENG_ENABLE_COMPILE
+
 /// define the control structure
 typedef struct _STATEEXECENGCONTROL
 {
@@ -121,6 +131,10 @@ typedef struct _STATEEXECENGCONTROL
   BOOL                      bExecExit;    ///< execute the exit function for this event
   BOOL                      bFlushEvent;  ///< flush event flag
   STATEEXECENGTABLE const*  ptStates;     ///< pointer to the states for this instance
+  #if ( STATEEXECENG_ENABLE_COMPILE == ON )
+  STATEEXECENGCMPSTATE const* ptCmpStates;  ///< pointer to the compiled states, NULL to walk the tables
+  STATEEXECENGEVENT const*    ptCmpEvents;  ///< pointer to the compiled events
+  #endif  // STATEEXECENG_ENABLE_COMPILE
   //  PVOID                     pvArg;        ///< pointer to an user supplied argument
 } STATEEXECENGCONTROL, *PSTATEEXECENGCONTROL;
 #define STATEEXECENGCONTROL_SIZE  sizeof( STATEEXECENGCONTROL )
@@ -128,6 +142,10 @@ typedef struct _STATEEXECENGCONTROL
 // global function prototypes --------------------------------------------------
 extern  void  StateExecutionEngine_Initialize( PSTATEEXECENGCONTROL ptControl, U8 nDefaultState );
 extern  void  StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGARG xEvent );
+#if ( STATEEXECENG_ENABLE_COMPILE == ON )
+extern  U16   StateExecutionEngine_GetCompiledSize( STATEEXECENGTABLE const* ptStates, U8 nNumStates );
+extern  BOOL  StateExecutionEngine_Compile( PSTATEEXECENGCONTROL ptControl, U8 nNumStates, PVOID pvBuffer, U16 wBufferSize );
+#endif  // STATEEXECENG_ENABLE_COMPILE
 
 /**@} EOF StateExecutionEngine.h */
 
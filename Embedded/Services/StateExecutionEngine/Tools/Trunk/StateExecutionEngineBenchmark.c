@@ -0,0 +1,421 @@
+/******************************************************************************
+ * @file StateExecutionEngineBenchmark.c
+ *
+ * @brief state execution engine benchmark
+ *
+ * This file provides a host tool that checks the compiled event tables against
+ * the table walk and times both.  It builds random state machines, runs the
+ * same random event stream through an instance that walks the tables and an
+ * instance that uses the compiled tables, and compares the sequence of entry,
+ * execute and exit calls.  It then times the lookup on long tables fed one
+ * byte at a time, the case for the command handlers.  It exits non zero on
+ * any mismatch.
+ *
+ * build with: cc -O2 -I. -I<include root> -o StateExecutionEngineBenchmark
+ *             StateExecutionEngineBenchmark.c ../../Core/Trunk/StateExecutionEngine.c
+ * usage:      StateExecutionEngineBenchmark [machines] [events] [seed]
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup StateExecutionEngine
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+  #include <x86intrin.h>
+#endif
+
+// local includes -------------------------------------------------------------
+#include "StateExecutionEngine/StateExecutionEngine.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the defaults
+#define DEFAULT_MACHINES                            ( 200 )
+#define DEFAULT_EVENTS                              ( 20000 )
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the number of states, must match the functions below
+#define NUM_STATES                                  ( 16 )
+
+/// define the largest event table and the event range
+#define MAX_EVENTS                                  ( 60 )
+#define EVENT_RANGE                                 ( 256 )
+
+/// define the benchmark table length and passes
+#define BENCH_EVENTS                                ( 48 )
+#define BENCH_STREAM                                ( 4096 )
+#define BENCH_PASSES                                ( 500 )
+
+/// define the helper to declare the functions for a state
+#define STATE_FUNCS( n ) \
+  static void Ent##n( void ) { Trace( 'N', n ); } \
+  static U8   Exc##n( STATEEXECENGARG xArg ) { return( Execute( n, xArg )); } \
+  static void Ext##n( void ) { Trace( 'X', n ); }
+
+/// define the helper to list the functions for a state
+#define STATE_FUNCS_ENTRY( n )    { Ent##n, Exc##n, Ext##n }
+
+// structures -----------------------------------------------------------------
+/// define the functions for a state
+typedef struct _FUNCS
+{
+  PVSTATEEXECENGENTFUNC   pvEntry;
+  PVSTATEEXECENGEXCFUNC   pvExec;
+  PVSTATEEXECENGEXTFUNC   pvExit;
+} FUNCS;
+
+// local parameter declarations -----------------------------------------------
+static  U32                 uTraceHash;
+static  U32                 uTraceCount;
+static  BOOL                bBenchMode;
+static  STATEEXECENGEVENT   aatEvents[ NUM_STATES ][ MAX_EVENTS + 1 ];
+static  STATEEXECENGTABLE   atStates[ NUM_STATES ];
+static  STATEEXECENGARG     axStream[ BENCH_STREAM ];
+static  U8                  anBuffer[ NUM_STATES * (( MAX_EVENTS * STATEEXECENGEVENT_SIZE ) + STATEEXECENGCMPSTATE_SIZE ) ];
+
+// local function prototypes --------------------------------------------------
+static  void    Trace( U8 nKind, U8 nState );
+static  U8      Execute( U8 nState, STATEEXECENGARG xArg );
+static  void    BuildMachine( int iMaxEvents, BOOL bAllFuncs );
+static  U32     RunMachine( BOOL bCompiled, int iEvents, unsigned uSeed, PU8 pnFinal );
+static  void    RunBenchmark( void );
+static  double  TimeStream( PSTATEEXECENGCONTROL ptControl, U64* phCycles );
+
+// state functions ------------------------------------------------------------
+STATE_FUNCS( 0 )  STATE_FUNCS( 1 )  STATE_FUNCS( 2 )  STATE_FUNCS( 3 )
+STATE_FUNCS( 4 )  STATE_FUNCS( 5 )  STATE_FUNCS( 6 )  STATE_FUNCS( 7 )
+STATE_FUNCS( 8 )  STATE_FUNCS( 9 )  STATE_FUNCS( 10 ) STATE_FUNCS( 11 )
+STATE_FUNCS( 12 ) STATE_FUNCS( 13 ) STATE_FUNCS( 14 ) STATE_FUNCS( 15 )
+
+// constant parameter initializations -----------------------------------------
+static  const FUNCS atFuncs[ NUM_STATES ] =
+{
+  STATE_FUNCS_ENTRY( 0 ),  STATE_FUNCS_ENTRY( 1 ),  STATE_FUNCS_ENTRY( 2 ),  STATE_FUNCS_ENTRY( 3 ),
+  STATE_FUNCS_ENTRY( 4 ),  STATE_FUNCS_ENTRY( 5 ),  STATE_FUNCS_ENTRY( 6 ),  STATE_FUNCS_ENTRY( 7 ),
+  STATE_FUNCS_ENTRY( 8 ),  STATE_FUNCS_ENTRY( 9 ),  STATE_FUNCS_ENTRY( 10 ), STATE_FUNCS_ENTRY( 11 ),
+  STATE_FUNCS_ENTRY( 12 ), STATE_FUNCS_ENTRY( 13 ), STATE_FUNCS_ENTRY( 14 ), STATE_FUNCS_ENTRY( 15 ),
+};
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry point
+ *
+ * This function will run the random machines through both modes, then run
+ * the benchmark
+ *
+ * @param[in]   iArgc       argument count
+ * @param[in]   ppszArgv    arguments
+ *
+ * @return      0 for pass, 1 for fail
+ *
+ *****************************************************************************/
+int main( int iArgc, char** ppszArgv )
+{
+  int       iMachines, iEvents, iMachine, iErrors;
+  unsigned  uSeed;
+  U32       uWalkHash, uCmpHash, uCalls;
+  U8        nWalkFinal, nCmpFinal;
+
+  // get the arguments
+  iMachines = ( iArgc > 1 ) ? atoi( ppszArgv[ 1 ] ) : DEFAULT_MACHINES;
+  iEvents = ( iArgc > 2 ) ? atoi( ppszArgv[ 2 ] ) : DEFAULT_EVENTS;
+  uSeed = ( iArgc > 3 ) ? atoi( ppszArgv[ 3 ] ) : DEFAULT_SEED;
+  srand( uSeed );
+  iErrors = 0;
+  uCalls = 0;
+
+  // for each machine
+  for ( iMachine = 0; iMachine < iMachines; iMachine++ )
+  {
+    // build it, run it both ways and compare
+    BuildMachine( 1 + ( rand( ) % MAX_EVENTS ), ( iMachine & 1 ));
+    uWalkHash = RunMachine( FALSE, iEvents, uSeed + iMachine, &nWalkFinal );
+    uCalls += uTraceCount;
+    uCmpHash = RunMachine( TRUE, iEvents, uSeed + iMachine, &nCmpFinal );
+    if (( uWalkHash != uCmpHash ) || ( nWalkFinal != nCmpFinal ))
+    {
+      if ( iErrors++ < 10 )
+      {
+        printf( "  mismatch machine %d: walk %08X/%d compiled %08X/%d\n", iMachine, uWalkHash, nWalkFinal, uCmpHash, nCmpFinal );
+      }
+    }
+  }
+
+  // check the fall back with a short buffer
+  BuildMachine( MAX_EVENTS, TRUE );
+  {
+    STATEEXECENGCONTROL tControl;
+    memset( &tControl, 0, STATEEXECENGCONTROL_SIZE );
+    tControl.ptStates = atStates;
+    if (( StateExecutionEngine_Compile( &tControl, NUM_STATES, anBuffer, 16 ) != TRUE ) || ( tControl.ptCmpStates != NULL ))
+    {
+      printf( "  short buffer did not fall back\n" );
+      iErrors++;
+    }
+  }
+
+  // report
+  printf( "equivalence: %d machines x %d events, %u calls traced, %d mismatches\n", iMachines, iEvents, uCalls, iErrors );
+  RunBenchmark( );
+  printf( "%s\n", ( iErrors == 0 ) ? "PASS" : "FAIL" );
+  return(( iErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function Trace
+ *
+ * @brief trace an entry/exit call
+ *
+ * This function will add a call to the trace hash
+ *
+ * @param[in]   nKind       kind of call
+ * @param[in]   nState      state
+ *
+ *****************************************************************************/
+static void Trace( U8 nKind, U8 nState )
+{
+  // add it to the hash
+  if ( !bBenchMode )
+  {
+    uTraceHash = ( uTraceHash ^ (( nKind << 8 ) | nState )) * 16777619UL;
+    uTraceCount++;
+  }
+}
+
+/******************************************************************************
+ * @function Execute
+ *
+ * @brief execute function
+ *
+ * This function will trace the call and change state for some events
+ *
+ * @param[in]   nState      state
+ * @param[in]   xArg        event
+ *
+ * @return      next state or none
+ *
+ *****************************************************************************/
+static U8 Execute( U8 nState, STATEEXECENGARG xArg )
+{
+  U8  nNextState = STATEEXECENG_STATE_NONE;
+
+  // trace it, the hash includes the event
+  Trace( 'E', nState );
+  Trace( 'A', ( U8 )xArg );
+
+  // change state on one event in seven
+  if (( !bBenchMode ) && ((( xArg * 31 ) + nState ) % 7 ) == 0 )
+  {
+    nNextState = ( xArg + nState ) % NUM_STATES;
+  }
+
+  // return the next state
+  return( nNextState );
+}
+
+/******************************************************************************
+ * @function BuildMachine
+ *
+ * @brief build a random machine
+ *
+ * This function will build random event tables for each state, with repeated
+ * events, some empty tables and some missing functions
+ *
+ * @param[in]   iMaxEvents  largest event table
+ * @param[in]   bAllFuncs   TRUE to give every state all functions
+ *
+ *****************************************************************************/
+static void BuildMachine( int iMaxEvents, BOOL bAllFuncs )
+{
+  int iState, iEvent, iNumEvents;
+
+  // for each state
+  for ( iState = 0; iState < NUM_STATES; iState++ )
+  {
+    // build the event table
+    iNumEvents = rand( ) % ( iMaxEvents + 1 );
+    for ( iEvent = 0; iEvent < iNumEvents; iEvent++ )
+    {
+      aatEvents[ iState ][ iEvent ].xEvent = 1 + ( rand( ) % ( EVENT_RANGE - 1 ));
+      aatEvents[ iState ][ iEvent ].nNextState = rand( ) % NUM_STATES;
+      aatEvents[ iState ][ iEvent ].bExecuteExit = rand( ) & 1;
+    }
+    aatEvents[ iState ][ iNumEvents ].xEvent = 0;
+
+    // fill the state, some with no table or functions
+    atStates[ iState ].nState = iState;
+    atStates[ iState ].ptEventTable = (( rand( ) % 8 ) == 0 ) ? NULL : aatEvents[ iState ];
+    atStates[ iState ].tFuncs.pvEntryFunc = ( bAllFuncs || ( rand( ) % 4 )) ? atFuncs[ iState ].pvEntry : NULL;
+    atStates[ iState ].tFuncs.pvExecuteFunc = ( bAllFuncs || ( rand( ) % 4 )) ? atFuncs[ iState ].pvExec : NULL;
+    atStates[ iState ].tFuncs.pvExitFunc = ( bAllFuncs || ( rand( ) % 4 )) ? atFuncs[ iState ].pvExit : NULL;
+  }
+}
+
+/******************************************************************************
+ * @function RunMachine
+ *
+ * @brief run a machine
+ *
+ * This function will run a random event stream through the machine
+ *
+ * @param[in]   bCompiled   TRUE to compile the tables
+ * @param[in]   iEvents     number of events
+ * @param[in]   uSeed       stream seed
+ * @param[out]  pnFinal     final state
+ *
+ * @return      trace hash
+ *
+ *****************************************************************************/
+static U32 RunMachine( BOOL bCompiled, int iEvents, unsigned uSeed, PU8 pnFinal )
+{
+  STATEEXECENGCONTROL tControl;
+  int                 iEvent;
+  unsigned            uRand;
+
+  // reset the trace
+  uTraceHash = 2166136261UL;
+  uTraceCount = 0;
+
+  // set up the control, compile after initialize to check either order works
+  memset( &tControl, 0, STATEEXECENGCONTROL_SIZE );
+  tControl.ptStates = atStates;
+  StateExecutionEngine_Initialize( &tControl, 0 );
+  if ( bCompiled )
+  {
+    if ( StateExecutionEngine_Compile( &tControl, NUM_STATES, anBuffer, sizeof( anBuffer )) != FALSE )
+    {
+      printf( "  compile failed\n" );
+    }
+  }
+
+  // run the stream, zero included
+  uRand = uSeed;
+  for ( iEvent = 0; iEvent < iEvents; iEvent++ )
+  {
+    uRand = ( uRand * 1103515245UL ) + 12345;
+    StateExecutionEngine_Process( &tControl, ( uRand >> 16 ) % EVENT_RANGE );
+    Trace( 'S', tControl.nCurState );
+  }
+
+  // return the results
+  *( pnFinal ) = tControl.nCurState;
+  return( uTraceHash );
+}
+
+/******************************************************************************
+ * @function RunBenchmark
+ *
+ * @brief time both lookups
+ *
+ * This function will build a machine with full tables that do not change
+ * state, and time a byte stream where half the events are in the table
+ *
+ *****************************************************************************/
+static void RunBenchmark( void )
+{
+  STATEEXECENGCONTROL tWalk, tCmp;
+  int                 iState, iEvent;
+  double              dWalk, dCmp;
+  U64                 hWalk, hCmp;
+
+  // build full tables, every event stays in the same state
+  for ( iState = 0; iState < NUM_STATES; iState++ )
+  {
+    for ( iEvent = 0; iEvent < BENCH_EVENTS; iEvent++ )
+    {
+      aatEvents[ iState ][ iEvent ].xEvent = 1 + ( iEvent * 2 );
+      aatEvents[ iState ][ iEvent ].nNextState = iState;
+      aatEvents[ iState ][ iEvent ].bExecuteExit = FALSE;
+    }
+    aatEvents[ iState ][ BENCH_EVENTS ].xEvent = 0;
+    atStates[ iState ].nState = iState;
+    atStates[ iState ].ptEventTable = aatEvents[ iState ];
+    atStates[ iState ].tFuncs.pvEntryFunc = NULL;
+    atStates[ iState ].tFuncs.pvExecuteFunc = atFuncs[ iState ].pvExec;
+    atStates[ iState ].tFuncs.pvExitFunc = NULL;
+  }
+
+  // random bytes in the table range, odd ones match
+  for ( iEvent = 0; iEvent < BENCH_STREAM; iEvent++ )
+  {
+    axStream[ iEvent ] = 1 + ( rand( ) % ( BENCH_EVENTS * 2 ));
+  }
+
+  // set up both
+  bBenchMode = TRUE;
+  memset( &tWalk, 0, STATEEXECENGCONTROL_SIZE );
+  tWalk.ptStates = atStates;
+  StateExecutionEngine_Initialize( &tWalk, 0 );
+  memcpy( &tCmp, &tWalk, STATEEXECENGCONTROL_SIZE );
+  StateExecutionEngine_Compile( &tCmp, NUM_STATES, anBuffer, sizeof( anBuffer ));
+
+  // time them
+  dWalk = TimeStream( &tWalk, &hWalk );
+  dCmp = TimeStream( &tCmp, &hCmp );
+  bBenchMode = FALSE;
+
+  // report
+  printf( "benchmark: %d events per state, %d byte stream x %d passes, %d bytes compiled\n",
+          BENCH_EVENTS, BENCH_STREAM, BENCH_PASSES, StateExecutionEngine_GetCompiledSize( atStates, NUM_STATES ));
+  printf( "  table walk   %8.2f ns %8.1f cycles per event\n", dWalk, ( double )hWalk / (( double )BENCH_STREAM * BENCH_PASSES ));
+  printf( "  compiled     %8.2f ns %8.1f cycles per event\n", dCmp, ( double )hCmp / (( double )BENCH_STREAM * BENCH_PASSES ));
+}
+
+/******************************************************************************
+ * @function TimeStream
+ *
+ * @brief time the stream
+ *
+ * This function will time the stream through a machine
+ *
+ * @param[in]   ptControl   pointer to the control
+ * @param[out]  phCycles    total cycles, zero if not available
+ *
+ * @return      nanoseconds per event
+ *
+ *****************************************************************************/
+static double TimeStream( PSTATEEXECENGCONTROL ptControl, U64* phCycles )
+{
+  struct timespec tStart, tStop;
+  int             iPass, iEvent;
+  U64             hStart = 0, hStop = 0;
+
+  // time it
+  clock_gettime( CLOCK_MONOTONIC, &tStart );
+  #if defined( __x86_64__ ) || defined( __i386__ )
+    hStart = __rdtsc( );
+  #endif
+  for ( iPass = 0; iPass < BENCH_PASSES; iPass++ )
+  {
+    for ( iEvent = 0; iEvent < BENCH_STREAM; iEvent++ )
+    {
+      StateExecutionEngine_Process( ptControl, axStream[ iEvent ] );
+    }
+  }
+  #if defined( __x86_64__ ) || defined( __i386__ )
+    hStop = __rdtsc( );
+  #endif
+  clock_gettime( CLOCK_MONOTONIC, &tStop );
+
+  // return the times
+  *( phCycles ) = hStop - hStart;
+  return(((( tStop.tv_sec - tStart.tv_sec ) * 1e9 ) + ( tStop.tv_nsec - tStart.tv_nsec )) / (( double )BENCH_STREAM * BENCH_PASSES ));
+}
+
+/**@} EOF StateExecutionEngineBenchmark.c */
@@ -287,6 +287,142 @@ void SystemMonitor_ProcessTransmit( void )
   BinaryCommandHandler_SendMessage( nLclCmdEnum );
 }
 
+/******************************************************************************
+ * @function SystemMonitor_GetEntryValue
+ *
+ * @brief get the value of an entry
+ *
+ * This function will fetch the current value of an entry, sign extended to
+ * 32 bits for integer types, and return its type
+ *
+ * @param[in]   eEntry      entry enumeration
+ * @param[io]   peEntType   pointer to store the entry type
+ * @param[io]   ptValue     pointer to store the value
+ *
+ * @return      TRUE if illegal entry, FALSE otherwise
+ *
+ *****************************************************************************/
+BOOL SystemMonitor_GetEntryValue( SYSMONENUM eEntry, PSYSMONENTTYPE peEntType, PU32UN ptValue )
+{
+  BOOL                bStatus = FALSE;
+  PSYSMONENTDEF       ptDef;
+  SYSMONENTTYPE       eEntType;
+  U32                 uOption;
+  PVSYSMONGETU8       pvGetU8;
+  PVSYSMONGETS8       pvGetS8;
+  PVSYSMONGETU16      pvGetU16;
+  PVSYSMONGETS16      pvGetS16;
+  PVSYSMONGETU32      pvGetU32;
+  PVSYSMONGETS32      pvGetS32;
+  PVSYSMONGETFLOAT    pvGetFloat;
+  PVSYSMONGETOPTU8    pvGetOptU8;
+  PVSYSMONGETOPTS8    pvGetOptS8;
+  PVSYSMONGETOPTU16   pvGetOptU16;
+  PVSYSMONGETOPTS16   pvGetOptS16;
+  PVSYSMONGETOPTU32   pvGetOptU32;
+  PVSYSMONGETOPTS32   pvGetOptS32;
+  PVSYSMONGETOPTFLOAT pvGetOptFloat;
+
+  // check for a valid enumeration
+  if ( eEntry < SYSMON_ENUM_MAX )
+  {
+    // get a pointer to the definition/get the type and option
+    ptDef = ( PSYSMONENTDEF )&atSysMonDefs[ eEntry ];
+    eEntType = PGM_RDBYTE( ptDef->eType );
+    uOption = PGM_RDDWRD( ptDef->uOption );
+
+    // get the value
+    switch( eEntType )
+    {
+      case SYSMON_ENTTYPE_U8 :
+        pvGetU8 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetU8 );
+        ptValue->uValue = pvGetU8( );
+        break;
+
+      case SYSMON_ENTTYPE_S8 :
+        pvGetS8 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetS8 );
+        ptValue->lValue = pvGetS8( );
+        break;
+
+      case SYSMON_ENTTYPE_U16 :
+        pvGetU16 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetU16 );
+        ptValue->uValue = pvGetU16( );
+        break;
+
+      case SYSMON_ENTTYPE_S16 :
+        pvGetS16 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetS16 );
+        ptValue->lValue = pvGetS16( );
+        break;
+
+      case SYSMON_ENTTYPE_U32 :
+        pvGetU32 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetU32 );
+        ptValue->uValue = pvGetU32( );
+        break;
+
+      case SYSMON_ENTTYPE_S32 :
+        pvGetS32 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetS32 );
+        ptValue->lValue = pvGetS32( );
+        break;
+
+      case SYSMON_ENTTYPE_FLOAT :
+        pvGetFloat = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetFloat );
+        ptValue->fValue = pvGetFloat( );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_U8 :
+        pvGetOptU8 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptU8 );
+        ptValue->uValue = pvGetOptU8( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_S8 :
+        pvGetOptS8 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptS8 );
+        ptValue->lValue = pvGetOptS8( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_U16 :
+        pvGetOptU16 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptU16 );
+        ptValue->uValue = pvGetOptU16( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_S16 :
+        pvGetOptS16 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptS16 );
+        ptValue->lValue = pvGetOptS16( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_U32 :
+        pvGetOptU32 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptU32 );
+        ptValue->uValue = pvGetOptU32( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_S32 :
+        pvGetOptS32 = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptS32 );
+        ptValue->lValue = pvGetOptS32( uOption );
+        break;
+
+      case SYSMON_ENTTYPE_OPT_FLOAT :
+        pvGetOptFloat = PGM_RDDWRD( ptDef->pvGetFuncs.pvGetOptFloat );
+        ptValue->fValue = pvGetOptFloat( uOption );
+        break;
+
+      default :
+        // illegal type
+        bStatus = TRUE;
+        break;
+    }
+
+    // return the type
+    *( peEntType ) = eEntType;
+  }
+  else
+  {
+    // set the error
+    bStatus = TRUE;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
 /******************************************************************************
  * @function ProcessSetup
  *
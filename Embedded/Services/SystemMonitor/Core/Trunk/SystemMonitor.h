@@ -80,6 +80,7 @@ typedef enum _SYSMONCMDS
 // global function prototypes --------------------------------------------------
 extern  BOOL        SystemMonitor_Initialize( void );
 extern  void        SystemMonitor_ProcessTransmit( void );
+extern  BOOL        SystemMonitor_GetEntryValue( SYSMONENUM eEntry, PSYSMONENTTYPE peEntType, PU32UN ptValue );
 
 /**@} EOF SystemMonitor.h */
 
@@ -168,7 +168,7 @@ typedef enum _SYSMONENTTYPE
   SYSMON_ENTTYPE_OPT_S32,         ///< signed 32 bit
   SYSMON_ENTTYPE_OPT_FLOAT,       ///< float
   SYSMON_ENTTYPE_MAX,
-} SYSMONENTTYPE;
+} SYSMONENTTYPE, *PSYSMONENTTYPE;
 
 // structures -----------------------------------------------------------------
 /// define the get value protototypes
@@ -0,0 +1,223 @@
+/******************************************************************************
+ * @file UpdateManager_cfg.c
+ *
+ * @brief update manager configuration implementation
+ *
+ * This file provides the flash access for the update manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "UpdateManager/UpdateManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+#if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  #include <stdio.h>
+#else
+  #include "BootLoader/BootLoader.h"
+#endif // UPDATEMANAGER_BACKEND
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+#if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  static  FILE*   ptImage;
+#endif // UPDATEMANAGER_BACKEND
+
+// local function prototypes --------------------------------------------------
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function UpdateManager_LocalInitialize
+ *
+ * @brief update manager local initialization
+ *
+ * This function will perform any local initialization, the file backend
+ * opens the image here, creating an erased one if not present
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL UpdateManager_LocalInitialize( void )
+{
+  BOOL  bStatus = FALSE;
+  #if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  U32   uIndex;
+
+  // open the image, create an erased one if not present
+  if (( ptImage = fopen( UPDATEMANAGER_FILE_IMAGE_NAME, "r+b" )) == NULL )
+  {
+    if (( ptImage = fopen( UPDATEMANAGER_FILE_IMAGE_NAME, "w+b" )) != NULL )
+    {
+      // fill it
+      for ( uIndex = 0; uIndex < UPDATEMANAGER_FILE_IMAGE_SIZE; uIndex++ )
+      {
+        fputc( 0xFF, ptImage );
+      }
+      fflush( ptImage );
+    }
+  }
+
+  // set the status
+  bStatus = ( ptImage == NULL ) ? TRUE : FALSE;
+  #endif // UPDATEMANAGER_BACKEND
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_LocalRead
+ *
+ * @brief read a block
+ *
+ * This function will read a block of data from the flash
+ *
+ * @param[in]   uAddress    address to read from
+ * @param[in]   pnData      pointer to the data storage
+ * @param[in]   wLength     length to read
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL UpdateManager_LocalRead( U32 uAddress, PU8 pnData, U16 wLength )
+{
+  BOOL  bStatus = FALSE;
+
+  #if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  // read from the image
+  bStatus = (( fseek( ptImage, uAddress, SEEK_SET ) == 0 ) && ( fread( pnData, 1, wLength, ptImage ) == wLength )) ? FALSE : TRUE;
+  #endif // UPDATEMANAGER_BACKEND
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_LocalWrite
+ *
+ * @brief write a block
+ *
+ * This function will program a block of data into erased flash, the file
+ * backend behaves like NOR flash and can only clear bits
+ *
+ * @param[in]   uAddress    address to write to
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length to write
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL UpdateManager_LocalWrite( U32 uAddress, PU8 pnData, U16 wLength )
+{
+  BOOL  bStatus = FALSE;
+  #if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  U8    anBlock[ UPDATEMANAGER_WRITE_BLOCK_SIZE ];
+  U16   wIndex, wSize;
+
+  // for each block
+  while (( bStatus == FALSE ) && ( wLength != 0 ))
+  {
+    // read the current contents, programming can only clear bits
+    wSize = MIN( wLength, UPDATEMANAGER_WRITE_BLOCK_SIZE );
+    if (( bStatus = UpdateManager_LocalRead( uAddress, anBlock, wSize )) == FALSE )
+    {
+      for ( wIndex = 0; wIndex < wSize; wIndex++ )
+      {
+        anBlock[ wIndex ] &= *( pnData + wIndex );
+      }
+
+      // write it back
+      bStatus = (( fseek( ptImage, uAddress, SEEK_SET ) == 0 ) && ( fwrite( anBlock, 1, wSize, ptImage ) == wSize )) ? FALSE : TRUE;
+    }
+
+    // adjust the pointers
+    uAddress += wSize;
+    pnData += wSize;
+    wLength -= wSize;
+  }
+  fflush( ptImage );
+  #endif // UPDATEMANAGER_BACKEND
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_LocalErase
+ *
+ * @brief erase a sector
+ *
+ * This function will erase the sector at an address
+ *
+ * @param[in]   uAddress    sector address
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL UpdateManager_LocalErase( U32 uAddress )
+{
+  BOOL  bStatus = FALSE;
+  #if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FILE )
+  U32   uIndex;
+
+  // fill the sector
+  if ( fseek( ptImage, uAddress, SEEK_SET ) == 0 )
+  {
+    for ( uIndex = 0; uIndex < UPDATEMANAGER_SECTOR_SIZE; uIndex++ )
+    {
+      fputc( 0xFF, ptImage );
+    }
+    fflush( ptImage );
+  }
+  else
+  {
+    bStatus = TRUE;
+  }
+  #endif // UPDATEMANAGER_BACKEND
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_LocalActivate
+ *
+ * @brief activate the new image
+ *
+ * This function will hand over to the boot loader once a new boot record
+ * has been written
+ *
+ *****************************************************************************/
+void UpdateManager_LocalActivate( void )
+{
+  #if ( UPDATEMANAGER_BACKEND == UPDATEMANAGER_BACKEND_FLASH )
+  // enter the boot loader, it runs the slot in the boot record
+  BootLoader_Enter( FALSE );
+  #endif // UPDATEMANAGER_BACKEND
+}
+
+/**@} EOF UpdateManager_cfg.c */
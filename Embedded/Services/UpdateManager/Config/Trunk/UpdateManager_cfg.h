@@ -0,0 +1,54 @@
+/******************************************************************************
+ * @file UpdateManager_cfg.h
+ *
+ * @brief update manager configuration declarations
+ *
+ * This file provides the declarations for the update manager configuration
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _UPDATEMANAGER_CFG_H
+#define _UPDATEMANAGER_CFG_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// local includes -------------------------------------------------------------
+#include "UpdateManager/UpdateManager_prm.h"
+#include "UpdateManager/UpdateManager_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  BOOL  UpdateManager_LocalInitialize( void );
+extern  BOOL  UpdateManager_LocalRead( U32 uAddress, PU8 pnData, U16 wLength );
+extern  BOOL  UpdateManager_LocalWrite( U32 uAddress, PU8 pnData, U16 wLength );
+extern  BOOL  UpdateManager_LocalErase( U32 uAddress );
+extern  void  UpdateManager_LocalActivate( void );
+
+/**@} EOF UpdateManager_cfg.h */
+
+#endif  // _UPDATEMANAGER_CFG_H
@@ -0,0 +1,1089 @@
+/******************************************************************************
+ * @file UpdateManager.c
+ *
+ * @brief update manager implementation
+ *
+ * This file provides the implementation of the staged firmware update.  A
+ * package is received in chunks into the staging area with progress records
+ * so the transfer can resume after a reset, it is verified with its CRC and
+ * then decoded into the inactive image slot.  The package payload is either
+ * the image or a delta against the running image, and may be zstd
+ * compressed.  Once the new image has been verified a boot record selecting
+ * the new slot is written and the boot loader is entered.
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "UpdateManager/UpdateManager.h"
+
+// library includes -----------------------------------------------------------
+#include "CRC32/CRC32.h"
+#if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+  #define ZSTD_STATIC_LINKING_ONLY
+  #include "Ztp/zstd.h"
+#endif // UPDATEMANAGER_ENABLE_COMPRESSION
+
+// Macros and Defines ---------------------------------------------------------
+/// define the size of the local buffers
+#define IO_BUF_SIZE                                 ( 256 )
+
+/// define the macro to get the address of a slot
+#define SLOT_ADDR( slot )                           (( slot ) ? UPDATEMANAGER_SLOT_B_ADDR : UPDATEMANAGER_SLOT_A_ADDR )
+
+/// define the macro to get the other boot record sector
+#define OTHER_BOOTREC( sector )                     ((( sector ) == UPDATEMANAGER_BOOTREC_ADDR ) ? UPDATEMANAGER_BOOTREC_ALT_ADDR : UPDATEMANAGER_BOOTREC_ADDR )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the local states
+typedef enum _LCLSTATE
+{
+  LCL_STATE_IDLE = 0,             ///< no update in progress
+  LCL_STATE_RECEIVING,            ///< receiving the payload
+  LCL_STATE_VERIFIED,             ///< payload received and verified
+} LCLSTATE;
+
+// structures -----------------------------------------------------------------
+/// define the delta decoder control structure
+typedef struct _DELTACTL
+{
+  U8    anOpHdr[ UPDATEDELTA_COPY_HDR_SIZE ]; ///< operation header
+  U8    nHdrIdx;                    ///< operation header index
+  U32   uRemaining;                 ///< data bytes remaining in the operation
+} DELTACTL, *PDELTACTL;
+#define DELTACTL_SIZE                               sizeof( DELTACTL )
+
+/// define the target control structure
+typedef struct _TARGETCTL
+{
+  U32   uBaseAddress;               ///< address of the target slot
+  U32   uWritten;                   ///< bytes written to the target
+  U32   uFlushed;                   ///< bytes programmed into the flash
+  U16   wBlockIdx;                  ///< bytes in the write block
+} TARGETCTL, *PTARGETCTL;
+#define TARGETCTL_SIZE                              sizeof( TARGETCTL )
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+static  LCLSTATE            eLclState;
+static  UPDATEPACKAGEHEADER tPackage;
+static  U32                 uReceived;
+static  UPDATEPROGRESS      tProgress;
+static  U32                 uProgressAddr;
+static  UPDATEBOOTREC       tBootRec;
+static  U32                 uBootRecSector;
+static  U32                 uBootRecAddr;
+static  DELTACTL            tDeltaCtl;
+static  TARGETCTL           tTargetCtl;
+static  U8                  anIoBuf[ IO_BUF_SIZE ];
+static  U8                  anCopyBuf[ IO_BUF_SIZE ];
+static  U8                  anBlock[ UPDATEMANAGER_WRITE_BLOCK_SIZE ];
+#if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+static  U8                  anDecWorkspace[ UPDATEMANAGER_DECOMP_WORKSIZE ] ALIGNED8;
+static  U8                  anDecOut[ IO_BUF_SIZE ];
+static  ZSTD_DStream*       ptDecStream;
+static  size_t              tDecResult;
+#endif // UPDATEMANAGER_ENABLE_COMPRESSION
+
+// local function prototypes --------------------------------------------------
+static  UPDATEMANAGERSTS  DecodeBlock( PU8 pnData, U16 wLength );
+static  UPDATEMANAGERSTS  ProcessDelta( PU8 pnData, U16 wLength );
+static  UPDATEMANAGERSTS  CopyBase( U32 uOffset, U32 uLength );
+static  UPDATEMANAGERSTS  WriteTarget( PU8 pnData, U16 wLength );
+static  UPDATEMANAGERSTS  FlushTarget( void );
+static  BOOL              ScanRecords( U32 uSectorAddr, U32 uMagic, PU8 pnRecord, U16 wRecSize, PU32 puNextAddr );
+static  BOOL              AppendRecord( U32 uSectorAddr, PU8 pnRecord, U16 wRecSize, PU32 puNextAddr );
+static  BOOL              ReadBootRecord( void );
+static  BOOL              WriteBootRecord( PUPDATEBOOTREC ptRecord );
+static  BOOL              WriteProgress( void );
+static  U32               ComputeCrc( U32 uCrc, PU8 pnData, U32 uLength );
+static  U32               ComputeFlashCrc( U32 uAddress, U32 uLength );
+static  U32               GetU32( PU8 pnData );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function UpdateManager_Initialize
+ *
+ * @brief update manager initialization
+ *
+ * This function will initialize the flash access, recover the last boot and
+ * progress records and create the decoder if enabled
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+BOOL UpdateManager_Initialize( void )
+{
+  BOOL  bStatus;
+
+  // clear the state
+  eLclState = LCL_STATE_IDLE;
+  uReceived = 0;
+
+  // perform the local initialization
+  if (( bStatus = UpdateManager_LocalInitialize( )) == FALSE )
+  {
+    // recover the boot record, default to a confirmed slot A
+    if ( !ReadBootRecord( ))
+    {
+      memset( &tBootRec, 0, UPDATEBOOTREC_SIZE );
+      tBootRec.uMagic = UPDATEBOOTREC_MAGIC;
+    }
+
+    // recover the progress record
+    if ( !ScanRecords( UPDATEMANAGER_PROGRESS_ADDR, UPDATEPROGRESS_MAGIC, ( PU8 )&tProgress, UPDATEPROGRESS_SIZE, &uProgressAddr ))
+    {
+      memset( &tProgress, 0, UPDATEPROGRESS_SIZE );
+    }
+  }
+
+  #if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+  // create the decoder in its static workspace
+  if (( ptDecStream = ZSTD_initStaticDStream( anDecWorkspace, UPDATEMANAGER_DECOMP_WORKSIZE )) != NULL )
+  {
+    // limit the window to what the workspace was sized for
+    ZSTD_DCtx_setParameter( ptDecStream, ZSTD_d_windowLogMax, UPDATEMANAGER_DECOMP_WINDOWLOG );
+  }
+  else
+  {
+    bStatus = TRUE;
+  }
+  #endif // UPDATEMANAGER_ENABLE_COMPRESSION
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Begin
+ *
+ * @brief begin an update
+ *
+ * This function will validate a package header and start receiving it, if
+ * the progress record is for the same package the transfer resumes
+ *
+ * @param[in]   ptHeader        pointer to the package header
+ * @param[io]   puResumeOffset  pointer to store the payload offset to send next
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+UPDATEMANAGERSTS UpdateManager_Begin( PUPDATEPACKAGEHEADER ptHeader, PU32 puResumeOffset )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U16               wSupported = UPDATEPACKAGE_FLAG_DELTA;
+
+  #if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+  // compressed packages can be decoded
+  wSupported |= UPDATEPACKAGE_FLAG_COMPRESSED;
+  #endif // UPDATEMANAGER_ENABLE_COMPRESSION
+
+  // validate the header
+  if (( ptHeader->uMagic != UPDATEPACKAGE_MAGIC ) || ( ptHeader->wVersion != UPDATEPACKAGE_VERSION ) ||
+      ( ~ComputeCrc( CRC32_GetInitialValue( ), ( PU8 )ptHeader, UPDATEPACKAGEHEADER_SIZE - sizeof( U32 )) != ptHeader->uHeaderCrc ))
+  {
+    eStatus = UPDATEMANAGER_STS_ILLHEADER;
+  }
+  else if ( ptHeader->wFlags & ~wSupported )
+  {
+    eStatus = UPDATEMANAGER_STS_NOTSUPPORTED;
+  }
+  else if (( ptHeader->uPayloadSize > UPDATEMANAGER_STAGING_SIZE ) || ( ptHeader->uImageSize > UPDATEMANAGER_SLOT_SIZE ) || ( ptHeader->uBaseSize > UPDATEMANAGER_SLOT_SIZE ))
+  {
+    eStatus = UPDATEMANAGER_STS_TOOLARGE;
+  }
+  else if (( ptHeader->wFlags & UPDATEPACKAGE_FLAG_DELTA ) && ( ComputeFlashCrc( SLOT_ADDR( tBootRec.nSlot ), ptHeader->uBaseSize ) != ptHeader->uBaseCrc ))
+  {
+    eStatus = UPDATEMANAGER_STS_BASEMISMATCH;
+  }
+  else
+  {
+    // check for a resume of the same package
+    if (( tProgress.uMagic == UPDATEPROGRESS_MAGIC ) && ( memcmp( &tProgress.tHeader, ptHeader, UPDATEPACKAGEHEADER_SIZE ) == 0 ))
+    {
+      // resume
+      uReceived = tProgress.uReceived;
+    }
+    else
+    {
+      // start over
+      uReceived = 0;
+      memcpy( &tProgress.tHeader, ptHeader, UPDATEPACKAGEHEADER_SIZE );
+      if ( WriteProgress( ))
+      {
+        eStatus = UPDATEMANAGER_STS_FLASHERROR;
+      }
+    }
+
+    // save the header/set the state
+    memcpy( &tPackage, ptHeader, UPDATEPACKAGEHEADER_SIZE );
+    eLclState = ( eStatus == UPDATEMANAGER_STS_OK ) ? LCL_STATE_RECEIVING : LCL_STATE_IDLE;
+    *( puResumeOffset ) = uReceived;
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Write
+ *
+ * @brief write a chunk of the payload
+ *
+ * This function will stage a chunk of the payload, chunks must be written in
+ * order, a progress record is written each time a sector is filled
+ *
+ * @param[in]   uOffset     payload offset of the chunk
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+UPDATEMANAGERSTS UpdateManager_Write( U32 uOffset, PU8 pnData, U16 wLength )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U32               uAddress;
+  U16               wSize;
+
+  // check for valid
+  if ( eLclState != LCL_STATE_RECEIVING )
+  {
+    eStatus = UPDATEMANAGER_STS_ILLSTATE;
+  }
+  else if ( uOffset != uReceived )
+  {
+    eStatus = UPDATEMANAGER_STS_SEQUENCE;
+  }
+  else if ( wLength > ( tPackage.uPayloadSize - uReceived ))
+  {
+    eStatus = UPDATEMANAGER_STS_TOOLARGE;
+  }
+  else
+  {
+    // while there is data
+    while (( eStatus == UPDATEMANAGER_STS_OK ) && ( wLength != 0 ))
+    {
+      // erase the sector on entry
+      uAddress = UPDATEMANAGER_STAGING_ADDR + uReceived;
+      wSize = MIN( wLength, UPDATEMANAGER_SECTOR_SIZE - ( uReceived % UPDATEMANAGER_SECTOR_SIZE ));
+      if ((( uReceived % UPDATEMANAGER_SECTOR_SIZE ) == 0 ) && ( UpdateManager_LocalErase( uAddress )))
+      {
+        eStatus = UPDATEMANAGER_STS_FLASHERROR;
+      }
+      else if ( UpdateManager_LocalWrite( uAddress, pnData, wSize ))
+      {
+        eStatus = UPDATEMANAGER_STS_FLASHERROR;
+      }
+      else
+      {
+        // adjust the counts
+        uReceived += wSize;
+        pnData += wSize;
+        wLength -= wSize;
+
+        // record the progress on a full sector or the end of the payload
+        if ((( uReceived % UPDATEMANAGER_SECTOR_SIZE ) == 0 ) || ( uReceived == tPackage.uPayloadSize ))
+        {
+          eStatus = ( WriteProgress( )) ? UPDATEMANAGER_STS_FLASHERROR : UPDATEMANAGER_STS_OK;
+        }
+      }
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Verify
+ *
+ * @brief verify the payload
+ *
+ * This function will check that the payload is complete and that its CRC
+ * matches the package header, on a CRC error the update is aborted
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+UPDATEMANAGERSTS UpdateManager_Verify( void )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+
+  // check for valid
+  if ( eLclState == LCL_STATE_IDLE )
+  {
+    eStatus = UPDATEMANAGER_STS_ILLSTATE;
+  }
+  else if ( uReceived != tPackage.uPayloadSize )
+  {
+    eStatus = UPDATEMANAGER_STS_INCOMPLETE;
+  }
+  else if ( ComputeFlashCrc( UPDATEMANAGER_STAGING_ADDR, tPackage.uPayloadSize ) != tPackage.uPayloadCrc )
+  {
+    // clear the progress so the package is sent again from the start
+    UpdateManager_Abort( );
+    eStatus = UPDATEMANAGER_STS_CRCERROR;
+  }
+  else
+  {
+    // verified
+    eLclState = LCL_STATE_VERIFIED;
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Apply
+ *
+ * @brief apply the update
+ *
+ * This function will decode the verified payload into the inactive slot,
+ * verify the image, write a pending boot record for the new slot and enter
+ * the boot loader.  The running image is not touched so a failure at any
+ * point leaves it intact
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+UPDATEMANAGERSTS UpdateManager_Apply( void )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  UPDATEBOOTREC     tNewRec;
+  U32               uOffset;
+  U16               wSize;
+
+  // check for valid
+  if ( eLclState != LCL_STATE_VERIFIED )
+  {
+    eStatus = UPDATEMANAGER_STS_ILLSTATE;
+  }
+  else
+  {
+    // set up the decoders and the target
+    memset( &tDeltaCtl, 0, DELTACTL_SIZE );
+    memset( &tTargetCtl, 0, TARGETCTL_SIZE );
+    tTargetCtl.uBaseAddress = SLOT_ADDR( tBootRec.nSlot ^ 1 );
+    #if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+    ZSTD_DCtx_reset( ptDecStream, ZSTD_reset_session_only );
+    tDecResult = 0;
+    #endif // UPDATEMANAGER_ENABLE_COMPRESSION
+
+    // decode the payload
+    for ( uOffset = 0; ( eStatus == UPDATEMANAGER_STS_OK ) && ( uOffset < tPackage.uPayloadSize ); uOffset += wSize )
+    {
+      wSize = MIN( IO_BUF_SIZE, tPackage.uPayloadSize - uOffset );
+      if ( UpdateManager_LocalRead( UPDATEMANAGER_STAGING_ADDR + uOffset, anIoBuf, wSize ))
+      {
+        eStatus = UPDATEMANAGER_STS_FLASHERROR;
+      }
+      else
+      {
+        eStatus = DecodeBlock( anIoBuf, wSize );
+      }
+    }
+
+    // check for a complete decode
+    #if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+    if (( eStatus == UPDATEMANAGER_STS_OK ) && ( tDecResult != 0 ))
+    {
+      eStatus = UPDATEMANAGER_STS_DECODEERROR;
+    }
+    #endif // UPDATEMANAGER_ENABLE_COMPRESSION
+    if (( eStatus == UPDATEMANAGER_STS_OK ) && (( tDeltaCtl.nHdrIdx != 0 ) || ( tDeltaCtl.uRemaining != 0 )))
+    {
+      eStatus = UPDATEMANAGER_STS_DECODEERROR;
+    }
+    if ( eStatus == UPDATEMANAGER_STS_OK )
+    {
+      eStatus = FlushTarget( );
+    }
+    if (( eStatus == UPDATEMANAGER_STS_OK ) && ( tTargetCtl.uWritten != tPackage.uImageSize ))
+    {
+      eStatus = UPDATEMANAGER_STS_DECODEERROR;
+    }
+
+    // verify the image as programmed
+    if (( eStatus == UPDATEMANAGER_STS_OK ) && ( ComputeFlashCrc( tTargetCtl.uBaseAddress, tPackage.uImageSize ) != tPackage.uImageCrc ))
+    {
+      eStatus = UPDATEMANAGER_STS_CRCERROR;
+    }
+
+    // check for success
+    if ( eStatus == UPDATEMANAGER_STS_OK )
+    {
+      // write the boot record for the new slot
+      tNewRec.uMagic = UPDATEBOOTREC_MAGIC;
+      tNewRec.nSlot = tBootRec.nSlot ^ 1;
+      tNewRec.nState = UPDATEBOOT_STATE_PENDING;
+      tNewRec.wSequence = tBootRec.wSequence + 1;
+      tNewRec.uImageSize = tPackage.uImageSize;
+      tNewRec.uImageCrc = tPackage.uImageCrc;
+      if ( WriteBootRecord( &tNewRec ))
+      {
+        eStatus = UPDATEMANAGER_STS_FLASHERROR;
+      }
+      else
+      {
+        // clear the progress, enter the boot loader
+        memcpy( &tBootRec, &tNewRec, UPDATEBOOTREC_SIZE );
+        UpdateManager_Abort( );
+        UpdateManager_LocalActivate( );
+      }
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Confirm
+ *
+ * @brief confirm the running image
+ *
+ * This function will mark a pending image as good, it is called by the new
+ * image once it is satisfied that it runs
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+UPDATEMANAGERSTS UpdateManager_Confirm( void )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  UPDATEBOOTREC     tNewRec;
+
+  // check for pending
+  if ( tBootRec.nState != UPDATEBOOT_STATE_PENDING )
+  {
+    eStatus = UPDATEMANAGER_STS_ILLSTATE;
+  }
+  else
+  {
+    // write the confirmed record
+    memcpy( &tNewRec, &tBootRec, UPDATEBOOTREC_SIZE );
+    tNewRec.nState = UPDATEBOOT_STATE_CONFIRMED;
+    tNewRec.wSequence++;
+    if ( WriteBootRecord( &tNewRec ))
+    {
+      eStatus = UPDATEMANAGER_STS_FLASHERROR;
+    }
+    else
+    {
+      memcpy( &tBootRec, &tNewRec, UPDATEBOOTREC_SIZE );
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function UpdateManager_Abort
+ *
+ * @brief abort an update
+ *
+ * This function will abort an update and clear the progress so the next
+ * transfer starts over
+ *
+ *****************************************************************************/
+void UpdateManager_Abort( void )
+{
+  // clear the state
+  eLclState = LCL_STATE_IDLE;
+  uReceived = 0;
+
+  // clear the progress if there is any
+  if ( tProgress.tHeader.uMagic != 0 )
+  {
+    memset( &tProgress.tHeader, 0, UPDATEPACKAGEHEADER_SIZE );
+    WriteProgress( );
+  }
+}
+
+/******************************************************************************
+ * @function UpdateManager_GetActiveSlot
+ *
+ * @brief get the active slot
+ *
+ * This function will return the slot selected by the boot record
+ *
+ * @return      the slot, 0 for A, 1 for B
+ *
+ *****************************************************************************/
+U8 UpdateManager_GetActiveSlot( void )
+{
+  // return the slot
+  return( tBootRec.nSlot );
+}
+
+/******************************************************************************
+ * @function UpdateManager_GetReceived
+ *
+ * @brief get the received count
+ *
+ * This function will return the number of payload bytes staged, this is the
+ * offset of the next chunk to write
+ *
+ * @return      the received count
+ *
+ *****************************************************************************/
+U32 UpdateManager_GetReceived( void )
+{
+  // return the count
+  return( uReceived );
+}
+
+/******************************************************************************
+ * @function DecodeBlock
+ *
+ * @brief decode a block of the payload
+ *
+ * This function will decompress a block of the payload if needed and pass
+ * it on to the delta decoder or straight to the target
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+static UPDATEMANAGERSTS DecodeBlock( PU8 pnData, U16 wLength )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  #if ( UPDATEMANAGER_ENABLE_COMPRESSION == ON )
+  ZSTD_inBuffer     tInBuf;
+  ZSTD_outBuffer    tOutBuf;
+
+  // check for compressed
+  if ( tPackage.wFlags & UPDATEPACKAGE_FLAG_COMPRESSED )
+  {
+    // decompress until the input is used and the output is drained
+    tInBuf.src = pnData;
+    tInBuf.size = wLength;
+    tInBuf.pos = 0;
+    do
+    {
+      tOutBuf.dst = anDecOut;
+      tOutBuf.size = IO_BUF_SIZE;
+      tOutBuf.pos = 0;
+      tDecResult = ZSTD_decompressStream( ptDecStream, &tOutBuf, &tInBuf );
+      if ( ZSTD_isError( tDecResult ))
+      {
+        eStatus = UPDATEMANAGER_STS_DECODEERROR;
+      }
+      else if ( tPackage.wFlags & UPDATEPACKAGE_FLAG_DELTA )
+      {
+        eStatus = ProcessDelta( anDecOut, tOutBuf.pos );
+      }
+      else
+      {
+        eStatus = WriteTarget( anDecOut, tOutBuf.pos );
+      }
+    } while (( eStatus == UPDATEMANAGER_STS_OK ) && (( tInBuf.pos < tInBuf.size ) || ( tOutBuf.pos == tOutBuf.size )));
+  }
+  else
+  #endif // UPDATEMANAGER_ENABLE_COMPRESSION
+  if ( tPackage.wFlags & UPDATEPACKAGE_FLAG_DELTA )
+  {
+    eStatus = ProcessDelta( pnData, wLength );
+  }
+  else
+  {
+    eStatus = WriteTarget( pnData, wLength );
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function ProcessDelta
+ *
+ * @brief process delta data
+ *
+ * This function will run the delta operations, copies are taken from the
+ * running image and data is written as is
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+static UPDATEMANAGERSTS ProcessDelta( PU8 pnData, U16 wLength )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U16               wSize;
+
+  // while there is data
+  while (( eStatus == UPDATEMANAGER_STS_OK ) && ( wLength != 0 ))
+  {
+    // check for data in progress
+    if ( tDeltaCtl.uRemaining != 0 )
+    {
+      // write it
+      wSize = ( U16 )MIN( wLength, tDeltaCtl.uRemaining );
+      eStatus = WriteTarget( pnData, wSize );
+      tDeltaCtl.uRemaining -= wSize;
+      pnData += wSize;
+      wLength -= wSize;
+    }
+    else
+    {
+      // collect the operation header
+      tDeltaCtl.anOpHdr[ tDeltaCtl.nHdrIdx++ ] = *( pnData++ );
+      wLength--;
+
+      // process the operation
+      switch( tDeltaCtl.anOpHdr[ 0 ] )
+      {
+        case UPDATEDELTA_OP_DATA :
+          if ( tDeltaCtl.nHdrIdx == UPDATEDELTA_DATA_HDR_SIZE )
+          {
+            // start the data
+            tDeltaCtl.uRemaining = GetU32( &tDeltaCtl.anOpHdr[ 1 ] );
+            tDeltaCtl.nHdrIdx = 0;
+          }
+          break;
+
+        case UPDATEDELTA_OP_COPY :
+          if ( tDeltaCtl.nHdrIdx == UPDATEDELTA_COPY_HDR_SIZE )
+          {
+            // copy from the base
+            eStatus = CopyBase( GetU32( &tDeltaCtl.anOpHdr[ 5 ] ), GetU32( &tDeltaCtl.anOpHdr[ 1 ] ));
+            tDeltaCtl.nHdrIdx = 0;
+          }
+          break;
+
+        default :
+          eStatus = UPDATEMANAGER_STS_DECODEERROR;
+          break;
+      }
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function CopyBase
+ *
+ * @brief copy from the base image
+ *
+ * This function will copy a range of the running image to the target
+ *
+ * @param[in]   uOffset     offset in the base image
+ * @param[in]   uLength     length to copy
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+static UPDATEMANAGERSTS CopyBase( U32 uOffset, U32 uLength )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U16               wSize;
+
+  // check for valid range
+  if (( uLength > tPackage.uBaseSize ) || ( uOffset > ( tPackage.uBaseSize - uLength )))
+  {
+    eStatus = UPDATEMANAGER_STS_DECODEERROR;
+  }
+
+  // copy it
+  while (( eStatus == UPDATEMANAGER_STS_OK ) && ( uLength != 0 ))
+  {
+    wSize = ( U16 )MIN( uLength, IO_BUF_SIZE );
+    if ( UpdateManager_LocalRead( SLOT_ADDR( tBootRec.nSlot ) + uOffset, anCopyBuf, wSize ))
+    {
+      eStatus = UPDATEMANAGER_STS_FLASHERROR;
+    }
+    else
+    {
+      eStatus = WriteTarget( anCopyBuf, wSize );
+      uOffset += wSize;
+      uLength -= wSize;
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function WriteTarget
+ *
+ * @brief write to the target
+ *
+ * This function will add data to the write block and program it when full
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+static UPDATEMANAGERSTS WriteTarget( PU8 pnData, U16 wLength )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U16               wSize;
+
+  // check for overflow
+  if ( wLength > ( tPackage.uImageSize - tTargetCtl.uWritten ))
+  {
+    eStatus = UPDATEMANAGER_STS_DECODEERROR;
+  }
+
+  // while there is data
+  while (( eStatus == UPDATEMANAGER_STS_OK ) && ( wLength != 0 ))
+  {
+    // copy to the block
+    wSize = MIN( wLength, UPDATEMANAGER_WRITE_BLOCK_SIZE - tTargetCtl.wBlockIdx );
+    memcpy( &anBlock[ tTargetCtl.wBlockIdx ], pnData, wSize );
+    tTargetCtl.wBlockIdx += wSize;
+    tTargetCtl.uWritten += wSize;
+    pnData += wSize;
+    wLength -= wSize;
+
+    // program a full block
+    if ( tTargetCtl.wBlockIdx == UPDATEMANAGER_WRITE_BLOCK_SIZE )
+    {
+      eStatus = FlushTarget( );
+    }
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function FlushTarget
+ *
+ * @brief flush the target
+ *
+ * This function will program the write block, erasing each sector as it is
+ * entered
+ *
+ * @return      appropriate status
+ *
+ *****************************************************************************/
+static UPDATEMANAGERSTS FlushTarget( void )
+{
+  UPDATEMANAGERSTS  eStatus = UPDATEMANAGER_STS_OK;
+  U32               uAddress;
+
+  // check for data
+  if ( tTargetCtl.wBlockIdx != 0 )
+  {
+    // erase on sector entry/program
+    uAddress = tTargetCtl.uBaseAddress + tTargetCtl.uFlushed;
+    if ((( tTargetCtl.uFlushed % UPDATEMANAGER_SECTOR_SIZE ) == 0 ) && ( UpdateManager_LocalErase( uAddress )))
+    {
+      eStatus = UPDATEMANAGER_STS_FLASHERROR;
+    }
+    else if ( UpdateManager_LocalWrite( uAddress, anBlock, tTargetCtl.wBlockIdx ))
+    {
+      eStatus = UPDATEMANAGER_STS_FLASHERROR;
+    }
+
+    // adjust the counts
+    tTargetCtl.uFlushed += tTargetCtl.wBlockIdx;
+    tTargetCtl.wBlockIdx = 0;
+  }
+
+  // return the status
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function ScanRecords
+ *
+ * @brief scan a record sector
+ *
+ * This function will find the last valid record in a sector and the address
+ * of the first free slot, records start with the magic and end with a CRC
+ *
+ * @param[in]   uSectorAddr   sector address
+ * @param[in]   uMagic        record magic
+ * @param[io]   pnRecord      pointer to store the last valid record
+ * @param[in]   wRecSize      size of the record
+ * @param[io]   puNextAddr    pointer to store the free address
+ *
+ * @return      TRUE if a record was found, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL ScanRecords( U32 uSectorAddr, U32 uMagic, PU8 pnRecord, U16 wRecSize, PU32 puNextAddr )
+{
+  BOOL  bFound = FALSE;
+  U32   uAddress;
+
+  // for each record
+  for ( uAddress = uSectorAddr; uAddress <= ( uSectorAddr + UPDATEMANAGER_SECTOR_SIZE - wRecSize ); uAddress += wRecSize )
+  {
+    // read it, stop at the first erased one
+    if (( UpdateManager_LocalRead( uAddress, anIoBuf, wRecSize )) || ( GetU32( anIoBuf ) == 0xFFFFFFFF ))
+    {
+      break;
+    }
+
+    // keep it if valid
+    if (( GetU32( anIoBuf ) == uMagic ) && ( ~ComputeCrc( CRC32_GetInitialValue( ), anIoBuf, wRecSize - sizeof( U32 )) == GetU32( &anIoBuf[ wRecSize - sizeof( U32 ) ] )))
+    {
+      memcpy( pnRecord, anIoBuf, wRecSize );
+      bFound = TRUE;
+    }
+  }
+
+  // return the next address/status
+  *( puNextAddr ) = uAddress;
+  return( bFound );
+}
+
+/******************************************************************************
+ * @function AppendRecord
+ *
+ * @brief append a record
+ *
+ * This function will set the CRC of a record and append it to its sector,
+ * the sector is erased when full so this is only used for records that can
+ * be lost, such as the progress
+ *
+ * @param[in]   uSectorAddr   sector address
+ * @param[in]   pnRecord      pointer to the record
+ * @param[in]   wRecSize      size of the record
+ * @param[io]   puNextAddr    pointer to the free address
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL AppendRecord( U32 uSectorAddr, PU8 pnRecord, U16 wRecSize, PU32 puNextAddr )
+{
+  BOOL  bStatus = FALSE;
+  U32   uCrc;
+
+  // set the CRC
+  uCrc = ~ComputeCrc( CRC32_GetInitialValue( ), pnRecord, wRecSize - sizeof( U32 ));
+  memcpy( pnRecord + wRecSize - sizeof( U32 ), &uCrc, sizeof( U32 ));
+
+  // erase if full
+  if (( *( puNextAddr ) + wRecSize ) > ( uSectorAddr + UPDATEMANAGER_SECTOR_SIZE ))
+  {
+    bStatus = UpdateManager_LocalErase( uSectorAddr );
+    *( puNextAddr ) = uSectorAddr;
+  }
+
+  // write it
+  if ( bStatus == FALSE )
+  {
+    bStatus = UpdateManager_LocalWrite( *( puNextAddr ), pnRecord, wRecSize );
+    *( puNextAddr ) += wRecSize;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function ReadBootRecord
+ *
+ * @brief read the boot record
+ *
+ * This function will scan both boot record sectors and keep the valid record
+ * with the newest sequence.  Both sectors only hold records after a reset
+ * between moving to the other sector and erasing the full one, the stale
+ * sector is erased here
+ *
+ * @return      TRUE if a record was found, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL ReadBootRecord( void )
+{
+  UPDATEBOOTREC tAltRec;
+  U32           uAltAddr;
+  BOOL          bFound, bAltFound;
+
+  // scan both sectors
+  bFound = ScanRecords( UPDATEMANAGER_BOOTREC_ADDR, UPDATEBOOTREC_MAGIC, ( PU8 )&tBootRec, UPDATEBOOTREC_SIZE, &uBootRecAddr );
+  bAltFound = ScanRecords( UPDATEMANAGER_BOOTREC_ALT_ADDR, UPDATEBOOTREC_MAGIC, ( PU8 )&tAltRec, UPDATEBOOTREC_SIZE, &uAltAddr );
+  uBootRecSector = UPDATEMANAGER_BOOTREC_ADDR;
+
+  // use the alternate if it is the only one or newer
+  if ( bAltFound && ( !bFound || (( S16 )( tAltRec.wSequence - tBootRec.wSequence ) > 0 )))
+  {
+    memcpy( &tBootRec, &tAltRec, UPDATEBOOTREC_SIZE );
+    uBootRecSector = UPDATEMANAGER_BOOTREC_ALT_ADDR;
+    uBootRecAddr = uAltAddr;
+  }
+
+  // erase the stale sector
+  if ( bFound && bAltFound )
+  {
+    UpdateManager_LocalErase( OTHER_BOOTREC( uBootRecSector ));
+  }
+
+  // return the status
+  return( bFound || bAltFound );
+}
+
+/******************************************************************************
+ * @function WriteBootRecord
+ *
+ * @brief write a boot record
+ *
+ * This function will append a boot record to the current sector.  When the
+ * sector is full the record is written to the start of the other sector and
+ * only then is the full sector erased, so a reset at any point leaves a valid
+ * record in one of them
+ *
+ * @param[in]   ptRecord    pointer to the record
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL WriteBootRecord( PUPDATEBOOTREC ptRecord )
+{
+  BOOL  bStatus;
+  U32   uSector, uNextAddr;
+
+  // check for full
+  if (( uBootRecAddr + UPDATEBOOTREC_SIZE ) > ( uBootRecSector + UPDATEMANAGER_SECTOR_SIZE ))
+  {
+    // erase the other sector/write the record to it
+    uSector = OTHER_BOOTREC( uBootRecSector );
+    uNextAddr = uSector;
+    if ((( bStatus = UpdateManager_LocalErase( uSector )) == FALSE ) &&
+        (( bStatus = AppendRecord( uSector, ( PU8 )ptRecord, UPDATEBOOTREC_SIZE, &uNextAddr )) == FALSE ))
+    {
+      // now erase the full sector, a failure here leaves it stale and it is
+      // erased on the next initialization
+      UpdateManager_LocalErase( uBootRecSector );
+      uBootRecSector = uSector;
+      uBootRecAddr = uNextAddr;
+    }
+  }
+  else
+  {
+    // append it
+    bStatus = AppendRecord( uBootRecSector, ( PU8 )ptRecord, UPDATEBOOTREC_SIZE, &uBootRecAddr );
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function WriteProgress
+ *
+ * @brief write a progress record
+ *
+ * This function will append a progress record with the current count
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL WriteProgress( void )
+{
+  // fill in the record/append it
+  tProgress.uMagic = UPDATEPROGRESS_MAGIC;
+  tProgress.uReceived = uReceived;
+  return( AppendRecord( UPDATEMANAGER_PROGRESS_ADDR, ( PU8 )&tProgress, UPDATEPROGRESS_SIZE, &uProgressAddr ));
+}
+
+/******************************************************************************
+ * @function ComputeCrc
+ *
+ * @brief add a block to a CRC
+ *
+ * This function will add a block of data to a running CRC32
+ *
+ * @param[in]   uCrc        current CRC
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   uLength     length of the data
+ *
+ * @return      the updated CRC
+ *
+ *****************************************************************************/
+static U32 ComputeCrc( U32 uCrc, PU8 pnData, U32 uLength )
+{
+  // for each byte
+  while ( uLength-- != 0 )
+  {
+    uCrc = CRC32_CalculateByte( uCrc, *( pnData++ ));
+  }
+
+  // return the CRC
+  return( uCrc );
+}
+
+/******************************************************************************
+ * @function ComputeFlashCrc
+ *
+ * @brief compute the CRC of a flash range
+ *
+ * This function will compute the CRC32 of a range of the flash
+ *
+ * @param[in]   uAddress    start address
+ * @param[in]   uLength     length of the range
+ *
+ * @return      the CRC
+ *
+ *****************************************************************************/
+static U32 ComputeFlashCrc( U32 uAddress, U32 uLength )
+{
+  U32   uCrc;
+  U16   wSize;
+
+  // for each block
+  uCrc = CRC32_GetInitialValue( );
+  while ( uLength != 0 )
+  {
+    wSize = ( U16 )MIN( uLength, IO_BUF_SIZE );
+    UpdateManager_LocalRead( uAddress, anCopyBuf, wSize );
+    uCrc = ComputeCrc( uCrc, anCopyBuf, wSize );
+    uAddress += wSize;
+    uLength -= wSize;
+  }
+
+  // return the CRC
+  return( ~uCrc );
+}
+
+/******************************************************************************
+ * @function GetU32
+ *
+ * @brief get a little endian value
+ *
+ * This function will return a little endian 32 bit value
+ *
+ * @param[in]   pnData      pointer to the data
+ *
+ * @return      the value
+ *
+ *****************************************************************************/
+static U32 GetU32( PU8 pnData )
+{
+  // return the value
+  return(( U32 )*( pnData ) | (( U32 )*( pnData + 1 ) << 8 ) | (( U32 )*( pnData + 2 ) << 16 ) | (( U32 )*( pnData + 3 ) << 24 ));
+}
+
+/**@} EOF UpdateManager.c */
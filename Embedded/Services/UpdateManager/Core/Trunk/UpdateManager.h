@@ -0,0 +1,71 @@
+/******************************************************************************
+ * @file UpdateManager.h
+ *
+ * @brief update manager declarations
+ *
+ * This file provides the declarations for the update manager
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _UPDATEMANAGER_H
+#define _UPDATEMANAGER_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "UpdateManager/UpdateManager_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the status
+typedef enum _UPDATEMANAGERSTS
+{
+  UPDATEMANAGER_STS_OK = 0,       ///< no error
+  UPDATEMANAGER_STS_ILLHEADER,    ///< illegal package header
+  UPDATEMANAGER_STS_NOTSUPPORTED, ///< package type not supported
+  UPDATEMANAGER_STS_TOOLARGE,     ///< package or image too large
+  UPDATEMANAGER_STS_BASEMISMATCH, ///< delta base is not the running image
+  UPDATEMANAGER_STS_ILLSTATE,     ///< not allowed in this state
+  UPDATEMANAGER_STS_SEQUENCE,     ///< data not at the expected offset
+  UPDATEMANAGER_STS_INCOMPLETE,   ///< payload not completely received
+  UPDATEMANAGER_STS_CRCERROR,     ///< payload or image CRC error
+  UPDATEMANAGER_STS_DECODEERROR,  ///< payload could not be decoded
+  UPDATEMANAGER_STS_FLASHERROR,   ///< flash error
+} UPDATEMANAGERSTS;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  BOOL              UpdateManager_Initialize( void );
+extern  UPDATEMANAGERSTS  UpdateManager_Begin( PUPDATEPACKAGEHEADER ptHeader, PU32 puResumeOffset );
+extern  UPDATEMANAGERSTS  UpdateManager_Write( U32 uOffset, PU8 pnData, U16 wLength );
+extern  UPDATEMANAGERSTS  UpdateManager_Verify( void );
+extern  UPDATEMANAGERSTS  UpdateManager_Apply( void );
+extern  UPDATEMANAGERSTS  UpdateManager_Confirm( void );
+extern  void              UpdateManager_Abort( void );
+extern  U8                UpdateManager_GetActiveSlot( void );
+extern  U32               UpdateManager_GetReceived( void );
+
+/**@} EOF UpdateManager.h */
+
+#endif  // _UPDATEMANAGER_H
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * @file UpdateManager_def.h
+ *
+ * @brief update manager definition declarations
+ *
+ * This file provides the package, delta and record formats shared with the
+ * packager and the boot loader
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _UPDATEMANAGER_DEF_H
+#define _UPDATEMANAGER_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the package magic ( "FWUP" ) and version
+#define UPDATEPACKAGE_MAGIC                         ( 0x50555746 )
+#define UPDATEPACKAGE_VERSION                       ( 1 )
+
+/// define the package flags, a delta payload is a list of operations that
+/// build the image from the running image, a compressed payload is a single
+/// zstd frame wrapping the raw or delta payload
+#define UPDATEPACKAGE_FLAG_COMPRESSED               ( 0x0001 )
+#define UPDATEPACKAGE_FLAG_DELTA                    ( 0x0002 )
+
+/// define the delta operations, each is an op byte and a little endian
+/// length, a copy adds a little endian base offset and data is followed by
+/// length bytes
+#define UPDATEDELTA_OP_COPY                         ( 0x01 )
+#define UPDATEDELTA_OP_DATA                         ( 0x02 )
+#define UPDATEDELTA_DATA_HDR_SIZE                   ( 5 )
+#define UPDATEDELTA_COPY_HDR_SIZE                   ( 9 )
+
+/// define the record magics
+#define UPDATEPROGRESS_MAGIC                        ( 0x47525055 )
+#define UPDATEBOOTREC_MAGIC                         ( 0x54425055 )
+
+// enumerations ---------------------------------------------------------------
+/// enumerate the boot record states
+typedef enum _UPDATEBOOTSTATE
+{
+  UPDATEBOOT_STATE_CONFIRMED = 0,   ///< image is good
+  UPDATEBOOT_STATE_PENDING,         ///< boot the image on trial, revert if not confirmed
+} UPDATEBOOTSTATE;
+
+// structures -----------------------------------------------------------------
+/// define the package header, the CRCs are CRC32 and the header CRC covers
+/// all fields before it
+typedef struct _UPDATEPACKAGEHEADER
+{
+  U32   uMagic;                   ///< package magic
+  U16   wVersion;                 ///< package version
+  U16   wFlags;                   ///< package flags
+  U32   uPayloadSize;             ///< size of the payload following the header
+  U32   uPayloadCrc;              ///< CRC of the payload
+  U32   uImageSize;               ///< size of the image
+  U32   uImageCrc;                ///< CRC of the image
+  U32   uBaseSize;                ///< size of the base image for a delta
+  U32   uBaseCrc;                 ///< CRC of the base image for a delta
+  U32   uHeaderCrc;               ///< CRC of the header
+} UPDATEPACKAGEHEADER, *PUPDATEPACKAGEHEADER;
+#define UPDATEPACKAGEHEADER_SIZE                    sizeof( UPDATEPACKAGEHEADER )
+
+/// define the progress record, these are appended to the progress sector
+/// as the staging area fills so a transfer can resume after a reset
+typedef struct _UPDATEPROGRESS
+{
+  U32                 uMagic;     ///< record magic
+  UPDATEPACKAGEHEADER tHeader;    ///< package being received
+  U32                 uReceived;  ///< payload bytes safely staged
+  U32                 uCrc;       ///< CRC of the record
+} UPDATEPROGRESS, *PUPDATEPROGRESS;
+#define UPDATEPROGRESS_SIZE                         sizeof( UPDATEPROGRESS )
+
+/// define the boot record, these are appended to one of the two boot record
+/// sectors and the valid one with the newest sequence tells the boot loader
+/// which slot to run
+typedef struct _UPDATEBOOTREC
+{
+  U32   uMagic;                   ///< record magic
+  U8    nSlot;                    ///< slot to run
+  U8    nState;                   ///< boot state
+  U16   wSequence;                ///< sequence number
+  U32   uImageSize;               ///< size of the image
+  U32   uImageCrc;                ///< CRC of the image
+  U32   uCrc;                     ///< CRC of the record
+} UPDATEBOOTREC, *PUPDATEBOOTREC;
+#define UPDATEBOOTREC_SIZE                          sizeof( UPDATEBOOTREC )
+
+/**@} EOF UpdateManager_def.h */
+
+#endif  // _UPDATEMANAGER_DEF_H
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * @file UpdateManager_prm.h
+ *
+ * @brief update manager test parameter declarations
+ *
+ * This file selects the file backend for the host test, the layout is the
+ * same as the default
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _UPDATEMANAGER_PRM_H
+#define _UPDATEMANAGER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the flash sector size, all areas must be sector aligned
+#define UPDATEMANAGER_SECTOR_SIZE                   ( 4096 )
+
+/// define the image slots, the boot loader runs the slot in the boot record
+#define UPDATEMANAGER_SLOT_A_ADDR                   ( 0x00000000 )
+#define UPDATEMANAGER_SLOT_B_ADDR                   ( 0x00040000 )
+#define UPDATEMANAGER_SLOT_SIZE                     ( 0x00040000 )
+
+/// define the staging area for the received package
+#define UPDATEMANAGER_STAGING_ADDR                  ( 0x00080000 )
+#define UPDATEMANAGER_STAGING_SIZE                  ( 0x00040000 )
+
+/// define the sectors for the progress records and the boot records, the
+/// boot records alternate between two sectors so a full sector is only
+/// erased after the next record is safely written to the other
+#define UPDATEMANAGER_PROGRESS_ADDR                 ( 0x000C0000 )
+#define UPDATEMANAGER_BOOTREC_ADDR                  ( 0x000C1000 )
+#define UPDATEMANAGER_BOOTREC_ALT_ADDR              ( 0x000C2000 )
+
+/// define the size of the flash write blocks
+#define UPDATEMANAGER_WRITE_BLOCK_SIZE              ( 256 )
+
+/// define the macro to enable zstd compressed packages
+#define UPDATEMANAGER_ENABLE_COMPRESSION            ( OFF )
+
+/// define the maximum window log accepted by the decoder, this must match
+/// the window log of the packager
+#define UPDATEMANAGER_DECOMP_WINDOWLOG              ( 12 )
+
+/// define the size of the static decoder workspace, this is dominated by
+/// the fixed 128K literal buffer of the decoder context
+#define UPDATEMANAGER_DECOMP_WORKSIZE               ( 170 * 1024 )
+
+/// define the backend selections
+#define UPDATEMANAGER_BACKEND_FLASH                 ( 0 )
+#define UPDATEMANAGER_BACKEND_FILE                  ( 1 )
+
+/// set the macro below to one of the above backends, the file backend
+/// simulates a NOR flash in a file for host testing
+#define UPDATEMANAGER_BACKEND                       ( UPDATEMANAGER_BACKEND_FILE )
+
+/// define the file name/size for the file backend
+#define UPDATEMANAGER_FILE_IMAGE_NAME               ( "UpdateManagerTest.img" )
+#define UPDATEMANAGER_FILE_IMAGE_SIZE               ( 0x000C3000 )
+
+/**@} EOF UpdateManager_prm.h */
+
+#endif  // _UPDATEMANAGER_PRM_H
@@ -0,0 +1,557 @@
+/******************************************************************************
+ * @file UpdateManagerTest.c
+ *
+ * @brief update manager flash simulation test
+ *
+ * This file provides a host tool that runs the update manager over the file
+ * backed NOR flash simulation.  It applies a full package into slot B and
+ * confirms it, then sends a delta package against it, resets part way
+ * through the transfer and checks that it resumes at the last full sector,
+ * applies it into slot A and confirms it.  Each image is read back from the
+ * flash and compared byte for byte.  It checks that a wrong delta base, an
+ * out of order chunk and a corrupted payload are rejected.  It then runs
+ * small updates until the boot records have moved between the two boot
+ * record sectors more than once, and at each move simulates a reset before
+ * the new record was written and a reset before the full sector was erased,
+ * checking that the boot record survives both.  Compressed packages need the
+ * zstd decoder and are not covered.  It exits non zero on any failure.
+ *
+ * build with: cc -O2 -I. -I<include root> -o UpdateManagerTest
+ *             UpdateManagerTest.c ../../Core/Trunk/UpdateManager.c
+ *             ../../Config/Trunk/UpdateManager_cfg.c
+ *             <CRC32 root>/Core/Trunk/CRC32.c
+ * usage:      UpdateManagerTest [seed]
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * Cyber Integration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ *
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "UpdateManager/UpdateManager.h"
+
+// library includes -----------------------------------------------------------
+#include "CRC32/CRC32.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the default seed
+#define DEFAULT_SEED                                ( 1 )
+
+/// define the image sizes
+#define FULL_IMAGE_SIZE                             ( 40000 )
+#define DELTA_IMAGE_SIZE                            ( 41000 )
+#define SMALL_IMAGE_SIZE                            ( 300 )
+
+/// define the delta block size, equal blocks are copied from the base
+#define DELTA_BLOCK_SIZE                            ( 512 )
+
+/// define the largest chunk sent
+#define MAX_CHUNK_SIZE                              ( 700 )
+
+/// define the number of small updates, enough to move the boot records
+/// between the sectors twice
+#define SMALL_UPDATES                               ( 250 )
+
+// local parameter declarations -----------------------------------------------
+static  U32   uRandom;
+static  U32   uErrors;
+static  U8    anFullImage[ FULL_IMAGE_SIZE ];
+static  U8    anDeltaImage[ DELTA_IMAGE_SIZE ];
+static  U8    anPayload[ DELTA_IMAGE_SIZE * 2 ];
+static  U8    anFlash[ DELTA_IMAGE_SIZE ];
+
+// local function prototypes --------------------------------------------------
+static  U32   Random( U32 uRange );
+static  void  Check( BOOL bCondition, PC8 pszWhat );
+static  U32   ComputeCrc( PU8 pnData, U32 uLength );
+static  void  BuildHeader( PUPDATEPACKAGEHEADER ptHeader, U16 wFlags, U32 uPayloadSize, PU8 pnImage, U32 uImageSize, PU8 pnBase, U32 uBaseSize );
+static  U32   BuildDelta( PU8 pnBase, U32 uBaseSize, PU8 pnImage, U32 uImageSize, PU8 pnDelta );
+static  BOOL  SendPayload( U32 uOffset, U32 uEnd );
+static  BOOL  CheckSlot( U8 nSlot, PU8 pnImage, U32 uSize );
+static  void  CheckFull( void );
+static  void  CheckDelta( void );
+static  void  CheckRejects( void );
+static  void  CheckBootRecords( void );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * @param[in]   argc    argument count
+ * @param[in]   argv    arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  // start erased
+  uRandom = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : DEFAULT_SEED;
+  remove( UPDATEMANAGER_FILE_IMAGE_NAME );
+  if ( UpdateManager_Initialize( ))
+  {
+    fprintf( stderr, "unable to create %s\n", UPDATEMANAGER_FILE_IMAGE_NAME );
+    return( 1 );
+  }
+
+  // run the checks
+  CheckFull( );
+  CheckDelta( );
+  CheckRejects( );
+  CheckBootRecords( );
+
+  // report
+  printf( "%s, %u errors\n", ( uErrors == 0 ) ? "PASS" : "FAIL", ( unsigned )uErrors );
+  remove( UPDATEMANAGER_FILE_IMAGE_NAME );
+  return(( uErrors == 0 ) ? 0 : 1 );
+}
+
+/******************************************************************************
+ * @function Random
+ *
+ * @brief random number
+ *
+ * @param[in]   uRange    range
+ *
+ * @return      random number below the range
+ *
+ *****************************************************************************/
+static U32 Random( U32 uRange )
+{
+  // xorshift
+  uRandom ^= uRandom << 13;
+  uRandom ^= uRandom >> 17;
+  uRandom ^= uRandom << 5;
+  return( uRandom % uRange );
+}
+
+/******************************************************************************
+ * @function Check
+ *
+ * @brief check a condition
+ *
+ * @param[in]   bCondition  condition that must be true
+ * @param[in]   pszWhat     description
+ *
+ *****************************************************************************/
+static void Check( BOOL bCondition, PC8 pszWhat )
+{
+  // report the first few failures
+  if ( !bCondition )
+  {
+    if ( uErrors++ < 10 )
+    {
+      fprintf( stderr, "fail: %s\n", pszWhat );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function ComputeCrc
+ *
+ * @brief compute a CRC
+ *
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   uLength     length of the data
+ *
+ * @return      the CRC32 as used by the packages
+ *
+ *****************************************************************************/
+static U32 ComputeCrc( PU8 pnData, U32 uLength )
+{
+  U32 uCrc = CRC32_GetInitialValue( );
+
+  // for each byte
+  while ( uLength-- != 0 )
+  {
+    uCrc = CRC32_CalculateByte( uCrc, *( pnData++ ));
+  }
+
+  // return the CRC
+  return( ~uCrc );
+}
+
+/******************************************************************************
+ * @function BuildHeader
+ *
+ * @brief build a package header
+ *
+ * This function fills in a header for the payload in anPayload
+ *
+ * @param[io]   ptHeader      pointer to the header
+ * @param[in]   wFlags        package flags
+ * @param[in]   uPayloadSize  payload size
+ * @param[in]   pnImage       pointer to the new image
+ * @param[in]   uImageSize    size of the new image
+ * @param[in]   pnBase        pointer to the base image for a delta
+ * @param[in]   uBaseSize     size of the base image, 0 if not a delta
+ *
+ *****************************************************************************/
+static void BuildHeader( PUPDATEPACKAGEHEADER ptHeader, U16 wFlags, U32 uPayloadSize, PU8 pnImage, U32 uImageSize, PU8 pnBase, U32 uBaseSize )
+{
+  // fill it in
+  memset( ptHeader, 0, UPDATEPACKAGEHEADER_SIZE );
+  ptHeader->uMagic = UPDATEPACKAGE_MAGIC;
+  ptHeader->wVersion = UPDATEPACKAGE_VERSION;
+  ptHeader->wFlags = wFlags;
+  ptHeader->uPayloadSize = uPayloadSize;
+  ptHeader->uPayloadCrc = ComputeCrc( anPayload, uPayloadSize );
+  ptHeader->uImageSize = uImageSize;
+  ptHeader->uImageCrc = ComputeCrc( pnImage, uImageSize );
+  ptHeader->uBaseSize = uBaseSize;
+  ptHeader->uBaseCrc = ( uBaseSize != 0 ) ? ComputeCrc( pnBase, uBaseSize ) : 0;
+  ptHeader->uHeaderCrc = ComputeCrc(( PU8 )ptHeader, UPDATEPACKAGEHEADER_SIZE - sizeof( U32 ));
+}
+
+/******************************************************************************
+ * @function BuildDelta
+ *
+ * @brief build a delta payload
+ *
+ * This function copies each block that is unchanged from the base and sends
+ * the others as data, a short tail is always sent as data
+ *
+ * @param[in]   pnBase      pointer to the base image
+ * @param[in]   uBaseSize   size of the base image
+ * @param[in]   pnImage     pointer to the new image
+ * @param[in]   uImageSize  size of the new image
+ * @param[io]   pnDelta     pointer to store the delta
+ *
+ * @return      size of the delta
+ *
+ *****************************************************************************/
+static U32 BuildDelta( PU8 pnBase, U32 uBaseSize, PU8 pnImage, U32 uImageSize, PU8 pnDelta )
+{
+  U32 uOffset, uSize, uLength = 0;
+
+  // for each block
+  for ( uOffset = 0; uOffset < uImageSize; uOffset += uSize )
+  {
+    uSize = MIN( DELTA_BLOCK_SIZE, uImageSize - uOffset );
+    if ((( uOffset + uSize ) <= uBaseSize ) && ( memcmp( &pnBase[ uOffset ], &pnImage[ uOffset ], uSize ) == 0 ))
+    {
+      // copy it from the base
+      pnDelta[ uLength++ ] = UPDATEDELTA_OP_COPY;
+      memcpy( &pnDelta[ uLength ], &uSize, sizeof( U32 ));
+      memcpy( &pnDelta[ uLength + sizeof( U32 ) ], &uOffset, sizeof( U32 ));
+      uLength += UPDATEDELTA_COPY_HDR_SIZE - 1;
+    }
+    else
+    {
+      // send it as data
+      pnDelta[ uLength++ ] = UPDATEDELTA_OP_DATA;
+      memcpy( &pnDelta[ uLength ], &uSize, sizeof( U32 ));
+      uLength += UPDATEDELTA_DATA_HDR_SIZE - 1;
+      memcpy( &pnDelta[ uLength ], &pnImage[ uOffset ], uSize );
+      uLength += uSize;
+    }
+  }
+
+  // return the length
+  return( uLength );
+}
+
+/******************************************************************************
+ * @function SendPayload
+ *
+ * @brief send part of the payload
+ *
+ * This function writes anPayload from an offset to an end in random chunks
+ *
+ * @param[in]   uOffset     starting offset
+ * @param[in]   uEnd        ending offset
+ *
+ * @return      TRUE if errors, FALSE if OK
+ *
+ *****************************************************************************/
+static BOOL SendPayload( U32 uOffset, U32 uEnd )
+{
+  BOOL  bStatus = FALSE;
+  U16   wSize;
+
+  // for each chunk
+  while (( bStatus == FALSE ) && ( uOffset < uEnd ))
+  {
+    wSize = 1 + Random( MAX_CHUNK_SIZE );
+    wSize = ( U16 )MIN( wSize, uEnd - uOffset );
+    bStatus = ( UpdateManager_Write( uOffset, &anPayload[ uOffset ], wSize ) == UPDATEMANAGER_STS_OK ) ? FALSE : TRUE;
+    uOffset += wSize;
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function CheckSlot
+ *
+ * @brief check a slot
+ *
+ * This function reads a slot back from the flash and compares it
+ *
+ * @param[in]   nSlot       slot
+ * @param[in]   pnImage     pointer to the expected image
+ * @param[in]   uSize       size of the image
+ *
+ * @return      TRUE if it matches, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL CheckSlot( U8 nSlot, PU8 pnImage, U32 uSize )
+{
+  BOOL  bStatus = FALSE;
+  U32   uOffset;
+  U16   wSize;
+
+  // read it
+  for ( uOffset = 0; ( bStatus == FALSE ) && ( uOffset < uSize ); uOffset += wSize )
+  {
+    wSize = ( U16 )MIN( UPDATEMANAGER_WRITE_BLOCK_SIZE, uSize - uOffset );
+    bStatus = UpdateManager_LocalRead((( nSlot ) ? UPDATEMANAGER_SLOT_B_ADDR : UPDATEMANAGER_SLOT_A_ADDR ) + uOffset, &anFlash[ uOffset ], wSize );
+  }
+
+  // compare it
+  return(( bStatus == FALSE ) && ( memcmp( anFlash, pnImage, uSize ) == 0 ));
+}
+
+/******************************************************************************
+ * @function CheckFull
+ *
+ * @brief check a full package
+ *
+ * This function sends a full image, applies it into slot B and confirms it
+ *
+ *****************************************************************************/
+static void CheckFull( void )
+{
+  UPDATEPACKAGEHEADER tHeader;
+  U32                 uIndex, uResume;
+
+  // build a random image, the payload is the image
+  for ( uIndex = 0; uIndex < FULL_IMAGE_SIZE; uIndex++ )
+  {
+    anFullImage[ uIndex ] = Random( 256 );
+  }
+  memcpy( anPayload, anFullImage, FULL_IMAGE_SIZE );
+  BuildHeader( &tHeader, 0, FULL_IMAGE_SIZE, anFullImage, FULL_IMAGE_SIZE, NULL, 0 );
+
+  // send it/verify it/apply it
+  Check( UpdateManager_GetActiveSlot( ) == 0, "full starts on slot A" );
+  Check(( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK ) && ( uResume == 0 ), "full begin" );
+  Check( UpdateManager_Apply( ) == UPDATEMANAGER_STS_ILLSTATE, "full apply before verify" );
+  Check( SendPayload( 0, FULL_IMAGE_SIZE ) == FALSE, "full write" );
+  Check( UpdateManager_Verify( ) == UPDATEMANAGER_STS_OK, "full verify" );
+  Check( UpdateManager_Apply( ) == UPDATEMANAGER_STS_OK, "full apply" );
+  Check( UpdateManager_GetActiveSlot( ) == 1, "full runs slot B" );
+  Check( CheckSlot( 1, anFullImage, FULL_IMAGE_SIZE ), "full image read back" );
+
+  // confirm it, once only
+  Check( UpdateManager_Confirm( ) == UPDATEMANAGER_STS_OK, "full confirm" );
+  Check( UpdateManager_Confirm( ) == UPDATEMANAGER_STS_ILLSTATE, "full confirm twice" );
+
+  // the boot record survives a reset
+  UpdateManager_Initialize( );
+  Check( UpdateManager_GetActiveSlot( ) == 1, "full slot B after reset" );
+  Check( UpdateManager_Confirm( ) == UPDATEMANAGER_STS_ILLSTATE, "full confirmed after reset" );
+}
+
+/******************************************************************************
+ * @function CheckDelta
+ *
+ * @brief check a delta package with a resume
+ *
+ * This function sends a delta against the running image, resets part way
+ * through, resumes it, applies it into slot A and confirms it
+ *
+ *****************************************************************************/
+static void CheckDelta( void )
+{
+  UPDATEPACKAGEHEADER tHeader;
+  U32                 uIndex, uSize, uResume, uStop;
+
+  // change a few blocks of the running image and grow it
+  memcpy( anDeltaImage, anFullImage, FULL_IMAGE_SIZE );
+  for ( uIndex = 0; uIndex < 24; uIndex++ )
+  {
+    anDeltaImage[ Random( FULL_IMAGE_SIZE ) ] ^= 0x5A;
+  }
+  for ( uIndex = FULL_IMAGE_SIZE; uIndex < DELTA_IMAGE_SIZE; uIndex++ )
+  {
+    anDeltaImage[ uIndex ] = Random( 256 );
+  }
+  uSize = BuildDelta( anFullImage, FULL_IMAGE_SIZE, anDeltaImage, DELTA_IMAGE_SIZE, anPayload );
+  BuildHeader( &tHeader, UPDATEPACKAGE_FLAG_DELTA, uSize, anDeltaImage, DELTA_IMAGE_SIZE, anFullImage, FULL_IMAGE_SIZE );
+  printf( "delta: %u byte image in a %u byte payload\n", DELTA_IMAGE_SIZE, ( unsigned )uSize );
+
+  // send part of it, stopping inside the third sector
+  uStop = ( 2 * UPDATEMANAGER_SECTOR_SIZE ) + ( UPDATEMANAGER_SECTOR_SIZE / 2 );
+  Check( uSize > uStop, "delta spans the resume point" );
+  Check(( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK ) && ( uResume == 0 ), "delta begin" );
+  Check( SendPayload( 0, uStop ) == FALSE, "delta first write" );
+  Check( UpdateManager_Verify( ) == UPDATEMANAGER_STS_INCOMPLETE, "delta verify incomplete" );
+
+  // reset, it resumes from the last full sector
+  UpdateManager_Initialize( );
+  Check( UpdateManager_Write( 0, anPayload, 1 ) == UPDATEMANAGER_STS_ILLSTATE, "delta write before begin" );
+  Check(( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK ) && ( uResume == ( 2 * UPDATEMANAGER_SECTOR_SIZE )), "delta resume offset" );
+  printf( "delta: reset at %u, resumed at %u\n", ( unsigned )uStop, ( unsigned )uResume );
+
+  // send the rest/verify it/apply it
+  Check( SendPayload( uResume, uSize ) == FALSE, "delta second write" );
+  Check( UpdateManager_Verify( ) == UPDATEMANAGER_STS_OK, "delta verify" );
+  Check( UpdateManager_Apply( ) == UPDATEMANAGER_STS_OK, "delta apply" );
+  Check( UpdateManager_GetActiveSlot( ) == 0, "delta runs slot A" );
+  Check( CheckSlot( 0, anDeltaImage, DELTA_IMAGE_SIZE ), "delta image read back" );
+  Check( CheckSlot( 1, anFullImage, FULL_IMAGE_SIZE ), "delta base untouched" );
+
+  // a reset before the confirm keeps it pending
+  UpdateManager_Initialize( );
+  Check( UpdateManager_GetActiveSlot( ) == 0, "delta slot A after reset" );
+  Check( UpdateManager_Confirm( ) == UPDATEMANAGER_STS_OK, "delta confirm after reset" );
+}
+
+/******************************************************************************
+ * @function CheckRejects
+ *
+ * @brief check rejected packages
+ *
+ * This function checks a wrong delta base, an out of order chunk, a corrupted
+ * payload and a corrupted header
+ *
+ *****************************************************************************/
+static void CheckRejects( void )
+{
+  UPDATEPACKAGEHEADER tHeader;
+  U32                 uSize, uResume;
+
+  // a delta against the image that is no longer running
+  uSize = BuildDelta( anFullImage, FULL_IMAGE_SIZE, anDeltaImage, DELTA_IMAGE_SIZE, anPayload );
+  BuildHeader( &tHeader, UPDATEPACKAGE_FLAG_DELTA, uSize, anDeltaImage, DELTA_IMAGE_SIZE, anFullImage, FULL_IMAGE_SIZE );
+  Check( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_BASEMISMATCH, "reject wrong base" );
+
+  // a corrupted header
+  memcpy( anPayload, anFullImage, FULL_IMAGE_SIZE );
+  BuildHeader( &tHeader, 0, FULL_IMAGE_SIZE, anFullImage, FULL_IMAGE_SIZE, NULL, 0 );
+  tHeader.uImageSize--;
+  Check( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_ILLHEADER, "reject header" );
+
+  // an out of order chunk
+  tHeader.uImageSize++;
+  Check(( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK ) && ( uResume == 0 ), "reject begin" );
+  Check( UpdateManager_Write( 1, anPayload, 1 ) == UPDATEMANAGER_STS_SEQUENCE, "reject sequence" );
+
+  // a payload corrupted in transit starts over
+  anPayload[ FULL_IMAGE_SIZE / 2 ] ^= 0x01;
+  Check( SendPayload( 0, FULL_IMAGE_SIZE ) == FALSE, "reject write" );
+  Check( UpdateManager_Verify( ) == UPDATEMANAGER_STS_CRCERROR, "reject payload CRC" );
+  Check( UpdateManager_Apply( ) == UPDATEMANAGER_STS_ILLSTATE, "reject apply" );
+  Check(( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK ) && ( uResume == 0 ), "reject starts over" );
+  UpdateManager_Abort( );
+  Check( UpdateManager_GetActiveSlot( ) == 0, "reject keeps slot A" );
+}
+
+/******************************************************************************
+ * @function CheckBootRecords
+ *
+ * @brief check the boot record sectors
+ *
+ * This function runs small updates, snapshotting the boot record sectors
+ * around each record written.  When the records move to the other sector
+ * it rebuilds the flash as a reset would have left it before the new record
+ * was written and before the full sector was erased, and checks the boot
+ * record recovered from each
+ *
+ *****************************************************************************/
+static void CheckBootRecords( void )
+{
+  static  U8          anBefore[ 2 ][ UPDATEMANAGER_SECTOR_SIZE ];
+  static  U8          anAfter[ 2 ][ UPDATEMANAGER_SECTOR_SIZE ];
+  static  U8          anSector[ UPDATEMANAGER_SECTOR_SIZE ];
+  static  const U32   auSectors[ 2 ] = { UPDATEMANAGER_BOOTREC_ADDR, UPDATEMANAGER_BOOTREC_ALT_ADDR };
+  UPDATEPACKAGEHEADER tHeader;
+  U32                 uUpdate, uIndex, uResume, uMoves = 0;
+  U8                  nOld, nNew, nSlotBefore, nSlotAfter, nStep;
+  BOOL                bBlankBefore[ 2 ], bBlankAfter[ 2 ];
+
+  // for each update
+  for ( uUpdate = 0; uUpdate < SMALL_UPDATES; uUpdate++ )
+  {
+    // build/send a small image
+    for ( uIndex = 0; uIndex < SMALL_IMAGE_SIZE; uIndex++ )
+    {
+      anPayload[ uIndex ] = Random( 256 );
+    }
+    BuildHeader( &tHeader, 0, SMALL_IMAGE_SIZE, anPayload, SMALL_IMAGE_SIZE, NULL, 0 );
+    Check( UpdateManager_Begin( &tHeader, &uResume ) == UPDATEMANAGER_STS_OK, "small begin" );
+    Check( SendPayload( 0, SMALL_IMAGE_SIZE ) == FALSE, "small write" );
+    Check( UpdateManager_Verify( ) == UPDATEMANAGER_STS_OK, "small verify" );
+
+    // apply it, then confirm it, each writes a boot record
+    for ( nStep = 0; nStep < 2; nStep++ )
+    {
+      // snapshot the sectors, write the record, snapshot them again
+      nSlotBefore = UpdateManager_GetActiveSlot( );
+      for ( uIndex = 0; uIndex < 2; uIndex++ )
+      {
+        UpdateManager_LocalRead( auSectors[ uIndex ], anBefore[ uIndex ], UPDATEMANAGER_SECTOR_SIZE );
+      }
+      Check((( nStep == 0 ) ? UpdateManager_Apply( ) : UpdateManager_Confirm( )) == UPDATEMANAGER_STS_OK, "small apply/confirm" );
+      nSlotAfter = UpdateManager_GetActiveSlot( );
+      for ( uIndex = 0; uIndex < 2; uIndex++ )
+      {
+        UpdateManager_LocalRead( auSectors[ uIndex ], anAfter[ uIndex ], UPDATEMANAGER_SECTOR_SIZE );
+        bBlankBefore[ uIndex ] = ( *(( PU32 )anBefore[ uIndex ] ) == 0xFFFFFFFF );
+        bBlankAfter[ uIndex ] = ( *(( PU32 )anAfter[ uIndex ] ) == 0xFFFFFFFF );
+      }
+      Check( bBlankAfter[ 0 ] != bBlankAfter[ 1 ], "one boot record sector in use" );
+
+      // check for a move
+      if (( bBlankBefore[ 0 ] != bBlankAfter[ 0 ] ) && ( !bBlankBefore[ 0 ] || !bBlankBefore[ 1 ] ))
+      {
+        nOld = ( bBlankBefore[ 0 ] ) ? 1 : 0;
+        nNew = nOld ^ 1;
+        uMoves++;
+
+        // reset after the other sector was erased, before the record was written
+        UpdateManager_LocalWrite( auSectors[ nOld ], anBefore[ nOld ], UPDATEMANAGER_SECTOR_SIZE );
+        UpdateManager_LocalErase( auSectors[ nNew ] );
+        UpdateManager_Initialize( );
+        Check( UpdateManager_GetActiveSlot( ) == nSlotBefore, "reset before the new record" );
+
+        // reset after the record was written, before the full sector was erased
+        UpdateManager_LocalWrite( auSectors[ nNew ], anAfter[ nNew ], UPDATEMANAGER_SECTOR_SIZE );
+        UpdateManager_Initialize( );
+        Check( UpdateManager_GetActiveSlot( ) == nSlotAfter, "reset before the erase" );
+        UpdateManager_LocalRead( auSectors[ nOld ], anSector, UPDATEMANAGER_SECTOR_SIZE );
+        Check( *(( PU32 )anSector ) == 0xFFFFFFFF, "stale sector erased" );
+        UpdateManager_LocalRead( auSectors[ nNew ], anSector, UPDATEMANAGER_SECTOR_SIZE );
+        Check( memcmp( anSector, anAfter[ nNew ], UPDATEMANAGER_SECTOR_SIZE ) == 0, "new sector kept" );
+      }
+    }
+
+    // the image is running
+    Check( CheckSlot( UpdateManager_GetActiveSlot( ), anPayload, SMALL_IMAGE_SIZE ), "small image read back" );
+  }
+
+  // report
+  printf( "boot records: %u updates, %u sector moves\n", SMALL_UPDATES, ( unsigned )uMoves );
+  Check( uMoves >= 2, "boot records moved both ways" );
+}
+
+/**@} EOF UpdateManagerTest.c */
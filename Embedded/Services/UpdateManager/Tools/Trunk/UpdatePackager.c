@@ -0,0 +1,585 @@
+/******************************************************************************
+ * @file UpdatePackager.c
+ *
+ * @brief update packager
+ *
+ * This file provides a host tool that builds an update manager package from
+ * a new image.  With -b the payload is a delta against the given base image,
+ * a list of copy operations from the base and literal data, the base must be
+ * the image running on the target.  With -z the payload is compressed into a
+ * single zstd frame.  The layout must match UpdateManager_def.h.
+ *
+ * build with: cc -O2 -I<zstd lib> -o UpdatePackager UpdatePackager.c -lzstd
+ *             where the zstd library is ThirdPartyLibraries/Ztp/zstd-dev/lib
+ * usage:      UpdatePackager [-z] [-b <base image>] <new image> <package>
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup UpdateManager
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "zstd.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the package magic/version/flags, these must match UpdateManager_def.h
+#define UPDATEPACKAGE_MAGIC                         ( 0x50555746 )
+#define UPDATEPACKAGE_VERSION                       ( 1 )
+#define UPDATEPACKAGE_FLAG_COMPRESSED               ( 0x0001 )
+#define UPDATEPACKAGE_FLAG_DELTA                    ( 0x0002 )
+#define UPDATEPACKAGEHEADER_SIZE                    ( 36 )
+
+/// define the delta operations, these must match UpdateManager_def.h
+#define UPDATEDELTA_OP_COPY                         ( 0x01 )
+#define UPDATEDELTA_OP_DATA                         ( 0x02 )
+
+/// define the compression level and window log, the window log must not
+/// exceed UPDATEMANAGER_DECOMP_WINDOWLOG
+#define COMPRESSION_LEVEL                           ( 19 )
+#define COMPRESSION_WINDOWLOG                       ( 12 )
+
+/// define the match parameters, matches are found by hashing this many bytes
+/// and are only used if at least the minimum length
+#define MATCH_HASH_LENGTH                           ( 8 )
+#define MATCH_MIN_LENGTH                            ( 16 )
+#define MATCH_HASH_BITS                             ( 18 )
+
+/// define the min/max macros
+#define MIN( a, b )                                 ((( a ) < ( b )) ? ( a ) : ( b ))
+#define MAX( a, b )                                 ((( a ) > ( b )) ? ( a ) : ( b ))
+
+// structures -----------------------------------------------------------------
+/// define the buffer structure
+typedef struct _BUFFER
+{
+  uint8_t*  pnData;                 ///< data
+  size_t    tLength;                ///< length of the data
+  size_t    tSize;                  ///< allocated size
+} BUFFER;
+
+// local parameter declarations -----------------------------------------------
+static  uint32_t  auCrcTable[ 256 ];
+
+// local function prototypes --------------------------------------------------
+static  int       LoadFile( const char* pszName, BUFFER* ptBuffer );
+static  void      BuildDelta( BUFFER* ptBase, BUFFER* ptImage, BUFFER* ptDelta );
+static  int       CheckDelta( BUFFER* ptBase, BUFFER* ptImage, BUFFER* ptDelta );
+static  size_t    MatchLength( const uint8_t* pnA, const uint8_t* pnB, size_t tMax );
+static  uint32_t  ComputeHash( const uint8_t* pnData );
+static  void      PutOp( BUFFER* ptDelta, uint8_t nOp, uint32_t uLength, uint32_t uOffset, const uint8_t* pnData );
+static  void      Append( BUFFER* ptBuffer, const void* pvData, size_t tLength );
+static  void      PutU16( uint8_t* pnData, uint16_t wValue );
+static  void      PutU32( uint8_t* pnData, uint32_t uValue );
+static  uint32_t  GetU32( const uint8_t* pnData );
+static  uint32_t  ComputeCrc( const uint8_t* pnData, size_t tLength );
+
+/******************************************************************************
+ * @function main
+ *
+ * @brief main entry
+ *
+ * This function will build the package
+ *
+ * @param[in]   argc      argument count
+ * @param[in]   argv      arguments
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+int main( int argc, char* argv[ ] )
+{
+  BUFFER      tBase = { 0 }, tImage = { 0 }, tPayload = { 0 };
+  uint8_t     anHeader[ UPDATEPACKAGEHEADER_SIZE ];
+  uint8_t*    pnFrame;
+  ZSTD_CCtx*  ptCCtx;
+  FILE*       ptPackage;
+  const char* pszBase = NULL;
+  size_t      tLength;
+  uint16_t    wFlags = 0;
+  int         bCompress = 0;
+  int         iArg;
+
+  // parse the options
+  for ( iArg = 1; ( iArg < argc ) && ( argv[ iArg ][ 0 ] == '-' ); iArg++ )
+  {
+    if ( strcmp( argv[ iArg ], "-z" ) == 0 )
+    {
+      bCompress = 1;
+    }
+    else if (( strcmp( argv[ iArg ], "-b" ) == 0 ) && ( iArg + 1 < argc ))
+    {
+      pszBase = argv[ ++iArg ];
+    }
+    else
+    {
+      break;
+    }
+  }
+  if (( argc - iArg ) != 2 )
+  {
+    fprintf( stderr, "usage: %s [-z] [-b <base image>] <new image> <package>\n", argv[ 0 ] );
+    return( 1 );
+  }
+
+  // load the images
+  if (( LoadFile( argv[ iArg ], &tImage ) != 0 ) || (( pszBase != NULL ) && ( LoadFile( pszBase, &tBase ) != 0 )))
+  {
+    return( 1 );
+  }
+
+  // build the payload
+  if ( pszBase != NULL )
+  {
+    // build the delta/check it
+    BuildDelta( &tBase, &tImage, &tPayload );
+    if ( CheckDelta( &tBase, &tImage, &tPayload ) != 0 )
+    {
+      fprintf( stderr, "delta check failed\n" );
+      return( 1 );
+    }
+    wFlags |= UPDATEPACKAGE_FLAG_DELTA;
+  }
+  else
+  {
+    Append( &tPayload, tImage.pnData, tImage.tLength );
+  }
+
+  // compress it if requested
+  if ( bCompress )
+  {
+    ptCCtx = ZSTD_createCCtx( );
+    ZSTD_CCtx_setParameter( ptCCtx, ZSTD_c_compressionLevel, COMPRESSION_LEVEL );
+    ZSTD_CCtx_setParameter( ptCCtx, ZSTD_c_windowLog, COMPRESSION_WINDOWLOG );
+    pnFrame = malloc( ZSTD_compressBound( tPayload.tLength ));
+    tLength = ZSTD_compress2( ptCCtx, pnFrame, ZSTD_compressBound( tPayload.tLength ), tPayload.pnData, tPayload.tLength );
+    ZSTD_freeCCtx( ptCCtx );
+    if ( ZSTD_isError( tLength ))
+    {
+      fprintf( stderr, "compress: %s\n", ZSTD_getErrorName( tLength ));
+      return( 1 );
+    }
+
+    // replace the payload
+    free( tPayload.pnData );
+    tPayload.pnData = pnFrame;
+    tPayload.tLength = tLength;
+    wFlags |= UPDATEPACKAGE_FLAG_COMPRESSED;
+  }
+
+  // build the header
+  PutU32( &anHeader[ 0 ], UPDATEPACKAGE_MAGIC );
+  PutU16( &anHeader[ 4 ], UPDATEPACKAGE_VERSION );
+  PutU16( &anHeader[ 6 ], wFlags );
+  PutU32( &anHeader[ 8 ], ( uint32_t )tPayload.tLength );
+  PutU32( &anHeader[ 12 ], ComputeCrc( tPayload.pnData, tPayload.tLength ));
+  PutU32( &anHeader[ 16 ], ( uint32_t )tImage.tLength );
+  PutU32( &anHeader[ 20 ], ComputeCrc( tImage.pnData, tImage.tLength ));
+  PutU32( &anHeader[ 24 ], ( uint32_t )tBase.tLength );
+  PutU32( &anHeader[ 28 ], ( pszBase != NULL ) ? ComputeCrc( tBase.pnData, tBase.tLength ) : 0 );
+  PutU32( &anHeader[ 32 ], ComputeCrc( anHeader, UPDATEPACKAGEHEADER_SIZE - 4 ));
+
+  // write the package
+  if (( ptPackage = fopen( argv[ iArg + 1 ], "wb" )) == NULL )
+  {
+    perror( argv[ iArg + 1 ] );
+    return( 1 );
+  }
+  fwrite( anHeader, 1, UPDATEPACKAGEHEADER_SIZE, ptPackage );
+  fwrite( tPayload.pnData, 1, tPayload.tLength, ptPackage );
+  fclose( ptPackage );
+
+  // done
+  printf( "image %u bytes, payload %u bytes%s%s\n", ( unsigned )tImage.tLength, ( unsigned )tPayload.tLength,
+          ( wFlags & UPDATEPACKAGE_FLAG_DELTA ) ? ", delta" : "", ( wFlags & UPDATEPACKAGE_FLAG_COMPRESSED ) ? ", compressed" : "" );
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function LoadFile
+ *
+ * @brief load a file
+ *
+ * This function will read a file into a buffer
+ *
+ * @param[in]   pszName       file name
+ * @param[in]   ptBuffer      buffer
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+static int LoadFile( const char* pszName, BUFFER* ptBuffer )
+{
+  FILE*   ptInput;
+  uint8_t anChunk[ 4096 ];
+  size_t  tLength;
+
+  // open the file
+  if (( ptInput = fopen( pszName, "rb" )) == NULL )
+  {
+    perror( pszName );
+    return( 1 );
+  }
+
+  // read it
+  while (( tLength = fread( anChunk, 1, sizeof( anChunk ), ptInput )) != 0 )
+  {
+    Append( ptBuffer, anChunk, tLength );
+  }
+  fclose( ptInput );
+
+  // return OK
+  return( 0 );
+}
+
+/******************************************************************************
+ * @function BuildDelta
+ *
+ * @brief build a delta
+ *
+ * This function will build the delta operations that turn the base into the
+ * image.  At each position the match continuing the previous copy and the
+ * last base position with the same hash are tried, the longest match is
+ * copied if long enough, otherwise the byte becomes literal data
+ *
+ * @param[in]   ptBase        base image
+ * @param[in]   ptImage       new image
+ * @param[in]   ptDelta       delta to build
+ *
+ *****************************************************************************/
+static void BuildDelta( BUFFER* ptBase, BUFFER* ptImage, BUFFER* ptDelta )
+{
+  int64_t*  phTable;
+  int64_t   hCandidate, hLastDiff = 0;
+  size_t    tPos, tLiteral, tIndex, tLength, tBestLength, tBestOffset;
+
+  // index the base
+  phTable = malloc(( 1 << MATCH_HASH_BITS ) * sizeof( int64_t ));
+  memset( phTable, 0xFF, ( 1 << MATCH_HASH_BITS ) * sizeof( int64_t ));
+  for ( tIndex = 0; ( tIndex + MATCH_HASH_LENGTH ) <= ptBase->tLength; tIndex++ )
+  {
+    phTable[ ComputeHash( &ptBase->pnData[ tIndex ] ) ] = ( int64_t )tIndex;
+  }
+
+  // for each position
+  tPos = tLiteral = 0;
+  while (( tPos + MATCH_HASH_LENGTH ) <= ptImage->tLength )
+  {
+    // try continuing the last copy
+    tBestLength = tBestOffset = 0;
+    hCandidate = ( int64_t )tPos + hLastDiff;
+    if (( hCandidate >= 0 ) && ( hCandidate < ( int64_t )ptBase->tLength ))
+    {
+      tBestOffset = ( size_t )hCandidate;
+      tBestLength = MatchLength( &ptBase->pnData[ tBestOffset ], &ptImage->pnData[ tPos ],
+                                 MIN( ptBase->tLength - tBestOffset, ptImage->tLength - tPos ));
+    }
+
+    // try the hash
+    if (( hCandidate = phTable[ ComputeHash( &ptImage->pnData[ tPos ] ) ] ) >= 0 )
+    {
+      tLength = MatchLength( &ptBase->pnData[ hCandidate ], &ptImage->pnData[ tPos ],
+                             MIN( ptBase->tLength - ( size_t )hCandidate, ptImage->tLength - tPos ));
+      if ( tLength > tBestLength )
+      {
+        tBestLength = tLength;
+        tBestOffset = ( size_t )hCandidate;
+      }
+    }
+
+    // check for a match
+    if ( tBestLength >= MATCH_MIN_LENGTH )
+    {
+      // flush the literals/copy
+      if ( tPos > tLiteral )
+      {
+        PutOp( ptDelta, UPDATEDELTA_OP_DATA, ( uint32_t )( tPos - tLiteral ), 0, &ptImage->pnData[ tLiteral ] );
+      }
+      PutOp( ptDelta, UPDATEDELTA_OP_COPY, ( uint32_t )tBestLength, ( uint32_t )tBestOffset, NULL );
+      hLastDiff = ( int64_t )tBestOffset - ( int64_t )tPos;
+      tPos += tBestLength;
+      tLiteral = tPos;
+    }
+    else
+    {
+      tPos++;
+    }
+  }
+
+  // flush the remaining literals
+  if ( ptImage->tLength > tLiteral )
+  {
+    PutOp( ptDelta, UPDATEDELTA_OP_DATA, ( uint32_t )( ptImage->tLength - tLiteral ), 0, &ptImage->pnData[ tLiteral ] );
+  }
+  free( phTable );
+}
+
+/******************************************************************************
+ * @function CheckDelta
+ *
+ * @brief check a delta
+ *
+ * This function will apply a delta to the base and compare it to the image
+ *
+ * @param[in]   ptBase        base image
+ * @param[in]   ptImage       new image
+ * @param[in]   ptDelta       delta
+ *
+ * @return      0 if OK, 1 on error
+ *
+ *****************************************************************************/
+static int CheckDelta( BUFFER* ptBase, BUFFER* ptImage, BUFFER* ptDelta )
+{
+  BUFFER    tResult = { 0 };
+  size_t    tIndex = 0;
+  uint32_t  uLength, uOffset;
+  int       iStatus = 0;
+
+  // for each operation
+  while (( iStatus == 0 ) && (( tIndex + 5 ) <= ptDelta->tLength ))
+  {
+    uLength = GetU32( &ptDelta->pnData[ tIndex + 1 ] );
+    if ( ptDelta->pnData[ tIndex ] == UPDATEDELTA_OP_COPY )
+    {
+      uOffset = GetU32( &ptDelta->pnData[ tIndex + 5 ] );
+      Append( &tResult, &ptBase->pnData[ uOffset ], uLength );
+      tIndex += 9;
+    }
+    else
+    {
+      Append( &tResult, &ptDelta->pnData[ tIndex + 5 ], uLength );
+      tIndex += 5 + uLength;
+    }
+  }
+
+  // compare it
+  if (( tIndex != ptDelta->tLength ) || ( tResult.tLength != ptImage->tLength ) || ( memcmp( tResult.pnData, ptImage->pnData, ptImage->tLength ) != 0 ))
+  {
+    iStatus = 1;
+  }
+  free( tResult.pnData );
+
+  // return the status
+  return( iStatus );
+}
+
+/******************************************************************************
+ * @function MatchLength
+ *
+ * @brief get a match length
+ *
+ * This function will return the number of equal leading bytes
+ *
+ * @param[in]   pnA           first data
+ * @param[in]   pnB           second data
+ * @param[in]   tMax          maximum length
+ *
+ * @return      the match length
+ *
+ *****************************************************************************/
+static size_t MatchLength( const uint8_t* pnA, const uint8_t* pnB, size_t tMax )
+{
+  size_t  tLength = 0;
+
+  // count the matching bytes
+  while (( tLength < tMax ) && ( pnA[ tLength ] == pnB[ tLength ] ))
+  {
+    tLength++;
+  }
+
+  // return the length
+  return( tLength );
+}
+
+/******************************************************************************
+ * @function ComputeHash
+ *
+ * @brief compute a match hash
+ *
+ * This function will hash the bytes at a position
+ *
+ * @param[in]   pnData        pointer to the data
+ *
+ * @return      the hash
+ *
+ *****************************************************************************/
+static uint32_t ComputeHash( const uint8_t* pnData )
+{
+  uint64_t  hValue;
+
+  // hash the bytes
+  memcpy( &hValue, pnData, MATCH_HASH_LENGTH );
+  return(( uint32_t )(( hValue * 0x9E3779B97F4A7C15ULL ) >> ( 64 - MATCH_HASH_BITS )));
+}
+
+/******************************************************************************
+ * @function PutOp
+ *
+ * @brief put a delta operation
+ *
+ * This function will append an operation to the delta
+ *
+ * @param[in]   ptDelta       delta
+ * @param[in]   nOp           operation
+ * @param[in]   uLength       length
+ * @param[in]   uOffset       base offset for a copy
+ * @param[in]   pnData        data for a data operation
+ *
+ *****************************************************************************/
+static void PutOp( BUFFER* ptDelta, uint8_t nOp, uint32_t uLength, uint32_t uOffset, const uint8_t* pnData )
+{
+  uint8_t anOp[ 9 ];
+
+  // build the header
+  anOp[ 0 ] = nOp;
+  PutU32( &anOp[ 1 ], uLength );
+  if ( nOp == UPDATEDELTA_OP_COPY )
+  {
+    PutU32( &anOp[ 5 ], uOffset );
+    Append( ptDelta, anOp, 9 );
+  }
+  else
+  {
+    Append( ptDelta, anOp, 5 );
+    Append( ptDelta, pnData, uLength );
+  }
+}
+
+/******************************************************************************
+ * @function Append
+ *
+ * @brief append to a buffer
+ *
+ * This function will append data to a buffer, growing it as needed
+ *
+ * @param[in]   ptBuffer      buffer
+ * @param[in]   pvData        pointer to the data
+ * @param[in]   tLength       length of the data
+ *
+ *****************************************************************************/
+static void Append( BUFFER* ptBuffer, const void* pvData, size_t tLength )
+{
+  // grow the buffer
+  if (( ptBuffer->tLength + tLength ) > ptBuffer->tSize )
+  {
+    ptBuffer->tSize = MAX( ptBuffer->tSize * 2, ptBuffer->tLength + tLength );
+    ptBuffer->pnData = realloc( ptBuffer->pnData, ptBuffer->tSize );
+  }
+
+  // copy the data
+  memcpy( &ptBuffer->pnData[ ptBuffer->tLength ], pvData, tLength );
+  ptBuffer->tLength += tLength;
+}
+
+/******************************************************************************
+ * @function PutU16
+ *
+ * @brief put a little endian value
+ *
+ * This function will store a 16 bit value little endian
+ *
+ * @param[in]   pnData        pointer to the data
+ * @param[in]   wValue        value
+ *
+ *****************************************************************************/
+static void PutU16( uint8_t* pnData, uint16_t wValue )
+{
+  // store it
+  pnData[ 0 ] = ( uint8_t )wValue;
+  pnData[ 1 ] = ( uint8_t )( wValue >> 8 );
+}
+
+/******************************************************************************
+ * @function PutU32
+ *
+ * @brief put a little endian value
+ *
+ * This function will store a 32 bit value little endian
+ *
+ * @param[in]   pnData        pointer to the data
+ * @param[in]   uValue        value
+ *
+ *****************************************************************************/
+static void PutU32( uint8_t* pnData, uint32_t uValue )
+{
+  // store it
+  PutU16( pnData, ( uint16_t )uValue );
+  PutU16( pnData + 2, ( uint16_t )( uValue >> 16 ));
+}
+
+/******************************************************************************
+ * @function GetU32
+ *
+ * @brief get a little endian value
+ *
+ * This function will return a 32 bit little endian value
+ *
+ * @param[in]   pnData        pointer to the data
+ *
+ * @return      the value
+ *
+ *****************************************************************************/
+static uint32_t GetU32( const uint8_t* pnData )
+{
+  // return the value
+  return(( uint32_t )pnData[ 0 ] | (( uint32_t )pnData[ 1 ] << 8 ) | (( uint32_t )pnData[ 2 ] << 16 ) | (( uint32_t )pnData[ 3 ] << 24 ));
+}
+
+/******************************************************************************
+ * @function ComputeCrc
+ *
+ * @brief compute a CRC
+ *
+ * This function will compute the CRC32 of a block, this matches CRC32 in
+ * the utilities
+ *
+ * @param[in]   pnData        pointer to the data
+ * @param[in]   tLength       length of the data
+ *
+ * @return      the CRC
+ *
+ *****************************************************************************/
+static uint32_t ComputeCrc( const uint8_t* pnData, size_t tLength )
+{
+  uint32_t  uCrc, uIndex, uBit;
+
+  // build the table on first use
+  if ( auCrcTable[ 1 ] == 0 )
+  {
+    for ( uIndex = 0; uIndex < 256; uIndex++ )
+    {
+      uCrc = uIndex;
+      for ( uBit = 0; uBit < 8; uBit++ )
+      {
+        uCrc = ( uCrc & 1 ) ? ( 0xEDB88320 ^ ( uCrc >> 1 )) : ( uCrc >> 1 );
+      }
+      auCrcTable[ uIndex ] = uCrc;
+    }
+  }
+
+  // compute the CRC
+  uCrc = 0xFFFFFFFF;
+  while ( tLength-- != 0 )
+  {
+    uCrc = auCrcTable[( uCrc ^ *pnData++ ) & 0xFF ] ^ ( uCrc >> 8 );
+  }
+
+  // return the CRC
+  return( ~uCrc );
+}
+
+/**@} EOF UpdatePackager.c */
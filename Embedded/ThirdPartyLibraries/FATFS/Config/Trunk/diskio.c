@@ -21,7 +21,7 @@ DSTATUS disk_initialize (
 	DSTATUS stat;
 
   // call the handler
-  stat = MmcSdHandler_Initialize( pdrv );
+  stat = MmcSdHandler_InitializeDrive( pdrv );
   return( stat );
 }
 
@@ -58,7 +58,7 @@ DRESULT disk_read (
 	DRESULT res;
   
   // call the handler
-  res = MmcSdHandler_Read( pdrv, buff, sector, count );
+  res = ( DRESULT )MmcSdHandler_Read( pdrv, buff, sector, count );
   
 	return ( res );
 }
@@ -80,7 +80,7 @@ DRESULT disk_write (
 	DRESULT res;
   
   // call the handler
-  res = MmcSdHandler_Write( pdrv, buff, sector, count );
+  res = ( DRESULT )MmcSdHandler_Write( pdrv, buff, sector, count );
 
 	return ( res );
 }
@@ -101,7 +101,7 @@ DRESULT disk_ioctl (
 	DRESULT res;
   
   // call the handler
-  res = MmcSdHandler_Ioctl( pdrv, cmd, buff );
+  res = ( DRESULT )MmcSdHandler_Ioctl( pdrv, cmd, buff );
   
 	return ( res );
 }
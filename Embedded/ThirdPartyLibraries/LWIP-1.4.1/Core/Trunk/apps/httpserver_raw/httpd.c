@@ -41,6 +41,8 @@
  *
  * To enable SSI support, define label INCLUDE_HTTPD_SSI in lwipopts.h.
  * To enable CGI support, define label INCLUDE_HTTPD_CGI in lwipopts.h.
+ * To have the request headers of each GET passed to a handler before the
+ * file is opened, define label INCLUDE_HTTPD_REQUEST_HEADERS in lwipopts.h.
  *
  * By default, the server assumes that HTTP headers are already present in
  * each file stored in the file system.  By defining DYNAMIC_HTTP_HEADERS in
@@ -198,6 +200,11 @@ const tCGI *g_pCGIs = NULL;
 int g_iNumCGIs = 0;
 #endif /* INCLUDE_HTTPD_CGI */
 
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+/* Request header handler information */
+tRequestHeaderHandler g_pfnRequestHeaderHandler = NULL;
+#endif /* INCLUDE_HTTPD_REQUEST_HEADERS */
+
 #ifdef DYNAMIC_HTTP_HEADERS
 //*****************************************************************************
 //
@@ -1236,6 +1243,16 @@ http_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
           return(ERR_OK);
         }
 
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+        /*
+         * Let the handler see the rest of the request, starting at the
+         * protocol version, before any file is opened.
+         */
+        if(g_pfnRequestHeaderHandler) {
+          g_pfnRequestHeaderHandler(&data[i + 1], p->len - (i + 1));
+        }
+#endif
+
 #ifdef INCLUDE_HTTPD_SSI
         /*
          * By default, assume we will not be processing server-side-includes
@@ -1462,4 +1479,13 @@ http_set_cgi_handlers(const tCGI *pCGIs, int iNumHandlers)
 }
 #endif
 
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+/*-----------------------------------------------------------------------------------*/
+void
+http_set_request_header_handler(tRequestHeaderHandler pfnHandler)
+{
+    g_pfnRequestHeaderHandler = pfnHandler;
+}
+#endif
+
 /*-----------------------------------------------------------------------------------*/
@@ -94,6 +94,24 @@ void http_set_cgi_handlers(const tCGI *pCGIs, int iNumHandlers);
 
 #endif
 
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+
+/*
+ * Function pointer for the request header handler callback.
+ *
+ * This function will be called for each GET request before the requested
+ * file is opened.  pcHeaders points to the request following the URI,
+ * starting with the protocol version, and iLen is the number of bytes
+ * available in the first packet of the request.  The data is not NULL
+ * terminated.  This allows fs_open to act on headers such as
+ * Accept-Encoding.
+ */
+typedef void (*tRequestHeaderHandler)(const char *pcHeaders, int iLen);
+
+void http_set_request_header_handler(tRequestHeaderHandler pfnHandler);
+
+#endif
+
 #ifdef INCLUDE_HTTPD_SSI
 
 /*
@@ -26,6 +26,7 @@
 #define _LWIPHTTPHANDLER_CFG_H
 
 // local includes -------------------------------------------------------------
+#include "LwipHttpHandler/LwipHttpHandler_prm.h"
 #include "LwipHttpHandler/LwipHttpHandler_def.h"
 
 // enumerations ---------------------------------------------------------------
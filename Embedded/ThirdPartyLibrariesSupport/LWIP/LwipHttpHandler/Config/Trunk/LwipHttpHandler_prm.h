@@ -0,0 +1,39 @@
+/******************************************************************************
+ * @file LwipHttpHandler_prm.h
+ *
+ * @brief LWIP HTTP handler parameter declarations
+ *
+ * This file declares any customization for the HTTP handler
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Endurance Products 
+ * LLC. It is the exclusive property of Endurance Products, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Endurance Products, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Endurance Products, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup LwipHttpHandler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _LWIPHTTPHANDLER_PRM_H
+#define _LWIPHTTPHANDLER_PRM_H
+
+// system includes ------------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to serve files not found in the HTML files from the
+/// flash file manager, compressed files are sent as is to clients that accept
+/// zstd when INCLUDE_HTTPD_REQUEST_HEADERS is defined in lwipopts.h
+#define LWIPHTTPHANDLER_ENABLE_FLASHFILES           ( OFF )
+
+/**@} EOF LwipHttpHandler_prm.h */
+
+#endif  // _LWIPHTTPHANDLER_PRM_H
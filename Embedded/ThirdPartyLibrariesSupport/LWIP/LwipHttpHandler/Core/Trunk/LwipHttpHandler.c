@@ -26,6 +26,7 @@
 #include "stdio.h"
 #include "stdlib.h"
 #include "ctype.h"
+#include "strings.h"
 
 // library includes -----------------------------------------------------------
 
@@ -36,6 +37,9 @@
 #include "apps/httpserver_raw/fsdata.h"
 #include "HtmlFiles/HtmlFiles.h"
 #include "HTMLPageDefs/HTMLPageDefs.h"
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+  #include "FlashFileManager/FlashFileManager.h"
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 
 // Macros and Defines ---------------------------------------------------------
 /// define the maximum size of the dynamic page buffer
@@ -46,6 +50,14 @@
 #define LWIP_MAX_OPEN_FILES     10
 #endif
 
+/// define the size of the header for a flash file
+#define FLASH_HDR_BUFFER_SIZE   192
+
+// flash files carry their own headers
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON ) && defined( DYNAMIC_HTTP_HEADERS )
+  #error "flash files can not be served with DYNAMIC_HTTP_HEADERS"
+#endif
+
 // define the page colors
 #define SET_PAG_BGR     RGB( 0xFF, 0xFF, 0xFF )
 #define SET_PAG_TXT     RGB( 0x00, 0x00, 0x00 )
@@ -68,13 +80,29 @@ typedef struct _FSTABLE
 {
   struct fs_file  ptFile;
   BOOL            bInUse;
+  #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+  FLASHFILEHANDLE tFlashFile;
+  C8              acFlashHdr[ FLASH_HDR_BUFFER_SIZE ];
+  #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 } FSTABLE;
 
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+/// define the content type table entry
+typedef struct _CONTENTTYPE
+{
+  PC8   pszExtension;
+  PC8   pszType;
+} CONTENTTYPE;
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
 static  C8      acDynPageBuffer[ DYN_PAGE_BUFFER_SIZE ];
 static  FSTABLE atFsTable[ LWIP_MAX_OPEN_FILES ];
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+static  BOOL    bAcceptZstd;
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 
 // local function prototypes --------------------------------------------------
 static  int             ProcessSsiTag( int iIndex, char* pcInsert, int iLength );
@@ -86,6 +114,13 @@ static  struct fs_file* fs_malloc( void );
 static  void            fs_free( struct fs_file *file );
 static  U16             GenerateDynamicPage( LWIPHTTPDYNPAGE const *ptPage );
 static  U16             SetGenerate( PC8 pcBuffer, U16 wMaxLength, U16 wCurLength );
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+static  BOOL            OpenFlashFile( PC8 pszName, FSTABLE* ptFsEnt );
+static  PC8             GetContentType( PC8 pszName );
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+static  void            ProcessRequestHeaders( const char* pcHeaders, int iLength );
+#endif // INCLUDE_HTTPD_REQUEST_HEADERS
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 
 // constant parameter initializations -----------------------------------------
 static  const C8  szCgiErr[ ]       = { "??" };
@@ -98,6 +133,37 @@ static  const C8  szSetRtnLabel[ ]  = { "Home" };
 /// initialize the settings page
 static const LWIPHTTPDYNPAGE tLwipHttpSetPage = LWIPHTTP_DYNPAGE( szSetHtm, szSetTitle, szSetTime, szSetRtnLabel, szSetRtnLink, NULL, SET_PAG_BGR, SET_PAG_TXT, SET_PAG_LNK, SET_PAG_VLK, SET_PAG_ALK, SET_PAG_FNTSIZE, SET_SEP_COLOR, SET_SEP_WIDTH, 0, 0, 0, 0, 0, 0, 0, SetGenerate, NULL );
 
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+static  const C8  szFlashHdr[ ]     = { "HTTP/1.0 200 OK\r\nServer: lwIP\r\nContent-Type: %s\r\nContent-Length: %lu\r\n%s\r\n" };
+static  const C8  szFlashZstd[ ]    = { "Content-Encoding: zstd\r\nVary: Accept-Encoding\r\n" };
+#if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+static  const C8  szFlashVary[ ]    = { "Vary: Accept-Encoding\r\n" };
+#endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+static  const C8  szFlashNone[ ]    = { "" };
+static  const C8  szAcceptEnc[ ]    = { "accept-encoding:" };
+static  const C8  szZstd[ ]         = { "zstd" };
+
+/// initialize the content types
+static  const CONTENTTYPE atContentTypes[ ] =
+{
+  { ".html",  "text/html" },
+  { ".htm",   "text/html" },
+  { ".css",   "text/css" },
+  { ".js",    "application/javascript" },
+  { ".json",  "application/json" },
+  { ".txt",   "text/plain" },
+  { ".svg",   "image/svg+xml" },
+  { ".png",   "image/png" },
+  { ".jpg",   "image/jpeg" },
+  { ".gif",   "image/gif" },
+  { ".ico",   "image/x-icon" },
+  { ".woff",  "font/woff" },
+  { ".woff2", "font/woff2" },
+  { ".ttf",   "font/ttf" },
+  { NULL,     "application/octet-stream" },
+};
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
 /******************************************************************************
  * @function LwipHttpHandler_Initialize
  *
@@ -117,6 +183,11 @@ void LwipHttpHandler_Initialize( void )
 
   // compute number of entries in the CGI table/initialize the handler
   http_set_cgi_handlers( atLwipHttpCgiFuncs, LwipHttpHandler_GetCgiFuncSize(  ));
+
+  #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON ) && defined( INCLUDE_HTTPD_REQUEST_HEADERS )
+  // look at the request headers to see what encodings the client accepts
+  http_set_request_header_handler( ProcessRequestHeaders );
+  #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 }
 
 /******************************************************************************
@@ -308,6 +379,7 @@ struct fs_file* fs_open( char *pszName )
   U8                        nIndex, nNumDynPages;
   PC8                       pszCmd;
   LWIPHTTPDYNPAGE const *   ptPage;
+  BOOL                      bFound;
 
   // allocate memory for the file system structure.
   ptFile = fs_malloc(  );
@@ -378,8 +450,19 @@ struct fs_file* fs_open( char *pszName )
         }
       }
 
+      // set the found flag
+      bFound = ( ptTree != NULL ) ? TRUE : FALSE;
+
+      #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+      // if not found, try the flash files
+      if ( !bFound )
+      {
+        bFound = OpenFlashFile( pszName, ( FSTABLE* )ptFile );
+      }
+      #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
       // if we did not find the entry/return a null
-      if ( ptTree == NULL )
+      if ( !bFound )
       {
         // free the memory/set the pointer to NULL
         fs_free( ptFile );
@@ -406,6 +489,15 @@ struct fs_file* fs_open( char *pszName )
  *****************************************************************************/
 void fs_close( struct fs_file* file )
 {
+  #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+  // close the flash file
+  if ((( FSTABLE* )file )->tFlashFile != -1 )
+  {
+    FlashFileManager_Close((( FSTABLE* )file )->tFlashFile );
+    (( FSTABLE* )file )->tFlashFile = -1;
+  }
+  #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
   // free the memory
   fs_free( file );
 }
@@ -425,7 +517,22 @@ void fs_close( struct fs_file* file )
 int fs_read( struct fs_file* file, char* buffer, int count )
 {
   S32 lAvailable = -1;
+  #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+  U16 wBytesRead;
+  #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
 
+  #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+  // check for a flash file
+  if ((( FSTABLE* )file )->tFlashFile != -1 )
+  {
+    // read the next block, end of file or an error ends the transfer
+    if ( FlashFileManager_Read((( FSTABLE* )file )->tFlashFile, ( PU8 )buffer, ( U16 )MIN( count, 0xFFFF ), &wBytesRead ) == FLASHFILE_ERROR_NONE )
+    {
+      lAvailable = wBytesRead;
+    }
+  }
+  else
+  #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
   // check to see if a comand
   if ( file->pextension == ( void* )1 )
   {
@@ -440,7 +547,7 @@ int fs_read( struct fs_file* file, char* buffer, int count )
     lAvailable = MIN( lAvailable, count );
 
     // copy the data/adjust the file index
-    memcpy( buffer, file->data + lAvailable, lAvailable );
+    memcpy( buffer, file->data + file->index, lAvailable );
     file->index += lAvailable;
   }
 
@@ -820,6 +927,157 @@ static BOOL DecodeHexEscape( const PC8 pcEncoded, PC8 pcDecoded )
   return( bStatus );
 }
 
+#if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+/******************************************************************************
+ * @function OpenFlashFile
+ *
+ * @brief open a file from the flash file manager
+ *
+ * This function will open a flash file and build its header as the initial
+ * data, the rest of the file is returned by fs_read.  A compressed file is
+ * passed through as is with a zstd content encoding if the client accepts
+ * it, otherwise it is decompressed by the flash file manager.  Either way
+ * the response varies on the accept encoding so caches keep both
+ *
+ * @param[in]   pszName     file name
+ * @param[in]   ptFsEnt     pointer to the file table entry
+ *
+ * @return      TRUE if found, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL OpenFlashFile( PC8 pszName, FSTABLE* ptFsEnt )
+{
+  BOOL            bFound = FALSE;
+  FLASHFILEHANDLE tHandle;
+  PC8             pszEncoding = ( PC8 )szFlashNone;
+  U32             uSize;
+
+  // find it
+  if (( tHandle = FlashFileManager_Find( pszName )) != -1 )
+  {
+    // check for compressed
+    if ( FlashFileManager_IsCompressed( tHandle ))
+    {
+      if ( bAcceptZstd )
+      {
+        // send the stored frame
+        FlashFileManager_SetRaw( tHandle );
+        pszEncoding = ( PC8 )szFlashZstd;
+      }
+      else
+      {
+        #if ( FLASHFILEMANAGER_ENABLE_COMPRESSION == ON )
+        // decompressed, the content still depends on the accepted encodings
+        pszEncoding = ( PC8 )szFlashVary;
+        #else
+        // no decoder, can not be served
+        FlashFileManager_Close( tHandle );
+        tHandle = -1;
+        #endif // FLASHFILEMANAGER_ENABLE_COMPRESSION
+      }
+    }
+
+    // check for still valid
+    if ( tHandle != -1 )
+    {
+      // build the header
+      FlashFileManager_Size( tHandle, &uSize );
+      ptFsEnt->ptFile.len = snprintf( ptFsEnt->acFlashHdr, FLASH_HDR_BUFFER_SIZE, szFlashHdr, GetContentType( pszName ), ( unsigned long )uSize, pszEncoding );
+      ptFsEnt->ptFile.len = MIN( ptFsEnt->ptFile.len, FLASH_HDR_BUFFER_SIZE - 1 );
+      ptFsEnt->ptFile.data = ptFsEnt->acFlashHdr;
+      ptFsEnt->ptFile.index = ptFsEnt->ptFile.len;
+      ptFsEnt->ptFile.pextension = NULL;
+      ptFsEnt->tFlashFile = tHandle;
+      bFound = TRUE;
+    }
+  }
+
+  // return the status
+  return( bFound );
+}
+
+/******************************************************************************
+ * @function GetContentType
+ *
+ * @brief get the content type
+ *
+ * This function will return the content type for the extension of a name
+ *
+ * @param[in]   pszName     file name
+ *
+ * @return      pointer to the content type
+ *
+ *****************************************************************************/
+static PC8 GetContentType( PC8 pszName )
+{
+  CONTENTTYPE const * ptType = atContentTypes;
+  PC8                 pszExt;
+
+  // find the extension, none matches nothing
+  if (( pszExt = strrchr( pszName, '.' )) == NULL )
+  {
+    pszExt = ( PC8 )szFlashNone;
+  }
+
+  // search the table, the last entry is the default
+  while (( ptType->pszExtension != NULL ) && ( strcasecmp( pszExt, ptType->pszExtension ) != 0 ))
+  {
+    ptType++;
+  }
+
+  // return the type
+  return( ptType->pszType );
+}
+
+#ifdef INCLUDE_HTTPD_REQUEST_HEADERS
+/******************************************************************************
+ * @function ProcessRequestHeaders
+ *
+ * @brief process the request headers
+ *
+ * This function will scan the request headers for an Accept-Encoding header
+ * that lists zstd, the result applies to the file opened for this request
+ *
+ * @param[in]   pcHeaders   pointer to the headers, not terminated
+ * @param[in]   iLength     length of the headers
+ *
+ *****************************************************************************/
+static void ProcessRequestHeaders( const char* pcHeaders, int iLength )
+{
+  int   iIndex = 0, iEnd, iTag;
+  int   iTagLength = sizeof( szAcceptEnc ) - 1;
+  int   iZstdLength = sizeof( szZstd ) - 1;
+
+  // clear the flag
+  bAcceptZstd = FALSE;
+
+  // for each line
+  while ( iIndex < iLength )
+  {
+    // find the end of the line
+    for ( iEnd = iIndex; ( iEnd < iLength ) && ( pcHeaders[ iEnd ] != '\n' ); iEnd++ );
+
+    // check for the header
+    if ((( iEnd - iIndex ) > iTagLength ) && ( strncasecmp( &pcHeaders[ iIndex ], szAcceptEnc, iTagLength ) == 0 ))
+    {
+      // look for the encoding
+      for ( iTag = iIndex + iTagLength; iTag <= ( iEnd - iZstdLength ); iTag++ )
+      {
+        if ( strncasecmp( &pcHeaders[ iTag ], szZstd, iZstdLength ) == 0 )
+        {
+          bAcceptZstd = TRUE;
+          break;
+        }
+      }
+    }
+
+    // next line
+    iIndex = iEnd + 1;
+  }
+}
+#endif // INCLUDE_HTTPD_REQUEST_HEADERS
+#endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
 /*-----------------------------------------------------------------------------------*/
 static struct fs_file* fs_malloc( void )
 {
@@ -835,6 +1093,12 @@ static struct fs_file* fs_malloc( void )
       // set in use/set the pointer
       atFsTable[ i ].bInUse = TRUE;
       ptFile = &atFsTable[ i ].ptFile;
+      #if ( LWIPHTTPHANDLER_ENABLE_FLASHFILES == ON )
+      atFsTable[ i ].tFlashFile = -1;
+      #endif // LWIPHTTPHANDLER_ENABLE_FLASHFILES
+
+      // exit loop
+      break;
     }
   }
 
@@ -24,7 +24,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
-#include "CRC32/Crc32.h"
+#include "CRC32/CRC32.h"
 
 // library includes -----------------------------------------------------------
 
@@ -115,7 +115,7 @@ U32	CRC32_CalculateBlock( PU8 pnData, U32 uLength )
   // for each byte calculate the CRC
   for( uIdx = 0; uIdx < uLength; uIdx++ )
   {
-    nData = *( pnData );
+    nData = *( pnData++ );
 
     // add the data
     uCrc = PGM_RDDWRD( auCrcTbl[(( uCrc ^ nData ) & 0x0000000F )]) ^ ( uCrc >> 4 );